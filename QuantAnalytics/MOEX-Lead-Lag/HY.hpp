@@ -8,6 +8,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <utility>
+#include <vector>
 #include <cstdio>
 #include <cstring>
 #include <cstdlib>
@@ -141,6 +142,159 @@ namespace MLL
     return cross / sqrt(a_stats1.m_var * a_stats2.m_var);
   }
 
+  //=========================================================================//
+  // "HayashiYoshidaSweep":                                                  //
+  //=========================================================================//
+  // Same estimator as above, but for all lags in [a_lmin .. a_lmax] at once
+  // (0 <= a_lmin <= a_lmax, the Leader is already selected), in one merged
+  // sweep over the tick intervals of both Instrs:
+  // A pair of intervals L=[fromL, toL) and F=[fromF, toF) contributes rL*rF
+  // to all lags "l" for which L shifted by "l" overlaps F, ie to the range
+  // fromF - toL < l < toF - fromL (further restricted by the same boundary
+  // conditions as in "HayashiYoshidaCrossCorr"), so each pair is visited only
+  // once, and its contribution goes into the difference array "a_diff"  (of
+  // size a_lmax - a_lmin + 2): the cross-covariance for lag "l" is then the
+  // sum of a_diff[0 .. l - a_lmin]:
+  //
+  template<int N>
+  void HayashiYoshidaSweep
+  (
+    MDEntryT const (&a_leader)  [N],
+    double           a_retL,
+    MDEntryT const (&a_follower)[N],
+    double           a_retF,
+    int              a_idx_from,
+    int              a_idx_to,
+    int              a_lmin,
+    int              a_lmax,
+    double*          a_diff
+  )
+  {
+    assert(0 <= a_idx_from && a_idx_from < a_idx_to && a_idx_to < N &&
+           0 <= a_lmin     && a_lmin <= a_lmax     && a_diff != nullptr);
+
+    // The first tick of the Follower at or after "a_idx_from":  a Leader int-
+    // erval shifted to before it is skipped by "HayashiYoshidaCrossCorr"  (as
+    // "fromF < a_idx_from" in that case):
+    int startF = a_follower[a_idx_from].m_curr;
+    if (startF < a_idx_from)
+      startF   = a_follower[a_idx_from].m_next;
+
+    int fromL  = a_leader[a_idx_from].m_curr;
+    assert(0 <= fromL && fromL < N && !a_leader[fromL].IsEmpty());
+
+    while (true)
+    {
+      // Got L=[fromL, toL); it is used for those lags only for which the
+      // shifted "toL" is still within the range:
+      int toL = a_leader[fromL].m_next;
+      if (toL + a_lmin > a_idx_to)
+        break;
+      assert(fromL < toL);
+
+      double rL = (a_leader[toL].m_px - a_leader[fromL].m_px) -
+                   a_retL * double(toL - fromL);
+
+      // The first Follower interval which may overlap with L shifted by any
+      // of the lags: the one containing (fromL + a_lmin), but not before
+      // "startF":
+      int t = std::max<int>(fromL + a_lmin, startF);
+      if (t > a_idx_to)
+        break;   // No more overlaps (in further iterations either)
+
+      int fromF = a_follower[t].m_curr;
+      assert(!a_follower[fromF].IsEmpty());
+
+      while (true)
+      {
+        int toF = a_follower[fromF].m_next;
+        if (toF > a_idx_to || fromF >= toL + a_lmax)
+          break;
+        assert(fromF < toF);
+
+        // The range of lags for which this pair contributes:
+        int lo = std::max<int>({ fromF - toL + 1, startF - fromL, a_lmin });
+        int hi = std::min<int>({ toF - fromL - 1, a_idx_to - toL, a_lmax });
+
+        if (lo <= hi)
+        {
+          double rF = (a_follower[toF].m_px - a_follower[fromF].m_px) -
+                       a_retF * double(toF - fromF);
+          a_diff[lo - a_lmin]     += rL * rF;
+          a_diff[hi - a_lmin + 1] -= rL * rF;
+        }
+        // Next iteration over the "follower":
+        fromF = toF;
+      }
+      // Next Iteration over the "leader":
+      fromL = toL;
+    }
+  }
+
+  //=========================================================================//
+  // "HayashiYoshidaCrossCorrs":                                             //
+  //=========================================================================//
+  // The whole Cross-Correlation Function (same as "HayashiYoshidaCrossCorr"
+  // for each lag in [a_lmin .. a_lmax], up to rounding errors), computed by
+  // 2 sweeps (for the lags >= 0 and < 0, ie for each Leader); the result is
+  // indexed by (l - a_lmin):
+  //
+  template<int N>
+  std::vector<double> HayashiYoshidaCrossCorrs
+  (
+    MDEntryT const (&a_instr1)[N],
+    StatsT   const&  a_stats1,
+    MDEntryT const (&a_instr2)[N],
+    StatsT   const&  a_stats2,
+    int              a_idx_from,
+    int              a_idx_to,
+    int              a_lmin,
+    int              a_lmax
+  )
+  {
+    assert(a_lmin <= a_lmax);
+    std::vector<double> res (size_t(a_lmax - a_lmin + 1), 0.0);
+    std::vector<double> diff(res.size() + 1);
+
+    // "instr1" leads by "l" >= 0:
+    if (a_lmax >= 0)
+    {
+      int from = std::max<int>(a_lmin, 0);
+      std::fill(diff.begin(), diff.end(), 0.0);
+      HayashiYoshidaSweep
+        (a_instr1, a_stats1.m_retRate, a_instr2, a_stats2.m_retRate,
+         a_idx_from, a_idx_to, from, a_lmax, diff.data());
+
+      double cross = 0.0;
+      for (int l = from; l <= a_lmax; ++l)
+      {
+        cross += diff[size_t(l - from)];
+        res[size_t(l - a_lmin)] = cross;
+      }
+    }
+    // "instr2" leads by "-l" > 0:
+    if (a_lmin < 0)
+    {
+      int from = std::max<int>(-a_lmax, 1);
+      std::fill(diff.begin(), diff.end(), 0.0);
+      HayashiYoshidaSweep
+        (a_instr2, a_stats2.m_retRate, a_instr1, a_stats1.m_retRate,
+         a_idx_from, a_idx_to, from, -a_lmin, diff.data());
+
+      double cross = 0.0;
+      for (int l = from; l <= -a_lmin; ++l)
+      {
+        cross += diff[size_t(l - from)];
+        res[size_t(-l - a_lmin)] = cross;
+      }
+    }
+    // Normalise the results:
+    double norm = sqrt(a_stats1.m_var * a_stats2.m_var);
+    for (double& r: res)
+      r /= norm;
+    return res;
+  }
+
   //=========================================================================//
   // "GetStatsHY": Some Descriptive Statistics for use with the HY Method:   //
   //=========================================================================//
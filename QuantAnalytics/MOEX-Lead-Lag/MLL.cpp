@@ -13,6 +13,7 @@
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/ini_parser.hpp>
 #include <string>
+#include <vector>
 
 namespace
 {
@@ -145,6 +146,13 @@ int main(int argc, char* argv[])
       nRes *= 2;
     double res[nRes];
 
+    // For HY, the whole Cross-Correlation Function is computed at once, in a
+    // single sweep over both TimeSeries (rather than a sweep per lag):
+    vector<double> resHY;
+    if (mi.m_method == MethodT::HY)
+      resHY = HayashiYoshidaCrossCorrs
+              (instr1, st1, instr2, st2, idxFrom, idxTo, lMin, lMax);
+
     //-----------------------------------------------------------------------//
     // Parallel Loop wrt Lead-Lag ("l"):                                     //
     //-----------------------------------------------------------------------//
@@ -156,8 +164,7 @@ int main(int argc, char* argv[])
       switch (mi.m_method)
       {
         case MethodT::HY:
-          res[i] = HayashiYoshidaCrossCorr
-                   (instr1, st1, instr2, st2, idxFrom,  idxTo, l);
+          res[i] = resHY[size_t(l - lMin)];
           break;
 
         case MethodT::VAR:
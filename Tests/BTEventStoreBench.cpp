@@ -0,0 +1,359 @@
+// vim:ts=2:et
+//===========================================================================//
+//                       "Tests/BTEventStoreBench.cpp":                      //
+//  BackTest Event Stores: Heap-Allocating Event Vector vs Columnar + Merge  //
+//===========================================================================//
+// Usage: BTEventStoreBench
+// (*) Generates a synthetic day of MktData for 8 instrs: L2 book snapshots
+//     (10 levels per side) and trades, ~1M events in total, with per-instr
+//     time-ordered streams (as in the "DataProvider" cache files);
+// (*) "Legacy" is the previous "DataProvider" representation: a vector of
+//     events each owning its book levels ("new[]" on every copy), which is
+//     then sorted by time as a whole;
+// (*) "Columnar" loads the same events into per-instr "EventStream"s (which
+//     are re-used, as for consecutive BackTest windows) and iterates them via
+//     the streaming k-way "EventMerge", or via "EventReplay" of the packed
+//     (stream, row) merge order recorded once (as "DataProvider::Load" does);
+// (*) All sequences are cross-checked, then Load and Iterate are timed, the
+//     latter also for "NPasses" passes over the same window (eg strategies or
+//     parameter sets), where the order is recorded on the 1st pass only.
+// The output is similar to that of Google Benchmark, with events/sec added:
+//
+#include "QuantSupport/BT/EventStore.h"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <string>
+
+using namespace MAQUETTE;
+using namespace MAQUETTE::History;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "LegacyData": The previous "DataProvider::data" (owning its quotes):    //
+  //=========================================================================//
+  struct LegacyData
+  {
+    utxx::time_val time;
+    uint16_t       id;
+    uint16_t       type;
+    uint16_t       asks_size, bids_size;
+
+    union
+    {
+      quote* quotes[2];
+      quote  trade;
+    };
+
+    LegacyData() { memset(this, 0, sizeof(LegacyData)); }
+    LegacyData(LegacyData const& a_r)
+    {
+      memset(this, 0, sizeof(LegacyData));
+      *this = a_r;
+    }
+    void operator=(LegacyData const& a_r)
+    {
+      if (type == 1)
+      {
+        delete[] quotes[0];
+        delete[] quotes[1];
+        quotes[0] = nullptr;
+        quotes[1] = nullptr;
+      }
+      time      = a_r.time;
+      id        = a_r.id;
+      type      = a_r.type;
+      asks_size = a_r.asks_size;
+      bids_size = a_r.bids_size;
+      if (type == 1)
+      {
+        quotes[0] = new quote[asks_size];
+        quotes[1] = new quote[bids_size];
+        copy(a_r.quotes[0], a_r.quotes[0] + asks_size, quotes[0]);
+        copy(a_r.quotes[1], a_r.quotes[1] + bids_size, quotes[1]);
+      }
+      else
+        trade = a_r.trade;
+    }
+    ~LegacyData()
+    {
+      if (type == 1)
+      {
+        delete[] quotes[0];
+        delete[] quotes[1];
+      }
+    }
+    bool operator<(LegacyData const& a_r) const
+      { return (time == a_r.time) ? (a_r.type < type) : (time < a_r.time); }
+  };
+
+  //=========================================================================//
+  // "RawEv": Generated event (as parsed from a cache file):                 //
+  //=========================================================================//
+  constexpr int NInstrs = 8;
+  constexpr int Depth   = 10;
+  constexpr int NPasses = 8;
+
+  struct RawEv
+  {
+    long   ns;
+    int    stream;              // 2*Instr + (0: Book, 1: Trade)
+    int    type;
+    quote  asks[Depth];
+    quote  bids[Depth];
+  };
+
+  //=========================================================================//
+  // "DoNotOptimize", "Bench":                                               //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  template<typename F>
+  void Bench(string const& a_name, long a_n, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    double ns = sec * 1e9 / double(n * a_n);
+    cout << left  << setw(30) << a_name
+         << right << setw(10) << fixed << setprecision(1) << ns << " ns/ev"
+         << setw(12) << setprecision(1) << (1e3 / ns) << " Mev/s" << endl;
+  }
+
+  //=========================================================================//
+  // "Generate":                                                             //
+  //=========================================================================//
+  // Per-stream times are increasing; the low bits hold the stream idx, so all
+  // times are distinct and both orderings are fully determined:
+  //
+  vector<vector<RawEv>> Generate(long a_per_stream)
+  {
+    mt19937_64            rng(12345);
+    vector<vector<RawEv>> res(2 * NInstrs);
+    for (int s = 0; s < 2 * NInstrs; ++s)
+    {
+      long   t  = 0;
+      double px = 100.0 + s;
+      res[size_t(s)].resize(size_t(a_per_stream));
+      for (RawEv& ev: res[size_t(s)])
+      {
+        t        += long(1 + rng() % 100'000);
+        px       += (double(rng() % 21) - 10.0) * 0.01;
+        ev.ns     = t * 64 + s;
+        ev.stream = s;
+        ev.type   = (s % 2 == 0) ? 1 : (2 + int(rng() % 2));
+        for (int l = 0; l < Depth; ++l)
+        {
+          ev.asks[l] = quote{PriceT(px + 0.01 * (l + 1)),
+                             QtyUD(double(1 + rng() % 100))};
+          ev.bids[l] = quote{PriceT(px - 0.01 * (l + 1)),
+                             QtyUD(double(1 + rng() % 100))};
+        }
+      }
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // Loaders:                                                                //
+  //=========================================================================//
+  void LoadLegacy
+    (vector<vector<RawEv>> const& a_raw, vector<LegacyData>* a_out)
+  {
+    a_out->clear();
+    for (auto const& stream: a_raw)
+      for (RawEv const& r: stream)
+      {
+        LegacyData d;
+        d.time = utxx::time_val(utxx::nsecs(r.ns));
+        d.id   = uint16_t(r.stream / 2);
+        d.type = uint16_t(r.type);
+        if (r.type == 1)
+        {
+          d.quotes[0] = new quote[Depth];
+          d.quotes[1] = new quote[Depth];
+          copy(r.asks, r.asks + Depth, d.quotes[0]);
+          copy(r.bids, r.bids + Depth, d.quotes[1]);
+          d.asks_size = Depth;
+          d.bids_size = Depth;
+        }
+        else
+          d.trade = r.asks[0];
+        a_out->push_back(d);
+      }
+    sort(a_out->begin(), a_out->end());
+  }
+
+  void LoadColumnar
+    (vector<vector<RawEv>> const& a_raw, vector<EventStream>* a_out)
+  {
+    a_out->resize(a_raw.size());
+    for (size_t s = 0; s < a_raw.size(); ++s)
+    {
+      EventStream& es = (*a_out)[s];
+      es.clear(uint16_t(s / 2));
+      for (RawEv const& r: a_raw[s])
+      {
+        utxx::time_val t = utxx::time_val(utxx::nsecs(r.ns));
+        if (r.type == 1)
+        {
+          es.begin_book(t);
+          for (int l = 0; l < Depth; ++l) es.add_bid(r.bids[l]);
+          for (int l = 0; l < Depth; ++l) es.add_ask(r.asks[l]);
+        }
+        else
+          es.add_trade(t, r.type == 3, r.asks[0]);
+      }
+      es.sort();
+    }
+  }
+
+  //=========================================================================//
+  // "Consume": What a consumer typically reads from an event:               //
+  //=========================================================================//
+  template<typename D>
+  inline double Consume(D const& a_d)
+  {
+    return
+      (a_d.type == 1)
+      ? double(a_d.quotes[0][0].price) + double(a_d.quotes[1][0].price) +
+        double(a_d.asks_size)
+      : double(a_d.trade.price);
+  }
+
+  template<typename D>
+  inline bool Same(LegacyData const& a_l, D const& a_c)
+  {
+    return
+      a_l.time == a_c.time && a_l.id == a_c.id && a_l.type == a_c.type &&
+      a_l.asks_size == a_c.asks_size && a_l.bids_size == a_c.bids_size &&
+      Consume(a_l) == Consume(a_c);
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main()
+{
+  try
+  {
+    long const            perStream = 65'536;
+    long const            nEvs      = 2 * NInstrs * perStream;
+    vector<vector<RawEv>> raw       = Generate(perStream);
+
+    vector<LegacyData>  legacy;
+    vector<EventStream> streams;
+    LoadLegacy  (raw, &legacy);
+    LoadColumnar(raw, &streams);
+
+    // Cross-Check:
+    long n = 0;
+    for (EventMerge m(streams); !m.done(); m.next(), ++n)
+      if (n >= long(legacy.size()) || !Same(legacy[size_t(n)], m.get()))
+      {
+        cerr << "MISMATCH at event " << n << endl;
+        return 1;
+      }
+    if (n != nEvs || long(legacy.size()) != nEvs)
+    {
+      cerr << "MISMATCH: " << n << " events, expected " << nEvs << endl;
+      return 1;
+    }
+    EventReplay::order_t order;
+    EventReplay::record(streams, &order);
+    n = 0;
+    for (EventReplay r(streams, order); !r.done(); r.next(), ++n)
+      if (n >= nEvs || !Same(legacy[size_t(n)], r.get()))
+      {
+        cerr << "REPLAY MISMATCH at event " << n << endl;
+        return 1;
+      }
+    if (n != nEvs)
+    {
+      cerr << "REPLAY MISMATCH: " << n << " events, expected " << nEvs
+           << endl;
+      return 1;
+    }
+
+    cout << left  << setw(30) << "Benchmark" << right << setw(16) << "Time"
+         << setw(18) << "Rate\n" << string(63, '-') << endl;
+
+    Bench("Legacy/Load+Sort",      nEvs, [&]
+      { LoadLegacy(raw, &legacy); DoNotOptimize(legacy.data()); });
+    Bench("Columnar/Load",         nEvs, [&]
+      { LoadColumnar(raw, &streams); DoNotOptimize(streams.data()); });
+    Bench("Legacy/Iterate",        nEvs, [&]
+      {
+        double acc = 0.0;
+        for (LegacyData const& d: legacy) acc += Consume(d);
+        DoNotOptimize(acc);
+      });
+    Bench("Columnar/Merge+Iterate", nEvs, [&]
+      {
+        double acc = 0.0;
+        for (EventMerge m(streams); !m.done(); m.next())
+          acc += Consume(m.get());
+        DoNotOptimize(acc);
+      });
+    Bench("Columnar/Record",        nEvs, [&]
+      {
+        EventReplay::record(streams, &order);
+        DoNotOptimize(order.recs.data());
+      });
+    Bench("Columnar/Replay+Iterate", nEvs, [&]
+      {
+        double acc = 0.0;
+        for (EventReplay r(streams, order); !r.done(); r.next())
+          acc += Consume(r.get());
+        DoNotOptimize(acc);
+      });
+
+    // Multi-Pass (per event of every pass):
+    string const passes = "x" + to_string(NPasses);
+    Bench("Legacy/Iterate"   + passes, NPasses * nEvs, [&]
+      {
+        double acc = 0.0;
+        for (int p = 0; p < NPasses; ++p)
+          for (LegacyData const& d: legacy) acc += Consume(d);
+        DoNotOptimize(acc);
+      });
+    Bench("Columnar/Merge"   + passes, NPasses * nEvs, [&]
+      {
+        double acc = 0.0;
+        for (int p = 0; p < NPasses; ++p)
+          for (EventMerge m(streams); !m.done(); m.next())
+            acc += Consume(m.get());
+        DoNotOptimize(acc);
+      });
+    Bench("Columnar/Record+Replay" + passes, NPasses * nEvs, [&]
+      {
+        double acc = 0.0;
+        EventReplay::record(streams, &order);
+        for (int p = 0; p < NPasses; ++p)
+          for (EventReplay r(streams, order); !r.done(); r.next())
+            acc += Consume(r.get());
+        DoNotOptimize(acc);
+      });
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,415 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "Tests/BTRunnerBench.cpp":                         //
+//        Scaling of the Parallel BackTest Runner with the Thread Count      //
+//===========================================================================//
+// Usage: BTRunnerBench [MaxThreads (default: all cores)]
+// (*) The job space is 16 days x 4 instr sets x 16 param sets = 1024 jobs,
+//     scheduled by the "WorkStealingPool" and aggregated by "BTReport", as
+//     the "parallel" BackTest mode does;
+// (*) The MktData of each (day, instr set) are synthetic per-instr books and
+//     trades in "EventStream"s (~32k events), which a worker re-generates
+//     only when its (day, instr set) changes -- as it re-loads the cache
+//     files in the real runner;
+// (*) Each job runs a simple mean-reversion strategy over the "EventMerge"
+//     of those streams, and reports its OMC-like "Statistics";
+// (*) Runs with 1, 2, 4, ... MaxThreads, and cross-checks that the aggre-
+//     gated report is the same for all thread counts;
+// (*) Then the same with a "RiskMgr": as in the real runner, every worker
+//     has a private one (worker-tagged "AccountPfx", own "MapAddr" slot),
+//     which is reset for every job; the fills of the job are booked in its
+//     "InstrRisks", and the resulting positions are cross-checked against
+//     the job's own, so any sharing of "RiskMgr"s between workers is caught.
+// The output is similar to that of Google Benchmark, with the speed-up and
+// the parallel efficiency added:
+//
+#include "QuantSupport/BT/BackTestRunner.h"
+#include "QuantSupport/BT/EventStore.h"
+#include "Basis/IOUtils.h"
+#include "InfraStruct/PersistMgr.h"
+#include "InfraStruct/SecDefsMgr.h"
+#include "InfraStruct/RiskMgr.h"
+#include <utxx/time_val.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+#include <string>
+
+using namespace MAQUETTE;
+using namespace MAQUETTE::History;
+using namespace std;
+
+namespace
+{
+  constexpr uint32_t NDays      = 16;
+  constexpr uint32_t NSets      = 4;
+  constexpr uint32_t NParams    = 16;
+  constexpr int      NInstrs    = 4;      // Per instr set
+  constexpr int      PerStream  = 4'096;
+  constexpr int      Depth      = 5;
+
+  char const* const  Pfx        = "BTRunnerBench";
+
+  //=========================================================================//
+  // "RMEnv": Shared by the private "RiskMgr"s of all Workers:               //
+  //=========================================================================//
+  struct RMEnv
+  {
+    SecDefsMgr*                     m_sdm = nullptr;
+    vector<SecDefD const*>          m_instrs;    // NSets * NInstrs
+    shared_ptr<spdlog::logger>      m_logger;
+  };
+
+  //=========================================================================//
+  // "MkRMParams": Params of the private "RiskMgr" of Worker "a_w":          //
+  //=========================================================================//
+  // As "WorkerConnectors" in the real runner makes them: the worker tag is
+  // appended to the "AccountPfx", and the "MapAddr" is an explicit slot:
+  //
+  boost::property_tree::ptree MkRMParams(uint32_t a_w)
+  {
+    using PM = PersistMgr<>;
+    char addr[32];
+    snprintf(addr, sizeof(addr), "0x%lx",
+             PM::BaseMapAddr + PM::MaxSegmSz * (PM::SegmIdxMod - 1 - a_w));
+
+    boost::property_tree::ptree params;
+    params.put("AccountPfx",                   string(Pfx) + "-BT" +
+                                               to_string(a_w));
+    params.put("MapAddr",                      addr);
+    params.put("ResetAll",                     true);
+    params.put("ShMSegmSzMB",                  64);
+    params.put("RFC",                          "USD");
+    params.put("MaxTotalRisk_RFC",             1e15);
+    params.put("MaxNormalRisk_RFC",            1e15);
+    params.put("MinTotalNAV_RFC",              -1e15);
+    params.put("MaxOrderSize_RFC",             1e12);
+    params.put("MinOrderSize_RFC",             1.0);
+    params.put("MaxActiveOrdersTotalSize_RFC", 1e15);
+    params.put("VlmThrottlPeriod1_Sec",        1);
+    params.put("VlmLimit1_RFC",                1e15);
+    params.put("VlmThrottlPeriod2_Sec",        60);
+    params.put("VlmLimit2_RFC",                1e15);
+    params.put("VlmThrottlPeriod3_Sec",        3600);
+    params.put("VlmLimit3_RFC",                1e15);
+    return params;
+  }
+
+  //=========================================================================//
+  // "MkData": Synthetic MktData of one (day, instr set):                    //
+  //=========================================================================//
+  void MkData(uint32_t a_day, uint32_t a_set, vector<EventStream>* a_out)
+  {
+    mt19937_64 rng(1'000 * a_day + a_set);
+    a_out->resize(2 * NInstrs);
+    for (int s = 0; s < 2 * NInstrs; ++s)
+    {
+      EventStream& es = (*a_out)[size_t(s)];
+      es.clear(uint16_t(a_set * NInstrs + uint32_t(s / 2)));
+      long   t  = 0;
+      double px = 100.0 + s / 2;
+      for (int i = 0; i < PerStream; ++i)
+      {
+        t  += long(1 + rng() % 100'000);
+        px += (double(rng() % 21) - 10.0) * 0.01;
+        utxx::time_val ts = utxx::time_val(utxx::nsecs(t * 16 + s));
+        if (s % 2 == 0)
+        {
+          es.begin_book(ts);
+          for (int l = 0; l < Depth; ++l)
+            es.add_bid(quote{PriceT(px - 0.01 * (l + 1)),
+                             QtyUD(double(1 + rng() % 100))});
+          for (int l = 0; l < Depth; ++l)
+            es.add_ask(quote{PriceT(px + 0.01 * (l + 1)),
+                             QtyUD(double(1 + rng() % 100))});
+        }
+        else
+          es.add_trade(ts, rng() % 2 == 0,
+                       quote{PriceT(px), QtyUD(double(1 + rng() % 10))});
+      }
+    }
+  }
+
+  //=========================================================================//
+  // "RunJob": Mean-reversion on the mid vs its EMA, per instr:              //
+  //=========================================================================//
+  // If "a_irs" is non-NULL, the fills are also booked in those "InstrRisks"
+  // (one per instr):
+  //
+  void RunJob
+  (
+    vector<EventStream> const& a_data,
+    uint32_t                   a_params,
+    BTReport::slot*            a_res,
+    InstrRisks const* const*   a_irs
+  )
+  {
+    double const thresh = 0.02 + 0.01 * a_params;
+    double const alpha  = 0.01;
+
+    vector<Statistics> stats(NInstrs);
+    vector<double>     ema  (NInstrs, NaN<double>);
+    vector<double>     last (NInstrs, 0.0);
+
+    for (EventMerge m(a_data); !m.done(); m.next())
+    {
+      event const& ev = m.get();
+      size_t       i  = size_t(ev.id % NInstrs);
+      Statistics&  st = stats[i];
+      if (ev.type != 1)
+      {
+        last[i] = double(ev.trade.price);
+        continue;
+      }
+      double mid = 0.5 * (double(ev.quotes[0][0].price) +
+                          double(ev.quotes[1][0].price));
+      ema[i]     = IsFinite(ema[i]) ? ema[i] + alpha * (mid - ema[i]) : mid;
+
+      // Trade 1 unit towards the EMA, with a position limit:
+      double dev = mid - ema[i];
+      int    dir = (dev > thresh) ? -1 : (dev < -thresh) ? 1 : 0;
+      if (dir == 0 || abs(st.cur_pos + dir) > 10.0)
+        continue;
+      double px   = double((dir > 0) ? ev.quotes[0][0].price
+                                     : ev.quotes[1][0].price);
+      ++st.new_orders;
+      st.cur_pos += dir;
+      st.volume  += px;
+      st.delta   -= dir * px;
+      st.min_pos  = min(st.min_pos, st.cur_pos);
+      st.max_pos  = max(st.max_pos, st.cur_pos);
+      if (a_irs != nullptr)
+        a_irs[i]->m_posA = RMQtyA(double(a_irs[i]->m_posA) + dir);
+    }
+    for (int i = 0; i < NInstrs; ++i)
+    {
+      // Close the position at the last trade px:
+      Statistics& st = stats[size_t(i)];
+      if (a_irs != nullptr && double(a_irs[i]->m_posA) != st.cur_pos)
+        throw runtime_error("RunJob: RiskMgr position mismatch");
+      st.delta      += st.cur_pos * last[size_t(i)];
+      st.secID       = SecID(i);
+      st.symbol      = "I" + to_string(i);
+      a_res->emplace_back("P" + to_string(a_params), st);
+    }
+  }
+
+  //=========================================================================//
+  // "Worker": Per-thread MktData cache:                                     //
+  //=========================================================================//
+  struct alignas(64) Worker
+  {
+    vector<EventStream>         m_data;
+    uint32_t                    m_day  = ~0u;
+    uint32_t                    m_set  = ~0u;
+    long                        m_gens = 0;
+    boost::property_tree::ptree m_rmParams;  // If with a RiskMgr
+  };
+
+  //=========================================================================//
+  // "Run": Returns the report summary, and the wall time:                   //
+  //=========================================================================//
+  // With a "RiskMgr" per Worker iff "a_env" is non-NULL:
+  //
+  vector<BTReport::entry> Run
+  (
+    uint32_t     a_threads,
+    RMEnv const* a_env,
+    double*      a_sec,
+    size_t*      a_steals,
+    long*        a_gens
+  )
+  {
+    JobSpace       space{NDays, NSets, NParams};
+    BTReport       report(space.size());
+    vector<Worker> workers(a_threads);
+    WorkStealingPool pool(a_threads);
+    if (a_env != nullptr)
+      for (uint32_t w = 0; w < a_threads; ++w)
+        workers[w].m_rmParams = MkRMParams(w);
+
+    utxx::time_val from = utxx::now_utc();
+    pool.run(space.size(), [&](uint32_t a_w, size_t a_j)
+    {
+      Worker&       wk  = workers[a_w];
+      JobSpace::job job = space[a_j];
+      if (wk.m_day != job.day || wk.m_set != job.instrs)
+      {
+        MkData(job.day, job.instrs, &wk.m_data);
+        wk.m_day = job.day;
+        wk.m_set = job.instrs;
+        ++wk.m_gens;
+      }
+      if (a_env == nullptr)
+      {
+        RunJob(wk.m_data, job.params, &report[a_j], nullptr);
+        return;
+      }
+      // A new Strategy would re-attach to (and reset) the Worker's RiskMgr,
+      // and register its instrs:
+      RiskMgr* rm = RiskMgr::GetPersistInstance
+        (false, wk.m_rmParams, *(a_env->m_sdm), false,
+         a_env->m_logger.get(), 0);
+
+      InstrRisks const* irs[NInstrs];
+      for (int i = 0; i < NInstrs; ++i)
+      {
+        SecDefD const& instr =
+          *(a_env->m_instrs[job.instrs * NInstrs + uint32_t(i)]);
+        rm->Register(instr, nullptr);
+        irs[i] = &(rm->GetInstrRisks(instr, 0));
+      }
+      RunJob(wk.m_data, job.params, &report[a_j], irs);
+    });
+    *a_sec    = (utxx::now_utc() - from).seconds();
+    *a_steals = pool.steals();
+    *a_gens   = 0;
+    for (Worker const& wk: workers)
+      *a_gens += wk.m_gens;
+    return report.summary();
+  }
+
+  bool Same(vector<BTReport::entry> const& a_l,
+            vector<BTReport::entry> const& a_r)
+  {
+    if (a_l.size() != a_r.size())
+      return false;
+    for (size_t i = 0; i < a_l.size(); ++i)
+    {
+      Statistics const& l = a_l[i].second;
+      Statistics const& r = a_r[i].second;
+      if (a_l[i].first != a_r[i].first || l.secID != r.secID ||
+          l.delta != r.delta || l.volume != r.volume ||
+          l.new_orders != r.new_orders || l.min_pos != r.min_pos ||
+          l.max_pos != r.max_pos || l.runs != r.runs)
+        return false;
+    }
+    return true;
+  }
+
+  //=========================================================================//
+  // "RemoveShM": ShM Segments created by this Bench:                        //
+  //=========================================================================//
+  void RemoveShM(uint32_t a_max_threads)
+  {
+    for (uint32_t w = 0; w < a_max_threads; ++w)
+      (void) RiskMgr::RemovePersistInstance(false, MkRMParams(w));
+
+    // (NB: "PersistMgr" prepends the UserName to the Segment names):
+    string pfx = string(cuserid(nullptr)) + "-" + Pfx;
+    (void) BIPC::shared_memory_object::remove
+      ((pfx + "-SecDefsMgr-Test").data());
+  }
+
+  //=========================================================================//
+  // "Scale": Runs with 1, 2, 4, ... MaxThreads:                             //
+  //=========================================================================//
+  // The 1st report is stored in "a_ref", all others are cross-checked against
+  // it:
+  //
+  void Scale
+  (
+    uint32_t                 a_max_threads,
+    RMEnv const*             a_env,
+    vector<BTReport::entry>* a_ref
+  )
+  {
+    size_t nJobs = size_t(NDays) * NSets * NParams;
+    double base  = 0.0;
+    for (uint32_t n = 1; ; n = min(2 * n, a_max_threads))
+    {
+      // Best of 3:
+      double                  sec    = 1e30;
+      size_t                  steals = 0;
+      long                    gens   = 0;
+      vector<BTReport::entry> res;
+      for (int r = 0; r < 3; ++r)
+      {
+        double s;
+        res = Run(n, a_env, &s, &steals, &gens);
+        sec = min(sec, s);
+      }
+      if (n == 1)
+        base = sec;
+      if (a_ref->empty())
+        *a_ref = res;
+      else
+      if (!Same(*a_ref, res))
+        throw runtime_error
+              ("MISMATCH: Report with " + to_string(n) + " threads" +
+               (a_env == nullptr ? "" : " and RiskMgr"));
+
+      double up = base / sec;
+      string nm = (a_env == nullptr) ? "Runner/" : "Runner+RiskMgr/";
+      cout << left  << setw(20) << (nm + to_string(n))
+           << right << setw(9)  << fixed << setprecision(1) << (sec * 1e3)
+           << " ms" << setw(14) << setprecision(0) << (double(nJobs) / sec)
+           << setw(10) << setprecision(2) << up
+           << setw(7)  << setprecision(0) << (100.0 * up / n) << '%'
+           << setw(8)  << steals << setw(8) << gens << endl;
+      if (n == a_max_threads)
+        break;
+    }
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  uint32_t maxThreads =
+    (argc >= 2)
+    ? uint32_t(atoi(argv[1]))
+    : max(1u, thread::hardware_concurrency());
+  if (maxThreads == 0)
+  {
+    cerr << "MaxThreads must be positive" << endl;
+    return 1;
+  }
+  RemoveShM(maxThreads);
+  int rc = 0;
+  try
+  {
+    // Instrs for the RiskMgr case: "I<k>/USD", k = set * NInstrs + instr:
+    RMEnv env;
+    env.m_logger = IO::MkLogger("BTRunnerBench_Logger", "stderr");
+    env.m_sdm    = SecDefsMgr::GetPersistInstance(false, Pfx);
+    for (uint32_t k = 0; k < NSets * NInstrs; ++k)
+    {
+      string  asset  = "I" + to_string(k);
+      string  symbol = asset + "/USD";
+      SecDefS sds
+        (0, symbol.data(), "", "", "", "BENCH", "", "", "", asset.data(),
+         "USD", 'A', 1.0, 1.0, 1, 0.01, 'A', 1.0, 0, 0, 0.0, 0, "");
+      env.m_instrs.push_back(&(env.m_sdm->Add(sds, false, 0, 0, 0.0, 0.0)));
+    }
+
+    size_t nJobs = size_t(NDays) * NSets * NParams;
+    cout << nJobs << " jobs, " << (NDays * NSets) << " data sets of "
+         << (2 * NInstrs * PerStream) << " events\n\n"
+         << left  << setw(20) << "Threads" << right << setw(12) << "Time"
+         << setw(14) << "Jobs/s" << setw(10) << "SpeedUp" << setw(8) << "Eff"
+         << setw(8) << "Steals" << setw(8) << "Loads" << '\n'
+         << string(80, '-') << endl;
+
+    vector<BTReport::entry> ref;
+    Scale(maxThreads, nullptr, &ref);
+    Scale(maxThreads, &env,    &ref);
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    rc = 1;
+  }
+  RemoveShM(maxThreads);
+  return rc;
+}
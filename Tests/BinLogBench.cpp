@@ -0,0 +1,310 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/BinLogBench.cpp":                         //
+//        "LOG_*" Macros: Async "spdlog" File Logger vs Binary "BinLog"      //
+//===========================================================================//
+// Usage: BinLogBench [TmpDir (default: /tmp)]
+// (*) Both loggers are made by "IO::MkLogger", as the Connectors make them:
+//     with a file path (async rotating "spdlog" logger, flushed by the macro
+//     after each msg), and with "binlog:" and a file path;
+// (*) Cross-checks that the decoded BinLog file contains the same msgs as
+//     "fmt::format" makes of the same args (incl the truncation of long
+//     strings, and the eager formatting of non-native args);
+// (*) Times the per-call cost of "LOG_INFO" with typical MDC args, and the
+//     distribution (p50 / p99 / p99.9 / max) of the latency of a simulated
+//     MDC update callback which logs at DebugLevel=3, with a few usec of
+//     "network" time between the updates.
+// The output is similar to that of Google Benchmark:
+//
+#include "Basis/Macros.h"
+#include "Basis/IOUtils.hpp"
+#include "Basis/BinLog.h"
+#include <spdlog/fmt/ostr.h>
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <string>
+#include <time.h>
+#include <unistd.h>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  constexpr int  DebugLevel = 3;
+  constexpr long NLat       = 200'000;
+
+  //=========================================================================//
+  // "DoNotOptimize", "Bench", "NanoTime":                                   //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  template<typename F>
+  void Bench(string const& a_name, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    cout << left  << setw(34) << a_name
+         << right << setw(14) << fixed << setprecision(1)
+         << (sec * 1e9 / double(n)) << " ns/call" << endl;
+  }
+
+  inline long NanoTime()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000L + ts.tv_nsec;
+  }
+
+  //=========================================================================//
+  // "MDC": A minimal MktData Connector (as far as logging goes):            //
+  //=========================================================================//
+  struct Update
+  {
+    char   m_symbol[16];
+    long   m_seqNum;
+    bool   m_isBid;
+    double m_px;
+    long   m_qty;
+  };
+
+  // Not a "native" arg, so formatted eagerly by "BinLog":
+  struct Level2
+  {
+    double m_px;
+    long   m_qty;
+  };
+
+  inline ostream& operator<<(ostream& a_os, Level2 const& a_l)
+    { return a_os << a_l.m_qty << '@' << a_l.m_px; }
+
+  class MDC
+  {
+  public:
+    spdlog::logger* m_logger;
+    int             m_debugLevel;
+    double          m_bestBid = 0.0;
+    double          m_bestAsk = 0.0;
+
+    MDC(spdlog::logger* a_logger, int a_debug_level)
+    : m_logger(a_logger), m_debugLevel(a_debug_level) {}
+
+    void LogTick(Update const& a_upd)
+    {
+      LOG_INFO(3,
+        "MDC::OnUpdate: {}: SeqNum={}, {}: Px={}, Qty={}",
+        a_upd.m_symbol, a_upd.m_seqNum, a_upd.m_isBid ? "Bid" : "Ask",
+        a_upd.m_px,     a_upd.m_qty)
+    }
+
+    void OnUpdate(Update const& a_upd)
+    {
+      double& best = a_upd.m_isBid ? m_bestBid : m_bestAsk;
+      bool    imp  = a_upd.m_isBid ? (a_upd.m_px > best)
+                                   : (a_upd.m_px < best);
+      if (imp || best == 0.0)
+        best = a_upd.m_px;
+      LogTick(a_upd);
+      if (utxx::unlikely(m_bestBid >= m_bestAsk && m_bestAsk != 0.0))
+        LOG_WARN(2, "MDC::OnUpdate: {}: Crossed: Bid={}, Ask={}",
+                 a_upd.m_symbol, m_bestBid, m_bestAsk)
+    }
+
+    void LogLevel2(char const* a_symbol, Level2 const& a_l)
+      { LOG_INFO(3, "MDC::Level2: {}: {}", a_symbol, a_l) }
+
+    void LogLong(string const& a_str)
+      { LOG_INFO(3, "MDC::Long: {}: {}", 1, a_str) }
+  };
+
+  vector<Update> MkUpdates(long a_n)
+  {
+    mt19937_64     rng(12345);
+    vector<Update> res(static_cast<size_t>(a_n));
+    double         px = 1.1;
+    for (long i = 0; i < a_n; ++i)
+    {
+      Update& u  = res[size_t(i)];
+      px        += (double(rng() % 21) - 10.0) * 1e-5;
+      strcpy(u.m_symbol, (i % 3 == 0) ? "EUR/USD" : "USD/JPY");
+      u.m_seqNum = 1'000'000 + i;
+      u.m_isBid  = (rng() % 2 == 0);
+      u.m_px     = u.m_isBid ? px - 5e-5 : px + 5e-5;
+      u.m_qty    = long(1 + rng() % 100) * 10'000;
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // "Latencies": Of "OnUpdate", spaced out by ~5 usec:                      //
+  //=========================================================================//
+  void Latencies(string const& a_name, MDC* a_mdc,
+                 vector<Update> const& a_upds)
+  {
+    vector<long> lats(a_upds.size());
+    for (size_t i = 0; i < a_upds.size(); ++i)
+    {
+      long t0 = NanoTime();
+      a_mdc->OnUpdate(a_upds[i]);
+      long t1 = NanoTime();
+      lats[i] = t1 - t0;
+      while (NanoTime() - t1 < 5'000) ;
+    }
+    sort(lats.begin(), lats.end());
+    size_t n   = lats.size();
+    auto   pct = [&](double a_p)
+      { return lats[min(n - 1, size_t(a_p * double(n)))]; };
+
+    cout << left  << setw(22) << a_name << right
+         << setw(10) << pct(0.5)  << setw(10) << pct(0.99)
+         << setw(10) << pct(0.999) << setw(12) << lats.back() << endl;
+  }
+
+  //=========================================================================//
+  // "TmpDir": Removes the log files on exit:                                //
+  //=========================================================================//
+  struct TmpDir
+  {
+    filesystem::path m_root;
+
+    explicit TmpDir(string const& a_dir)
+    : m_root(filesystem::path(a_dir) /
+             ("BinLogBench." + to_string(getpid())))
+    { filesystem::create_directories(m_root); }
+
+    ~TmpDir()
+    {
+      error_code ec;
+      filesystem::remove_all(m_root, ec);
+    }
+  };
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    TmpDir         dir((argc >= 2) ? argv[1] : "/tmp");
+    string const   txtPath = (dir.m_root / "mdc.log").string();
+    string const   binPath = (dir.m_root / "mdc.blog").string();
+    vector<Update> upds    = MkUpdates(NLat);
+
+    shared_ptr<spdlog::logger> txtLog =
+      IO::MkLogger("BinLogBench-Txt", txtPath);
+    shared_ptr<spdlog::logger> binLog =
+      IO::MkLogger("BinLogBench-Bin", "binlog:" + binPath);
+
+    MDC txt(txtLog.get(), DebugLevel);
+    MDC bin(binLog.get(), DebugLevel);
+    MDC off(binLog.get(), DebugLevel - 1);
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    {
+      vector<string> exp;
+      for (size_t i = 0; i < 1'000; ++i)
+      {
+        Update const& u = upds[i];
+        bin.LogTick(u);
+        exp.push_back(fmt::format
+          ("MDC::OnUpdate: {}: SeqNum={}, {}: Px={}, Qty={}",
+           u.m_symbol, u.m_seqNum, u.m_isBid ? "Bid" : "Ask", u.m_px,
+           u.m_qty));
+      }
+      Level2 l2{1.2345, 500};
+      bin.LogLevel2("EUR/USD", l2);
+      exp.push_back(fmt::format("MDC::Level2: {}: {}", "EUR/USD", l2));
+
+      // The string is truncated to fit into a record (after the int arg: tag
+      // and 8 bytes, and the string tag and length: 3 bytes):
+      string longStr(2 * BinLog::MaxRecSize, 'x');
+      bin.LogLong(longStr);
+      exp.push_back("MDC::Long: 1: " +
+                    longStr.substr(0, BinLog::MaxPayload - 9 - 3));
+
+      // Direct calls on the logger are passed on as text:
+      binLog->warn("Direct: {}", 42);
+      exp.push_back("Direct: 42");
+
+      BinLog::Flush();
+      ifstream      in(binPath, ios::in | ios::binary);
+      ostringstream out;
+      BinLog::Decode(in, out);
+
+      istringstream lines(out.str());
+      string        line;
+      size_t        n = 0;
+      while (getline(lines, line))
+      {
+        // Skip "[Time] [Name] [Level] ":
+        size_t pos = line.find("] [", line.find("] [") + 3);
+        pos        = (pos == string::npos) ? pos : line.find("] ", pos + 3);
+        string msg = (pos == string::npos) ? line : line.substr(pos + 2);
+        if (n < exp.size() && msg == exp[n])
+        {
+          ++n;
+          continue;
+        }
+        cerr << "MISMATCH: Msg " << n << ":\n  " << msg << "\nvs\n  "
+             << ((n < exp.size()) ? exp[n] : string("(none)")) << endl;
+        return 1;
+      }
+      if (n != exp.size())
+      {
+        cerr << "MISMATCH: Decoded " << n << " msgs, expected " << exp.size()
+             << endl;
+        return 1;
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // Per-Call Cost (back-to-back calls):                                   //
+    //-----------------------------------------------------------------------//
+    cout << left  << setw(34) << "Benchmark" << right << setw(19) << "Time\n"
+         << string(56, '-') << endl;
+    size_t i = 0;
+    Bench("LOG_INFO/Disabled",  [&] { off.LogTick(upds[i++ % upds.size()]); });
+    Bench("LOG_INFO/SpdLog",    [&] { txt.LogTick(upds[i++ % upds.size()]); });
+    Bench("LOG_INFO/BinLog",    [&] { bin.LogTick(upds[i++ % upds.size()]); });
+    BinLog::Flush();
+
+    //-----------------------------------------------------------------------//
+    // Tail Latency of the MDC callback:                                     //
+    //-----------------------------------------------------------------------//
+    cout << '\n' << left << setw(22) << "OnUpdate (ns)" << right << setw(10)
+         << "p50" << setw(10) << "p99" << setw(10) << "p99.9" << setw(12)
+         << "max" << '\n' << string(64, '-') << endl;
+    Latencies("Disabled", &off, upds);
+    Latencies("SpdLog",   &txt, upds);
+    Latencies("BinLog",   &bin, upds);
+    BinLog::Flush();
+    txtLog->flush();
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
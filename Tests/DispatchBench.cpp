@@ -0,0 +1,114 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Tests/DispatchBench.cpp":                        //
+//   Per-Event Call-Back Dispatch Cost: Thunks vs "std::function" in FDInfo  //
+//===========================================================================//
+#include "Basis/IOUtils.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "Conn": A Connector-like Call-Back Target:                              //
+  //=========================================================================//
+  class Conn
+  {
+  public:
+    long  m_bytesRx = 0;
+    long  m_nCalls  = 0;
+
+    int OnRead(int, char const*, int a_size, utxx::time_val)
+    {
+      m_bytesRx += a_size;
+      ++m_nCalls;
+      return a_size;
+    }
+  };
+
+  //=========================================================================//
+  // "RunOnce":                                                              //
+  //=========================================================================//
+  // Invokes the "ReadHandler"s installed in "a_handlers" in the round-robin
+  // order (as the Reactor would do for events on different FDs), so the call
+  // target is not known at compile time. Returns ns per event:
+  //
+  double RunOnce
+  (
+    vector<IO::FDInfo::ReadHandler> const& a_handlers,
+    long                                   a_n
+  )
+  {
+    char           buff[64];
+    utxx::time_val ts   = utxx::now_utc();
+    size_t         nH   = a_handlers.size();
+    long           sum  = 0;
+
+    utxx::time_val from = utxx::now_utc();
+    for (long i = 0; i < a_n; ++i)
+    {
+      size_t fd = size_t(i) % nH;
+      sum += a_handlers[fd](int(fd), buff, int(i & 63), ts);
+    }
+    utxx::time_val to   = utxx::now_utc();
+
+    // Prevent the loop from being optimised away:
+    if (sum < 0)
+      cerr << sum << endl;
+    return double((to - from).nanoseconds()) / double(a_n);
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NEvents [NFDs]]:
+  long n   = (argc >= 2) ? atol(argv[1]) : 100000000;
+  int  nfd = (argc >= 3) ? atoi(argv[2]) : 16;
+
+  if (n <= 0 || nfd <= 0)
+  {
+    cerr << "PARAMETERS: [NEvents [NFDs]]" << endl;
+    return 1;
+  }
+  vector<Conn> conns(static_cast<size_t>(nfd));
+
+  // Static Dispatch (Thunks):
+  vector<IO::FDInfo::ReadHandler> thunks;
+  for (Conn& conn: conns)
+    thunks.push_back(IO::MkThunk<&Conn::OnRead>(&conn));
+
+  // Dynamic Dispatch ("std::function" wrapping a capturing Lambda, as was used
+  // by the Connectors before):
+  vector<IO::FDInfo::ReadHandler> funcs;
+  for (Conn& conn: conns)
+  {
+    Conn* c = &conn;
+    funcs.push_back
+    (
+      [c](int a_fd, char const* a_buff, int a_size, utxx::time_val a_ts)
+      -> int
+      { return c->OnRead(a_fd, a_buff, a_size, a_ts); }
+    );
+  }
+  assert(thunks[0].IsStatic() && !funcs[0].IsStatic());
+
+  // Warm-up, then the actual runs:
+  (void) RunOnce(thunks, n / 10);
+  (void) RunOnce(funcs,  n / 10);
+
+  double nsThunk = RunOnce(thunks, n);
+  double nsFunc  = RunOnce(funcs,  n);
+
+  cout << "Events=" << n << ", FDs=" << nfd         << '\n'
+       << "Thunk        : " << nsThunk << " ns/event" << '\n'
+       << "std::function: " << nsFunc  << " ns/event" << endl;
+  return 0;
+}
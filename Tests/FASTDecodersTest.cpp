@@ -0,0 +1,654 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "Tests/FASTDecodersTest.cpp":                      //
+//     Generated FAST Decoders vs Hand-Written Ones: Conformance, Speed      //
+//===========================================================================//
+// Streams of FAST msgs are encoded by a minimal reference encoder (below) for
+// FORTS "OrdersLogIncrRefresh", "OrdersLogSnapShot", "SecurityStatus", "Trad-
+// ingSessionStatus" and MICEX "IncrementalRefresh" (EQ and FX, which use Copy
+// operators in Sequence Entries with their own PMaps), with random NULLs and
+// Copy omissions. Each msg is decoded by the hand-written and by the generated
+// ("Tools/MkFASTDecoders.py") decoders into the same "Msgs_*" structs, and the
+// results (incl the consumed lengths) are compared. Then the throughput of the
+// decoders is measured; the generated ones are also run on "slim" Msg structs
+// containing only the flds used by a typical Strategy (others are SkipVal'ed):
+//
+#include "Protocols/FAST/Decoder_FORTS_Curr.h"
+#include "Protocols/FAST/Decoder_MICEX_Curr.h"
+#include "Protocols/FAST/Decoders_FORTS_Curr.hpp"
+#include "Protocols/FAST/Decoders_MICEX_Curr.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace MAQUETTE::FAST;
+using namespace std;
+
+namespace
+{
+  namespace FF   = ::MAQUETTE::FAST::FORTS;
+  namespace FM   = ::MAQUETTE::FAST::MICEX;
+  using FVer     = FF::ProtoVerT;
+  using MVer     = FM::ProtoVerT;
+  using MAC      = ::MAQUETTE::MICEX::AssetClassT;
+  using FOLIncr  = FF::OrdersLogIncrRefresh<FVer::Curr>;
+  using FOLSnap  = FF::OrdersLogSnapShot   <FVer::Curr>;
+  using FSecStat = FF::SecurityStatus      <FVer::Curr>;
+  using FTSStat  = FF::TradingSessionStatus<FVer::Curr>;
+  using MIncr    = FM::IncrementalRefresh  <MVer::Curr>;
+
+  //=========================================================================//
+  // "Enc": Minimal FAST Encoder:                                            //
+  //=========================================================================//
+  class Enc
+  {
+  private:
+    vector<char>  m_buff;
+    vector<bool>  m_pmap;   // PMap bits of the curr Msg or Entry
+    vector<char>  m_body;   // Flds following that PMap
+
+    void PutStop(char const* a_tmp, int a_n)
+    {
+      for (int k = a_n - 1; k >= 0; --k)
+        m_body.push_back(char(a_tmp[k] | ((k == 0) ? '\x80' : '\0')));
+    }
+
+  public:
+    // "Begin": A new Msg or Sequence Entry (the latter with own PMap or not):
+    void Begin() { m_pmap.clear(); m_body.clear(); }
+
+    // "Flush": Emit the PMap (if any) and the Body:
+    void Flush(bool a_with_pmap)
+    {
+      if (a_with_pmap)
+      {
+        size_t nb = max<size_t>(1, (m_pmap.size() + 6) / 7);
+        for (size_t b = 0; b < nb; ++b)
+        {
+          char c = '\0';
+          for (size_t j = 0; j < 7; ++j)
+            if (7 * b + j < m_pmap.size() && m_pmap[7 * b + j])
+              c = char(c | (1 << (6 - j)));
+          m_buff.push_back(char(c | ((b == nb - 1) ? '\x80' : '\0')));
+        }
+      }
+      m_buff.insert(m_buff.end(), m_body.begin(), m_body.end());
+      Begin();
+    }
+
+    void Bit(bool a_on) { m_pmap.push_back(a_on); }
+
+    void U(uint64_t a_v, bool a_nullable)
+    {
+      a_v += a_nullable;
+      char tmp[10];
+      int  n = 0;
+      do { tmp[n++] = char(a_v & 0x7f); a_v >>= 7; } while (a_v != 0);
+      PutStop(tmp, n);
+    }
+
+    void S(int64_t a_v, bool a_nullable)
+    {
+      if (a_nullable && a_v >= 0)
+        ++a_v;
+      char tmp[10];
+      int  n = 0;
+      while (true)
+      {
+        tmp[n++]     = char(a_v & 0x7f);
+        int64_t rest = a_v >> 7;
+        bool    sgn  = (tmp[n-1] & '\x40') != 0;
+        if ((rest == 0 && !sgn) || (rest == -1 && sgn))
+          break;
+        a_v = rest;
+      }
+      PutStop(tmp, n);
+    }
+
+    void Null() { m_body.push_back('\x80'); }
+
+    void Str(string const& a_s)
+    {
+      assert(!a_s.empty());
+      for (char c: a_s)
+        m_body.push_back(char(c & '\x7f'));
+      m_body.back() = char(m_body.back() | '\x80');
+    }
+
+    // Old-style (single-fld) Decimal:
+    void Dec(int a_exp, int64_t a_mant, bool a_nullable)
+    {
+      int e = (a_nullable && a_exp >= 0) ? (a_exp + 1) : a_exp;
+      m_body.push_back(char((e & 0x7f) | 0x80));
+      S(a_mant, false);
+    }
+
+    vector<char>& Buff() { return m_buff; }
+  };
+
+  //=========================================================================//
+  // Random Flds:                                                            //
+  //=========================================================================//
+  mt19937_64 g_rng(20171);
+
+  long   Rnd(long a_n)  { return long(g_rng() % uint64_t(a_n)); }
+  bool   IsNull()       { return Rnd(5) == 0; }
+  string RndStr(int a_maxLen)
+  {
+    string s(size_t(1 + Rnd(a_maxLen)), 'A');
+    for (char& c: s)
+      c = char('A' + Rnd(26));
+    return s;
+  }
+
+  // Optional flds, NULL with Prob=0.2:
+  void OptU(Enc* a_e, uint64_t a_v)
+    { if (IsNull()) a_e->Null(); else a_e->U(a_v, true); }
+  void OptS(Enc* a_e, int64_t  a_v)
+    { if (IsNull()) a_e->Null(); else a_e->S(a_v, true); }
+  void OptDec(Enc* a_e)
+  {
+    if (IsNull())
+      a_e->Null();
+    else
+      a_e->Dec(-int(Rnd(5)), Rnd(1000000), true);
+  }
+  void OptStr(Enc* a_e, int a_maxLen)
+    { if (IsNull()) a_e->Null(); else a_e->Str(RndStr(a_maxLen)); }
+
+  void Header(Enc* a_e, TID a_tid)
+  {
+    a_e->Begin();
+    a_e->Bit(true);            // TID
+    a_e->U(a_tid, false);
+    a_e->U(uint64_t(Rnd(1000000)), false);               // MsgSeqNum
+    a_e->U(20171030120000000UL + uint64_t(Rnd(1000)), false); // SendingTime
+  }
+
+  //=========================================================================//
+  // Msg Encoders:                                                           //
+  //=========================================================================//
+  void MkFOLIncr(Enc* a_e, TID a_tid)
+  {
+    Header(a_e, a_tid);
+    int n = 1 + int(Rnd(20));
+    a_e->U(1, false);                                    // LastFragment
+    a_e->U(uint64_t(n), false);                          // NoMDEntries
+    a_e->Flush(true);
+    for (int i = 0; i < n; ++i)
+    {
+      a_e->U(uint64_t(Rnd(3)), false);                   // MDUpdateAction
+      a_e->Str(Rnd(2) ? "0" : "1");                      // MDEntryType
+      OptS(a_e, Rnd(1L << 40));                          // MDEntryID
+      OptU(a_e, uint64_t(Rnd(1L << 30)));                // SecurityID
+      OptU(a_e, uint64_t(Rnd(1L << 20)));                // RptSeq
+      OptU(a_e, 20171030);                               // MDEntryDate
+      a_e->U(uint64_t(Rnd(1L << 40)), false);            // MDEntryTime
+      OptDec(a_e);                                       // MDEntryPx
+      OptS(a_e, Rnd(1000));                              // MDEntrySize
+      OptDec(a_e);                                       // LastPx
+      OptS(a_e, Rnd(1000));                              // LastQty
+      OptS(a_e, Rnd(1L << 40));                          // TradeID
+      OptU(a_e, uint64_t(Rnd(10000)));                   // ExchTrSessID
+      OptS(a_e, Rnd(1L << 40) - (1L << 39));             // MDFlags
+      OptU(a_e, uint64_t(Rnd(1L << 40)));                // Revision
+      a_e->Flush(false);
+    }
+  }
+
+  void MkFOLSnap(Enc* a_e, TID a_tid)
+  {
+    Header(a_e, a_tid);
+    int n = 1 + int(Rnd(20));
+    a_e->U(uint64_t(Rnd(1000000)), false);               // LastMsgSeqNumPr
+    OptU(a_e, uint64_t(Rnd(1000000)));                   // RptSeq
+    a_e->U(uint64_t(Rnd(2)), false);                     // LastFragment
+    a_e->U(uint64_t(Rnd(2)), false);                     // RouteFirst
+    a_e->U(uint64_t(Rnd(10000)), false);                 // ExchTrSessID
+    OptU(a_e, uint64_t(Rnd(1L << 30)));                  // SecurityID
+    a_e->U(uint64_t(n), false);                          // NoMDEntries
+    a_e->Flush(true);
+    for (int i = 0; i < n; ++i)
+    {
+      a_e->Str(Rnd(2) ? "0" : "1");                      // MDEntryType
+      OptS(a_e, Rnd(1L << 40));                          // MDEntryID
+      OptU(a_e, 20171030);                               // MDEntryDate
+      a_e->U(uint64_t(Rnd(1L << 40)), false);            // MDEntryTime
+      OptDec(a_e);                                       // MDEntryPx
+      OptS(a_e, Rnd(1000));                              // MDEntrySize
+      OptS(a_e, Rnd(1L << 40));                          // TradeID
+      OptS(a_e, Rnd(1L << 40));                          // MDFlags
+      a_e->Flush(false);
+    }
+  }
+
+  void MkFSecStat(Enc* a_e, TID a_tid)
+  {
+    Header(a_e, a_tid);
+    a_e->U(uint64_t(Rnd(1L << 30)), false);              // SecurityID
+    a_e->Str(RndStr(15));                                // Symbol
+    OptU(a_e, uint64_t(Rnd(30)));                        // SecTrStatus
+    for (int k = 0; k < 5; ++k)
+      OptDec(a_e);                                       // Limits, Margins
+    a_e->Flush(true);
+  }
+
+  void MkFTSStat(Enc* a_e, TID a_tid)
+  {
+    Header(a_e, a_tid);
+    a_e->U(uint64_t(Rnd(1L << 50)), false);              // TrSesOpenTime
+    a_e->U(uint64_t(Rnd(1L << 50)), false);              // TrSesCloseTime
+    OptU(a_e, uint64_t(Rnd(1L << 50)));                  // ClrStartTime
+    OptU(a_e, uint64_t(Rnd(1L << 50)));                  // ClrEndTime
+    a_e->U(uint64_t(Rnd(10000)), false);                 // TrSessID
+    OptU(a_e, uint64_t(Rnd(10000)));                     // ExchTrSessID
+    a_e->U(uint64_t(Rnd(10)), false);                    // TrSesStatus
+    a_e->Str(RndStr(15));                                // MktSegmentID
+    OptS(a_e, Rnd(100) - 50);                            // TrSesEvent
+    a_e->Flush(true);
+  }
+
+  // MICEX "IncrementalRefresh": Copy flds are omitted (PMap bit 0) with Prob
+  // 1/2 for all Entries but the 1st one:
+  template<MAC::type AC>
+  void MkMIncr(Enc* a_e, TID a_tid)
+  {
+    Header(a_e, a_tid);
+    int n = 1 + int(Rnd(20));
+    a_e->U(uint64_t(n), false);                          // NoMDEntries
+    a_e->Flush(true);
+
+    for (int i = 0; i < n; ++i)
+    {
+      auto copyU = [&](uint64_t a_v)
+      {
+        bool on = (i == 0 || Rnd(2));
+        a_e->Bit(on);
+        if (on)
+          a_e->U(a_v, true);
+      };
+      auto copyDec = [&]()
+      {
+        bool on = (i == 0 || Rnd(2));
+        a_e->Bit(on);
+        if (on)
+          a_e->Dec(-int(Rnd(4)), Rnd(100000), true);
+      };
+      auto copyStr = [&](int a_maxLen)
+      {
+        bool on = (i == 0 || Rnd(2));
+        a_e->Bit(on);
+        if (on)
+          a_e->Str(RndStr(a_maxLen));
+      };
+      if constexpr (AC == MAC::EQ)
+        OptU(a_e, uint64_t(Rnd(3)));                     // MDUpdateAction
+      else
+        copyU(uint64_t(Rnd(3)));
+      copyStr(1);                                        // MDEntryType
+      OptStr(a_e, 15);                                   // MDEntryID
+      copyStr(10);                                       // Symbol
+      OptS  (a_e, Rnd(1L << 30));                        // RptSeq
+      copyU (20171030);                                  // MDEntryDate
+      copyU (uint64_t(Rnd(1L << 30)));                   // MDEntryTime
+      copyU (uint64_t(Rnd(1L << 30)));                   // OrigTime
+      copyDec();                                         // MDEntryPx
+      copyDec();                                         // MDEntrySize
+      if constexpr (AC == MAC::EQ)
+        copyDec();                                       // Yield
+      copyStr(3);                                        // OrderStatus
+      if constexpr (AC == MAC::EQ)
+      {
+        copyStr(1);                                      // OrdType
+        copyDec();                                       // TotalVolume
+      }
+      copyStr(4);                                        // TradingSessionID
+      copyStr(4);                                        // TrSessSubID
+      a_e->Flush(true);
+    }
+  }
+
+  //=========================================================================//
+  // Comparisons:                                                            //
+  //=========================================================================//
+  template<typename T>
+  bool Same(T const& a_x, T const& a_y)   { return a_x == a_y; }
+
+  bool Same(Decimal const& a_x, Decimal const& a_y)
+    { return a_x.m_exp == a_y.m_exp && a_x.m_mant == a_y.m_mant; }
+
+  template<size_t N>
+  bool Same(char const (&a_x)[N], char const (&a_y)[N])
+    { return strncmp(a_x, a_y, N) == 0; }
+
+# define SAME(Fld) ok &= Same(a_x.Fld, a_y.Fld)
+
+  bool Same(FOLIncr const& a_x, FOLIncr const& a_y)
+  {
+    bool ok = true;
+    SAME(m_MsgSeqNum);  SAME(m_LastFragment);  SAME(m_NoMDEntries);
+    for (unsigned i = 0; ok && i < a_x.m_NoMDEntries; ++i)
+    {
+      auto const& x = a_x.m_MDEntries[i];
+      auto const& y = a_y.m_MDEntries[i];
+      ok = Same(x.m_MDUpdateAction, y.m_MDUpdateAction) &&
+           Same(x.m_MDEntryType,    y.m_MDEntryType)    &&
+           Same(x.m_MDEntryID,      y.m_MDEntryID)      &&
+           Same(x.m_SecurityID,     y.m_SecurityID)     &&
+           Same(x.m_RptSeq,         y.m_RptSeq)         &&
+           Same(x.m_MDEntryDate,    y.m_MDEntryDate)    &&
+           Same(x.m_MDEntryTime,    y.m_MDEntryTime)    &&
+           Same(x.m_MDEntryPx,      y.m_MDEntryPx)      &&
+           Same(x.m_MDEntrySize,    y.m_MDEntrySize)    &&
+           Same(x.m_LastPx,         y.m_LastPx)         &&
+           Same(x.m_LastQty,        y.m_LastQty)        &&
+           Same(x.m_TradeID,        y.m_TradeID)        &&
+           Same(x.m_MDFlags,        y.m_MDFlags)        &&
+           Same(x.m_Revision,       y.m_Revision)       &&
+           Same(x.m_ExchangeTradingSessionID,
+                y.m_ExchangeTradingSessionID);
+    }
+    return ok;
+  }
+
+  bool Same(FOLSnap const& a_x, FOLSnap const& a_y)
+  {
+    bool ok = true;
+    SAME(m_MsgSeqNum);    SAME(m_LastMsgSeqNumProcessed); SAME(m_RptSeq);
+    SAME(m_LastFragment); SAME(m_RouteFirst);  SAME(m_SecurityID);
+    SAME(m_ExchangeTradingSessionID);          SAME(m_NoMDEntries);
+    for (unsigned i = 0; ok && i < a_x.m_NoMDEntries; ++i)
+    {
+      auto const& x = a_x.m_MDEntries[i];
+      auto const& y = a_y.m_MDEntries[i];
+      ok = Same(x.m_MDEntryType,    y.m_MDEntryType)    &&
+           Same(x.m_MDEntryID,      y.m_MDEntryID)      &&
+           Same(x.m_MDEntryDate,    y.m_MDEntryDate)    &&
+           Same(x.m_MDEntryTime,    y.m_MDEntryTime)    &&
+           Same(x.m_MDEntryPx,      y.m_MDEntryPx)      &&
+           Same(x.m_MDEntrySize,    y.m_MDEntrySize)    &&
+           Same(x.m_TradeID,        y.m_TradeID)        &&
+           Same(x.m_MDFlags,        y.m_MDFlags);
+    }
+    return ok;
+  }
+
+  bool Same(FSecStat const& a_x, FSecStat const& a_y)
+  {
+    bool ok = true;
+    SAME(m_MsgSeqNum);    SAME(m_SecurityID);  SAME(m_Symbol);
+    SAME(m_SecurityTradingStatus);  SAME(m_HighLimitPx); SAME(m_LowLimitPx);
+    SAME(m_InitialMarginOnBuy);     SAME(m_InitialMarginOnSell);
+    SAME(m_InitialMarginSyntetic);
+    return ok;
+  }
+
+  bool Same(FTSStat const& a_x, FTSStat const& a_y)
+  {
+    bool ok = true;
+    SAME(m_MsgSeqNum);    SAME(m_TradSesOpenTime);  SAME(m_TradSesCloseTime);
+    SAME(m_TradSesIntermClearingStartTime);
+    SAME(m_TradSesIntermClearingEndTime);
+    SAME(m_TradingSessionID);   SAME(m_ExchangeTradingSessionID);
+    SAME(m_TradSesStatus);      SAME(m_MarketSegmentID);  SAME(m_TradSesEvent);
+    return ok;
+  }
+
+  bool Same(MIncr const& a_x, MIncr const& a_y)
+  {
+    bool ok = true;
+    SAME(m_MsgSeqNum);  SAME(m_NoMDEntries);
+    for (unsigned i = 0; ok && i < a_x.m_NoMDEntries; ++i)
+    {
+      auto const& x = a_x.m_MDEntries[i];
+      auto const& y = a_y.m_MDEntries[i];
+      ok = Same(x.m_MDUpdateAction, y.m_MDUpdateAction) &&
+           Same(x.m_MDEntryType,    y.m_MDEntryType)    &&
+           Same(x.m_MDEntryID,      y.m_MDEntryID)      &&
+           Same(x.m_Symbol,         y.m_Symbol)         &&
+           Same(x.m_RptSeq,         y.m_RptSeq)         &&
+           Same(x.m_MDEntryDate,    y.m_MDEntryDate)    &&
+           Same(x.m_MDEntryTime,    y.m_MDEntryTime)    &&
+           Same(x.m_OrigTime,       y.m_OrigTime)       &&
+           Same(x.m_MDEntryPx,      y.m_MDEntryPx)      &&
+           Same(x.m_MDEntrySize,    y.m_MDEntrySize)    &&
+           Same(x.m_TradingSessionID, y.m_TradingSessionID);
+    }
+    return ok;
+  }
+# undef SAME
+
+  //=========================================================================//
+  // "Slim" Msgs: Only the flds used by an OrderBook-building Strategy:      //
+  //=========================================================================//
+  struct SlimFOLIncr
+  {
+    struct MDEntry
+    {
+      uint32_t  m_MDUpdateAction;
+      char      m_MDEntryType[4];
+      int64_t   m_MDEntryID;
+      uint64_t  m_SecurityID;
+      Decimal   m_MDEntryPx;
+      int64_t   m_MDEntrySize;
+      int64_t   m_MDFlags;
+    };
+    uint32_t    m_MsgSeqNum;
+    uint32_t    m_NoMDEntries;
+    MDEntry     m_MDEntries[128];
+  };
+
+  struct SlimMIncr
+  {
+    struct MDEntry
+    {
+      uint32_t  m_MDUpdateAction;
+      char      m_MDEntryType[4];
+      char      m_Symbol[16];
+      Decimal   m_MDEntryPx;
+      Decimal   m_MDEntrySize;
+    };
+    uint32_t    m_MsgSeqNum;
+    uint32_t    m_NoMDEntries;
+    MDEntry     m_MDEntries[128];
+  };
+
+  //=========================================================================//
+  // "Stream": Encoded Msgs:                                                 //
+  //=========================================================================//
+  struct Stream
+  {
+    vector<char>    m_data;
+    vector<size_t>  m_offs;   // Msg boundaries, incl the final one
+  };
+
+  template<typename MkF>
+  Stream MkStream(long a_n, MkF a_mk, TID a_tid)
+  {
+    Enc    e;
+    Stream s;
+    for (long k = 0; k < a_n; ++k)
+    {
+      s.m_offs.push_back(e.Buff().size());
+      a_mk(&e, a_tid);
+    }
+    s.m_offs.push_back(e.Buff().size());
+    s.m_data = move(e.Buff());
+    return s;
+  }
+
+  //=========================================================================//
+  // "Check": Conformance of the Generated Decoder to the Hand-Written One:  //
+  //=========================================================================//
+  // "a_hand" and "a_gen" take (Msg*, buff, end, pmap) and return the end ptr:
+  //
+  template<typename Msg, typename Hand, typename Gen>
+  bool Check(char const* a_title, Stream const& a_s, TID a_tid,
+             Hand a_hand, Gen a_gen)
+  {
+    auto x   = make_unique<Msg>();
+    auto y   = make_unique<Msg>();
+    long bad = 0;
+    size_t n = a_s.m_offs.size() - 1;
+
+    for (size_t k = 0; k < n; ++k)
+    {
+      char const* from = a_s.m_data.data() + a_s.m_offs[k];
+      char const* end  = a_s.m_data.data() + a_s.m_offs[k+1];
+      PMap        pmap = 0;
+      TID         tid  = 0;
+      char const* body = GetMsgHeader(from, end, &pmap, &tid, a_title);
+      if (tid != a_tid)
+        { ++bad; continue; }
+
+      // Different garbage in both objs before decoding:
+      memset(x.get(), 0x00, sizeof(Msg));
+      memset(y.get(), 0x5a, sizeof(Msg));
+      char const* endX = a_hand(x.get(), body, end, pmap);
+      char const* endY = a_gen (y.get(), body, end, pmap);
+      bad += (endX != end || endY != end || !Same(*x, *y));
+    }
+    cout << "Conformance: " << setw(24) << left << a_title << right
+         << ": Msgs=" << n << ", Mismatches=" << bad << endl;
+    return (bad == 0);
+  }
+
+  //=========================================================================//
+  // "Time": ns/Msg:                                                         //
+  //=========================================================================//
+  template<typename Msg, typename Dec>
+  double Time(Stream const& a_s, int a_rounds, Dec a_dec)
+  {
+    auto   msg = make_unique<Msg>();
+    size_t n   = a_s.m_offs.size() - 1;
+    long   chk = 0;
+    utxx::time_val from = utxx::now_utc();
+
+    for (int r = 0; r < a_rounds; ++r)
+      for (size_t k = 0; k < n; ++k)
+      {
+        char const* buff = a_s.m_data.data() + a_s.m_offs[k];
+        char const* end  = a_s.m_data.data() + a_s.m_offs[k+1];
+        PMap        pmap = 0;
+        TID         tid  = 0;
+        char const* body = GetMsgHeader(buff, end, &pmap, &tid, "Time");
+        chk += (a_dec(msg.get(), body, end, pmap) - buff);
+        chk += msg->m_MsgSeqNum;
+      }
+    double sec = (utxx::now_utc() - from).seconds();
+    if (chk == 0)
+      cout << "???" << endl;   // Prevent the loop from being optimised away
+    return sec * 1e9 / double(n * size_t(a_rounds));
+  }
+
+  template<typename Msg, typename Slim, typename Hand, typename Gen>
+  void Bench(char const* a_title, Stream const& a_s, int a_rounds,
+             Hand a_hand, Gen a_gen)
+  {
+    (void) Time<Msg>(a_s, 1, a_hand);   // Warm-up
+    double hand = Time<Msg> (a_s, a_rounds, a_hand);
+    double gen  = Time<Msg> (a_s, a_rounds, a_gen);
+    double slim = Time<Slim>(a_s, a_rounds, a_gen);
+    cout << "Throughput : " << setw(24) << left << a_title << right
+         << ": Hand-Written=" << setw(7) << hand  << " ns/msg, Generated="
+         << setw(7) << gen << " ns/msg, Generated(Slim)=" << setw(7) << slim
+         << " ns/msg" << endl;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NMsgs [NRounds]]:
+  long nMsgs   = (argc >= 2) ? atol(argv[1]) : 20000;
+  int  nRounds = (argc >= 3) ? atoi(argv[2]) : 20;
+  if (nMsgs <= 0 || nRounds <= 0)
+  {
+    cerr << "PARAMETERS: [NMsgs [NRounds]]" << endl;
+    return 1;
+  }
+  try
+  {
+    namespace FG = FF::Generated;
+    namespace MG = FM::Generated;
+
+    // The Generated TIDs must be the same as the Hand-Written ones:
+    static_assert(FG::OrdersLogIncrRefreshTID ==
+                  FF::OrdersLogIncrRefreshTID<FVer::Curr>());
+    static_assert(FG::OrdersLogSnapShotTID    ==
+                  FF::OrdersLogSnapShotTID<FVer::Curr>());
+
+    Stream folIncr = MkStream(nMsgs, MkFOLIncr, FG::OrdersLogIncrRefreshTID);
+    Stream folSnap = MkStream(nMsgs, MkFOLSnap, FG::OrdersLogSnapShotTID);
+    Stream fSecSt  = MkStream(nMsgs, MkFSecStat, FG::SecurityStatusTID);
+    Stream fTSSt   = MkStream(nMsgs, MkFTSStat,  FG::TradingSessionStatusTID);
+    Stream mIncrEQ =
+      MkStream(nMsgs, MkMIncr<MAC::EQ>, MG::IncrementalRefresh_EQTID);
+    Stream mIncrFX =
+      MkStream(nMsgs, MkMIncr<MAC::FX>, MG::IncrementalRefresh_FXTID);
+
+    //-----------------------------------------------------------------------//
+    // Conformance:                                                          //
+    //-----------------------------------------------------------------------//
+    auto hDecode  = [](auto* m, char const* b, char const* e, PMap p)
+      { return m->Decode(b, e, p); };
+    auto hMIncrEQ = [](auto* m, char const* b, char const* e, PMap p)
+      { return m->template Decode<MAC::EQ>(b, e, p); };
+    auto hMIncrFX = [](auto* m, char const* b, char const* e, PMap p)
+      { return m->template Decode<MAC::FX>(b, e, p); };
+    auto gFOLIncr = [](auto* m, char const* b, char const* e, PMap p)
+      { return FG::DecodeOrdersLogIncrRefresh(m, b, e, p); };
+    auto gFOLSnap = [](auto* m, char const* b, char const* e, PMap p)
+      { return FG::DecodeOrdersLogSnapShot(m, b, e, p); };
+    auto gFSecSt  = [](auto* m, char const* b, char const* e, PMap p)
+      { return FG::DecodeSecurityStatus(m, b, e, p); };
+    auto gFTSSt   = [](auto* m, char const* b, char const* e, PMap p)
+      { return FG::DecodeTradingSessionStatus(m, b, e, p); };
+    auto gMIncrEQ = [](auto* m, char const* b, char const* e, PMap p)
+      { return MG::DecodeIncrementalRefresh_EQ(m, b, e, p); };
+    auto gMIncrFX = [](auto* m, char const* b, char const* e, PMap p)
+      { return MG::DecodeIncrementalRefresh_FX(m, b, e, p); };
+
+    bool ok = true;
+    ok &= Check<FOLIncr> ("FORTS OrdersLogIncr", folIncr,
+                          FG::OrdersLogIncrRefreshTID,    hDecode, gFOLIncr);
+    ok &= Check<FOLSnap> ("FORTS OrdersLogSnapShot", folSnap,
+                          FG::OrdersLogSnapShotTID,       hDecode, gFOLSnap);
+    ok &= Check<FSecStat>("FORTS SecurityStatus", fSecSt,
+                          FG::SecurityStatusTID,          hDecode, gFSecSt);
+    ok &= Check<FTSStat> ("FORTS TrSessStatus", fTSSt,
+                          FG::TradingSessionStatusTID,    hDecode, gFTSSt);
+    ok &= Check<MIncr>   ("MICEX IncrRefresh EQ", mIncrEQ,
+                          MG::IncrementalRefresh_EQTID,   hMIncrEQ, gMIncrEQ);
+    ok &= Check<MIncr>   ("MICEX IncrRefresh FX", mIncrFX,
+                          MG::IncrementalRefresh_FXTID,   hMIncrFX, gMIncrFX);
+    if (!ok)
+    {
+      cerr << "FASTDecodersTest FAILED" << endl;
+      return 1;
+    }
+
+    //-----------------------------------------------------------------------//
+    // Throughput:                                                           //
+    //-----------------------------------------------------------------------//
+    cout << fixed << setprecision(1);
+    Bench<FOLIncr, SlimFOLIncr>
+      ("FORTS OrdersLogIncr",  folIncr, nRounds, hDecode, gFOLIncr);
+    Bench<MIncr,   SlimMIncr>
+      ("MICEX IncrRefresh EQ", mIncrEQ, nRounds, hMIncrEQ, gMIncrEQ);
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
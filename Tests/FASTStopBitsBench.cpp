@@ -0,0 +1,528 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "Tests/FASTStopBitsBench.cpp":                     //
+//     FAST Fld Extraction: Vectorised Stop-Bit Scanning vs Per-Byte Loops   //
+//===========================================================================//
+// Usage: FASTStopBitsBench [PCapFile]
+// (*) If a PCap file with recorded MOEX FAST MktData (UDP over Ethernet/IPv4,
+//     each datagram being a 4-byte SeqNum followed by a FAST msg) is given,
+//     the msgs are taken from there; otherwise, synthetic msgs with the fld
+//     sizes of FORTS "OrdersLogIncrRefresh" are generated;
+// (*) First, "GetInteger" and "GetASCII" with and without "UseSIMD" are
+//     cross-checked on random flds of all lengths (incl those at the very end
+//     of the buffer, and invalid ones);
+// (*) Then the msgs are walked fld-by-fld (every fld read as an Integer, or
+//     as an ASCII string), with and without "UseSIMD", and also pre-split by
+//     "StopBits::SplitFields"; the results of all walks are cross-checked.
+// The output is similar to that of Google Benchmark:
+//
+#include "Protocols/FAST/LowLevel.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types and Consts:                                                       //
+  //=========================================================================//
+  constexpr int MaxFlds = 4096;
+  constexpr int MaxStr  = 256;
+
+  // All msgs are stored back-to-back in one buffer:
+  struct MsgsT
+  {
+    vector<char> m_data;
+    vector<int>  m_offs;    // Msg boundaries, size = NMsgs + 1
+    MsgsT(): m_data(), m_offs(1, 0) {}
+
+    int         Size()           const { return int(m_offs.size()) - 1; }
+    char const* Begin(int a_i)   const { return m_data.data() + m_offs[a_i]; }
+    char const* End  (int a_i)   const { return Begin(a_i+1); }
+
+    void Add(char const* a_from, char const* a_to)
+    {
+      m_data.insert(m_data.end(), a_from, a_to);
+      m_offs.push_back(int(m_data.size()));
+    }
+  };
+
+  //=========================================================================//
+  // "DoNotOptimize":                                                        //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  //=========================================================================//
+  // "Bench": Runs "a_f" (which returns the number of flds processed) until  //
+  // at least 0.2 sec has elapsed, and prints the time per fld:              //
+  //=========================================================================//
+  template<typename F>
+  void Bench(string const& a_name, long a_bytes, F const& a_f)
+  {
+    long   nFlds  = 0;
+    long   nBytes = 0;
+    double sec    = 0.0;
+    for (long n = 1; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      nFlds  = 0;
+      for (long i = 0; i < n; ++i)
+        nFlds += a_f();
+      sec    = (utxx::now_utc() - from).seconds();
+      nBytes = n * a_bytes;
+    }
+    cout << left  << setw(32) << a_name
+         << right << setw(10) << fixed << setprecision(2)
+         << (sec * 1e9 / double(nFlds)) << " ns/fld"
+         << setw(10) << setprecision(0) << (double(nBytes) / sec / 1e6)
+         << " MB/s" << setw(12) << nFlds << '\n';
+  }
+
+  //=========================================================================//
+  // Encoding (as in the FAST Spec):                                         //
+  //=========================================================================//
+  void EncU(vector<char>* a_out, uint64_t a_val)
+  {
+    char tmp[10];
+    int  n = 0;
+    do
+    {
+      tmp[n++] = char(a_val & 0x7f);
+      a_val  >>= 7;
+    }
+    while (a_val != 0);
+    tmp[0] |= '\x80';
+    for (int i = n - 1; i >= 0; --i)
+      a_out->push_back(tmp[i]);
+  }
+
+  void EncS(vector<char>* a_out, int64_t a_val)
+  {
+    char tmp[10];
+    int  n = 0;
+    for (bool more = true; more; )
+    {
+      tmp[n++] = char(a_val & 0x7f);
+      a_val  >>= 7;   // Arithmetic shift
+      more     = !((a_val ==  0 && !(tmp[n-1] & '\x40')) ||
+                   (a_val == -1 &&  (tmp[n-1] & '\x40')));
+    }
+    tmp[0] |= '\x80';
+    for (int i = n - 1; i >= 0; --i)
+      a_out->push_back(tmp[i]);
+  }
+
+  void EncStr(vector<char>* a_out, string const& a_str)
+  {
+    a_out->insert(a_out->end(), a_str.begin(), a_str.end());
+    a_out->back() |= '\x80';
+  }
+
+  //=========================================================================//
+  // "MkSynthetic":                                                          //
+  //=========================================================================//
+  // Fld sizes and values typical for FORTS "OrdersLogIncrRefresh" msgs (with
+  // NULLable flds encoded as +1, and NULLs as 0x80):
+  //
+  void MkSynthetic(int a_n, MsgsT* a_msgs)
+  {
+    mt19937_64   rng(12345);
+    vector<char> m;
+    uint32_t     seqNum = 1'000'000;
+    uint64_t     entID  = 1'900'000'000'000;
+    uint32_t     rpt    = 50'000'000;
+
+    for (int i = 0; i < a_n; ++i)
+    {
+      m.clear();
+      m.push_back('\xc0');                          // PMap
+      EncU(&m, 14);                                 // TID
+      EncU(&m, seqNum++);                           // MsgSeqNum
+      EncU(&m, 20171231'120000'123 + 1000 * uint64_t(i));  // SendingTime
+      EncU(&m, 1);                                  // LastFragment
+      int nEnts = 1 + int(rng() % 4);
+      EncU(&m, uint64_t(nEnts));                    // NoMDEntries
+
+      for (int e = 0; e < nEnts; ++e)
+      {
+        EncU  (&m, rng() % 3);                      // MDUpdateAction
+        EncStr(&m, (rng() & 1) ? "0" : "1");        // MDEntryType
+        EncS  (&m, int64_t(entID += rng() % 50) + 1);  // MDEntryID
+        EncU  (&m, 2'000'000 + rng() % 100'000 + 1);   // SecurityID
+        EncU  (&m, ++rpt + 1);                      // RptSeq
+        m.push_back('\x80');                        // MDEntryDate: NULL
+        EncU  (&m, 120000'123'456'789 + rng() % 1'000'000'000);
+        EncS  (&m, -5 + 1);                         // MDEntryPx: Exp
+        EncS  (&m, 60'000'000 + int64_t(rng() % 100'000));  // Mant
+        EncS  (&m, int64_t(1 + rng() % 300) + 1);   // MDEntrySize
+        m.push_back('\x80');                        // LastPx:  NULL
+        m.push_back('\x80');                        // LastQty: NULL
+        m.push_back('\x80');                        // TradeID: NULL
+        EncU  (&m, 4'500 + 1);                      // ExchTradingSessionID
+        EncS  (&m, 0x1'0000'1001 + 1);              // MDFlags
+        EncU  (&m, 1'000'000'000'000 + rng() % 1000 + 1);   // Revision
+      }
+      a_msgs->Add(m.data(), m.data() + m.size());
+    }
+  }
+
+  //=========================================================================//
+  // "ReadPCap":                                                             //
+  //=========================================================================//
+  // Classic PCap format (either byte order, usec or nsec time stamps),
+  // Ethernet (possibly with VLAN tags) or Linux "cooked" link layer, IPv4,
+  // UDP; non-UDP frames and IP fragments are skipped:
+  //
+  uint32_t Get32(char const* a_p, bool a_swap)
+  {
+    uint32_t x;
+    memcpy(&x, a_p, 4);
+    return a_swap ? __builtin_bswap32(x) : x;
+  }
+
+  void ReadPCap(char const* a_file, MsgsT* a_msgs)
+  {
+    ifstream     in(a_file, ios::binary);
+    vector<char> buf((istreambuf_iterator<char>(in)),
+                      istreambuf_iterator<char>());
+    if (buf.size() < 24)
+      throw utxx::badarg_error("ReadPCap: Invalid file: ", a_file);
+
+    uint32_t magic = Get32(buf.data(), false);
+    bool     swap  = (magic == 0xd4c3b2a1 || magic == 0x4d3cb2a1);
+    if (!swap && magic != 0xa1b2c3d4 && magic != 0xa1b23c4d)
+      throw utxx::badarg_error("ReadPCap: Not a PCap file: ", a_file);
+    uint32_t link  = Get32(buf.data() + 20, swap);
+
+    for (size_t off = 24; off + 16 <= buf.size(); )
+    {
+      size_t       len = Get32(buf.data() + off + 8, swap);
+      char const*  p   = buf.data() + off + 16;
+      char const*  end = p + len;
+      off += 16 + len;
+      if (off > buf.size())
+        break;
+
+      // Link Layer:
+      uint16_t etype = 0;
+      if (link == 1)
+      {
+        if (end - p < 14)
+          continue;
+        etype = uint16_t((uint8_t(p[12]) << 8) | uint8_t(p[13]));
+        p    += 14;
+        while (etype == 0x8100 && end - p >= 4)
+        {
+          etype = uint16_t((uint8_t(p[2]) << 8) | uint8_t(p[3]));
+          p    += 4;
+        }
+      }
+      else
+      if (link == 113)
+      {
+        if (end - p < 16)
+          continue;
+        etype = uint16_t((uint8_t(p[14]) << 8) | uint8_t(p[15]));
+        p    += 16;
+      }
+      if (etype != 0x0800 || end - p < 20)
+        continue;
+
+      // IPv4 (skip fragments) and UDP:
+      int ihl = 4 * (p[0] & 0x0f);
+      if (p[9] != 17 || (uint8_t(p[6]) & 0x3f) != 0 || p[7] != 0 ||
+          end - p < ihl + 8)
+        continue;
+      p += ihl + 8;
+
+      // Strip the SeqNum:
+      if (end - p > 4)
+        a_msgs->Add(p + 4, end);
+    }
+  }
+
+  //=========================================================================//
+  // "CanWalk":                                                              //
+  //=========================================================================//
+  // Whether the msg can be walked fld-by-fld as Integers (it ends with a stop
+  // bit, and is not too long for "SplitFields") and, in addition, as ASCII
+  // strings (no over-long flds, no non-0 chars after a 0 prefix):
+  //
+  bool CanWalk(char const* a_from, char const* a_to, bool a_ascii)
+  {
+    if (a_to - a_from > 65535 || a_from == a_to || !(a_to[-1] & '\x80'))
+      return false;
+    if (!a_ascii)
+      return true;
+    for (char const* p = a_from; p < a_to; )
+    {
+      char const* q = p;
+      while (!(*q & '\x80'))
+        ++q;
+      ++q;
+      if (q - p >= MaxStr)
+        return false;
+      if ((*p & '\x7f') == 0)
+        for (char const* r = p + 1; r < q; ++r)
+          if ((*r & '\x7f') != 0)
+            return false;
+      p = q;
+    }
+    return true;
+  }
+
+  //=========================================================================//
+  // Walks:                                                                  //
+  //=========================================================================//
+  template<bool UseSIMD>
+  long WalkInts(MsgsT const& a_msgs, uint64_t* a_sum)
+  {
+    long     nFlds = 0;
+    uint64_t sum   = 0;
+    for (int i = 0; i < a_msgs.Size(); ++i)
+    {
+      char const* end = a_msgs.End(i);
+      for (char const* p = a_msgs.Begin(i); p < end; ++nFlds)
+      {
+        int64_t val    = 0;
+        bool    isNull = false;
+        p = FAST::GetInteger<false, int64_t, UseSIMD>
+            (true, p, end, &val, &isNull, "Walk", nullptr);
+        sum += uint64_t(val) + isNull;
+      }
+    }
+    *a_sum = sum;
+    return nFlds;
+  }
+
+  template<bool UseSIMD>
+  long WalkASCII(MsgsT const& a_msgs, uint64_t* a_sum)
+  {
+    long     nFlds = 0;
+    uint64_t sum   = 0;
+    char     str[MaxStr];
+    for (int i = 0; i < a_msgs.Size(); ++i)
+    {
+      char const* end = a_msgs.End(i);
+      for (char const* p = a_msgs.Begin(i); p < end; ++nFlds)
+      {
+        int  len    = 0;
+        bool isNull = false;
+        p = FAST::GetASCII<false, UseSIMD>
+            (true, p, end, str, MaxStr, &len, &isNull, "Walk");
+        sum += uint64_t(len) + uint64_t(uint8_t(str[0])) + isNull;
+      }
+    }
+    *a_sum = sum;
+    return nFlds;
+  }
+
+  template<bool UseSIMD>
+  long Split(MsgsT const& a_msgs, uint64_t* a_sum)
+  {
+    long     nFlds = 0;
+    uint64_t sum   = 0;
+    uint16_t ends[MaxFlds];
+    for (int i = 0; i < a_msgs.Size(); ++i)
+    {
+      int n = FAST::StopBits::SplitFields<UseSIMD>
+              (a_msgs.Begin(i), a_msgs.End(i), ends, MaxFlds);
+      if (utxx::unlikely(n < 0))
+        throw utxx::runtime_error("Split: Too many flds");
+      nFlds += n;
+      for (int k = 0; k < n; ++k)
+        sum += ends[k];
+    }
+    *a_sum = sum;
+    return nFlds;
+  }
+
+  //=========================================================================//
+  // "CrossCheck": Random Flds, SIMD vs Scalar:                              //
+  //=========================================================================//
+  template<typename T>
+  bool CheckInt(char const* a_from, char const* a_end, bool a_nullable)
+  {
+    T    v[2]    = { 1, 1 };
+    bool nul[2]  = { false, false }, neg[2] = { false, false };
+    bool exc[2]  = { false, false };
+    char const* res[2] = { nullptr, nullptr };
+    try
+      { res[0] = FAST::GetInteger<false, T, false>
+                 (a_nullable, a_from, a_end, v, nul, "X", neg); }
+    catch (exception const&) { exc[0] = true; }
+    try
+      { res[1] = FAST::GetInteger<false, T, true>
+                 (a_nullable, a_from, a_end, v+1, nul+1, "X", neg+1); }
+    catch (exception const&) { exc[1] = true; }
+
+    bool ok = (exc[0] == exc[1]) &&
+              (exc[0] || (v[0] == v[1] && nul[0] == nul[1] &&
+                          neg[0] == neg[1] && res[0] == res[1]));
+    if (!ok)
+      cerr << "GetInteger MISMATCH: Size=" << sizeof(T) << ", Signed="
+           << is_signed_v<T> << ", Len=" << (a_end - a_from) << endl;
+    return ok;
+  }
+
+  bool CrossCheck()
+  {
+    mt19937_64   rng(67890);
+    vector<char> buf(64);
+    long         nErrs = 0;
+
+    for (int i = 0; i < 1'000'000; ++i)
+    {
+      // A fld of 1..12 bytes (the stop bit may also be missing), followed by
+      // 0..16 arbitrary bytes in the buffer:
+      int  len  = 1 + int(rng() % 12);
+      int  tail = int(rng() % 17);
+      bool term = (rng() % 16 != 0);
+      for (int j = 0; j < len + tail; ++j)
+        buf[size_t(j)] = char(rng());
+      for (int j = 0; j < len; ++j)
+        buf[size_t(j)] &= '\x7f';
+      if (term)
+        buf[size_t(len-1)] |= '\x80';
+      // Sometimes, make it a NULL or a small value:
+      if (rng() % 8 == 0)
+        buf[0] = (len == 1) ? '\x80' : '\x00';
+
+      char const* from = buf.data();
+      char const* end  = from + len + tail;
+      bool        nbl  = bool(rng() & 1);
+
+      nErrs += !CheckInt<int32_t> (from, end, nbl);
+      nErrs += !CheckInt<uint32_t>(from, end, nbl);
+      nErrs += !CheckInt<int64_t> (from, end, nbl);
+      nErrs += !CheckInt<uint64_t>(from, end, nbl);
+
+      // The same as a string, with a random output buffer size:
+      int  maxLen = 2 + int(rng() % 16);
+      char s[2][32];
+      int  sl [2] = { 0, 0 };
+      bool nul[2] = { false, false }, exc[2] = { false, false };
+      char const* res[2] = { nullptr, nullptr };
+      try
+        { res[0] = FAST::GetASCII<false, false>
+                   (nbl, from, end, s[0], maxLen, sl, nul, "X"); }
+      catch (exception const&) { exc[0] = true; }
+      try
+        { res[1] = FAST::GetASCII<false, true>
+                   (nbl, from, end, s[1], maxLen, sl+1, nul+1, "X"); }
+      catch (exception const&) { exc[1] = true; }
+
+      if (exc[0] != exc[1] ||
+         (!exc[0] && (sl[0] != sl[1] || nul[0] != nul[1] ||
+                      res[0] != res[1] || strcmp(s[0], s[1]) != 0)))
+      {
+        cerr << "GetASCII MISMATCH: Len=" << len << ", MaxLen=" << maxLen
+             << endl;
+        ++nErrs;
+      }
+    }
+    cout << "CrossCheck: " << nErrs << " mismatches" << endl;
+    return nErrs == 0;
+  }
+
+  //=========================================================================//
+  // "Run": Benchmarks for a set of msgs:                                    //
+  //=========================================================================//
+  bool Run(MsgsT const& a_all)
+  {
+    // Select the msgs which can be walked:
+    MsgsT ints, strs;
+    for (int i = 0; i < a_all.Size(); ++i)
+    {
+      if (CanWalk(a_all.Begin(i), a_all.End(i), false))
+        ints.Add(a_all.Begin(i), a_all.End(i));
+      if (CanWalk(a_all.Begin(i), a_all.End(i), true))
+        strs.Add(a_all.Begin(i), a_all.End(i));
+    }
+    cout << "Msgs: " << a_all.Size() << " (Int Walk: " << ints.Size()
+         << ", ASCII Walk: " << strs.Size() << ")\n";
+    if (ints.Size() == 0)
+      return false;
+
+    // Cross-check the walks:
+    uint64_t s[6] = { 0, 0, 0, 0, 0, 0 };
+    long     n[6] =
+    {
+      WalkInts <false>(ints, s),   WalkInts <true>(ints, s+1),
+      WalkASCII<false>(strs, s+2), WalkASCII<true>(strs, s+3),
+      Split    <false>(ints, s+4), Split    <true>(ints, s+5)
+    };
+    if (n[0] != n[1] || s[0] != s[1] || n[2] != n[3] || s[2] != s[3] ||
+        n[4] != n[5] || s[4] != s[5] || n[0] != n[4])
+    {
+      cerr << "Walk MISMATCH" << endl;
+      return false;
+    }
+    cout << "Flds: " << n[0] << ", Bytes: " << ints.m_data.size() << "\n\n"
+         << left  << setw(32) << "Benchmark"
+         << right << setw(17) << "Time" << setw(15) << "Throughput"
+         << setw(12) << "Flds" << '\n' << string(76, '-') << endl;
+
+    long ib = long(ints.m_data.size()), sb = long(strs.m_data.size());
+    uint64_t sum = 0;
+#   define FAST_SB_BENCH(Name, Bytes, Walk, Msgs)                \
+    Bench(Name, Bytes, [&]() -> long                             \
+      { long r = Walk(Msgs, &sum); DoNotOptimize(sum); return r; })
+
+    FAST_SB_BENCH("GetInteger/Scalar",  ib, WalkInts <false>, ints);
+    FAST_SB_BENCH("GetInteger/SIMD",    ib, WalkInts <true>,  ints);
+    FAST_SB_BENCH("GetASCII/Scalar",    sb, WalkASCII<false>, strs);
+    FAST_SB_BENCH("GetASCII/SIMD",      sb, WalkASCII<true>,  strs);
+    FAST_SB_BENCH("SplitFields/Scalar", ib, Split    <false>, ints);
+    FAST_SB_BENCH("SplitFields/SIMD",   ib, Split    <true>,  ints);
+#   undef FAST_SB_BENCH
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    cout << "SIMD: " << (FAST::HasSIMD ? "yes" : "no") << ", BMI2: "
+#   ifdef __BMI2__
+         << "yes"
+#   else
+         << "no"
+#   endif
+         << ", AVX2: " << (__builtin_cpu_supports("avx2") ? "yes" : "no")
+         << endl;
+
+    if (!CrossCheck())
+      return 1;
+
+    MsgsT msgs;
+    if (argc >= 2)
+      ReadPCap(argv[1], &msgs);
+    else
+      MkSynthetic(100'000, &msgs);
+
+    if (!Run(msgs))
+      return 1;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
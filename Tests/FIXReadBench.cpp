@@ -0,0 +1,434 @@
+// vim:ts=2:et
+//===========================================================================//
+//                           "Tests/FIXReadBench.cpp":                       //
+//       FIX Msg Reading: Zero-Copy In-Place Parsing vs Parsing a Copy       //
+//===========================================================================//
+// Usage: FIXReadBench [FIXLogFile]
+// (*) If a FIX log file is given (eg as written by the "ProtoLogFile" logger,
+//     or any other text file with one FIX msg per line, with SOHs or '|'s as
+//     separators), all msgs found there are used; otherwise,  synthetic LMAX
+//     ExecutionReports and MarketDataIncrementalRefreshes are generated;
+// (*) The msgs are fed into the LMAX "FIX::ProtoEngine::ReadHandler"   in TCP
+//     segment-sized chunks, emulating the Reactor buffer (incl the "crunch"
+//     of incomplete msgs), with "ZeroCopyRead" off and on; the parsed results
+//     of both modes are cross-checked;
+// (*) "ScanMsg" (CheckSum and SOH positions in one pass) is also compared
+//     with the separate CheckSum and SOH searches it replaces.
+// The output is similar to that of Google Benchmark:
+//
+#include "Basis/EPollReactor.h"
+#include "Connectors/EConnector_MktData.h"
+#include "Venues/LMAX/Features_FIX.h"
+#include "Protocols/FIX/ProtoEngine.hpp"
+#include <utxx/time_val.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types and Consts:                                                       //
+  //=========================================================================//
+  constexpr FIX::DialectT::type D       = FIX::DialectT::LMAX;
+  constexpr int                 ChunkSz = 1448;   // TCP MSS
+  constexpr int                 Rounds  = 8;
+
+  //=========================================================================//
+  // "BenchSessMgr", "BenchProc":                                            //
+  //=========================================================================//
+  // Minimal SessMgr and Processor for a Client-Side "ProtoEngine": all msgs
+  // are accepted; the Processor computes a digest of the parsed flds:
+  //
+  struct BenchSessMgr
+  {
+    FIX::SessData           m_sess;
+    spdlog::logger*         m_logger;
+    spdlog::logger*         m_protoLogger;
+    int                     m_debugLevel;
+    long                    m_nSessMsgs;
+    long                    m_nTerms;
+
+    BenchSessMgr(spdlog::logger* a_logger)
+    : m_sess       (),
+      m_logger     (a_logger),
+      m_protoLogger(nullptr),
+      m_debugLevel (0),
+      m_nSessMsgs  (0),
+      m_nTerms     (0)
+    {}
+
+    FIX::SessData* GetFIXSession(int)              { return &m_sess; }
+    bool IsInactiveSess(FIX::SessData const*) const { return false;   }
+
+    template<bool Graceful>
+    void TerminateSession(int, FIX::SessData*, char const*, utxx::time_val)
+      { ++m_nTerms; }
+
+    template<typename Msg>
+    void Process(Msg const&, FIX::SessData*, utxx::time_val)
+      { ++m_nSessMsgs; }
+
+    // Not used on the Client-Side:
+    template<FIX::MsgT::type MT, typename Msg>
+    bool CheckFIXSession(int, Msg const*, FIX::SessData**) { return true; }
+  };
+
+  struct BenchProc
+  {
+    long     m_nMsgs   = 0;
+    uint64_t m_digest  = 0;
+
+    void Mix(uint64_t a_x)
+      { m_digest = (m_digest ^ a_x) * 0x100000001b3UL; }
+
+    template<typename Msg>
+    void Process(Msg const& a_msg, FIX::SessData*, utxx::time_val,
+                 utxx::time_val)
+    {
+      ++m_nMsgs;
+      Mix(uint64_t(a_msg.m_MsgSeqNum));
+      Mix(uint64_t(a_msg.m_SendingTime.microseconds()));
+
+      if constexpr (requires { a_msg.m_ExecID; })
+      {
+        Mix(uint64_t(a_msg.m_ClOrdID));
+        Mix(uint64_t(double(a_msg.m_Price) * 1e5));
+        Mix(uint64_t(long(a_msg.m_LeavesQty)));
+        Mix(uint64_t(a_msg.m_ExecType));
+        Mix(strlen(a_msg.m_ExecID));
+      }
+      if constexpr (requires { a_msg.m_MDEntries; a_msg.m_MDReqID; })
+      {
+        Mix(uint64_t(a_msg.m_MDReqID));
+        for (int i = 0; i < a_msg.m_NoMDEntries; ++i)
+        {
+          Mix(uint64_t(double(a_msg.m_MDEntries[i].m_MDEntryPx) * 1e5));
+          Mix(uint64_t(long (a_msg.m_MDEntries[i].m_MDEntrySize)));
+        }
+      }
+    }
+
+    void Process(FIX::SessData*) {}
+  };
+
+  //=========================================================================//
+  // "Engine": Exposes "ReadHandler":                                        //
+  //=========================================================================//
+  class Engine: public FIX::ProtoEngine<D, false, BenchSessMgr, BenchProc>
+  {
+    using Base = FIX::ProtoEngine<D, false, BenchSessMgr, BenchProc>;
+  public:
+    Engine(BenchSessMgr* a_sess_mgr, BenchProc* a_proc, bool a_zero_copy)
+    : Base(a_sess_mgr, a_proc, a_zero_copy)
+    {}
+    using Base::ReadHandler;
+  };
+
+  //=========================================================================//
+  // "DoNotOptimize":                                                        //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  //=========================================================================//
+  // "Bench": Runs "a_f" (which returns the number of msgs processed) until  //
+  // at least 0.2 sec has elapsed, and prints the time per msg:              //
+  //=========================================================================//
+  template<typename F>
+  void Bench(string const& a_name, F const& a_f)
+  {
+    long   nMsgs = 0;
+    double sec   = 0.0;
+    for (long n = 1; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      nMsgs = 0;
+      for (long i = 0; i < n; ++i)
+        nMsgs += a_f();
+      sec   = (utxx::now_utc() - from).seconds();
+    }
+    cout << left  << setw(40) << a_name
+         << right << setw(12) << fixed << setprecision(2)
+         << (sec * 1e9 / double(nMsgs)) << " ns" << setw(14) << nMsgs << '\n';
+  }
+
+  //=========================================================================//
+  // Msgs:                                                                   //
+  //=========================================================================//
+  // Completes a msg from its body (starting with "35="; SOHs as '|'s):
+  //
+  string MkMsg(string a_body)
+  {
+    for (char& c: a_body)
+      if (c == '|')
+        c = FIX::soh;
+    string msg = "8=FIX.4.4" SOH "9=" + to_string(a_body.size()) + SOH +
+                 a_body;
+    char cs[8];
+    snprintf(cs, sizeof(cs), "%03d",
+             FIX::MsgCheckSum(msg.data(), msg.data() + msg.size()));
+    return msg + "10=" + cs + SOH;
+  }
+
+  void MkSynthetic(int a_n, vector<string>* a_msgs)
+  {
+    mt19937_64 rng(12345);
+    for (int i = 0; i < a_n; ++i)
+    {
+      char   px[32];
+      string hdr =
+        "34=" + to_string(1000 + i) +
+        "|49=LMXBL|52=20240102-12:34:56." + to_string(100 + i % 900) +
+        "|56=CLIENT|";
+
+      if (rng() % 4 == 0)
+      {
+        // ExecutionReport:
+        snprintf(px, sizeof(px), "%.5f", 1.1 + double(rng() % 1000) * 1e-5);
+        string qty = to_string(1 + rng() % 100);
+        a_msgs->push_back(MkMsg
+          ("35=8|" + hdr + "1=1234567|6=0|11=20240102-" +
+           to_string(100000 + i) + "|14=0|17=AAAAAGCkAAAAAF" + to_string(i) +
+           "|37=AAK8xAAAAAAAAB" + to_string(i) + "|38=" + qty +
+           "|39=0|40=2|44=" + px + "|48=4001|54=" + to_string(1 + i % 2) +
+           "|59=0|60=20240102-12:34:56.100|150=0|151=" + qty + "|"));
+      }
+      else
+      {
+        // MarketDataIncrementalRefresh (with 1..4 MDEs):
+        string body = "35=X|" + hdr + "262=20240102-7|";
+        int    nMDEs = 1 + int(rng() % 4);
+        body += "268=" + to_string(nMDEs) + "|";
+        for (int e = 0; e < nMDEs; ++e)
+        {
+          snprintf(px, sizeof(px), "%.5f", 1.1 + double(rng() % 1000) * 1e-5);
+          body += "279=" + to_string(rng() % 3) + "|269=" +
+                  to_string(rng() % 2) + "|48=4001|270=" + px + "|271=" +
+                  to_string(1 + rng() % 500) + "|";
+        }
+        a_msgs->push_back(MkMsg(body));
+      }
+    }
+  }
+
+  // Msgs from a log file: from "8=FIX" to the end of the line; '|' separators
+  // are converted back to SOHs, and the final SOH is restored if required:
+  //
+  void ReadLog(char const* a_file, vector<string>* a_msgs)
+  {
+    ifstream in(a_file);
+    if (!in)
+      throw utxx::badarg_error("ReadLog: Cannot open ", a_file);
+    string line;
+    while (getline(in, line))
+    {
+      size_t from = line.find("8=FIX");
+      if (from == string::npos)
+        continue;
+      string msg = line.substr(from);
+      while (!msg.empty() && isspace(msg.back()))
+        msg.pop_back();
+      for (char& c: msg)
+        if (c == '|')
+          c = FIX::soh;
+      if (!msg.empty() && msg.back() != FIX::soh)
+        msg += FIX::soh;
+      a_msgs->push_back(msg);
+    }
+  }
+
+  //=========================================================================//
+  // "Feed": Emulates "ReadUntilEAgain" over the whole Stream:               //
+  //=========================================================================//
+  long Feed(Engine* a_eng, string const& a_stream, vector<char>* a_rd)
+  {
+    long   ncons = 0;
+    size_t sz    = 0;        // Data currently in the buffer
+    for (size_t off = 0; off < a_stream.size(); )
+    {
+      size_t n = min<size_t>(ChunkSz, a_stream.size() - off);
+      memcpy(a_rd->data() + sz, a_stream.data() + off, n);
+      off += n;
+      sz  += n;
+
+      int consumed =
+        a_eng->ReadHandler(3, a_rd->data(), int(sz), utxx::time_val());
+      if (utxx::unlikely(consumed < 0))
+        throw utxx::runtime_error("Feed: ReadHandler failed");
+
+      // "read_and_crunch":
+      sz -= size_t(consumed);
+      if (consumed > 0 && sz > 0)
+        memmove(a_rd->data(), a_rd->data() + consumed, sz);
+      ncons += consumed;
+    }
+    return ncons;
+  }
+
+  //=========================================================================//
+  // "ScanSep": What "ScanMsg" replaces: CheckSum + SOH search per fld:      //
+  //=========================================================================//
+  int ScanSep(char const* a_from, char const* a_to, int* a_n_sohs)
+  {
+    int cs = FIX::MsgCheckSum(a_from, a_to);
+    int n  = 0;
+    for (char const* p = a_from; p < a_to; ++n)
+    {
+      char const* e =
+        static_cast<char const*>(memchr(p, FIX::soh, size_t(a_to - p)));
+      if (e == nullptr)
+        break;
+      p = e + 1;
+    }
+    *a_n_sohs = n;
+    return cs;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    vector<string> msgs;
+    if (argc >= 2)
+      ReadLog(argv[1], &msgs);
+    else
+      MkSynthetic(20000, &msgs);
+
+    string stream;
+    for (string const& m: msgs)
+      stream += m;
+    if (msgs.empty())
+      throw utxx::badarg_error("No msgs");
+
+    auto            sink   = std::make_shared<spdlog::sinks::null_sink_mt>();
+    spdlog::logger  logger("FIXReadBench", sink);
+    vector<char>    rd(stream.size() + ChunkSz + 16);
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    BenchProc  proc[2];
+    long       ncons[2] = { 0, 0 };
+    for (int zc = 0; zc < 2; ++zc)
+    {
+      BenchSessMgr sm(&logger);
+      Engine       eng(&sm, proc + zc, bool(zc));
+      ncons[zc] = Feed(&eng, stream, &rd);
+    }
+    cout << "Msgs: " << msgs.size() << ", Bytes: " << stream.size()
+         << ", Processed: " << proc[0].m_nMsgs << '\n';
+    if (proc[0].m_nMsgs  != proc[1].m_nMsgs  ||
+        proc[0].m_digest != proc[1].m_digest || ncons[0] != ncons[1] ||
+        ncons[0] != long(stream.size()))
+    {
+      cerr << "ZeroCopy vs Copy MISMATCH" << endl;
+      return 1;
+    }
+
+    for (string const& m: msgs)
+    {
+      uint16_t sohs[4096];
+      int n[3] = { 0, 0, 0 };
+      char const* from = m.data();
+      char const* to   = from + m.size();
+      int cs[3] =
+      {
+        ScanSep             (from, to, n),
+        FIX::ScanMsg<false> (from, to, sohs, 4096, n+1),
+        FIX::ScanMsg<true>  (from, to, sohs, 4096, n+2)
+      };
+      if (cs[0] != cs[1] || cs[0] != cs[2] || n[0] != n[1] || n[0] != n[2])
+      {
+        cerr << "ScanMsg MISMATCH" << endl;
+        return 1;
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // Benchmarks:                                                           //
+    //-----------------------------------------------------------------------//
+    cout << '\n'  << left  << setw(40) << "Benchmark"
+         << right << setw(15) << "Time/Msg" << setw(14) << "Msgs" << '\n'
+         << string(69, '-') << endl;
+
+    for (int zc = 0; zc < 2; ++zc)
+    {
+      BenchSessMgr sm(&logger);
+      BenchProc    pr;
+      Engine       eng(&sm, &pr, bool(zc));
+      Bench(zc ? "ReadHandler/ZeroCopy" : "ReadHandler/Copy", [&]() -> long
+      {
+        for (int r = 0; r < Rounds; ++r)
+          Feed(&eng, stream, &rd);
+        return long(Rounds * msgs.size());
+      });
+    }
+    // The chunk feeding alone (included in both of the above):
+    Bench("Feed only (memcpy+crunch)", [&]() -> long
+    {
+      for (int r = 0; r < Rounds; ++r)
+        for (size_t off = 0; off < stream.size(); off += ChunkSz)
+        {
+          size_t n = min<size_t>(ChunkSz, stream.size() - off);
+          memcpy(rd.data(), stream.data() + off, n);
+          DoNotOptimize(rd[0]);
+        }
+      return long(Rounds * msgs.size());
+    });
+
+    uint16_t sohs[4096];
+    Bench("CheckSum+memchr (separate)", [&]() -> long
+    {
+      for (string const& m: msgs)
+      {
+        int n  = 0;
+        int cs = ScanSep(m.data(), m.data() + m.size(), &n);
+        DoNotOptimize(cs + n);
+      }
+      return long(msgs.size());
+    });
+    Bench("ScanMsg/Scalar", [&]() -> long
+    {
+      for (string const& m: msgs)
+      {
+        int n  = 0;
+        int cs = FIX::ScanMsg<false>
+                 (m.data(), m.data() + m.size(), sohs, 4096, &n);
+        DoNotOptimize(cs + n);
+      }
+      return long(msgs.size());
+    });
+    Bench("ScanMsg/SIMD", [&]() -> long
+    {
+      for (string const& m: msgs)
+      {
+        int n  = 0;
+        int cs = FIX::ScanMsg<true>
+                 (m.data(), m.data() + m.size(), sohs, 4096, &n);
+        DoNotOptimize(cs + n);
+      }
+      return long(msgs.size());
+    });
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
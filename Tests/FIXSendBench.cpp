@@ -0,0 +1,326 @@
+// vim:ts=2:et
+//===========================================================================//
+//                           "Tests/FIXSendBench.cpp":                       //
+//    FIX Order Msgs Sending: Generic Fld-by-Fld Generation vs "HotTmpl"s    //
+//===========================================================================//
+// Usage: FIXSendBench [NOrders (default: 1000)]
+// (*) "NewOrderSingle"s and "OrderCancelReplaceRequest"s are generated by the
+//     LMAX and Currenex "FIX::ProtoEngine"s with "HotOrderTmpls" off and on,
+//     over a few Instruments and both Sides, with varying Pxs, Qtys and Req-
+//     IDs; the resulting msgs are cross-checked byte-by-byte;
+// (*) then the latencies of "NewOrderImpl" and "ModifyOrderImpl" (up to the
+//     "SendImpl" call, which is a no-op here) are measured per call, and the
+//     percentiles are printed (as in "Tools/LatencyTest.cpp", in nsec):
+//
+#include "Basis/EPollReactor.h"
+#include "Connectors/EConnector_MktData.h"
+#include "Venues/LMAX/Features_FIX.h"
+#include "Venues/Currenex/Features_FIX.h"
+#include "Protocols/FIX/ProtoEngine.hpp"
+#include <utxx/time_val.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  // Each order is sent "Rounds" times in the latency measurements; the number
+  // of orders is small by default, so that they stay in the cache:
+  constexpr int Rounds = 100;
+
+  //=========================================================================//
+  // "BenchSessMgr":                                                         //
+  //=========================================================================//
+  // Minimal Client-Side SessMgr with OrdMgmt; "SendImpl" only memoises the
+  // last msg sent:
+  //
+  struct BenchSessMgr
+  {
+    SeqNum                  m_txSN;
+    SeqNum                  m_rxSN;
+    FIX::SessData           m_sess;
+    spdlog::logger*         m_logger;
+    spdlog::logger*         m_protoLogger;
+    int                     m_debugLevel;
+    string                  m_lastSent;
+    bool                    m_keepSent;
+
+    BenchSessMgr(spdlog::logger* a_logger)
+    : m_txSN       (1),
+      m_rxSN       (1),
+      m_sess       ("CLIENT", "VENUE", &m_txSN, &m_rxSN, 30, 1000, "", "",
+                    "", "", "", "ACCT-1"),
+      m_logger     (a_logger),
+      m_protoLogger(nullptr),
+      m_debugLevel (0),
+      m_lastSent   (),
+      m_keepSent   (true)
+    {}
+
+    FIX::SessData* GetFIXSession(int)              { return &m_sess; }
+    bool IsInactiveSess(FIX::SessData const*) const { return false;   }
+    bool IsOrdMgmt() const                          { return true;    }
+    bool IsMktData() const                          { return false;   }
+
+    utxx::time_val SendImpl(FIX::SessData*, char const* a_buff, int a_len)
+    {
+      if (m_keepSent)
+        m_lastSent.assign(a_buff, size_t(a_len));
+      return utxx::time_val();
+    }
+
+    template<bool Graceful>
+    void TerminateSession(int, FIX::SessData*, char const*, utxx::time_val)
+      {}
+
+    template<typename Msg>
+    void Process(Msg const&, FIX::SessData*, utxx::time_val) {}
+
+    template<FIX::MsgT::type MT, typename Msg>
+    bool CheckFIXSession(int, Msg const*, FIX::SessData**) { return true; }
+  };
+
+  struct BenchProc
+  {
+    template<typename Msg>
+    void Process(Msg const&, FIX::SessData*, utxx::time_val, utxx::time_val)
+      {}
+    void Process(FIX::SessData*) {}
+  };
+
+  //=========================================================================//
+  // "Engine": Exposes the Order Senders:                                    //
+  //=========================================================================//
+  template<FIX::DialectT::type D>
+  class Engine: public FIX::ProtoEngine<D, false, BenchSessMgr, BenchProc>
+  {
+    using Base = FIX::ProtoEngine<D, false, BenchSessMgr, BenchProc>;
+  public:
+    using QtyN = typename Base::QtyN;
+    using QR   = typename Base::QR;
+
+    Engine(BenchSessMgr* a_sess_mgr, bool a_hot_tmpls)
+    : Base(a_sess_mgr, nullptr, false, a_hot_tmpls)
+    {}
+  };
+
+  //=========================================================================//
+  // "Orders": Pre-Created AOSes and Req12s:                                 //
+  //=========================================================================//
+  template<FIX::DialectT::type D>
+  struct Orders
+  {
+    using QtyN = typename Engine<D>::QtyN;
+    using QR   = typename Engine<D>::QR;
+    constexpr static QtyTypeT QT = FIX::ProtocolFeatures<D>::s_QT;
+
+    vector<unique_ptr<AOS>>   m_aoses;
+    vector<unique_ptr<Req12>> m_news;
+    vector<unique_ptr<Req12>> m_mods;
+
+    Orders(Strategy* a_strat, vector<SecDefD> const& a_instrs, int a_n)
+    {
+      utxx::time_val ts = utxx::now_utc();
+      for (int i = 0; i < a_n; ++i)
+      {
+        SecDefD const& instr = a_instrs[size_t(i) % a_instrs.size()];
+        bool   isBuy  = (i % 2 == 0);
+        OrderID newID = OrderID(1000 + 2 * i);
+        PriceT  px    (1.1 + double(i % 97) * 1e-5);
+        QtyN    qty   (QR(1 + i % 50));
+
+        m_aoses.emplace_back(new AOS
+          (QT, FIX::ProtocolFeatures<D>::s_hasFracQtys, a_strat, newID,
+           &instr, nullptr, isBuy, FIX::OrderTypeT::Limit, false,
+           FIX::TimeInForceT::GoodTillCancel, 0));
+
+        AOS* aos = m_aoses.back().get();
+        m_news.emplace_back(new Req12
+          (aos, true, newID, 0, Req12::KindT::New, px, false, qty, qty,
+           QtyN(), false, 0.0, ts, ts, ts, ts + utxx::msecs(i)));
+
+        m_mods.emplace_back(new Req12
+          (aos, false, newID + 1, newID, Req12::KindT::Modify,
+           PriceT(double(px) + 1e-5), false, QtyN(QR(2 + i % 50)),
+           QtyN(QR(2 + i % 50)), QtyN(), false, 0.0, ts, ts, ts,
+           ts + utxx::msecs(i) + utxx::usecs(500)));
+        m_news.back()->m_status = Req12::StatusT::New;
+      }
+    }
+
+    // The Senders require "Indicated" Req12s:
+    Req12* New(size_t a_i) const
+    {
+      Req12* req = m_news[a_i].get();
+      req->m_status = Req12::StatusT::Indicated;
+      return req;
+    }
+    Req12* Mod(size_t a_i) const
+    {
+      Req12* req = m_mods[a_i].get();
+      req->m_status = Req12::StatusT::Indicated;
+      // The orig req must be at least "New":
+      m_news[a_i]->m_status = Req12::StatusT::New;
+      return req;
+    }
+  };
+
+  //=========================================================================//
+  // "NowNSec":                                                              //
+  //=========================================================================//
+  inline long NowNSec()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000L + ts.tv_nsec;
+  }
+
+  //=========================================================================//
+  // "PrintLatencies":                                                       //
+  //=========================================================================//
+  void PrintLatencies(char const* a_name, vector<long>* a_lats)
+  {
+    assert(a_lats != nullptr && !a_lats->empty());
+    sort(a_lats->begin(), a_lats->end());
+    auto pct = [a_lats](double a_p) -> long
+    {
+      size_t i = size_t(a_p * double(a_lats->size() - 1));
+      return (*a_lats)[i];
+    };
+    cout << left  << setw(34) << a_name << right
+         << setw(8) << pct(0.5)   << setw(8) << pct(0.9)
+         << setw(8) << pct(0.99)  << setw(8) << pct(0.999)
+         << setw(9) << a_lats->back() << endl;
+  }
+
+  //=========================================================================//
+  // "Run":                                                                  //
+  //=========================================================================//
+  template<FIX::DialectT::type D>
+  bool Run(char const* a_name, spdlog::logger* a_logger, Strategy* a_strat,
+           int a_n)
+  {
+    // Instruments:
+    vector<SecDefD> instrs(8);
+    for (size_t i = 0; i < instrs.size(); ++i)
+    {
+      string ccy   = "C" + to_string(i);
+      SecDefD& sd  = instrs[i];
+      sd.m_SecID   = 4001 + i;
+      sd.m_Symbol  = MkSymKey((ccy + "/USD").data());
+      sd.m_AssetA  = MkSymKey(ccy.data());
+      sd.m_PxStep  = 1e-5;
+    }
+    Orders<D>    ords(a_strat, instrs, a_n);
+
+    BenchSessMgr smGen(a_logger);
+    BenchSessMgr smHot(a_logger);
+    Engine<D>    gen  (&smGen, false);
+    Engine<D>    hot  (&smHot, true);
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    for (int pass = 0; pass < 2; ++pass)     // Record the Tmpls, then use them
+    for (size_t i = 0; i < size_t(a_n); ++i)
+    {
+      gen.NewOrderImpl(&smGen.m_sess, ords.New(i), false);
+      string msgGen = smGen.m_lastSent;
+      hot.NewOrderImpl(&smHot.m_sess, ords.New(i), false);
+      if (smHot.m_lastSent != msgGen)
+      {
+        cerr << a_name << ": NewOrderSingle MISMATCH:\n" << msgGen << '\n'
+             << smHot.m_lastSent << endl;
+        return false;
+      }
+      gen.ModifyOrderImpl(&smGen.m_sess, nullptr, ords.Mod(i), ords.New(i),
+                          false);
+      msgGen = smGen.m_lastSent;
+      hot.ModifyOrderImpl(&smHot.m_sess, nullptr, ords.Mod(i), ords.New(i),
+                          false);
+      if (smHot.m_lastSent != msgGen)
+      {
+        cerr << a_name << ": OrderCancelReplaceRequest MISMATCH:\n" << msgGen
+             << '\n' << smHot.m_lastSent << endl;
+        return false;
+      }
+    }
+    //-----------------------------------------------------------------------//
+    // Latencies:                                                            //
+    //-----------------------------------------------------------------------//
+    smGen.m_keepSent = false;
+    smHot.m_keepSent = false;
+    vector<long> lats(size_t(a_n * Rounds));
+
+    for (int h = 0; h < 2; ++h)
+    {
+      Engine<D>&    eng = h ? hot   : gen;
+      BenchSessMgr& sm  = h ? smHot : smGen;
+      string pfx = string(a_name) + (h ? "/Hot" : "/Generic");
+
+      for (size_t k = 0; k < lats.size(); ++k)
+      {
+        Req12* req = ords.New(k % size_t(a_n));
+        long   t0  = NowNSec();
+        eng.NewOrderImpl(&sm.m_sess, req, false);
+        lats[k]    = NowNSec() - t0;
+      }
+      PrintLatencies((pfx + "/NewOrderSingle").data(), &lats);
+
+      for (size_t k = 0; k < lats.size(); ++k)
+      {
+        size_t i    = k % size_t(a_n);
+        Req12* req  = ords.Mod(i);
+        Req12* orig = ords.New(i);
+        orig->m_status = Req12::StatusT::New;
+        long   t0   = NowNSec();
+        eng.ModifyOrderImpl(&sm.m_sess, nullptr, req, orig, false);
+        lats[k]     = NowNSec() - t0;
+      }
+      PrintLatencies((pfx + "/OrderCancelReplace").data(), &lats);
+    }
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    int n = (argc >= 2) ? atoi(argv[1]) : 1000;
+    if (n <= 0)
+      throw utxx::badarg_error("Invalid NOrders: ", n);
+
+    auto           sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+    spdlog::logger logger("FIXSendBench", sink);
+    Strategy       strat ("FIXSendBench", nullptr, &logger, 0);
+
+    cout << left  << setw(34) << "Latency, nsec" << right
+         << setw(8)  << "50%" << setw(8) << "90%" << setw(8) << "99%"
+         << setw(8)  << "99.9%" << setw(9) << "Max" << '\n'
+         << string(75, '-') << endl;
+
+    if (!Run<FIX::DialectT::LMAX>    ("LMAX",     &logger, &strat, n) ||
+        !Run<FIX::DialectT::Currenex>("Currenex", &logger, &strat, n))
+      return 1;
+  }
+  catch (exception const& exn)
+  {
+    cerr << "EXCEPTION: " << exn.what() << endl;
+    return 1;
+  }
+  return 0;
+}
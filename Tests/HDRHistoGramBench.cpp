@@ -0,0 +1,147 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "Tests/HDRHistoGramBench.cpp":                     //
+//            Log-Bucketed Latency HistoGrams: Precision and Update Cost     //
+//===========================================================================//
+// Usage: HDRHistoGramBench [NVals (default: 1M)]
+// (*) Generates NVals latency-like vals (log-normal, with a heavy tail, in
+//     nsec), puts them into an "HDRHistoGram" (as used by "LatencyTrace"),
+//     and cross-checks its percentiles against the exact ones (from the sor-
+//     ted vals): the relative error must be within the bucket precision;
+// (*) Times "Update" of "HDRHistoGram" vs the old linear "HistoGram" (over
+//     a fixed range, with 1M intervals to get the same precision at ~1 usec).
+// The output is similar to that of Google Benchmark:
+//
+#include "QuantSupport/HDRHistoGram.hpp"
+#include "QuantSupport/HistoGram.hpp"
+#include "Connectors/LatencyTrace.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <cmath>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "DoNotOptimize", "Bench":                                               //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  template<typename F>
+  void Bench(string const& a_name, long a_n, char const* a_unit, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    cout << left  << setw(34) << a_name
+         << right << setw(14) << fixed << setprecision(1)
+         << (sec * 1e9 / double(n * a_n)) << " ns/" << a_unit << endl;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    long nVals = (argc >= 2) ? atol(argv[1]) : 1'000'000;
+    if (nVals <= 0)
+      throw invalid_argument("NVals must be positive");
+
+    using Hist = LatencyTrace::Hist;
+
+    // Latencies: median ~2 usec, with a tail up to ~100s of usec:
+    mt19937_64                 rng(12345);
+    lognormal_distribution<>   distr(log(2000.0), 0.8);
+    vector<long>               vals(static_cast<size_t>(nVals));
+    for (long& v: vals)
+      v = max<long>(1, lround(distr(rng)));
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    unique_ptr<Hist> hist(new Hist("Test"));
+    for (long v: vals)
+      hist->Update(v);
+
+    Hist::Summary s = hist->GetSummary();
+    vector<long>  sorted(vals);
+    sort(sorted.begin(), sorted.end());
+
+    // The exact percentile is the val of the "ceil(p*n)"th rank:
+    auto exact = [&sorted](double a_p) -> long
+    {
+      size_t r = size_t(ceil(a_p * double(sorted.size())));
+      return sorted[max<size_t>(r, 1) - 1];
+    };
+    double const prec = 1.0 / double(Hist::Half);
+
+    pair<long, long> const checks[]
+    {
+      { s.m_p50,  exact(0.5)   }, { s.m_p90,  exact(0.9)   },
+      { s.m_p99,  exact(0.99)  }, { s.m_p999, exact(0.999) },
+      { s.m_min,  sorted.front() }, { s.m_max, sorted.back() }
+    };
+    for (auto const& c: checks)
+      if (c.first < c.second ||
+          double(c.first - c.second) > prec * double(c.second))
+      {
+        cerr << "MISMATCH: HDR=" << c.first << ", Exact=" << c.second
+             << endl;
+        return 1;
+      }
+    if (s.m_count != nVals)
+    {
+      cerr << "MISMATCH: Count=" << s.m_count << endl;
+      return 1;
+    }
+    cout << *hist << "\n\n"
+         << left  << setw(34) << "Benchmark" << right << setw(19) << "Time\n"
+         << string(56, '-') << endl;
+
+    //-----------------------------------------------------------------------//
+    // "Update":                                                             //
+    //-----------------------------------------------------------------------//
+    unique_ptr<QuantSupport::HistoGram<1'000'000>> lin
+      (new QuantSupport::HistoGram<1'000'000>("Test", 0.0, 1e6));
+
+    size_t i = 0;
+    Bench("Update/HDRHistoGram",   1, "val", [&]
+      {
+        hist->Update(vals[i++ % vals.size()]);
+      });
+    Bench("Update/HistoGram<1M>",  1, "val", [&]
+      {
+        lin->Update(double(vals[i++ % vals.size()]));
+      });
+    Bench("GetSummary/HDRHistoGram", 1, "call", [&]
+      {
+        DoNotOptimize(hist->GetSummary().m_p99);
+      });
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,613 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Tests/JSONIndexBench.cpp":                       //
+//    H2WS JSON Parsing: Structural Index + Cursor vs "strstr" / "strtod"    //
+//===========================================================================//
+// Usage: JSONIndexBench [RecordedFile]
+// (*) If a file with recorded WS msgs (one JSON msg per line) is given, the
+//     msgs are taken from there; otherwise, synthetic Binance "trade" and
+//     "depthUpdate" msgs, and full-depth (1000+1000 levels) SnapShots, are
+//     generated;
+// (*) First, "JSON::ToDouble" is cross-checked against "strtod" on random
+//     decimals, and "JSON::StructIdx" with and without "UseSIMD" on random
+//     JSON-like text (with escapes and quotes at block boundaries);
+// (*) Then each stream (Trades, Updates, SnapShots) is parsed in the style of
+//     the previous Binance MDC ("strstr" / "strchr" / "strtod" chains), and
+//     via "StructIdx" + "Cursor" (Scalar and SIMD); the results are cross-
+//     checked. Recorded msgs of other formats are only walked generically.
+// The output is similar to that of Google Benchmark:
+//
+#include "Protocols/JSONIndex.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types:                                                                  //
+  //=========================================================================//
+  // All msgs are stored back-to-back in one buffer, each one 0-terminated (as
+  // in the WS receive buffers), but the 0s are not counted in msg lengths:
+  struct MsgsT
+  {
+    vector<char> m_data;
+    vector<int>  m_offs;    // Msg boundaries, size = NMsgs + 1
+    MsgsT(): m_data(), m_offs(1, 0) {}
+
+    int         Size()         const { return int(m_offs.size()) - 1; }
+    char const* Begin(int a_i) const { return m_data.data() + m_offs[a_i]; }
+    int         Len  (int a_i) const
+      { return m_offs[a_i+1] - m_offs[a_i] - 1; }
+    long        Bytes()        const { return long(m_data.size()); }
+
+    void Add(string const& a_msg)
+    {
+      m_data.insert(m_data.end(), a_msg.begin(), a_msg.end());
+      m_data.push_back('\0');
+      m_offs.push_back(int(m_data.size()));
+    }
+  };
+
+  // Parsing result (accumulated over all msgs of a stream):
+  struct ResT
+  {
+    long   m_n   = 0;     // Levels or Trades
+    double m_sum = 0.0;   // Of Px * Qty
+    long   m_ids = 0;     // Sum of UpdateIDs / TradeIDs / Times
+
+    bool operator==(ResT const& a_r) const
+      { return m_n == a_r.m_n && m_sum == a_r.m_sum && m_ids == a_r.m_ids; }
+  };
+
+  //=========================================================================//
+  // "DoNotOptimize":                                                        //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  //=========================================================================//
+  // "Bench": Runs "a_f" (which processes all msgs once) until at least 0.2  //
+  // sec has elapsed, and prints the time per msg:                           //
+  //=========================================================================//
+  template<typename F>
+  void Bench(string const& a_name, MsgsT const& a_msgs, F const& a_f)
+  {
+    if (a_msgs.Size() == 0)
+      return;
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    cout << left  << setw(32) << a_name
+         << right << setw(10) << fixed << setprecision(1)
+         << (sec * 1e9 / double(n * a_msgs.Size())) << " ns/msg"
+         << setw(10) << setprecision(0)
+         << (double(n * a_msgs.Bytes()) / sec / 1e6) << " MB/s"
+         << setw(12) << a_msgs.Size() << '\n';
+  }
+
+  //=========================================================================//
+  // Synthetic Msgs:                                                         //
+  //=========================================================================//
+  string Dec(mt19937_64& a_rng, long a_max, int a_frac)
+  {
+    char buf[64];
+    long v = long(a_rng() % uint64_t(a_max));
+    snprintf(buf, sizeof(buf), "%ld.%0*ld",
+             v / 100'000'000, a_frac, (v % 100'000'000) / 1);
+    return string(buf);
+  }
+
+  string MkLevels(mt19937_64& a_rng, int a_n)
+  {
+    string res = "[";
+    for (int i = 0; i < a_n; ++i)
+    {
+      if (i != 0)
+        res += ',';
+      // NB: Qty=0 is a valid Update (level removal), but not in SnapShots:
+      res += "[\"" + Dec(a_rng, 5'000'000'000'000L, 8) + "\",\"" +
+             Dec(a_rng, 1'000'000'000L, 8) + "\"]";
+    }
+    return res + "]";
+  }
+
+  void MkSynthetic
+  (
+    int    a_n,
+    MsgsT* a_trades,
+    MsgsT* a_updates,
+    MsgsT* a_snaps
+  )
+  {
+    mt19937_64 rng(12345);
+    long       ts = 1'672'515'782'136L;
+    for (int i = 0; i < a_n; ++i)
+    {
+      ts += long(rng() % 50);
+      a_trades->Add
+        ("{\"e\":\"trade\",\"E\":" + to_string(ts + 1) +
+         ",\"s\":\"BTCUSDT\",\"t\":" + to_string(2'000'000'000L + i) +
+         ",\"p\":\"" + Dec(rng, 5'000'000'000'000L, 8) + "\",\"q\":\"" +
+         Dec(rng, 100'000'000L, 8) + "\",\"b\":" + to_string(88 + i) +
+         ",\"a\":" + to_string(50 + i) + ",\"T\":" + to_string(ts) +
+         ",\"m\":" + ((rng() & 1) ? "true" : "false") + ",\"M\":true}");
+
+      a_updates->Add
+        ("{\"e\":\"depthUpdate\",\"E\":" + to_string(ts) +
+         ",\"s\":\"BTCUSDT\",\"U\":" + to_string(157 + 10 * i) +
+         ",\"u\":" + to_string(166 + 10 * i) +
+         ",\"b\":" + MkLevels(rng, int(rng() % 20)) +
+         ",\"a\":" + MkLevels(rng, int(rng() % 20)) + "}");
+
+      if (i % 100 == 0)
+        a_snaps->Add
+          ("{\"lastUpdateId\":" + to_string(1'027'024L + i) +
+           ",\"bids\":" + MkLevels(rng, 1000) +
+           ",\"asks\":" + MkLevels(rng, 1000) + "}");
+    }
+  }
+
+  //=========================================================================//
+  // "ReadRecorded": One msg per line, classified by its prefix:             //
+  //=========================================================================//
+  void ReadRecorded
+  (
+    char const* a_file,
+    MsgsT*      a_trades,
+    MsgsT*      a_updates,
+    MsgsT*      a_snaps,
+    MsgsT*      a_others
+  )
+  {
+    ifstream in(a_file);
+    if (!in)
+      throw runtime_error(string("Cannot open ") + a_file);
+    string line;
+    while (getline(in, line))
+    {
+      if (line.empty())
+        continue;
+      if (line.compare(0, 13, "{\"e\":\"trade\",")  == 0)
+        a_trades->Add(line);
+      else
+      if (line.compare(0, 18, "{\"e\":\"depthUpdate\"") == 0)
+        a_updates->Add(line);
+      else
+      if (line.compare(0, 16, "{\"lastUpdateId\":") == 0)
+        a_snaps->Add(line);
+      else
+        a_others->Add(line);
+    }
+  }
+
+  //=========================================================================//
+  // Legacy Parsers ("strstr" / "strchr" / "strtod" chains):                 //
+  //=========================================================================//
+  // "LegacyLevels": "a_curr" points to the opening '[' of the array of Levels;
+  // returns the ptr after its closing ']':
+  char const* LegacyLevels(char const* a_curr, ResT* a_res)
+  {
+    char const* curr  = a_curr + 1;
+    if (*curr == ']')
+      return curr + 1;
+    ++curr;
+    char*       after = nullptr;
+    while (true)
+    {
+      if (*curr == '"')
+        ++curr;
+      double px  = strtod(curr, &after);
+      curr = after;
+      if (*curr == '"')
+        ++curr;
+      ++curr;           // ','
+      if (*curr == '"')
+        ++curr;
+      double qty = strtod(curr, &after);
+      curr = after;
+      if (*curr == '"')
+        ++curr;
+      ++a_res->m_n;
+      a_res->m_sum += px * qty;
+      if (strncmp(curr, "]]", 2) == 0)
+        return curr + 2;
+      curr += 3;        // "],["
+    }
+  }
+
+  void LegacyUpdate(char const* a_msg, ResT* a_res)
+  {
+    char const* curr = strstr(a_msg, "\"s\":\"") + 5;
+    curr = strchr(curr, '"');
+    curr = strstr(curr, "\"U\":") + 4;
+    long firstID = 0, lastID = 0;
+    curr = utxx::fast_atoi<long, false>(curr, curr + 20, firstID);
+    curr = strstr(curr, "\"u\":") + 4;
+    curr = utxx::fast_atoi<long, false>(curr, curr + 20, lastID);
+    a_res->m_ids += firstID + lastID;
+    curr = strstr(curr, ",\"b\":[") + 5;
+    curr = LegacyLevels(curr, a_res);
+    curr = strstr(curr, ",\"a\":[") + 5;
+    LegacyLevels(curr, a_res);
+  }
+
+  void LegacySnapShot(char const* a_msg, ResT* a_res)
+  {
+    char const* curr = a_msg + 16;
+    long seqNum = 0;
+    curr = utxx::fast_atoi<long, false>(curr, curr + 20, seqNum);
+    a_res->m_ids += seqNum;
+    curr = strstr(curr, ",\"bids\":[") + 8;
+    curr = LegacyLevels(curr, a_res);
+    curr = strstr(curr, ",\"asks\":[") + 8;
+    LegacyLevels(curr, a_res);
+  }
+
+  void LegacyTrade(char const* a_msg, ResT* a_res)
+  {
+    char const* curr  = strstr(a_msg, ",\"t\":") + 5;
+    char*       after = nullptr;
+    long        id    = 0, T = 0;
+    curr = utxx::fast_atoi<long, false>(curr, curr + 20, id);
+    curr = strstr(curr, ",\"p\":\"") + 6;
+    double px  = strtod(curr, &after);
+    curr = strstr(after, ",\"q\":\"") + 6;
+    double qty = strtod(curr, &after);
+    curr = strstr(after, ",\"T\":") + 5;
+    curr = utxx::fast_atoi<long, false>(curr, curr + 20, T);
+    curr = strstr(curr, ",\"m\":") + 5;
+    bool sell = (strncmp(curr, "true", 4) == 0);
+    ++a_res->m_n;
+    a_res->m_sum += sell ? -px * qty : px * qty;
+    a_res->m_ids += id + T;
+  }
+
+  //=========================================================================//
+  // Index-Based Parsers (as in the Binance MDC):                            //
+  //=========================================================================//
+  void CursorLevels(JSON::Cursor* a_cur, ResT* a_res)
+  {
+    if (!a_cur->EnterArr())
+      return;
+    do
+    {
+      a_cur->EnterArr();
+      double px  = a_cur->GetDouble();
+      a_cur->Expect(',');
+      double qty = a_cur->GetDouble();
+      if (a_cur->NextElem())
+        a_cur->LeaveArr();
+      ++a_res->m_n;
+      a_res->m_sum += px * qty;
+    }
+    while (a_cur->NextElem());
+  }
+
+  template<bool UseSIMD>
+  void CursorUpdate
+    (JSON::StructIdx* a_idx, char const* a_msg, int a_len, ResT* a_res)
+  {
+    a_idx->Build<UseSIMD>(a_msg, a_len);
+    JSON::Cursor     cur(*a_idx);
+    string_view      key;
+    cur.EnterObj();
+    while (cur.NextKey(&key))
+    {
+      if (key == "U" || key == "u")
+        a_res->m_ids += cur.GetInt<long>();
+      else
+      if (key == "b" || key == "a")
+        CursorLevels(&cur, a_res);
+      else
+      if (key == "s")
+        DoNotOptimize(cur.GetStr());
+      else
+        cur.SkipVal();
+    }
+  }
+
+  template<bool UseSIMD>
+  void CursorSnapShot
+    (JSON::StructIdx* a_idx, char const* a_msg, int a_len, ResT* a_res)
+  {
+    a_idx->Build<UseSIMD>(a_msg, a_len);
+    JSON::Cursor     cur(*a_idx);
+    string_view      key;
+    cur.EnterObj();
+    while (cur.NextKey(&key))
+    {
+      if (key == "lastUpdateId")
+        a_res->m_ids += cur.GetInt<long>();
+      else
+      if (key == "bids" || key == "asks")
+        CursorLevels(&cur, a_res);
+      else
+        cur.SkipVal();
+    }
+  }
+
+  template<bool UseSIMD>
+  void CursorTrade
+    (JSON::StructIdx* a_idx, char const* a_msg, int a_len, ResT* a_res)
+  {
+    a_idx->Build<UseSIMD>(a_msg, a_len);
+    JSON::Cursor     cur(*a_idx);
+    string_view      key;
+    double           px = 0.0, qty = 0.0;
+    bool             sell = false;
+    cur.EnterObj();
+    while (cur.NextKey(&key))
+    {
+      if (key == "t" || key == "T")
+        a_res->m_ids += cur.GetInt<long>();
+      else
+      if (key == "p")
+        px   = cur.GetDouble();
+      else
+      if (key == "q")
+        qty  = cur.GetDouble();
+      else
+      if (key == "m")
+        sell = cur.GetBool();
+      else
+        cur.SkipVal();
+    }
+    ++a_res->m_n;
+    a_res->m_sum += sell ? -px * qty : px * qty;
+  }
+
+  //-------------------------------------------------------------------------//
+  // "WalkAny": Generic traversal, summing up all numeric values:            //
+  //-------------------------------------------------------------------------//
+  void WalkVal(JSON::Cursor* a_cur, ResT* a_res)
+  {
+    char c = a_cur->Peek();
+    if (c == '{')
+    {
+      string_view key;
+      a_cur->EnterObj();
+      while (a_cur->NextKey(&key))
+        WalkVal(a_cur, a_res);
+    }
+    else
+    if (c == '[')
+    {
+      if (a_cur->EnterArr())
+        do WalkVal(a_cur, a_res); while (a_cur->NextElem());
+    }
+    else
+    {
+      string_view v   = a_cur->GetRaw();
+      double      val = 0.0;
+      char const* end = v.data() + v.size();
+      if (!v.empty() && JSON::ToDouble(v.data(), end, &val) == end)
+      {
+        ++a_res->m_n;
+        a_res->m_sum += val;
+      }
+    }
+  }
+
+  template<bool UseSIMD>
+  void WalkAny
+    (JSON::StructIdx* a_idx, char const* a_msg, int a_len, ResT* a_res)
+  {
+    a_idx->Build<UseSIMD>(a_msg, a_len);
+    JSON::Cursor cur(*a_idx);
+    WalkVal(&cur, a_res);
+    a_res->m_ids += a_idx->GetN();
+  }
+
+  //=========================================================================//
+  // "CrossCheck": "ToDouble" vs "strtod"; Scalar vs SIMD "StructIdx":       //
+  //=========================================================================//
+  bool CrossCheck()
+  {
+    mt19937_64 rng(67890);
+    long       nErrs = 0;
+
+    // Decimals of all typical shapes, incl those falling back to "strtod":
+    for (int i = 0; i < 1'000'000; ++i)
+    {
+      char buf[64];
+      int  n = 0;
+      switch (i % 4)
+      {
+      case 0:
+        n = snprintf(buf, sizeof(buf), "%.8f",
+                     double(rng() % 10'000'000'000'000UL) / 1e3);
+        break;
+      case 1:
+        n = snprintf(buf, sizeof(buf), "%lu.%0*lu", rng() % 100'000,
+                     int(rng() % 12) + 1, rng() % 1'000'000'000'000UL);
+        break;
+      case 2:
+        n = snprintf(buf, sizeof(buf), "%.17g",
+                     uniform_real_distribution<double>(0, 1e6)(rng));
+        break;
+      default:
+        n = snprintf(buf, sizeof(buf), "-%lu",
+                     rng() % 1'000'000'000'000'000'000UL);
+      }
+      double      exp = strtod(buf, nullptr);
+      double      got = NaN<double>;
+      char const* end = JSON::ToDouble(buf, buf + n, &got);
+      if (got != exp || end != buf + n)
+      {
+        if (nErrs < 10)
+          cerr << "ToDouble MISMATCH: " << buf << endl;
+        ++nErrs;
+      }
+    }
+
+    // Random JSON-like text (the alphabet is biased towards structurals,
+    // quotes and backslashes):
+    static char const Alpha[] = "{}[]:,\"\"\\\\ab 01";
+    JSON::StructIdx idx[2];
+    for (int i = 0; i < 20'000; ++i)
+    {
+      string s(size_t(rng() % 300), ' ');
+      for (char& c: s)
+        c = Alpha[rng() % (sizeof(Alpha) - 1)];
+      idx[0].Build<false>(s.data(), int(s.size()));
+      idx[1].Build<true> (s.data(), int(s.size()));
+      bool ok = (idx[0].GetN() == idx[1].GetN());
+      for (int j = 0; ok && j < idx[0].GetN(); ++j)
+        ok = (idx[0].GetOffs()[j] == idx[1].GetOffs()[j]);
+
+      // Also verify the Scalar index against a byte-by-byte reference (NB: a
+      // backslash only affects the quote which follows it; outside strings,
+      // it is invalid JSON anyway):
+      int  k = 0;
+      bool inStr = false, esc = false;
+      for (int j = 0; ok && j < int(s.size()); ++j)
+      {
+        char c = s[size_t(j)];
+        bool st = false;
+        if (c == '"' && !esc)
+        {
+          inStr = !inStr;
+          st    = true;
+        }
+        else
+          st = !inStr && c != '\0' && strchr("{}[]:,", c) != nullptr;
+        esc = (c == '\\') && !esc;
+        if (st)
+          ok = (k < idx[0].GetN() && int(idx[0].GetOffs()[k++]) == j);
+      }
+      ok = ok && (k == idx[0].GetN());
+      if (!ok)
+      {
+        if (nErrs < 10)
+          cerr << "StructIdx MISMATCH: " << s << endl;
+        ++nErrs;
+      }
+    }
+    cout << "CrossCheck: " << nErrs << " mismatches" << endl;
+    return nErrs == 0;
+  }
+
+  //=========================================================================//
+  // "Run": Benchmarks for a stream of msgs:                                 //
+  //=========================================================================//
+  template<typename Legacy, typename Scalar, typename SIMD>
+  bool Run
+  (
+    string const& a_name,
+    MsgsT  const& a_msgs,
+    Legacy const& a_legacy,   // May be NULL
+    Scalar const& a_scalar,
+    SIMD   const& a_simd
+  )
+  {
+    if (a_msgs.Size() == 0)
+      return true;
+
+    JSON::StructIdx idx;
+    auto walk = [&](auto const& a_f) -> ResT
+    {
+      ResT res;
+      for (int i = 0; i < a_msgs.Size(); ++i)
+        a_f(&idx, a_msgs.Begin(i), a_msgs.Len(i), &res);
+      return res;
+    };
+    // NB: Generic, so that it is not instantiated for "Legacy" = "nullptr_t":
+    auto legacy = [&](JSON::StructIdx*, char const* a_msg, int, auto* a_res)
+      { a_legacy(a_msg, a_res); };
+
+    ResT r[3] = { ResT(), walk(a_scalar), walk(a_simd) };
+    if constexpr (!is_same_v<Legacy, nullptr_t>)
+      r[0] = walk(legacy);
+    else
+      r[0] = r[1];
+
+    if (!(r[0] == r[1] && r[1] == r[2]))
+    {
+      cerr << a_name << ": MISMATCH" << endl;
+      return false;
+    }
+    cout << '\n' << a_name << ": Msgs=" << a_msgs.Size() << ", Bytes="
+         << a_msgs.Bytes() << ", Items=" << r[0].m_n << '\n';
+
+    if constexpr (!is_same_v<Legacy, nullptr_t>)
+      Bench(a_name + "/Legacy", a_msgs, [&]{ DoNotOptimize(walk(legacy)); });
+    Bench(a_name + "/Index/Scalar", a_msgs,
+          [&]{ DoNotOptimize(walk(a_scalar)); });
+    Bench(a_name + "/Index/SIMD",   a_msgs,
+          [&]{ DoNotOptimize(walk(a_simd));   });
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    cout << "SIMD: " << (JSON::HasSIMD ? "yes" : "no") << ", AVX2: "
+#   ifdef __AVX2__
+         << "yes"
+#   else
+         << "no"
+#   endif
+         << ", PCLMUL: "
+#   ifdef __PCLMUL__
+         << "yes"
+#   else
+         << "no"
+#   endif
+         << endl;
+
+    if (!CrossCheck())
+      return 1;
+
+    MsgsT trades, updates, snaps, others;
+    if (argc >= 2)
+      ReadRecorded(argv[1], &trades, &updates, &snaps, &others);
+    else
+      MkSynthetic(20'000, &trades, &updates, &snaps);
+
+    cout << '\n' << left  << setw(32) << "Benchmark"
+         << right << setw(17) << "Time" << setw(15) << "Throughput"
+         << setw(12) << "Msgs" << '\n' << string(76, '-') << endl;
+
+    bool ok =
+      Run("Trade",     trades,  LegacyTrade,
+          CursorTrade   <false>, CursorTrade   <true>) &&
+      Run("Update",    updates, LegacyUpdate,
+          CursorUpdate  <false>, CursorUpdate  <true>) &&
+      Run("SnapShot",  snaps,   LegacySnapShot,
+          CursorSnapShot<false>, CursorSnapShot<true>) &&
+      Run("Other",     others,  nullptr,
+          WalkAny       <false>, WalkAny       <true>);
+    if (!ok)
+      return 1;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
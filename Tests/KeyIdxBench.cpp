@@ -0,0 +1,205 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/KeyIdxBench.cpp":                         //
+//     Symbol / SecID Lookups: "KeyIdx" Hash Index vs Linear "strcmp" Scans  //
+//===========================================================================//
+// Usage: KeyIdxBench
+// (*) For 10, 1k and 50k instruments (with synthetic Symbols of 3..15 chars,
+//     similar to Binance spot pairs and FORTS options, and random SecIDs),
+//     builds "KeyIdx" indices by Symbol and by SecID, in the same way as the
+//     MDCs and "SecDefsMgr" do;
+// (*) Then looks up random Symbols and SecIDs (90% hits, 10% misses) via the
+//     indices and via Linear Search (as was done by "FindOrderBook" and
+//     "FindSecDefOpt"), and cross-checks the results.
+// NB: The 50k case exceeds "Limits::MaxInstrs"; it shows the scaling only.
+// The output is similar to that of Google Benchmark:
+//
+#include "Basis/KeyIdx.hpp"
+#include <utxx/time_val.hpp>
+#include <boost/container/detail/algorithm.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstring>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types:                                                                  //
+  //=========================================================================//
+  // A stand-in for "SecDefD" / "OrderBook" (the relevant flds only, padded to
+  // a realistic size, so that Linear Search touches as many cache lines):
+  struct InstrT
+  {
+    SymKey  m_Symbol;
+    SecID   m_SecID;
+    char    m_other[488];
+  };
+
+  // "NSlots" fits 50k entries:
+  using IdxT = KeyIdx<131072>;
+
+  //=========================================================================//
+  // "DoNotOptimize":                                                        //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  //=========================================================================//
+  // "Bench": Runs "a_f" (which performs all lookups once) until at least  //
+  // 0.2 sec has elapsed, and prints the time per lookup:                    //
+  //=========================================================================//
+  template<typename F>
+  void Bench(string const& a_name, long a_n, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    cout << left  << setw(36) << a_name
+         << right << setw(12) << fixed << setprecision(1)
+         << (sec * 1e9 / double(n * a_n)) << " ns/lookup" << endl;
+  }
+
+  //=========================================================================//
+  // "MkSymbol": Unique synthetic Symbol of 3..15 chars:                     //
+  //=========================================================================//
+  string MkSymbol(mt19937_64& a_rng, int a_i)
+  {
+    static char const* Quotes[] = { "USDT", "BTC", "ETH", "BUSD", "" };
+    string res;
+    for (int j = 0; j < 2 + int(a_rng() % 3); ++j)
+      res += char('A' + a_rng() % 26);
+    res += to_string(a_i);
+    res += Quotes[a_rng() % 5];
+    return res.substr(0, SymKeySz - 1);
+  }
+
+  //=========================================================================//
+  // "Run":                                                                  //
+  //=========================================================================//
+  bool Run(int a_n)
+  {
+    mt19937_64     rng(12345 + unsigned(a_n));
+    vector<InstrT> instrs(static_cast<size_t>(a_n));
+    auto           bySym = make_unique<IdxT>();
+    auto           byID  = make_unique<IdxT>();
+
+    for (int i = 0; i < a_n; ++i)
+    {
+      InstrT& instr = instrs[size_t(i)];
+      instr.m_Symbol = MkSymKey(MkSymbol(rng, i));
+      instr.m_SecID  = rng() | 1;
+      (void) bySym->Insert(MkKey16(instr.m_Symbol), i);
+      (void) byID ->Insert(MkKey16(instr.m_SecID),  i);
+    }
+
+    // Queries: 90% hits, 10% misses:
+    constexpr int NQ = 4096;
+    vector<string> qSyms(NQ);
+    vector<SecID>  qIDs (NQ);
+    for (int q = 0; q < NQ; ++q)
+    {
+      bool   hit = (rng() % 10 != 0);
+      size_t i   = size_t(rng() % uint64_t(a_n));
+      qSyms[size_t(q)] =
+        hit ? string(instrs[i].m_Symbol.data()) : "ZZ" + to_string(q);
+      qIDs [size_t(q)] = hit ? instrs[i].m_SecID : (rng() & ~1UL);
+    }
+
+    // Linear Search (as in the previous "FindOrderBook" / "FindSecDefOpt"):
+    auto linSym = [&](char const* a_sym) -> InstrT const*
+    {
+      auto it = boost::container::find_if
+        (instrs.cbegin(), instrs.cend(),
+        [a_sym](InstrT const& a_curr)->bool
+        { return strcmp(a_curr.m_Symbol.data(), a_sym) == 0; });
+      return (it != instrs.cend()) ? &(*it) : nullptr;
+    };
+    auto linID  = [&](SecID a_id) -> InstrT const*
+    {
+      auto it = boost::container::find_if
+        (instrs.cbegin(), instrs.cend(),
+        [a_id](InstrT const& a_curr)->bool
+        { return a_curr.m_SecID == a_id; });
+      return (it != instrs.cend()) ? &(*it) : nullptr;
+    };
+    // Via the Hash Index:
+    auto idxSym = [&](char const* a_sym) -> InstrT const*
+    {
+      Key16 key;
+      if (!MkKey16(a_sym, &key))
+        return nullptr;
+      int i = bySym->Find(key);
+      return (i >= 0) ? instrs.data() + i : nullptr;
+    };
+    auto idxID  = [&](SecID a_id) -> InstrT const*
+    {
+      int i = byID->Find(MkKey16(a_id));
+      return (i >= 0) ? instrs.data() + i : nullptr;
+    };
+
+    // Cross-Check:
+    for (int q = 0; q < NQ; ++q)
+      if (linSym(qSyms[size_t(q)].data()) != idxSym(qSyms[size_t(q)].data()) ||
+          linID (qIDs [size_t(q)])        != idxID (qIDs [size_t(q)]))
+      {
+        cerr << "MISMATCH: N=" << a_n << ", Symbol=" << qSyms[size_t(q)]
+             << ", SecID=" << qIDs[size_t(q)] << endl;
+        return false;
+      }
+
+    // Benchmarks (Linear Search is limited to a subset of queries for large
+    // "a_n", otherwise it takes too long):
+    long nLin = min<long>(NQ, max<long>(64, 2'000'000 / a_n));
+    string sfx = "/" + to_string(a_n);
+    cout << '\n';
+    Bench("Symbol/Linear" + sfx, nLin, [&]
+      { for (long q = 0; q < nLin; ++q)
+          DoNotOptimize(linSym(qSyms[size_t(q)].data())); });
+    Bench("Symbol/KeyIdx" + sfx, NQ,   [&]
+      { for (int  q = 0; q < NQ;   ++q)
+          DoNotOptimize(idxSym(qSyms[size_t(q)].data())); });
+    Bench("SecID/Linear"  + sfx, nLin, [&]
+      { for (long q = 0; q < nLin; ++q)
+          DoNotOptimize(linID (qIDs[size_t(q)])); });
+    Bench("SecID/KeyIdx"  + sfx, NQ,   [&]
+      { for (int  q = 0; q < NQ;   ++q)
+          DoNotOptimize(idxID (qIDs[size_t(q)])); });
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main()
+{
+  try
+  {
+    cout << left  << setw(36) << "Benchmark" << right << setw(22) << "Time\n"
+         << string(58, '-') << endl;
+    for (int n: { 10, 1000, 50000 })
+      if (!Run(n))
+        return 1;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
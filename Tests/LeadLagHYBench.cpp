@@ -0,0 +1,256 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/LeadLagHYBench.cpp":                      //
+//       Hayashi-Yoshida Lead-Lag: Per-Lag vs All-Lags Sweep vs Streaming    //
+//===========================================================================//
+// Usage: LeadLagHYBench [NHours (default: 2)] [MaxLag (default: 100 msec)]
+// (*) Simulates NHours of the MOEX trading day as 2 tick streams on a msec
+//     grid (as produced by "MLL::TickDataReader"): Instr1 observes a random-
+//     walk Px at Poisson times (avg interval 40 msec), and Instr2 observes the
+//     same Px delayed by 7 msec (avg interval 70 msec), so Instr1 leads;
+// (*) Computes the HY Cross-Correlation Function over [-MaxLag .. MaxLag]:
+//     by "MLL::HayashiYoshidaCrossCorr" for each lag (the old way),  and by
+//     "MLL::HayashiYoshidaCrossCorrs" in one sweep, and cross-checks them;
+// (*) Feeds the ticks to "QuantSupport::LeadLagHY" (the streaming engine),
+//     and checks that all methods recover the lead;
+// (*) Reports the timings.
+//
+#include "QuantAnalytics/MOEX-Lead-Lag/MLL.hpp"
+#include "QuantAnalytics/MOEX-Lead-Lag/HY.hpp"
+#include "QuantSupport/LeadLagHY.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cmath>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  using namespace MLL;
+  using TicksArr = MDEntryT[MaxTicks];
+
+  // NB: The arrays are too large for static data (unless compiled with
+  // "-mcmodel=large", as "MLL" is), so they are allocated on the heap; an
+  // all-0 "MDEntryT" is the same as a default-constructed one, and only the
+  // pages actually used are committed:
+  TicksArr& AllocTicks()
+  {
+    void* mem = calloc(MaxTicks, sizeof(MDEntryT));
+    if (mem == nullptr)
+      throw bad_alloc();
+    return *static_cast<TicksArr*>(mem);
+  }
+
+  constexpr int TrueLead = 7;   // msec
+
+  //=========================================================================//
+  // "Tick", "MkTicks": Observations of a Px at Poisson times:               //
+  //=========================================================================//
+  struct Tick
+  {
+    int     m_t;
+    double  m_px;
+  };
+
+  vector<Tick> MkTicks
+  (
+    vector<double> const& a_px,
+    int                   a_delay,
+    double                a_avg_int,
+    mt19937_64&           a_rng
+  )
+  {
+    exponential_distribution<> distr(1.0 / a_avg_int);
+    vector<Tick>               res;
+    double                     prev = NaN<double>;
+    int const                  n    = int(a_px.size());
+    for (int t = a_delay + int(distr(a_rng)); t < n;
+         t += 1 + int(distr(a_rng)))
+    {
+      double px = a_px[size_t(t - a_delay)];
+      if (px != prev)
+        res.push_back({t, px});
+      prev = px;
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // "Fill": Ticks -> MDEntryTs (as "TickDataReader" does):                  //
+  //=========================================================================//
+  template<int N>
+  void Fill(vector<Tick> const& a_ticks, MDEntryT (&a_targ)[N])
+  {
+    int prev = -1;
+    for (Tick const& tick: a_ticks)
+    {
+      MDEntryT& mde = a_targ[tick.m_t];
+      mde.m_px      = tick.m_px;
+      mde.m_curr    = tick.m_t;
+      mde.m_prev    = prev;
+      mde.m_next    = N;
+      if (prev >= 0)
+      {
+        MDEntryT& mdp = a_targ[prev];
+        mdp.m_next    = tick.m_t;
+        for (int i = prev + 1; i < tick.m_t; ++i)
+        {
+          MDEntryT& mdi = a_targ[i];
+          mdi.m_px      = mdp.m_px;
+          mdi.m_curr    = prev;
+          mdi.m_prev    = mdp.m_prev;
+          mdi.m_next    = tick.m_t;
+        }
+      }
+      prev = tick.m_t;
+    }
+  }
+
+  //=========================================================================//
+  // "ArgMaxAbs": The lag with the largest absolute Cross-Corr:              //
+  //=========================================================================//
+  int ArgMaxAbs(vector<double> const& a_corrs, int a_lmin)
+  {
+    auto it = max_element(a_corrs.cbegin(), a_corrs.cend(),
+                          [](double a_x, double a_y)
+                          { return Abs(a_x) < Abs(a_y); });
+    return int(it - a_corrs.cbegin()) + a_lmin;
+  }
+
+  double Sec(utxx::time_val a_from)
+    { return (utxx::now_utc() - a_from).seconds(); }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    double nHours = (argc >= 2) ? atof(argv[1]) : 2.0;
+    int    maxLag = (argc >= 3) ? atoi(argv[2]) : 100;
+    int    nMSec  = int(nHours * 3'600'000.0);
+    if (nMSec <= 1000 || nMSec > MaxTicks || maxLag <= TrueLead)
+      throw invalid_argument("Invalid NHours or MaxLag");
+
+    //-----------------------------------------------------------------------//
+    // Simulate the Data:                                                    //
+    //-----------------------------------------------------------------------//
+    mt19937_64       rng(12345);
+    normal_distribution<> incr(0.0, 1.0);
+    vector<double>   px(static_cast<size_t>(nMSec));
+    double           p = 0.0;
+    for (double& x: px)
+    {
+      p += incr(rng);
+      x  = 100'000.0 + round(p);
+    }
+    vector<Tick> ticks1 = MkTicks(px, 0,        40.0, rng);
+    vector<Tick> ticks2 = MkTicks(px, TrueLead, 70.0, rng);
+    TicksArr& instr1 = AllocTicks();
+    TicksArr& instr2 = AllocTicks();
+    Fill(ticks1, instr1);
+    Fill(ticks2, instr2);
+
+    int idxFrom = max<int>(ticks1.front().m_t, ticks2.front().m_t);
+    int idxTo   = min<int>(ticks1.back ().m_t, ticks2.back ().m_t);
+
+    StatsT st1 = GetStatsHY(instr1, idxFrom, idxTo);
+    StatsT st2 = GetStatsHY(instr2, idxFrom, idxTo);
+
+    cout << ticks1.size() << " + " << ticks2.size() << " ticks over "
+         << nMSec << " msec, lags: [" << -maxLag << " .. " << maxLag
+         << "]\n" << endl;
+
+    //-----------------------------------------------------------------------//
+    // Per-Lag (as "MLL" did) vs All-Lags:                                   //
+    //-----------------------------------------------------------------------//
+    vector<double> perLag(static_cast<size_t>(2 * maxLag + 1));
+    utxx::time_val from = utxx::now_utc();
+    for (int l = -maxLag; l <= maxLag; ++l)
+      perLag[size_t(l + maxLag)] =
+        HayashiYoshidaCrossCorr
+          (instr1, st1, instr2, st2, idxFrom, idxTo, l);
+    double secPerLag = Sec(from);
+
+    from = utxx::now_utc();
+    vector<double> allLags = HayashiYoshidaCrossCorrs
+      (instr1, st1, instr2, st2, idxFrom, idxTo, -maxLag, maxLag);
+    double secAllLags = Sec(from);
+
+    for (int l = -maxLag; l <= maxLag; ++l)
+    {
+      double x = perLag [size_t(l + maxLag)];
+      double y = allLags[size_t(l + maxLag)];
+      if (!(Abs(x - y) <= 1e-9))
+      {
+        cerr << "MISMATCH: Lag=" << l << ": PerLag=" << x << ", AllLags="
+             << y << endl;
+        return 1;
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // Streaming:                                                            //
+    //-----------------------------------------------------------------------//
+    // Merge the ticks in time order:
+    vector<pair<int, Tick>> all;
+    all.reserve(ticks1.size() + ticks2.size());
+    for (Tick const& tick: ticks1) all.emplace_back(0, tick);
+    for (Tick const& tick: ticks2) all.emplace_back(1, tick);
+    stable_sort(all.begin(), all.end(),
+                [](pair<int, Tick> const& a_x, pair<int, Tick> const& a_y)
+                { return a_x.second.m_t < a_y.second.m_t; });
+
+    QuantSupport::LeadLagHY lhy(maxLag);
+    utxx::time_val          base = utxx::now_utc();
+
+    from = utxx::now_utc();
+    for (auto const& upd: all)
+      lhy.Update(upd.first, base + utxx::msecs(upd.second.m_t),
+                 upd.second.m_px);
+    double secOnline = Sec(from);
+
+    double corrOnline = 0.0;
+    int    leadOnline = lhy.GetLeadLag(&corrOnline);
+    int    leadPerLag = ArgMaxAbs(perLag,  -maxLag);
+    int    leadAll    = ArgMaxAbs(allLags, -maxLag);
+
+    cout << left << setw(14) << "Method" << right << setw(8) << "Lead"
+         << setw(10) << "Corr" << setw(14) << "Time, msec" << '\n'
+         << string(46, '-') << '\n' << fixed << setprecision(4)
+         << left << setw(14) << "PerLag"   << right << setw(8) << leadPerLag
+         << setw(10) << perLag [size_t(leadPerLag + maxLag)]
+         << setw(14) << setprecision(1) << secPerLag  * 1000.0 << '\n'
+         << setprecision(4)
+         << left << setw(14) << "AllLags"  << right << setw(8) << leadAll
+         << setw(10) << allLags[size_t(leadAll    + maxLag)]
+         << setw(14) << setprecision(1) << secAllLags * 1000.0 << '\n'
+         << setprecision(4)
+         << left << setw(14) << "Streaming" << right << setw(8) << leadOnline
+         << setw(10) << corrOnline
+         << setw(14) << setprecision(1) << secOnline  * 1000.0 << " ("
+         << setprecision(1) << (secOnline * 1e9 / double(all.size()))
+         << " ns/tick)" << endl;
+
+    if (leadPerLag != leadAll || abs(leadAll    - TrueLead) > 2 ||
+                                 abs(leadOnline - TrueLead) > 2)
+    {
+      cerr << "MISMATCH: Lead-Lag not recovered" << endl;
+      return 1;
+    }
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,287 @@
+// vim:ts=2:et
+//===========================================================================//
+//                       "Tests/MDStoreSeekBench.cpp":                       //
+//      MDStore Readers: Whole-File "MDStoreReader" vs mmap + Sparse Index   //
+//===========================================================================//
+// Usage: MDStoreSeekBench [TmpDir (default: /tmp)]
+// (*) Writes a synthetic day of L1 MktData (24 hourly files, ~1M recs) with
+//     "MDStoreWriter" into a temporary store; "ts_exch" lags "ts_recv" by a
+//     random latency, and occasionally runs ahead of it (clock skew), so it
+//     is not monotonic within the files;
+// (*) Cross-checks that "MDStoreMMapReader" seeks by "ts_recv" to the same
+//     records as "MDStoreReader", and by "ts_exch" to the same record as a
+//     linear scan of the whole day;
+// (*) Times a seek to a random time of the day (with and without opening the
+//     store first; for "ts_exch", with the index built on the fly or loaded
+//     from the persisted ".idx" files), and a scan of the whole day.
+// The output is similar to that of Google Benchmark:
+//
+#include "QuantSupport/MDStore.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <filesystem>
+#include <random>
+#include <vector>
+#include <string>
+#include <unistd.h>
+
+using namespace MAQUETTE;
+using namespace MAQUETTE::QuantSupport;
+using namespace std;
+
+namespace
+{
+  using Writer  = MDStoreWriter    <MDRecL1>;
+  using Reader  = MDStoreReader    <MDRecL1>;
+  using MReader = MDStoreMMapReader<MDRecL1>;
+  using Rec     = Reader::MDStoreRecord;
+
+  constexpr int  Hours   = 24;
+  constexpr long PerHour = 40'000;
+  char const     Venue[] = "BENCH";
+  char const     Symbol[]= "EUR/USD";
+
+  //=========================================================================//
+  // "DoNotOptimize", "Bench":                                               //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  template<typename F>
+  void Bench(string const& a_name, long a_n, char const* a_unit, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    double ns = sec * 1e9 / double(n * a_n);
+    cout << left  << setw(34) << a_name
+         << right << setw(14) << fixed << setprecision(1) << ns << " ns/"
+         << a_unit << endl;
+  }
+
+  //=========================================================================//
+  // "Generate": Writes the store, returns all recs in file order:           //
+  //=========================================================================//
+  vector<Rec> Generate(string const& a_root, utxx::time_val a_day)
+  {
+    mt19937_64  rng(12345);
+    vector<Rec> res;
+    res.reserve(size_t(Hours * PerHour));
+
+    Writer wr(a_root, Venue, Symbol, "ob_L1");
+    long   step = 3600L * 1'000'000'000L / PerHour;
+    long   t    = 0;
+    double px   = 1.1;
+    for (long i = 0; i < Hours * PerHour; ++i)
+    {
+      t  += 1 + long(rng() % uint64_t(2 * step));
+      if (t >= Hours * 3600L * 1'000'000'000L)
+        break;
+      px += (double(rng() % 21) - 10.0) * 1e-5;
+
+      Rec r;
+      r.ts_recv = a_day + utxx::nsecs(t);
+      // Latency of 0..5ms, or (1 in 64) the Exchange clock 0..1ms ahead:
+      long lat  = (rng() % 64 == 0)
+                ? -long(rng() % 1'000'000)
+                :  long(rng() % 5'000'000);
+      r.ts_exch = r.ts_recv - utxx::nsecs(lat);
+      r.rec     = MDRecL1{px - 5e-5, px + 5e-5,
+                          double(1 + rng() % 10) * 1e5,
+                          double(1 + rng() % 10) * 1e5};
+      wr.Write(r);
+      res.push_back(r);
+    }
+    return res;
+  }
+
+  inline bool Same(Rec const& a_l, Rec const& a_r)
+  {
+    return a_l.ts_recv == a_r.ts_recv && a_l.ts_exch == a_r.ts_exch &&
+           a_l.rec.bid == a_r.rec.bid && a_l.rec.ask == a_r.rec.ask;
+  }
+
+  //=========================================================================//
+  // "TmpStore": Removes the store on exit:                                  //
+  //=========================================================================//
+  struct TmpStore
+  {
+    filesystem::path m_root;
+
+    explicit TmpStore(string const& a_dir)
+    : m_root(filesystem::path(a_dir) /
+             ("MDStoreSeekBench." + to_string(getpid())))
+    {}
+
+    ~TmpStore()
+    {
+      error_code ec;
+      filesystem::remove_all(m_root, ec);
+    }
+  };
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    TmpStore         store((argc >= 2) ? argv[1] : "/tmp");
+    string const     root = store.m_root.string();
+    utxx::time_val   day(2020, 1, 2, 0, 0, 0, 0);
+    vector<Rec>      all  = Generate(root, day);
+    long const       nRecs = long(all.size());
+
+    // Random seek targets within the day:
+    mt19937_64             rng(54321);
+    vector<utxx::time_val> targets(1'024);
+    for (utxx::time_val& t: targets)
+      t = day + utxx::nsecs(
+          long(rng() % uint64_t(Hours * 3600L * 1'000'000'000L)));
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    {
+      Reader  rd (root, Venue, Symbol, "ob_L1");
+      MReader mrd(root, Venue, Symbol, "ob_L1", false);
+
+      long n = 0;
+      auto it = all.begin();
+      mrd.Read(day, [&](Rec const& a_r)
+        {
+          if (it == all.end() || !Same(*(it++), a_r))
+            return false;
+          ++n;
+          return true;
+        });
+      if (n != nRecs)
+      {
+        cerr << "MISMATCH: Scanned " << n << " recs, expected " << nRecs
+             << endl;
+        return 1;
+      }
+
+      for (utxx::time_val t: targets)
+      {
+        Rec  exp;
+        bool found = false;
+        rd.Read(t, [&](Rec const& a_r)
+          { exp = a_r; found = true; return false; });
+
+        MReader::Pos pos = mrd.SeekRecv(t);
+        if (found != (pos != mrd.End()) || (found && !Same(exp, mrd[pos])))
+        {
+          cerr << "MISMATCH: SeekRecv to " << t.nanoseconds() << endl;
+          return 1;
+        }
+
+        auto ex = find_if(all.begin(), all.end(),
+                          [t](Rec const& a_r) { return a_r.ts_exch >= t; });
+        pos     = mrd.SeekExch(t);
+        if ((ex == all.end()) != (pos == mrd.End()) ||
+            (ex != all.end() && !Same(*ex, mrd[pos])))
+        {
+          cerr << "MISMATCH: SeekExch to " << t.nanoseconds() << endl;
+          return 1;
+        }
+      }
+    }
+
+    cout << nRecs << " recs in " << Hours << " files\n\n"
+         << left  << setw(34) << "Benchmark" << right << setw(19) << "Time\n"
+         << string(56, '-') << endl;
+
+    //-----------------------------------------------------------------------//
+    // Seeks in an open store:                                               //
+    //-----------------------------------------------------------------------//
+    size_t  i = 0;
+    Reader  rd (root, Venue, Symbol, "ob_L1");
+    MReader mrd(root, Venue, Symbol, "ob_L1", false);
+
+    Bench("Reader/Seek",               1, "seek", [&]
+      {
+        rd.Read(targets[i++ % targets.size()],
+                [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+    Bench("MMap/SeekRecv",             1, "seek", [&]
+      {
+        mrd.Read(targets[i++ % targets.size()],
+                 [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+    Bench("MMap/SeekExch",             1, "seek", [&]
+      {
+        mrd.ReadExch(targets[i++ % targets.size()],
+                     [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+
+    //-----------------------------------------------------------------------//
+    // Open the store, then seek (as a tool starting mid-day does):          //
+    //-----------------------------------------------------------------------//
+    Bench("Reader/Open+Seek",          1, "seek", [&]
+      {
+        Reader r(root, Venue, Symbol, "ob_L1");
+        r.Read(targets[i++ % targets.size()],
+               [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+    Bench("MMap/Open+SeekRecv",        1, "seek", [&]
+      {
+        MReader r(root, Venue, Symbol, "ob_L1", false);
+        r.Read(targets[i++ % targets.size()],
+               [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+    // No ".idx" files exist yet, so the index of each file visited is built:
+    Bench("MMap/Open+SeekExch/BuildIdx", 1, "seek", [&]
+      {
+        MReader r(root, Venue, Symbol, "ob_L1", false);
+        r.ReadExch(targets[i++ % targets.size()],
+                   [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+    // Persist the index of all files, then load it:
+    {
+      MReader r(root, Venue, Symbol, "ob_L1");
+      for (size_t f = 0; f < r.NumFiles(); ++f)
+        r.SeekExch(day + utxx::secs(3600 * long(f)));
+    }
+    Bench("MMap/Open+SeekExch/LoadIdx",  1, "seek", [&]
+      {
+        MReader r(root, Venue, Symbol, "ob_L1");
+        r.ReadExch(targets[i++ % targets.size()],
+                   [](Rec const& a_r) { DoNotOptimize(a_r); return false; });
+      });
+
+    //-----------------------------------------------------------------------//
+    // Full scans:                                                           //
+    //-----------------------------------------------------------------------//
+    Bench("Reader/Scan",           nRecs, "rec", [&]
+      {
+        double acc = 0.0;
+        rd.Read(day, [&](Rec const& a_r) { acc += a_r.rec.bid; return true; });
+        DoNotOptimize(acc);
+      });
+    Bench("MMap/Scan",             nRecs, "rec", [&]
+      {
+        double acc = 0.0;
+        mrd.Read(day,
+                 [&](Rec const& a_r) { acc += a_r.rec.bid; return true; });
+        DoNotOptimize(acc);
+      });
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,301 @@
+// vim:ts=2:et
+//===========================================================================//
+//                           "Tests/OBScanBench.cpp":                        //
+//    Depth Scans of a Dense OrderBook: Vectorised SoA vs Per-Entry Loops    //
+//===========================================================================//
+// For several realistic Book shapes (fully-populated, gappy and sparse depth),
+// compares the following implementations of "next non-empty level", "cumulat-
+// ive Qty of N levels" and "VWAP for a given Qty":
+// (*) "Loop":   per-slot loops over "OBEntry"s, as the Dense OrderBook used to
+//               do;
+// (*) "Scalar": scans of the SoA Qtys, scalar code;
+// (*) "AVX2":   scans of the SoA Qtys, vectorised code (if available);
+// (*) "OB":     the corresp "OrderBook" methods (end-to-end).
+// The results of all implementations are cross-checked first. The output is
+// similar to that of Google Benchmark:
+//
+#include "Connectors/OrderBook.hpp"
+#include "Basis/SIMDScans.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types and Consts:                                                       //
+  //=========================================================================//
+  constexpr QtyTypeT QT     = QtyTypeT::QtyA;
+  using    QR               = double;
+  using    QtyT             = Qty<QT,QR>;
+  constexpr int      NL     = 1 << 16;  // Total Levels (per side)
+  constexpr int      Best   = NL / 2;   // Slot of the Best Bid
+  constexpr int      Depth  = 8192;     // Populated range below the Best Bid
+  constexpr double   PxStep = 0.01;
+
+  //=========================================================================//
+  // "DoNotOptimize":                                                        //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  //=========================================================================//
+  // "Bench": Runs "a_f" (which returns the number of ops performed) until at //
+  // least 0.2 sec has elapsed, and prints the time per op:                  //
+  //=========================================================================//
+  template<typename F>
+  void Bench(string const& a_name, F const& a_f)
+  {
+    long   nOps = 0;
+    double sec  = 0.0;
+    for (long n = 1; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      nOps = 0;
+      for (long i = 0; i < n; ++i)
+        nOps += a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    cout << left  << setw(40) << a_name
+         << right << setw(12) << fixed << setprecision(2)
+         << (sec * 1e9 / double(nOps)) << " ns" << setw(14) << nOps << '\n';
+  }
+
+  //=========================================================================//
+  // "Loop*": Reference implementations over "OBEntry"s (Bids only):         //
+  //=========================================================================//
+  inline int LoopNext(OrderBook::OBEntry const* a_side, int a_s, int a_lo)
+  {
+    for (int s = a_s; s >= a_lo; --s)
+      if (IsPos(a_side[s].m_aggrQty))
+        return s;
+    return -1;
+  }
+
+  inline double LoopCumQty(OrderBook::OBEntry const* a_side, int a_lo, int a_n)
+  {
+    double res = 0.0;
+    for (int s = Best, d = 0; s >= a_lo && d < a_n; --s)
+      if (IsPos(a_side[s].m_aggrQty))
+      {
+        res += double(a_side[s].GetAggrQty<QT,QR>());
+        ++d;
+      }
+    return res;
+  }
+
+  inline double LoopVWAP
+    (OrderBook::OBEntry const* a_side, int a_lo, double a_best_px, double a_q)
+  {
+    double rem = a_q;
+    double cum = 0.0;
+    for (int s = Best; s >= a_lo && rem > 0.0; --s)
+      if (IsPos(a_side[s].m_aggrQty))
+      {
+        double q  = double(a_side[s].GetAggrQty<QT,QR>());
+        double v  = Min(q, rem);
+        cum      += (a_best_px + double(s - Best) * PxStep) * (v / a_q);
+        rem      -= v;
+      }
+    return (rem > 0.0) ? NaN<double> : cum;
+  }
+
+  //=========================================================================//
+  // "RunShape":                                                             //
+  //=========================================================================//
+  bool RunShape(char const* a_shape, double a_fill_prob, SecDefD const& a_instr)
+  {
+    //-----------------------------------------------------------------------//
+    // Populate the Book (Bids only), and its "OBEntry" and SoA copies:      //
+    //-----------------------------------------------------------------------//
+    OrderBook ob(nullptr, &a_instr, false, false, QT, true, false, false,
+                 false, NL, 0, 0, false);
+    vector<OrderBook::OBEntry> entries(NL);
+    vector<double>             qtys   (NL, 0.0);
+
+    mt19937_64                  rng(2024);
+    uniform_real_distribution<> u01;
+    double bestPx = 1000.0;
+    int    lo     = Best;
+    double totQty = 0.0;
+
+    for (int s = Best; s > Best - Depth; --s)
+    {
+      // L1 is always populated:
+      if (s != Best && u01(rng) >= a_fill_prob)
+        continue;
+      double q  = Round(1.0 + 20.0 * u01(rng));
+      PriceT px(bestPx + double(s - Best) * PxStep);
+      (void) ob.Update<true, false, false, false, true, false, false, QT, QR>
+        (FIX::MDUpdateActionT::New, px, QtyT(q), 0, 0, nullptr);
+
+      entries[size_t(s)].m_ob      = &ob;
+      entries[size_t(s)].m_aggrQty = QtyU(q);
+      qtys   [size_t(s)]           = q;
+      lo      = s;
+      totQty += q;
+    }
+    OrderBook::OBEntry const* side = entries.data();
+    double const*             qs   = qtys.data();
+    PriceT                    bbPx = ob.GetBestBidPx();
+    assert(IsFinite(bbPx));
+
+    // Random starting points for "next level" scans (within the top levels):
+    vector<int> starts(1024);
+    uniform_int_distribution<int> startD(Best - 255, Best);
+    for (int& st: starts)
+      st = startD(rng);
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check the Implementations:                                      //
+    //-----------------------------------------------------------------------//
+    for (int st: starts)
+    {
+      int    r0 = LoopNext(side, st, lo);
+      int    r1 = SIMD::FindPos<false, false>(qs, st, lo);
+      int    r2 = SIMD::FindPos<false>       (qs, st, lo);
+      PriceT p3 = ob.GetNextPx<true>(PriceT(bestPx + double(st + 1 - Best) *
+                                                     PxStep));
+      PriceT p0 = (r0 >= 0)
+                  ? PriceT(bestPx + double(r0 - Best) * PxStep) : PriceT();
+      if (r0 != r1 || r0 != r2 || !(p0 == p3 || (!IsFinite(p0) &&
+                                                 !IsFinite(p3))))
+      {
+        cerr << a_shape << ": NextLevel MISMATCH at " << st << endl;
+        return false;
+      }
+    }
+    for (int n: {1, 5, 20, 100, 1000000})
+    {
+      double r0 = LoopCumQty(side, lo, n);
+      double r1 = SIMD::CumQtyN<false, false>(qs, Best, lo, n).m_qty;
+      double r2 = SIMD::CumQtyN<false>       (qs, Best, lo, n).m_qty;
+      double r3 = double(ob.GetCumQty<true, QT, QR>(n));
+      if (r0 != r1 || r0 != r2 || r0 != r3)
+      {
+        cerr << a_shape << ": CumQty MISMATCH for N=" << n << endl;
+        return false;
+      }
+    }
+    for (double q: {5.0, 100.0, 1000.0, totQty, totQty + 1.0})
+    {
+      double r0 = LoopVWAP(side, lo, bestPx, q);
+      SIMD::DepthScan ds1 = SIMD::ScanToQty<false, false>(qs, Best, lo, q);
+      SIMD::DepthScan ds2 = SIMD::ScanToQty<false>       (qs, Best, lo, q);
+      double r1 = (ds1.m_qty == q) ? bestPx - ds1.m_qtyOff / q * PxStep
+                                   : NaN<double>;
+      double r2 = (ds2.m_qty == q) ? bestPx - ds2.m_qtyOff / q * PxStep
+                                   : NaN<double>;
+      double r3 = double(ob.GetVWAP1<QT, QR, true>(QtyT(q)));
+      bool   ok = true;
+      for (double r: {r1, r2, r3})
+        ok &= (!IsFinite(r0) && !IsFinite(r))            ||
+              (IsFinite(r0)  && Abs(r - r0) < 1e-9 * r0);
+      if (!ok)
+      {
+        cerr << a_shape << ": VWAP MISMATCH for Qty=" << q << endl;
+        return false;
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // Benchmarks:                                                           //
+    //-----------------------------------------------------------------------//
+    string pfx = "BM_";
+    string sh  = string("/") + a_shape;
+
+    // Next Non-Empty Level:
+    Bench(pfx + "NextLevel" + sh + "/Loop",   [&]() -> long
+    {
+      for (int st: starts) DoNotOptimize(LoopNext(side, st, lo));
+      return long(starts.size());
+    });
+    Bench(pfx + "NextLevel" + sh + "/Scalar", [&]() -> long
+    {
+      for (int st: starts)
+        DoNotOptimize(SIMD::FindPos<false, false>(qs, st, lo));
+      return long(starts.size());
+    });
+    Bench(pfx + "NextLevel" + sh + "/AVX2",   [&]() -> long
+    {
+      for (int st: starts) DoNotOptimize(SIMD::FindPos<false>(qs, st, lo));
+      return long(starts.size());
+    });
+    Bench(pfx + "NextLevel" + sh + "/OB",     [&]() -> long
+    {
+      for (int st: starts)
+        DoNotOptimize(ob.GetNextPx<true>(bbPx - double(Best - st) * PxStep));
+      return long(starts.size());
+    });
+
+    // Cumulative Qty of N Levels:
+    for (int n: {5, 20, 100})
+    {
+      string nm = pfx + "CumQty" + sh + "/N=" + to_string(n);
+      Bench(nm + "/Loop",   [&]() -> long
+        { DoNotOptimize(LoopCumQty(side, lo, n)); return 1; });
+      Bench(nm + "/Scalar", [&]() -> long
+        { DoNotOptimize(SIMD::CumQtyN<false, false>(qs, Best, lo, n));
+          return 1; });
+      Bench(nm + "/AVX2",   [&]() -> long
+        { DoNotOptimize(SIMD::CumQtyN<false>(qs, Best, lo, n)); return 1; });
+      Bench(nm + "/OB",     [&]() -> long
+        { DoNotOptimize(ob.GetCumQty<true, QT, QR>(n)); return 1; });
+    }
+
+    // VWAP for a given Qty:
+    for (double q: {50.0, 500.0, 5000.0})
+    {
+      string nm = pfx + "VWAP" + sh + "/Q=" + to_string(long(q));
+      Bench(nm + "/Loop",   [&]() -> long
+        { DoNotOptimize(LoopVWAP(side, lo, bestPx, q)); return 1; });
+      Bench(nm + "/Scalar", [&]() -> long
+        { DoNotOptimize(SIMD::ScanToQty<false, false>(qs, Best, lo, q));
+          return 1; });
+      Bench(nm + "/AVX2",   [&]() -> long
+        { DoNotOptimize(SIMD::ScanToQty<false>(qs, Best, lo, q)); return 1; });
+      Bench(nm + "/OB",     [&]() -> long
+        { DoNotOptimize(ob.GetVWAP1<QT, QR, true>(QtyT(q))); return 1; });
+    }
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main()
+{
+  try
+  {
+    SecDefD instr;
+    instr.m_SecID    = 1;
+    instr.m_PxStep   = PxStep;
+    instr.m_FullName = MkObjName("SYNTH");
+
+    cout << "AVX2: " << (SIMD::HasAVX2 ? "yes" : "no") << '\n'
+         << left  << setw(40) << "Benchmark"
+         << right << setw(15) << "Time" << setw(14) << "Ops" << '\n'
+         << string(69, '-') << endl;
+
+    // Book shapes: fraction of populated levels in the Depth:
+    if (!RunShape("Full",   1.0,        instr) ||
+        !RunShape("Gappy",  0.25,       instr) ||
+        !RunShape("Sparse", 1.0 / 32.0, instr))
+      return 1;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
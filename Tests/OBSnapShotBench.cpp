@@ -0,0 +1,235 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/OBSnapShotBench.cpp":                     //
+//     Cross-Thread OrderBook SnapShots: Writer Overhead and Consistency     //
+//===========================================================================//
+// (1) Consistency: the writer keeps all published levels of the Book at the
+//     same Qty (which changes on each round), while a reader thread takes
+//     SnapShots concurrently; any torn SnapShot would have different Qtys;
+// (2) Writer overhead: a stream of random L2 updates is applied to a Dense
+//     and a Sparse Book, with and without publishing a SnapShot after each
+//     update (the worst case: normally, SnapShots are published once per
+//     batch of updates), for several SnapShot depths:
+//
+#include "Connectors/OrderBook.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types and Consts:                                                       //
+  //=========================================================================//
+  constexpr QtyTypeT QT     = QtyTypeT::QtyA;
+  using    QR               = double;
+  using    QtyT             = Qty<QT,QR>;
+  constexpr int      NL     = 1 << 12;  // Dense Book size
+  constexpr int      NLvls  = 50;       // Populated levels on each side
+  constexpr double   Mid    = 1000.0;
+  constexpr double   PxStep = 0.01;
+
+  //-------------------------------------------------------------------------//
+  // "L2Op": A single OrderBook Update:                                      //
+  //-------------------------------------------------------------------------//
+  struct L2Op
+  {
+    bool    m_isBid;
+    int     m_lvl;     // 0-based, from L1
+    double  m_qty;     // Target Qty (> 0)
+  };
+
+  inline PriceT LvlPx(bool a_is_bid, int a_lvl)
+  {
+    double off = double(a_lvl + 1) * PxStep;
+    return PriceT(a_is_bid ? (Mid - off) : (Mid + off));
+  }
+
+  //=========================================================================//
+  // "Apply":                                                                //
+  //=========================================================================//
+  template<bool IsSparse>
+  inline void Apply(OrderBook* a_ob, L2Op const& a_op)
+  {
+    PriceT px  = LvlPx(a_op.m_isBid, a_op.m_lvl);
+    QtyT   qty(a_op.m_qty);
+    if (a_op.m_isBid)
+      (void) a_ob->Update
+        <true,  false, false, false, true, false, IsSparse, QT, QR>
+        (FIX::MDUpdateActionT::Change, px, qty, 0, 0, nullptr);
+    else
+      (void) a_ob->Update
+        <false, false, false, false, true, false, IsSparse, QT, QR>
+        (FIX::MDUpdateActionT::Change, px, qty, 0, 0, nullptr);
+  }
+
+  //=========================================================================//
+  // "MkBook": With "NLvls" levels populated on each side:                   //
+  //=========================================================================//
+  template<bool IsSparse>
+  OrderBook* MkBook(SecDefD const& a_instr, int a_ss_depth)
+  {
+    OrderBook* ob =
+      new OrderBook(nullptr, &a_instr, false, IsSparse, QT, true, false,
+                    false, false, IsSparse ? 0 : NL, 0, 0, false);
+    if (a_ss_depth > 0)
+      ob->EnableSnapShots(a_ss_depth);
+    ob->SetInitialised();
+
+    for (int l = 0; l < NLvls; ++l)
+    {
+      Apply<IsSparse>(ob, L2Op{true,  l, 10.0});
+      Apply<IsSparse>(ob, L2Op{false, l, 10.0});
+    }
+    return ob;
+  }
+
+  //=========================================================================//
+  // "CheckConsistency":                                                     //
+  //=========================================================================//
+  bool CheckConsistency(SecDefD const& a_instr, long a_rounds)
+  {
+    constexpr int Depth = OBSnapShot::MaxDepth;
+    unique_ptr<OrderBook> ob(MkBook<false>(a_instr, Depth));
+
+    atomic<bool> done(false);
+    long nReads = 0, nTorn = 0, nBack = 0;
+
+    thread reader([&]()
+    {
+      OBSnapShot ss;
+      long       lastVer = 0;
+      while (!done.load(memory_order_relaxed))
+      {
+        if (!ob->GetSnapShot(&ss))
+          continue;
+        ++nReads;
+        bool ok =
+          ss.m_nBids == Depth && ss.m_nAsks == Depth && ss.m_isValid;
+        for (int l = 0; ok && l < Depth; ++l)
+          ok = (ss.m_bidQtys[l] == ss.m_bidQtys[0]                    &&
+                ss.m_askQtys[l] == ss.m_bidQtys[0]                    &&
+                Abs(ss.m_bidPxs[l] - LvlPx(true,  l)) < PxStep / 2.0  &&
+                Abs(ss.m_askPxs[l] - LvlPx(false, l)) < PxStep / 2.0);
+        nTorn  += !ok;
+        nBack  += (ss.m_version < lastVer);
+        lastVer = ss.m_version;
+      }
+    });
+
+    // Writer: All published levels get the same Qty in each round:
+    for (long r = 0; r < a_rounds; ++r)
+    {
+      double q = double(1 + r % 1000);
+      for (int l = 0; l < Depth; ++l)
+      {
+        Apply<false>(ob.get(), L2Op{true,  l, q});
+        Apply<false>(ob.get(), L2Op{false, l, q});
+      }
+      ob->PublishSnapShot(true, utxx::time_val(), utxx::time_val());
+    }
+    done.store(true);
+    reader.join();
+
+    cout << "Consistency: Rounds=" << a_rounds << ", Reads=" << nReads
+         << ", Torn=" << nTorn << ", Non-Monotonic=" << nBack << endl;
+    return (nTorn == 0 && nBack == 0);
+  }
+
+  //=========================================================================//
+  // "RunOps": Returns ns/update:                                            //
+  //=========================================================================//
+  template<bool IsSparse, bool WithPub>
+  double RunOps(OrderBook* a_ob, vector<L2Op> const& a_ops)
+  {
+    utxx::time_val from = utxx::now_utc();
+    for (L2Op const& op: a_ops)
+    {
+      Apply<IsSparse>(a_ob, op);
+      if constexpr (WithPub)
+        a_ob->PublishSnapShot(true, utxx::time_val(), utxx::time_val());
+    }
+    double sec = (utxx::now_utc() - from).seconds();
+    return sec * 1e9 / double(a_ops.size());
+  }
+
+  template<bool IsSparse>
+  void RunOverhead(SecDefD const& a_instr, vector<L2Op> const& a_ops)
+  {
+    char const* rep = IsSparse ? "Sparse" : "Dense ";
+    double      ns0;
+    {
+      unique_ptr<OrderBook> ob(MkBook<IsSparse>(a_instr, 0));
+      (void) RunOps<IsSparse, false>(ob.get(), a_ops);   // Warm-up
+      ns0 = RunOps<IsSparse, false>(ob.get(), a_ops);
+    }
+    cout << rep << ": Update only         : " << setw(7) << ns0
+         << " ns/update\n";
+
+    for (int depth: {1, 5, 10, 20})
+    {
+      unique_ptr<OrderBook> ob(MkBook<IsSparse>(a_instr, depth));
+      (void) RunOps<IsSparse, true>(ob.get(), a_ops);
+      double ns1 = RunOps<IsSparse, true>(ob.get(), a_ops);
+      cout << rep << ": Update+Publish D=" << setw(2) << depth << " : "
+           << setw(7) << ns1 << " ns/update, Overhead=" << setw(7)
+           << (ns1 - ns0) << " ns\n";
+    }
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NUpdates]:
+  long nOps = (argc >= 2) ? atol(argv[1]) : 2000000;
+  if (nOps <= 0)
+  {
+    cerr << "PARAMETERS: [NUpdates]" << endl;
+    return 1;
+  }
+  try
+  {
+    SecDefD instr;
+    instr.m_SecID    = 1;
+    instr.m_PxStep   = PxStep;
+    instr.m_FullName = MkObjName("SYNTH");
+
+    if (!CheckConsistency(instr, nOps / 20))
+    {
+      cerr << "Consistency Check FAILED" << endl;
+      return 1;
+    }
+
+    // Random updates, skewed towards the top levels:
+    mt19937_64                  rng(777);
+    uniform_real_distribution<> u01;
+    geometric_distribution<int> lvlD(0.2);
+    vector<L2Op> ops(static_cast<size_t>(nOps));
+    for (L2Op& op: ops)
+      op = L2Op{u01(rng) < 0.5, min(lvlD(rng), NLvls - 1),
+                1.0 + Round(99.0 * u01(rng))};
+
+    cout << fixed << setprecision(2);
+    RunOverhead<false>(instr, ops);
+    RunOverhead<true> (instr, ops);
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
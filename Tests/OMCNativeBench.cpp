@@ -0,0 +1,685 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Tests/OMCNativeBench.cpp":                       //
+//    New Order Tick-to-Wire Latency: Virtual vs Native ("OMCNative") API    //
+//===========================================================================//
+// Usage: OMCNativeBench [NOrders (default: 50000)]
+// (*) "BenchOMC" is a minimal OMC in the Test env, built as the real TWIME
+//     one is: it is its own ProtoEngine and SessMgr, and derives from "OMC-
+//     Native"; its "NewOrderImpl" fills in a TWIME "NewOrderSingle", and
+//     "FlushOrdersImpl" "sends" it by copying it into the "wire" buffer (no
+//     socket I/O), so the whole "EConnector_OrdMgmt" path (AOS and Req12 in
+//     ShM, indices, throttling) is exercised;
+// (*) "BenchFIXOMC" is built as "EConnector_FIX<LMAX>" is, with the TCP Con-
+//     nector replaced by a loopback "SendImpl":  it is its own SessData and
+//     "FIX::ProtoEngine", so "NewOrderSingle"s are generated by the real FIX
+//     Senders (including "HotOrderTmpls") and copied into the "wire" buffer;
+// (*) Cross-checks that the Virtual "NewOrder" (via an "EConnector_OrdMgmt"
+//     ptr, with "QtyAny" args) and the Native "NewOrderN" (with an "Order-
+//     Desc") put identical msgs on the wire (apart from the ClOrdIDs and, in
+//     FIX, the SeqNums, TimeStamps and CheckSums);
+// (*) Then measures the latency of NewOrder calls (from the Strategy's call
+//     to the return, which is after the msg is on the wire), interleaving
+//     both APIs, and prints the percentiles (in nsec, as "FIXSendBench"):
+//
+#include "Connectors/EConnector_OrdMgmt.hpp"
+#include "Connectors/EConnector_OrdMgmt.h"
+#include "Basis/EPollReactor.h"
+#include "InfraStruct/PersistMgr.h"
+#include "InfraStruct/SecDefsMgr.h"
+#include "Protocols/TWIME/Msgs.h"
+#include "Venues/LMAX/Features_FIX.h"
+#include "Protocols/FIX/ProtoEngine.hpp"
+#include "InfraStruct/Strategy.hpp"
+#include <utxx/time_val.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "NowNSec":                                                              //
+  //=========================================================================//
+  inline long NowNSec()
+  {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1'000'000'000L + ts.tv_nsec;
+  }
+
+  //=========================================================================//
+  // "BenchOMC":                                                             //
+  //=========================================================================//
+  class BenchOMC:
+    public EConnector_OrdMgmt,
+    public OMCNative<BenchOMC>
+  {
+  public:
+    //-----------------------------------------------------------------------//
+    // Features (as in TWIME):                                               //
+    //-----------------------------------------------------------------------//
+    constexpr static QtyTypeT QT                  = QtyTypeT::Contracts;
+    using                     QR                  = long;
+    using                     QtyN                = Qty<QT,QR>;
+    constexpr static bool     HasBatchSend        = true;
+    constexpr static bool     HasAtomicModify     = true;
+    constexpr static bool     HasNativeMassCancel = false;
+    constexpr static bool     HasFreeCancel       = true;
+
+  private:
+    friend class EConnector_OrdMgmt;
+    friend class OMCNative<BenchOMC>;
+
+    // TxSN and RxSN (as in the SessData):
+    SeqNum*       m_txSN;
+    SeqNum*       m_rxSN;
+
+    // Out Buffer and the "wire":
+    mutable char  m_outBuff[1024];
+    mutable int   m_outBuffLen;
+    mutable char  m_wire   [1024];
+    mutable int   m_wireLen;
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Ctor:                                                                 //
+    //-----------------------------------------------------------------------//
+    BenchOMC
+    (
+      EPollReactor*                      a_reactor,
+      SecDefsMgr*                        a_sec_defs_mgr,
+      boost::property_tree::ptree const& a_params
+    )
+    : EConnector
+      (
+        a_params.get<string>("AccountKey"), "FORTS", 0, a_reactor, false,
+        a_sec_defs_mgr, vector<SecDefS>(), nullptr, false, false, nullptr,
+        a_params, QT, false
+      ),
+      EConnector_OrdMgmt
+      (
+        true, a_params, 1, 0, PipeLineModeT::Wait1, true, false, true, true,
+        true, false
+      ),
+      m_txSN      (m_TxSN),
+      m_rxSN      (m_RxSN),
+      m_outBuffLen(0),
+      m_wireLen   (0)
+    {}
+
+    //-----------------------------------------------------------------------//
+    // "EConnector" and "EConnector_OrdMgmt" Virtual Methods:                //
+    //-----------------------------------------------------------------------//
+    void EnsureAbstract() const override {}
+    void Start()                override {}
+    void Stop ()                override {}
+    bool IsActive() const       override { return true; }
+
+    AOS const* NewOrder
+    (
+      Strategy*           a_strategy,
+      SecDefD const&      a_instr,
+      FIX::OrderTypeT     a_ord_type,
+      bool                a_is_buy,
+      PriceT              a_px,
+      bool                a_is_aggr,
+      QtyAny              a_qty,
+      utxx::time_val      a_ts_md_exch,
+      utxx::time_val      a_ts_md_conn,
+      utxx::time_val      a_ts_md_strat,
+      bool                a_batch_send,
+      FIX::TimeInForceT   a_time_in_force,
+      int                 a_expire_date,
+      QtyAny              a_qty_show,
+      QtyAny              a_qty_min,
+      bool                a_peg_side,
+      double              a_peg_offset
+    )
+    override
+    {
+      return EConnector_OrdMgmt::NewOrderGen<QT, QR>
+      (
+        this,          this,          a_strategy,    a_instr,
+        a_ord_type,    a_is_buy,      a_px,          a_is_aggr,
+        a_qty,         a_ts_md_exch,  a_ts_md_conn,  a_ts_md_strat,
+        a_batch_send,  a_time_in_force,              a_expire_date,
+        a_qty_show,    a_qty_min,     a_peg_side,    a_peg_offset
+      );
+    }
+
+    bool CancelOrder
+      (AOS const*, utxx::time_val, utxx::time_val, utxx::time_val, bool)
+    override
+      { return false; }
+
+    bool ModifyOrder
+    (
+      AOS const*, PriceT, bool, QtyAny, utxx::time_val, utxx::time_val,
+      utxx::time_val, bool, QtyAny, QtyAny
+    )
+    override
+      { return false; }
+
+    void CancelAllOrders
+      (unsigned long, SecDefD const*, FIX::SideT, char const*) override {}
+
+    utxx::time_val FlushOrders() override
+      { return FlushOrdersGen<BenchOMC, BenchOMC>(this, this); }
+
+    //-----------------------------------------------------------------------//
+    // The last msg on the "wire":                                           //
+    //-----------------------------------------------------------------------//
+    using MsgT = TWIME::NewOrderSingle;
+
+    MsgT const& LastSent() const
+    {
+      assert(m_wireLen == int(sizeof(MsgT)));
+      return *reinterpret_cast<MsgT const*>(m_wire);
+    }
+
+    // Whether 2 msgs are identical apart from their ClOrdIDs, which must be
+    // the given ones:
+    static bool SameMsgs
+      (MsgT a_msg1, OrderID a_id1, MsgT a_msg2, OrderID a_id2)
+    {
+      if (a_msg1.m_ClOrdID != a_id1 || a_msg2.m_ClOrdID != a_id2)
+        return false;
+      a_msg1.m_ClOrdID = 0;
+      a_msg2.m_ClOrdID = 0;
+      return memcmp(&a_msg1, &a_msg2, sizeof(MsgT)) == 0;
+    }
+
+  private:
+    //-----------------------------------------------------------------------//
+    // "EConnector_OrdMgmt" Call-Backs:                                      //
+    //-----------------------------------------------------------------------//
+    // As in "EConnector_TWIME_FORTS":
+    //
+    void NewOrderImpl(BenchOMC*, Req12* a_new_req, bool a_batch_send)
+    {
+      assert(a_new_req != nullptr && a_new_req->m_aos != nullptr);
+      AOS const*     aos   = a_new_req->m_aos;
+      SecDefD const* instr = aos->m_instr;
+      Strategy*      strat = aos->m_strategy;
+      assert(instr != nullptr && strat != nullptr);
+
+      TWIME::NewOrderSingle* tmsg =
+        reinterpret_cast<TWIME::NewOrderSingle*>(m_outBuff + m_outBuffLen);
+      m_outBuffLen += int(sizeof(TWIME::NewOrderSingle));
+
+      tmsg->m_BlockLength = sizeof(TWIME::NewOrderSingle) -
+                            sizeof(TWIME::MsgHdr);
+      tmsg->m_TemplateID  = TWIME::NewOrderSingle::s_id;
+      tmsg->m_SchemaID    = TWIME::SchemaID;
+      tmsg->m_Version     = TWIME::SchemaVer;
+      tmsg->m_ClOrdID     = a_new_req->m_id;
+      tmsg->m_ExpireDate  = TWIME::EmptyTimeStamp;
+      tmsg->m_Price       = TWIME::Decimal5T(a_new_req->m_px);
+      tmsg->m_SecurityID  = int32_t(instr->m_SecID);
+      tmsg->m_ClOrdLinkID = int32_t (strat->GetHash48() & 0xFFFFFFFFUL);
+      tmsg->m_OrderQty    = uint32_t(QR(a_new_req->GetQty<QT,QR>()));
+      tmsg->m_TimeInForce =
+        TWIME::TimeInForceE::type(char(aos->m_timeInForce) - '0');
+      tmsg->m_Side        =
+        aos->m_isBuy ? TWIME::SideE::Buy : TWIME::SideE::Sell;
+      tmsg->m_CheckLimit  = TWIME::CheckLimitE::DontCheck;
+      StrNCpy<false>(tmsg->m_Account, "BENCH01");
+
+      SeqNum txSN = (*m_txSN)++;
+      utxx::time_val sendTS =
+        !a_batch_send ? FlushOrders() : utxx::time_val();
+
+      a_new_req->m_status  = Req12::StatusT::New;
+      a_new_req->m_ts_sent = sendTS;
+      a_new_req->m_seqNum  = txSN;
+    }
+
+    void CancelOrderImpl(BenchOMC*, Req12*, Req12 const*, bool)
+      { throw utxx::runtime_error("BenchOMC::CancelOrderImpl"); }
+
+    void ModifyOrderImpl(BenchOMC*, Req12*, Req12*, Req12 const*, bool)
+      { throw utxx::runtime_error("BenchOMC::ModifyOrderImpl"); }
+
+    // The "wire" is a memcpy (as a "send" into the socket buffer):
+    utxx::time_val FlushOrdersImpl(BenchOMC*) const
+    {
+      if (utxx::unlikely(m_outBuffLen == 0))
+        return utxx::time_val();
+      memcpy(m_wire, m_outBuff, size_t(m_outBuffLen));
+      m_wireLen    = m_outBuffLen;
+      m_outBuffLen = 0;
+      return utxx::now_utc();
+    }
+  };
+
+  //=========================================================================//
+  // "BenchFIXOMC":                                                          //
+  //=========================================================================//
+  // As "EConnector_FIX<LMAX>", but with the "FIX_ConnectorSessMgr" (TCP) re-
+  // placed by a loopback "SendImpl":
+  //
+  class BenchFIXOMC:
+    public EConnector_OrdMgmt,
+    public FIX::SessData,
+    public FIX::ProtoEngine
+           <FIX::DialectT::LMAX, false, BenchFIXOMC, BenchFIXOMC>,
+    public OMCNative<BenchFIXOMC>
+  {
+  private:
+    using ProtoEngT =
+      FIX::ProtoEngine<FIX::DialectT::LMAX, false, BenchFIXOMC, BenchFIXOMC>;
+    friend class EConnector_OrdMgmt;
+    friend class OMCNative<BenchFIXOMC>;
+    friend class FIX::ProtoEngine
+                 <FIX::DialectT::LMAX, false, BenchFIXOMC, BenchFIXOMC>;
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Features (from the ProtoEngine, as in "EConnector_FIX"):              //
+    //-----------------------------------------------------------------------//
+    using                     QR            = typename ProtoEngT::QR;
+    constexpr static QtyTypeT QT            = ProtoEngT::QT;
+    using                     QtyN          = typename ProtoEngT::QtyN;
+    constexpr static bool     HasFreeCancel = false;
+
+  private:
+    // No FIX Protocol Logging (as "TCP_Connector::m_protoLogger"):
+    spdlog::logger*   m_protoLogger;
+
+    // The "wire":
+    mutable char      m_wire[1024];
+    mutable int       m_wireLen;
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Ctor:                                                                 //
+    //-----------------------------------------------------------------------//
+    BenchFIXOMC
+    (
+      EPollReactor*                      a_reactor,
+      SecDefsMgr*                        a_sec_defs_mgr,
+      boost::property_tree::ptree const& a_params
+    )
+    : EConnector
+      (
+        a_params.get<string>("AccountKey"),
+        FIX::ProtocolFeatures<FIX::DialectT::LMAX>::s_exchange, 0, a_reactor,
+        false, a_sec_defs_mgr, vector<SecDefS>(), nullptr, false, false,
+        nullptr, a_params, QT,
+        FIX::ProtocolFeatures<FIX::DialectT::LMAX>::s_hasFracQtys
+      ),
+      EConnector_OrdMgmt
+      (
+        true, a_params, 1, 0, PipeLineModeT::Wait1, false, false, true,
+        FIX::ProtocolFeatures<FIX::DialectT::LMAX>::s_hasPartFilledModify,
+        true,
+        FIX::ProtocolFeatures<FIX::DialectT::LMAX>::s_hasMktOrders
+      ),
+      FIX::SessData
+        ("CLIENT", "VENUE", m_TxSN, m_RxSN, 30, 1000, "", "", "", "", "",
+         "ACCT-1"),
+      ProtoEngT    (this, this),
+      m_protoLogger(nullptr),
+      m_wireLen    (0)
+    {}
+
+    //-----------------------------------------------------------------------//
+    // "EConnector" and "EConnector_OrdMgmt" Virtual Methods:                //
+    //-----------------------------------------------------------------------//
+    void EnsureAbstract() const override {}
+    void Start()                override {}
+    void Stop ()                override {}
+    bool IsActive() const       override { return true; }
+
+    AOS const* NewOrder
+    (
+      Strategy*           a_strategy,
+      SecDefD const&      a_instr,
+      FIX::OrderTypeT     a_ord_type,
+      bool                a_is_buy,
+      PriceT              a_px,
+      bool                a_is_aggr,
+      QtyAny              a_qty,
+      utxx::time_val      a_ts_md_exch,
+      utxx::time_val      a_ts_md_conn,
+      utxx::time_val      a_ts_md_strat,
+      bool                a_batch_send,
+      FIX::TimeInForceT   a_time_in_force,
+      int                 a_expire_date,
+      QtyAny              a_qty_show,
+      QtyAny              a_qty_min,
+      bool                a_peg_side,
+      double              a_peg_offset
+    )
+    override
+    {
+      return EConnector_OrdMgmt::NewOrderGen<QT, QR>
+      (
+        this,          this,          a_strategy,    a_instr,
+        a_ord_type,    a_is_buy,      a_px,          a_is_aggr,
+        a_qty,         a_ts_md_exch,  a_ts_md_conn,  a_ts_md_strat,
+        a_batch_send,  a_time_in_force,              a_expire_date,
+        a_qty_show,    a_qty_min,     a_peg_side,    a_peg_offset
+      );
+    }
+
+    bool CancelOrder
+      (AOS const*, utxx::time_val, utxx::time_val, utxx::time_val, bool)
+    override
+      { return false; }
+
+    bool ModifyOrder
+    (
+      AOS const*, PriceT, bool, QtyAny, utxx::time_val, utxx::time_val,
+      utxx::time_val, bool, QtyAny, QtyAny
+    )
+    override
+      { return false; }
+
+    void CancelAllOrders
+      (unsigned long, SecDefD const*, FIX::SideT, char const*) override {}
+
+    utxx::time_val FlushOrders() override
+      { return FlushOrdersGen(this, this); }
+
+    //-----------------------------------------------------------------------//
+    // The last msg on the "wire":                                           //
+    //-----------------------------------------------------------------------//
+    using MsgT = string;
+
+    MsgT LastSent() const { return MsgT(m_wire, size_t(m_wireLen)); }
+
+    // Whether 2 msgs are identical apart from the flds which differ between
+    // any 2 msgs (BodyLength, MsgSeqNum, SendingTime, TransactTime, CheckSum)
+    // and the ClOrdIDs, which must differ as well:
+    static bool SameMsgs(MsgT const& a_msg1, OrderID, MsgT const& a_msg2,
+                         OrderID)
+    {
+      string clOrdID1;
+      string clOrdID2;
+      return
+        Masked(a_msg1, &clOrdID1) == Masked(a_msg2, &clOrdID2) &&
+        !clOrdID1.empty() && clOrdID1 != clOrdID2;
+    }
+
+  private:
+    static string Masked(MsgT const& a_msg, string* a_cl_ord_id)
+    {
+      assert(a_cl_ord_id != nullptr);
+      string res;
+      for (size_t from = 0; from < a_msg.size(); )
+      {
+        size_t to  = a_msg.find('\x01', from);
+        to         = (to == string::npos) ? a_msg.size() : to + 1;
+        string fld = a_msg.substr(from, to - from);
+        from       = to;
+
+        if (fld.compare(0, 3, "11=") == 0)
+          *a_cl_ord_id = fld;
+        else
+        if (fld.compare(0, 2, "9=")  != 0 && fld.compare(0, 3, "10=") != 0 &&
+            fld.compare(0, 3, "34=") != 0 && fld.compare(0, 3, "52=") != 0 &&
+            fld.compare(0, 3, "60=") != 0)
+          res += fld;
+      }
+      return res;
+    }
+
+    //-----------------------------------------------------------------------//
+    // SessMgr Call-Backs (as in "FIX_ConnectorSessMgr"):                    //
+    //-----------------------------------------------------------------------//
+    FIX::SessData* GetFIXSession(int)                    { return this;  }
+    bool IsActiveSess  (FIX::SessData const*) const      { return true;  }
+    bool IsInactiveSess(FIX::SessData const*) const      { return false; }
+    bool IsOrdMgmt() const                               { return true;  }
+    bool IsMktData() const                               { return false; }
+
+    // The "wire" is a memcpy (as a "send" into the socket buffer):
+    utxx::time_val SendImpl(FIX::SessData*, char const* a_buff, int a_len)
+    {
+      assert(0 < a_len && a_len <= int(sizeof(m_wire)));
+      memcpy(m_wire, a_buff, size_t(a_len));
+      m_wireLen = a_len;
+      return utxx::now_utc();
+    }
+  };
+
+  //=========================================================================//
+  // "PrintLatencies":                                                       //
+  //=========================================================================//
+  void PrintLatencies(char const* a_name, vector<long>* a_lats)
+  {
+    assert(a_lats != nullptr && !a_lats->empty());
+    sort(a_lats->begin(), a_lats->end());
+    auto pct = [a_lats](double a_p) -> long
+    {
+      size_t i = size_t(a_p * double(a_lats->size() - 1));
+      return (*a_lats)[i];
+    };
+    cout << left  << setw(34) << a_name << right
+         << setw(8) << pct(0.5)   << setw(8) << pct(0.9)
+         << setw(8) << pct(0.99)  << setw(8) << pct(0.999)
+         << setw(9) << a_lats->back() << endl;
+  }
+
+  //=========================================================================//
+  // "MkParams", "RemoveShM":                                                //
+  //=========================================================================//
+  constexpr char const* Name    = "OMCNativeBench-TWIME-FORTS-Test";
+  constexpr char const* FIXName = "OMCNativeBench-FIX-LMAX-Test";
+
+  boost::property_tree::ptree MkParams
+    (char const* a_name, unsigned long a_max_reqs)
+  {
+    boost::property_tree::ptree params;
+    params.put("AccountKey",    a_name);
+    params.put("DebugLevel",    0);
+    params.put("LogFile",       "stderr");
+    params.put("MaxAOSes",      a_max_reqs);
+    params.put("MaxReq12s",     a_max_reqs);
+    params.put("MaxTrades",     16);
+    params.put("TradesLogFile", "");
+    return params;
+  }
+
+  // (NB: "PersistMgr" prepends the UserName to the Segment names):
+  void RemoveShM
+  (
+    boost::property_tree::ptree const& a_params,
+    boost::property_tree::ptree const& a_fix_params
+  )
+  {
+    (void) PersistMgr<>::Remove(Name,    &a_params);
+    (void) PersistMgr<>::Remove(FIXName, &a_fix_params);
+    (void) BIPC::shared_memory_object::remove
+      ((string(cuserid(nullptr)) + "-" + Name + "-SecDefsMgr-Test").data());
+  }
+
+  //=========================================================================//
+  // "Orders": The Args of the orders to be sent:                            //
+  //=========================================================================//
+  template<typename OMC>
+  using OrderDescN = OrderDesc<OMC::QT, typename OMC::QR>;
+
+  template<typename OMC>
+  vector<OrderDescN<OMC>> MkOrders
+    (vector<SecDefD const*> const& a_instrs, double a_px0, int a_n)
+  {
+    vector<OrderDescN<OMC>> res(static_cast<size_t>(a_n));
+    for (int i = 0; i < a_n; ++i)
+    {
+      OrderDescN<OMC>& od = res[size_t(i)];
+      SecDefD const*   instr = a_instrs[size_t(i) % a_instrs.size()];
+      od.m_instr       = instr;
+      od.m_isBuy       = (i % 2 == 0);
+      od.m_px          =
+        PriceT(a_px0 + double(i % 97) * 10.0 * instr->m_PxStep);
+      od.m_qty         = typename OMC::QtyN(typename OMC::QR(1 + i % 50));
+      od.m_timeInForce = FIX::TimeInForceT::Day;
+    }
+    return res;
+  }
+
+  // Via the Virtual API (the OMC ptr is made opaque to the compiler, so that
+  // the call is not de-virtualised):
+  template<typename OMC>
+  inline AOS const* SendVirtual
+    (EConnector_OrdMgmt* a_omc, Strategy* a_strat, OrderDescN<OMC> const& a_od)
+  {
+    asm volatile("" : "+r"(a_omc));
+    return a_omc->NewOrder
+    (
+      a_strat,        *a_od.m_instr,      a_od.m_ordType,   a_od.m_isBuy,
+      a_od.m_px,      a_od.m_isAggr,      QtyAny(a_od.m_qty),
+      a_od.m_tsMDExch, a_od.m_tsMDConn,   a_od.m_tsMDStrat, a_od.m_batchSend,
+      a_od.m_timeInForce, a_od.m_expireDate
+    );
+  }
+
+  // Via the Native API:
+  template<typename OMC>
+  inline AOS const* SendNative
+    (OMC* a_omc, Strategy* a_strat, OrderDescN<OMC> const& a_od)
+    { return a_omc->NewOrderN(a_strat, a_od); }
+
+  //=========================================================================//
+  // "Run": Cross-Check and Latencies of a given OMC:                        //
+  //=========================================================================//
+  // Each order is sent via both APIs, and the Cross-Check sends 1000 more:
+  constexpr int NCheck = 1000;
+
+  template<typename OMC>
+  bool Run
+  (
+    char const*                   a_name,
+    OMC*                          a_omc,
+    Strategy*                     a_strat,
+    vector<SecDefD const*> const& a_instrs,
+    double                        a_px0,
+    int                           a_n
+  )
+  {
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    vector<OrderDescN<OMC>> ords = MkOrders<OMC>(a_instrs, a_px0, NCheck);
+    for (OrderDescN<OMC> const& od: ords)
+    {
+      AOS const* aosV = SendVirtual<OMC>(a_omc, a_strat, od);
+      typename OMC::MsgT msgV = a_omc->LastSent();
+      AOS const* aosN = SendNative (a_omc, a_strat, od);
+      typename OMC::MsgT msgN = a_omc->LastSent();
+
+      if (aosV == nullptr || aosN == nullptr ||
+          !OMC::SameMsgs(msgV, aosV->m_lastReq->m_id,
+                         msgN, aosN->m_lastReq->m_id))
+      {
+        cerr << a_name << ": NewOrderSingle MISMATCH:\n" << msgV << '\n'
+             << msgN << endl;
+        return false;
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // Latencies:                                                            //
+    //-----------------------------------------------------------------------//
+    ords = MkOrders<OMC>(a_instrs, a_px0, a_n);
+    vector<long> latsV(static_cast<size_t>(a_n));
+    vector<long> latsN(static_cast<size_t>(a_n));
+
+    for (size_t k = 0; k < size_t(a_n); ++k)
+    {
+      // Alternate the order of the APIs, and space the orders out a bit:
+      for (int h = 0; h < 2; ++h)
+      {
+        bool  native = ((k + size_t(h)) % 2 == 1);
+        long  t0     = NowNSec();
+        (void) (native ? SendNative      (a_omc, a_strat, ords[k])
+                       : SendVirtual<OMC>(a_omc, a_strat, ords[k]));
+        long  t1     = NowNSec();
+        (native ? latsN : latsV)[k] = t1 - t0;
+        while (NowNSec() - t1 < 2'000) ;
+      }
+    }
+    PrintLatencies((string(a_name) + "/Virtual/NewOrder").data(), &latsV);
+    PrintLatencies((string(a_name) + "/Native/NewOrderN").data(), &latsN);
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  int n = (argc >= 2) ? atoi(argv[1]) : 50'000;
+  if (n <= 0)
+  {
+    cerr << "PARAMETERS: [NOrders]" << endl;
+    return 1;
+  }
+  unsigned long maxReqs = 2 * static_cast<unsigned long>(n + NCheck) + 16;
+  boost::property_tree::ptree params    = MkParams(Name,    maxReqs);
+  boost::property_tree::ptree fixParams = MkParams(FIXName, maxReqs);
+
+  RemoveShM(params, fixParams);
+  bool ok = true;
+  try
+  {
+    auto           sink = std::make_shared<spdlog::sinks::null_sink_mt>();
+    spdlog::logger logger("OMCNativeBench", sink);
+    Strategy       strat ("OMCNativeBench", nullptr, &logger, 0);
+    EPollReactor   reactor(&logger, 0);
+    SecDefsMgr*    sdm  = SecDefsMgr::GetPersistInstance(false, Name);
+    BenchOMC       omc   (&reactor, sdm, params);
+    BenchFIXOMC    fixOMC(&reactor, sdm, fixParams);
+
+    // Instruments (FORTS-like Futures for TWIME, LMAX-like FX for FIX):
+    vector<SecDefD const*> instrs;
+    vector<SecDefD const*> fixInstrs;
+    for (int i = 0; i < 8; ++i)
+    {
+      string  symbol = "Si-" + to_string(3 * (i + 1)) + ".26";
+      SecDefS sds
+        (SecID(400001 + i), symbol.data(), "", "", "", "FORTS", "", "", "",
+         "USD", "RUB", 'A', 1000.0, 1.0, 1, 1.0, 'C', 0.001, 0, 0, 0.0, 0,
+         "");
+      instrs.push_back(&(sdm->Add(sds, false, 0, 0, 0.0, 0.0)));
+
+      string  ccy    = "C" + to_string(i);
+      string  fxSym  = ccy + "/USD";
+      SecDefS fxSds
+        (SecID(4001 + i), fxSym.data(), "", "", "", "LMAX", "", "", "",
+         ccy.data(), "USD", 'A', 1.0, 1.0, 1, 1e-5, 'A', 1.0, 0, 0, 0.0, 0,
+         "");
+      fixInstrs.push_back(&(sdm->Add(fxSds, false, 0, 0, 0.0, 0.0)));
+    }
+
+    cout << left  << setw(34) << "NewOrder Latency, nsec" << right
+         << setw(8)  << "50%" << setw(8) << "90%" << setw(8) << "99%"
+         << setw(8)  << "99.9%" << setw(9) << "Max" << '\n'
+         << string(75, '-') << endl;
+
+    if (!Run("TWIME", &omc,    &strat, instrs,    80000.0, n) ||
+        !Run("FIX",   &fixOMC, &strat, fixInstrs, 1.1,     n))
+      throw utxx::runtime_error("Cross-Check Failed");
+  }
+  catch (exception const& exn)
+  {
+    cerr << "EXCEPTION: " << exn.what() << endl;
+    ok = false;
+  }
+  RemoveShM(params, fixParams);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,462 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Tests/OrderBookBench.cpp":                       //
+//     Update Latency and Memory of Dense, Sparse and Hybrid OrderBooks      //
+//===========================================================================//
+// The L1 stream is either read from an MDStore ("ob_L1" recs) or generated
+// (a random walk). It is converted into a stream of L2 Updates (using shadow
+// Bid and Ask ladders), which is then replayed through OrderBooks of all 3
+// Reps. The results are cross-verified (in a separate, untimed pass):
+//
+#include "Connectors/OrderBook.hpp"
+#include "QuantSupport/MDStore.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace QuantSupport;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types:                                                                  //
+  //=========================================================================//
+  constexpr QtyTypeT QT = QtyTypeT::QtyA;
+  using    QR         = double;
+  using    QtyT       = Qty<QT,QR>;
+
+  //-------------------------------------------------------------------------//
+  // "L2Op": A single OrderBook Update:                                      //
+  //-------------------------------------------------------------------------//
+  struct L2Op
+  {
+    bool                 m_isBid;
+    FIX::MDUpdateActionT m_action;
+    PriceT               m_px;
+    double               m_qty;   // 0 for Delete
+  };
+
+  //-------------------------------------------------------------------------//
+  // "L1Rec": Source data (as in MDStore):                                   //
+  //-------------------------------------------------------------------------//
+  struct L1Rec
+  {
+    double m_bid, m_ask, m_bidSz, m_askSz;
+  };
+
+  //=========================================================================//
+  // "MkL2Ops":                                                              //
+  //=========================================================================//
+  // Converts an L1 stream into L2 Updates. Apart from the L1 itself, each L1
+  // rec produces a few random updates in the depth of each side; and a few
+  // far-away levels (at 0.5x and 2x of the initial Pxs) are installed in the
+  // beginning, as is typical for Crypto OrderBooks:
+  //
+  class OpsMaker
+  {
+  private:
+    double             m_pxStep;
+    map<long, double>  m_bids;    // Tick => Qty (shadow ladders)
+    map<long, double>  m_asks;
+    mt19937_64         m_rng;
+    vector<L2Op>*      m_ops;
+    long               m_minTick;
+    long               m_maxTick;
+
+    void Emit(bool a_is_bid, long a_tick, double a_qty)
+    {
+      // NB: Qtys are rounded to integers, as "GetVWAP" is invoked with "long"
+      // Qtys below:
+      map<long, double>& side = a_is_bid ? m_bids : m_asks;
+      auto it = side.find(a_tick);
+      if (a_qty > 0.0)
+        a_qty = max(1.0, Round(a_qty));
+      FIX::MDUpdateActionT act;
+      if (a_qty <= 0.0)
+      {
+        if (it == side.end())
+          return;
+        side.erase(it);
+        act   = FIX::MDUpdateActionT::Delete;
+        a_qty = 0.0;
+      }
+      else
+      {
+        act = (it == side.end())
+              ? FIX::MDUpdateActionT::New
+              : FIX::MDUpdateActionT::Change;
+        side[a_tick] = a_qty;
+      }
+      m_ops->push_back
+        (L2Op{a_is_bid, act, PriceT(double(a_tick) * m_pxStep), a_qty});
+      m_minTick = min(m_minTick, a_tick);
+      m_maxTick = max(m_maxTick, a_tick);
+    }
+
+    // Random updates in the depth (up to 64 levels from L1):
+    void Depth(bool a_is_bid, long a_best)
+    {
+      uniform_int_distribution<long> offD(1, 64);
+      uniform_real_distribution<>    u01;
+      for (int i = 0; i < 2; ++i)
+      {
+        long t = a_is_bid ? (a_best - offD(m_rng)) : (a_best + offD(m_rng));
+        Emit(a_is_bid, t, (u01(m_rng) < 0.3) ? 0.0 : 1.0 + 10.0 * u01(m_rng));
+      }
+    }
+
+  public:
+    OpsMaker(double a_px_step, vector<L2Op>* a_ops)
+    : m_pxStep (a_px_step),
+      m_bids   (),
+      m_asks   (),
+      m_rng    (12345),
+      m_ops    (a_ops),
+      m_minTick(LONG_MAX),
+      m_maxTick(LONG_MIN)
+    {}
+
+    long GetMinTick() const { return m_minTick; }
+    long GetMaxTick() const { return m_maxTick; }
+
+    void Add(L1Rec const& a_rec)
+    {
+      long tb = long(Round(a_rec.m_bid / m_pxStep));
+      long ta = long(Round(a_rec.m_ask / m_pxStep));
+      if (tb >= ta || a_rec.m_bidSz <= 0.0 || a_rec.m_askSz <= 0.0)
+        return;
+
+      // The first rec: Install the far-away levels:
+      if (m_bids.empty() && m_asks.empty())
+      {
+        Emit(true,  tb / 2, 100.0);
+        Emit(true,  tb / 4, 100.0);
+        Emit(false, ta * 2, 100.0);
+        Emit(false, ta * 4, 100.0);
+      }
+      // Remove the levels which are better than the new L1s (or collide with
+      // the other side), BEFORE installing the new L1s:
+      while (!m_bids.empty() && m_bids.rbegin()->first >= ta)
+        Emit(true,  m_bids.rbegin()->first, 0.0);
+      while (!m_asks.empty() && m_asks.begin()->first  <= tb)
+        Emit(false, m_asks.begin()->first,  0.0);
+      while (!m_bids.empty() && m_bids.rbegin()->first >  tb)
+        Emit(true,  m_bids.rbegin()->first, 0.0);
+      while (!m_asks.empty() && m_asks.begin()->first  <  ta)
+        Emit(false, m_asks.begin()->first,  0.0);
+
+      Emit(true,  tb, a_rec.m_bidSz);
+      Emit(false, ta, a_rec.m_askSz);
+      Depth(true,  tb);
+      Depth(false, ta);
+    }
+  };
+
+  //=========================================================================//
+  // "Apply":                                                                //
+  //=========================================================================//
+  template<bool IsSparse>
+  inline void Apply(OrderBook* a_ob, L2Op const& a_op)
+  {
+    QtyT qty(a_op.m_qty);
+    if (a_op.m_isBid)
+      (void) a_ob->Update
+        <true,  false, false, false, true,  false, IsSparse, QT, QR>
+        (a_op.m_action, a_op.m_px, qty, 0, 0, nullptr);
+    else
+      (void) a_ob->Update
+        <false, false, false, false, true,  false, IsSparse, QT, QR>
+        (a_op.m_action, a_op.m_px, qty, 0, 0, nullptr);
+  }
+
+  //=========================================================================//
+  // "RunOnce": Returns ns per Update:                                       //
+  //=========================================================================//
+  template<bool IsSparse>
+  double RunOnce(OrderBook* a_ob, vector<L2Op> const& a_ops)
+  {
+    a_ob->Invalidate();
+    utxx::time_val from = utxx::now_utc();
+    for (L2Op const& op: a_ops)
+      Apply<IsSparse>(a_ob, op);
+    utxx::time_val to   = utxx::now_utc();
+    return double((to - from).nanoseconds()) / double(a_ops.size());
+  }
+
+  //=========================================================================//
+  // "Levels": Full contents of one side (via "Traverse"):                   //
+  //=========================================================================//
+  template<bool IsBid>
+  vector<pair<PriceT, double>> Levels(OrderBook const& a_ob)
+  {
+    vector<pair<PriceT, double>> res;
+    a_ob.Traverse<IsBid>
+    (
+      0,
+      [&res](int, PriceT a_px, OrderBook::OBEntry const& a_obe) -> bool
+      {
+        res.emplace_back(a_px, double(a_obe.GetAggrQty<QT,QR>()));
+        return true;
+      }
+    );
+    return res;
+  }
+
+  //=========================================================================//
+  // "Close": Pxs are equal up to rounding errors (or both are NaN):         //
+  //=========================================================================//
+  // NB: Dense Pxs are computed from the L1 Px and an offset, so they may dif-
+  // fer from the original ones in the last digits:
+  //
+  inline bool Close(PriceT a_px1, PriceT a_px2)
+  {
+    double p1 = double(a_px1);
+    double p2 = double(a_px2);
+    return
+      (!IsFinite(p1) && !IsFinite(p2)) ||
+      Abs(p1 - p2) <= 1e-9 * Max(1.0, Abs(p1));
+  }
+
+  //=========================================================================//
+  // "SameLevels": Compares one side of 2 OrderBooks in full:                //
+  //=========================================================================//
+  template<bool IsBid>
+  bool SameLevels(OrderBook const& a_ob1, OrderBook const& a_ob2)
+  {
+    auto l1 = Levels<IsBid>(a_ob1);
+    auto l2 = Levels<IsBid>(a_ob2);
+    if (l1.size() != l2.size())
+      return false;
+    for (size_t i = 0; i < l1.size(); ++i)
+      if (!Close(l1[i].first, l2[i].first) || l1[i].second != l2[i].second)
+        return false;
+    return true;
+  }
+
+  //=========================================================================//
+  // "SameVWAPs": Compares multi-band VWAPs (via "GetVWAP"):                 //
+  //=========================================================================//
+  template<bool IsBid>
+  bool SameVWAPs(OrderBook const& a_ob1, OrderBook const& a_ob2)
+  {
+    OrderBook::ParamsVWAP<QT> p1;
+    p1.m_bandSizes[0] = Qty<QT,long>(10L);
+    p1.m_bandSizes[1] = Qty<QT,long>(30L);
+    p1.m_bandSizes[2] = Qty<QT,long>(100L);
+    OrderBook::ParamsVWAP<QT> p2 = p1;
+
+    a_ob1.GetVWAP<QT,QR,QT,long,IsBid>(&p1);
+    a_ob2.GetVWAP<QT,QR,QT,long,IsBid>(&p2);
+
+    for (int i = 0; i < 3; ++i)
+      if (!Close(p1.m_vwaps[i],   p2.m_vwaps[i]) ||
+          !Close(p1.m_wrstPxs[i], p2.m_wrstPxs[i]))
+        return false;
+    return true;
+  }
+
+  //=========================================================================//
+  // "Verify": Cross-checks the 3 Reps after each Update:                    //
+  //=========================================================================//
+  bool Verify
+  (
+    OrderBook*          a_dense,    // May be NULL
+    OrderBook*          a_sparse,
+    OrderBook*          a_hybrid,
+    vector<L2Op> const& a_ops
+  )
+  {
+    OrderBook* obs[3] = { a_dense, a_sparse, a_hybrid };
+    for (OrderBook* ob: obs)
+      if (ob != nullptr)
+        ob->Invalidate();
+
+    for (size_t i = 0; i < a_ops.size(); ++i)
+    {
+      if (a_dense != nullptr)
+        Apply<false>(a_dense, a_ops[i]);
+      Apply<true>(a_sparse, a_ops[i]);
+      Apply<true>(a_hybrid, a_ops[i]);
+
+      for (OrderBook* ob: obs)
+      {
+        if (ob == nullptr || ob == a_sparse)
+          continue;
+        if (!Close(ob->GetBestBidPx(), a_sparse->GetBestBidPx())      ||
+            !Close(ob->GetBestAskPx(), a_sparse->GetBestAskPx())      ||
+            ob->GetBestBidQty<QT,QR>() != a_sparse->GetBestBidQty<QT,QR>() ||
+            ob->GetBestAskQty<QT,QR>() != a_sparse->GetBestAskQty<QT,QR>() ||
+            !SameVWAPs<true> (*ob, *a_sparse)                         ||
+            !SameVWAPs<false>(*ob, *a_sparse))
+        {
+          cerr << "MISMATCH at Update #" << i << ": "
+               << ((ob == a_dense) ? "Dense" : "Hybrid") << endl;
+          return false;
+        }
+      }
+    }
+    // Finally, compare the whole Books:
+    for (OrderBook* ob: obs)
+      if (ob != nullptr && ob != a_sparse &&
+         (!SameLevels<true> (*ob, *a_sparse) ||
+          !SameLevels<false>(*ob, *a_sparse)))
+      {
+        cerr << "MISMATCH in Full Books: "
+             << ((ob == a_dense) ? "Dense" : "Hybrid") << endl;
+        return false;
+      }
+    return true;
+  }
+
+  //=========================================================================//
+  // "GetDate": YYYYMMDD -> "time_val":                                      //
+  //=========================================================================//
+  utxx::time_val GetDate(char const* a_str)
+  {
+    int date = atoi(a_str);
+    int year = date / 10000;
+    int mon  = (date - 10000 * year) / 100;
+    int day  =  date - 10000 * year  - 100 * mon;
+    return utxx::time_val(year, unsigned(mon), unsigned(day));
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [MDStoreRoot Venue Symbol StartDate PxStep [MaxRecs]] or
+  //         [NRecs [HybridWindow]]:
+  bool fromMDS = (argc >= 6);
+  long maxRecs =
+    fromMDS ? ((argc >= 7) ? atol(argv[6]) : 10000000)
+            : ((argc >= 2) ? atol(argv[1]) : 1000000);
+  int  window  = (!fromMDS && argc >= 3) ? atoi(argv[2]) : 512;
+  double pxStep = fromMDS ? atof(argv[5]) : 0.01;
+
+  if (maxRecs <= 0 || window <= 0 || !(pxStep > 0.0))
+  {
+    cerr << "PARAMETERS: [MDStoreRoot Venue Symbol StartDate(YYYYMMDD) PxStep "
+            "[MaxRecs]] | [NRecs [HybridWindow]]" << endl;
+    return 1;
+  }
+  try
+  {
+    //-----------------------------------------------------------------------//
+    // Get the L1 stream and make the L2 Updates:                            //
+    //-----------------------------------------------------------------------//
+    vector<L2Op> ops;
+    OpsMaker     maker(pxStep, &ops);
+    long         nRecs = 0;
+
+    if (fromMDS)
+    {
+      using Reader = MDStoreReader<MDRecL1>;
+      Reader mds(argv[1], argv[2], argv[3], "ob_L1");
+      mds.Read
+      (
+        GetDate(argv[4]),
+        [&](Reader::MDStoreRecord const& a_rec) -> bool
+        {
+          maker.Add(L1Rec{a_rec.rec.bid,      a_rec.rec.ask,
+                          a_rec.rec.bid_size, a_rec.rec.ask_size});
+          return (++nRecs < maxRecs);
+        }
+      );
+    }
+    else
+    {
+      // Random walk of the Mid (in Ticks), with a random Spread:
+      mt19937_64                     rng(67890);
+      uniform_int_distribution<long> stepD  (-2, 2);
+      uniform_int_distribution<long> spreadD( 1, 4);
+      uniform_real_distribution<>    szD    (0.1, 20.0);
+      long mid = 100000;   // 1000.00
+      for (; nRecs < maxRecs; ++nRecs)
+      {
+        mid += stepD(rng);
+        long spr = spreadD(rng);
+        maker.Add(L1Rec{double(mid)       * pxStep,
+                        double(mid + spr) * pxStep, szD(rng), szD(rng)});
+      }
+    }
+    if (ops.empty())
+    {
+      cerr << "No Data" << endl;
+      return 1;
+    }
+    //-----------------------------------------------------------------------//
+    // Create the OrderBooks:                                                //
+    //-----------------------------------------------------------------------//
+    SecDefD instr;
+    instr.m_SecID    = 1;
+    instr.m_PxStep   = pxStep;
+    instr.m_FullName = MkObjName(fromMDS ? argv[3] : "SYNTH");
+
+    // The Dense Book must accommodate the whole Px range (in both directions,
+    // since its initial L1 is placed in the middle):
+    long range   = maker.GetMaxTick() - maker.GetMinTick() + 1;
+    long denseNL = 2 * range + 1;
+    bool doDense = (denseNL <= (1L << 24));
+
+    unique_ptr<OrderBook> dense
+      (doDense
+       ? new OrderBook(nullptr, &instr, false, false, QT, true, false, false,
+                       false, int(denseNL), 0, 0, false)
+       : nullptr);
+    OrderBook sparse(nullptr, &instr, false, true, QT, true, false, false,
+                     false, 0,      0, 0, false);
+    OrderBook hybrid(nullptr, &instr, false, true, QT, true, false, false,
+                     false, window, 0, 0, false);
+
+    //-----------------------------------------------------------------------//
+    // Verification (untimed):                                               //
+    //-----------------------------------------------------------------------//
+    if (!Verify(dense.get(), &sparse, &hybrid, ops))
+      return 1;
+
+    size_t nLevels = Levels<true>(sparse).size() + Levels<false>(sparse).size();
+
+    //-----------------------------------------------------------------------//
+    // Timed Runs:                                                           //
+    //-----------------------------------------------------------------------//
+    double nsDense  = doDense ? RunOnce<false>(dense.get(), ops) : NaN<double>;
+    double nsSparse = RunOnce<true> (&sparse, ops);
+    double nsHybrid = RunOnce<true> (&hybrid, ops);
+
+    // Memory estimates: Dense: both arrays (incl the SoA Qtys); Sparse: Map
+    // nodes (approx); Hybrid: both windows + (at most) all levels in the Maps:
+    size_t obeSz   = sizeof(OrderBook::OBEntry);
+    size_t nodeSz  = sizeof(pair<PriceT const, OrderBook::OBEntry>) +
+                     3 * sizeof(void*);
+    size_t winSz   = 16;
+    while (winSz < size_t(window))
+      winSz <<= 1;
+
+    cout << "L1 Recs=" << nRecs  << ", L2 Updates=" << ops.size()
+         << ", Px Range=" << range << " ticks, Final Levels=" << nLevels
+         << ", Verified OK\n"
+         << "Dense : " << nsDense  << " ns/update, Mem="
+         << (doDense ? (2 * size_t(denseNL) * (obeSz + sizeof(double))) : 0)
+         << " bytes\n"
+         << "Sparse: " << nsSparse << " ns/update, Mem~"
+         << (nLevels * nodeSz) << " bytes\n"
+         << "Hybrid: " << nsHybrid << " ns/update, Mem~"
+         << (2 * winSz * obeSz + nLevels * nodeSz)    << " bytes (Window="
+         << winSz << ")" << endl;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
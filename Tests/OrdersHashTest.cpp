@@ -0,0 +1,104 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/OrdersHashTest.cpp":                      //
+//       OrdersLog Look-Ups: Unknown OrderIDs Must Not Consume the Pool      //
+//===========================================================================//
+// Modify / Delete updates for OrderIDs which are not in the Book (filtered
+// out, or placed before the subscription) are merely looked up: for both the
+// "OrdersHash" and the Array mode, "FindOrderInfo" must return NULL and must
+// not create any slots, so the whole pool remains available for New Orders:
+//
+#include "Connectors/OrderBook.hpp"
+#include <iostream>
+#include <memory>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  constexpr QtyTypeT QT       = QtyTypeT::QtyA;
+  using    QR                 = double;
+  constexpr long     MaxLive  = 1000;
+  constexpr long     NUnknown = 1'000'000;
+
+  int NErrs = 0;
+
+  void Check(bool a_cond, char const* a_what)
+  {
+    if (!a_cond)
+    {
+      cerr << "FAILED: " << a_what << endl;
+      ++NErrs;
+    }
+  }
+
+  //=========================================================================//
+  // "RunTest":                                                              //
+  //=========================================================================//
+  void RunTest(SecDefD const& a_instr, bool a_hashed)
+  {
+    unique_ptr<OrderBook> ob
+      (new OrderBook(nullptr, &a_instr, false, false, QT, true, false, false,
+                     false, 1024, 0, MaxLive, a_hashed));
+
+    // Look-ups of many unknown OrderIDs: all NULL, no slots taken:
+    bool allNull = true;
+    for (OrderID id = 1; id <= OrderID(NUnknown); ++id)
+      allNull &= (ob->FindOrderInfo(id * 7919) == nullptr);
+    Check(allNull, "FindOrderInfo(Unknown) != NULL");
+
+    if (a_hashed)
+      Check(ob->GetOrdersHash()->GetNUsed() == 0,
+            "FindOrderInfo consumed OrdersHash slots");
+
+    // So the whole capacity is still available for New Orders:
+    long nSlots = a_hashed ? ob->GetOrdersHash()->GetPoolSize() : MaxLive;
+    bool allOK  = true;
+    for (OrderID id = 1; id <= OrderID(nSlots); ++id)
+    {
+      auto* order =
+        const_cast<OrderBook::OrderInfo*>(ob->GetOrderInfo(id));
+      if (order == nullptr)
+      {
+        allOK = false;
+        break;
+      }
+      order->m_isBid = true;
+      order->m_px    = PriceT(100.0);
+      order->m_qty   = QtyU(Qty<QT,QR>(1.0));
+    }
+    Check(allOK, "GetOrderInfo(New) failed within the capacity");
+
+    // And the inserted Orders are found:
+    OrderBook::OrderInfo const* found = ob->FindOrderInfo(OrderID(nSlots));
+    Check(found != nullptr && found->m_id == OrderID(nSlots),
+          "FindOrderInfo(Known) failed");
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main()
+{
+  try
+  {
+    SecDefD instr;
+    instr.m_SecID    = 1;
+    instr.m_PxStep   = 0.01;
+    instr.m_FullName = MkObjName("SYNTH");
+
+    RunTest(instr, true);
+    RunTest(instr, false);
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  if (NErrs != 0)
+    return 1;
+  cout << "OK" << endl;
+  return 0;
+}
@@ -0,0 +1,372 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Tests/OrdersLogBench.cpp":                       //
+//   OrdersLog Storage: Array Indexed by OrderID vs "OrdersHash" (MBO Books) //
+//===========================================================================//
+// A synthetic trading day of "NOrders" Orders (default: 50M) is generated:
+// Orders are placed at random depths around a fixed Mid, part-filled and
+// deleted, so that the number of live Orders stays around "MaxLive". The day
+// is replayed (in the same way as "EConnector_MktData::ApplyOrderUpdate" does
+// it) through MBO OrderBooks with:
+// (*) "Array":       the array of Orders indexed by (contiguous) OrderIDs;
+//                    it must hold ALL Orders of the day;
+// (*) "Hash":        the "OrdersHash", same OrderIDs;
+// (*) "Hash/Sparse": the "OrdersHash", random 64-bit OrderIDs.
+// The resulting Books are cross-checked:
+//
+#include "Connectors/OrderBook.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <random>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types and Consts:                                                       //
+  //=========================================================================//
+  constexpr QtyTypeT QT      = QtyTypeT::QtyA;
+  using    QR                = double;
+  using    QtyT              = Qty<QT,QR>;
+  constexpr int      NL      = 1 << 14;  // Dense Book size
+  constexpr int      MaxOff  = 1000;     // Max Order depth (in ticks)
+  constexpr double   Mid     = 1000.0;
+  constexpr double   PxStep  = 0.01;
+  constexpr long     ChunkSz = 1 << 20;  // Ops generated at a time
+
+  //-------------------------------------------------------------------------//
+  // "OLOp": A single OrdersLog Update:                                      //
+  //-------------------------------------------------------------------------//
+  struct OLOp
+  {
+    OrderID              m_id;
+    FIX::MDUpdateActionT m_action;
+    bool                 m_isBid;   // For New only
+    int                  m_off;     // ditto: Depth in ticks (> 0)
+    double               m_qty;     // New or PartFill Qty; 0 for Delete
+  };
+
+  //=========================================================================//
+  // "DayMaker": Generates the OrdersLog in chunks:                          //
+  //=========================================================================//
+  class DayMaker
+  {
+  private:
+    long                      m_nOrders;   // Total in the day
+    long                      m_maxLive;
+    bool                      m_sparseIDs;
+    mt19937_64                m_rng;
+    long                      m_nNew;      // Orders created so far
+    vector<pair<long,double>> m_live;      // (SeqNo, Qty)
+
+    // OrderID from the Order SeqNo (1-based): A bijective mix for sparse IDs:
+    OrderID MkID(long a_seq) const
+    {
+      if (!m_sparseIDs)
+        return OrderID(a_seq);
+      OrderID z = OrderID(a_seq) * 0xBF58476D1CE4E5B9UL;
+      z = (z ^ (z >> 31)) * 0x94D049BB133111EBUL;
+      z =  z ^ (z >> 29);
+      return (z == 0 || z == ~OrderID(0)) ? OrderID(a_seq) : z;
+    }
+
+  public:
+    DayMaker(long a_n_orders, long a_max_live, bool a_sparse_ids)
+    : m_nOrders  (a_n_orders),
+      m_maxLive  (a_max_live),
+      m_sparseIDs(a_sparse_ids),
+      m_rng      (20240517),
+      m_nNew     (0),
+      m_live     ()
+    { m_live.reserve(size_t(a_max_live)); }
+
+    bool IsDone() const { return m_nNew == m_nOrders && m_live.empty(); }
+
+    // Fills in "a_ops" with the next chunk (up to "ChunkSz" ops):
+    void Next(vector<OLOp>* a_ops)
+    {
+      uniform_real_distribution<> u01;
+      geometric_distribution<int> offD(0.02);
+      a_ops->clear();
+
+      while (long(a_ops->size()) < ChunkSz && !IsDone())
+      {
+        double r      = u01(m_rng);
+        bool   canNew = (m_nNew < m_nOrders);
+        long   nLive  = long(m_live.size());
+        bool   doNew  =
+          canNew && nLive < m_maxLive &&
+          (nLive == 0 || nLive < m_maxLive / 2 || r < 0.4);
+
+        if (doNew)
+        {
+          long   seq = ++m_nNew;
+          bool   bid = (u01(m_rng) < 0.5);
+          int    off = 1 + min(offD(m_rng), MaxOff - 1);
+          double q   = 1.0 + Round(99.0 * u01(m_rng));
+          m_live.emplace_back(seq, q);
+          a_ops->push_back
+            (OLOp{MkID(seq), FIX::MDUpdateActionT::New, bid, off, q});
+          continue;
+        }
+        // Otherwise, act on a random live Order: PartFill (if possible) or
+        // Delete (Cancel or Complete Fill):
+        size_t i   = size_t(u01(m_rng) * double(m_live.size()));
+        i          = min(i, m_live.size() - 1);
+        auto&  ord = m_live[i];
+        if (ord.second > 1.0 && u01(m_rng) < 0.3)
+        {
+          ord.second = Round(ord.second / 2.0);
+          a_ops->push_back
+            (OLOp{MkID(ord.first), FIX::MDUpdateActionT::Change, false, 0,
+                  ord.second});
+        }
+        else
+        {
+          a_ops->push_back
+            (OLOp{MkID(ord.first), FIX::MDUpdateActionT::Delete, false, 0,
+                  0.0});
+          ord = m_live.back();
+          m_live.pop_back();
+        }
+      }
+    }
+  };
+
+  //=========================================================================//
+  // "Apply": A single Op (as in "EConnector_MktData::ApplyOrderUpdate"):    //
+  //=========================================================================//
+  inline bool Apply(OrderBook* a_ob, OLOp const& a_op)
+  {
+    // Only a New Order gets a new slot; others are merely looked up:
+    bool const isNew = (a_op.m_action == FIX::MDUpdateActionT::New);
+    OrderBook::OrderInfo* order =
+      const_cast<OrderBook::OrderInfo*>
+      (isNew ? a_ob->GetOrderInfo (a_op.m_id)
+             : a_ob->FindOrderInfo(a_op.m_id));
+    if (utxx::unlikely(order == nullptr))
+      return false;
+
+    QtyT   delta;
+    PriceT effPx;
+    switch (a_op.m_action)
+    {
+    case FIX::MDUpdateActionT::New:
+    {
+      double off     = double(a_op.m_off) * PxStep;
+      double px      = a_op.m_isBid ? (Mid - off) : (Mid + off);
+      order->m_isBid = a_op.m_isBid;
+      order->m_px    = PriceT(px);
+      order->m_qty   = QtyU(QtyT(a_op.m_qty));
+      delta          = QtyT(a_op.m_qty);
+      effPx          = order->m_px;
+      break;
+    }
+    case FIX::MDUpdateActionT::Delete:
+      delta          = - order->GetQty<QT,QR>();
+      effPx          = order->m_px;
+      order->m_px    = PriceT();
+      order->m_qty   = QtyU();
+      break;
+
+    default:
+      delta          = QtyT(a_op.m_qty) - order->GetQty<QT,QR>();
+      effPx          = order->m_px;
+      order->m_qty   = QtyU(QtyT(a_op.m_qty));
+    }
+
+    OrderBook::UpdateEffectT upd =
+      order->m_isBid
+      ? a_ob->Update<true,  false, true, false, true, false, false, QT, QR>
+          (a_op.m_action, effPx, delta, 0, 0, order)
+      : a_ob->Update<false, false, true, false, true, false, false, QT, QR>
+          (a_op.m_action, effPx, delta, 0, 0, order);
+
+    if (a_ob->HasHashedOrders() && !IsPos(order->m_qty))
+      a_ob->RetireOrderInfo(order);
+
+    return (upd != OrderBook::UpdateEffectT::ERROR);
+  }
+
+  //=========================================================================//
+  // "RunDay": Returns the average ns/update:                                //
+  //=========================================================================//
+  double RunDay
+  (
+    OrderBook* a_ob,
+    long       a_n_orders,
+    long       a_max_live,
+    bool       a_sparse_ids,
+    long*      a_n_ops
+  )
+  {
+    DayMaker     maker(a_n_orders, a_max_live, a_sparse_ids);
+    vector<OLOp> ops;
+    ops.reserve(size_t(ChunkSz));
+    double       sec = 0.0;
+    *a_n_ops         = 0;
+
+    while (!maker.IsDone())
+    {
+      // Generation is not timed:
+      maker.Next(&ops);
+
+      utxx::time_val from = utxx::now_utc();
+      for (OLOp const& op: ops)
+        if (utxx::unlikely(!Apply(a_ob, op)))
+          throw utxx::runtime_error
+                ("RunDay: Update failed: OrderID=", op.m_id, ", Op#=",
+                 *a_n_ops);
+      sec       += (utxx::now_utc() - from).seconds();
+      *a_n_ops  += long(ops.size());
+    }
+    return sec * 1e9 / double(*a_n_ops);
+  }
+
+  //=========================================================================//
+  // "SameBooks":                                                           //
+  //=========================================================================//
+  inline bool SamePx(PriceT a_px1, PriceT a_px2)
+    { return a_px1 == a_px2 || (!IsFinite(a_px1) && !IsFinite(a_px2)); }
+
+  bool SameBooks(OrderBook const& a_ob1, OrderBook const& a_ob2)
+  {
+    return
+      SamePx(a_ob1.GetBestBidPx(), a_ob2.GetBestBidPx())                 &&
+      SamePx(a_ob1.GetBestAskPx(), a_ob2.GetBestAskPx())                 &&
+      double(a_ob1.GetCumQty<true,  QT, QR>(MaxOff)) ==
+      double(a_ob2.GetCumQty<true,  QT, QR>(MaxOff))                     &&
+      double(a_ob1.GetCumQty<false, QT, QR>(MaxOff)) ==
+      double(a_ob2.GetCumQty<false, QT, QR>(MaxOff));
+  }
+
+  //=========================================================================//
+  // "Verify": Replays a part of the day through all modes, in lock-step:    //
+  //=========================================================================//
+  bool Verify
+  (
+    OrderBook* a_arr,
+    OrderBook* a_hash,
+    OrderBook* a_sparse,
+    long       a_n_orders,
+    long       a_max_live
+  )
+  {
+    DayMaker     m1(a_n_orders, a_max_live, false);
+    DayMaker     m2(a_n_orders, a_max_live, true);
+    vector<OLOp> ops1, ops2;
+
+    for (int c = 0; c < 4 && !m1.IsDone(); ++c)
+    {
+      m1.Next(&ops1);
+      m2.Next(&ops2);
+      if (ops1.size() != ops2.size())
+        return false;
+
+      for (size_t i = 0; i < ops1.size(); ++i)
+      {
+        if (!Apply(a_arr, ops1[i]) || !Apply(a_hash, ops1[i]) ||
+            !Apply(a_sparse, ops2[i]))
+          return false;
+
+        if ((i & 1023) == 0 &&
+            (!SameBooks(*a_arr, *a_hash) || !SameBooks(*a_arr, *a_sparse)))
+        {
+          cerr << "Books MISMATCH at Op#" << i << " of Chunk " << c << endl;
+          return false;
+        }
+      }
+    }
+    return SameBooks(*a_arr, *a_hash) && SameBooks(*a_arr, *a_sparse);
+  }
+
+  //=========================================================================//
+  // "MkBook":                                                               //
+  //=========================================================================//
+  OrderBook* MkBook(SecDefD const& a_instr, long a_max_orders, bool a_hashed)
+  {
+    return new OrderBook(nullptr, &a_instr, false, false, QT, true, false,
+                         false, false, NL, 0, a_max_orders, a_hashed);
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NOrders [MaxLive]]:
+  long nOrders = (argc >= 2) ? atol(argv[1]) : 50000000;
+  long maxLive = (argc >= 3) ? atol(argv[2]) : 1000000;
+
+  if (nOrders <= 0 || maxLive <= 0)
+  {
+    cerr << "PARAMETERS: [NOrders [MaxLive]]" << endl;
+    return 1;
+  }
+  try
+  {
+    SecDefD instr;
+    instr.m_SecID    = 1;
+    instr.m_PxStep   = PxStep;
+    instr.m_FullName = MkObjName("SYNTH");
+
+    // The Array must accommodate all OrderIDs of the day (OrderID=0 is not
+    // used); the Hash only needs the max number of live Orders:
+    long arrN = nOrders + 1;
+
+    //-----------------------------------------------------------------------//
+    // Verification (untimed, separate Books):                               //
+    //-----------------------------------------------------------------------//
+    {
+      long vN = min(nOrders, 4 * ChunkSz);
+      unique_ptr<OrderBook> arr   (MkBook(instr, vN + 1,  false));
+      unique_ptr<OrderBook> hash  (MkBook(instr, maxLive, true));
+      unique_ptr<OrderBook> sparse(MkBook(instr, maxLive, true));
+      if (!Verify(arr.get(), hash.get(), sparse.get(), vN, maxLive))
+      {
+        cerr << "Verification FAILED" << endl;
+        return 1;
+      }
+    }
+    //-----------------------------------------------------------------------//
+    // Timed Runs (one Book at a time, to limit the memory footprint):       //
+    //-----------------------------------------------------------------------//
+    long   nOps = 0;
+    double nsArr, nsHash, nsSparse;
+    size_t memHash = 0;
+    {
+      unique_ptr<OrderBook> ob(MkBook(instr, arrN, false));
+      nsArr    = RunDay(ob.get(), nOrders, maxLive, false, &nOps);
+    }
+    {
+      unique_ptr<OrderBook> ob(MkBook(instr, maxLive, true));
+      nsHash   = RunDay(ob.get(), nOrders, maxLive, false, &nOps);
+      memHash  = ob->GetOrdersHash()->GetMemSize();
+    }
+    {
+      unique_ptr<OrderBook> ob(MkBook(instr, maxLive, true));
+      nsSparse = RunDay(ob.get(), nOrders, maxLive, true,  &nOps);
+    }
+    cout << "Orders=" << nOrders << ", MaxLive=" << maxLive << ", Updates="
+         << nOps    << ", Verified OK\n"
+         << "Array      : " << nsArr    << " ns/update, Mem="
+         << (size_t(arrN) * sizeof(OrderBook::OrderInfo)) << " bytes\n"
+         << "Hash       : " << nsHash   << " ns/update, Mem=" << memHash
+         << " bytes\n"
+         << "Hash/Sparse: " << nsSparse << " ns/update, Mem=" << memHash
+         << " bytes" << endl;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
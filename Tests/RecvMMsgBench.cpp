@@ -0,0 +1,175 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Tests/RecvMMsgBench.cpp":                        //
+//     Loopback UDP RX Benchmark: "recvmsg" vs "recvmmsg" in EPollReactor    //
+//===========================================================================//
+#include "Basis/EPollReactor.h"
+#include "Basis/IOUtils.hpp"
+#include "QuantSupport/HistoGram.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "RunOnce":                                                              //
+  //=========================================================================//
+  // Sends "a_n" DataGrams of "a_sz" bytes in bursts of "a_burst" (via "send-
+  // mmsg") from a separate thread, and receives them in the Reactor  with the
+  // given "a_recv_batch" (0: "recvmsg" per DataGram). Each DataGram carries the
+  // send time, so the latency (Send -> RecvHandler) is measured:
+  //
+  void RunOnce
+  (
+    EPollReactor* a_reactor,
+    int           a_port,
+    int           a_recv_batch,
+    long          a_n,
+    int           a_sz,
+    int           a_burst
+  )
+  {
+    QuantSupport::HistoGram<20> lats
+      ("Send-to-Handler Latency (usec), RecvBatch=" +
+       to_string(a_recv_batch), 0.0, 100.0);
+
+    long           nRecv = 0;
+    utxx::time_val from, to;
+
+    IO::FDInfo::RecvHandler onRecv
+    (
+      [&](int, char const* a_buff, int a_size, utxx::time_val,
+          IO::IUAddr const*) -> bool
+      {
+        if (a_buff == nullptr)      // EndOfDataChunk
+          return true;
+
+        utxx::time_val now = utxx::now_utc();
+        if (nRecv == 0)
+          from = now;
+
+        long sentNS = 0;
+        if (utxx::unlikely(a_size < int(sizeof(sentNS))))
+          return true;
+        memcpy(&sentNS, a_buff, sizeof(sentNS));
+        lats.Update(double(now.nanoseconds() - sentNS) / 1000.0);
+
+        if (++nRecv == a_n)
+        {
+          to = now;
+          a_reactor->ExitImmediately("RunOnce: All Received");
+        }
+        return true;
+      }
+    );
+    IO::FDInfo::ErrHandler onErr
+    (
+      [](int a_fd, int a_err_code, uint32_t, char const* a_msg)
+      {
+        cerr << "ERROR: FD=" << a_fd << ", ErrCode=" << a_err_code << ": "
+             << a_msg << endl;
+      }
+    );
+
+    int rfd = a_reactor->AddDataGram
+      ("BenchRX",  "127.0.0.1", a_port, onRecv, onErr, 0, 0, nullptr, -1,
+       a_recv_batch);
+
+    // Enlarge the RX buffer so that the sender does not just drop everything:
+    int rcvBuf = 64 << 20;
+    (void) setsockopt(rfd, SOL_SOCKET, SO_RCVBUF, &rcvBuf, sizeof(rcvBuf));
+
+    //-----------------------------------------------------------------------//
+    // Sender Thread:                                                        //
+    //-----------------------------------------------------------------------//
+    atomic<bool> sending(true);
+    thread sender
+    (
+      [&]()
+      {
+        int sfd = IO::MkDGramSock(nullptr, -1, "127.0.0.1", a_port).first;
+        vector<vector<char>> bufs
+          (static_cast<size_t>(a_burst), vector<char>(size_t(a_sz)));
+        vector<iovec>        iovs (static_cast<size_t>(a_burst));
+        vector<mmsghdr>      mmsgs(static_cast<size_t>(a_burst));
+        memset(mmsgs.data(), '\0', mmsgs.size() * sizeof(mmsghdr));
+
+        for (int i = 0; i < a_burst; ++i)
+        {
+          iovs [size_t(i)].iov_base           = bufs[size_t(i)].data();
+          iovs [size_t(i)].iov_len            = size_t(a_sz);
+          mmsgs[size_t(i)].msg_hdr.msg_iov    = &iovs[size_t(i)];
+          mmsgs[size_t(i)].msg_hdr.msg_iovlen = 1;
+        }
+        // Keep sending (in case of loopback drops) until told to stop:
+        while (sending.load(memory_order_relaxed))
+        {
+          for (int i = 0; i < a_burst; ++i)
+          {
+            long ns = utxx::now_utc().nanoseconds();
+            memcpy(bufs[size_t(i)].data(), &ns, sizeof(ns));
+          }
+          (void) sendmmsg(sfd, mmsgs.data(), unsigned(a_burst), 0);
+          this_thread::yield();
+        }
+        close(sfd);
+      }
+    );
+
+    a_reactor->Run(true);
+    sending.store(false, memory_order_relaxed);
+    sender.join();
+    a_reactor->Remove(rfd);
+    close(rfd);
+
+    double secs = (to - from).seconds();
+    cout << lats << "RecvBatch=" << a_recv_batch << ": " << nRecv
+         << " DataGrams in " << secs << " sec: "
+         << ((secs > 0.0) ? (double(nRecv) / secs) : 0.0) << " pkts/sec\n"
+         << endl;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NMsgs [MsgSize [Burst [RecvBatch]]]]:
+  long n     = (argc >= 2) ? atol(argv[1]) : 2000000;
+  int  sz    = (argc >= 3) ? atoi(argv[2]) : 200;
+  int  burst = (argc >= 4) ? atoi(argv[3]) : 32;
+  int  batch = (argc >= 5) ? atoi(argv[4]) : 64;
+
+  if (n <= 0 || sz < int(sizeof(long)) || burst <= 0 || batch <= 0)
+  {
+    cerr << "PARAMETERS: [NMsgs [MsgSize [Burst [RecvBatch]]]]" << endl;
+    return 1;
+  }
+  try
+  {
+    IO::GlobalInit({SIGINT});
+    shared_ptr<spdlog::logger> loggerShP =
+      IO::MkLogger("RecvMMsgBench", "stderr");
+
+    EPollReactor reactor(loggerShP.get(), 1);
+
+    RunOnce(&reactor, 31001, 0,     n, sz, burst);  // "recvmsg"  per DGram
+    RunOnce(&reactor, 31002, batch, n, sz, burst);  // "recvmmsg" batches
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,285 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/Req12IdxBench.cpp":                       //
+//        Req12 Lookups by ExchOrdID and SeqNum: Hash Indices vs Old Ways    //
+//===========================================================================//
+// Usage: Req12IdxBench [NReqs (default: 1M)]
+// (*) Emulates the Req12 array of an OMC: NReqs records of "sizeof(Req12)"
+//     bytes with the ExchOrdIDs (numeric, or alpha-numeric as those of the
+//     crypto exchanges) and the SeqNums, indexed by "KeyIdx" as "EConnector_
+//     OrdMgmt" does;
+// (*) Cross-checks that each record is found by both indices;
+// (*) Times random lookups:
+//     by numeric ExchOrdID: "KeyIdx" vs "std::unordered_map" (the old index,
+//     which only supported numeric IDs);
+//     by alpha-numeric ExchOrdID: "KeyIdx" vs a linear search;
+//     by SeqNum: "KeyIdx" vs the old linear search (backwards from the last
+//     Req12), and the index re-build time (as on start-up).
+// The output is similar to that of Google Benchmark:
+//
+#include "Basis/KeyIdx.hpp"
+#include "Basis/OrdMgmtTypes.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <unordered_map>
+#include <vector>
+#include <string>
+#include <climits>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "DoNotOptimize", "Bench":                                               //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  template<typename F>
+  void Bench(string const& a_name, long a_n, char const* a_unit, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    cout << left  << setw(34) << a_name
+         << right << setw(14) << fixed << setprecision(1)
+         << (sec * 1e9 / double(n * a_n)) << " ns/" << a_unit << endl;
+  }
+
+  //=========================================================================//
+  // "Rec": Same size as "Req12", with the flds used by the lookups:         //
+  //=========================================================================//
+  struct Rec
+  {
+    OrderID   m_id;
+    SeqNum    m_seqNum;
+    ExchOrdID m_exchOrdID;
+    char      m_pad[sizeof(Req12) - 2 * sizeof(long) - sizeof(ExchOrdID)];
+  };
+  static_assert(sizeof(Rec) == sizeof(Req12), "Rec");
+
+  //=========================================================================//
+  // "Store": The Recs and their indices:                                    //
+  //=========================================================================//
+  struct Store
+  {
+    vector<Rec>        m_recs;
+    unsigned           m_nSlots;
+    vector<KeyIdxSlot> m_byExchID;
+    vector<KeyIdxSlot> m_bySeqNum;
+    int                m_nByExchID = 0;
+    int                m_nBySeqNum = 0;
+
+    Store(unsigned a_n, bool a_alpha)
+    : m_recs    (a_n + 1),
+      m_nSlots  (KeyIdxNSlots(a_n + 1)),
+      m_byExchID(m_nSlots),
+      m_bySeqNum(m_nSlots)
+    {
+      // The IDs are unique but not monotonic (an odd multiplier permutes the
+      // 32-bit ints):
+      mt19937_64 rng(12345);
+      for (unsigned i = 1; i <= a_n; ++i)
+      {
+        Rec&     r   = m_recs[i];
+        uint32_t key = i * 2654435761U;
+        r.m_id       = i;
+        r.m_seqNum   = SeqNum(i) + 1000;
+        if (a_alpha)
+        {
+          // Eg Binance / Huobi / Kraken style IDs:
+          char buf[40];
+          snprintf(buf, sizeof(buf), "O%08X-%05lX-%06lX", key,
+                   rng() & 0xFFFFF, rng() & 0xFFFFFF);
+          r.m_exchOrdID = ExchOrdID(buf, int(strlen(buf)));
+        }
+        else
+          r.m_exchOrdID = ExchOrdID(OrderID(7'000'000'000UL + key));
+      }
+      ReIndex();
+    }
+
+    void ReIndex()
+    {
+      KeyIdxClear(m_byExchID.data(), m_nSlots);
+      KeyIdxClear(m_bySeqNum.data(), m_nSlots);
+      m_nByExchID = 0;
+      m_nBySeqNum = 0;
+      for (size_t i = 1; i < m_recs.size(); ++i)
+      {
+        Rec const& r = m_recs[i];
+        (void) KeyIdxAssign(m_bySeqNum.data(), m_nSlots, &m_nBySeqNum,
+                            Key16{uint64_t(r.m_seqNum), 0}, int(i));
+        (void) KeyIdxInsert(m_byExchID.data(), m_nSlots, &m_nByExchID,
+                            MkKey16(r.m_exchOrdID),   int(i));
+      }
+    }
+
+    // As "EConnector_OrdMgmt::GetReq12ByExchID":
+    Rec const* ByExchID(ExchOrdID const& a_id) const
+    {
+      int id = KeyIdxFind(m_byExchID.data(), m_nSlots, MkKey16(a_id));
+      if (id < 0)
+        return nullptr;
+      Rec const* r = &m_recs[size_t(id)];
+      return (r->m_exchOrdID == a_id) ? r : nullptr;
+    }
+
+    // As "EConnector_OrdMgmt::GetReq12BySeqNum":
+    Rec const* BySeqNum(SeqNum a_sn) const
+    {
+      int id = KeyIdxFind
+               (m_bySeqNum.data(), m_nSlots, Key16{uint64_t(a_sn), 0});
+      return (id > 0 && m_recs[size_t(id)].m_seqNum == a_sn)
+             ? &m_recs[size_t(id)] : nullptr;
+    }
+
+    // The old "GetReq12BySeqNum":
+    Rec const* ScanSeqNum(SeqNum a_sn) const
+    {
+      SeqNum prevSN = LONG_MAX;
+      for (size_t i = m_recs.size() - 1; i >= 1; --i)
+      {
+        Rec const& r = m_recs[i];
+        if (r.m_seqNum == a_sn)
+          return &r;
+        if (r.m_seqNum < a_sn || r.m_seqNum >= prevSN)
+          break;
+        prevSN = r.m_seqNum;
+      }
+      return nullptr;
+    }
+
+    // A linear search by ExchOrdID:
+    Rec const* ScanExchID(ExchOrdID const& a_id) const
+    {
+      for (size_t i = m_recs.size() - 1; i >= 1; --i)
+        if (m_recs[i].m_exchOrdID == a_id)
+          return &m_recs[i];
+      return nullptr;
+    }
+  };
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    unsigned nReqs = (argc >= 2) ? unsigned(atoi(argv[1])) : 1'000'000;
+    if (nReqs == 0)
+      throw invalid_argument("NReqs must be positive");
+
+    Store num  (nReqs, false);
+    Store alpha(nReqs, true);
+
+    // The old index of numeric ExchOrdIDs:
+    unordered_map<OrderID, Rec const*> oldMap;
+    oldMap.max_load_factor(1.0);
+    oldMap.reserve(nReqs);
+    for (size_t i = 1; i < num.m_recs.size(); ++i)
+      oldMap.emplace(num.m_recs[i].m_exchOrdID.GetOrderID(), &num.m_recs[i]);
+
+    //-----------------------------------------------------------------------//
+    // Cross-Check:                                                          //
+    //-----------------------------------------------------------------------//
+    for (Store const* st: {&num, &alpha})
+      for (size_t i = 1; i < st->m_recs.size(); ++i)
+      {
+        Rec const& r = st->m_recs[i];
+        if (st->ByExchID(r.m_exchOrdID) != &r ||
+            st->BySeqNum(r.m_seqNum)    != &r)
+        {
+          cerr << "MISMATCH: Rec " << i << ": ExchOrdID="
+               << r.m_exchOrdID.ToString() << endl;
+          return 1;
+        }
+      }
+    if (num.BySeqNum(1) != nullptr ||
+        alpha.ByExchID(ExchOrdID("NO-SUCH-ID")) != nullptr)
+    {
+      cerr << "MISMATCH: Found a non-existent Req12" << endl;
+      return 1;
+    }
+
+    // Random lookup targets:
+    mt19937_64      rng(54321);
+    vector<unsigned> targets(4'096);
+    for (unsigned& t: targets)
+      t = 1 + unsigned(rng() % nReqs);
+
+    cout << nReqs << " Req12s (" << sizeof(Req12) << " bytes each), "
+         << num.m_nSlots << " slots per index\n\n"
+         << left  << setw(34) << "Benchmark" << right << setw(19) << "Time\n"
+         << string(56, '-') << endl;
+
+    //-----------------------------------------------------------------------//
+    // By ExchOrdID:                                                         //
+    //-----------------------------------------------------------------------//
+    size_t i = 0;
+    Bench("ExchID/Num/UnorderedMap", 1, "lookup", [&]
+      {
+        Rec const& r  = num.m_recs[targets[i++ % targets.size()]];
+        auto       it = oldMap.find(r.m_exchOrdID.GetOrderID());
+        DoNotOptimize(it->second);
+      });
+    Bench("ExchID/Num/KeyIdx",      1, "lookup", [&]
+      {
+        Rec const& r = num.m_recs[targets[i++ % targets.size()]];
+        DoNotOptimize(num.ByExchID(r.m_exchOrdID));
+      });
+    Bench("ExchID/Alpha/KeyIdx",    1, "lookup", [&]
+      {
+        Rec const& r = alpha.m_recs[targets[i++ % targets.size()]];
+        DoNotOptimize(alpha.ByExchID(r.m_exchOrdID));
+      });
+    Bench("ExchID/Alpha/LinearScan", 1, "lookup", [&]
+      {
+        Rec const& r = alpha.m_recs[targets[i++ % targets.size()]];
+        DoNotOptimize(alpha.ScanExchID(r.m_exchOrdID));
+      });
+
+    //-----------------------------------------------------------------------//
+    // By SeqNum:                                                            //
+    //-----------------------------------------------------------------------//
+    Bench("SeqNum/KeyIdx",          1, "lookup", [&]
+      {
+        Rec const& r = num.m_recs[targets[i++ % targets.size()]];
+        DoNotOptimize(num.BySeqNum(r.m_seqNum));
+      });
+    Bench("SeqNum/LinearScan",      1, "lookup", [&]
+      {
+        Rec const& r = num.m_recs[targets[i++ % targets.size()]];
+        DoNotOptimize(num.ScanSeqNum(r.m_seqNum));
+      });
+
+    //-----------------------------------------------------------------------//
+    // Re-building both indices (as on start-up):                            //
+    //-----------------------------------------------------------------------//
+    Bench("ReIndex/Alpha",         nReqs, "req",    [&]
+      {
+        alpha.ReIndex();
+        DoNotOptimize(alpha.m_nByExchID);
+      });
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
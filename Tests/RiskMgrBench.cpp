@@ -0,0 +1,324 @@
+// vim:ts=2:et
+//===========================================================================//
+//                           "Tests/RiskMgrBench.cpp":                       //
+//            "RiskMgr" MktData Ticks Throughput (Many Users x Instrs)       //
+//===========================================================================//
+// "NInstrs" Instruments "A<i>/USD" (RFC=USD) are Registered with a "RiskMgr",
+// each with its own OrderBook which is also the Valuator of Asset "A<i>". Then
+// "NUsers" Users get non-0 Positions in all Instruments, so each OrderBook tick
+// affects "NUsers" "InstrRisks" and "NUsers" "AssetRisks".  The ticks (which
+// move the L1 Bid Px back and forth) go to randomly-chosen OrderBooks.
+// Modes:
+// (*) STP:         RFC Totals are not maintained on MktData ticks at all;
+// (*) FullReCalc:  RFC Totals of all affected Users are re-calculated from 0
+//                  on each tick (RFCTotalsReconcilePeriod=0);
+// (*) Throttled:   as above, but MktData updates are throttled (10 msec), so
+//                  most ticks are skipped and the Risks become stale;
+// (*) Incremental: RFC Totals are updated by deltas on each tick, with full
+//                  re-calculation (drift reconciliation) after every 1000
+//                  updates of each User.
+// Then each User gets "A0" Balance Updates. In all Modes except STP, the re-
+// sulting RFC Totals are verified against the direct summation over all the
+// "AssetRisks" (ie a full re-calculation):
+//
+#include "Basis/IOUtils.h"
+#include "Connectors/OrderBook.hpp"
+#include "InfraStruct/SecDefsMgr.h"
+#include "InfraStruct/RiskMgr.h"
+#include <utxx/time_val.hpp>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <memory>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <cstdio>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Consts:                                                                 //
+  //=========================================================================//
+  constexpr QtyTypeT QT     = QtyTypeT::QtyA;
+  using    QR               = double;
+  using    QtyT             = Qty<QT,QR>;
+  constexpr double   PxStep = 0.01;
+
+  char const* const  Pfx    = "RiskMgrBench";
+
+  //=========================================================================//
+  // "Apply": A single OrderBook Update:                                     //
+  //=========================================================================//
+  template<bool IsBid>
+  void Apply
+  (
+    OrderBook*           a_ob,
+    FIX::MDUpdateActionT a_act,
+    double               a_px,
+    double               a_qty
+  )
+  {
+    (void) a_ob->Update<IsBid, false, false, false, true, false, true, QT, QR>
+      (a_act, PriceT(a_px), QtyT(a_qty), 0, 0, nullptr);
+  }
+
+  //=========================================================================//
+  // "MkBook": 2 Bid and 2 Ask levels around 100:                            //
+  //=========================================================================//
+  OrderBook* MkBook(SecDefD const& a_instr)
+  {
+    OrderBook* ob =
+      new OrderBook(nullptr, &a_instr, false, true, QT, true, false, false,
+                    false, 0, 0, 0, false);
+    ob->SetInitialised();
+    Apply<true> (ob, FIX::MDUpdateActionT::New, 100.0 - PxStep,     10.0);
+    Apply<true> (ob, FIX::MDUpdateActionT::New, 100.0 - 2 * PxStep, 10.0);
+    Apply<false>(ob, FIX::MDUpdateActionT::New, 100.0 + PxStep,     10.0);
+    Apply<false>(ob, FIX::MDUpdateActionT::New, 100.0 + 2 * PxStep, 10.0);
+    return ob;
+  }
+
+  //=========================================================================//
+  // "MkParams": RiskMgr Params (all Limits are effectively disabled):       //
+  //=========================================================================//
+  boost::property_tree::ptree MkParams
+  (
+    long a_n_risks,
+    int  a_md_period_msec,
+    int  a_reconcile_period
+  )
+  {
+    // ShM size estimate: "InstrRisks" and "AssetRisks" in Map nodes:
+    size_t perRisk  = sizeof(InstrRisks) + sizeof(AssetRisks) + 256;
+    size_t segmSzMB =
+      64 + (size_t(a_n_risks) * perRisk) / (1UL << 20) * 5 / 4;
+
+    boost::property_tree::ptree params;
+    params.put("AccountPfx",                   Pfx);
+    params.put("ResetAll",                     true);
+    params.put("ShMSegmSzMB",                  segmSzMB);
+    params.put("RFC",                          "USD");
+    params.put("MDUpdatesPeriodMSec",          a_md_period_msec);
+    params.put("RFCTotalsReconcilePeriod",     a_reconcile_period);
+    params.put("MaxTotalRisk_RFC",             1e15);
+    params.put("MaxNormalRisk_RFC",            1e15);
+    params.put("MinTotalNAV_RFC",              -1e15);
+    params.put("MaxOrderSize_RFC",             1e12);
+    params.put("MinOrderSize_RFC",             1.0);
+    params.put("MaxActiveOrdersTotalSize_RFC", 1e15);
+    params.put("VlmThrottlPeriod1_Sec",        1);
+    params.put("VlmLimit1_RFC",                1e15);
+    params.put("VlmThrottlPeriod2_Sec",        60);
+    params.put("VlmLimit2_RFC",                1e15);
+    params.put("VlmThrottlPeriod3_Sec",        3600);
+    params.put("VlmLimit3_RFC",                1e15);
+    return params;
+  }
+
+  //=========================================================================//
+  // "RemoveShM": ShM Segments created by this Test:                         //
+  //=========================================================================//
+  // (NB: "PersistMgr" prepends the UserName to the Segment names):
+  //
+  void RemoveShM()
+  {
+    string pfx = string(cuserid(nullptr)) + "-" + Pfx;
+    (void) BIPC::shared_memory_object::remove
+      ((pfx + "-SecDefsMgr-Test").data());
+    (void) BIPC::shared_memory_object::remove
+      ((pfx + "-RiskMgr-Test").data());
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NUsers [NInstrs [NTicks [Mode]]]]:
+  int    nUsers  = (argc >= 2) ? atoi(argv[1]) : 1000;
+  int    nInstrs = (argc >= 3) ? atoi(argv[2]) : 500;
+  long   nTicks  = (argc >= 4) ? atol(argv[3]) : 20000;
+  string modeStr = (argc >= 5) ? argv[4]       : "STP";
+
+  bool isThrottled = (modeStr == "Throttled");
+  bool isIncr      = (modeStr == "Incremental");
+  if (nUsers <= 0 || nInstrs <= 0 || nInstrs > Limits::MaxInstrs / 2 ||
+      nTicks <= 0 ||
+      (modeStr != "STP" && modeStr != "FullReCalc" && !isThrottled && !isIncr))
+  {
+    cerr << "PARAMETERS: [NUsers [NInstrs [NTicks "
+            "[{STP|FullReCalc|Throttled|Incremental}]]]]" << endl;
+    return 1;
+  }
+  RMModeT mode = (modeStr == "STP") ? RMModeT::STP : RMModeT::Normal;
+
+  RemoveShM();
+  bool ok = true;
+  try
+  {
+    shared_ptr<spdlog::logger> logger =
+      IO::MkLogger("RiskMgrBench_Logger", "stderr");
+
+    //-----------------------------------------------------------------------//
+    // Instruments and OrderBooks:                                           //
+    //-----------------------------------------------------------------------//
+    SecDefsMgr* sdm = SecDefsMgr::GetPersistInstance(false, Pfx);
+    vector<SecDefD const*>        instrs;
+    vector<unique_ptr<OrderBook>> obs;
+
+    for (int i = 0; i < nInstrs; ++i)
+    {
+      string asset  = "A" + to_string(i);
+      string symbol = asset + "/USD";
+      SecDefS sds
+        (0, symbol.data(), "", "", "", "BENCH", "", "", "", asset.data(),
+         "USD", 'A', 1.0, 1.0, 1, PxStep, 'A', 1.0, 0, 0, 0.0, 0, "");
+      instrs.push_back(&(sdm->Add(sds, false, 0, 0, 0.0, 0.0)));
+      obs.emplace_back(MkBook(*instrs.back()));
+    }
+
+    //-----------------------------------------------------------------------//
+    // RiskMgr:                                                              //
+    //-----------------------------------------------------------------------//
+    long nRisks = long(nUsers) * long(nInstrs);
+    utxx::time_val from = utxx::now_utc();
+
+    RiskMgr* rm = RiskMgr::GetPersistInstance
+      (false, MkParams(nRisks, isThrottled ? 10 : 0, isIncr ? 1000 : 0),
+       *sdm, false, logger.get(), 0);
+
+    for (int i = 0; i < nInstrs; ++i)
+    {
+      rm->Register(*instrs[size_t(i)], obs[size_t(i)].get());
+      rm->InstallValuator
+        (instrs[size_t(i)]->m_AssetA.data(), 0, obs[size_t(i)].get());
+    }
+    // Users' Positions: Long 1 unit of each Instrument (and of each Asset, so
+    // that the RFC Totals change on each tick):
+    for (UserID u = 1; u <= UserID(nUsers); ++u)
+    for (SecDefD const* instr: instrs)
+    {
+      InstrRisks const& ir = rm->GetInstrRisks(*instr, u);
+      ir.m_posA            = RMQtyA(1.0);
+      ir.m_avgPosPxAB      = PriceT(100.0);
+      ir.m_risksA->m_trdDelta = 1.0;
+    }
+    rm->Start(mode);
+
+    double setupSec = (utxx::now_utc() - from).seconds();
+    cout << "Users=" << nUsers  << ", Instrs=" << nInstrs << ", Mode="
+         << modeStr  << ", Setup=" << fixed    << setprecision(2) << setupSec
+         << " sec"   << endl;
+
+    //-----------------------------------------------------------------------//
+    // Ticks:                                                                //
+    //-----------------------------------------------------------------------//
+    // Each tick toggles the L1 Bid of a random OrderBook (so the Valuation
+    // rate changes on every tick), then notifies the RiskMgr:
+    //
+    mt19937_64                   rng(2024);
+    uniform_int_distribution<int> obD(0, nInstrs - 1);
+    vector<char>                  hasL1(size_t(nInstrs), 1);
+    vector<char>                  ticked(size_t(nInstrs), 0);
+    double                        sec = 0.0;
+    double                        l1  = 100.0 - PxStep;
+
+    for (long t = 0; t < nTicks; ++t)
+    {
+      size_t     i  = size_t(obD(rng));
+      OrderBook* ob = obs[i].get();
+      if (hasL1[i])
+        Apply<true>(ob, FIX::MDUpdateActionT::Delete, l1, 0.0);
+      else
+        Apply<true>(ob, FIX::MDUpdateActionT::New,    l1, 10.0);
+      hasL1[i]  = !hasL1[i];
+      ticked[i] = 1;
+
+      utxx::time_val t0 = utxx::now_utc();
+      rm->OnMktDataUpdate(*ob, t0);
+      sec += (utxx::now_utc() - t0).seconds();
+    }
+
+    //-----------------------------------------------------------------------//
+    // Balance Updates (untimed):                                            //
+    //-----------------------------------------------------------------------//
+    // Each User gets an initial Balance of "A0", then a Deposit of it; these
+    // must also be reflected in the RFC Totals (checked below):
+    //
+    char const*    a0 = instrs[0]->m_AssetA.data();
+    utxx::time_val ts = utxx::now_utc();
+    for (UserID u = 1; u <= UserID(nUsers); ++u)
+    {
+      rm->OnBalanceUpdate
+        (a0, 0, "Init",    u, AssetRisks::AssetTransT::Initial, 5.0,  ts);
+      rm->OnBalanceUpdate
+        (a0, 0, "Deposit", u, AssetRisks::AssetTransT::Deposit, 12.0, ts);
+    }
+
+    //-----------------------------------------------------------------------//
+    // Verify the UnRPnLs:                                                   //
+    //-----------------------------------------------------------------------//
+    // For each ticked Instrument and each User, the UnRPnL must correspond to
+    // the curr L1 Bid Px  -- unless the ticks were throttled,  in which case
+    // we only count the stale ones:
+    long nStale = 0;
+    for (int i = 0; i < nInstrs; ++i)
+    {
+      double bid   = double(obs[size_t(i)]->GetBestBidPx());
+      for (UserID u = 1; u <= UserID(nUsers); ++u)
+      {
+        InstrRisks const& ir = rm->GetInstrRisks(*instrs[size_t(i)], u);
+        double expUnRPnL     = bid - 100.0;
+        nStale +=
+          ticked[size_t(i)] &&
+          (ir.m_ts.empty() || Abs(double(ir.m_unrPnLB) - expUnRPnL) >= 1e-9);
+      }
+    }
+    ok = isThrottled || nStale == 0;
+
+    //-----------------------------------------------------------------------//
+    // Verify the RFC Totals:                                                //
+    //-----------------------------------------------------------------------//
+    // They must be equal to a full re-calculation (direct summation over all
+    // "AssetRisks", as in "RiskMgr::ReCalcRFCTotals"), after all ticks  and
+    // Balance Updates:
+    //
+    double maxErr = 0.0;
+    for (UserID u = 1; mode != RMModeT::STP && u <= UserID(nUsers); ++u)
+    {
+      double nav = 0.0, risk = 0.0;
+      for (auto const& arp: rm->GetAllAssetRisks(u))
+      {
+        double rfc = arp.second.GetNetTotalRFC();
+        nav       += rfc;
+        risk      += arp.second.m_isRFC ? 0.0 : Abs(rfc);
+      }
+      maxErr = max(maxErr, Abs(rm->GetTotalNAV_RFC(u) - nav));
+      maxErr = max(maxErr, Abs(rm->GetTotalRiskRFC(u) - risk));
+    }
+    ok &= (maxErr < 1e-6);
+
+    cout << "Ticks=" << nTicks << ": " << setprecision(0)
+         << (double(nTicks) / sec) << " ticks/sec, " << setprecision(2)
+         << (sec * 1e9 / (double(nTicks) * 2.0 * double(nUsers)))
+         << " ns per affected Risk, StaleRisks=" << nStale
+         << ", MaxTotalsErr=" << scientific << maxErr << fixed
+         << (ok ? "" : "  *** FAILED ***") << endl;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    ok = false;
+  }
+  RemoveShM();
+  return ok ? 0 : 1;
+}
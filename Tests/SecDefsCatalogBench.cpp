@@ -0,0 +1,233 @@
+// vim:ts=2:et
+//===========================================================================//
+//                      "Tests/SecDefsCatalogBench.cpp":                     //
+//    Start-Up Cost of Compiled-In "SecDefS" Tables vs Binary MMap Catalog   //
+//===========================================================================//
+// Usage: SecDefsCatalogBench [TmpDir (default: /tmp)]
+// (*) Uses the real FORTS Options table ("SecDefs_Opt_Prod", ~7.9k entries),
+//     and a synthetic 100k table made of its replicas with distinct Symbols
+//     and SecIDs;
+// (*) "Init/Ctors" re-constructs the table via the Full "SecDefS" Ctor,  as
+//     is done by the static initialisers of the compiled-in tables at start-
+//     up;
+// (*) "Catalog/Open" maps a "SecDefsCatalog" of the same table, with  and
+//     without verification of the CheckSum;
+// (*) Then Symbol lookups are compared: Linear Search (as is done by "ECon-
+//     nector" over a compiled-in table) vs the Catalog's Symbol Index;
+// (*) The Catalog contents are cross-checked against the original table.
+// The output is similar to that of Google Benchmark:
+//
+#include "Basis/SecDefsCatalog.h"
+#include "Venues/FORTS/SecDefs.h"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <random>
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "DoNotOptimize":                                                        //
+  //=========================================================================//
+  template<typename T>
+  inline void DoNotOptimize(T const& a_val)
+    { asm volatile("" : : "r,m"(a_val) : "memory"); }
+
+  //=========================================================================//
+  // "Bench": Runs "a_f" (which performs "a_n" ops) until at least 0.2 sec   //
+  // has elapsed, and prints the time per op:                                //
+  //=========================================================================//
+  template<typename F>
+  void Bench(string const& a_name, long a_n, char const* a_unit, F const& a_f)
+  {
+    long   n   = 1;
+    double sec = 0.0;
+    for (; sec < 0.2; n *= 2)
+    {
+      utxx::time_val from = utxx::now_utc();
+      for (long i = 0; i < n; ++i)
+        a_f();
+      sec = (utxx::now_utc() - from).seconds();
+    }
+    n /= 2;
+    cout << left  << setw(36) << a_name
+         << right << setw(12) << fixed << setprecision(1)
+         << (sec * 1e9 / double(n * a_n)) << " ns/" << a_unit << endl;
+  }
+
+  //=========================================================================//
+  // "ReConstruct":                                                          //
+  //=========================================================================//
+  // Same as a static initialiser of a compiled-in table would do (with the
+  // args recovered from the already-constructed "SecDefS"):
+  //
+  vector<SecDefS> ReConstruct(vector<SecDefS> const& a_sds)
+  {
+    vector<SecDefS> res;
+    res.reserve(a_sds.size());
+    for (SecDefS const& sd: a_sds)
+    {
+      bool inA = sd.IsContractInA();
+      res.emplace_back
+      (
+        sd.m_SecID,               sd.m_Symbol.data(),   sd.m_AltSymbol.data(),
+        sd.m_SecurityDesc,        sd.m_CFICode,         sd.m_Exchange.data(),
+        sd.m_SessOrSegmID.data(), sd.m_Tenor.data(),    sd.m_Tenor2.data(),
+        sd.m_AssetA.data(),       sd.m_QuoteCcy.data(), inA ? 'A' : 'B',
+        sd.m_ABQtys[inA ? 0 : 1], sd.m_LotSize,         sd.m_MinSizeLots,
+        sd.m_PxStep,              'A',                  sd.m_PxFactAB,
+        sd.m_ExpireDate,          sd.m_ExpireTime,      sd.m_Strike,
+        sd.m_UnderlyingSecID,     sd.m_UnderlyingSymbol.data()
+      );
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // "Replicate": Makes a table of "a_n" entries with distinct Symbols:      //
+  //=========================================================================//
+  vector<SecDefS> Replicate(vector<SecDefS> const& a_sds, size_t a_n)
+  {
+    vector<SecDefS> res;
+    res.reserve(a_n);
+    for (size_t i = 0; i < a_n; ++i)
+    {
+      SecDefS sd = a_sds[i % a_sds.size()];
+      size_t  r  = i / a_sds.size();
+      if (r != 0)
+      {
+        char sym[64];
+        snprintf(sym, sizeof(sym), "%.11s#%zu", sd.m_Symbol.data(), r);
+        InitFixedStr(&sd.m_Symbol, sym);
+        sd.m_SecID += 100'000'000UL * r;
+      }
+      res.push_back(sd);
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // "CrossCheck":                                                           //
+  //=========================================================================//
+  bool CrossCheck(vector<SecDefS> const& a_sds, SecDefsCatalog const& a_cat)
+  {
+    if (utxx::unlikely(size_t(a_cat.Size()) != a_sds.size()))
+    {
+      cerr << "MISMATCH: Size=" << a_cat.Size() << ", expected "
+           << a_sds.size() << endl;
+      return false;
+    }
+    for (SecDefS const& sd: a_sds)
+    {
+      // The verbatim image must be found among the Recs with its Symbol:
+      SecDefsRange rng = a_cat.FindBySymbol(sd.m_Symbol.data());
+      bool found =
+        any_of(rng.begin(), rng.end(), [&sd](SecDefS const& a_curr)->bool
+               { return memcmp(&a_curr, &sd, sizeof(SecDefS)) == 0; });
+
+      SecDefS const* byID = a_cat.FindBySecID(sd.m_SecID);
+      if (utxx::unlikely
+         (!found || byID == nullptr || byID->m_SecID != sd.m_SecID ||
+          any_of(rng.begin(), rng.end(), [&sd](SecDefS const& a_curr)->bool
+                 { return a_curr.m_Symbol != sd.m_Symbol; })))
+      {
+        cerr << "MISMATCH: Symbol=" << sd.m_Symbol.data() << ", SecID="
+             << sd.m_SecID << endl;
+        return false;
+      }
+    }
+    return true;
+  }
+
+  //=========================================================================//
+  // "Run":                                                                  //
+  //=========================================================================//
+  bool Run(vector<SecDefS> const& a_sds, string const& a_path)
+  {
+    long   n   = long(a_sds.size());
+    string sfx = "/" + to_string(n);
+
+    utxx::time_val from = utxx::now_utc();
+    SecDefsCatalog::Write(a_path, a_sds, "SecDefsCatalogBench");
+    double wrSec = (utxx::now_utc() - from).seconds();
+
+    SecDefsCatalog cat(a_path);
+    if (!CrossCheck(a_sds, cat))
+      return false;
+
+    // Queries: 90% hits, 10% misses:
+    constexpr int NQ = 4096;
+    mt19937_64     rng(12345 + unsigned(n));
+    vector<string> qSyms(NQ);
+    for (int q = 0; q < NQ; ++q)
+      qSyms[size_t(q)] =
+        (rng() % 10 != 0)
+        ? string(a_sds[rng() % a_sds.size()].m_Symbol.data())
+        : "ZZ" + to_string(q);
+
+    cout << '\n' << left << setw(36) << ("Catalog/Write" + sfx)
+         << right << setw(12) << fixed << setprecision(1)
+         << (wrSec * 1e3) << " ms (once)" << endl;
+
+    Bench("Init/Ctors"            + sfx, n, "rec",
+          [&]{ DoNotOptimize(ReConstruct(a_sds).data()); });
+    Bench("Catalog/Open"          + sfx, n, "rec",
+          [&]{ SecDefsCatalog c(a_path, false); DoNotOptimize(c.begin()); });
+    Bench("Catalog/Open+CheckSum" + sfx, n, "rec",
+          [&]{ SecDefsCatalog c(a_path, true);  DoNotOptimize(c.begin()); });
+
+    long nLin = min<long>(NQ, max<long>(64, 20'000'000 / n));
+    Bench("Symbol/Linear"         + sfx, nLin, "lookup", [&]
+      {
+        for (long q = 0; q < nLin; ++q)
+          DoNotOptimize
+          (find_if(a_sds.cbegin(), a_sds.cend(),
+            [&](SecDefS const& a_curr)->bool
+            { return strcmp(a_curr.m_Symbol.data(),
+                            qSyms[size_t(q)].data()) == 0; }));
+      });
+    Bench("Symbol/Catalog"        + sfx, NQ,   "lookup", [&]
+      {
+        for (int  q = 0; q < NQ;   ++q)
+          DoNotOptimize(cat.FindBySymbol(qSyms[size_t(q)].data()).begin());
+      });
+    return true;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  try
+  {
+    string dir  = (argc >= 2) ? argv[1] : "/tmp";
+    string path = dir + "/SecDefsCatalogBench." + to_string(getpid());
+
+    vector<SecDefS> const& real = FORTS::SecDefs_Opt_Prod;
+
+    cout << left  << setw(36) << "Benchmark" << right << setw(22) << "Time\n"
+         << string(58, '-') << endl;
+    bool ok =
+      Run(real, path) &&
+      Run(Replicate(real, 100'000), path);
+
+    (void) unlink(path.data());
+    return ok ? 0 : 1;
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+}
@@ -0,0 +1,243 @@
+// vim:ts=2:et
+//===========================================================================//
+//                       "Tests/SeqNumBufferBench.cpp":                      //
+//   "SeqNumBuffer" on A/B-Arbitrated Feeds with Synthetic Reordering / Loss //
+//===========================================================================//
+// Streams of "NItems" SeqNums (default: 10M) are generated as received from 2
+// redundant Channels ('A' and 'B', the latter lagging behind), with optional
+// local reordering within each Channel, and optional independent losses in
+// each Channel (so that some SeqNums are lost in both, and the Buffer has to
+// "Recover"). Each stream is fed into a "SeqNumBuffer" with a per-Item and
+// with a batch Processor; the output is verified (strictly increasing, and
+// complete unless there were losses in both Channels):
+//
+#include "Basis/IOUtils.h"
+#include "Connectors/SeqNumBuffer.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // Types and Consts:                                                       //
+  //=========================================================================//
+  constexpr int Capacity = 1024;
+  constexpr int MaxGap   = 256;
+  constexpr int BLag     = 8;      // Lag of Channel 'B' (in Items)
+
+  // The Items are small "decoded msgs":
+  struct Item
+  {
+    SeqNum  m_sn;
+    double  m_data[3];
+  };
+
+  //-------------------------------------------------------------------------//
+  // "Pattern":                                                              //
+  //-------------------------------------------------------------------------//
+  struct Pattern
+  {
+    char const* m_name;
+    bool        m_withB;     // Is Channel 'B' present?
+    double      m_swapProb;  // Prob of swapping adjacent Items in a Channel
+    double      m_lossProb;  // Prob of losing an Item in a Channel
+  };
+
+  //=========================================================================//
+  // "MkStream": Items received from Channels 'A' and 'B', merged:           //
+  //=========================================================================//
+  vector<SeqNum> MkStream(Pattern const& a_pat, long a_n, mt19937_64* a_rng)
+  {
+    uniform_real_distribution<> u01;
+
+    auto mkChannel = [&]() -> vector<SeqNum>
+    {
+      vector<SeqNum> ch;
+      ch.reserve(size_t(a_n));
+      for (SeqNum sn = 1; sn <= a_n; ++sn)
+        if (a_pat.m_lossProb == 0.0 || u01(*a_rng) >= a_pat.m_lossProb)
+          ch.push_back(sn);
+
+      // NB: The 1st Item is never moved, as it initialises the expected Seq-
+      // Num of the Buffer:
+      if (a_pat.m_swapProb > 0.0)
+        for (size_t i = 2; i < ch.size(); ++i)
+          if (u01(*a_rng) < a_pat.m_swapProb)
+          {
+            swap(ch[i-1], ch[i]);
+            ++i;    // Don't move the same Item twice
+          }
+      return ch;
+    };
+
+    vector<SeqNum> a = mkChannel();
+    if (!a_pat.m_withB)
+      return a;
+
+    vector<SeqNum> b = mkChannel();
+    vector<SeqNum> res;
+    res.reserve(a.size() + b.size());
+    for (size_t i = 0; i < max(a.size(), b.size() + BLag); ++i)
+    {
+      if (i < a.size())
+        res.push_back(a[i]);
+      if (i >= BLag && i - BLag < b.size())
+        res.push_back(b[i - BLag]);
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // Emplacer and Processors:                                                //
+  //=========================================================================//
+  struct Emplacer
+  {
+    SeqNum m_sn = 0;
+
+    void operator()(Item* a_place) const
+      { a_place->m_sn = m_sn; a_place->m_data[0] = double(m_sn); }
+  };
+
+  struct ProcBase
+  {
+    SeqNum  m_last   = 0;
+    long    m_n      = 0;
+    long    m_calls  = 0;
+    long    m_errs   = 0;
+    double  m_sum    = 0.0;
+
+    void Do(SeqNum a_sn, Item const& a_item)
+    {
+      m_errs += (a_sn <= m_last || a_item.m_sn != a_sn);
+      m_last  = a_sn;
+      m_sum  += a_item.m_data[0];
+      ++m_n;
+    }
+  };
+
+  struct ItemProc: public ProcBase
+  {
+    void operator()
+      (SeqNum a_sn, Item const& a_item, bool, utxx::time_val, utxx::time_val)
+    {
+      ++m_calls;
+      Do(a_sn, a_item);
+    }
+  };
+
+  struct BatchProc: public ProcBase
+  {
+    // The per-Item call-back is still required:
+    void operator()
+      (SeqNum a_sn, Item const& a_item, bool, utxx::time_val, utxx::time_val)
+    {
+      ++m_calls;
+      Do(a_sn, a_item);
+    }
+
+    void operator()
+      (SeqNum a_sn0, int a_n, Item const* a_items, bool,
+       utxx::time_val const*, utxx::time_val const*)
+    {
+      ++m_calls;
+      for (int i = 0; i < a_n; ++i)
+        Do(a_sn0 + i, a_items[i]);
+    }
+  };
+
+  //=========================================================================//
+  // "Run": Returns "false" if the output is incorrect:                      //
+  //=========================================================================//
+  template<typename Proc>
+  bool Run
+  (
+    char const*           a_title,
+    vector<SeqNum> const& a_stream,
+    long                  a_n,
+    bool                  a_complete,
+    spdlog::logger*       a_logger
+  )
+  {
+    Proc     proc;
+    Emplacer emplacer;
+    // NB: DebugLevel=1, so that "Recover" warnings are not logged:
+    SeqNumBuffer<Item, Emplacer, Proc>
+      buff(Capacity, MaxGap, &proc, a_logger, 1, false);
+
+    utxx::time_val from = utxx::now_utc();
+    for (SeqNum sn: a_stream)
+    {
+      emplacer.m_sn = sn;
+      (void) buff.Put(&emplacer, sn, utxx::time_val(), utxx::time_val());
+    }
+    double sec = (utxx::now_utc() - from).seconds();
+
+    bool ok = (proc.m_errs == 0) && (!a_complete || proc.m_n == a_n);
+    cout << "  " << setw(6) << a_title << ": "    << setw(6)
+         << (sec * 1e9 / double(a_stream.size())) << " ns/Put, Processed="
+         << proc.m_n << ", Calls=" << proc.m_calls
+         << (ok ? "" : "  *** FAILED ***") << endl;
+    return ok;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NItems]:
+  long n = (argc >= 2) ? atol(argv[1]) : 10000000;
+  if (n <= 0)
+  {
+    cerr << "PARAMETERS: [NItems]" << endl;
+    return 1;
+  }
+  shared_ptr<spdlog::logger> logger =
+    IO::MkLogger("SeqNumBufferBench_Logger", "stderr");
+
+  Pattern const patterns[]
+  {
+    { "A only, in order",         false, 0.0,  0.0   },
+    { "A only, reordered",        false, 0.05, 0.0   },
+    { "A/B, in order",            true,  0.0,  0.0   },
+    { "A/B, reordered",           true,  0.05, 0.0   },
+    { "A/B, losses",              true,  0.0,  0.01  },
+    { "A/B, reordered + losses",  true,  0.05, 0.01  }
+  };
+
+  mt19937_64 rng(12345);
+  bool       ok = true;
+  cout << fixed << setprecision(2);
+
+  for (Pattern const& pat: patterns)
+  {
+    vector<SeqNum> stream = MkStream(pat, n, &rng);
+
+    // The output can only be complete if no SeqNum was lost in both Chnls:
+    vector<SeqNum> sorted(stream);
+    sort(sorted.begin(), sorted.end());
+    bool complete =
+      (unique(sorted.begin(), sorted.end()) - sorted.begin()) == n;
+
+    cout << pat.m_name << ": Puts=" << stream.size()
+         << (complete ? "" : " (with losses)") << endl;
+    ok &= Run<ItemProc> ("Item",  stream, n, complete, logger.get());
+    ok &= Run<BatchProc>("Batch", stream, n, complete, logger.get());
+  }
+  if (!ok)
+  {
+    cerr << "SeqNumBufferBench FAILED" << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,201 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tests/URingBench.cpp":                          //
+//   Loopback TCP Ping-Pong Benchmark: EPoll vs io_uring in EPollReactor     //
+//===========================================================================//
+#include "Basis/EPollReactor.h"
+#include "Basis/IOUtils.hpp"
+#include "QuantSupport/HistoGram.hpp"
+#include <utxx/time_val.hpp>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace MAQUETTE;
+using namespace std;
+
+namespace
+{
+  //=========================================================================//
+  // "EchoServer":                                                           //
+  //=========================================================================//
+  // Blocking, single-connection echo server, run in a separate thread. The
+  // listening socket is created by the Caller, so there is no race with the
+  // Client's "Connect":
+  //
+  void EchoServer(int a_lfd)
+  {
+    int sfd = accept(a_lfd, nullptr, nullptr);
+    if (sfd < 0)
+      return;
+    int one = 1;
+    (void) setsockopt(sfd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    char buff[65536];
+    while (true)
+    {
+      ssize_t n = read(sfd, buff, sizeof(buff));
+      if (n <= 0)
+        break;
+      for (ssize_t off = 0; off < n; )
+      {
+        ssize_t m = write(sfd, buff + off, size_t(n - off));
+        if (m <= 0)
+          break;
+        off += m;
+      }
+    }
+    close(sfd);
+  }
+
+  //=========================================================================//
+  // "MkListener":                                                           //
+  //=========================================================================//
+  int MkListener(int a_port)
+  {
+    int lfd = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    (void) setsockopt(lfd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    sockaddr_in addr;
+    memset(&addr, '\0', sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_port        = htons(uint16_t(a_port));
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    if (bind(lfd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 ||
+        listen(lfd, 1) < 0)
+      IO::SystemError(-1, "MkListener: Port=", a_port);
+    return lfd;
+  }
+
+  //=========================================================================//
+  // "RunOnce":                                                              //
+  //=========================================================================//
+  // Sends "a_n" msgs of "a_sz" bytes one at a time, each one after the prev
+  // one has been echoed back, and measures the Round-Trip Time:
+  //
+  void RunOnce
+  (
+    spdlog::logger* a_logger,
+    bool            a_use_io_uring,
+    int             a_port,
+    long            a_n,
+    int             a_sz
+  )
+  {
+    char const* mode = a_use_io_uring ? "io_uring" : "EPoll";
+    EPollReactor reactor
+      (a_logger, 1, false, false, 1024, -1, a_use_io_uring);
+
+    int    lfd = MkListener(a_port);
+    thread server(EchoServer, lfd);
+
+    QuantSupport::HistoGram<20> rtts
+      (string("Round-Trip Time (usec), ") + mode, 0.0, 100.0);
+
+    long           nRecv = 0;
+    utxx::time_val from, to, sent;
+    vector<char>   msg(size_t(a_sz), 'x');
+    int            cfd   = -1;
+
+    auto sendNext = [&]()
+    {
+      sent = utxx::now_utc();
+      (void) reactor.Send(msg.data(), a_sz, cfd);
+    };
+
+    IO::FDInfo::ConnectHandler onConnect
+    (
+      [&](int a_fd)
+      {
+        int one = 1;
+        (void) setsockopt(a_fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        from = utxx::now_utc();
+        sendNext();
+      }
+    );
+    IO::FDInfo::ReadHandler onRead
+    (
+      [&](int, char const*, int a_size, utxx::time_val) -> int
+      {
+        // Wait until the whole msg has been echoed back:
+        if (a_size < a_sz)
+          return 0;
+
+        utxx::time_val now = utxx::now_utc();
+        rtts.Update(double((now - sent).nanoseconds()) / 1000.0);
+
+        if (++nRecv == a_n)
+        {
+          to = now;
+          reactor.ExitImmediately("RunOnce: All Received");
+        }
+        sendNext();
+        return a_sz;
+      }
+    );
+    IO::FDInfo::ErrHandler onErr
+    (
+      [](int a_fd, int a_err_code, uint32_t, char const* a_msg)
+      {
+        cerr << "ERROR: FD=" << a_fd << ", ErrCode=" << a_err_code << ": "
+             << a_msg << endl;
+      }
+    );
+
+    cfd = reactor.AddDataStream
+      ("BenchTX", -1, onRead, onConnect, onErr, 65536, 1024, 65536, 1024);
+    reactor.Connect(cfd, "127.0.0.1", a_port);
+    reactor.Run(true);
+
+    // Closing the Client socket terminates the Server:
+    reactor.Remove(cfd);
+    close(cfd);
+    server.join();
+    close(lfd);
+
+    double secs = (to - from).seconds();
+    cout << rtts << mode << ": " << nRecv << " Msgs in " << secs << " sec: "
+         << ((secs > 0.0) ? (double(nRecv) / secs) : 0.0) << " msgs/sec\n"
+         << endl;
+  }
+}
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  // Params: [NMsgs [MsgSize]]:
+  long n  = (argc >= 2) ? atol(argv[1]) : 200000;
+  int  sz = (argc >= 3) ? atoi(argv[2]) : 64;
+
+  if (n <= 0 || sz <= 0 || sz > 16384)
+  {
+    cerr << "PARAMETERS: [NMsgs [MsgSize]]" << endl;
+    return 1;
+  }
+  try
+  {
+    IO::GlobalInit({SIGINT});
+    shared_ptr<spdlog::logger> loggerShP =
+      IO::MkLogger("URingBench", "stderr");
+
+    RunOnce(loggerShP.get(), false, 31011, n, sz);   // EPoll
+    RunOnce(loggerShP.get(), true,  31012, n, sz);   // io_uring
+  }
+  catch (exception const& exc)
+  {
+    cerr << "EXCEPTION: " << exc.what() << endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,49 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Tools/BinLogDecode.cpp":                        //
+//       Formats Binary Log Files (written by "binlog:" loggers) as Text     //
+//===========================================================================//
+// Usage: BinLogDecode BinLogFile...
+// The text goes to stdout, in the same format as that of the file loggers,
+// in the order of the files given:
+//
+#include "Basis/BinLog.h"
+#include <iostream>
+#include <fstream>
+
+using namespace std;
+using namespace MAQUETTE;
+
+//===========================================================================//
+// "main":                                                                   //
+//===========================================================================//
+int main(int argc, char* argv[])
+{
+  if (argc < 2)
+  {
+    cerr << "PARAMETERS: BinLogFile..." << endl;
+    return 1;
+  }
+  int rc = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    ifstream in(argv[i], ios::in | ios::binary);
+    if (!in)
+    {
+      cerr << "ERROR: Cannot open " << argv[i] << endl;
+      rc = 1;
+      continue;
+    }
+    try
+    {
+      BinLog::Decode(in, cout);
+    }
+    catch (exception const& exc)
+    {
+      cout.flush();
+      cerr << "EXCEPTION: " << argv[i] << ": " << exc.what() << endl;
+      rc = 1;
+    }
+  }
+  return rc;
+}
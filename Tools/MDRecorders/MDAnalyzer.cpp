@@ -47,7 +47,7 @@ int main(int argc, char *argv[]) {
   printf("# %18s  %12s  %10s  %16s  %16s  %16s  %16s\n", "Time [frac of day]",
          "Latency [us]", "Spread", "Bid", "Ask", "Bid size", "Ask size");
 
-  using Reader = MDStoreReader<MDRecL1>;
+  using Reader = MDStoreMMapReader<MDRecL1>;
   Reader mds(md_store_root, venue, symbol, "ob_L1");
   Reader::MDStoreRecord last_rec;
 
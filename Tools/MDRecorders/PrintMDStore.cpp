@@ -58,7 +58,7 @@ int main(int argc, char *argv[]) {
     printf("# %24s  %10s  %12s  %10s  %10s  %12s  %12s\n", "Date/time",
            "Spread", "Spread [bp]", "Bid", "Ask", "Bid size", "Ask size");
 
-    using Reader = MDStoreReader<MDRecL1>;
+    using Reader = MDStoreMMapReader<MDRecL1>;
     Reader mds(md_store_root, venue, symbol, "ob_L1");
     Reader::MDStoreRecord last_rec;
 
@@ -98,7 +98,7 @@ int main(int argc, char *argv[]) {
     printf("# %24s  %10s  %12s  %s\n", "Date/time", "Price", "Size",
            "Aggressor");
 
-    using Reader = MDStoreReader<MDAggression>;
+    using Reader = MDStoreMMapReader<MDAggression>;
     Reader mds(md_store_root, venue, symbol, "trades");
 
     char fmt[128];
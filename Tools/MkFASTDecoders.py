@@ -0,0 +1,485 @@
+#! /usr/bin/python3 -O
+#============================================================================#
+#                          "Tools/MkFASTDecoders.py":                        #
+#     Generates C++ FAST Decoders from FAST 1.1 XML Templates (at Build)     #
+#============================================================================#
+# Usage:
+#   MkFASTDecoders.py TemplatesXML OutputHPP Namespace
+#
+# For each <template>, emits a function template
+#   "Decode<Name>(Msg* msg, char const* buff, char const* end, PMap pmap)"
+# into "MAQUETTE::FAST::<Namespace>::Generated", where "Msg" is the (existing)
+# Msg struct to be filled in, eg "FAST::FORTS::OrdersLogIncrRefresh<Curr>".
+# XML fld "X" is decoded into "Msg::m_X"; if there is no such NON-STATIC data
+# member in "Msg", the fld is skipped (SkipVal=true) -- so unused flds can be
+# made static or removed from the Msg types. A <sequence> "S" is decoded into
+# "Msg::m_S" (a C array or a vector-like container), its <length> "L" into
+# "Msg::m_L".
+# Unlike the hand-written decoders (see "Protocols/FAST/Macros.h"), the PMap
+# bit positions and operators are resolved here, so the generated code only
+# contains compile-time constants.
+# Operator semantics are the same as in the hand-written decoders: the Dict-
+# ionary is reset for each msg, ie "copy", "increment" and "delta" refer to the
+# prev entry of the same Sequence, or to the initial value for the 1st entry
+# and for top-level flds. Decimals are "old-style" (single-fld). Not supported:
+# <group>, <templateRef>, "tail", and per-component Decimal operators:
+#
+import sys
+import os
+import xml.etree.ElementTree as ET
+from decimal import Decimal
+
+#============================================================================#
+# Types:                                                                     #
+#============================================================================#
+IntTypes = { "int32":  "int32_t", "uInt32": "uint32_t",
+             "int64":  "int64_t", "uInt64": "uint64_t" }
+Ops      = [ "constant", "copy", "default", "delta", "increment", "tail" ]
+
+class Fld:
+  def __init__(self):
+    self.kind     = None  # "int", "dec", "ascii", "bytes", "seq"
+    self.xtype    = None  # XML tag
+    self.name     = None
+    self.fid      = None
+    self.optional = False
+    self.op       = None  # None (NoOp) or one of "Ops"
+    self.value    = None  # Const / Initial / Default value (string)
+    self.bit      = None  # PMap bit number, if any
+    self.length   = None  # For Sequences: the length Fld
+    self.flds     = []    # For Sequences: Entry Flds
+    self.hasPMap  = False # For Sequences: Entries have their own PMaps
+
+  def Nullable(self):
+    return self.optional and self.op != "constant"
+
+  def HasPMapBit(self):
+    if self.op is None or self.op == "delta":
+      return False
+    if self.op == "constant":
+      return self.optional
+    return True
+
+def Error(msg):
+  sys.stderr.write("MkFASTDecoders: ERROR: " + msg + "\n")
+  sys.exit(1)
+
+def Tag(elem):
+  return elem.tag.split("}")[-1]
+
+def Ident(name):
+  return "".join(c if c.isalnum() or c == "_" else "_" for c in name)
+
+#============================================================================#
+# Parsing:                                                                   #
+#============================================================================#
+def ParseFld(elem, where):
+  tag = Tag(elem)
+  f   = Fld()
+  f.xtype    = tag
+  f.name     = Ident(elem.get("name", ""))
+  f.fid      = elem.get("id")
+  f.optional = (elem.get("presence", "mandatory") == "optional")
+  if not f.name:
+    Error(where + ": Unnamed <" + tag + ">")
+  where += "." + f.name
+
+  if tag in IntTypes:
+    f.kind = "int"
+  elif tag == "decimal":
+    f.kind = "dec"
+  elif tag == "string":
+    f.kind = "bytes" if elem.get("charset") == "unicode" else "ascii"
+  elif tag == "byteVector":
+    f.kind = "bytes"
+  elif tag == "sequence":
+    f.kind = "seq"
+    children = list(elem)
+    if not children or Tag(children[0]) != "length":
+      Error(where + ": <sequence> without <length>")
+    ln = children[0]
+    f.length          = Fld()
+    f.length.kind     = "int"
+    f.length.xtype    = "uInt32"
+    f.length.name     = Ident(ln.get("name", "No" + f.name))
+    f.length.fid      = ln.get("id")
+    f.length.optional = f.optional
+    if list(ln):
+      Error(where + ": Operators on <length> are not supported")
+    f.flds = [ParseFld(c, where) for c in children[1:]]
+    AssignPMapBits(f.flds, 0, where)
+    f.hasPMap = any(c.bit is not None for c in f.flds)
+    return f
+  else:
+    Error(where + ": Unsupported element <" + tag + ">")
+
+  # Operator (if any):
+  for c in elem:
+    op = Tag(c)
+    if op in ("exponent", "mantissa"):
+      Error(where + ": Per-component Decimal operators are not supported")
+    if op not in Ops:
+      Error(where + ": Unknown operator <" + op + ">")
+    if op == "tail":
+      Error(where + ": <tail> operator is not supported")
+    f.op    = op
+    f.value = c.get("value")
+  if f.op == "constant" and f.value is None:
+    Error(where + ": <constant> without a value")
+  if f.op == "increment" and f.kind != "int":
+    Error(where + ": <increment> is for Integers only")
+  if f.op == "delta" and f.kind == "bytes":
+    Error(where + ": <delta> is not supported for byte vectors")
+  return f
+
+def AssignPMapBits(flds, init, where):
+  bit = init
+  for f in flds:
+    if f.HasPMapBit():
+      # NB: "GetPMapBit" only supports bits 0..62:
+      if bit > 62:
+        Error(where + ": Too many PMap bits")
+      f.bit = bit
+      bit  += 1
+
+#============================================================================#
+# Code Generation:                                                           #
+#============================================================================#
+def CLit(f, val):
+  # Literal for a Const / Initial / Default value (an expr or a string):
+  if f.kind == "int":
+    return str(int(val))
+  if f.kind == "dec":
+    t = Decimal(val).as_tuple()
+    m = int("".join(map(str, t.digits)) or "0")
+    return "Decimal(%d, %s%d)" % (t.exponent, "-" if t.sign else "", m)
+  return '"' + val.replace("\\", "\\\\").replace('"', '\\"') + '"'
+
+class Gen:
+  def __init__(self):
+    self.out = []
+
+  def Put(self, ind, line):
+    self.out.append(" " * ind + line if line else "")
+
+  # "Read": Stmt reading the fld value into "dst" ("skip" for SkipVal=true):
+  def Read(self, ind, f, dst, nullable=None):
+    nl   = "true" if (f.Nullable() if nullable is None else nullable) \
+           else "false"
+    skip = (dst is None)
+    sv   = "true" if skip else "false"
+    nm   = '"' + f.name + '"'
+    if f.kind == "int":
+      d = "&skip_int" if skip else dst
+      self.Put(ind, "a_buff = GetInteger<%s>" % sv)
+      self.Put(ind, "         (%s, a_buff, a_end, %s, &is_null," % (nl, d))
+      self.Put(ind, "          %s, nullptr);" % nm)
+    elif f.kind == "dec":
+      d = "&skip_dec" if skip else dst
+      self.Put(ind, "a_buff = GetOldDecimal<%s>" % sv)
+      self.Put(ind, "         (%s, a_buff, a_end, %s, &is_null," % (nl, d))
+      self.Put(ind, "          %s);" % nm)
+    else:
+      fn = "GetByteVec" if f.kind == "bytes" else \
+           ("GetASCIIDelta" if f.op == "delta" else "GetASCII")
+      if skip:
+        d, sz = "&skip_str", "INT_MAX"
+      else:
+        d  = dst
+        sz = "int(sizeof(%s))%s" % (dst, " - 1" if f.kind == "bytes" else "")
+      self.Put(ind, "a_buff = %s<%s>" % (fn, sv))
+      self.Put(ind, "         (%s, a_buff, a_end, %s," % (nl, d))
+      self.Put(ind, "          %s, &act_len, &is_null, %s);" % (sz, nm))
+
+  def Assign(self, ind, f, lhs, rhs):
+    if f.kind in ("ascii", "bytes"):
+      self.Put(ind, "StrNCpy<true>(%s, %s);" % (lhs, rhs))
+    else:
+      self.Put(ind, "%s = %s;" % (lhs, rhs))
+
+  def Clear(self, ind, f, lhs):
+    if f.kind == "int":
+      self.Put(ind, "%s = 0;" % lhs)
+    elif f.kind == "dec":
+      self.Put(ind, "%s.Reset();" % lhs)
+    else:
+      self.Put(ind, "%s[0] = '\\0';" % lhs)
+
+  def InitOrClear(self, ind, f, lhs):
+    if f.value is not None:
+      self.Assign(ind, f, lhs, CLit(f, f.value))
+    else:
+      self.Clear(ind, f, lhs)
+
+  # "Absent": Value of a fld with a PMap bit which is not present:
+  def Absent(self, ind, f, lhs, prev, in_seq):
+    if f.op == "constant" or (f.op == "default" and f.value is None):
+      # Optional Const not present, or Default w/o value: NULL:
+      self.Clear(ind, f, lhs)
+    elif f.op == "default":
+      self.Assign(ind, f, lhs, CLit(f, f.value))
+    elif not in_seq:
+      # "copy" or "increment" at top level: the Dictionary is reset:
+      self.InitOrClear(ind, f, lhs)
+    else:
+      self.Put(ind, "if (utxx::likely(i > 0))")
+      if f.op == "copy":
+        self.Assign(ind + 2, f, lhs, prev)
+      else:
+        self.Put(ind + 2, "%s = GenAddDelta(%s, 1);" % (lhs, prev))
+      self.Put(ind, "else")
+      self.InitOrClear(ind + 2, f, lhs)
+
+  def Delta(self, ind, f, lhs, prev, in_seq):
+    init = CLit(f, f.value) if f.value is not None else None
+    if f.kind == "int":
+      self.Put(ind, "using T = std::remove_reference_t<decltype(%s)>;" % lhs)
+      self.Put(ind, "int64_t delta = 0;")
+      self.Read(ind, f, "&delta")
+      base = "T(%s)" % (init or "0")
+      if in_seq:
+        base = "(utxx::likely(i > 0) ? %s : %s)" % (prev, base)
+      self.Put(ind, "%s = GenAddDelta(%s, delta);" % (lhs, base))
+    elif f.kind == "dec":
+      self.Put(ind, "Decimal delta;")
+      self.Read(ind, f, "&delta")
+      base = init or "Decimal()"
+      if in_seq:
+        base = "(utxx::likely(i > 0) ? %s : %s)" % (prev, base)
+      self.Put(ind, "%s  = %s;" % (lhs, base))
+      self.Put(ind, "%s += delta;" % lhs)
+    else:
+      base = init or '""'
+      if in_seq:
+        base = "(utxx::likely(i > 0) ? %s : %s)" % (prev, base)
+      self.Put(ind, "StrNCpy<true>(%s, %s);" % (lhs, base))
+      self.Read(ind, f, lhs)
+
+  # "Scalar": A non-Sequence fld:
+  def Scalar(self, ind, f, mtype, pmap, in_seq):
+    mem  = "m_" + f.name
+    lhs  = "msg." + mem
+    prev = "prev->" + mem
+    desc = "%s (%s): %s, %s, %s" % \
+           (f.name, f.fid or "-", f.xtype,
+            "optional" if f.optional else "mandatory",
+            f.op or "NoOp")
+    if f.bit is not None:
+      desc += ", PMap bit %d" % f.bit
+    self.Put(ind, "// " + desc + ":")
+
+    # Mandatory Consts are not in the stream at all:
+    if f.op == "constant" and not f.optional:
+      self.Put(ind, "if constexpr (FAST_GEN_HAS(%s, %s))" % (mtype, mem))
+      self.Assign(ind + 2, f, lhs, CLit(f, f.value))
+      return
+
+    dst = "msg." + mem if f.kind in ("ascii", "bytes") else "&msg." + mem
+    cond = "GetPMapBit(%s, %d)" % (pmap, f.bit) if f.bit is not None \
+           else None
+
+    self.Put(ind, "if constexpr (FAST_GEN_HAS(%s, %s))" % (mtype, mem))
+    self.Put(ind, "{")
+    i2 = ind + 2
+    if f.op == "constant":
+      # Optional Const: the PMap bit tells whether it is present:
+      self.Put(i2, "if (%s)" % cond)
+      self.Assign(i2 + 2, f, lhs, CLit(f, f.value))
+      self.Put(i2, "else")
+      self.Clear(i2 + 2, f, lhs)
+    elif f.op == "delta":
+      self.Delta(i2, f, lhs, prev, in_seq)
+    elif cond is not None:
+      self.Put(i2, "if (%s)" % cond)
+      self.Put(i2, "{")
+      self.Read(i2 + 2, f, dst)
+      self.Put(i2, "}")
+      self.Put(i2, "else")
+      self.Put(i2, "{")
+      self.Absent(i2 + 2, f, lhs, prev, in_seq)
+      self.Put(i2, "}")
+    else:
+      self.Read(i2, f, dst)
+    self.Put(ind, "}")
+
+    # Skipped fld: only advance the buffer ptr:
+    if f.op == "constant":
+      return
+    self.Put(ind, "else")
+    if cond is not None:
+      self.Put(ind + 2, "if (%s)" % cond)
+      self.Read(ind + 4, f, None)
+    else:
+      self.Read(ind + 2, f, None)
+
+  # "Sequence": Length and the loop over Entries:
+  def Sequence(self, ind, f, mtype, fname):
+    ln = f.length
+    self.Put(ind, "// Sequence %s: Length %s (%s), %s:" %
+             (f.name, ln.name, ln.fid or "-",
+              "optional" if f.optional else "mandatory"))
+    self.Put(ind, "{")
+    i2 = ind + 2
+    self.Put(i2, "uint32_t n = 0;")
+    self.Read(i2, ln, "&n")
+    self.Put(i2, "if constexpr (FAST_GEN_HAS(%s, m_%s))" % (mtype, ln.name))
+    self.Put(i2, "  msg.m_%s =" % ln.name)
+    self.Put(i2, "    std::remove_reference_t<decltype(msg.m_%s)>(n);" %
+             ln.name)
+    self.Put(i2, "if constexpr (FAST_GEN_HAS(%s, m_%s))" % (mtype, f.name))
+    self.Put(i2, "{")
+    self.Put(i2 + 2, "auto* es = GenSeqEntries(msg.m_%s, n, \"%s\");" %
+             (f.name, f.name))
+    self.Put(i2 + 2, "for (uint32_t i = 0; i < n; ++i)")
+    self.Put(i2 + 2, "  a_buff = %s" % fname)
+    self.Put(i2 + 2,
+             "           (es + i, (i > 0) ? (es + i - 1) : nullptr, i,")
+    self.Put(i2 + 2, "            a_buff, a_end);")
+    self.Put(i2, "}")
+    self.Put(i2, "else")
+    self.Put(i2, "{")
+    self.Put(i2 + 2, "GenSkipEntry skip;")
+    self.Put(i2 + 2, "for (uint32_t i = 0; i < n; ++i)")
+    self.Put(i2 + 2, "  a_buff = %s<GenSkipEntry>" % fname)
+    self.Put(i2 + 2, "           (&skip, nullptr, i, a_buff, a_end);")
+    self.Put(i2, "}")
+    self.Put(ind, "}")
+
+  def Locals(self, ind):
+    self.Put(ind, "[[maybe_unused]] bool     is_null  = false;")
+    self.Put(ind, "[[maybe_unused]] int      act_len  = 0;")
+    self.Put(ind, "[[maybe_unused]] uint64_t skip_int = 0;")
+    self.Put(ind, "[[maybe_unused]] Decimal  skip_dec;")
+    self.Put(ind, "[[maybe_unused]] char     skip_str = '\\0';")
+
+  def Body(self, ind, flds, mtype, pmap, in_seq, fprefix):
+    for f in flds:
+      self.Put(0, "")
+      if f.kind == "seq":
+        self.Sequence(ind, f, mtype, fprefix + "_" + f.name)
+      else:
+        self.Scalar(ind, f, mtype, pmap, in_seq)
+
+  # "Entry": Decoder for a single Sequence Entry (generated before its user):
+  def Entry(self, f, fname):
+    for c in f.flds:
+      if c.kind == "seq":
+        self.Entry(c, fname + "_" + c.name)
+    Banner(self, '"%s": Entry of Sequence "%s":' % (fname, f.name))
+    self.Put(2, "template<typename E>")
+    self.Put(2, "inline char const* %s" % fname)
+    self.Put(2, "(")
+    self.Put(2, "  E*                         a_entry,")
+    self.Put(2, "  [[maybe_unused]] E const*  prev,")
+    self.Put(2, "  [[maybe_unused]] uint32_t  i,")
+    self.Put(2, "  char const*                a_buff,")
+    self.Put(2, "  char const*                a_end")
+    self.Put(2, ")")
+    self.Put(2, "{")
+    self.Put(4, "assert(a_entry != nullptr && a_buff < a_end);")
+    self.Put(4, "[[maybe_unused]] E& msg = *a_entry;")
+    self.Locals(4)
+    if f.hasPMap:
+      self.Put(0, "")
+      self.Put(4, "// This Entry has its own PMap:")
+      self.Put(4, "PMap pmap = 0;")
+      self.Put(4, "a_buff = GetMsgHeader(a_buff, a_end, &pmap, nullptr, "
+                  "\"%s\");" % f.name)
+    self.Body(4, f.flds, "E", "pmap", True, fname)
+    self.Put(4, "return a_buff;")
+    self.Put(2, "}")
+    self.Put(0, "")
+
+  def Template(self, name, tid, flds):
+    fname = "Decode" + name
+    for f in flds:
+      if f.kind == "seq":
+        self.Entry(f, fname + "_" + f.name)
+    Banner(self, '"%s" (TID=%s):' % (fname, tid))
+    self.Put(2, "constexpr TID %sTID = %s;" % (name, tid))
+    self.Put(0, "")
+    self.Put(2, "template<typename Msg>")
+    self.Put(2, "inline char const* %s" % fname)
+    self.Put(2, "(")
+    self.Put(2, "  Msg*                        a_msg,")
+    self.Put(2, "  char const*                 a_buff,")
+    self.Put(2, "  char const*                 a_end,")
+    self.Put(2, "  [[maybe_unused]] PMap       a_pmap")
+    self.Put(2, ")")
+    self.Put(2, "{")
+    self.Put(4, "assert(a_msg != nullptr && a_buff != nullptr && "
+                "a_buff < a_end);")
+    self.Put(4, "[[maybe_unused]] Msg& msg = *a_msg;")
+    self.Locals(4)
+    self.Body(4, flds, "Msg", "a_pmap", False, fname)
+    self.Put(4, "return a_buff;")
+    self.Put(2, "}")
+    self.Put(0, "")
+
+def Banner(g, text):
+  g.Put(2, "//" + "=" * 73 + "//")
+  g.Put(2, "// " + text.ljust(72) + "//")
+  g.Put(2, "//" + "=" * 73 + "//")
+
+def Centered(text):
+  return "//" + text.center(75) + "//"
+
+#============================================================================#
+# "main":                                                                    #
+#============================================================================#
+if len(sys.argv) != 4:
+  sys.stderr.write("PARAMETERS: TemplatesXML OutputHPP Namespace\n")
+  sys.exit(1)
+
+xmlFile, outFile, ns = sys.argv[1:]
+root = ET.parse(xmlFile).getroot()
+g    = Gen()
+
+for t in root:
+  if Tag(t) != "template":
+    continue
+  name = Ident(t.get("name", ""))
+  tid  = t.get("id")
+  if not name or tid is None:
+    Error(xmlFile + ": <template> without name or id")
+  flds = [ParseFld(c, name) for c in t if Tag(c) != "typeRef"]
+  # Top-level PMap bits start from 1 (bit 0 is for the TemplateID):
+  AssignPMapBits(flds, 1, name)
+  g.Template(name, tid, flds)
+
+hdr = "Protocols/FAST/" + os.path.basename(outFile)
+src = os.path.basename(xmlFile)
+head = [
+  "// vim:ts=2:et",
+  "//" + "=" * 75 + "//",
+  Centered('"' + hdr + '":'),
+  Centered('FAST Decoders for ' + ns + ' Generated from "' + src + '"'),
+  "//" + "=" * 75 + "//",
+  "// XXX: GENERATED by \"Tools/MkFASTDecoders.py\" -- DO NOT EDIT!",
+  "//",
+  "#pragma  once",
+  "",
+  "#include \"Protocols/FAST/GenSupport.hpp\"",
+  "#include <type_traits>",
+  "#include <climits>",
+  "#include <cstdint>",
+  "#include <cassert>",
+  "",
+  "namespace MAQUETTE",
+  "{",
+  "namespace FAST",
+  "{",
+  "namespace " + ns,
+  "{",
+  "namespace Generated",
+  "{"
+]
+tail = [
+  "} // End namespace Generated",
+  "} // End namespace " + ns,
+  "} // End namespace FAST",
+  "} // End namespace MAQUETTE"
+]
+os.makedirs(os.path.dirname(os.path.abspath(outFile)), exist_ok=True)
+with open(outFile, "w") as f:
+  f.write("\n".join(head + g.out + tail) + "\n")
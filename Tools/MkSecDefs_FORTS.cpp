@@ -9,6 +9,7 @@
 #include "Connectors/SSM_Channel.hpp"
 #include "Venues/FORTS/SecDefs.h"
 #include "Venues/FORTS/Configs_FAST.h"
+#include "Basis/SecDefsCatalog.h"
 #include <cstdlib>
 #include <cassert>
 
@@ -38,6 +39,7 @@ namespace FORTS
     AssetClassT const                 m_ac;
     mutable SecurityDefinition<Ver>   m_secDef;     // FAST msgs parsed here!
     mutable int                       m_round;
+    std::vector<SecDefS>              m_secDefsS;   // For a binary Catalog
 
     // Default Ctor is deleted:
     SecDefsCh() = delete;
@@ -78,7 +80,8 @@ namespace FORTS
       // partially-complete "SecurityDefinition"s (not starting from SeqNum=1);
       // Round=1 is the first complete round starting from SeqNum=1; after that,
       // we exit, so there should be no Rounds >= 2:
-      m_round(0)
+      m_round   (0),
+      m_secDefsS()
     {}
 
     //=======================================================================//
@@ -90,6 +93,11 @@ namespace FORTS
       m_round = 0;
     }
 
+    //=======================================================================//
+    // "GetSecDefsS": All "SecDefS"s received (in Round=1):                  //
+    //=======================================================================//
+    std::vector<SecDefS> const& GetSecDefsS() const { return m_secDefsS; }
+
     //=======================================================================//
     // "RecvHandler":                                                        //
     //=======================================================================//
@@ -341,6 +349,18 @@ namespace FORTS
         << "  \"" << underSym            << "\"\n"        // UnderlyingSymbol
         << "},"   << endl;
 
+      // Also memoise the same "SecDefS" for the binary Catalog (if requested
+      // -- it is cheap anyway):
+      m_secDefsS.emplace_back
+      (
+        s.m_SecurityID,  s.m_Symbol,      s.m_SecurityAltID, s.m_SecurityDesc,
+        s.m_CFICode,     "FORTS",         sessID,            tenor,
+        "",              assetA,          s.m_Currency,      'A',
+        double(assetAQty),                1.0,               1,
+        s.m_MinPriceIncrement.m_val,      'C',               pointPx,
+        int(s.m_MaturityDate),            tenorTime,
+        s.m_StrikePrice.m_val,            underSecID,        underSym
+      );
       return true;  // Continue
     }
 
@@ -379,9 +399,13 @@ int main(int argc, char* argv[])
   using namespace FAST::FORTS;
 
   // Get the Command-Line Params:
-  if (argc != 4)
+  // If the optional "CatalogFile" is given, the "SecDefS"s are also written
+  // into it as a binary "SecDefsCatalog" (in addition to the C++ source out-
+  // put on stdout):
+  if (argc != 4 && argc != 5)
   {
-    cerr << "PARAMETERS: <EnvT (eg ProdF)> <Fut|Opt> <IFaceIP>" << endl;
+    cerr << "PARAMETERS: <EnvT (eg ProdF)> <Fut|Opt> <IFaceIP> [CatalogFile]"
+         << endl;
     return 1;
   }
 
@@ -390,6 +414,7 @@ int main(int argc, char* argv[])
   AssetClassT ac        = AssetClassT::from_string(argv[2]);
   ProtoVerT   ver       = ImpliedProtoVerT(env);
   string      ifaceIP   = argv[3];
+  string      catFile   = (argc == 5) ? argv[4] : "";
 
   // Initialise the Logger (simple -- synchronous logging on stderr):
   auto        loggerShP = IO::MkLogger("Main", "stderr");
@@ -411,6 +436,14 @@ int main(int argc, char* argv[])
     channel.Start();
     reactor.Run  (true);   // Exit on any unhandled exceptions
     channel.Stop ();
+
+    if (!catFile.empty())
+    {
+      string source = string("FORTS-") + argv[2] + "-" + argv[1];
+      SecDefsCatalog::Write(catFile, channel.GetSecDefsS(), source.data());
+      cerr << "Catalog written: " << catFile << ": "
+           << channel.GetSecDefsS().size() << " SecDefs" << endl;
+    }
   }
   else
   {
@@ -3,11 +3,13 @@
 //                             "Tools/StatsMDC.cpp":                         //
 //===========================================================================//
 #include "InfraStruct/PersistMgr.h"
-#include "Connectors/EConnector_MktData.h"
+#include "Connectors/EConnector.h"
+#include "Connectors/LatencyTrace.hpp"
 #include <utxx/compiler_hints.hpp>
 #include <utxx/error.hpp>
 #include <iostream>
 #include <cstring>
+#include <unistd.h>
 
 using namespace std;
 using namespace MAQUETTE;
@@ -18,41 +20,39 @@ namespace
   // "DisplayStatsGen":                                                      //
   //=========================================================================//
   // ST: FixedShM or FixedMMF
+  // The segment is mapped in RO mode, and the "LatencyTrace" is looked up w/o
+  // locking the segment, so the Connector process is not affected at all.  If
+  // "a_interval_sec" is positive, the Stats are re-displayed periodically:
   //
   template<typename ST>
   inline void DisplayStatsGen
   (
     char const*   a_seg_name,
-    unsigned long a_base_addr
+    unsigned long a_base_addr,
+    int           a_interval_sec
   )
   {
     // Map the segment in:
     PersistMgr<ST> PM(a_seg_name, a_base_addr, 0, nullptr);
 
-    // Get ptrs to all Stats:
-    using ECMD = EConnector_MktData;
-    constexpr char const* statNames[5]
-    {
-      ECMD::SocketStatsON (),
-      ECMD::ProcStatsON   (),
-      ECMD::UpdtStatsON   (),
-      ECMD::StratStatsON  (),
-      ECMD::OverAllStatsON()
-    };
-
-    for (unsigned i = 0; i < 5; ++i)
-    {
-      // Get the "LatencyStats" object ptr:
-      auto   res =
-        PM.GetSegm()->template find<ECMD::LatencyStats>(statNames[i]);
-      assert(res.second == 1);
+    // Get the "LatencyTrace" ptr:
+    auto res =
+      PM.GetSegm()->template find_no_lock<LatencyTrace>
+        (EConnector::LatencyTraceON());
 
-      ECMD::LatencyStats const* ls = res.first;
-      assert(ls != nullptr);
+    if (utxx::unlikely(res.first == nullptr || res.second != 1))
+      throw utxx::runtime_error
+            ("No LatencyTrace in the Segment: ", a_seg_name);
 
+    LatencyTrace const* lt = res.first;
+    do
+    {
       // Output the object:
-      cout << (*ls) << endl;
+      cout << (*lt) << endl;
+      if (a_interval_sec > 0)
+        sleep(unsigned(a_interval_sec));
     }
+    while (a_interval_sec > 0);
   }
 }
 //===========================================================================//
@@ -64,19 +64,22 @@ int main(int argc, char* argv[])
   // Get the Command-Line Args:                                              //
   //-------------------------------------------------------------------------//
   if (utxx::unlikely
-     ((argc != 2  && argc   != 3) ||
+     (argc < 2    || argc   >  4  ||
       strcmp(argv[1], "-h") == 0  || strcmp(argv[1], "--help") == 0))
   {
-    cerr << "PARAMETERS: {shm|mmf}:Name [BaseAddr]" << endl;
+    cerr << "PARAMETERS: {shm|mmf}:Name [BaseAddr [IntervalSec]]" << endl;
     return 1;
   }
 
   char const*   segName  = argv[1];
   unsigned long baseAddr =
-    (argc == 3)
+    (argc >= 3)
     ? strtoul(argv[2], nullptr, 16)
     : 0;        // Will use the default one
 
+  // Re-display the Stats every "interval" sec (0: only once):
+  int interval = (argc == 4) ? atoi(argv[3]) : 0;
+
   // Is it a ShM Segment Name or a File?
   bool isShM =  (strncmp(segName, "shm:", 4) == 0);
   bool isMMF =  (strncmp(segName, "mmf:", 4) == 0);
@@ -96,9 +99,9 @@ int main(int argc, char* argv[])
   try
   {
     if (isShM)
-      DisplayStatsGen<FixedShM>(segName, baseAddr);
+      DisplayStatsGen<FixedShM>(segName, baseAddr, interval);
     else
-      DisplayStatsGen<FixedMMF>(segName, baseAddr);
+      DisplayStatsGen<FixedMMF>(segName, baseAddr, interval);
   }
   catch (std::exception const& exc)
   {
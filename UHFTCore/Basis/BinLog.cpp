@@ -0,0 +1,714 @@
+// vim:ts=2:et
+//===========================================================================//
+//                             "Basis/BinLog.cpp":                           //
+//        Binary Deferred-Formatting Logger: Back-End Thread and Decoder     //
+//===========================================================================//
+#include "Basis/BinLog.h"
+#include <spdlog/sinks/base_sink.h>
+#include <spdlog/details/null_mutex.h>
+#include <utxx/error.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <istream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <time.h>
+
+using namespace std;
+
+namespace MAQUETTE
+{
+namespace BinLog
+{
+  std::atomic<uint64_t> g_generation(0);
+
+  namespace
+  {
+    //=======================================================================//
+    // Consts and File Layout:                                               //
+    //=======================================================================//
+    constexpr uint32_t RingSize    = 1U << 20;   // 1 MB per thread
+    constexpr uint16_t MaxChannels = 256;
+
+    // Each run of a process appends its own "Open" record to the file (which
+    // resets the fmt string IDs in the decoder), followed by a "Sync":
+    constexpr char     Magic[8]    = {'M', 'Q', 'T', 'B', 'L', 'O', 'G', '1'};
+
+    struct OpenHdr
+    {
+      char    m_magic[8];
+      double  m_ticksPerNs;
+      char    m_name[48];
+    };
+
+    int64_t UTCNanoSecs()
+    {
+      timespec ts;
+      clock_gettime(CLOCK_REALTIME, &ts);
+      return int64_t(ts.tv_sec) * 1'000'000'000L + ts.tv_nsec;
+    }
+
+    //=======================================================================//
+    // "Backend": Rings, Channels, fmt strings, and the drainer thread:      //
+    //=======================================================================//
+    class Backend
+    {
+    public:
+      // NB: The Backend is never destroyed (the "spdlog" registry, and so the
+      // Channel loggers, may well outlive it); it is stopped, and all files
+      // flushed, at exit:
+      static Backend& Get()
+      {
+        static Backend* s_backend = new Backend();
+        return *s_backend;
+      }
+
+      Backend()
+      : m_ticksPerNs(Calibrate()),
+        m_nChannels (0),
+        m_stop      (false),
+        m_flushReq  (0),
+        m_flushDone (0)
+      {
+        m_thread = thread(&Backend::Run, this);
+        atexit([] { Get().Stop(); });
+      }
+
+      //---------------------------------------------------------------------//
+      // Producers' Side (all rare):                                         //
+      //---------------------------------------------------------------------//
+      void AddRing(Ring* a_ring)
+      {
+        lock_guard<mutex> lock(m_lock);
+        m_rings.push_back(a_ring);
+      }
+
+      uint32_t Register
+        (CallSite* a_site, char const* a_fmt, size_t a_len, uint8_t a_level)
+      {
+        lock_guard<mutex> lock(m_lock);
+        uint32_t id = a_site->m_id.load(memory_order_relaxed);
+        if (id == 0)
+        {
+          m_sites.push_back
+            (Site{string(a_fmt, min<size_t>(a_len, MaxPayload)), a_level});
+          id = uint32_t(m_sites.size());
+          a_site->m_id.store(id, memory_order_release);
+        }
+        return id;
+      }
+
+      Channel* AddChannel(string const& a_name, string const& a_path)
+      {
+        lock_guard<mutex> lock(m_lock);
+        uint16_t id = m_nChannels.load(memory_order_relaxed);
+        if (utxx::unlikely(id == MaxChannels))
+          throw utxx::runtime_error("BinLog: Too many Channels");
+
+        FILE* file = fopen(a_path.c_str(), "ab");
+        if (utxx::unlikely(file == nullptr))
+          throw utxx::runtime_error("BinLog: Cannot open ", a_path);
+
+        Channel* ch  = new Channel;
+        ch->m_logger = nullptr;
+        ch->m_id     = id;
+        m_files.push_back(ChFile{ch, file, {}, true});
+
+        OpenHdr oh;
+        memset(&oh, '\0', sizeof(oh));
+        memcpy(oh.m_magic, Magic, sizeof(Magic));
+        oh.m_ticksPerNs = m_ticksPerNs;
+        strncpy(oh.m_name, a_name.c_str(), sizeof(oh.m_name) - 1);
+        Write(&m_files.back(), RecT::Open, 0, 0, Ticks(), &oh, sizeof(oh));
+        WriteSync(&m_files.back());
+
+        m_channels[id].store(ch, memory_order_relaxed);
+        m_nChannels.store(uint16_t(id + 1), memory_order_release);
+        return ch;
+      }
+
+      Channel const* Find(spdlog::logger const* a_logger) const
+      {
+        uint16_t n = m_nChannels.load(memory_order_acquire);
+        for (uint16_t i = 0; i < n; ++i)
+        {
+          Channel const* ch = m_channels[i].load(memory_order_relaxed);
+          if (ch->m_logger.load(memory_order_relaxed) == a_logger)
+            return ch;
+        }
+        return nullptr;
+      }
+
+      // Waits until everything logged before this call is written out:
+      void Flush()
+      {
+        uint64_t req = m_flushReq.fetch_add(1, memory_order_acq_rel) + 1;
+        while (m_flushDone.load(memory_order_acquire) < req &&
+               !m_stop.load(memory_order_acquire))
+          this_thread::sleep_for(chrono::microseconds(100));
+      }
+
+    private:
+      struct Site
+      {
+        string    m_fmt;
+        uint8_t   m_level;
+      };
+
+      struct ChFile
+      {
+        Channel*      m_ch;
+        FILE*         m_file;
+        vector<bool>  m_sites;    // Already written into this file
+        bool          m_dirty;
+      };
+
+      //---------------------------------------------------------------------//
+      // "Calibrate": Ticks per nsec:                                        //
+      //---------------------------------------------------------------------//
+      static double Calibrate()
+      {
+#       if defined(__x86_64__) || defined(__i386__)
+        int64_t  ns0 = UTCNanoSecs();
+        uint64_t tk0 = Ticks();
+        this_thread::sleep_for(chrono::milliseconds(10));
+        int64_t  ns1 = UTCNanoSecs();
+        uint64_t tk1 = Ticks();
+        return double(tk1 - tk0) / double(ns1 - ns0);
+#       else
+        return 1.0;   // "Ticks" are nsecs already
+#       endif
+      }
+
+      //---------------------------------------------------------------------//
+      // Back-End Thread:                                                    //
+      //---------------------------------------------------------------------//
+      void Run()
+      {
+        auto lastSync = chrono::steady_clock::now();
+        while (!m_stop.load(memory_order_acquire))
+        {
+          uint64_t req  = m_flushReq.load(memory_order_acquire);
+          bool     busy = DrainAll();
+
+          auto now = chrono::steady_clock::now();
+          if (now - lastSync >= chrono::seconds(1))
+          {
+            lock_guard<mutex> lock(m_lock);
+            for (ChFile& cf: m_files)
+              WriteSync(&cf);
+            lastSync = now;
+          }
+          if (!busy)
+          {
+            // All caught up: this is the only place where the files are
+            // flushed:
+            FlushFiles();
+            m_flushDone.store(req, memory_order_release);
+            this_thread::sleep_for(chrono::microseconds(200));
+          }
+        }
+      }
+
+      void Stop()
+      {
+        if (m_stop.exchange(true))
+          return;
+        m_thread.join();
+        DrainAll();
+        lock_guard<mutex> lock(m_lock);
+        for (ChFile& cf: m_files)
+          fclose(cf.m_file);
+        m_files.clear();
+      }
+
+      bool DrainAll()
+      {
+        lock_guard<mutex> lock(m_lock);
+        long n = 0;
+        for (size_t i = 0; i < m_rings.size(); )
+        {
+          Ring* ring    = m_rings[i];
+          bool  retired = ring->m_retired.load(memory_order_acquire);
+          n += ring->Drain([this](RecHdr const& a_rec) { Dispatch(a_rec); });
+
+          // Drops are not attributed to Channels, so they go into all files:
+          uint64_t drops = ring->TakeDrops();
+          if (utxx::unlikely(drops != 0))
+            for (ChFile& cf: m_files)
+              Write(&cf, RecT::Drops, 0, 0, Ticks(), &drops, sizeof(drops));
+
+          if (retired)
+          {
+            delete ring;
+            m_rings[i] = m_rings.back();
+            m_rings.pop_back();
+          }
+          else
+            ++i;
+        }
+        return n != 0;
+      }
+
+      void Dispatch(RecHdr const& a_rec)
+      {
+        assert(a_rec.m_channel < m_files.size());
+        ChFile& cf = m_files[a_rec.m_channel];
+
+        // Write the fmt string before its first Msg:
+        if (a_rec.m_kind == RecT::Msg)
+        {
+          uint32_t id = a_rec.m_site;
+          assert(0 < id && id <= m_sites.size());
+          if (cf.m_sites.size() <= id)
+            cf.m_sites.resize(id + 1, false);
+          if (!cf.m_sites[id])
+          {
+            Site const& site = m_sites[id - 1];
+            Write(&cf, RecT::Site, site.m_level, id, a_rec.m_ticks,
+                  site.m_fmt.data(), site.m_fmt.size());
+            cf.m_sites[id] = true;
+          }
+        }
+        fwrite(&a_rec, a_rec.m_size, 1, cf.m_file);
+        cf.m_dirty = true;
+      }
+
+      void Write
+      (
+        ChFile*     a_cf,
+        RecT        a_kind,
+        uint8_t     a_level,
+        uint32_t    a_site,
+        uint64_t    a_ticks,
+        void const* a_data,
+        size_t      a_len
+      )
+      {
+        RecHdr hdr;
+        hdr.m_size    = uint32_t(sizeof(RecHdr) + a_len + 7) & ~7U;
+        hdr.m_channel = a_cf->m_ch->m_id;
+        hdr.m_kind    = a_kind;
+        hdr.m_level   = a_level;
+        hdr.m_site    = a_site;
+        hdr.m_len     = uint32_t(a_len);
+        hdr.m_ticks   = a_ticks;
+
+        static char const zeros[8] = {};
+        fwrite(&hdr,   sizeof(hdr), 1, a_cf->m_file);
+        fwrite(a_data, a_len,       1, a_cf->m_file);
+        fwrite(zeros,  hdr.m_size - sizeof(hdr) - a_len, 1, a_cf->m_file);
+        a_cf->m_dirty = true;
+      }
+
+      void WriteSync(ChFile* a_cf)
+      {
+        uint64_t ticks = Ticks();
+        int64_t  ns    = UTCNanoSecs();
+        Write(a_cf, RecT::Sync, 0, 0, ticks, &ns, sizeof(ns));
+      }
+
+      void FlushFiles()
+      {
+        lock_guard<mutex> lock(m_lock);
+        for (ChFile& cf: m_files)
+          if (cf.m_dirty)
+          {
+            fflush(cf.m_file);
+            cf.m_dirty = false;
+          }
+      }
+
+      //---------------------------------------------------------------------//
+      // Data Flds:                                                          //
+      //---------------------------------------------------------------------//
+      double              const m_ticksPerNs;
+      mutex                     m_lock;       // Guards all flds below
+      vector<Ring*>             m_rings;
+      deque<Site>               m_sites;      // Site ID = idx + 1
+      deque<ChFile>             m_files;      // By Channel ID
+      // Lock-free view of the Channels, for "Find":
+      atomic<Channel*>          m_channels[MaxChannels];
+      atomic<uint16_t>          m_nChannels;
+      atomic<bool>              m_stop;
+      atomic<uint64_t>          m_flushReq;
+      atomic<uint64_t>          m_flushDone;
+      thread                    m_thread;
+    };
+
+    //=======================================================================//
+    // "RingHolder": Retires the thread's Ring on thread exit:               //
+    //=======================================================================//
+    struct RingHolder
+    {
+      Ring*   m_ring    = nullptr;
+      Ring**  m_slot    = nullptr;
+      bool    m_exiting = false;
+
+      ~RingHolder()
+      {
+        m_exiting = true;
+        if (m_ring != nullptr)
+        {
+          *m_slot = nullptr;
+          m_ring->m_retired.store(true, memory_order_release);
+        }
+      }
+    };
+    thread_local RingHolder t_ringHolder;
+
+    //=======================================================================//
+    // "Sink": For msgs which are formatted by "spdlog":                     //
+    //=======================================================================//
+    class Sink final:
+      public spdlog::sinks::base_sink<spdlog::details::null_mutex>
+    {
+    public:
+      explicit Sink(Channel* a_ch): m_ch(a_ch) {}
+
+      // The logger is being dropped, so its Channel is no longer found:
+      ~Sink() override
+      {
+        m_ch->m_logger.store(nullptr, memory_order_relaxed);
+        g_generation.fetch_add(1, memory_order_acq_rel);
+      }
+
+    protected:
+      void sink_it_(spdlog::details::log_msg const& a_msg) override
+        { LogText(m_ch, a_msg.level, a_msg.payload.data(),
+                  a_msg.payload.size()); }
+
+      // Flushing is done by the back-end thread:
+      void flush_() override {}
+
+    private:
+      Channel* m_ch;
+    };
+  }
+
+  //=========================================================================//
+  // "Ring":                                                                 //
+  //=========================================================================//
+  Ring::Ring(uint32_t a_size)
+  : m_retired  (false),
+    m_head     (0),
+    m_next     (0),
+    m_tailCache(0),
+    m_drops    (0),
+    m_tail     (0),
+    m_buff     (new char[a_size]),
+    m_size     (a_size),
+    m_mask     (a_size - 1)
+  {
+    if (utxx::unlikely(a_size < MaxRecSize || (a_size & (a_size - 1)) != 0))
+      throw utxx::badarg_error("BinLog::Ring: Invalid Size=", a_size);
+  }
+
+  Ring::~Ring()
+    { delete[] m_buff; }
+
+  //=========================================================================//
+  // Producers' Entry Points:                                                //
+  //=========================================================================//
+  Channel const* FindSlow(spdlog::logger const* a_logger)
+  {
+    // No Channels have been created yet, so do not start the Backend just to
+    // find that out:
+    return
+      (g_generation.load(memory_order_acquire) == 0)
+      ? nullptr
+      : Backend::Get().Find(a_logger);
+  }
+
+  Ring* NewRing(Ring** a_slot)
+  {
+    assert(a_slot != nullptr && *a_slot == nullptr);
+    if (utxx::unlikely(t_ringHolder.m_exiting))
+      return nullptr;
+
+    Ring* ring = new Ring(RingSize);
+    Backend::Get().AddRing(ring);
+    t_ringHolder.m_ring = ring;
+    t_ringHolder.m_slot = a_slot;
+    *a_slot             = ring;
+    return ring;
+  }
+
+  uint32_t Register
+  (
+    CallSite*                  a_site,
+    char const*                a_fmt,
+    size_t                     a_len,
+    spdlog::level::level_enum  a_level
+  )
+  {
+    assert(a_site != nullptr && a_fmt != nullptr);
+    return Backend::Get().Register(a_site, a_fmt, a_len, uint8_t(a_level));
+  }
+
+  void LogText
+  (
+    Channel const*             a_ch,
+    spdlog::level::level_enum  a_level,
+    char const*                a_msg,
+    size_t                     a_len
+  )
+  {
+    assert(a_ch != nullptr && a_msg != nullptr);
+    uint32_t len  = uint32_t(min<size_t>(a_len, MaxPayload));
+    uint32_t size = (uint32_t(sizeof(RecHdr)) + len + 7) & ~7U;
+
+    Ring* ring = ThisRing();
+    char* rec  = (ring != nullptr) ? ring->Reserve(size) : nullptr;
+    if (utxx::unlikely(rec == nullptr))
+      return;
+
+    RecHdr* hdr    = reinterpret_cast<RecHdr*>(rec);
+    hdr->m_size    = size;
+    hdr->m_channel = a_ch->m_id;
+    hdr->m_kind    = RecT::Text;
+    hdr->m_level   = uint8_t(a_level);
+    hdr->m_site    = 0;
+    hdr->m_len     = len;
+    hdr->m_ticks   = Ticks();
+    memcpy(rec + sizeof(RecHdr), a_msg, len);
+    ring->Commit();
+  }
+
+  //=========================================================================//
+  // "MkLogger":                                                             //
+  //=========================================================================//
+  shared_ptr<spdlog::logger> MkLogger
+    (string const& a_name, string const& a_path)
+  {
+    if (utxx::unlikely(a_name.empty() || a_path.empty()))
+      throw utxx::badarg_error("BinLog::MkLogger: Invalid arg(s)");
+
+    Channel* ch     = Backend::Get().AddChannel(a_name, a_path);
+    auto     logger = make_shared<spdlog::logger>
+                      (a_name, make_shared<Sink>(ch));
+    ch->m_logger.store(logger.get(), memory_order_relaxed);
+    g_generation.fetch_add(1, memory_order_acq_rel);
+
+    // Same as for other "MkLogger" loggers (throws on duplicate names):
+    spdlog::register_logger(logger);
+    return logger;
+  }
+
+  //=========================================================================//
+  // "Flush":                                                                //
+  //=========================================================================//
+  void Flush()
+  {
+    if (g_generation.load(memory_order_acquire) != 0)
+      Backend::Get().Flush();
+  }
+
+  //=========================================================================//
+  // "Decode":                                                               //
+  //=========================================================================//
+  namespace
+  {
+    using FmtArg = fmt::basic_format_arg<fmt::format_context>;
+
+    template<typename V>
+    V GetRaw(char const** a_p, char const* a_end)
+    {
+      V val;
+      if (utxx::unlikely(*a_p + sizeof(V) > a_end))
+        throw utxx::runtime_error("BinLog::Decode: Truncated Arg");
+      memcpy(&val, *a_p, sizeof(V));
+      *a_p += sizeof(V);
+      return val;
+    }
+
+    // Decodes the args (strings point into the payload):
+    void GetArgs(char const* a_p, char const* a_end, vector<FmtArg>* a_args)
+    {
+      using fmt::internal::make_arg;
+      a_args->clear();
+      while (a_p < a_end)
+      {
+        switch (ArgT(*(a_p++)))
+        {
+        case ArgT::Int:
+          a_args->push_back(make_arg<fmt::format_context>
+            (static_cast<long long>(GetRaw<int64_t>(&a_p, a_end))));
+          break;
+        case ArgT::UInt:
+          a_args->push_back(make_arg<fmt::format_context>
+            (static_cast<unsigned long long>(GetRaw<uint64_t>(&a_p, a_end))));
+          break;
+        case ArgT::Dbl:
+          a_args->push_back(make_arg<fmt::format_context>
+            (GetRaw<double>(&a_p, a_end)));
+          break;
+        case ArgT::Flt:
+          a_args->push_back(make_arg<fmt::format_context>
+            (GetRaw<float>(&a_p, a_end)));
+          break;
+        case ArgT::Bool:
+          a_args->push_back(make_arg<fmt::format_context>
+            (GetRaw<uint8_t>(&a_p, a_end) != 0));
+          break;
+        case ArgT::Char:
+          a_args->push_back(make_arg<fmt::format_context>
+            (GetRaw<char>(&a_p, a_end)));
+          break;
+        case ArgT::Str:
+        {
+          uint16_t len = GetRaw<uint16_t>(&a_p, a_end);
+          if (utxx::unlikely(a_p + len > a_end))
+            throw utxx::runtime_error("BinLog::Decode: Truncated Str");
+          a_args->push_back(make_arg<fmt::format_context>
+            (fmt::string_view(a_p, len)));
+          a_p += len;
+          break;
+        }
+        case ArgT::Ptr:
+          a_args->push_back(make_arg<fmt::format_context>
+            (reinterpret_cast<void const*>
+              (uintptr_t(GetRaw<uint64_t>(&a_p, a_end)))));
+          break;
+        default:
+          throw utxx::runtime_error("BinLog::Decode: Invalid ArgT");
+        }
+      }
+    }
+  }
+
+  long Decode(istream& a_in, ostream& a_out)
+  {
+    unordered_map<uint32_t, pair<string, uint8_t>> sites;
+    vector<FmtArg> args;
+    vector<char>   payload(MaxRecSize);
+    string         name;
+    double         ticksPerNs = 1.0;
+    uint64_t       syncTicks  = 0;
+    int64_t        syncNs     = 0;
+    long           off        = 0;
+    long           n          = 0;
+    fmt::memory_buffer line;
+
+    auto putLine = [&](uint64_t a_ticks, uint8_t a_level, string_view a_msg)
+    {
+      // The "%+" pattern of "spdlog": "[%Y-%m-%d %H:%M:%S.%e] [%n] [%l] %v":
+      int64_t ns =
+        syncNs + int64_t(double(int64_t(a_ticks - syncTicks)) / ticksPerNs);
+      time_t  sec = time_t(ns / 1'000'000'000L);
+      long    ms  = (ns % 1'000'000'000L) / 1'000'000L;
+      if (ms < 0)
+      {
+        --sec;
+        ms += 1000;
+      }
+      tm tm;
+      gmtime_r(&sec, &tm);
+
+      auto lvl = spdlog::level::to_string_view
+                 (spdlog::level::level_enum(a_level));
+      line.clear();
+      fmt::format_to
+        (line, "[{:04d}-{:02d}-{:02d} {:02d}:{:02d}:{:02d}.{:03d}] [{}] [{}] ",
+         tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour,
+         tm.tm_min, tm.tm_sec, ms, name, fmt::string_view(lvl.data(),
+         lvl.size()));
+      line.append(a_msg.data(), a_msg.data() + a_msg.size());
+      line.push_back('\n');
+      a_out.write(line.data(), long(line.size()));
+      ++n;
+    };
+
+    RecHdr hdr;
+    while (a_in.read(reinterpret_cast<char*>(&hdr), sizeof(hdr)))
+    {
+      if (utxx::unlikely(hdr.m_size < sizeof(hdr) ||
+                         hdr.m_size > MaxRecSize  ||
+                         hdr.m_len  > hdr.m_size - sizeof(hdr)))
+        throw utxx::runtime_error("BinLog::Decode: Corrupt Record @ ", off);
+      if (utxx::unlikely(off == 0 && hdr.m_kind != RecT::Open))
+        throw utxx::runtime_error("BinLog::Decode: Not a BinLog File");
+
+      // The last record may be incomplete if the file is still being written:
+      if (!a_in.read(payload.data(), long(hdr.m_size - sizeof(hdr))))
+        break;
+      off += hdr.m_size;
+
+      char const* p = payload.data();
+      switch (hdr.m_kind)
+      {
+      case RecT::Open:
+      {
+        OpenHdr oh;
+        memcpy(&oh, p, sizeof(oh));
+        if (utxx::unlikely(memcmp(oh.m_magic, Magic, sizeof(Magic)) != 0))
+          throw utxx::runtime_error("BinLog::Decode: Invalid Magic @ ", off);
+        oh.m_name[sizeof(oh.m_name) - 1] = '\0';
+        name       = oh.m_name;
+        ticksPerNs = oh.m_ticksPerNs;
+        syncTicks  = 0;
+        sites.clear();
+        break;
+      }
+      case RecT::Sync:
+      {
+        int64_t ns;
+        memcpy(&ns, p, sizeof(ns));
+        // Refine the rate over intervals of at least 1 sec:
+        if (syncTicks != 0 && ns - syncNs >= 1'000'000'000L &&
+            hdr.m_ticks > syncTicks)
+          ticksPerNs = double(hdr.m_ticks - syncTicks) / double(ns - syncNs);
+        syncTicks = hdr.m_ticks;
+        syncNs    = ns;
+        break;
+      }
+      case RecT::Site:
+        sites[hdr.m_site] = make_pair(string(p, hdr.m_len), hdr.m_level);
+        break;
+
+      case RecT::Msg:
+      {
+        auto it = sites.find(hdr.m_site);
+        if (utxx::unlikely(it == sites.end()))
+          throw utxx::runtime_error
+                ("BinLog::Decode: Unknown Site=", hdr.m_site, " @ ", off);
+        string const& fmtStr = it->second.first;
+        string        msg;
+        try
+        {
+          GetArgs(p, p + hdr.m_len, &args);
+          msg = fmt::vformat
+                (fmtStr, fmt::format_args(args.data(), int(args.size())));
+        }
+        catch (fmt::format_error const& exc)
+        {
+          msg = fmtStr + " [BinLog: " + exc.what() + "]";
+        }
+        putLine(hdr.m_ticks, hdr.m_level, msg);
+        break;
+      }
+      case RecT::Text:
+        putLine(hdr.m_ticks, hdr.m_level, string_view(p, hdr.m_len));
+        break;
+
+      case RecT::Drops:
+      {
+        uint64_t drops;
+        memcpy(&drops, p, sizeof(drops));
+        putLine(hdr.m_ticks, uint8_t(spdlog::level::warn),
+                fmt::format("BinLog: {} msg(s) dropped", drops));
+        break;
+      }
+      default:
+        throw utxx::runtime_error("BinLog::Decode: Invalid Record @ ", off);
+      }
+    }
+    return n;
+  }
+} // End namespace BinLog
+} // End namespace MAQUETTE
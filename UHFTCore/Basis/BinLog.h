@@ -0,0 +1,440 @@
+// vim:ts=2:et
+//===========================================================================//
+//                              "Basis/BinLog.h":                            //
+//        Binary Deferred-Formatting Logger behind the "LOG_*" Macros        //
+//===========================================================================//
+// A logger made by "IO::MkLogger" with the output "binlog:<Path>" is still an
+// "spdlog::logger", but it is also registered here as a "Channel". For such
+// loggers, the "LOG_*" macros do not format anything: they only copy the ID
+// of the fmt string (assigned on the first call at each call site) and the
+// raw args into a per-thread lock-free (SPSC) ring. A single back-end thread
+// drains all rings and appends the binary records to the Channel files; the
+// formatting itself is deferred until the file is decoded ("BinLogDecode",
+// or "BinLog::Decode" below), so nothing is ever flushed on the hot path.
+// Calls which do not go through the macros (eg "m_logger->info(...)") still
+// work: they are formatted by "spdlog" and passed on as pre-formatted text.
+//
+// Args of arithmetic types, unscoped enums, C strings, char arrays, std::
+// strings and string_views and "void const*" are stored raw. If any arg of a
+// call is of another type (PxsQtys etc), that call is formatted right away,
+// and is also passed on as text.
+//
+// Records are stamped with raw CPU ticks (RDTSC); the back-end writes a wall-
+// clock sync point into every Channel each second, from which the decoder
+// converts ticks into UTC. If a ring is full, the record is dropped (as with
+// the async "spdlog" loggers), and the number of drops is logged instead:
+//
+#pragma  once
+
+#include <spdlog/spdlog.h>
+#include <utxx/compiler_hints.hpp>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <time.h>
+#endif
+
+namespace MAQUETTE
+{
+namespace BinLog
+{
+  //=========================================================================//
+  // Record Layout (same in the rings and in the files):                     //
+  //=========================================================================//
+  enum class RecT: uint8_t
+  {
+    Pad   = 0,    // Ring only: skip to the ring start
+    Site  = 1,    // File only: fmt string of "m_site", before its first Msg
+    Msg   = 2,    // Args of a LOG_* call ("m_site" is the fmt string ID)
+    Text  = 3,    // Pre-formatted msg
+    Sync  = 4,    // Payload: UTC in nsec at "m_ticks"
+    Drops = 5,    // Payload: number of records dropped (since the last one)
+    Open  = 6     // File only: first record, with the magic and the TSC rate
+  };
+
+  struct RecHdr
+  {
+    uint32_t  m_size;     // Whole record incl this Hdr, a multiple of 8
+    uint16_t  m_channel;
+    RecT      m_kind;
+    uint8_t   m_level;    // spdlog::level::level_enum
+    uint32_t  m_site;
+    uint32_t  m_len;      // Payload bytes (the rest is padding)
+    uint64_t  m_ticks;
+  };
+  static_assert(sizeof(RecHdr) == 24, "BinLog::RecHdr");
+
+  // Max record size; longer Msgs are truncated:
+  constexpr uint32_t MaxRecSize = 4096;
+  constexpr uint32_t MaxPayload = MaxRecSize - sizeof(RecHdr);
+
+  // Type tags of the Args in a Msg payload (each tag is followed by the raw
+  // value; "Str" by a 16-bit length and the chars):
+  enum class ArgT: uint8_t
+  {
+    Int = 1, UInt = 2, Dbl = 3, Flt = 4, Bool = 5, Char = 6, Str = 7, Ptr = 8
+  };
+
+  //=========================================================================//
+  // "Ticks": Record TimeStamps:                                             //
+  //=========================================================================//
+  inline uint64_t Ticks()
+  {
+#   if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#   else
+    timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return uint64_t(ts.tv_sec) * 1'000'000'000UL + uint64_t(ts.tv_nsec);
+#   endif
+  }
+
+  //=========================================================================//
+  // "Ring": Per-Thread SPSC Ring of Variable-Size Records:                  //
+  //=========================================================================//
+  // "m_head" and "m_tail" are running byte counts (never wrapped); records
+  // never wrap around the ring end -- a "Pad" record fills the gap instead:
+  //
+  class Ring
+  {
+  public:
+    explicit Ring(uint32_t a_size);
+    ~Ring();
+
+    Ring(Ring const&)            = delete;
+    Ring& operator=(Ring const&) = delete;
+
+    //-----------------------------------------------------------------------//
+    // Producer:                                                             //
+    //-----------------------------------------------------------------------//
+    // Returns NULL (and counts a drop) if there is no room for "a_size" (a
+    // multiple of 8) bytes; otherwise, the record must be "Commit"ted:
+    //
+    char* Reserve(uint32_t a_size)
+    {
+      assert(a_size % 8 == 0 && a_size <= MaxRecSize);
+      uint64_t head = m_head.load(std::memory_order_relaxed);
+      uint32_t off  = uint32_t(head) & m_mask;
+      uint32_t pad  = (off + a_size > m_size) ? (m_size - off) : 0;
+
+      if (utxx::unlikely(head + pad + a_size - m_tailCache > m_size))
+      {
+        m_tailCache = m_tail.load(std::memory_order_acquire);
+        if (head + pad + a_size - m_tailCache > m_size)
+        {
+          m_drops.fetch_add(1, std::memory_order_relaxed);
+          return nullptr;
+        }
+      }
+      if (utxx::unlikely(pad != 0))
+      {
+        RecHdr* gap = reinterpret_cast<RecHdr*>(m_buff + off);
+        gap->m_size = pad;
+        gap->m_kind = RecT::Pad;
+        off         = 0;
+      }
+      m_next = head + pad + a_size;
+      return m_buff + off;
+    }
+
+    void Commit()
+      { m_head.store(m_next, std::memory_order_release); }
+
+    //-----------------------------------------------------------------------//
+    // Consumer:                                                             //
+    //-----------------------------------------------------------------------//
+    // Invokes "a_f(RecHdr const&)" on all committed records; returns their
+    // number:
+    //
+    template<typename F>
+    long Drain(F const& a_f)
+    {
+      uint64_t head = m_head.load(std::memory_order_acquire);
+      uint64_t tail = m_tail.load(std::memory_order_relaxed);
+      long     n    = 0;
+      while (tail != head)
+      {
+        RecHdr const* rec =
+          reinterpret_cast<RecHdr const*>(m_buff + (uint32_t(tail) & m_mask));
+        if (rec->m_kind != RecT::Pad)
+        {
+          a_f(*rec);
+          ++n;
+        }
+        tail += rec->m_size;
+      }
+      m_tail.store(tail, std::memory_order_release);
+      return n;
+    }
+
+    uint64_t Head() const { return m_head.load(std::memory_order_acquire); }
+    uint64_t Tail() const { return m_tail.load(std::memory_order_acquire); }
+
+    uint64_t TakeDrops()
+      { return m_drops.exchange(0, std::memory_order_relaxed); }
+
+    // Set by the owning thread on exit; the back-end then frees the Ring:
+    std::atomic<bool>     m_retired;
+
+  private:
+    alignas(64)
+    std::atomic<uint64_t> m_head;       // Written by the producer only
+    uint64_t              m_next;       //
+    uint64_t              m_tailCache;  //
+    std::atomic<uint64_t> m_drops;      //
+    alignas(64)
+    std::atomic<uint64_t> m_tail;       // Written by the consumer only
+    char*                 m_buff;
+    uint32_t              m_size;       // A power of 2
+    uint32_t              m_mask;
+  };
+
+  //=========================================================================//
+  // "Channel" (one per binary log file), "CallSite":                        //
+  //=========================================================================//
+  struct Channel
+  {
+    std::atomic<spdlog::logger const*> m_logger;  // NULL once it is dropped
+    uint16_t                           m_id;
+  };
+
+  struct CallSite
+  {
+    std::atomic<uint32_t>              m_id;      // 0 until registered
+  };
+
+  //=========================================================================//
+  // Non-Inline Parts (see "BinLog.cpp"):                                    //
+  //=========================================================================//
+  // Incremented whenever a Channel is created or its logger is dropped:
+  extern std::atomic<uint64_t> g_generation;
+
+  Channel const* FindSlow(spdlog::logger const* a_logger);
+
+  // Creates the calling thread's Ring, and stores it in "a_slot" (which is
+  // reset to NULL on thread exit); returns NULL if the thread is exiting:
+  Ring*    NewRing(Ring** a_slot);
+
+  uint32_t Register
+  (
+    CallSite*                  a_site,
+    char const*                a_fmt,
+    size_t                     a_len,
+    spdlog::level::level_enum  a_level
+  );
+
+  void LogText
+  (
+    Channel const*             a_ch,
+    spdlog::level::level_enum  a_level,
+    char const*                a_msg,
+    size_t                     a_len
+  );
+
+  // Creates a Channel writing into "a_path", and an "spdlog::logger" (regis-
+  // tered with "spdlog" under "a_name") which logs into it:
+  std::shared_ptr<spdlog::logger> MkLogger
+    (std::string const& a_name, std::string const& a_path);
+
+  // Waits until everything logged so far (by any thread) has been written out:
+  void Flush();
+
+  // Decodes a binary log file into text, in the "%+" format of "spdlog";
+  // returns the number of msgs:
+  long Decode(std::istream& a_in, std::ostream& a_out);
+
+  //=========================================================================//
+  // "Find": The Channel of a logger (NULL for plain "spdlog" loggers):      //
+  //=========================================================================//
+  inline Channel const* Find(spdlog::logger const* a_logger)
+  {
+    struct Cache
+    {
+      spdlog::logger const* m_logger;
+      Channel const*        m_ch;
+      uint64_t              m_gen;
+    };
+    static thread_local Cache s_cache{nullptr, nullptr, 0};
+
+    uint64_t gen = g_generation.load(std::memory_order_acquire);
+    if (utxx::unlikely(s_cache.m_logger != a_logger || s_cache.m_gen != gen))
+      s_cache = Cache{a_logger, FindSlow(a_logger), gen};
+    return s_cache.m_ch;
+  }
+
+  //=========================================================================//
+  // "ThisRing": The calling thread's Ring (NULL if the thread is exiting):  //
+  //=========================================================================//
+  inline Ring* ThisRing()
+  {
+    static thread_local Ring* s_ring = nullptr;
+    return utxx::likely(s_ring != nullptr) ? s_ring : NewRing(&s_ring);
+  }
+
+  //=========================================================================//
+  // Arg Encoding:                                                           //
+  //=========================================================================//
+  template<typename T>
+  constexpr bool IsCharArray =
+    std::is_array_v<T> &&
+    std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>;
+
+  template<typename T>
+  constexpr bool IsNative =
+    std::is_arithmetic_v<T>                                    ||
+    (std::is_enum_v<T> && std::is_convertible_v<T, long long>) ||
+    std::is_same_v<T, char const*> || std::is_same_v<T, char*> ||
+    IsCharArray<T>                                             ||
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, void const*> || std::is_same_v<T, void*>;
+
+  template<typename T>
+  inline std::string_view StrArg(T const& a_val)
+  {
+    if constexpr (IsCharArray<T>)
+      return std::string_view(a_val, strnlen(a_val, std::extent_v<T>));
+    else
+    if constexpr (std::is_pointer_v<T>)
+      return (a_val != nullptr) ? std::string_view(a_val)
+                                : std::string_view("(null)");
+    else
+      return std::string_view(a_val);
+  }
+
+  template<typename T>
+  constexpr bool IsStr =
+    IsCharArray<T> || std::is_same_v<T, char const*>     ||
+    std::is_same_v<T, char*>       || std::is_same_v<T, std::string> ||
+    std::is_same_v<T, std::string_view>;
+
+  template<typename T>
+  inline uint32_t ArgSize(T const& a_val)
+  {
+    if constexpr (IsStr<T>)
+      return 1 + 2 + uint32_t(StrArg(a_val).size());
+    else
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, char>)
+      return 2;
+    else
+    if constexpr (std::is_same_v<T, float>)
+      return 1 + sizeof(float);
+    else
+      return 1 + 8;
+  }
+
+  template<typename V>
+  inline char* PutRaw(char* a_p, ArgT a_tag, V a_val)
+  {
+    *a_p = char(a_tag);
+    memcpy(a_p + 1, &a_val, sizeof(V));
+    return a_p + 1 + sizeof(V);
+  }
+
+  // Args must fit before "a_end": strings are truncated if necessary, other
+  // args which do not fit are skipped (only possible after a long string):
+  template<typename T>
+  inline char* PutArg(char* a_p, char const* a_end, T const& a_val)
+  {
+    if (utxx::unlikely(a_end - a_p < (IsStr<T> ? 3 : long(ArgSize(a_val)))))
+      return a_p;
+
+    if constexpr (IsStr<T>)
+    {
+      std::string_view s   = StrArg(a_val);
+      uint16_t         len =
+        uint16_t(std::min<size_t>(s.size(), size_t(a_end - a_p) - 3));
+      char* p = PutRaw(a_p, ArgT::Str, len);
+      memcpy(p, s.data(), len);
+      return p + len;
+    }
+    else
+    if constexpr (std::is_same_v<T, bool>)
+      return PutRaw(a_p, ArgT::Bool, uint8_t(a_val));
+    else
+    if constexpr (std::is_same_v<T, char>)
+      return PutRaw(a_p, ArgT::Char, a_val);
+    else
+    if constexpr (std::is_same_v<T, float>)
+      return PutRaw(a_p, ArgT::Flt, a_val);
+    else
+    if constexpr (std::is_floating_point_v<T>)
+      return PutRaw(a_p, ArgT::Dbl, double(a_val));
+    else
+    if constexpr (std::is_pointer_v<T>)
+      return PutRaw(a_p, ArgT::Ptr, uint64_t(uintptr_t(a_val)));
+    else
+    if constexpr (std::is_enum_v<T> || std::is_signed_v<T>)
+      return PutRaw(a_p, ArgT::Int,  int64_t(a_val));
+    else
+      return PutRaw(a_p, ArgT::UInt, uint64_t(a_val));
+  }
+
+  //=========================================================================//
+  // "Log": Invoked by the "LOG_*" Macros for Channel loggers:               //
+  //=========================================================================//
+  // With a literal fmt string and native args, the Msg is stored raw:
+  //
+  template<size_t N, typename... Args>
+  inline std::enable_if_t<(IsNative<Args> && ...)> Log
+  (
+    Channel const*             a_ch,
+    CallSite*                  a_site,
+    spdlog::level::level_enum  a_level,
+    char const               (&a_fmt)[N],
+    Args const&...             a_args
+  )
+  {
+    uint32_t id = a_site->m_id.load(std::memory_order_relaxed);
+    if (utxx::unlikely(id == 0))
+      id = Register(a_site, a_fmt, strnlen(a_fmt, N), a_level);
+
+    uint32_t len  = std::min((ArgSize(a_args) + ... + 0u), MaxPayload);
+    uint32_t size = (uint32_t(sizeof(RecHdr)) + len + 7) & ~7u;
+
+    Ring* ring = ThisRing();
+    char* rec  = (ring != nullptr) ? ring->Reserve(size) : nullptr;
+    if (utxx::unlikely(rec == nullptr))
+      return;
+
+    RecHdr* hdr    = reinterpret_cast<RecHdr*>(rec);
+    hdr->m_size    = size;
+    hdr->m_channel = a_ch->m_id;
+    hdr->m_kind    = RecT::Msg;
+    hdr->m_level   = uint8_t(a_level);
+    hdr->m_site    = id;
+    hdr->m_ticks   = Ticks();
+
+    char*       p   = rec + sizeof(RecHdr);
+    [[maybe_unused]] char const* end = p + len;   // Unused if no args
+    ((p = PutArg(p, end, a_args)), ...);
+    hdr->m_len     = uint32_t(p - (rec + sizeof(RecHdr)));
+    ring->Commit();
+  }
+
+  // Otherwise, it is formatted right away:
+  //
+  template<typename Fmt, typename... Args>
+  inline void Log
+  (
+    Channel const*             a_ch,
+    CallSite*                  /*a_site*/,
+    spdlog::level::level_enum  a_level,
+    Fmt const&                 a_fmt,
+    Args const&...             a_args
+  )
+  {
+    fmt::memory_buffer buff;
+    fmt::format_to(buff, a_fmt, a_args...);
+    LogText(a_ch, a_level, buff.data(), buff.size());
+  }
+} // End namespace BinLog
+} // End namespace MAQUETTE
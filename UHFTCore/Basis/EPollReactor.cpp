@@ -27,6 +27,53 @@ using namespace std;
 
 namespace MAQUETTE
 {
+  namespace
+  {
+    //=======================================================================//
+    // io_uring "user_data" Encoding:                                        //
+    //=======================================================================//
+    // Bits  0..31: FD;
+    // Bits 32..61: lower 30 bits of the FDInfo InstID (to detect stale CQEs
+    //              after the FD has been removed and re-used);
+    // Bits 62..63: Operation Tag:
+    //
+    enum class URingOpT: uint64_t
+    {
+      Poll = 0,   // Multi-shot POLL_ADD
+      Recv = 1,   // Multi-shot RECV
+      Ctl  = 2    // POLL_REMOVE (incl updates) and ASYNC_CANCEL
+    };
+
+    constexpr uint64_t URingIIDMask = (1ULL << 30) - 1;
+
+    inline uint64_t MkURingUD(URingOpT a_op, int a_fd, uint64_t a_iid)
+    {
+      return (uint64_t(a_op)          << 62) |
+             ((a_iid & URingIIDMask)  << 32) |
+             uint64_t(uint32_t(a_fd));
+    }
+
+    inline URingOpT GetURingOp (uint64_t a_ud) { return URingOpT(a_ud >> 62); }
+    inline int      GetURingFD (uint64_t a_ud) { return int(uint32_t(a_ud));   }
+    inline uint64_t GetURingIID(uint64_t a_ud)
+      { return (a_ud >> 32) & URingIIDMask; }
+
+    //=======================================================================//
+    // "URingPollMask":                                                      //
+    //=======================================================================//
+    // The EPoll-style "m_waitEvents" are directly usable as "poll32_events",
+    // except for EPOLLET (selected by the POLL_ADD flags instead),  and EPOLLIN
+    // which is not needed if a multi-shot RECV is armed:
+    //
+    inline uint32_t URingPollMask(IO::FDInfo const& a_info)
+    {
+      uint32_t mask = a_info.m_waitEvents & (~uint32_t(EPOLLET));
+      if (a_info.m_uringRecv)
+        mask &= (~uint32_t(EPOLLIN));
+      return mask;
+    }
+  }
+
   //=========================================================================//
   // "EPollReactor" Non-Default Ctor:                                        //
   //=========================================================================//
@@ -37,25 +84,33 @@ namespace MAQUETTE
     bool            a_use_poll,
     bool            a_use_kernel_tls,
     int             a_max_fds,
-    int             a_cpu
+    int             a_cpu,
+    bool            a_use_io_uring
   )
   : m_MaxFDs        (a_max_fds),
     m_usePoll       (a_use_poll),
+    m_useURing      (a_use_io_uring),
     // For Poll:
     m_pollFDs       (m_usePoll  ? new pollfd[unsigned(m_MaxFDs)] : nullptr),
     // For EPoll:
-    m_epollFD       (!m_usePoll ? epoll_create1(0) : -1),
+    m_epollFD       ((!m_usePoll && !m_useURing) ? epoll_create1(0) : -1),
                                         // Master EPollFD created HERE!
     m_MaxEvents     (!m_usePoll ? (2 * m_MaxFDs)   :  0),
-                                        // Reasonable estimate
-    m_epEvents      (!m_usePoll
+                                        // Reasonable estimate (also io_uring)
+    m_epEvents      ((!m_usePoll && !m_useURing)
                      ? new epoll_event[unsigned(m_MaxEvents)] : nullptr),
+    // For io_uring (created below):
+    m_uring         (nullptr),
+    m_cqes          (nullptr),
+    m_nCQEs         (0),
+    m_cqeIdx        (0),
     // Generic:
     m_fdis          (new    IO::FDInfo[unsigned(m_MaxFDs)]),
     m_topFD         (-1),               // No active FDs yet
     m_useKernelTLS  (a_use_kernel_tls), // Use Linux Kernel TLS, not GNUTLS
     m_useVMA        (false),            // Set below
     m_udprxs        (new IO::UDPRX[NU]),
+    m_mmsgs         (new mmsghdr  [NU]),
     m_tlsCreds      (nullptr),
     m_logger        (a_logger),
     m_debugLevel    (a_debug_level),
@@ -70,6 +125,11 @@ namespace MAQUETTE
       if (utxx::unlikely(m_logger == nullptr || m_MaxFDs <= 0))
         throw utxx::badarg_error("EPollReactor::Ctor: Invalid arg(s)");
     )
+    // Poll and io_uring are mutually-exclusive back-ends:
+    if (utxx::unlikely(m_usePoll && m_useURing))
+      throw utxx::badarg_error
+            ("EPollReactor::Ctor: UsePoll and UseIOURing are incompatible");
+
     if (m_usePoll)
     {
       // Poll: Clear all PollFDs:
@@ -82,6 +142,17 @@ namespace MAQUETTE
       }
     }
     else
+    if (m_useURing)
+    {
+      // io_uring: Create the Ring. The SQ is sized for 1 SQE per event (incl
+      // mask updates), and the CQ for 2 CQEs per event; the Provided Buffers
+      // Ring is used by multi-shot RECVs:
+      m_uring = new IO::URing(unsigned(m_MaxEvents), 2 * unsigned(m_MaxEvents));
+      m_uring->SetUpBufRing(URingNBufs, URingBufSz, URingBufGroup);
+      m_cqes  = new IO::URing::Completion[unsigned(m_MaxEvents)];
+      LOG_INFO(2, "EPollReactor::Ctor: Using io_uring")
+    }
+    else
     {
       // EPoll: Create the MasterFD:
       if (utxx::unlikely(m_epollFD < 0))
@@ -94,6 +165,13 @@ namespace MAQUETTE
     // NB: "m_fdis" entries are initialized by "FDInfo" default ctors, so no
     // need to do it explicitly...
 
+    // Link the "recvmmsg" headers to the UDPRX buffers:
+    for (int i = 0; i < NU; ++i)
+    {
+      m_mmsgs[i].msg_hdr = m_udprxs[i].m_mh;
+      m_mmsgs[i].msg_len = 0;
+    }
+
     // Check whether LibVMA is used:
     char const* ldPreLoad = getenv("LD_PRELOAD");
     if (ldPreLoad != nullptr && strstr(ldPreLoad, "libvma.so") != nullptr)
@@ -101,6 +179,11 @@ namespace MAQUETTE
       m_useVMA = true;
       LOG_INFO(2, "EPollReactor::Ctor: Using LibVMA!")
 
+      // LibVMA intercepts the Socket API, but not io_uring:
+      if (utxx::unlikely(m_useURing))
+        throw utxx::badarg_error
+              ("EPollReactor::Ctor: UseIOURing is incompatible with LibVMA");
+
       // However, LibVMA is incompatible with KernelTLS:
       if (m_useKernelTLS)
       {
@@ -147,6 +230,18 @@ namespace MAQUETTE
         m_epEvents = nullptr;
       }
 
+      // io_uring: Closing the Ring cancels all outstanding requests:
+      if (m_cqes  != nullptr)
+      {
+        delete[] m_cqes;
+        m_cqes  = nullptr;
+      }
+      if (m_uring != nullptr)
+      {
+        delete   m_uring;
+        m_uring = nullptr;
+      }
+
       // In any case: Remove the "FDInfo"s:
       if (utxx::likely(m_fdis   != nullptr))
       {
@@ -161,6 +256,11 @@ namespace MAQUETTE
         delete[] m_udprxs;
         m_udprxs = nullptr;
       }
+      if (utxx::likely(m_mmsgs  != nullptr))
+      {
+        delete[] m_mmsgs;
+        m_mmsgs  = nullptr;
+      }
 
       // m_loggerShP is finalised automaticaly, but we reset the direct ptr:
       m_logger = nullptr;
@@ -295,6 +395,31 @@ namespace MAQUETTE
         }
       }
       else
+      if (m_useURing)
+      {
+        // io_uring: Remove the multi-shot POLL_ADD and cancel the RECV (if any)
+        // -- submit them NOW, before the socket is closed.  The corresp final
+        // CQEs will be filtered out by their InstIDs:
+        assert(m_uring != nullptr);
+        uint64_t iid = a_info->m_inst_id;
+
+        io_uring_sqe* sqe = m_uring->GetSQE();
+        sqe->opcode       = IORING_OP_POLL_REMOVE;
+        sqe->fd           = -1;
+        sqe->addr         = MkURingUD(URingOpT::Poll, fd, iid);
+        sqe->user_data    = MkURingUD(URingOpT::Ctl,  fd, iid);
+
+        if (a_info->m_uringRecv)
+        {
+          sqe             = m_uring->GetSQE();
+          sqe->opcode     = IORING_OP_ASYNC_CANCEL;
+          sqe->fd         = -1;
+          sqe->addr       = MkURingUD(URingOpT::Recv, fd, iid);
+          sqe->user_data  = MkURingUD(URingOpT::Ctl,  fd, iid);
+        }
+        (void) m_uring->Submit();
+      }
+      else
       {
         // EPoll:
         assert(m_epollFD >= 0);
@@ -386,6 +511,20 @@ namespace MAQUETTE
         pfd->revents = 0;
       }
       else
+      if (m_useURing)
+      {
+        // io_uring: Same Non-Blocking logic as for EPoll below (LibVMA is not
+        // used in this case). A plain TCP Stream which is already connected
+        // (ie Server-side) gets a multi-shot RECV right away, so  its  POLL_
+        // ADD will not contain EPOLLIN:
+        if (a_events & EPOLLET)
+          (void) IO::SetBlocking<false>(fd);
+
+        a_info->m_waitEvents = a_events;
+        MaybeArmURingRecv(a_info, false);
+        URingPollAdd(*a_info);
+      }
+      else
       {
         // EPoll: Add it to the Master, really:
         assert(m_epollFD >= 0);
@@ -802,7 +941,8 @@ namespace MAQUETTE
     int                            a_wr_bufsz,
     int                            a_wr_lwm,
     char const*                    a_remote_addr, // To "connect" to:
-    int                            a_remote_port  //   may be empty/invalid
+    int                            a_remote_port, //   may be empty/invalid
+    int                            a_recv_batch   // 0: no "recvmmsg"
   )
   {
     //-----------------------------------------------------------------------//
@@ -813,6 +953,11 @@ namespace MAQUETTE
       if (utxx::unlikely(a_wr_bufsz < 0 || a_wr_lwm < 0))
         throw utxx::badarg_error
               ("EPollReactor::AddDataGram: Negative BuffSz or LowWaterMark");
+
+      if (utxx::unlikely(a_recv_batch < 0 || a_recv_batch > NU))
+        throw utxx::badarg_error
+              ("EPollReactor::AddDataGram: Invalid RecvBatch=", a_recv_batch,
+               ": Must be in [0..", NU, ']');
     )
     // Create an INET or UNIX DGram Socket (and possibly connect it to the re-
     // mote if specified):
@@ -857,6 +1002,7 @@ namespace MAQUETTE
     info.m_rch     = a_on_recv;     // May be empty, but seldom
     info.m_eh      = a_on_error;
     info.m_inst_id = ++m_currInstID;
+    info.m_recvBatch = a_recv_batch;
 
     // Create and attach the Read and Write Buffers:
     // NB: The Read Buffer is not required for DGram sockets -- in that case,
@@ -1434,6 +1580,21 @@ namespace MAQUETTE
       a_info->m_waitEvents = uint32_t(pfd->events);
     }
     else
+    if (m_useURing)
+    {
+      // io_uring: Same mask logic as for EPoll below, but the update is only
+      // queued -- it will be submitted along with the next "Poll":
+      uint32_t  newEvs = ON ? (oldEvs | EPOLLOUT) : (oldEvs & (~EPOLLOUT));
+      if (utxx::unlikely(noRX))
+        newEvs &= (~EPOLLIN);
+
+      if (oldEvs != newEvs)
+      {
+        a_info->m_waitEvents = newEvs;
+        URingPollUpdate(*a_info);
+      }
+    }
+    else
     {
       // EPoll:
       uint32_t  newEvs = ON ? (oldEvs | EPOLLOUT) : (oldEvs & (~EPOLLOUT));
@@ -1466,6 +1627,92 @@ namespace MAQUETTE
     }
   }
 
+  //=========================================================================//
+  // io_uring Event Mgmt:                                                    //
+  //=========================================================================//
+  //-------------------------------------------------------------------------//
+  // "URingPollAdd":                                                         //
+  //-------------------------------------------------------------------------//
+  // Queues a multi-shot POLL_ADD for the given FDInfo; it will be submitted
+  // along with the next "Poll":
+  //
+  inline void EPollReactor::URingPollAdd(IO::FDInfo const& a_info) const
+  {
+    assert(m_useURing && m_uring != nullptr && a_info.m_fd >= 0);
+
+    io_uring_sqe* sqe   = m_uring->GetSQE();
+    sqe->opcode         = IORING_OP_POLL_ADD;
+    sqe->fd             = a_info.m_fd;
+    sqe->poll32_events  = URingPollMask(a_info);
+    sqe->len            =
+      IORING_POLL_ADD_MULTI |
+      ((a_info.m_waitEvents & EPOLLET) ? 0U : IORING_POLL_ADD_LEVEL);
+    sqe->user_data      =
+      MkURingUD(URingOpT::Poll, a_info.m_fd, a_info.m_inst_id);
+  }
+
+  //-------------------------------------------------------------------------//
+  // "URingPollUpdate":                                                      //
+  //-------------------------------------------------------------------------//
+  // Queues an in-place update of the events mask of an existing multi-shot
+  // POLL_ADD (the io_uring analogue of EPOLL_CTL_MOD, but w/o a syscall of
+  // its own). NB: Updates are only used for (Edge-Triggered) Streams:
+  //
+  inline void EPollReactor::URingPollUpdate(IO::FDInfo const& a_info) const
+  {
+    assert(m_useURing && m_uring != nullptr && a_info.m_fd >= 0 &&
+           (a_info.m_waitEvents & EPOLLET));
+
+    io_uring_sqe* sqe   = m_uring->GetSQE();
+    sqe->opcode         = IORING_OP_POLL_REMOVE;
+    sqe->fd             = -1;
+    sqe->addr           =
+      MkURingUD(URingOpT::Poll, a_info.m_fd, a_info.m_inst_id);
+    sqe->len            = IORING_POLL_UPDATE_EVENTS | IORING_POLL_ADD_MULTI;
+    sqe->poll32_events  = URingPollMask(a_info);
+    sqe->user_data      =
+      MkURingUD(URingOpT::Ctl,  a_info.m_fd, a_info.m_inst_id);
+  }
+
+  //-------------------------------------------------------------------------//
+  // "MaybeArmURingRecv":                                                    //
+  //-------------------------------------------------------------------------//
+  // For connected plain TCP (non-TLS) Streams with a "ReadHandler", queues a
+  // multi-shot RECV using the Provided Buffers Ring. After that, the data are
+  // delivered by CQEs rather than by "read" upon readability events, so  the
+  // POLL_ADD mask is updated (if "a_update_poll" is set) to exclude EPOLLIN:
+  //
+  inline void EPollReactor::MaybeArmURingRecv
+  (
+    IO::FDInfo* a_info,
+    bool        a_update_poll
+  )
+  {
+    assert(a_info != nullptr);
+    if (!m_useURing                                           ||
+        a_info->m_htype   != IO::FDInfo::HandlerT::DataStream ||
+        a_info->m_tlsType != IO::TLSTypeT::None               ||
+        a_info->m_rd_buff == nullptr || !(a_info->m_rh)       ||
+        !(a_info->m_connected))
+      return;
+
+    assert(m_uring != nullptr && a_info->m_fd >= 0);
+    if (!(a_info->m_uringRecv))
+    {
+      a_info->m_uringRecv = true;
+      if (a_update_poll)
+        URingPollUpdate(*a_info);
+    }
+    io_uring_sqe* sqe = m_uring->GetSQE();
+    sqe->opcode       = IORING_OP_RECV;
+    sqe->fd           = a_info->m_fd;
+    sqe->ioprio       = IORING_RECV_MULTISHOT;
+    sqe->flags        = IOSQE_BUFFER_SELECT;
+    sqe->buf_group    = m_uring->GetBufGroup();
+    sqe->user_data    =
+      MkURingUD(URingOpT::Recv, a_info->m_fd, a_info->m_inst_id);
+  }
+
   //=========================================================================//
   // "Poll" (to be invoked by an external driver, or internal "Run"):        //
   //=========================================================================//
@@ -1488,6 +1735,13 @@ namespace MAQUETTE
       gh.second();
     }
 
+    // The io_uring back-end is completion-based, so it is handled separately:
+    if (m_useURing)
+    {
+      PollURing(a_timeout_ms);
+      return;
+    }
+
     //-----------------------------------------------------------------------//
     // Now get the next batch of events:                                     //
     //-----------------------------------------------------------------------//
@@ -1565,102 +1819,293 @@ namespace MAQUETTE
           continue;
         }
       }
-      //---------------------------------------------------------------------//
-      // Further checks (and get the "FDInfo"):                              //
-      //---------------------------------------------------------------------//
-      CHECK_ONLY
-      (LOG_INFO(4,
-        "EPollReactor::Poll: FD={}: {}", fd, EPollEventsToStr(events)))
-
-      // OK, "fd" is within the valid range:
-      assert(0 <= fd && fd < m_MaxFDs && fd <= m_topFD);
+      HandleEvents(fd, events);
+    }
+  }
 
-      // Get the "FDInfo", it must be valid -- if not, it is a very serious
-      // error condition which terminated the whole Reactor:
-      IO::FDInfo& info  = m_fdis[fd];
+  //=========================================================================//
+  // "HandleEvents":                                                         //
+  //=========================================================================//
+  // Dispatches the "a_events" received on "a_fd" (by any back-end) to the
+  // resp Handler:
+  //
+  inline void EPollReactor::HandleEvents(int a_fd, uint32_t a_events)
+  {
+    //-----------------------------------------------------------------------//
+    // Checks (and get the "FDInfo"):                                        //
+    //-----------------------------------------------------------------------//
+    CHECK_ONLY
+    (LOG_INFO(4,
+      "EPollReactor::HandleEvents: FD={}: {}", a_fd,
+      EPollEventsToStr(a_events)))
+
+    // OK, "a_fd" is within the valid range:
+    assert(0 <= a_fd && a_fd < m_MaxFDs && a_fd <= m_topFD);
+
+    // Get the "FDInfo", it must be valid -- if not, it is a very serious
+    // error condition which terminated the whole Reactor:
+    IO::FDInfo& info  = m_fdis[a_fd];
+
+    // Check: If we use Poll, the follwoing two wait-for event sets must be
+    // same:
+    assert(!m_usePoll ||
+          (info.m_waitEvents == uint32_t(m_pollFDs[a_fd].events)));
+
+    // XXX: The following must normally happen:  If a certain FD was removed
+    // from the Reactor,  it was also removed from the Poll/EPoll mechanism,
+    // and we must NOT receive events on it. We should also not receive Zero
+    // Events. YET it happens sometimes -- so log and ignore such events:
+    //
+    if (utxx::unlikely
+       (a_events == 0 || info.m_fd != a_fd || info.m_inst_id == 0))
+    {
+      CHECK_ONLY
+      (
+        LOG_WARN(3,
+          "EPollReactor::HandleEvents: OldFD={}: Empty FDInfo(?), but still "
+          "got Event={} ({}): Ignored (MaxFDs={}, TopFD={}, FDInfo.FD={}, "
+          "FDInfo.InstID={}, FDInfo.Name={})",
+          a_fd,      EPollEventsToStr(a_events), a_events, m_MaxFDs, m_topFD,
+          info.m_fd, info.m_inst_id, info.m_name.data())
+      )
+      return;
+    }
+    // Record the Events received in the FDInfo:
+    info.m_gotEvents = a_events;
+
+    //-----------------------------------------------------------------------//
+    // Call-Backs Invocation:                                                //
+    //-----------------------------------------------------------------------//
+    // OK, "FDInfo" is valid -- will invoke a Call-Back on it, depending on
+    // its "HType":
+    // (*) Invoke "regular" IO event processing first, and check for EPoll-
+    //     detected errors later. This is because the data could still  be
+    //     available for Reading even in the presence  of  an EPoll  error
+    //     (however, we will refrain from Writing into the socket if there
+    //     was already an error detected);
+    // (*) Still, the "Handle*" methods invoked below are aware  of EPoll-
+    //     detected errors, so if a secondary error occurs there,  it will
+    //     NOT trigger an exception -- rather, the primary error   will be
+    //     processed:
+    // (*) Otherwise, if any "unexpected" IO error is encountered by Handler,
+    //     "HandleIOError" will be invoked but no exception will be thrown;
+    //     still, an exception may occur for any other reasons in user-level
+    //     handlers -- which is NOT caught here):
+    //
+    switch (info.m_htype)
+    {
+      case IO::FDInfo::HandlerT::DataStream:
+        HandleDataStream(&info);
+        break;
+      case IO::FDInfo::HandlerT::DataGram:
+        HandleDataGram  (&info);
+        break;
+      case IO::FDInfo::HandlerT::RawInput:
+        HandleRawInput  (&info);
+        break;
+      case IO::FDInfo::HandlerT::Timer:
+        HandleTimer     (&info);
+        break;
+      case IO::FDInfo::HandlerT::Signal:
+        HandleSignal    (&info);
+        break;
+      case IO::FDInfo::HandlerT::Acceptor:
+        HandleAccept    (&info);
+        break;
+      default:
+        LOG_ERROR(1,
+          "EPollReactor::HandleEvents: UnExpected Handler type for FD={}: {}",
+          a_fd, int(info.m_htype))
+    }
+    // And only now, process any possible EPoll-detected errors  (because we
+    // may receive useful events along with them, and such events need to be
+    // processed first).  In this general case, we do NOT automatically stop
+    // the Reactor, and do not throw any exceptions:
+    //
+    if (utxx::unlikely(IsError(info.m_gotEvents)))
+      HandleIOError<false, false>
+        (info, "EPollReactor::HandleEvents: Error event received");
+  }
 
-      // Check: If we use Poll, the follwoing two wait-for event sets must be
-      // same:
-      assert(!m_usePoll ||
-            (info.m_waitEvents == uint32_t(m_pollFDs[fd].events)));
+  //=========================================================================//
+  // "PollURing":                                                            //
+  //=========================================================================//
+  // io_uring version of the "Poll" body: Submits all queued SQEs (mask updates,
+  // re-arms etc) and waits for CQEs in a single syscall; none at all if there
+  // are CQEs available already:
+  //
+  void EPollReactor::PollURing(int a_timeout_ms)
+  {
+    assert(m_useURing && m_uring != nullptr && m_cqes != nullptr);
 
-      // XXX: The following must normally happen:  If a certain FD was removed
-      // from the Reactor,  it was also removed from the Poll/EPoll mechanism,
-      // and we must NOT receive events on it. We should also not receive Zero
-      // Events. YET it happens sometimes -- so log and ignore such events:
-      //
-      if (utxx::unlikely
-         (events == 0 || info.m_fd != fd || info.m_inst_id == 0))
+    // Harvest a new batch of CQEs, unless some remain from the prev invocation
+    // (if it was interrupted by an exception):
+    if (m_cqeIdx >= m_nCQEs)
+    {
+      m_cqeIdx = 0;
+      m_nCQEs  = 0;
+      m_nCQEs  = m_uring->SubmitAndGet(m_cqes, m_MaxEvents, a_timeout_ms);
+    }
+    //-----------------------------------------------------------------------//
+    // Process the CQEs:                                                     //
+    //-----------------------------------------------------------------------//
+    while (m_cqeIdx < m_nCQEs)
+    {
+      // NB: Advance the index BEFORE processing, so that a CQE which resulted
+      // in an exception is not processed again:
+      IO::URing::Completion cqe = m_cqes[m_cqeIdx++];
+
+      URingOpT op  = GetURingOp (cqe.m_userData);
+      int      fd  = GetURingFD (cqe.m_userData);
+      uint64_t iid = GetURingIID(cqe.m_userData);
+
+      // Is this CQE stale (ie the FD has been removed, or even re-used, since
+      // the corresp SQE was submitted)?
+      bool stale =
+        (fd < 0 || fd >= m_MaxFDs || fd > m_topFD   ||
+         m_fdis[fd].m_fd != fd    || m_fdis[fd].m_inst_id == 0 ||
+         (m_fdis[fd].m_inst_id & URingIIDMask) != iid);
+
+      switch (op)
       {
-        CHECK_ONLY
-        (
-          LOG_WARN(3,
-            "EPollReactor::Poll: OldFD={}: Empty FDInfo(?), but still got "
-            "Event={} ({}): Ignored (MaxFDs={}, TopFD={}, FDInfo.FD={}, "
-            "FDInfo.InstID={}, FDInfo.Name={})",
-            fd,        EPollEventsToStr(events), events, m_MaxFDs, m_topFD,
-            info.m_fd, info.m_inst_id, info.m_name.data())
-        )
-        continue;
-      }
-      // Record the Events received in the FDInfo:
-      info.m_gotEvents = events;
+        //-------------------------------------------------------------------//
+        case URingOpT::Poll:
+        //-------------------------------------------------------------------//
+          if (utxx::unlikely(stale || cqe.m_res == -ECANCELED))
+            break;
+          {
+            IO::FDInfo& info = m_fdis[fd];
 
-      //---------------------------------------------------------------------//
-      // Call-Backs Invocation:                                              //
-      //---------------------------------------------------------------------//
-      // OK, "FDInfo" is valid -- will invoke a Call-Back on it, depending on
-      // its "HType":
-      // (*) Invoke "regular" IO event processing first, and check for EPoll-
-      //     detected errors later. This is because the data could still  be
-      //     available for Reading even in the presence  of  an EPoll  error
-      //     (however, we will refrain from Writing into the socket if there
-      //     was already an error detected);
-      // (*) Still, the "Handle*" methods invoked below are aware  of EPoll-
-      //     detected errors, so if a secondary error occurs there,  it will
-      //     NOT trigger an exception -- rather, the primary error   will be
-      //     processed:
-      // (*) Otherwise, if any "unexpected" IO error is encountered by Handler,
-      //     "HandleIOError" will be invoked but no exception will be thrown;
-      //     still, an exception may occur for any other reasons in user-level
-      //     handlers -- which is NOT caught here):
-      //
-      switch (info.m_htype)
-      {
-        case IO::FDInfo::HandlerT::DataStream:
-          HandleDataStream(&info);
-          break;
-        case IO::FDInfo::HandlerT::DataGram:
-          HandleDataGram  (&info);
-          break;
-        case IO::FDInfo::HandlerT::RawInput:
-          HandleRawInput  (&info);
-          break;
-        case IO::FDInfo::HandlerT::Timer:
-          HandleTimer     (&info);
-          break;
-        case IO::FDInfo::HandlerT::Signal:
-          HandleSignal    (&info);
+            // If the multi-shot POLL_ADD has been terminated by the kernel (eg
+            // due to CQ overflow), re-arm it:
+            if (utxx::unlikely(!(cqe.m_flags & IORING_CQE_F_MORE)))
+              URingPollAdd(info);
+
+            // A negative "res" is an error code -- report it as such:
+            uint32_t events =
+              (cqe.m_res >= 0) ? uint32_t(cqe.m_res) : uint32_t(EPOLLERR);
+            HandleEvents(fd, events);
+          }
           break;
-        case IO::FDInfo::HandlerT::Acceptor:
-          HandleAccept    (&info);
+
+        //-------------------------------------------------------------------//
+        case URingOpT::Recv:
+        //-------------------------------------------------------------------//
+          if (utxx::unlikely(stale))
+          {
+            // Still need to return the buffer (if any) to the kernel:
+            if (cqe.m_flags & IORING_CQE_F_BUFFER)
+              m_uring->RecycleBuf(cqe.m_flags >> IORING_CQE_BUFFER_SHIFT);
+            break;
+          }
+          HandleURingRecv(m_fdis + fd, cqe);
           break;
+
+        //-------------------------------------------------------------------//
         default:
-          LOG_ERROR(1,
-            "EPollReactor::Poll: UnExpected Handler type for FD={}: {}", fd,
-            int(info.m_htype))
+        //-------------------------------------------------------------------//
+          // Ctl: Only unexpected errors are of interest. ENOENT and EALREADY
+          // occur when the target request has already terminated:
+          if (utxx::unlikely
+             (cqe.m_res < 0       && cqe.m_res != -ENOENT &&
+              cqe.m_res != -EALREADY && cqe.m_res != -ECANCELED))
+            LOG_WARN(3,
+              "EPollReactor::PollURing: FD={}: Ctl Op Failed: {}", fd,
+              strerror(-cqe.m_res))
       }
-      // And only now, process any possible EPoll-detected errors  (because we
-      // may receive useful events along with them, and such events need to be
-      // processed first).  In this general case, we do NOT automatically stop
-      // the Reactor, and do not throw any exceptions:
-      //
-      if (utxx::unlikely(IsError(info.m_gotEvents)))
-        HandleIOError<false, false>
-          (info, "EPollReactor::Poll: Error event received");
     }
   }
 
+  //=========================================================================//
+  // "HandleURingRecv":                                                      //
+  //=========================================================================//
+  // Processes a multi-shot RECV CQE: the data are moved from the Provided
+  // Buffer into "m_rd_buff", and the "ReadHandler" is invoked exactly as from
+  // "ReadUntilEAgain":
+  //
+  inline void EPollReactor::HandleURingRecv
+  (
+    IO::FDInfo*                  a_info,
+    IO::URing::Completion const& a_cqe
+  )
+  {
+    assert(a_info != nullptr && a_info->m_uringRecv &&
+           a_info->m_htype == IO::FDInfo::HandlerT::DataStream);
+
+    int      fd   = a_info->m_fd;
+    uint64_t iid  = a_info->m_inst_id;
+    int      res  = a_cqe.m_res;
+    bool     more = (a_cqe.m_flags & IORING_CQE_F_MORE);
+
+    //-----------------------------------------------------------------------//
+    // Got some data:                                                        //
+    //-----------------------------------------------------------------------//
+    if (utxx::likely(res > 0))
+    {
+      assert(a_cqe.m_flags & IORING_CQE_F_BUFFER);
+      unsigned                 bid    =
+        a_cqe.m_flags >> IORING_CQE_BUFFER_SHIFT;
+      utxx::dynamic_io_buffer* rdBuff = a_info->m_rd_buff;
+      assert(rdBuff != nullptr);
+
+      // As in "ReadUntilEAgain", a buffer overflow is currently unrecoverable:
+      if (utxx::unlikely(size_t(res) >= rdBuff->capacity()))
+      {
+        m_uring->RecycleBuf(bid);
+        throw utxx::runtime_error
+              ("EPollReactor::HandleURingRecv: BufferOverFlow: FD=", fd);
+      }
+      memcpy(rdBuff->wr_ptr(), m_uring->GetBuf(bid), size_t(res));
+      rdBuff->commit(size_t(res));
+      m_uring->RecycleBuf(bid);
+
+      // Re-arm the RECV BEFORE invoking the "ReadHandler" (which may remove
+      // this FD):
+      if (utxx::unlikely(!more))
+        MaybeArmURingRecv(a_info, false);
+
+      // Invoke the "ReadHandler" on the cumulative data in the buffer:
+      int consumed =
+        a_info->m_rh(fd, rdBuff->rd_ptr(), int(rdBuff->size()),
+                     utxx::now_utc());
+
+      // The FDInfo may have been detached by the "ReadHandler":
+      if (utxx::unlikely
+         (consumed < 0 || a_info->m_fd != fd || a_info->m_inst_id != iid))
+        return;
+
+      if (utxx::likely(consumed > 0))
+        rdBuff->read_and_crunch(consumed);
+      return;
+    }
+    //-----------------------------------------------------------------------//
+    // Otherwise: No data:                                                   //
+    //-----------------------------------------------------------------------//
+    if (utxx::unlikely(a_cqe.m_flags & IORING_CQE_F_BUFFER))
+      m_uring->RecycleBuf(a_cqe.m_flags >> IORING_CQE_BUFFER_SHIFT);
+
+    if (res == -ENOBUFS)
+    {
+      // All Provided Buffers are in use (cannot normally happen, as they  are
+      // recycled synchronously): Re-arm the RECV:
+      LOG_WARN(2,
+        "EPollReactor::HandleURingRecv: FD={}, Name={}: Out of Buffers",
+        fd, a_info->m_name.data())
+      if (!more)
+        MaybeArmURingRecv(a_info, false);
+      return;
+    }
+    if (res == -ECANCELED)
+      return;
+
+    // EOF (res==0) or a real error: the RECV is terminated. Handle it in the
+    // same way as a "ReadUntilEAgain" error  (StopReactor=false, Throwing=
+    // false):
+    a_info->m_uringRecv = false;
+    HandleIOError<false, false>
+      (*a_info, "EPollReactor::HandleURingRecv: recv Failed: res=", res);
+  }
+
   //=========================================================================//
   // "Run":                                                                  //
   //=========================================================================//
@@ -1913,6 +2358,9 @@ namespace MAQUETTE
         assert(a_info->m_tlsType == IO::TLSTypeT::None);
         SetOUTEventMask<false>(a_info);
 
+        // With io_uring, plain TCP data are received via a multi-shot RECV:
+        MaybeArmURingRecv(a_info, true);
+
         LOG_INFO(2,
           "EPollReactor::HandleDataStream: FD={}, Name={}: TCP Connect "
           "Successful", fd, a_info->m_name.data())
@@ -1952,9 +2400,10 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // Generic Reading:                                                      //
     //-----------------------------------------------------------------------//
-    // NB: We will try to do so even if "wasError" is set:
+    // NB: We will try to do so even if "wasError" is set. If a multi-shot io_
+    // uring RECV is armed, the data are delivered by "HandleURingRecv" instead:
     //
-    if (isReadable)
+    if (isReadable && !(a_info->m_uringRecv))
     {
       IO::FDInfo::ReadHandler& rh = a_info->m_rh;
       CHECK_ONLY
@@ -2153,13 +2602,18 @@ namespace MAQUETTE
         };
 
       //---------------------------------------------------------------------//
-      // Invoke "IO::RecvUntilEAgain" with a Reactor-wide UDP buffer:        //
+      // Invoke "IO::Recv{MMsg}UntilEAgain" with a Reactor-wide UDP buffer:  //
       //---------------------------------------------------------------------//
       // XXX: It will produce an error if "m_iov" was de-configured:
       //
-      IO::RecvUntilEAgain
-        (*a_info, m_udprxs, NU, recv_action, err_action,
-         "EPollReactor::HandleDataGram)");
+      if (a_info->m_recvBatch > 0)
+        IO::RecvMMsgUntilEAgain
+          (*a_info, m_udprxs, m_mmsgs, NU, recv_action, err_action,
+           "EPollReactor::HandleDataGram(MMsg)");
+      else
+        IO::RecvUntilEAgain
+          (*a_info, m_udprxs, NU, recv_action, err_action,
+           "EPollReactor::HandleDataGram");
     }
 
     //-----------------------------------------------------------------------//
@@ -2601,6 +3055,7 @@ namespace MAQUETTE
         // it is a UNIX-domain socket. However, technically speaking,   we still
         // need to (possibly) reset the OUT event mask here:
         SetOUTEventMask<false>(&info);
+        MaybeArmURingRecv(&info, true);
 
         // Immediately invoke the CallBack:
         IO::FDInfo::ConnectHandler& ch = info.m_ch;
@@ -7,6 +7,7 @@
 
 #include "Basis/BaseTypes.hpp"
 #include "Basis/IOUtils.h"
+#include "Basis/IOURing.h"
 #include <utxx/compiler_hints.hpp>
 #include <boost/container/static_vector.hpp>
 #include <spdlog/logger.h>
@@ -34,10 +35,19 @@ namespace MAQUETTE
     //=======================================================================//
     int const        m_MaxFDs;
     bool const       m_usePoll;      // Use Poll instead of EPoll
+    bool const       m_useURing;     // Use io_uring instead of EPoll
     pollfd*          m_pollFDs;      // If Poll  is used
     int              m_epollFD;      // The EPoll MasterFD
     int const        m_MaxEvents;    // Only for EPoll
     epoll_event*     m_epEvents;     // Events received from EPoll
+    // For io_uring: FDs are monitored via multi-shot POLL_ADDs, and plain TCP
+    // streams are read via multi-shot RECVs into the Provided Buffers  Ring.
+    // Harvested CQEs are processed from "m_cqes[m_cqeIdx..m_nCQEs)",  so the
+    // remaining ones survive an exception thrown by a user-level Handler:
+    IO::URing*       m_uring;
+    IO::URing::Completion* m_cqes;
+    int              m_nCQEs;
+    int              m_cqeIdx;
     IO::FDInfo*      m_fdis;
     int              m_topFD;        // m_topFD < m_MaxFDs
 
@@ -57,7 +67,15 @@ namespace MAQUETTE
     // for UDP sends!) So to improve data locality, use a Reactor-common UDP Rd
     // buffer and related structs in that case:
     constexpr static int NU = 1024;
+
+    // Provided Buffers for io_uring multi-shot RECVs (per-Reactor):
+    constexpr static unsigned URingNBufs    = 256;
+    constexpr static unsigned URingBufSz    = 16384;
+    constexpr static uint16_t URingBufGroup = 0;
     IO::UDPRX*       m_udprxs;
+    // Same for the batched ("recvmmsg") mode: "m_mmsgs[i].msg_hdr" is a copy
+    // of "m_udprxs[i].m_mh", so the data are received into same buffers:
+    mmsghdr*         m_mmsgs;
 
     // TLS Support: Credentials are per-Reactor:
     gnutls_certificate_credentials_t m_tlsCreds;
@@ -96,7 +114,8 @@ namespace MAQUETTE
       bool            a_use_poll       = false,
       bool            a_use_kernel_tls = true,
       int             a_max_fds        = 1024,
-      int             a_cpu            = -1
+      int             a_cpu            = -1,
+      bool            a_use_io_uring   = false   // Incompatible with Poll
     );
 
     ~EPollReactor() noexcept;
@@ -139,7 +158,11 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // "AddDataGram":                                                        //
     //-----------------------------------------------------------------------//
-    // For details, see the imp. Returns the FD:
+    // For details, see the imp. Returns the FD.
+    // "a_recv_batch": if > 0, incoming DataGrams are received in batches of up
+    // to that many per "recvmmsg" syscall (useful for bursty MCast feeds); if
+    // 0, one "recvmsg" syscall per DataGram is used:
+    //
     int AddDataGram
     (
       char const*                     a_name,        // May be NULL (then "")
@@ -150,7 +173,8 @@ namespace MAQUETTE
       int                             a_wr_bufsz,    // WrBuff Size
       int                             a_wr_lwm,      // WrBuff LowWaterMark
       char const*                     a_remote_addr, // To connect to: may be
-      int                             a_remote_port  //   empty/invalid
+      int                             a_remote_port, //   empty/invalid
+      int                             a_recv_batch = 0
     );
 
     //-----------------------------------------------------------------------//
@@ -481,6 +505,11 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     bool WithLibVMA() const { return m_useVMA; }
 
+    //-----------------------------------------------------------------------//
+    // Whether io_uring is used:                                             //
+    //-----------------------------------------------------------------------//
+    bool WithIOURing() const { return m_useURing; }
+
     //-----------------------------------------------------------------------//
     // Access to the Logger:                                                 //
     //-----------------------------------------------------------------------//
@@ -522,6 +551,16 @@ namespace MAQUETTE
     // "Clear": possibly decreases "m_topFD":
     void Clear(IO::FDInfo* a_info);
 
+    // Dispatching the Events received on a given FD (from any back-end):
+    void HandleEvents(int a_fd, uint32_t a_events);
+
+    // io_uring back-end support:
+    void PollURing        (int a_timeout_ms);
+    void URingPollAdd     (IO::FDInfo const& a_info) const;
+    void URingPollUpdate  (IO::FDInfo const& a_info) const;
+    void MaybeArmURingRecv(IO::FDInfo* a_info, bool a_update_poll);
+    void HandleURingRecv  (IO::FDInfo* a_info, IO::URing::Completion const&);
+
     // Internal event handlers -- invoked before any user-level handler:
     void HandleDataStream(IO::FDInfo* a_info);
     void HandleDataGram  (IO::FDInfo* a_info);
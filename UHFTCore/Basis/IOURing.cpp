@@ -0,0 +1,388 @@
+// vim:ts=2:et
+//===========================================================================//
+//                            "Basis/IOURing.cpp":                           //
+//          Minimal "io_uring" Wrapper (Raw SysCalls, w/o "liburing")        //
+//===========================================================================//
+#include "Basis/IOURing.h"
+#include "Basis/IOUtils.hpp"
+#include <utxx/error.hpp>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <ctime>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace MAQUETTE
+{
+namespace IO
+{
+  namespace
+  {
+    //-----------------------------------------------------------------------//
+    // Raw SysCall Wrappers:                                                 //
+    //-----------------------------------------------------------------------//
+    inline int SysSetUp(unsigned a_entries, io_uring_params* a_params)
+      { return int(syscall(__NR_io_uring_setup, a_entries, a_params)); }
+
+    inline int SysRegister
+      (int a_fd, unsigned a_opcode, void const* a_arg, unsigned a_nargs)
+      { return int(syscall(__NR_io_uring_register, a_fd, a_opcode, a_arg,
+                           a_nargs)); }
+
+    // Rounds up to a power of 2:
+    inline unsigned RoundUpPow2(unsigned a_n)
+    {
+      unsigned res = 1;
+      while (res < a_n)
+        res <<= 1;
+      return res;
+    }
+
+    // Pointer arithmetic over a mapped region:
+    template<typename T>
+    inline T* At(void* a_base, unsigned a_off)
+      { return reinterpret_cast<T*>(static_cast<char*>(a_base) + a_off); }
+  }
+
+  //=========================================================================//
+  // Non-Default Ctor:                                                       //
+  //=========================================================================//
+  URing::URing(unsigned a_sq_entries, unsigned a_cq_entries)
+  : m_ringFD      (-1),
+    m_features    (0),
+    m_sqRing      (MAP_FAILED),
+    m_sqRingSz    (0),
+    m_cqRing      (MAP_FAILED),
+    m_cqRingSz    (0),
+    m_sqes        (static_cast<io_uring_sqe*>(MAP_FAILED)),
+    m_sqesSz      (0),
+    m_sqHead      (nullptr),
+    m_sqTail      (nullptr),
+    m_sqMask      (0),
+    m_sqEntries   (0),
+    m_sqLocalTail (0),
+    m_toSubmit    (0),
+    m_cqHead      (nullptr),
+    m_cqTail      (nullptr),
+    m_cqMask      (0),
+    m_cqes        (nullptr),
+    m_bufRing     (nullptr),
+    m_bufRingSz   (0),
+    m_bufs        (nullptr),
+    m_bufsSz      (0),
+    m_nBufs       (0),
+    m_bufSz       (0),
+    m_bufGroup    (0),
+    m_bufTail     (0)
+  {
+    if (utxx::unlikely(a_sq_entries == 0 || a_cq_entries < a_sq_entries))
+      throw utxx::badarg_error("URing::Ctor: Invalid arg(s)");
+
+    //-----------------------------------------------------------------------//
+    // Create the Ring:                                                      //
+    //-----------------------------------------------------------------------//
+    // Try the most efficient flags first; if they are not supported by this
+    // kernel, fall back to the minimal set.
+    // NB: IORING_SETUP_SINGLE_ISSUER is NOT used: it binds the ring to the
+    // creating thread, whereas a Reactor may be constructed on one thread and
+    // run on another (eg by the parallel BackTest workers):
+    io_uring_params params;
+    memset(&params, '\0', sizeof(params));
+    params.flags      = IORING_SETUP_CQSIZE      | IORING_SETUP_CLAMP |
+                        IORING_SETUP_SUBMIT_ALL;
+    params.cq_entries = a_cq_entries;
+
+    m_ringFD = SysSetUp(a_sq_entries, &params);
+    if (m_ringFD < 0 && errno == EINVAL)
+    {
+      memset(&params, '\0', sizeof(params));
+      params.flags      = IORING_SETUP_CQSIZE | IORING_SETUP_CLAMP;
+      params.cq_entries = a_cq_entries;
+      m_ringFD          = SysSetUp(a_sq_entries, &params);
+    }
+    if (utxx::unlikely(m_ringFD < 0))
+      SystemError(-1, "URing::Ctor: io_uring_setup() Failed");
+
+    m_features  = params.features;
+
+    // We need time-outs on waits, and multi-shot ops, ie a reasonably recent
+    // kernel (5.19+); EXT_ARG is a good enough proxy for the former:
+    if (utxx::unlikely(!(m_features & IORING_FEAT_EXT_ARG)))
+    {
+      Close();
+      throw utxx::runtime_error
+            ("URing::Ctor: Kernel too old: IORING_FEAT_EXT_ARG required");
+    }
+
+    //-----------------------------------------------------------------------//
+    // Map the Rings:                                                        //
+    //-----------------------------------------------------------------------//
+    try
+    {
+      m_sqRingSz = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+      m_cqRingSz = params.cq_off.cqes  +
+                   params.cq_entries   * sizeof(io_uring_cqe);
+
+      bool single = (m_features & IORING_FEAT_SINGLE_MMAP);
+      if (single)
+        m_sqRingSz = m_cqRingSz = std::max<size_t>(m_sqRingSz, m_cqRingSz);
+
+      m_sqRing = mmap(nullptr, m_sqRingSz, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, m_ringFD, IORING_OFF_SQ_RING);
+      if (utxx::unlikely(m_sqRing == MAP_FAILED))
+        SystemError(-1, "URing::Ctor: mmap(SQ Ring) Failed");
+
+      m_cqRing =
+        single
+        ? m_sqRing
+        : mmap(nullptr, m_cqRingSz, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, m_ringFD, IORING_OFF_CQ_RING);
+      if (utxx::unlikely(m_cqRing == MAP_FAILED))
+        SystemError(-1, "URing::Ctor: mmap(CQ Ring) Failed");
+
+      m_sqesSz = params.sq_entries * sizeof(io_uring_sqe);
+      m_sqes   = static_cast<io_uring_sqe*>
+                 (mmap(nullptr, m_sqesSz, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, m_ringFD, IORING_OFF_SQES));
+      if (utxx::unlikely(m_sqes == MAP_FAILED))
+        SystemError(-1, "URing::Ctor: mmap(SQEs) Failed");
+    }
+    catch (...)
+    {
+      Close();
+      throw;
+    }
+
+    // SQ ring ptrs:
+    m_sqHead      = At<unsigned>(m_sqRing, params.sq_off.head);
+    m_sqTail      = At<unsigned>(m_sqRing, params.sq_off.tail);
+    m_sqMask      = *At<unsigned>(m_sqRing, params.sq_off.ring_mask);
+    m_sqEntries   = *At<unsigned>(m_sqRing, params.sq_off.ring_entries);
+    m_sqLocalTail = *m_sqTail;
+
+    // The SQ index array is an identity map (SQEs are always filled in order),
+    // so initialise it once and for all:
+    unsigned* sqArray = At<unsigned>(m_sqRing, params.sq_off.array);
+    for (unsigned i = 0; i < m_sqEntries; ++i)
+      sqArray[i] = i;
+
+    // CQ ring ptrs:
+    m_cqHead = At<unsigned>    (m_cqRing, params.cq_off.head);
+    m_cqTail = At<unsigned>    (m_cqRing, params.cq_off.tail);
+    m_cqMask = *At<unsigned>   (m_cqRing, params.cq_off.ring_mask);
+    m_cqes   = At<io_uring_cqe>(m_cqRing, params.cq_off.cqes);
+  }
+
+  //=========================================================================//
+  // Dtor:                                                                   //
+  //=========================================================================//
+  URing::~URing() noexcept
+    { Close(); }
+
+  //=========================================================================//
+  // "Close":                                                                //
+  //=========================================================================//
+  // Idempotent: Releases whatever has been allocated so far:
+  //
+  void URing::Close() noexcept
+  {
+    if (m_bufs != nullptr)
+    {
+      (void) munmap(m_bufs, m_bufsSz);
+      m_bufs = nullptr;
+    }
+    if (m_bufRing != nullptr)
+    {
+      // NB: Closing the ring FD automatically un-registers the BufRing:
+      (void) munmap(m_bufRing, m_bufRingSz);
+      m_bufRing = nullptr;
+    }
+    if (m_sqes != MAP_FAILED)
+    {
+      (void) munmap(m_sqes, m_sqesSz);
+      m_sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    }
+    if (m_cqRing != MAP_FAILED && m_cqRing != m_sqRing)
+      (void) munmap(m_cqRing, m_cqRingSz);
+    m_cqRing = MAP_FAILED;
+
+    if (m_sqRing != MAP_FAILED)
+    {
+      (void) munmap(m_sqRing, m_sqRingSz);
+      m_sqRing = MAP_FAILED;
+    }
+    if (m_ringFD >= 0)
+    {
+      (void) close(m_ringFD);
+      m_ringFD = -1;
+    }
+  }
+
+  //=========================================================================//
+  // "Enter":                                                                //
+  //=========================================================================//
+  int URing::Enter
+  (
+    unsigned    a_to_submit,
+    unsigned    a_min_complete,
+    unsigned    a_flags,
+    void const* a_arg,
+    size_t      a_arg_sz
+  )
+  {
+    int rc = 0;
+    do
+      rc = int(syscall(__NR_io_uring_enter, m_ringFD, a_to_submit,
+                       a_min_complete, a_flags, a_arg, a_arg_sz));
+    while (utxx::unlikely(rc < 0 && errno == EINTR));
+
+    // The following are not errors:
+    // ETIME: Time-out expired while waiting for CQEs;
+    // EBUSY: CQ overflow is pending, so no new SQEs could be submitted  until
+    //        the CQEs are harvested; they will be re-submitted on the next
+    //        call:
+    if (utxx::unlikely(rc < 0 && errno != ETIME && errno != EBUSY))
+      SystemError(-1, "URing::Enter: io_uring_enter() Failed");
+
+    if (rc > 0)
+    {
+      assert(unsigned(rc) <= m_toSubmit);
+      m_toSubmit -= unsigned(rc);
+    }
+    return rc;
+  }
+
+  //=========================================================================//
+  // "MakeSQRoom":                                                           //
+  //=========================================================================//
+  void URing::MakeSQRoom()
+  {
+    (void) Submit();
+    unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+
+    // If the kernel could not take any SQEs (EBUSY), we cannot harvest CQEs
+    // here on behalf of the Caller (they would be lost), so report an error:
+    if (utxx::unlikely(m_sqLocalTail - head >= m_sqEntries))
+      throw utxx::runtime_error
+            ("URing::GetSQE: SQ Ring is full, and the kernel does not accept "
+             "more SQEs (CQ overflow?): Entries=", m_sqEntries);
+  }
+
+  //=========================================================================//
+  // "Submit":                                                               //
+  //=========================================================================//
+  int URing::Submit()
+  {
+    PublishSQEs();
+    return
+      (m_toSubmit == 0)
+      ? 0
+      : Enter(m_toSubmit, 0, 0, nullptr, 0);
+  }
+
+  //=========================================================================//
+  // "SubmitAndGet":                                                         //
+  //=========================================================================//
+  int URing::SubmitAndGet(Completion* a_out, int a_max, int a_timeout_ms)
+  {
+    assert(a_out != nullptr && a_max > 0);
+    PublishSQEs();
+
+    //-----------------------------------------------------------------------//
+    // Do we need to enter the kernel at all?                                //
+    //-----------------------------------------------------------------------//
+    unsigned head  = *m_cqHead;
+    unsigned tail  = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+    bool     empty = (head == tail);
+
+    if (m_toSubmit != 0 || (empty && a_timeout_ms != 0))
+    {
+      if (!empty || a_timeout_ms == 0)
+        // Submit only:
+        (void) Enter(m_toSubmit, 0, 0, nullptr, 0);
+      else
+      if (a_timeout_ms < 0)
+        // Submit and wait indefinitely:
+        (void) Enter(m_toSubmit, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+      else
+      {
+        // Submit and wait with a time-out:
+        timespec ts;
+        ts.tv_sec  = a_timeout_ms / 1000;
+        ts.tv_nsec = long(a_timeout_ms % 1000) * 1000000L;
+
+        io_uring_getevents_arg arg;
+        memset(&arg, '\0', sizeof(arg));
+        arg.sigmask_sz = _NSIG / 8;
+        arg.ts         = uint64_t(reinterpret_cast<uintptr_t>(&ts));
+
+        (void) Enter(m_toSubmit, 1,
+                     IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG,
+                     &arg, sizeof(arg));
+      }
+      tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+    }
+    //-----------------------------------------------------------------------//
+    // Harvest the CQEs:                                                     //
+    //-----------------------------------------------------------------------//
+    int n = 0;
+    for (; head != tail && n < a_max; ++head, ++n)
+    {
+      io_uring_cqe const* cqe = m_cqes + (head & m_cqMask);
+      a_out[n].m_userData     = cqe->user_data;
+      a_out[n].m_res          = cqe->res;
+      a_out[n].m_flags        = cqe->flags;
+    }
+    // Release the harvested slots:
+    __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+    return n;
+  }
+
+  //=========================================================================//
+  // "SetUpBufRing":                                                         //
+  //=========================================================================//
+  void URing::SetUpBufRing(unsigned a_nbufs, unsigned a_buf_sz, uint16_t a_bgid)
+  {
+    if (utxx::unlikely(a_nbufs == 0 || a_nbufs > 32768 || a_buf_sz == 0 ||
+                       m_bufRing != nullptr))
+      throw utxx::badarg_error("URing::SetUpBufRing: Invalid arg(s)");
+
+    m_nBufs    = RoundUpPow2(a_nbufs);
+    m_bufSz    = a_buf_sz;
+    m_bufGroup = a_bgid;
+
+    // The ring itself must be page-aligned, so use "mmap":
+    m_bufRingSz = m_nBufs * sizeof(io_uring_buf);
+    void* ring  = mmap(nullptr, m_bufRingSz, PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (utxx::unlikely(ring == MAP_FAILED))
+      SystemError(-1, "URing::SetUpBufRing: mmap(BufRing) Failed");
+    m_bufRing = static_cast<io_uring_buf_ring*>(ring);
+
+    m_bufsSz  = size_t(m_nBufs) * m_bufSz;
+    void* bufs = mmap(nullptr, m_bufsSz, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+    if (utxx::unlikely(bufs == MAP_FAILED))
+      SystemError(-1, "URing::SetUpBufRing: mmap(Bufs) Failed");
+    m_bufs = static_cast<char*>(bufs);
+
+    // Register the ring:
+    io_uring_buf_reg reg;
+    memset(&reg, '\0', sizeof(reg));
+    reg.ring_addr    = uint64_t(reinterpret_cast<uintptr_t>(m_bufRing));
+    reg.ring_entries = m_nBufs;
+    reg.bgid         = m_bufGroup;
+
+    if (utxx::unlikely
+       (SysRegister(m_ringFD, IORING_REGISTER_PBUF_RING, &reg, 1) < 0))
+      SystemError(-1, "URing::SetUpBufRing: IORING_REGISTER_PBUF_RING Failed");
+
+    // Hand all buffers over to the kernel:
+    m_bufTail = 0;
+    for (unsigned bid = 0; bid < m_nBufs; ++bid)
+      RecycleBuf(bid);
+  }
+} // End namespace IO
+} // End namespace MAQUETTE
@@ -0,0 +1,218 @@
+// vim:ts=2:et
+//===========================================================================//
+//                             "Basis/IOURing.h":                            //
+//          Minimal "io_uring" Wrapper (Raw SysCalls, w/o "liburing")        //
+//===========================================================================//
+// Only the functionality required by "EPollReactor" is provided: SQE acquisi-
+// tion, batched submission, harvesting of CQEs (with an optional time-out) and
+// a Provided Buffers Ring for multi-shot "recv"s. All ring memory is mapped at
+// construction time, so there is no dynamic memory allocation afterwards:
+//
+#pragma  once
+
+#include <utxx/compiler_hints.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <linux/io_uring.h>
+#include <cstdint>
+#include <cstddef>
+#include <cassert>
+
+namespace MAQUETTE
+{
+namespace IO
+{
+  //=========================================================================//
+  // "URing" Class:                                                          //
+  //=========================================================================//
+  class URing: public boost::noncopyable
+  {
+  public:
+    //=======================================================================//
+    // "Completion": A copy of a CQE:                                        //
+    //=======================================================================//
+    // CQEs are copied out of the CQ ring before being processed, so that the
+    // ring slots can be released to the kernel at once  (and the processing
+    // may throw exceptions without leaving the ring in an undefined state):
+    //
+    struct Completion
+    {
+      uint64_t  m_userData;
+      int32_t   m_res;
+      uint32_t  m_flags;
+    };
+
+  private:
+    //=======================================================================//
+    // Data Flds:                                                            //
+    //=======================================================================//
+    int               m_ringFD;
+    unsigned          m_features;     // IORING_FEAT_*
+
+    // Memory-mapped rings:
+    void*             m_sqRing;
+    size_t            m_sqRingSz;
+    void*             m_cqRing;       // May be same as "m_sqRing"
+    size_t            m_cqRingSz;
+    io_uring_sqe*     m_sqes;
+    size_t            m_sqesSz;
+
+    // SQ ring ptrs and state:
+    unsigned*         m_sqHead;       // Written by the kernel
+    unsigned*         m_sqTail;       // Written by us
+    unsigned          m_sqMask;
+    unsigned          m_sqEntries;
+    unsigned          m_sqLocalTail;  // Incl SQEs not yet published
+    unsigned          m_toSubmit;     // Published but not yet submitted
+
+    // CQ ring ptrs:
+    unsigned*         m_cqHead;       // Written by us
+    unsigned*         m_cqTail;       // Written by the kernel
+    unsigned          m_cqMask;
+    io_uring_cqe*     m_cqes;
+
+    // Provided Buffers Ring (optional, see "SetUpBufRing"):
+    io_uring_buf_ring* m_bufRing;
+    size_t            m_bufRingSz;
+    char*             m_bufs;
+    size_t            m_bufsSz;
+    unsigned          m_nBufs;        // Power of 2
+    unsigned          m_bufSz;
+    uint16_t          m_bufGroup;
+    uint16_t          m_bufTail;
+
+    // Default Ctor is deleted:
+    URing() = delete;
+
+  public:
+    //=======================================================================//
+    // Non-Default Ctor, Dtor:                                               //
+    //=======================================================================//
+    // NB: Both sizes are rounded up to powers of 2, and clamped to the max
+    // allowed values, by the kernel:
+    //
+    URing(unsigned a_sq_entries, unsigned a_cq_entries);
+
+    ~URing() noexcept;
+
+    //=======================================================================//
+    // Submission:                                                           //
+    //=======================================================================//
+    //-----------------------------------------------------------------------//
+    // "GetSQE":                                                             //
+    //-----------------------------------------------------------------------//
+    // Returns a zeroed-out SQE to be filled in by the Caller; it will be sent
+    // to the kernel on the next "Submit" or "SubmitAndGet". If the SQ ring is
+    // full, pending SQEs are submitted first (see "MakeSQRoom"), so the result
+    // is never NULL:
+    //
+    io_uring_sqe* GetSQE()
+    {
+      unsigned head = __atomic_load_n(m_sqHead, __ATOMIC_ACQUIRE);
+      if (utxx::unlikely(m_sqLocalTail - head >= m_sqEntries))
+        MakeSQRoom();
+
+      io_uring_sqe* sqe = m_sqes + (m_sqLocalTail & m_sqMask);
+      ++m_sqLocalTail;
+      __builtin_memset(sqe, 0, sizeof(io_uring_sqe));
+      return sqe;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "HasPending":                                                         //
+    //-----------------------------------------------------------------------//
+    bool HasPending() const
+      { return m_toSubmit != 0 || m_sqLocalTail != *m_sqTail; }
+
+    //-----------------------------------------------------------------------//
+    // "Submit":                                                             //
+    //-----------------------------------------------------------------------//
+    // Submits all pending SQEs without waiting for completions. Returns the
+    // number of SQEs consumed by the kernel:
+    //
+    int Submit();
+
+    //-----------------------------------------------------------------------//
+    // "SubmitAndGet":                                                       //
+    //-----------------------------------------------------------------------//
+    // Submits all pending SQEs (if any), then, if the CQ ring is empty, waits
+    // for at least 1 CQE for up to "a_timeout_ms" (< 0: indefinitely, 0: no
+    // wait at all). Copies up to "a_max" available CQEs into "a_out" and re-
+    // leases them to the kernel. Returns the number of CQEs copied.
+    // NB: If there is nothing to submit and CQEs are already available, no
+    // syscall is made at all:
+    //
+    int SubmitAndGet(Completion* a_out, int a_max, int a_timeout_ms);
+
+    //=======================================================================//
+    // Provided Buffers Ring:                                                //
+    //=======================================================================//
+    // "SetUpBufRing":
+    // Allocates "a_nbufs" (rounded up to a power of 2) buffers of "a_buf_sz"
+    // bytes each, and registers them with the kernel as Buffer Group "a_bgid"
+    // (to be used with IOSQE_BUFFER_SELECT):
+    //
+    void SetUpBufRing(unsigned a_nbufs, unsigned a_buf_sz, uint16_t a_bgid);
+
+    // Buffer by its ID (as returned in CQE flags):
+    char* GetBuf(unsigned a_bid) const
+    {
+      assert(m_bufs != nullptr && a_bid < m_nBufs);
+      return m_bufs + size_t(a_bid) * m_bufSz;
+    }
+
+    // Return a consumed buffer to the kernel:
+    void RecycleBuf(unsigned a_bid)
+    {
+      assert(m_bufRing != nullptr && a_bid < m_nBufs);
+      // NB: Do not use "m_bufRing->bufs": in C++, the kernel's flex-array
+      // macro puts it at a wrong offset (after an empty struct member):
+      io_uring_buf* buf =
+        reinterpret_cast<io_uring_buf*>(m_bufRing) +
+        (m_bufTail & (m_nBufs - 1));
+      buf->addr = uint64_t(reinterpret_cast<uintptr_t>(GetBuf(a_bid)));
+      buf->len  = m_bufSz;
+      buf->bid  = uint16_t(a_bid);
+      ++m_bufTail;
+      __atomic_store_n(&(m_bufRing->tail), m_bufTail, __ATOMIC_RELEASE);
+    }
+
+    uint16_t GetBufGroup() const { return m_bufGroup; }
+    unsigned GetBufSize () const { return m_bufSz;    }
+
+    //=======================================================================//
+    // Misc:                                                                 //
+    //=======================================================================//
+    int      GetFD      () const { return m_ringFD;   }
+    unsigned GetFeatures() const { return m_features; }
+
+  private:
+    // Release all resources (used by the Dtor, and on Ctor failures):
+    void Close() noexcept;
+
+    // Slow path of "GetSQE": Submits the pending SQEs to free up the SQ ring;
+    // throws if the kernel did not consume any of them (EBUSY: a CQ overflow
+    // is pending, so the CQEs must be harvested by "SubmitAndGet" first):
+    void MakeSQRoom();
+
+    // Publish locally-filled SQEs to the kernel-visible SQ tail:
+    void PublishSQEs()
+    {
+      if (m_sqLocalTail != *m_sqTail)
+      {
+        m_toSubmit += m_sqLocalTail - *m_sqTail;
+        __atomic_store_n(m_sqTail, m_sqLocalTail, __ATOMIC_RELEASE);
+      }
+    }
+
+    // "io_uring_enter" with EINTR handling:
+    int Enter
+    (
+      unsigned    a_to_submit,
+      unsigned    a_min_complete,
+      unsigned    a_flags,
+      void const* a_arg,
+      size_t      a_arg_sz
+    );
+  };
+} // End namespace IO
+} // End namespace MAQUETTE
@@ -5,6 +5,7 @@
 //===========================================================================//
 #include "Basis/IOUtils.hpp"
 #include "Basis/ConfigUtils.hpp"
+#include "Basis/BinLog.h"
 
 #include <spdlog/common.h>
 #include <spdlog/spdlog.h>
@@ -204,14 +205,14 @@ namespace IO
 
     // Reset all Handlers:
     m_htype      = HandlerT::UNDEFINED;
-    m_rh         = ReadHandler();
-    m_ch         = ConnectHandler();
-    m_rch        = RecvHandler();
-    m_rih        = RawInputHandler();
-    m_th         = TimerHandler();
-    m_sh         = SigHandler();
-    m_ah         = AcceptHandler();
-    m_eh         = ErrHandler();
+    m_rh.Reset();
+    m_ch.Reset();
+    m_rch.Reset();
+    m_rih.Reset();
+    m_th.Reset();
+    m_sh.Reset();
+    m_ah.Reset();
+    m_eh.Reset();
 
     // Remove the Buffers (if any).
     // POTENTIAL DANGER HERE: In some cases,  "Clear" is invoked  via "Remove"
@@ -251,6 +252,8 @@ namespace IO
     m_handShaken  = false;
     memset(&m_peer, 0, sizeof(m_peer));
     m_peer_len    = 0;
+    m_recvBatch   = 0;
+    m_uringRecv   = false;
 
     // Verify the "msghdr" relationships:
     m_iov.iov_base          = nullptr;
@@ -1173,6 +1176,11 @@ namespace IO
     // the main thread. FIXME: This might be a serious real-time issue:
     try
     {
+      // "binlog:<Path>": Binary log, formatted offline (see "Basis/BinLog.h");
+      // Size and Rotations are not used in this case:
+      if (logLC.compare(0, 7, "binlog:") == 0)
+        return BinLog::MkLogger(a_logger_name, a_log_output.substr(7));
+
       std::shared_ptr<spdlog::logger> retLogger;
       retLogger =
         (logLC == "stderr")
@@ -12,9 +12,13 @@
 #include <utxx/time_val.hpp>
 #include <utxx/buffer.hpp>
 #include <utxx/enum.hpp>
+#include <utxx/compiler_hints.hpp>
 #include <boost/core/noncopyable.hpp>
 #include <gnutls/gnutls.h>
 #include <functional>
+#include <type_traits>
+#include <cassert>
+#include <cstddef>
 #include <sys/signalfd.h>
 #include <sys/un.h>
 #include <netinet/in.h>
@@ -172,6 +176,197 @@ namespace IO
     );
   };
 
+  //=========================================================================//
+  // "Thunk": Static-Dispatch Call-Back:                                     //
+  //=========================================================================//
+  // A pair (StubPtr, ObjPtr), where the Stub is generated at compile time for
+  // a particular concrete class "T" and its method, so the method call inside
+  // the Stub is a direct one (and the method body can be inlined into it).The
+  // only indirection left is the call of the Stub itself. Unlike  "std::func-
+  // tion", a Thunk is trivially copyable and never allocates; the object must
+  // outlive the Thunk. Use "MkThunk" (below) to create Thunks:
+  //
+  template<typename Sig> class Thunk;
+
+  template<typename R, typename... Args>
+  class Thunk<R(Args...)>
+  {
+  public:
+    using StubT = R (*)(void* a_obj, Args... a_args);
+
+  private:
+    StubT   m_stub = nullptr;
+    void*   m_obj  = nullptr;
+
+  public:
+    Thunk() = default;
+
+    Thunk(StubT a_stub, void* a_obj)
+    : m_stub(a_stub),
+      m_obj (a_obj)
+    {}
+
+    explicit operator bool() const { return (m_stub != nullptr); }
+
+    StubT GetStub() const { return m_stub; }
+    void* GetObj () const { return m_obj;  }
+
+    R operator()(Args... a_args) const
+    {
+      assert(m_stub != nullptr);
+      return m_stub(m_obj, a_args...);
+    }
+
+    // The Stub for "T::Method":
+    template<typename T, R (T::*Method)(Args...)>
+    static R Stub(void* a_obj, Args... a_args)
+      { return (static_cast<T*>(a_obj)->*Method)(a_args...); }
+  };
+
+  //-------------------------------------------------------------------------//
+  // "MkThunk":                                                              //
+  //-------------------------------------------------------------------------//
+  // Usage: MkThunk<&Connector::OnRead>(connectorPtr).
+  // The resulting Thunk type is derived from the Method type:
+  //
+  template<typename M> struct MethodTraits;
+
+  template<typename T, typename R, typename... Args>
+  struct MethodTraits<R (T::*)(Args...)>
+  {
+    using ClassT = T;
+    using ThunkT = Thunk<R(Args...)>;
+  };
+
+  template<auto Method>
+  inline typename MethodTraits<decltype(Method)>::ThunkT MkThunk
+    (typename MethodTraits<decltype(Method)>::ClassT* a_obj)
+  {
+    using Traits = MethodTraits<decltype(Method)>;
+    using ThunkT = typename Traits::ThunkT;
+    assert(a_obj != nullptr);
+    return
+      ThunkT(&ThunkT::template Stub<typename Traits::ClassT, Method>, a_obj);
+  }
+
+  //=========================================================================//
+  // "Handler": Static-Dispatch Thunk or "std::function":                    //
+  //=========================================================================//
+  // The Call-Back type stored in "FDInfo".  It is constructible from a Thunk
+  // (static dispatch: the Reactor makes 1 indirect call,  directly into  the
+  // concrete Connector's method), or from any callable object, incl lambdas.
+  // In both cases, the Handler is just a Thunk (2 ptrs), so that "FDInfo"
+  // stays compact: a callable object is moved into a heap-allocated "std::
+  // function" (owned by the Handler), and the Thunk points to "FuncStub" and
+  // that "std::function"; so this mode costs an extra indirect call:
+  //
+  template<typename Sig> class Handler;
+
+  template<typename R, typename... Args>
+  class Handler<R(Args...)>
+  {
+  public:
+    using ThunkT = Thunk<R(Args...)>;
+    using FuncT  = std::function<R(Args...)>;
+
+  private:
+    ThunkT  m_thunk;
+
+    static R FuncStub(void* a_obj, Args... a_args)
+      { return (*static_cast<FuncT*>(a_obj))(a_args...); }
+
+    // Does this Handler own a "std::function"?
+    bool IsOwner() const { return m_thunk.GetStub() == &FuncStub; }
+
+    FuncT const& GetFunc() const
+    {
+      assert(IsOwner());
+      return *static_cast<FuncT const*>(m_thunk.GetObj());
+    }
+
+    void MkFunc(FuncT&& a_func)
+    {
+      if (bool(a_func))
+        m_thunk = ThunkT(&FuncStub, new FuncT(std::move(a_func)));
+    }
+
+  public:
+    // Default Ctor: Empty Handler:
+    Handler() = default;
+    Handler(std::nullptr_t) {}
+
+    // Static Dispatch:
+    Handler(ThunkT const& a_thunk)
+    : m_thunk(a_thunk)
+    {}
+
+    // Dynamic Dispatch: From any other callable object (eg a lambda):
+    template
+    <
+      typename C,
+      typename = std::enable_if_t
+      <
+        !std::is_same_v<std::decay_t<C>, Handler> &&
+        !std::is_same_v<std::decay_t<C>, ThunkT>  &&
+        !std::is_same_v<std::decay_t<C>, std::nullptr_t> &&
+        std::is_constructible_v<FuncT, C&&>
+      >
+    >
+    Handler(C&& a_callable)
+    : m_thunk()
+      { MkFunc(FuncT(std::forward<C>(a_callable))); }
+
+    // Copying clones the owned "std::function" (if any):
+    Handler(Handler const& a_right)
+    : m_thunk(a_right.m_thunk)
+    {
+      if (a_right.IsOwner())
+      {
+        m_thunk = ThunkT();
+        MkFunc(FuncT(a_right.GetFunc()));
+      }
+    }
+
+    Handler(Handler&& a_right) noexcept
+    : m_thunk(a_right.m_thunk)
+      { a_right.m_thunk = ThunkT(); }
+
+    Handler& operator=(Handler const& a_right)
+    {
+      if (this != &a_right)
+        *this = Handler(a_right);
+      return *this;
+    }
+
+    Handler& operator=(Handler&& a_right) noexcept
+    {
+      if (this != &a_right)
+      {
+        Reset();
+        m_thunk         = a_right.m_thunk;
+        a_right.m_thunk = ThunkT();
+      }
+      return *this;
+    }
+
+    ~Handler() { Reset(); }
+
+    explicit operator bool() const { return bool(m_thunk); }
+
+    bool IsStatic() const { return bool(m_thunk) && !IsOwner(); }
+
+    R operator()(Args... a_args) const { return m_thunk(a_args...); }
+
+    void Reset()
+    {
+      if (IsOwner())
+        delete static_cast<FuncT*>(m_thunk.GetObj());
+      m_thunk = ThunkT();
+    }
+  };
+  static_assert(sizeof(Handler<void(int)>) == 2 * sizeof(void*),
+                "Handler must be just a Thunk");
+
   //=========================================================================//
   // "FDInfo" Class: File Descriptor with Extended Details:                  //
   //=========================================================================//
@@ -180,18 +375,18 @@ namespace IO
     //=======================================================================//
     // Lowest-Level Event-Handling Call-Back Types:                          //
     //=======================================================================//
-    // NB: Call-Back invovation is performed via the "std::function" mechanism.
-    // The reason is the following:
+    // NB: Call-Backs are stored as "Handler"s (see above), ie either as Thunks
+    // or as "std::function"s:
     // (*) because call-backs are invoked through the FD table anyway, a fully-
     //     static interface based on variadic templates would not be consistent
-    //     with that:  if we either get an advantage of a static interface,  we
-    //     must lose the advantage of table-driven invocation (XXX currently no
-    //     way of getting both of them);
-    // (*) then we are left either with low-level type erasure via the "void*"
-    //     to the underlying object, or "std::function", or the classical vir-
-    //     tual methods mechanism; of then, "std::function" is known to have a
-    //     very low invocation overhead (maybe just 2 instructions on top of
-    //     the direct call), and is the most flexible, hence it is selected.
+    //     with that;
+    // (*) a Thunk (low-level type erasure via "void*" to the underlying object
+    //     plus a compile-time-generated Stub) gets us both: table-driven invo-
+    //     cation, and a direct (inlinable) call of the concrete Connector's me-
+    //     thod inside the Stub. Connectors on the critical path should  regis-
+    //     ter Thunks made by "MkThunk";
+    // (*) "std::function" (eg wrapping a lambda) is still supported  as  the
+    //     most flexible mode, at the cost of an extra indirect call:
     //
     //-----------------------------------------------------------------------//
     // "ReadHandler":                                                        //
@@ -209,8 +404,8 @@ namespace IO
     //     <  0: reset the buffer and stop immediately:
     //
     using ReadHandler =
-          std::function<int (int a_fd,      char const* a_buff, int a_size,
-                             utxx::time_val a_ts_recv)>;
+          Handler<int (int a_fd,      char const* a_buff, int a_size,
+                       utxx::time_val a_ts_recv)>;
 
     //-----------------------------------------------------------------------//
     // "RecvHandler":                                                        //
@@ -222,9 +417,9 @@ namespace IO
     //   "true" to continue, "false" to stop immediately:
     //
     using RecvHandler =
-          std::function<bool(int  a_fd,     char const* a_buff, int a_size,
-                             utxx::time_val a_ts_recv,
-                             IUAddr const*  a_sender_addr)>;
+          Handler<bool(int  a_fd,     char const* a_buff, int a_size,
+                       utxx::time_val a_ts_recv,
+                       IUAddr const*  a_sender_addr)>;
 
     // XXX: There is currently no "{Write,Send,SendTo}Handler" (refer to "Send"
     // for a detailed discussion of Read/Write asymmetry)...
@@ -239,17 +434,17 @@ namespace IO
     // Client; in partricular, no buffers for such sockets is provided   by the
     // Reactor:
     //
-    using RawInputHandler = std::function<void(int a_fd)>;
+    using RawInputHandler = Handler<void(int a_fd)>;
 
     //-----------------------------------------------------------------------//
     // "TimerHandler", "SigHandler":                                         //
     //-----------------------------------------------------------------------//
     // This handler type is for reacting to Timer events:
-    using TimerHandler = std::function<void(int a_fd)>;
+    using TimerHandler = Handler<void(int a_fd)>;
 
     // This handler type is for reacting to Signal events:
     using SigHandler   =
-          std::function<void(int a_fd, signalfd_siginfo const& a_si)>;
+          Handler<void(int a_fd, signalfd_siginfo const& a_si)>;
 
     //-----------------------------------------------------------------------//
     // "AcceptHandler":                                                      //
@@ -263,7 +458,7 @@ namespace IO
     // of the connected Client (its length is determined by the socket domain):
     //
     using AcceptHandler =
-          std::function
+          Handler
           <void(int a_acceptor_fd, int a_client_fd, IUAddr const* a_addr)>;
 
     //-----------------------------------------------------------------------//
@@ -275,7 +470,7 @@ namespace IO
     // TIME on TLS HandShake completion; the CallEE should be able to distingu-
     // ish between the two states (TCP Connected / TLS HandShaken):
     //
-    using ConnectHandler = std::function<void(int a_fd)>;
+    using ConnectHandler = Handler<void(int a_fd)>;
 
     //-----------------------------------------------------------------------//
     // "ErrHandler":                                                         //
@@ -293,8 +488,8 @@ namespace IO
     // the CallEE via the FD:
     //
     using ErrHandler =
-          std::function<void(int  a_fd,  int a_err_code,  uint32_t a_events,
-                             char const* a_msg)>;
+          Handler<void(int  a_fd,  int a_err_code,  uint32_t a_events,
+                       char const* a_msg)>;
     //-----------------------------------------------------------------------//
     // "GenericHandler":                                                     //
     //-----------------------------------------------------------------------//
@@ -366,6 +561,15 @@ namespace IO
     mutable int               m_peer_len    = 0;
     mutable IUAddr            m_bound{};             // Local bind IP
 
+    // For DGram sockets only: if > 0, incoming DataGrams are received in bat-
+    // ches of up to "m_recvBatch" per "recvmmsg" syscall,   rather than  one
+    // "recvmsg" per DataGram:
+    int                       m_recvBatch   = 0;
+
+    // For Stream sockets with the io_uring back-end only: is a multi-shot RECV
+    // armed on this FD (then readability events are not used for reading)?
+    mutable bool              m_uringRecv   = false;
+
     // UserData  (up to 64 bytes, can be installed directly in "FDInfo" for ef-
     // ficiency):
     UserData                  m_userData {};
@@ -532,6 +736,11 @@ namespace IO
   //=========================================================================//
   // Logger Factory:                                                         //
   //=========================================================================//
+  // "a_log_output" is "stdout", "stderr", a file path (rotated), or "binlog:"
+  // followed by a file path: then the "LOG_*" macros write binary records to
+  // it, formatted offline by "BinLogDecode" (see "Basis/BinLog.h"); the size
+  // and rotations params are not used in that case:
+  //
   std::shared_ptr<spdlog::logger> MkLogger
   (
     std::string const&  a_logger_name,
@@ -22,6 +22,7 @@
 #include <cerrno>
 #include <csignal>
 #include <type_traits>
+#include <algorithm>
 #include <fcntl.h>
 #include <netdb.h>
 #include <sys/types.h>
@@ -489,7 +490,7 @@ namespace IO
     // Process what we got (or do nothing if no UDP msgs have been received):
     for (int i = 0; i < nrx; ++i)
     {
-      UDPRX*  udprx     = a_udprxs + nrx;
+      UDPRX*  udprx     = a_udprxs + i;
       msghdr* mh        = &(udprx->m_mh);
       iovec&  iov       = mh->msg_iov[0];
       char*   buff      = static_cast<char*>(iov.iov_base);
@@ -523,6 +524,131 @@ namespace IO
     // All Done!
   }
 
+  //=========================================================================//
+  // "RecvMMsgUntilEAgain":                                                  //
+  //=========================================================================//
+  // Same semantics as "RecvUntilEAgain" above  (incl the Action invoked with
+  // empty args at the end), but DataGrams are received in batches of up to
+  // "a_info.m_recvBatch" per "recvmmsg" syscall. Each batch is processed  im-
+  // mediately after being received, so "a_udprxs" are re-used from one batch
+  // to the next one, and there is no limit on the total number of DataGrams
+  // received in one invocation:
+  // NB: "a_mmsgs[i].msg_hdr" must be a copy of "a_udprxs[i].m_mh" (ie point to
+  // the buffers of "a_udprxs[i]"); this is set up by the Reactor:
+  //
+  template<typename Action, typename ErrHandler>
+  inline void RecvMMsgUntilEAgain
+  (
+    FDInfo     const& a_info,
+    UDPRX*            a_udprxs,
+    mmsghdr*          a_mmsgs,      // Of same length as "a_udprxs"
+    int               a_nu,         // #(UDPRXs)
+    Action     const& a_action,
+    ErrHandler const& a_on_error,
+    char       const* a_where
+  )
+  {
+    //-----------------------------------------------------------------------//
+    // Checks:                                                               //
+    //-----------------------------------------------------------------------//
+    assert(a_where != nullptr && a_udprxs != nullptr && a_mmsgs != nullptr &&
+           a_nu > 0);
+
+    int                 fd    = a_info.m_fd;
+    DEBUG_ONLY(uint64_t iid   = a_info.m_inst_id;)
+    int                 batch = std::min<int>(a_info.m_recvBatch, a_nu);
+    assert(fd >= 0 && iid != 0 && batch > 0);
+
+    //-----------------------------------------------------------------------//
+    // The RX Loop (over batches):                                           //
+    //-----------------------------------------------------------------------//
+    while (true)
+    {
+      // Reset the value-result flds of all "msghdr"s in the batch, as they are
+      // over-written by the prev "recvmmsg":
+      for (int i = 0; i < batch; ++i)
+      {
+        mmsghdr& mm             = a_mmsgs[i];
+        assert(mm.msg_hdr.msg_iov     == &(a_udprxs[i].m_iov) &&
+               mm.msg_hdr.msg_control ==   a_udprxs[i].m_cmsg);
+        mm.msg_hdr.msg_namelen    = sizeof(IUAddr);
+        mm.msg_hdr.msg_controllen = sizeof(a_udprxs[i].m_cmsg);
+        mm.msg_hdr.msg_flags      = 0;
+        mm.msg_len                = 0;
+      }
+
+      // Skip EINTR events, as in "RecvUntilEAgain". NB: The socket is non-
+      // blocking and no time-out is given, so "recvmmsg" returns as many dgrams
+      // (up to "batch") as are currently available:
+      int nrx = 0;
+      do
+        nrx = recvmmsg(fd, a_mmsgs, unsigned(batch), 0, nullptr);
+      while
+        (utxx::unlikely(nrx < 0 && errno == EINTR));
+
+      if (nrx < 0 && errno == EAGAIN)
+        // No more data are available -- this is a normal end of reading in the
+        // non-blocking mode:
+        break;
+      else
+      if (utxx::unlikely(nrx <= 0))
+      {
+        // Any other error (NB: if an error occurs after some dgrams have been
+        // received, "recvmmsg" returns those dgrams, and the error is reported
+        // on the next call):
+        int  ec = GetSocketError(fd);
+        a_on_error(nrx, ec);
+        break;
+      }
+      assert(0 < nrx && nrx <= batch);
+
+      //---------------------------------------------------------------------//
+      // Process the batch just received:                                    //
+      //---------------------------------------------------------------------//
+      for (int i = 0; i < nrx; ++i)
+      {
+        msghdr* mh     = &(a_mmsgs[i].msg_hdr);
+        int     n      = int(a_mmsgs[i].msg_len);
+        iovec&  iov    = mh->msg_iov[0];
+        char*   buff   = static_cast<char*>(iov.iov_base);
+        int     buffSz = int(iov.iov_len);
+        assert(buff != nullptr && buffSz > 0 && 0 <= n && n <= buffSz);
+
+        // Truncated DataGrams are errors, same as in "RecvUntilEAgain":
+        if (utxx::unlikely(n == buffSz || (mh->msg_flags & MSG_TRUNC) != 0))
+          throw utxx::runtime_error
+                ("RecvMMsgUntilEAgain(", a_where, "): Buffer OverFlow: FD=",
+                 fd);
+
+        // Per-DataGram kernel TimeStamp:
+        UDPRX*  udprx  = a_udprxs + i;
+        udprx->m_len   = n;
+        udprx->m_ts    = GetRXTime(mh);
+
+        IUAddr const* fromAddr = static_cast<IUAddr const*>(mh->msg_name);
+        assert(mh->msg_namelen <= sizeof(IUAddr));
+
+        bool cont = a_action(buff, n, udprx->m_ts, fromAddr);
+
+        // As in "RecvUntilEAgain": the FDInfo may have been destroyed by the
+        // Action, in which case it must have returned False:
+        assert(!cont || (a_info.m_fd == fd && a_info.m_inst_id == iid));
+
+        if (utxx::unlikely(!cont))
+          return;
+      }
+      // If the batch was not filled up, the socket RX queue has been drained,
+      // so there is no need for another syscall just to get EAGAIN (any dgrams
+      // arriving later will produce a new Readability event):
+      if (nrx < batch)
+        break;
+    }
+    // If we got here, signal EndOfDataChunk:
+    (void) a_action(nullptr, 0, utxx::time_val(), nullptr);
+
+    // All Done!
+  }
+
   //=========================================================================//
   // "SendUntilEAgain":                                                      //
   //=========================================================================//
@@ -0,0 +1,387 @@
+// vim:ts=2:et
+//===========================================================================//
+//                             "Basis/KeyIdx.hpp":                           //
+//     Fixed-Capacity Hash Index over 16-Byte Keys (SecIDs, SymKeys etc)     //
+//===========================================================================//
+// Maps 16-byte keys into positional idxs in some external array (of Order-
+// Books, SecDefs, Req12s etc). This is an open-addressing (linear probing)
+// table: the keys are stored in the slots themselves, so a lookup is typical-
+// ly a single 16-byte compare within one cache line, with no ptr chasing. En-
+// tries are only ever inserted (never removed), so the index grows along with
+// the array it refers to (a Key may be re-assigned to another Val though).
+// The table is at most half full. As the obj contains no ptrs, it can be pla-
+// ced in ShM. "KeyIdxDyn" is a variant with dynamically-allocated Slots (via
+// an Allocator, possibly a ShM one) which grows on demand:
+//
+#pragma  once
+
+#include "Basis/BaseTypes.hpp"
+#include "Basis/XXHash.hpp"
+#include <utxx/compiler_hints.hpp>
+#include <utxx/error.hpp>
+#include <boost/container/vector.hpp>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+
+namespace MAQUETTE
+{
+  //=========================================================================//
+  // "Key16":                                                                //
+  //=========================================================================//
+  struct Key16
+  {
+    uint64_t m_lo;
+    uint64_t m_hi;
+
+    bool operator==(Key16 const& a_right) const
+      { return ((m_lo ^ a_right.m_lo) | (m_hi ^ a_right.m_hi)) == 0; }
+  };
+
+  // From a SecID:
+  inline Key16 MkKey16(SecID a_sec_id)
+    { return Key16{a_sec_id, 0}; }
+
+  // From a "SymKey" (which is always 0-padded):
+  inline Key16 MkKey16(SymKey const& a_sym)
+  {
+    static_assert(sizeof(SymKey) == sizeof(Key16), "MkKey16");
+    Key16 res;
+    memcpy(&res, a_sym.data(), sizeof(res));
+    return res;
+  }
+
+  // From a C string: Returns "false" if the string is too long to be a valid
+  // "SymKey" (so it cannot be found in any "SymKey"-based index):
+  inline bool MkKey16(char const* a_str, Key16* a_res)
+  {
+    assert(a_str != nullptr && a_res != nullptr);
+    size_t len = strnlen(a_str, sizeof(SymKey));
+    if (utxx::unlikely(len >= sizeof(SymKey)))
+      return false;
+    a_res->m_lo = 0;
+    a_res->m_hi = 0;
+    memcpy(a_res, a_str, len);
+    return true;
+  }
+
+  // From an "ExchOrdID" (of any format): Numeric IDs are used as they are, and
+  // the others are replaced by a 128-bit hash (with the top bit set,  so they
+  // never clash with numeric ones). XXX: Hash collisions between different
+  // string IDs are not detected here;  the users verify the entries found:
+  //
+  inline Key16 MkKey16(ExchOrdID const& a_id)
+  {
+    if (a_id.IsNum())
+      return Key16{uint64_t(a_id.GetOrderID()), 0};
+    char const* str = a_id.ToString();
+    size_t      len = strnlen(str, ExchOrdID::StrSz);
+    return Key16{XXH64(str, len, XXHSeed),
+                 XXH64(str, len, ~XXHSeed) | (1UL << 63)};
+  }
+
+  //=========================================================================//
+  // "KeyIdxSlot" and Operations on Arrays of Slots:                         //
+  //=========================================================================//
+  // These are also used directly on pre-built indices which are stored in
+  // files (eg in "SecDefsCatalog"), so the Slot layout is fixed. "a_nslots"
+  // must be a power of 2:
+  //
+  struct KeyIdxSlot
+  {
+    Key16    m_key;
+    int32_t  m_val;     // (-1) if the Slot is empty
+    int32_t  m_dups;    // Number of repeated insertions of this Key
+  };
+  static_assert(sizeof(KeyIdxSlot) == 24, "KeyIdxSlot");
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxHash": A 64-bit Murmur3 finaliser over both halves of the Key:   //
+  //-------------------------------------------------------------------------//
+  inline unsigned KeyIdxHash(Key16 const& a_key, unsigned a_nslots)
+  {
+    assert(a_nslots >= 2 && (a_nslots & (a_nslots - 1)) == 0);
+    uint64_t h = a_key.m_lo ^ (a_key.m_hi * 0x9e3779b97f4a7c15UL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdUL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53UL;
+    h ^= h >> 33;
+    return unsigned(h) & (a_nslots - 1);
+  }
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxNSlots": The number of Slots required for a given Capacity:      //
+  //-------------------------------------------------------------------------//
+  inline unsigned KeyIdxNSlots(unsigned a_capacity)
+  {
+    unsigned n = 2;
+    while (n / 2 < a_capacity)
+      n *= 2;
+    return n;
+  }
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxClear":                                                          //
+  //-------------------------------------------------------------------------//
+  inline void KeyIdxClear(KeyIdxSlot* a_slots, unsigned a_nslots)
+  {
+    for (unsigned i = 0; i < a_nslots; ++i)
+      a_slots[i] = KeyIdxSlot{Key16{0, 0}, -1, 0};
+  }
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxReHash":                                                         //
+  //-------------------------------------------------------------------------//
+  // Moves all non-empty Slots (with their Vals and Dups) from "a_src" into the
+  // (normally larger) "a_dst", which is cleared first:
+  //
+  inline void KeyIdxReHash
+  (
+    KeyIdxSlot const* a_src,
+    unsigned          a_nsrc,
+    KeyIdxSlot*       a_dst,
+    unsigned          a_ndst
+  )
+  {
+    assert(a_src != nullptr && a_dst != nullptr && a_src != a_dst);
+    KeyIdxClear(a_dst, a_ndst);
+    for (unsigned i = 0; i < a_nsrc; ++i)
+    {
+      KeyIdxSlot const& slot = a_src[i];
+      if (slot.m_val < 0)
+        continue;
+      // NB: The Keys are distinct, so just find the 1st free Slot:
+      for (unsigned j = KeyIdxHash(slot.m_key, a_ndst); ;
+           j = (j + 1) & (a_ndst - 1))
+        if (a_dst[j].m_val < 0)
+        {
+          a_dst[j] = slot;
+          break;
+        }
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxInsert":                                                         //
+  //-------------------------------------------------------------------------//
+  // Returns "true" if the Key is new. Otherwise, the original Val is KEPT (so
+  // that lookups return the 1st inserted entry, same as a linear scan would),
+  // the Key is marked as a Dup, and "false" is returned. "a_n" is the curr
+  // number of distinct Keys, which must stay within "a_nslots"/2:
+  //
+  inline bool KeyIdxInsert
+  (
+    KeyIdxSlot*  a_slots,
+    unsigned     a_nslots,
+    int*         a_n,
+    Key16 const& a_key,
+    int          a_val
+  )
+  {
+    assert(a_slots != nullptr && a_n != nullptr && a_val >= 0);
+    for (unsigned i = KeyIdxHash(a_key, a_nslots); ;
+         i = (i + 1) & (a_nslots - 1))
+    {
+      KeyIdxSlot& slot = a_slots[i];
+      if (slot.m_val < 0)
+      {
+        if (utxx::unlikely(*a_n >= int(a_nslots / 2)))
+          throw utxx::runtime_error("KeyIdxInsert: Capacity exceeded");
+        slot = KeyIdxSlot{a_key, a_val, 0};
+        ++(*a_n);
+        return true;
+      }
+      if (slot.m_key == a_key)
+      {
+        ++slot.m_dups;
+        return false;
+      }
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxAssign":                                                         //
+  //-------------------------------------------------------------------------//
+  // Similar to "KeyIdxInsert", but if the Key is already there, its Val is
+  // OVER-WRITTEN (and it is not counted as a Dup):
+  //
+  inline bool KeyIdxAssign
+  (
+    KeyIdxSlot*  a_slots,
+    unsigned     a_nslots,
+    int*         a_n,
+    Key16 const& a_key,
+    int          a_val
+  )
+  {
+    assert(a_slots != nullptr && a_n != nullptr && a_val >= 0);
+    for (unsigned i = KeyIdxHash(a_key, a_nslots); ;
+         i = (i + 1) & (a_nslots - 1))
+    {
+      KeyIdxSlot& slot = a_slots[i];
+      if (slot.m_val < 0)
+      {
+        if (utxx::unlikely(*a_n >= int(a_nslots / 2)))
+          throw utxx::runtime_error("KeyIdxAssign: Capacity exceeded");
+        slot = KeyIdxSlot{a_key, a_val, 0};
+        ++(*a_n);
+        return true;
+      }
+      if (slot.m_key == a_key)
+      {
+        slot.m_val = a_val;
+        return false;
+      }
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // "KeyIdxFind":                                                           //
+  //-------------------------------------------------------------------------//
+  // Returns the Val, or (-1) if not found. If "a_dups" is non-NULL, it recei-
+  // ves the number of repeated insertions of the Key:
+  //
+  inline int KeyIdxFind
+  (
+    KeyIdxSlot const* a_slots,
+    unsigned          a_nslots,
+    Key16 const&      a_key,
+    int*              a_dups = nullptr
+  )
+  {
+    assert(a_slots != nullptr);
+    // NB: The table is never full, so the loop always terminates:
+    for (unsigned i = KeyIdxHash(a_key, a_nslots); ;
+         i = (i + 1) & (a_nslots - 1))
+    {
+      KeyIdxSlot const& slot = a_slots[i];
+      if (utxx::likely(slot.m_key == a_key && slot.m_val >= 0))
+      {
+        if (a_dups != nullptr)
+          *a_dups = slot.m_dups;
+        return slot.m_val;
+      }
+      if (slot.m_val < 0)
+        return -1;
+    }
+  }
+
+  //=========================================================================//
+  // "KeyIdx":                                                               //
+  //=========================================================================//
+  // "NSlots" must be a power of 2; the Capacity (max number of distinct keys)
+  // is NSlots/2:
+  //
+  template<unsigned NSlots>
+  class KeyIdx
+  {
+  private:
+    static_assert(NSlots >= 2 && (NSlots & (NSlots - 1)) == 0,
+                  "KeyIdx: NSlots must be a power of 2");
+
+    KeyIdxSlot m_slots[NSlots];
+    int        m_n;
+
+  public:
+    constexpr static int Capacity = int(NSlots / 2);
+
+    //-----------------------------------------------------------------------//
+    // Default Ctor, "Clear":                                                //
+    //-----------------------------------------------------------------------//
+    KeyIdx() { Clear(); }
+
+    void Clear()
+    {
+      KeyIdxClear(m_slots, NSlots);
+      m_n = 0;
+    }
+
+    int Size() const { return m_n; }
+
+    //-----------------------------------------------------------------------//
+    // "Insert", "Find": See "KeyIdxInsert" and "KeyIdxFind" above:          //
+    //-----------------------------------------------------------------------//
+    bool Insert(Key16 const& a_key, int a_val)
+      { return KeyIdxInsert(m_slots, NSlots, &m_n, a_key, a_val); }
+
+    int Find(Key16 const& a_key, int* a_dups = nullptr) const
+      { return KeyIdxFind  (m_slots, NSlots, a_key, a_dups); }
+  };
+
+  //=========================================================================//
+  // "KeyIdxDyn":                                                            //
+  //=========================================================================//
+  // As "KeyIdx" above, but the Slots are allocated via "Alloc" (which may be a
+  // ShM Allocator, in which case the obj itself can be placed in ShM as well),
+  // and the number of Slots is doubled (with re-hashing) whenever the table
+  // would become more than half full, so there is no fixed Capacity. Re-hash-
+  // ing does not affect the Vals:
+  //
+  template<typename Alloc = std::allocator<KeyIdxSlot>>
+  class KeyIdxDyn
+  {
+  private:
+    using SlotsVec = boost::container::vector<KeyIdxSlot, Alloc>;
+
+    SlotsVec   m_slots;   // Size is a power of 2
+    int        m_n;
+
+    // NB: "data()" may return a fancy ptr (eg with a ShM Allocator):
+    KeyIdxSlot*       Slots()       { return &(m_slots[0]); }
+    KeyIdxSlot const* Slots() const { return &(m_slots[0]); }
+    unsigned          NSlots() const { return unsigned(m_slots.size()); }
+
+    //-----------------------------------------------------------------------//
+    // "Reserve": Make sure that 1 more Key can be inserted:                 //
+    //-----------------------------------------------------------------------//
+    void Reserve()
+    {
+      unsigned nslots = NSlots();
+      if (utxx::likely(m_n < int(nslots / 2)))
+        return;
+      SlotsVec slots(2 * nslots, m_slots.get_allocator());
+      KeyIdxReHash(Slots(), nslots, &(slots[0]), 2 * nslots);
+      m_slots.swap(slots);
+    }
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Non-Default Ctor, "Clear":                                            //
+    //-----------------------------------------------------------------------//
+    explicit KeyIdxDyn
+    (
+      unsigned     a_capacity = 32,
+      Alloc const& a_alloc    = Alloc()
+    )
+    : m_slots(KeyIdxNSlots(a_capacity), a_alloc),
+      m_n    (0)
+    { Clear(); }
+
+    void Clear()
+    {
+      KeyIdxClear(Slots(), NSlots());
+      m_n = 0;
+    }
+
+    int Size() const { return m_n; }
+
+    //-----------------------------------------------------------------------//
+    // "Insert", "Assign", "Find": See "KeyIdxInsert" etc above:             //
+    //-----------------------------------------------------------------------//
+    bool Insert(Key16 const& a_key, int a_val)
+    {
+      Reserve();
+      return KeyIdxInsert(Slots(), NSlots(), &m_n, a_key, a_val);
+    }
+
+    bool Assign(Key16 const& a_key, int a_val)
+    {
+      Reserve();
+      return KeyIdxAssign(Slots(), NSlots(), &m_n, a_key, a_val);
+    }
+
+    int Find(Key16 const& a_key, int* a_dups = nullptr) const
+      { return KeyIdxFind(Slots(), NSlots(), a_key, a_dups); }
+  };
+} // End namespace MAQUETTE
@@ -47,6 +47,29 @@
 //===========================================================================//
 // Logging:                                                                  //
 //===========================================================================//
+//---------------------------------------------------------------------------//
+// "MQT_LOG": Common body of "LOG_*" and "LOGA_*":                           //
+//---------------------------------------------------------------------------//
+// If "Logger" was made by "IO::MkLogger" with a "binlog:" output, only the fmt
+// string ID and the raw args are stored (in a per-thread ring), and the back-
+// end thread does all file I/O (see "Basis/BinLog.h"). Otherwise, the msg is
+// formatted and flushed by "spdlog" right away:
+//
+#include "Basis/BinLog.h"
+
+#ifdef  MQT_LOG
+#undef  MQT_LOG
+#endif
+#define MQT_LOG(Logger, Method, Level, ...) \
+  if (MAQUETTE::BinLog::Channel const* mqtLogCh_ = \
+      MAQUETTE::BinLog::Find(Logger)) \
+    { static MAQUETTE::BinLog::CallSite mqtLogSite_; \
+      MAQUETTE::BinLog::Log(mqtLogCh_, &mqtLogSite_, spdlog::level::Level, \
+                            __VA_ARGS__); } \
+  else \
+    { (Logger)->Method(__VA_ARGS__); \
+      (Logger)->flush(); }
+
 //---------------------------------------------------------------------------//
 // "LOG_*": For any classes with "m_logger" and "m_debugLevel":              //
 //---------------------------------------------------------------------------//
@@ -55,32 +78,28 @@
 #endif
 #define LOG_INFO(LogLevel, ...) \
   if (this->m_logger != nullptr && this->m_debugLevel >= LogLevel) \
-    { this->m_logger->info(__VA_ARGS__); \
-      this->m_logger->flush(); }
+    { MQT_LOG(this->m_logger, info,     info,     __VA_ARGS__) }
 
 #ifdef  LOG_WARN
 #undef  LOG_WARN
 #endif
 #define LOG_WARN(LogLevel, ...) \
   if (this->m_logger != nullptr && this->m_debugLevel >= LogLevel) \
-    { this->m_logger->warn(__VA_ARGS__); \
-      this->m_logger->flush(); }
+    { MQT_LOG(this->m_logger, warn,     warn,     __VA_ARGS__) }
 
 #ifdef  LOG_ERROR
 #undef  LOG_ERROR
 #endif
 #define LOG_ERROR(LogLevel, ...) \
   if (this->m_logger != nullptr && this->m_debugLevel >= LogLevel) \
-    { this->m_logger->error(__VA_ARGS__); \
-      this->m_logger->flush(); }
+    { MQT_LOG(this->m_logger, error,    err,      __VA_ARGS__) }
 
 #ifdef  LOG_CRIT
 #undef  LOG_CRIT
 #endif
 #define LOG_CRIT(LogLevel, ...) \
   if (this->m_logger != nullptr && this->m_debugLevel >= LogLevel) \
-    { this->m_logger->critical(__VA_ARGS__); \
-      this->m_logger->flush(); }
+    { MQT_LOG(this->m_logger, critical, critical, __VA_ARGS__) }
 
 //---------------------------------------------------------------------------//
 // Identification:                                                           //
@@ -108,32 +127,28 @@
 #endif
 #define LOGA_INFO(Another,  LogLevel, ...) \
   if (utxx::unlikely(Another::m_debugLevel >= LogLevel)) \
-    { Another::m_logger->info(__VA_ARGS__); \
-      Another::m_logger->flush(); }
+    { MQT_LOG(Another::m_logger, info,     info,     __VA_ARGS__) }
 
 #ifdef  LOGA_WARN
 #undef  LOGA_WARN
 #endif
 #define LOGA_WARN(Another,  LogLevel, ...) \
   if (utxx::unlikely(Another::m_debugLevel >= LogLevel)) \
-    { Another::m_logger->warn(__VA_ARGS__); \
-      Another::m_logger->flush(); }
+    { MQT_LOG(Another::m_logger, warn,     warn,     __VA_ARGS__) }
 
 #ifdef  LOGA_ERROR
 #undef  LOGA_ERROR
 #endif
 #define LOGA_ERROR(Another, LogLevel, ...) \
   if (utxx::unlikely(Another::m_debugLevel >= LogLevel)) \
-    { Another::m_logger->error(__VA_ARGS__); \
-      Another::m_logger->flush(); }
+    { MQT_LOG(Another::m_logger, error,    err,      __VA_ARGS__) }
 
 #ifdef  LOGA_CRIT
 #undef  LOGA_CRIT
 #endif
 #define LOGA_CRIT(Another,  LogLevel, ...) \
   if (utxx::unlikely(Another::m_debugLevel >= LogLevel)) \
-    { Another::m_logger->critical(__VA_ARGS__); \
-      Another::m_logger->flush(); }
+    { MQT_LOG(Another::m_logger, critical, critical, __VA_ARGS__) }
 
 //===========================================================================//
 // Misc:                                                                     //
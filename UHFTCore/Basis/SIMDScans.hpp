@@ -0,0 +1,255 @@
+// vim:ts=2:et
+//===========================================================================//
+//                           "Basis/SIMDScans.hpp":                          //
+//        Vectorised (AVX2, with a Scalar Fall-Back) Scans of Qty Arrays     //
+//===========================================================================//
+// The arrays scanned are Structure-of-Arrays "shadows" of per-Px-Level Aggr-
+// egated Qtys (as "double"s), where empty levels are represented by 0s, eg in
+// the Dense "OrderBook". All scans proceed from slot "a_from" towards slot
+// "a_to" (inclusive), which can be in either direction ("Up" or down). The
+// AVX2 path is selected at compile time (via "-march"); "UseAVX2" can be set
+// to "false" explicitly to force the scalar path (eg for benchmarking):
+//
+#pragma  once
+
+#include <utxx/compiler_hints.hpp>
+#include <cassert>
+#ifdef   __AVX2__
+#include <immintrin.h>
+#endif
+
+namespace MAQUETTE
+{
+namespace SIMD
+{
+# ifdef __AVX2__
+  constexpr bool HasAVX2 = true;
+# else
+  constexpr bool HasAVX2 = false;
+# endif
+
+  //=========================================================================//
+  // "DepthScan": Result of "CumQtyN" and "ScanToQty":                       //
+  //=========================================================================//
+  struct DepthScan
+  {
+    double  m_qty;     // Cumulative Qty of the levels taken
+    double  m_qtyOff;  // Sum of (Qty * Offset), Offset = |Slot - "a_from"|
+    int     m_last;    // Last non-empty slot taken, or (-1) if none
+  };
+
+# ifdef __AVX2__
+  //=========================================================================//
+  // Internal AVX2 Helpers:                                                  //
+  //=========================================================================//
+  namespace Detail
+  {
+    // Horizontal Sum of 4 "double"s:
+    inline double HSum(__m256d a_v)
+    {
+      __m128d lo = _mm256_castpd256_pd128(a_v);
+      __m128d hi = _mm256_extractf128_pd(a_v, 1);
+      lo         = _mm_add_pd(lo, hi);
+      return _mm_cvtsd_f64(_mm_add_sd(lo, _mm_unpackhi_pd(lo, lo)));
+    }
+
+    // Bit Mask of (a_v[j] > 0):
+    inline unsigned PosMask(__m256d a_v)
+    {
+      return unsigned(_mm256_movemask_pd
+                     (_mm256_cmp_pd(a_v, _mm256_setzero_pd(), _CMP_GT_OQ)));
+    }
+
+    // The 4-slot block to be loaded at curr slot "a_s": for the "Up" direc-
+    // tion, it is [s .. s+3], otherwise [s-3 .. s]:
+    template<bool Up>
+    inline __m256d Load(double const* a_qs, int a_s)
+      { return _mm256_loadu_pd(a_qs + (Up ? a_s : (a_s - 3))); }
+
+    // Whether a full block starting at "a_s" is within the range:
+    template<bool Up>
+    inline bool HasBlock(int a_s, int a_to)
+      { return Up ? (a_s + 3 <= a_to) : (a_s - 3 >= a_to); }
+
+    // Slot of the first (in the scan direction) set bit of "a_mask" (non-0):
+    template<bool Up>
+    inline int FirstSlot(int a_s, unsigned a_mask)
+    {
+      assert(a_mask != 0);
+      return
+        Up ? (a_s + __builtin_ctz(a_mask))
+           : (a_s - 3 + (31 - __builtin_clz(a_mask)));
+    }
+
+    // Slot of the last (in the scan direction) set bit of "a_mask" (non-0):
+    template<bool Up>
+    inline int LastSlot (int a_s, unsigned a_mask)
+    {
+      assert(a_mask != 0);
+      return
+        Up ? (a_s + (31 - __builtin_clz(a_mask)))
+           : (a_s - 3 + __builtin_ctz(a_mask));
+    }
+
+    // Offsets (from "a_from") of the block slots, in the lane order:
+    template<bool Up>
+    inline __m256d Offsets(int a_s, int a_from)
+    {
+      double k = double(Up ? (a_s - a_from) : (a_from - a_s));
+      return
+        Up ? _mm256_setr_pd(k,       k + 1.0, k + 2.0, k + 3.0)
+           : _mm256_setr_pd(k + 3.0, k + 2.0, k + 1.0, k);
+    }
+  }
+# endif // __AVX2__
+
+  //=========================================================================//
+  // "FindPos":                                                              //
+  //=========================================================================//
+  // Returns the first slot (in the scan direction) in the range [a_from ..
+  // a_to] with a positive Qty, or (-1) if there is none:
+  //
+  template<bool Up, bool UseAVX2 = HasAVX2>
+  inline int FindPos(double const* a_qs, int a_from, int a_to)
+  {
+    assert(a_qs != nullptr && a_from >= 0 && a_to >= 0);
+    int s = a_from;
+
+#   ifdef __AVX2__
+    if constexpr (UseAVX2)
+    {
+      // The most common case (eg in a fully-populated Book) is that the very
+      // first slot is non-empty, so check it before vectorising:
+      if ((Up ? (s <= a_to) : (s >= a_to)) && a_qs[s] > 0.0)
+        return s;
+
+      for (; Detail::HasBlock<Up>(s, a_to); Up ? (s += 4) : (s -= 4))
+      {
+        unsigned mask = Detail::PosMask(Detail::Load<Up>(a_qs, s));
+        if (mask != 0)
+          return Detail::FirstSlot<Up>(s, mask);
+      }
+    }
+#   endif
+    // Scalar path, or the remaining tail:
+    for (; Up ? (s <= a_to) : (s >= a_to); Up ? ++s : --s)
+      if (a_qs[s] > 0.0)
+        return s;
+    return -1;
+  }
+
+  //=========================================================================//
+  // "CumQtyN":                                                              //
+  //=========================================================================//
+  // Cumulative Qty of the first "a_n" non-empty levels in the range [a_from ..
+  // a_to] (or of all of them, if there are fewer than "a_n"):
+  //
+  template<bool Up, bool UseAVX2 = HasAVX2>
+  inline DepthScan CumQtyN(double const* a_qs, int a_from, int a_to, int a_n)
+  {
+    assert(a_qs != nullptr && a_from >= 0 && a_to >= 0 && a_n >= 0);
+    DepthScan res { 0.0, 0.0, -1 };
+    int       s = a_from;
+
+#   ifdef __AVX2__
+    if constexpr (UseAVX2)
+    {
+      // Whole blocks are taken while they contain fewer than the remaining
+      // number of levels; the final block is completed by the scalar path:
+      __m256d acc    = _mm256_setzero_pd();
+      __m256d accOff = _mm256_setzero_pd();
+
+      for (; Detail::HasBlock<Up>(s, a_to); Up ? (s += 4) : (s -= 4))
+      {
+        __m256d  v    = Detail::Load<Up>(a_qs, s);
+        unsigned mask = Detail::PosMask(v);
+        int      cnt  = __builtin_popcount(mask);
+        if (cnt >= a_n)
+          break;
+        if (mask != 0)
+        {
+          acc      = _mm256_add_pd(acc, v);
+          accOff   = _mm256_add_pd
+                     (accOff, _mm256_mul_pd(v, Detail::Offsets<Up>(s, a_from)));
+          res.m_last = Detail::LastSlot<Up>(s, mask);
+          a_n       -= cnt;
+        }
+      }
+      res.m_qty    = Detail::HSum(acc);
+      res.m_qtyOff = Detail::HSum(accOff);
+    }
+#   endif
+    // Scalar path, or the remaining tail:
+    for (; a_n > 0 && (Up ? (s <= a_to) : (s >= a_to)); Up ? ++s : --s)
+    {
+      double q = a_qs[s];
+      if (q > 0.0)
+      {
+        res.m_qty    += q;
+        res.m_qtyOff += q * double(Up ? (s - a_from) : (a_from - s));
+        res.m_last    = s;
+        --a_n;
+      }
+    }
+    return res;
+  }
+
+  //=========================================================================//
+  // "ScanToQty":                                                            //
+  //=========================================================================//
+  // Takes levels in the range [a_from .. a_to] until the cumulative Qty reach-
+  // es "a_target" (> 0); the last level taken may be taken partially. If the
+  // liquidity is sufficient, "m_qty" is EXACTLY "a_target" (so the Caller can
+  // test for that), otherwise it is the total Qty in the range:
+  //
+  template<bool Up, bool UseAVX2 = HasAVX2>
+  inline DepthScan ScanToQty
+    (double const* a_qs, int a_from, int a_to, double a_target)
+  {
+    assert(a_qs != nullptr && a_from >= 0 && a_to >= 0 && a_target > 0.0);
+    DepthScan res { 0.0, 0.0, -1 };
+    double    rem = a_target;
+    int       s   = a_from;
+
+#   ifdef __AVX2__
+    if constexpr (UseAVX2)
+    {
+      // Whole blocks are taken while their Qty is below the remaining one;
+      // the final block is completed by the scalar path:
+      __m256d accOff = _mm256_setzero_pd();
+
+      for (; Detail::HasBlock<Up>(s, a_to); Up ? (s += 4) : (s -= 4))
+      {
+        __m256d  v    = Detail::Load<Up>(a_qs, s);
+        unsigned mask = Detail::PosMask(v);
+        if (mask == 0)
+          continue;
+        double   bq   = Detail::HSum(v);
+        if (bq >= rem)
+          break;
+        accOff     = _mm256_add_pd
+                     (accOff, _mm256_mul_pd(v, Detail::Offsets<Up>(s, a_from)));
+        res.m_last = Detail::LastSlot<Up>(s, mask);
+        rem       -= bq;
+      }
+      res.m_qtyOff = Detail::HSum(accOff);
+    }
+#   endif
+    // Scalar path, or the remaining tail:
+    for (; rem > 0.0 && (Up ? (s <= a_to) : (s >= a_to)); Up ? ++s : --s)
+    {
+      double q = a_qs[s];
+      if (q > 0.0)
+      {
+        double f      = (q < rem) ? q : rem;
+        res.m_qtyOff += f * double(Up ? (s - a_from) : (a_from - s));
+        res.m_last    = s;
+        rem          -= f;
+      }
+    }
+    // NB: "rem" is exactly 0 if the last level was taken partially:
+    res.m_qty = utxx::likely(rem <= 0.0) ? a_target : (a_target - rem);
+    return res;
+  }
+} // End namespace SIMD
+} // End namespace MAQUETTE
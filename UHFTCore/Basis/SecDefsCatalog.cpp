@@ -0,0 +1,289 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Basis/SecDefsCatalog.cpp":                       //
+//        Versioned Binary (MMap-able) Catalog of Static "SecDefS"s          //
+//===========================================================================//
+#include "Basis/SecDefsCatalog.h"
+#include "Basis/XXHash.hpp"
+#include <utxx/error.hpp>
+#include <algorithm>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+
+using namespace std;
+
+namespace MAQUETTE
+{
+  constexpr char     SecDefsCatalog::Magic[8];
+  constexpr uint32_t SecDefsCatalog::Version;
+
+  namespace
+  {
+    //=======================================================================//
+    // Utils:                                                                //
+    //=======================================================================//
+    // All sections are 64-aligned (cache lines):
+    inline uint64_t Align64(uint64_t a_off)
+      { return (a_off + 63) & ~uint64_t(63); }
+  }
+
+  //=========================================================================//
+  // "SecDefsRange":                                                         //
+  //=========================================================================//
+  SecDefsRange::SecDefsRange(SecDefsCatalog const& a_cat)
+  : m_begin(a_cat.begin()),
+    m_end  (a_cat.end  ()),
+    m_cat  (&a_cat)
+  {}
+
+  SecDefsRange SecDefsRange::BySymbol(char const* a_symbol) const
+  {
+    // A sub-range of a Catalog is only looked up via the Index if it is the
+    // whole Catalog (otherwise the Index is not applicable):
+    return
+      (m_cat != nullptr    && m_begin == m_cat->begin() &&
+       m_end == m_cat->end())
+      ? m_cat->FindBySymbol(a_symbol)
+      : *this;
+  }
+
+  //=========================================================================//
+  // "SecDefsCatalog": Ctor, Dtor:                                           //
+  //=========================================================================//
+  SecDefsCatalog::SecDefsCatalog(string const& a_path, bool a_verify)
+  : m_path   (a_path),
+    m_map    (),
+    m_hdr    (nullptr),
+    m_recs   (nullptr),
+    m_secIDs (nullptr),
+    m_symbols(nullptr)
+  {
+    Open(a_verify);
+  }
+
+  SecDefsCatalog::~SecDefsCatalog() noexcept
+  {
+    // "m_map" is unmapped by its own Dtor; just reset the ptrs for safety:
+    m_hdr     = nullptr;
+    m_recs    = nullptr;
+    m_secIDs  = nullptr;
+    m_symbols = nullptr;
+  }
+
+  //=========================================================================//
+  // "Open":                                                                 //
+  //=========================================================================//
+  void SecDefsCatalog::Open(bool a_verify)
+  {
+    char const* path = m_path.data();
+
+    // Open the file by ourselves, so that its size is checked on exactly what
+    // is mapped (even if the file is being replaced concurrently):
+    int fd = open(path, O_RDONLY);
+    if (utxx::unlikely(fd < 0))
+      IO::SystemError(-1, "SecDefsCatalog::Open: Cannot open: ", path);
+
+    struct stat st;
+    unique_ptr<IO::MMapedFile<char, false>> map;
+    try
+    {
+      if (utxx::unlikely(fstat(fd, &st) < 0))
+        IO::SystemError(-1, "SecDefsCatalog::Open: Cannot stat: ", path);
+
+      if (utxx::unlikely(size_t(st.st_size) < sizeof(Header)))
+        throw utxx::runtime_error
+              ("SecDefsCatalog::Open: ", path, ": File too short");
+
+      // NB: "fd" is not memoised by "MMapedFile", so we close it ourselves
+      // (the mapping remains valid):
+      map.reset(new IO::MMapedFile<char, false>(path, fd));
+    }
+    catch (...)
+    {
+      (void) close(fd);
+      throw;
+    }
+    (void) close(fd);
+
+    //-----------------------------------------------------------------------//
+    // Verify the Header and the Layout:                                     //
+    //-----------------------------------------------------------------------//
+    char const*   base = map->GetPtr();
+    uint64_t      len  = uint64_t(map->GetNRecs());
+    Header const* hdr  = reinterpret_cast<Header const*>(base);
+
+    if (utxx::unlikely(memcmp(hdr->m_magic, Magic, sizeof(Magic)) != 0))
+      throw utxx::runtime_error
+            ("SecDefsCatalog::Open: ", path, ": Not a SecDefs Catalog");
+
+    if (utxx::unlikely
+       (hdr->m_version != Version || hdr->m_recSize != sizeof(SecDefS)))
+      throw utxx::runtime_error
+            ("SecDefsCatalog::Open: ", path, ": Incompatible Version=",
+             hdr->m_version, ", RecSize=", hdr->m_recSize, ": Expected ",
+             Version, ", ", sizeof(SecDefS));
+
+    uint64_t nRecs    = hdr->m_nRecs;
+    uint64_t nSlots   = hdr->m_nSlots;
+    uint64_t idxBytes = nSlots * sizeof(KeyIdxSlot);
+
+    if (utxx::unlikely
+       (hdr->m_fileSize != len                                          ||
+        nSlots < 2      || (nSlots & (nSlots - 1)) != 0 ||
+        nRecs  > nSlots / 2                                             ||
+        hdr->m_recsOff    < sizeof(Header)                              ||
+        (hdr->m_recsOff | hdr->m_secIDsOff | hdr->m_symbolsOff) % 64    ||
+        hdr->m_recsOff    + nRecs * sizeof(SecDefS) > hdr->m_secIDsOff  ||
+        hdr->m_secIDsOff  + idxBytes                > hdr->m_symbolsOff ||
+        hdr->m_symbolsOff + idxBytes                > len))
+      throw utxx::runtime_error
+            ("SecDefsCatalog::Open: ", path, ": Invalid Layout");
+
+    //-----------------------------------------------------------------------//
+    // Verify the CheckSum (optional, as it touches all pages):              //
+    //-----------------------------------------------------------------------//
+    if (a_verify)
+    {
+      uint64_t cs =
+        XXH64(base + sizeof(Header), len - sizeof(Header), XXHSeed);
+      if (utxx::unlikely(cs != hdr->m_checkSum))
+        throw utxx::runtime_error
+              ("SecDefsCatalog::Open: ", path, ": CheckSum Mismatch");
+    }
+
+    //-----------------------------------------------------------------------//
+    // All Done: Install the new map:                                        //
+    //-----------------------------------------------------------------------//
+    m_map     = std::move(map);
+    m_hdr     = hdr;
+    m_recs    = reinterpret_cast<SecDefS    const*>(base + hdr->m_recsOff);
+    m_secIDs  = reinterpret_cast<KeyIdxSlot const*>(base + hdr->m_secIDsOff);
+    m_symbols =
+      reinterpret_cast<KeyIdxSlot const*>(base + hdr->m_symbolsOff);
+  }
+
+  //=========================================================================//
+  // "FindBySymbol":                                                         //
+  //=========================================================================//
+  SecDefsRange SecDefsCatalog::FindBySymbol(char const* a_symbol) const
+  {
+    assert(a_symbol != nullptr);
+    Key16 key;
+    int   dups = 0;
+    int   idx  =
+      MkKey16(a_symbol, &key)
+      ? KeyIdxFind(m_symbols, m_hdr->m_nSlots, key, &dups)
+      : -1;
+
+    if (idx < 0)
+      return SecDefsRange(end(), end(), this);
+
+    SecDefS const* from = m_recs + idx;
+    return SecDefsRange(from, from + dups + 1, this);
+  }
+
+  //=========================================================================//
+  // "Write":                                                                //
+  //=========================================================================//
+  void SecDefsCatalog::Write
+  (
+    string const& a_path,
+    SecDefsRange  a_sds,
+    char const*   a_source
+  )
+  {
+    //-----------------------------------------------------------------------//
+    // Sort the "SecDefS"s by Symbol (stable, so the relative order of Recs  //
+    // with the same Symbol is preserved):                                   //
+    //-----------------------------------------------------------------------//
+    vector<SecDefS const*> ptrs;
+    ptrs.reserve(a_sds.size());
+    for (SecDefS const& sd: a_sds)
+      ptrs.push_back(&sd);
+
+    stable_sort(ptrs.begin(), ptrs.end(),
+      [](SecDefS const* a_left, SecDefS const* a_right)->bool
+      { return
+          strcmp(a_left->m_Symbol.data(), a_right->m_Symbol.data()) < 0; });
+
+    //-----------------------------------------------------------------------//
+    // Layout:                                                               //
+    //-----------------------------------------------------------------------//
+    uint32_t nRecs  = uint32_t(ptrs.size());
+    uint32_t nSlots = 16;
+    while (nSlots < 2 * nRecs)
+      nSlots *= 2;
+
+    uint64_t idxBytes   = uint64_t(nSlots) * sizeof(KeyIdxSlot);
+    uint64_t recsOff    = Align64(sizeof(Header));
+    uint64_t secIDsOff  = Align64(recsOff   + nRecs * sizeof(SecDefS));
+    uint64_t symbolsOff = Align64(secIDsOff + idxBytes);
+    uint64_t fileSize   = symbolsOff + idxBytes;
+
+    // The whole image is built in memory (it is only a few MB even for the
+    // largest Venues), 0-filled so that the gaps are deterministic:
+    vector<char> buff(fileSize, '\0');
+    char*        base    = buff.data();
+    Header*      hdr     = reinterpret_cast<Header*>    (base);
+    SecDefS*     recs    = reinterpret_cast<SecDefS*>   (base + recsOff);
+    KeyIdxSlot*  secIDs  = reinterpret_cast<KeyIdxSlot*>(base + secIDsOff);
+    KeyIdxSlot*  symbols = reinterpret_cast<KeyIdxSlot*>(base + symbolsOff);
+
+    //-----------------------------------------------------------------------//
+    // Recs and Indices:                                                     //
+    //-----------------------------------------------------------------------//
+    KeyIdxClear(secIDs,  nSlots);
+    KeyIdxClear(symbols, nSlots);
+    int nIDs  = 0;
+    int nSyms = 0;
+
+    for (uint32_t i = 0; i < nRecs; ++i)
+    {
+      memcpy(recs + i, ptrs[i], sizeof(SecDefS));
+      // As the Recs are sorted by Symbol, the 1st insertion of each Symbol
+      // is the beginning of its run, and Dups+1 is the run length:
+      (void) KeyIdxInsert(secIDs,  nSlots, &nIDs,
+                          MkKey16(recs[i].m_SecID),  int(i));
+      (void) KeyIdxInsert(symbols, nSlots, &nSyms,
+                          MkKey16(recs[i].m_Symbol), int(i));
+    }
+
+    //-----------------------------------------------------------------------//
+    // Header (the CheckSum is computed last):                               //
+    //-----------------------------------------------------------------------//
+    memcpy(hdr->m_magic, Magic, sizeof(Magic));
+    hdr->m_version    = Version;
+    hdr->m_recSize    = sizeof(SecDefS);
+    hdr->m_nRecs      = nRecs;
+    hdr->m_nSlots     = nSlots;
+    hdr->m_recsOff    = recsOff;
+    hdr->m_secIDsOff  = secIDsOff;
+    hdr->m_symbolsOff = symbolsOff;
+    hdr->m_fileSize   = fileSize;
+    hdr->m_created    = utxx::now_utc().microseconds();
+    if (a_source != nullptr)
+      strncpy(hdr->m_source, a_source, sizeof(hdr->m_source) - 1);
+    hdr->m_checkSum   =
+      XXH64(base + sizeof(Header), fileSize - sizeof(Header), XXHSeed);
+
+    //-----------------------------------------------------------------------//
+    // Write it out under a tmp name, then rename (atomically):              //
+    //-----------------------------------------------------------------------//
+    string tmp = a_path + ".tmp." + to_string(getpid());
+    FILE*  f   = fopen(tmp.data(), "wb");
+    if (utxx::unlikely(f == nullptr))
+      IO::SystemError(-1, "SecDefsCatalog::Write: Cannot create: ", tmp);
+
+    bool ok = (fwrite(base, 1, fileSize, f) == fileSize);
+    ok     &= (fflush(f) == 0 && fsync(fileno(f)) == 0);
+    ok     &= (fclose(f) == 0);
+    if (utxx::unlikely(!ok || rename(tmp.data(), a_path.data()) < 0))
+    {
+      int err = errno;
+      (void) unlink(tmp.data());
+      IO::SystemError(err, "SecDefsCatalog::Write: Cannot write: ", a_path);
+    }
+  }
+} // End namespace MAQUETTE
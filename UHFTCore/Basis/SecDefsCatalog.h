@@ -0,0 +1,174 @@
+// vim:ts=2:et
+//===========================================================================//
+//                          "Basis/SecDefsCatalog.h":                        //
+//        Versioned Binary (MMap-able) Catalog of Static "SecDefS"s          //
+//===========================================================================//
+// An alternative to the compiled-in "SecDefS" tables (Venues/*/SecDefs*.cpp):
+// the "SecDefS"s are stored in a binary file as verbatim images, along with
+// pre-built "KeyIdx" indices by SecID and by Symbol, so the file is used as
+// is after "mmap" (no parsing). Catalogs are produced by the "MkSecDefs_*"
+// tools (or by "SecDefsCatalog::Write"), and can be updated without re-buil-
+// ding anything.
+// LIMITATION: The "EConnector"s only read the Catalog in their Ctors (and then
+// unmap it); the "SecDefD"s installed in the "SecDefsMgr" are never updated
+// intraday, so a Catalog change only takes effect after the Connectors (ie the
+// process) are re-started:
+//
+// File Layout (all offsets are from the beginning of the file, 64-aligned):
+// (*) "Header";
+// (*) "SecDefS" Recs, sorted by Symbol (stable), so that all Recs with same
+//     Symbol are contiguous;
+// (*) SecID  Index: "KeyIdxSlot"s, Val = Rec idx (of the 1st occurrence);
+// (*) Symbol Index: "KeyIdxSlot"s, Val = idx of the 1st Rec with this Symbol,
+//     Dups+1 = number of such Recs.
+// NB: As "SecDefS" images are stored verbatim, any change in its layout must
+// be accompanied by incrementing "SecDefsCatalog::Version":
+//
+#pragma once
+
+#include "Basis/SecDefs.h"
+#include "Basis/KeyIdx.hpp"
+#include "Basis/IOUtils.hpp"
+#include <boost/core/noncopyable.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace MAQUETTE
+{
+  class SecDefsCatalog;
+
+  //=========================================================================//
+  // "SecDefsRange":                                                         //
+  //=========================================================================//
+  // A contiguous range of "SecDefS"s: either in a vector (eg a compiled-in
+  // table), or in a "SecDefsCatalog":
+  //
+  class SecDefsRange
+  {
+  private:
+    SecDefS const*        m_begin;
+    SecDefS const*        m_end;
+    SecDefsCatalog const* m_cat;    // NULL if not from a Catalog
+
+  public:
+    SecDefsRange(std::vector<SecDefS> const& a_vec)
+    : m_begin(a_vec.data()),
+      m_end  (a_vec.data() + a_vec.size()),
+      m_cat  (nullptr)
+    {}
+
+    SecDefsRange(SecDefsCatalog const& a_cat);
+
+    SecDefS const* begin() const { return m_begin;                }
+    SecDefS const* end  () const { return m_end;                  }
+    size_t         size () const { return size_t(m_end - m_begin); }
+    bool           empty() const { return m_begin == m_end;       }
+
+    // "BySymbol": A sub-range containing ALL "SecDefS"s with the given Symbol.
+    // For a Catalog, it is found via the Symbol Index and contains only such
+    // "SecDefS"s; otherwise, it is the whole range (to be searched linearly):
+    SecDefsRange BySymbol(char const* a_symbol) const;
+
+  private:
+    friend class SecDefsCatalog;
+
+    SecDefsRange
+      (SecDefS const* a_begin, SecDefS const* a_end, SecDefsCatalog const* a_c)
+    : m_begin(a_begin),
+      m_end  (a_end),
+      m_cat  (a_c)
+    {}
+  };
+
+  //=========================================================================//
+  // "SecDefsCatalog" Class:                                                 //
+  //=========================================================================//
+  class SecDefsCatalog: public boost::noncopyable
+  {
+  public:
+    //-----------------------------------------------------------------------//
+    // File Format:                                                          //
+    //-----------------------------------------------------------------------//
+    constexpr static char     Magic[8] = {'M','Q','T','S','D','C','A','T'};
+    constexpr static uint32_t Version  = 1;
+
+    struct Header
+    {
+      char      m_magic    [8];
+      uint32_t  m_version;
+      uint32_t  m_recSize;        // sizeof(SecDefS)
+      uint32_t  m_nRecs;
+      uint32_t  m_nSlots;         // In each Index (a power of 2)
+      uint64_t  m_recsOff;
+      uint64_t  m_secIDsOff;      // SecID  Index
+      uint64_t  m_symbolsOff;     // Symbol Index
+      uint64_t  m_fileSize;
+      uint64_t  m_checkSum;       // XXH64 of everything after the Header
+      long      m_created;        // As "utxx::time_val" microseconds
+      char      m_source   [64];  // Eg "FORTS-Opt-ProdF"
+      char      m_pad      [56];
+    };
+    static_assert(sizeof(Header) % 64 == 0, "SecDefsCatalog::Header");
+
+  private:
+    //-----------------------------------------------------------------------//
+    // Data Flds:                                                            //
+    //-----------------------------------------------------------------------//
+    std::string                                   m_path;
+    std::unique_ptr<IO::MMapedFile<char, false>>  m_map;
+    Header const*                                 m_hdr;
+    SecDefS const*                                m_recs;
+    KeyIdxSlot const*                             m_secIDs;
+    KeyIdxSlot const*                             m_symbols;
+
+    // Map the file and verify it (throws an exception on any error):
+    void Open(bool a_verify);
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Ctor, Dtor:                                                           //
+    //-----------------------------------------------------------------------//
+    // If "a_verify" is set, the CheckSum is verified as well (otherwise, only
+    // the Header and the Layout are):
+    //
+    SecDefsCatalog(std::string const& a_path, bool a_verify = true);
+    ~SecDefsCatalog() noexcept;
+
+    //-----------------------------------------------------------------------//
+    // "Write": Creates a Catalog file from the given "SecDefS"s:            //
+    //-----------------------------------------------------------------------//
+    // The file is written under a tmp name and then renamed into "a_path", so
+    // a reader never sees a partially-written Catalog:
+    //
+    static void Write
+    (
+      std::string const&   a_path,
+      SecDefsRange         a_sds,
+      char const*          a_source
+    );
+
+    //-----------------------------------------------------------------------//
+    // Accessors and Lookups:                                                //
+    //-----------------------------------------------------------------------//
+    int            Size     () const { return int(m_hdr->m_nRecs);      }
+    SecDefS const* begin    () const { return m_recs;                   }
+    SecDefS const* end      () const { return m_recs + m_hdr->m_nRecs;  }
+    char const*    GetSource() const { return m_hdr->m_source;          }
+    utxx::time_val GetCreatedTime() const
+      { return utxx::usecs(m_hdr->m_created); }
+
+    // By SecID: Returns NULL if not found:
+    SecDefS const* FindBySecID(SecID a_sec_id) const
+    {
+      int idx =
+        KeyIdxFind(m_secIDs, m_hdr->m_nSlots, MkKey16(a_sec_id));
+      return (idx >= 0) ? m_recs + idx : nullptr;
+    }
+
+    // By Symbol: Returns the (possibly empty) sub-range of all "SecDefS"s with
+    // this Symbol:
+    SecDefsRange FindBySymbol(char const* a_symbol) const;
+  };
+} // End namespace MAQUETTE
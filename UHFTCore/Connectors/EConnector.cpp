@@ -8,11 +8,13 @@
 #include "Basis/TimeValUtils.hpp"
 #include "Basis/XXHash.hpp"
 #include "Basis/OrdMgmtTypes.hpp"
+#include "Basis/KeyIdx.hpp"
 #include "Connectors/EConnector.h"
 #include "InfraStruct/StaticLimits.h"
 #include "InfraStruct/PersistMgr.h"
 #include "InfraStruct/RiskMgr.h"
 #include "InfraStruct/SecDefsMgr.h"
+#include "Basis/SecDefsCatalog.h"
 #include <utxx/error.hpp>
 #include <boost/algorithm/string.hpp>
 #include <spdlog/spdlog.h>
@@ -50,13 +52,18 @@ namespace
     unsigned long const maxReq12s = a_params.get<unsigned long>("MaxReq12s", 0);
     unsigned long const maxTrades = a_params.get<unsigned long>("MaxTrades", 0);
 
-    // Calculate the minimum size required to hold the above data. The minimum
-    // size is 64k to allow for small allocations and memory manager overhead:
+    // Calculate the minimum size required to hold the above data (incl the 2
+    // indices of Req12s, and the "LatencyTrace"). The minimum size is 64k to
+    // allow for small allocations and memory manager overhead:
+    unsigned long idxSlots =
+      (maxReq12s != 0) ? KeyIdxNSlots(unsigned(maxReq12s)) : 0;
     unsigned long res =
-      maxAOSes        * sizeof(AOS)   +
-      maxReq12s       * sizeof(Req12) +
-      maxTrades       * sizeof(Trade) +
-      a_extra_shm_size                +
+      maxAOSes        * sizeof(AOS)        +
+      maxReq12s       * sizeof(Req12)      +
+      2 * idxSlots    * sizeof(KeyIdxSlot) +
+      maxTrades       * sizeof(Trade)      +
+      sizeof(LatencyTrace)                 +
+      a_extra_shm_size                     +
       65536;
 
     // Since we reserve "MaxShmSegmSz" of address space  to each mapped segm
@@ -325,7 +332,8 @@ namespace MAQUETTE
     m_ptrTotBytesTx(nullptr),
     m_ptrTotBytesRx(nullptr),
     m_ptrLastTxTS  (nullptr),
-    m_ptrLastRxTS  (nullptr)
+    m_ptrLastRxTS  (nullptr),
+    m_latTrace     (nullptr)
   {
     //-----------------------------------------------------------------------//
     // Some Checks:                                                          //
@@ -388,6 +396,8 @@ namespace MAQUETTE
         segm->find_or_construct<utxx::time_val>(LastTxTS_ON()) ();
       m_ptrLastRxTS   =
         segm->find_or_construct<utxx::time_val>(LastRxTS_ON()) ();
+      m_latTrace      =
+        segm->find_or_construct<LatencyTrace>  (LatencyTraceON())();
     }
     else
     {
@@ -400,16 +410,37 @@ namespace MAQUETTE
       m_ptrTotBytesRx = new unsigned long (0);
       m_ptrLastTxTS   = new utxx::time_val();
       m_ptrLastRxTS   = new utxx::time_val();
+      m_latTrace      = new LatencyTrace();
     }
     // So the Stats Ptrs are always non-NULL:
     assert(m_ptrTotBytesTx != nullptr && m_ptrTotBytesRx != nullptr &&
-           m_ptrLastTxTS   != nullptr && m_ptrLastRxTS   != nullptr);
+           m_ptrLastTxTS   != nullptr && m_ptrLastRxTS   != nullptr &&
+           m_latTrace      != nullptr);
 
     //-----------------------------------------------------------------------//
     // Install the "SecDefD"s from the given "SevDefS"s:                     //
     //-----------------------------------------------------------------------//
+    // If a binary SecDefs Catalog is configured, it is used instead of the
+    // compiled-in "a_all_sec_defs". It is only required during installation
+    // (the "SecDefD"s are copies), so it is unmapped at the end of the Ctor.
+    // NB: Hence Catalog changes are NOT picked up intraday (a re-start is re-
+    // quired), see "Basis/SecDefsCatalog.h":
+    string catalogPath = a_params.get<string>("SecDefsCatalog", "");
+    unique_ptr<SecDefsCatalog> catalog;
+    if (!catalogPath.empty())
+    {
+      catalog.reset(new SecDefsCatalog(catalogPath));
+      LOG_INFO(1,
+        "EConnector::Ctor: Using SecDefsCatalog={}: Source={}, NRecs={}",
+        catalogPath, catalog->GetSource(), catalog->Size())
+    }
+    SecDefsRange allSecDefs =
+      (catalog != nullptr)
+      ? SecDefsRange(*catalog)
+      : SecDefsRange(a_all_sec_defs);
+
     // All "SecDefS"s must really belong to this Exchange:
-    for (SecDefS const& defS: a_all_sec_defs)
+    for (SecDefS const& defS: allSecDefs)
       if (utxx::unlikely
          (strcmp(defS.m_Exchange.data(), m_exchange.data()) != 0))
         throw utxx::badarg_error
@@ -419,7 +450,7 @@ namespace MAQUETTE
     if (a_expl_sds_only)
       // Only explicit SettlDates are allowed, other SecDefs are not installed:
       InstallExplicitSecDefs
-        (a_all_sec_defs, a_only_symbols, a_use_tenors, a_params);
+        (allSecDefs, a_only_symbols, a_use_tenors, a_params);
     else
     {
       // Implicit SettlDates are allowed,  but in this case we probably  should
@@ -430,7 +461,7 @@ namespace MAQUETTE
               ("EConnector::Ctor: UseTenors and ImplicitSettlDates modes "
                "are currently incompatible");
       // If OK:
-      InstallAllSecDefs(a_all_sec_defs, a_only_symbols, a_params);
+      InstallAllSecDefs(allSecDefs, a_only_symbols, a_params);
     }
     // All Done!
   }
@@ -458,6 +489,7 @@ namespace MAQUETTE
         Delete0(m_ptrTotBytesRx);
         Delete0(m_ptrLastTxTS);
         Delete0(m_ptrLastRxTS);
+        Delete0(m_latTrace);
       }
     }
     catch(...){}
@@ -659,7 +691,7 @@ namespace MAQUETTE
   //
   inline void EConnector::InstallExplicitSecDefs
   (
-    vector<SecDefS>             const&  a_all_sec_defs,
+    SecDefsRange                        a_all_sec_defs,
     vector<string>              const*  a_only_symbols,
     bool                                a_use_tenors,    // UseTenorsInSecIDs
     boost::property_tree::ptree const&  a_params
@@ -715,24 +747,25 @@ namespace MAQUETTE
              (anyTenor2 ||
               strcmp(tenor2.data(), a_defs.m_Tenor2.data())       == 0);
           };
-        // Search for the 1st occurrence of out 4-ple:
-        auto cit1 =
-          find_if(a_all_sec_defs.cbegin(), a_all_sec_defs.cend(), selector);
+        // Search for the 1st occurrence of out 4-ple. With a Catalog, only the
+        // "SecDefS"s with this Symbol are searched (via the Symbol Index):
+        SecDefsRange cands = a_all_sec_defs.BySymbol(symbol.data());
+        auto cit1 = find_if(cands.begin(), cands.end(), selector);
 
         // Many Params entries could initially look like an Instrument -- so if
         // the required 4-ple was not found, it's completely normal  (TODO: use
         // a special XML sub-tree for Instruments!). Just continue:
         //
-        if (utxx::likely(cit1 == a_all_sec_defs.cend()))
+        if (utxx::likely(cit1 == cands.end()))
           return true;
 
         // If found, check for Uniqueness. If not unique (found twice), produce
         // an error:
         CHECK_ONLY
         (
-          auto cit2 = find_if(next(cit1), a_all_sec_defs.cend(), selector);
+          auto cit2 = find_if(next(cit1), cands.end(), selector);
 
-          if (utxx::unlikely(cit2 != a_all_sec_defs.cend()))
+          if (utxx::unlikely(cit2 != cands.end()))
             throw utxx::badarg_error
                   ("EConnector::Ctor: ", m_name,   ": Symbol=",
                    symbol.data(),     ", Exchange=", exchange.data(),
@@ -788,7 +821,7 @@ namespace MAQUETTE
   //=========================================================================//
   inline void EConnector::InstallAllSecDefs
   (
-    vector<SecDefS>             const&  a_all_sec_defs,
+    SecDefsRange                        a_all_sec_defs,
     vector<string>              const*  a_only_symbols,
     boost::property_tree::ptree const&  a_params
   )
@@ -12,6 +12,7 @@
 #include "InfraStruct/StaticLimits.h"
 #include "InfraStruct/PersistMgr.h"
 #include "InfraStruct/Strategy.hpp"
+#include "Connectors/LatencyTrace.hpp"
 #include <spdlog/spdlog.h>
 #include <boost/core/noncopyable.hpp>
 #include <boost/container/static_vector.hpp>
@@ -20,6 +21,7 @@
 namespace MAQUETTE
 {
   class SecDefsMgr;
+  class SecDefsRange;
   class RiskMgr;
   class EPollReactor;
 
@@ -40,6 +42,7 @@ namespace MAQUETTE
     constexpr static char const* TotBytesTxON() { return "TotBytesTx"; }
     constexpr static char const* LastRxTS_ON () { return "LastRxTS";   }
     constexpr static char const* LastTxTS_ON () { return "LastTxTS";   }
+    constexpr static char const* LatencyTraceON() { return "LatencyTrace"; }
 
   protected:
     //=======================================================================//
@@ -86,6 +89,12 @@ namespace MAQUETTE
     utxx::time_val*                 m_ptrLastTxTS;
     utxx::time_val*                 m_ptrLastRxTS;
 
+  protected:
+    // Latency HistoGrams of the MDC and OMC Stages (see "LatencyTrace"); also
+    // located in ShM (on Heap for Hist Connectors), shared by the MDC and OMC
+    // parts of this Connector:
+    LatencyTrace*                   m_latTrace;
+
   public:
     //=======================================================================//
     // Ctors, Dtor:                                                          //
@@ -174,6 +183,9 @@ namespace MAQUETTE
     utxx::time_val    GetLastTxTS  ()  const { return *m_ptrLastTxTS;   }
     utxx::time_val    GetLastRxTS  ()  const { return *m_ptrLastRxTS;   }
 
+    // Latency Statistics:
+    LatencyTrace const& GetLatencyTrace() const { return *m_latTrace;   }
+
     //-----------------------------------------------------------------------//
     // Updating Tx and Rx Stats:                                             //
     //-----------------------------------------------------------------------//
@@ -280,7 +292,7 @@ namespace MAQUETTE
     //
     void InstallExplicitSecDefs
     (
-      std::vector<SecDefS>        const&  a_all_sec_defs,
+      SecDefsRange                        a_all_sec_defs,
       std::vector<std::string>    const*  a_only_symbols,
       bool                                a_use_tenors,    // UseTenorsInSecIDs
       boost::property_tree::ptree const&  a_params
@@ -297,7 +309,7 @@ namespace MAQUETTE
     //
     void InstallAllSecDefs
     (
-      std::vector<SecDefS>        const&  a_all_sec_defs,
+      SecDefsRange                        a_all_sec_defs,
       std::vector<std::string>    const*  a_only_symbols,
       boost::property_tree::ptree const&  a_params
     );
@@ -39,6 +39,12 @@ namespace MAQUETTE
                            : m_primaryMDC->m_orderBooks)
                          : nullptr
                         ),
+    m_obIdx             (a_is_enabled
+                         ?(IsPrimaryMDC()
+                           ? new OrderBooksIdx
+                           : m_primaryMDC->m_obIdx)
+                         : nullptr
+                        ),
     m_mktDepth          (a_mkt_depth),
     m_maxOrderBookLevels(0),                      // As yet
     m_isFullAmt         (a_is_full_amt),
@@ -49,6 +55,8 @@ namespace MAQUETTE
     m_withExplTrades    (a_with_expl_trades),
     m_withOLTrades      (a_with_ol_trades),
     m_maxOrders         (a_params.get<long>("MaxOrders", 0)),
+    m_hashedOrders      (a_params.get<bool>("HashedOrdersLog", false)),
+    m_obSnapShotDepth   (a_params.get<int> ("OBSnapShotDepth", 0)),
     m_updated           (),                       // Initially empty
     m_useDynInit        (a_use_dyn_init),
     m_dynInitMode       (a_use_dyn_init),         // DynInitMode NOW!
@@ -59,13 +67,7 @@ namespace MAQUETTE
                          : nullptr),
     m_trdSubscrIDs      (a_is_enabled && HasTrades()
                          ? new ProtoSubscrIDsVec  // Empty as yet
-                         : nullptr),
-    // "LatencyStats" ptrs are set to NULL here, and properly initialised later:
-    m_socketStats       (nullptr),
-    m_procStats         (nullptr),
-    m_updtStats         (nullptr),
-    m_stratStats        (nullptr),
-    m_overAllStats      (nullptr)
+                         : nullptr)
   {
     //-----------------------------------------------------------------------//
     // MDC Functionality Enabled?                                            //
@@ -112,55 +114,19 @@ namespace MAQUETTE
       )
     }
     else
-      m_maxOrderBookLevels = 0;
-
-    //-----------------------------------------------------------------------//
-    // Set Ptrs to Stats:                                                    //
-    //-----------------------------------------------------------------------//
-    if (!IsHistEnv())
     {
-      // For a non-Hist Connector, the PersistMgr must be initialised at this
-      // point (done in "EConnector" Ctor):
-      assert(!m_pm.IsEmpty());
-      auto   segm  = m_pm.GetSegm();
-      assert(segm != nullptr);
-
-      // The Stats Ptrs will then point to ShM:
-      m_socketStats   =
-        segm->find_or_construct<LatencyStats>
-              (SocketStatsON()) ("HWRecv-to-Socket     Latency", 0.0, 10000.0);
-      m_procStats     =
-        segm->find_or_construct<LatencyStats>
-              (ProcStatsON())   ("Socket-to-ProcBuff   Latency", 0.0, 10000.0);
-      m_updtStats     =
-        segm->find_or_construct<LatencyStats>
-              (UpdtStatsON())   ("ProcBuff-to-OBUpdate Latency", 0.0, 10000.0);
-      m_stratStats    =
-        segm->find_or_construct<LatencyStats>
-              (StratStatsON())  ("OBUpdate-to-Strategy Latency", 0.0, 10000.0);
-      m_overAllStats  =
-        segm->find_or_construct<LatencyStats>
-              (OverAllStatsON())("HWRecv-to-Strategy   Latency", 0.0, 20000.0);
-    }
-    else
-    {
-      // In Hist mode, Stats objs will need to be created explicitly on Heap
-      // (this is for integrity only -- they make little sense in this case):
-      m_socketStats =
-        new LatencyStats("HWRecv-to-Socket     Latency", 0.0, 10000.0);
-      m_procStats     =
-        new LatencyStats("Socket-to-ProcBuff   Latency", 0.0, 10000.0);
-      m_updtStats     =
-        new LatencyStats("ProcBuff-to-OBUpdate Latency", 0.0, 10000.0);
-      m_stratStats    =
-        new LatencyStats("OBUpdate-to-Strategy Latency", 0.0, 10000.0);
-      m_overAllStats  =
-        new LatencyStats("HWRecv-to-Strategy   Latency", 0.0, 20000.0);
+      // For Sparse OrderBooks, a non-0 "HybridOBWindow" makes them Hybrid: a
+      // Dense window of (at least) that many levels around L1, plus Maps for
+      // the levels outside the window (see "OrderBook"):
+      m_maxOrderBookLevels = a_params.get<int>("HybridOBWindow", 0);
+      CHECK_ONLY
+      (
+        if (utxx::unlikely(m_maxOrderBookLevels < 0))
+          throw utxx::badarg_error
+                ("EConnector_MktData::Ctor: ",    m_name,
+                 ": Invalid HybridOBWindow=",     m_maxOrderBookLevels);
+      )
     }
-    // So the Stats Ptrs must be non-NULL in any case:
-    assert(m_socketStats  != nullptr && m_procStats  != nullptr &&
-           m_updtStats    != nullptr && m_stratStats != nullptr &&
-           m_overAllStats != nullptr);
 
     //-----------------------------------------------------------------------//
     // Create OrderBooks for all "SecDefD"s created by the parent:           //
@@ -199,6 +165,12 @@ namespace MAQUETTE
           delete m_orderBooks;
         m_orderBooks     = nullptr;
       }
+      if (m_obIdx != nullptr)
+      {
+        if (IsPrimaryMDC())
+          delete m_obIdx;
+        m_obIdx          = nullptr;
+      }
 
       // For any MDC, de-allocate the OBSubscrIDs and TrdSubscrIDs:
       if (m_obSubscrIDs  != nullptr)
@@ -211,17 +183,6 @@ namespace MAQUETTE
         delete m_trdSubscrIDs;
         m_trdSubscrIDs = nullptr;
       }
-
-      // In Hist mode, de-allocate Stats Objs (they were allocated on Heap in
-      // that case); otherwise, they are located in ShM, and preserved there:
-      if (IsHistEnv())
-      {
-        Delete0(m_socketStats);
-        Delete0(m_procStats);
-        Delete0(m_updtStats);
-        Delete0(m_stratStats);
-        Delete0(m_overAllStats);
-      }
     }
     catch(...) {}
   }
@@ -425,9 +386,23 @@ namespace MAQUETTE
   //-------------------------------------------------------------------------//
   OrderBook* EConnector_MktData::FindOrderBook(SecDefD const& a_instr)
   {
-    // Use Linear Search -- it is OK because the number of constructed Order-
-    // Books is typically small. SecDefs are compared by PTR:
-    assert(m_orderBooks != nullptr);
+    // SecDefs are compared by PTR. Find the 1st OrderBook with the same SecID
+    // via the Hash Index; normally, SecIDs of OrderBooks are unique, so it is
+    // either the one we need, or there is none:
+    assert(m_orderBooks != nullptr && m_obIdx != nullptr);
+    int dups = 0;
+    int idx  = m_obIdx->m_bySecID.Find(MkKey16(a_instr.m_SecID), &dups);
+    if (utxx::unlikely(idx < 0))
+      return nullptr;
+
+    OrderBook* ob = m_orderBooks->data() + idx;
+    if (utxx::likely(&(ob->GetInstr()) == &a_instr))
+      return ob;
+    if (utxx::likely(dups == 0))
+      return nullptr;
+
+    // Otherwise (different SecDefs with same SecID -- should not happen if
+    // they all come from the "SecDefsMgr"), fall back to Linear Search:
     auto it =
       boost::container::find_if
       (
@@ -436,7 +411,7 @@ namespace MAQUETTE
         { return &(a_curr.GetInstr()) == &a_instr; }
       );
     return
-      (utxx::likely(it != m_orderBooks->end()))
+      (it != m_orderBooks->end())
       ? &(*it)
       : nullptr;
   }
@@ -447,19 +422,13 @@ namespace MAQUETTE
   OrderBook* EConnector_MktData::FindOrderBook(SecID a_sec_id)
   {
     // XXX: In theory, SecID may be 0 -- but then the result is surely  NULL,
-    // which may or may not be OK for the Caller. Again, use Linear Search by
-    // SecID:
-    assert(m_orderBooks != nullptr);
-    auto it =
-      boost::container::find_if
-      (
-        m_orderBooks->begin(), m_orderBooks->end(),
-        [a_sec_id](OrderBook const& a_curr)->bool
-        { return (a_curr.GetInstr().m_SecID == a_sec_id); }
-      );
+    // which may or may not be OK for the Caller. The Hash Index returns the
+    // 1st OrderBook with this SecID, as Linear Search would:
+    assert(m_orderBooks != nullptr && m_obIdx != nullptr);
+    int idx = m_obIdx->m_bySecID.Find(MkKey16(a_sec_id));
     return
-      (utxx::likely(it != m_orderBooks->end()))
-      ? &(*it)
+      (utxx::likely(idx >= 0))
+      ? m_orderBooks->data() + idx
       : nullptr;
   }
 
@@ -469,45 +438,38 @@ namespace MAQUETTE
   // XXX: This method is somewhat dangerous:   If more than one Instr has same
   // Symbol (eg with different Tenors), it will return the 1st entry found. So
   // it is for internal use only when we KNOW that Symbols are unique. For ex-
-  // tra safety, in the Debug mode only, we  scan  all further OrderBooks, and
-  // make sure there are no repeated Symbols:
+  // tra safety, in the Debug mode only, we check (via the Hash Index) that the
+  // Symbol found is not repeated in further OrderBooks:
   //
   template<bool UseAltSymbol>
   OrderBook* EConnector_MktData::FindOrderBook(char const* a_some_symbol)
   {
     // Try to find this Symbol (XXX: We do not check here whether it is empty
-    // or not, but an empty one would surely result in NULL --  this is to be
-    // handled by the Caller):
-    assert(a_some_symbol != nullptr && m_orderBooks != nullptr);
-    auto selector =
-      [a_some_symbol](OrderBook const& a_curr)->bool
-      { return
-          UseAltSymbol
-          ? (strcmp(a_curr.GetInstr().m_AltSymbol.data(), a_some_symbol) == 0)
-          : (strcmp(a_curr.GetInstr().m_Symbol   .data(), a_some_symbol) == 0);
-      };
-    auto it =
-      boost::container::find_if
-      (m_orderBooks->begin(), m_orderBooks->end(), selector);
+    // or not -- this is to be handled by the Caller). Symbols which do not
+    // fit into "SymKey" cannot be found at all:
+    assert(a_some_symbol != nullptr && m_orderBooks != nullptr &&
+           m_obIdx       != nullptr);
+    Key16 key;
+    if (utxx::unlikely(!MkKey16(a_some_symbol, &key)))
+      return nullptr;
+
+    int dups = 0;
+    int idx  =
+      (UseAltSymbol ? m_obIdx->m_byAltSymbol : m_obIdx->m_bySymbol)
+      .Find(key, &dups);
 
     DEBUG_ONLY(
     // If found, check that the Symbol is unique:
-    if (utxx::likely(it != m_orderBooks->end()))
-    {
-      auto it2 =
-        boost::container::find_if(std::next(it), m_orderBooks->end(), selector);
-
-      if (utxx::unlikely(it2 != m_orderBooks->end()))
-        throw utxx::runtime_error
-              ("EConnector_MktData::FindOrderBook: ",
-               (UseAltSymbol ? "AltSymbol=" : "Symbol="), a_some_symbol,
-               ": Not Unique");
-      }
+    if (utxx::unlikely(idx >= 0 && dups != 0))
+      throw utxx::runtime_error
+            ("EConnector_MktData::FindOrderBook: ",
+             (UseAltSymbol ? "AltSymbol=" : "Symbol="), a_some_symbol,
+             ": Not Unique");
     )
     // If OK (even if not found):
     return
-      (utxx::likely(it != m_orderBooks->end()))
-      ? &(*it)
+      (utxx::likely(idx >= 0))
+      ? m_orderBooks->data() + idx
       : nullptr;
   }
 
@@ -566,9 +528,22 @@ namespace MAQUETTE
       m_contRptSeqs,
       m_maxOrderBookLevels,
       m_mktDepth,
-      m_maxOrders
+      m_maxOrders,
+      m_hashedOrders
     );
 
+    // Possibly enable SnapShots for other threads:
+    if (m_obSnapShotDepth > 0)
+      m_orderBooks->back().EnableSnapShots(m_obSnapShotDepth);
+
+    // Extend the Hash Indices. Repeated keys are allowed here (they are only
+    // marked as such), as they were for Linear Search:
+    assert(m_obIdx != nullptr);
+    int idx = int(m_orderBooks->size()) - 1;
+    (void) m_obIdx->m_bySecID    .Insert(MkKey16(a_instr.m_SecID),     idx);
+    (void) m_obIdx->m_bySymbol   .Insert(MkKey16(a_instr.m_Symbol),    idx);
+    (void) m_obIdx->m_byAltSymbol.Insert(MkKey16(a_instr.m_AltSymbol), idx);
+
     // In parallel with OrderBook creation, install {OB,Trd}SubscrID place-
     // holders:
     assert(m_obSubscrIDs != nullptr);
@@ -783,24 +758,15 @@ namespace MAQUETTE
     long stratLat   = (a_ts_strat       - a_obui.m_updtTS) .nanoseconds();
     long overAllLat = (a_ts_strat       - a_obui.m_recvTS) .nanoseconds();
 
-    // Update the Stats (cut off the extreme vals shich are certainly invalid,
-    // and would only distort the stats):
-    constexpr long MaxNS = 1'000'000'000;   // 1 sec is a reasonable limit
-
-    if (utxx::likely(0 < socketLat  && socketLat  < MaxNS))
-      m_socketStats -> Update(double(socketLat));
-
-    if (utxx::likely(0 < procLat    && procLat    < MaxNS))
-      m_procStats   -> Update(double(procLat));
-
-    if (utxx::likely(0 < updtLat    && updtLat    < MaxNS))
-      m_updtStats   -> Update(double(updtLat));
-
-    if (utxx::likely(0 < stratLat   && stratLat   < MaxNS))
-      m_stratStats  -> Update(double(stratLat));
-
-    if (utxx::likely(0 < overAllLat && overAllLat < MaxNS))
-      m_overAllStats-> Update(double(overAllLat));
+    // Update the Stats (the extreme vals, which are certainly invalid and
+    // would only distort the stats, are cut off by "LatencyTrace"):
+    using ST = LatencyTrace::StageT;
+    assert(m_latTrace != nullptr);
+    m_latTrace->Trace(ST::HWRecvToSocket,  socketLat);
+    m_latTrace->Trace(ST::SocketToProc,    procLat);
+    m_latTrace->Trace(ST::ProcToOBUpdate,  updtLat);
+    m_latTrace->Trace(ST::OBUpdateToStrat, stratLat);
+    m_latTrace->Trace(ST::HWRecvToStrat,   overAllLat);
   }
 }
 // End namespace MAQUETTE
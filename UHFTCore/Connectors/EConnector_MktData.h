@@ -6,11 +6,11 @@
 #pragma once
 
 #include "Basis/BaseTypes.hpp"
+#include "Basis/KeyIdx.hpp"
 #include "Basis/OrdMgmtTypes.hpp"
 #include "Basis/TimeValUtils.hpp"
 #include "Connectors/EConnector.h"
 #include "Connectors/OrderBook.h"
-#include "QuantSupport/HistoGram.hpp"
 #include <utxx/error.hpp>
 #include <spdlog/spdlog.h>
 #include <boost/container/static_vector.hpp>
@@ -26,19 +26,6 @@ namespace MAQUETTE
   //
   class EConnector_MktData: virtual public EConnector
   {
-  public:
-    //=======================================================================//
-    // Names of Persistent Objs:                                             //
-    //=======================================================================//
-    constexpr static char const* SocketStatsON () { return "SocketStats";  }
-    constexpr static char const* ProcStatsON   () { return "ProcStats";    }
-    constexpr static char const* UpdtStatsON   () { return "UpdtStats";    }
-    constexpr static char const* StratStatsON  () { return "StratStats";   }
-    constexpr static char const* OverAllStatsON() { return "OverAllStats"; }
-
-    // Each of the above objs is "LatencyStats":
-    using LatencyStats = QuantSupport::HistoGram<20>;
-
   protected:
     //=======================================================================//
     // "OBUpdateInfo" Struct:                                                //
@@ -101,12 +88,24 @@ namespace MAQUETTE
           boost::container::static_vector<OrderBook, Limits::MaxInstrs>;
     OrderBooksVec*                m_orderBooks;
 
+    // Hash Indices of "m_orderBooks" by SecID, Symbol and AltSymbol (positio-
+    // nal idxs in "m_orderBooks"). They are extended as OrderBooks are creat-
+    // ed, and are owned and shared in the same way as "m_orderBooks" itself:
+    struct OrderBooksIdx
+    {
+      KeyIdx<2 * Limits::MaxInstrs> m_bySecID;
+      KeyIdx<2 * Limits::MaxInstrs> m_bySymbol;
+      KeyIdx<2 * Limits::MaxInstrs> m_byAltSymbol;
+    };
+    OrderBooksIdx*                m_obIdx;
+
     // Max OrderBooks Logical Depth to be maintained (0 for +oo):
     int                           m_mktDepth;
 
     // Max Number of Levels in the Physical OrderBook representation -- should
     // be large enough to accommodate px movements for the whole duration of
-    // continuous trading, even under high volatility:
+    // continuous trading, even under high volatility. For Sparse OrderBooks,
+    // it is the Hybrid window size (0 for purely Map-based OrderBooks):
     int                           m_maxOrderBookLevels;
 
     // Whether pxs are non-sweepable (full-amount): Propagated to OrderBooks:
@@ -144,6 +143,15 @@ namespace MAQUETTE
     // Maximum number of orders in each order book
     long const                    m_maxOrders;
 
+    // Whether the OrdersLog is stored in a Hash Table rather than in an array
+    // indexed by OrderID (then "m_maxOrders" is the max number of live Orders
+    // rather than the max OrderID):
+    bool const                    m_hashedOrders;
+
+    // Depth of OrderBook SnapShots published for other threads after each
+    // batch of updates (see "OBSnapShot"), or 0 if not published:
+    int const                     m_obSnapShotDepth;
+
     // At each "IncrementalRefresh" processed, OrderBook update results will be
     // accumulated here:
     constexpr static int MaxUpdates = 128;
@@ -168,15 +176,6 @@ namespace MAQUETTE
     ProtoSubscrIDsVec*            m_obSubscrIDs;
     ProtoSubscrIDsVec*            m_trdSubscrIDs;
 
-    // Ptrs to HistoGrams collecting latency statistics of MktData progressing
-    // times (in nsec) through this Connector. Actual objs are located  in ShM
-    // or on heap (for Hist Connectors):
-    LatencyStats*                 m_socketStats;  // From HWRecv   to Socket
-    LatencyStats*                 m_procStats;    // From Socket   to Process
-    LatencyStats*                 m_updtStats;    // From Process  to OBUpdate
-    LatencyStats*                 m_stratStats;   // From OBUpdate to Strategy
-    LatencyStats*                 m_overAllStats; // From HWRecv   to Strategy
-                                                  // (Over-All)
     //=======================================================================//
     // Ctors, Dtor and Properties:                                           //
     //=======================================================================//
@@ -265,7 +265,7 @@ namespace MAQUETTE
       // XXX: The following should return the MDEntryID of one of the Orders
       // which made this Trade -- hopefully the Passive one:
       OrderID refID = a_mde.GetEntryRefID();
-      a_order       = a_obp.GetOrderInfo(refID);
+      a_order       = a_obp.FindOrderInfo(refID);
 
       // NB: "a_order" may still be NULL, eg if "refID" was 0, it's OK. But if
       // it is non-NULL, its MDEntryID must be same as RefID of course:
@@ -1169,9 +1169,39 @@ namespace MAQUETTE
     // Get the OrderInfo and perform Integrity Checks:                       //
     //-----------------------------------------------------------------------//
     // NB: In case of any error, the returned DeltaQty is 0 (NOT Invalid)!
+    // A new OrderInfo slot is only created if this update may add an Order;
+    // otherwise, the Order is merely looked up, so that Modify or Delete upd-
+    // ates of unknown OrderIDs (eg filtered out, or placed before we started
+    // receiving the data) do not consume the "OrdersHash" pool:
     //
+    bool const mayBeNew =
+      !WithIncrUpdates || a_action == FIX::MDUpdateActionT::New ||
+      (NewEncdAsChange && a_action == FIX::MDUpdateActionT::Change);
+
     OrderBook::OrderInfo* order =
-      const_cast<OrderBook::OrderInfo*>(a_ob->GetOrderInfo(a_order_id));
+      const_cast<OrderBook::OrderInfo*>
+      (mayBeNew ? a_ob->GetOrderInfo (a_order_id)
+                : a_ob->FindOrderInfo(a_order_id));
+
+    if (!mayBeNew && order == nullptr)
+    {
+      // Attempting to Modify or Delete a non-existing Order: OK in the Non-
+      // Strict RptSeq mode (nothing to do), an error otherwise:
+      if (utxx::likely(!m_contRptSeqs))
+        return
+          std::make_tuple
+            (OrderBook::UpdateEffectT::NONE,
+             OrderBook::UpdatedSidesT::NONE, Qty<QT,QR>(), order);
+
+      LOG_ERROR(2,
+        "EConnector_MktData::ApplyOrderUpdate: Instr={}, OrderID={}: "
+        "Inconsistency: Action={} but the Order does not exist", instrName,
+        a_order_id, char(a_action))
+      return
+        std::make_tuple
+          (OrderBook::UpdateEffectT::ERROR,
+           OrderBook::UpdatedSidesT::NONE, Qty<QT,QR>(), order);
+    }
     CHECK_ONLY
     (
       if (utxx::unlikely(order == nullptr))
@@ -1261,11 +1291,16 @@ namespace MAQUETTE
       {
         // Attempting to Modify or Delete an non-existing Order?
         if (!m_contRptSeqs)
-          // This is quite OK then -- just nothing to do:
+        {
+          // This is quite OK then -- just nothing to do (but the empty slot
+          // which may have just been created, is to be released):
+          if (a_ob->HasHashedOrders() && order->m_req12 == nullptr)
+            a_ob->RetireOrderInfo(order);
           return
             std::make_tuple
               (OrderBook::UpdateEffectT::NONE,
                OrderBook::UpdatedSidesT::NONE, Qty<QT,QR>(), order);
+        }
 
         // Otherewise, it is still an error:
         LOG_ERROR(2,
@@ -1513,6 +1548,12 @@ namespace MAQUETTE
       upd = OrderBook::UpdateEffectT::ERROR;
     }
 
+    // If the Order has been deleted, and the "OrdersHash" is used, its slot is
+    // to be released. This is done in a deferred way, so "order" remains val-
+    // id for the Caller (eg for inferring a Trade):
+    if (a_ob->HasHashedOrders() && !IsPos(order->m_qty))
+      a_ob->RetireOrderInfo(order);
+
     // Finally:
     return std::make_tuple(upd, sides, delta, order);
   }
@@ -1681,6 +1722,11 @@ namespace MAQUETTE
       upd                            = obui.m_effect;
       OrderBook::UpdatedSidesT sides = obui.m_sides;
 
+      // The Book is now consistent, so publish its SnapShot for other threads
+      // (if enabled):
+      if (ob->HasSnapShots())
+        ob->PublishSnapShot(ok, obui.m_exchTS, obui.m_recvTS);
+
       // Notify the RiskMgr if the L1Px has changed:
       if (utxx::unlikely
          (upd == OrderBook::UpdateEffectT::L1Px && m_riskMgr != nullptr))
@@ -37,9 +37,13 @@ namespace MAQUETTE
     m_Req12s               (nullptr),
     m_maxTrades            (0),
     m_Trades               (nullptr),
+    m_nIdxSlots            (0),
+    m_reqsByExchID         (nullptr),
+    m_nByExchID            (0),
+    m_reqsBySeqNum         (nullptr),
+    m_nBySeqNum            (0),
 
-    // Conventional map: NumericExchID => Req12 and other Properties:
-    m_reqsByExchID         (),
+    // Properties:
     // PipeLineMode: can be moved to a higher (but not lower) degree of synchr-
     // onicity based on the run-time "a_params":
     m_pipeLineMode         (std::max<PipeLineModeT>
@@ -128,6 +132,15 @@ namespace MAQUETTE
     m_Trades = m_pm.FindOrConstruct<Trade>(TradesON(), &m_maxTrades);
     assert(m_AOSes != nullptr && m_Req12s != nullptr && m_Trades != nullptr);
 
+    // The Req12 indices. NB: Their sizes must be powers of 2, so if an exist-
+    // ing index is larger than requested, only the requested part is used:
+    m_nIdxSlots    = KeyIdxNSlots(m_maxReq12s);
+    unsigned nSlt1 = m_nIdxSlots;
+    unsigned nSlt2 = m_nIdxSlots;
+    m_reqsByExchID = m_pm.FindOrConstruct<KeyIdxSlot>(ByExchIDON(), &nSlt1);
+    m_reqsBySeqNum = m_pm.FindOrConstruct<KeyIdxSlot>(BySeqNumON(), &nSlt2);
+    assert(m_reqsByExchID != nullptr && m_reqsBySeqNum != nullptr);
+
     //-----------------------------------------------------------------------//
     // Reset the ptrs in AOSes:                                              //
     //-----------------------------------------------------------------------//
@@ -241,17 +254,16 @@ namespace MAQUETTE
              m_maxReqsPerPeriod);
 
     //-----------------------------------------------------------------------//
-    // Optimise the HashTable:                                               //
+    // Re-build the Req12 indices:                                           //
     //-----------------------------------------------------------------------//
-    if (m_useExchOrdIDsMap)
-    {
-      // XXX: PipeLinedReqs may or may not be compatible with UseExchOrdIDsMap.
-      // Currently, ExchOrdIDsMap is a secondary (after ReqID/AOSID) method of
-      // finding the Req12 for a given order -- so we ALLOW it with PipeLined-
-      // Reqs:
-      m_reqsByExchID.max_load_factor(1.0);
-      m_reqsByExchID.reserve        (m_maxReq12s);
-    }
+    // XXX: PipeLinedReqs may or may not be compatible with UseExchOrdIDsMap.
+    // Currently, ExchOrdIDsMap is a secondary (after ReqID/AOSID) method of
+    // finding the Req12 for a given order -- so we ALLOW it with PipeLined-
+    // Reqs.
+    // NB: The indices are in ShM along with the Req12s, but they are re-built
+    // anyway, as the prev process instance may have died while updating them:
+    //
+    ReIndexReq12s();
     //-----------------------------------------------------------------------//
     // Finally, if the RiskMgr is used, register this OMC with it:           //
     //-----------------------------------------------------------------------//
@@ -339,6 +351,39 @@ namespace MAQUETTE
     // istered in the newly-linked MDC!
   }
 
+  //=========================================================================//
+  // "ReIndexReq12s":                                                        //
+  //=========================================================================//
+  void EConnector_OrdMgmt::ReIndexReq12s()
+  {
+    KeyIdxClear(m_reqsByExchID, m_nIdxSlots);
+    KeyIdxClear(m_reqsBySeqNum, m_nIdxSlots);
+    m_nByExchID = 0;
+    m_nBySeqNum = 0;
+
+    // NB: ReqN is the *next* ReqID, and ReqID=1 (not 0) is the initial one.
+    // Go in the order of ReqIDs, so for each ExchID, the 1st Req12 is kept,
+    // and for each SeqNum, the last one (as they were inserted originally):
+    //
+    assert(*m_ReqN <= m_maxReq12s);
+    for (OrderID id = 1; id < *m_ReqN; ++id)
+    {
+      Req12 const* req = m_Req12s + id;
+      if (utxx::unlikely(req->m_id != id || req->m_aos == nullptr))
+        continue;   // Uninitialised
+
+      IndexSeqNum(req);
+
+      if (m_useExchOrdIDsMap && !req->m_exchOrdID.IsEmpty())
+        (void) KeyIdxInsert
+          (m_reqsByExchID, m_nIdxSlots, &m_nByExchID,
+           MkKey16(req->m_exchOrdID), int(id));
+    }
+    LOG_INFO(1,
+      "EConnector_OrdMgmt::ReIndexReq12s: {} Req12s by ExchID, {} by SeqNum",
+      m_nByExchID, m_nBySeqNum)
+  }
+
   //=========================================================================//
   // "GetReq12BySeqNum":                                                     //
   //=========================================================================//
@@ -356,9 +401,43 @@ namespace MAQUETTE
     if (utxx::unlikely(a_sn <= 0))
       return nullptr;
 
-    // NB: ReqN is the *next* ReqID, and ReqID=1 (not 0) is  the initial one:
-    // Traverse the Reqs backwards;  because "SeqNum"s can be reset, stop if
-    // non-monotonicity is encountered. XXX: We will be searching through ALL
+    // The SeqNum of an indexed Req12 should still be the same, unless it was
+    // re-sent by some other means:
+    int    id  =
+      KeyIdxFind(m_reqsBySeqNum, m_nIdxSlots, Key16{uint64_t(a_sn), 0});
+    Req12* req =
+      (utxx::likely(id > 0) && m_Req12s[id].m_seqNum == a_sn)
+      ? m_Req12s + id
+      : FindReq12BySeqNum(a_sn);
+
+    if (utxx::unlikely(req == nullptr))
+      return nullptr;
+
+    // Check the validity of this "req" before returning it:
+    CHECK_ONLY
+    (
+      OrderID reqID = OrderID(req - m_Req12s);
+
+      if (utxx::unlikely(req->m_id != reqID || req->m_aos == nullptr))
+        throw utxx::logic_error
+              ("EConnector_OrdMgmt::GetReq12BySeqNum(", a_where, "): ",
+               m_name, ": Uninitialised Req12 @ ", reqID, ": StoredID=",
+               req->m_id, ((req->m_aos == nullptr) ? "AOS=NULL" : ""));
+    )
+    // If OK:
+    return req;
+  }
+
+  //=========================================================================//
+  // "FindReq12BySeqNum":                                                    //
+  //=========================================================================//
+  // The fall-back for "GetReq12BySeqNum", for Req12s which are not in the in-
+  // dex (eg sent by-passing "TrySendIndications"). The Req12 found is indexed:
+  //
+  Req12* EConnector_OrdMgmt::FindReq12BySeqNum(SeqNum a_sn) const
+  {
+    // Traverse the Reqs backwards; because "SeqNum"s can be reset, stop if
+    // non-monotonicity is encountered. XXX: We may be searching through ALL
     // available Req12s, which may be TERRIBLY inefficient:
     //
     assert(*m_ReqN <= m_maxReq12s);
@@ -370,18 +449,7 @@ namespace MAQUETTE
     {
       if (req->m_seqNum == a_sn)
       {
-        // Check the validity of this "req" before returning it:
-        CHECK_ONLY
-        (
-          OrderID id = OrderID(req - m_Req12s);
-
-          if (utxx::unlikely(req->m_id != id || req->m_aos == nullptr))
-            throw utxx::logic_error
-                  ("EConnector_OrdMgmt::GetReq12BySeqNum(", a_where, "): ",
-                   m_name, ": Uninitialised Req12 @ ", id, ": StoredID=",
-                   req->m_id, ((req->m_aos == nullptr) ? "AOS=NULL" : ""));
-        )
-        // If OK:
+        IndexSeqNum(req);
         return req;
       }
       if (utxx::unlikely(req->m_seqNum < a_sn || req->m_seqNum >= prevSN))
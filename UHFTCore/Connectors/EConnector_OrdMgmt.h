@@ -6,12 +6,12 @@
 #pragma once
 
 #include "Basis/BaseTypes.hpp"
+#include "Basis/KeyIdx.hpp"
 #include "Basis/TimeValUtils.hpp"
 #include "Basis/OrdMgmtTypes.hpp"
 #include "Connectors/EConnector.h"
 #include <utxx/rate_throttler.hpp>
 #include <boost/container/static_vector.hpp>
-#include <unordered_map>
 
 namespace MAQUETTE
 {
@@ -44,6 +44,11 @@ namespace MAQUETTE
     template<typename OMC>
     friend struct OMCTradeProcessor;
 
+    // "OMCNative" (the Native Order Entry API, see below) invokes the "*Gen"
+    // methods on behalf of the Derived OMC:
+    template<typename OMC>
+    friend class  OMCNative;
+
   public:
     //=======================================================================//
     // Names of Persistent Objs:                                             //
@@ -51,6 +56,8 @@ namespace MAQUETTE
     constexpr static char const* AOSesON()  { return "AOSes";   }
     constexpr static char const* Req12sON() { return "Reqs12s"; }
     constexpr static char const* TradesON() { return "Trades";  } // OurTrades!
+    constexpr static char const* ByExchIDON() { return "Req12sByExchID"; }
+    constexpr static char const* BySeqNumON() { return "Req12sBySeqNum"; }
 
     constexpr static char const* RxSN_ON()  { return "RxSN";    }
     constexpr static char const* TxSN_ON()  { return "TxSN";    }
@@ -103,11 +110,15 @@ namespace MAQUETTE
     unsigned               m_maxTrades;
     Trade*                 m_Trades;
 
-    // XXX: An auxiliary HashTable mapping ExcOrdIDs to confirmed Req12s, loca-
-    // ted in conventional process memory. It is currently for numeric ExchIDs
-    // only. Only used if "m_useExchOrdIDsMap" flag (below) is set:
-    mutable std::unordered_map<OrderID, Req12*>
-                           m_reqsByExchID;
+    // Hash indices of Req12s (in ShM, with ReqIDs as Vals), re-built from the
+    // "m_Req12s" on start-up: by ExchOrdIDs (of any format) of confirmed Re-
+    // q12s, only used if "m_useExchOrdIDsMap" flag (below) is set; and by the
+    // SeqNums of sent Req12s (the latest Req12 for a given SeqNum):
+    unsigned               m_nIdxSlots;
+    KeyIdxSlot*            m_reqsByExchID;
+    mutable int            m_nByExchID;
+    KeyIdxSlot*            m_reqsBySeqNum;
+    mutable int            m_nBySeqNum;
 
     // Properties (set by the derived classes). XXX: They could be moved into
     // template params of the methods which use them, but this would probably
@@ -697,6 +708,37 @@ namespace MAQUETTE
       double              a_peg_offset
     );
 
+    //-----------------------------------------------------------------------//
+    // "NewOrderGenN":                                                       //
+    //-----------------------------------------------------------------------//
+    // Same as "NewOrderGen", but with the Qtys already in the Native (OMC-spe-
+    // cific) type, so no conversions are required. "NewOrderGen" converts the
+    // Qtys and invokes this method:
+    //
+    template<QtyTypeT QT, typename QR, typename ProtoEng, typename SessData>
+    AOS* NewOrderGenN
+    (
+      ProtoEng*           a_proto_eng,
+      SessData*           a_sess,
+      Strategy*           a_strategy,
+      SecDefD const&      a_instr,
+      FIX::OrderTypeT     a_ord_type,
+      bool                a_is_buy,
+      PriceT              a_px,
+      bool                a_is_aggr,
+      Qty<QT,QR>          a_qty,
+      utxx::time_val      a_ts_md_exch,
+      utxx::time_val      a_ts_md_conn,
+      utxx::time_val      a_ts_md_strat,
+      bool                a_batch_send,
+      FIX::TimeInForceT   a_time_in_force,
+      int                 a_expire_date,
+      Qty<QT,QR>          a_qty_show,
+      Qty<QT,QR>          a_qty_min,
+      bool                a_peg_side,
+      double              a_peg_offset
+    );
+
     //-----------------------------------------------------------------------//
     // "CancelOrderGen":                                                     //
     //-----------------------------------------------------------------------//
@@ -750,6 +792,28 @@ namespace MAQUETTE
       QtyAny              a_new_qty_min
     );
 
+    //-----------------------------------------------------------------------//
+    // "ModifyOrderGenN":                                                    //
+    //-----------------------------------------------------------------------//
+    // Same as "ModifyOrderGen", but with the Native Qtys:
+    //
+    template<QtyTypeT QT, typename QR, typename ProtoEng, typename SessData>
+    bool ModifyOrderGenN
+    (
+      ProtoEng*           a_proto_eng,
+      SessData*           a_sess,
+      AOS*                a_aos,      // Non-NULL
+      PriceT              a_new_px,
+      bool                a_is_aggr,
+      Qty<QT,QR>          a_new_qty,
+      utxx::time_val      a_ts_md_exch,
+      utxx::time_val      a_ts_md_conn,
+      utxx::time_val      a_ts_md_strat,
+      bool                a_batch_send,
+      Qty<QT,QR>          a_new_qty_show,
+      Qty<QT,QR>          a_new_qty_min
+    );
+
     //-----------------------------------------------------------------------//
     // "CancelAllOrdersGen":                                                 //
     //-----------------------------------------------------------------------//
@@ -913,9 +977,9 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // "GetReq12ByExchID":                                                   //
     //-----------------------------------------------------------------------//
-    // NON-Throwing (Non-Strict), returns NULL if a suitable Req12 not found.
-    // XXX: Relatively inefficient, so it should only be used as a last resort
-    // when the main "GetReq12" method yields nothing. Px is optional:
+    // NON-Throwing (Non-Strict), returns NULL if a suitable Req12 not found
+    // (or if "m_useExchOrdIDsMap" is not set).   A hash lookup, but it should
+    // still only be used when the main "GetReq12" method yields nothing:
     //
     template<unsigned Mask>
     Req12* GetReq12ByExchID(ExchOrdID const& a_exch_id) const;
@@ -925,10 +989,20 @@ namespace MAQUETTE
     // "GetReq12BySeqNum":                                                   //
     //-----------------------------------------------------------------------//
     // NB: This is currently a NON-Throwing function (in case of the SeqNum is
-    // not found -- NULL is returned). Very inefficient,    so only applies to
-    // failed orders:
+    // not found -- NULL is returned). A hash lookup; a linear search is only
+    // done if the SeqNum is not in the index:
     //
     Req12* GetReq12BySeqNum(SeqNum a_sn, char const* a_where) const;
+    Req12* FindReq12BySeqNum(SeqNum a_sn) const;
+
+    //-----------------------------------------------------------------------//
+    // "IndexSeqNum", "ReIndexReq12s":                                       //
+    //-----------------------------------------------------------------------//
+    // "IndexSeqNum" is invoked once a Req12 has been sent (and so has got its
+    // SeqNum); "ReIndexReq12s" re-builds both indices from the ShM Req12s:
+    //
+    void IndexSeqNum(Req12 const* a_req) const;
+    void ReIndexReq12s();
 
     //-----------------------------------------------------------------------//
     // "GetTargetReq12":                                                     //
@@ -1156,4 +1230,107 @@ namespace MAQUETTE
     void PusherTimerErrHandler
          (int a_err_code, uint32_t a_events, char const* a_msg);
   };
+
+  //=========================================================================//
+  // "OrderDesc": Compact Descriptor of a New Order:                         //
+  //=========================================================================//
+  // Used by the Native Order Entry API (see "OMCNative" below). The Qtys are
+  // in the Native type of the OMC, ie "Qty<OMC::QT, OMC::QR>",  so they need
+  // no conversions. The defaults are same as in the Virtual "NewOrder"; Peg-
+  // ged Orders are not supported by this API:
+  //
+  template<QtyTypeT QT, typename QR>
+  struct OrderDesc
+  {
+    SecDefD const*      m_instr       = nullptr;  // Non-NULL
+    PriceT              m_px;                     // NaN for Mkt Orders
+    Qty<QT,QR>          m_qty;                    // Full Qty
+    Qty<QT,QR>          m_qtyShow     = Qty<QT,QR>::PosInf();
+    Qty<QT,QR>          m_qtyMin;                 // 0: No minimum
+
+    // Temporal params of the triggering MktData event:
+    utxx::time_val      m_tsMDExch;
+    utxx::time_val      m_tsMDConn;
+    utxx::time_val      m_tsMDStrat;
+
+    FIX::OrderTypeT     m_ordType     = FIX::OrderTypeT::Limit;
+    FIX::TimeInForceT   m_timeInForce = FIX::TimeInForceT::UNDEFINED;
+    int                 m_expireDate  = 0;        // Or YYYYMMDD
+    bool                m_isBuy       = false;
+    bool                m_isAggr      = false;
+    bool                m_batchSend   = false;    // Recommendation Only!
+  };
+
+  //=========================================================================//
+  // "OMCNative": Native (Non-Virtual) Order Entry API:                      //
+  //=========================================================================//
+  // CRTP base of concrete OMCs: "OMC" is the Derived class itself; it must be
+  // derived from "EConnector_OrdMgmt" and serve as its own ProtoEngine and
+  // SessMgr (as "EConnector_TWIME_FORTS" and "EConnector_FIX<D>" do). Strat-
+  // egies templated on the concrete OMC type can use the methods below inst-
+  // ead of the Virtual ones:
+  // (*) there is no virtual dispatch, so the whole path down to the "*Impl"
+  //     Call-Backs of the OMC can be inlined into the Strategy;
+  // (*) a New Order is given by an "OrderDesc" instead of ~20 args, and the
+  //     Qtys are Native, so the "QtyAny" conversions are skipped;
+  // (*) the OMC-specific checks of "OrderDesc", if any, are provided by the
+  //     static "OMC::CheckNewOrderN" (the default one below does nothing);
+  // (*) the Risk Checks and the Req12s state machine are those of the Virtual
+  //     API ("NewOrderGenN" etc), so both APIs can be used on the same OMC:
+  //
+  template<typename OMC>
+  class OMCNative
+  {
+  public:
+    //-----------------------------------------------------------------------//
+    // "NewOrderN":                                                          //
+    //-----------------------------------------------------------------------//
+    template<QtyTypeT QT, typename QR>
+    AOS const* NewOrderN
+    (
+      Strategy*               a_strategy,     // Non-NULL
+      OrderDesc<QT,QR> const& a_od
+    );
+
+    //-----------------------------------------------------------------------//
+    // "CancelOrderN":                                                       //
+    //-----------------------------------------------------------------------//
+    bool CancelOrderN
+    (
+      AOS const*              a_aos,          // Non-NULL
+      utxx::time_val          a_ts_md_exch    = utxx::time_val(),
+      utxx::time_val          a_ts_md_conn    = utxx::time_val(),
+      utxx::time_val          a_ts_md_strat   = utxx::time_val(),
+      bool                    a_batch_send    = false
+    );
+
+    //-----------------------------------------------------------------------//
+    // "ModifyOrderN":                                                       //
+    //-----------------------------------------------------------------------//
+    // The semantics of the args is same as for the Virtual "ModifyOrder":
+    //
+    template<QtyTypeT QT, typename QR>
+    bool ModifyOrderN
+    (
+      AOS const*              a_aos,          // Non-NULL
+      PriceT                  a_new_px,
+      bool                    a_is_aggr,
+      Qty<QT,QR>              a_new_qty,
+      utxx::time_val          a_ts_md_exch    = utxx::time_val(),
+      utxx::time_val          a_ts_md_conn    = utxx::time_val(),
+      utxx::time_val          a_ts_md_strat   = utxx::time_val(),
+      bool                    a_batch_send    = false,
+      Qty<QT,QR>              a_new_qty_show  = Qty<QT,QR>::PosInf(),
+      Qty<QT,QR>              a_new_qty_min   = Qty<QT,QR>::Zero  ()
+    );
+
+  protected:
+    //-----------------------------------------------------------------------//
+    // "CheckNewOrderN": Default (No-Op) OMC-Specific Checks:                //
+    //-----------------------------------------------------------------------//
+    // May be hidden by a static method of the same name in "OMC"; invoked in
+    // the Checked Mode only:
+    template<QtyTypeT QT, typename QR>
+    static void CheckNewOrderN(OrderDesc<QT,QR> const&) {}
+  };
 } // End namespace MAQUETTE
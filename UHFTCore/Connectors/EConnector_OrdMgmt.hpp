@@ -36,6 +36,58 @@ namespace MAQUETTE
     bool               a_peg_side,     // True: This side; False: Opposite side
     double             a_peg_offset    // Can be <=> 0.0
   )
+  {
+    //-----------------------------------------------------------------------//
+    // Convert the user-level Qtys into the OMC-specific ones:               //
+    //-----------------------------------------------------------------------//
+    // XXX:
+    // (*) This is rather expensive!
+    // (*) QtyA <-> QtyB conversions require a Px, for which only "a_px" is av-
+    //     ailable at this point (if at all), so in those cases the result may
+    //     be quite inaccurate, or an exception could be raised. The Px is rou-
+    //     nded here as it will be in "NewOrderGenN":
+    PriceT     px      = Round(a_px, a_instr.m_PxStep);
+    Qty<QT,QR> qty     = a_qty     .ConvQty<QT,QR>(a_instr, px);
+    Qty<QT,QR> qtyShow = a_qty_show.ConvQty<QT,QR>(a_instr, px);
+    Qty<QT,QR> qtyMin  = a_qty_min .ConvQty<QT,QR>(a_instr, px);
+
+    // The rest is done with the Native Qtys:
+    return NewOrderGenN<QT, QR, ProtoEng, SessData>
+    (
+      a_proto_eng,    a_sess,          a_strategy,    a_instr,
+      a_ord_type,     a_is_buy,        a_px,          a_is_aggr,
+      qty,            a_ts_md_exch,    a_ts_md_conn,  a_ts_md_strat,
+      a_batch_send,   a_time_in_force, a_expire_date, qtyShow,
+      qtyMin,         a_peg_side,      a_peg_offset
+    );
+  }
+
+  //=========================================================================//
+  // "NewOrderGenN":                                                         //
+  //=========================================================================//
+  template <QtyTypeT QT, typename QR, typename ProtoEng, typename SessData>
+  inline AOS* EConnector_OrdMgmt::NewOrderGenN
+  (
+    ProtoEng*          a_proto_eng,
+    SessData*          a_sess,
+    Strategy*          a_strategy,
+    SecDefD const&     a_instr,
+    FIX::OrderTypeT    a_ord_type,
+    bool               a_is_buy,
+    PriceT             a_px,
+    bool               a_is_aggr,      // Intended to be Aggressive?
+    Qty<QT,QR>         a_qty,          // Full intended Qty
+    utxx::time_val     a_ts_md_exch,
+    utxx::time_val     a_ts_md_conn,
+    utxx::time_val     a_ts_md_strat,
+    bool               a_batch_send,   // To send several msgs at once
+    FIX::TimeInForceT  a_time_in_force,
+    int                a_expire_date,
+    Qty<QT,QR>         a_qty_show,     // Intended Qty Show
+    Qty<QT,QR>         a_qty_min,      // Intended Qty Min
+    bool               a_peg_side,     // True: This side; False: Opposite side
+    double             a_peg_offset    // Can be <=> 0.0
+  )
   {
     //-----------------------------------------------------------------------//
     // Verify the Args:                                                      //
@@ -81,16 +133,11 @@ namespace MAQUETTE
     a_px = Round(a_px, a_instr.m_PxStep);
 
     //-----------------------------------------------------------------------//
-    // Convert, Normalise and Verify the Qtys:                               //
+    // Normalise and Verify the Qtys:                                        //
     //-----------------------------------------------------------------------//
-    // Convert the user-level Qtys into the OMC-specific ones. XXX:
-    // (*) This is rather expensive!
-    // (*) QtyA <-> QtyB conversions require a Px, for which only "a_px" is av-
-    //     ailable at this point (if at all), so in those cases the result may
-    //     be quite inaccurate, or an exception could be raised:
-    Qty<QT,QR> qty     = a_qty     .ConvQty<QT,QR>(a_instr, a_px);
-    Qty<QT,QR> qtyShow = a_qty_show.ConvQty<QT,QR>(a_instr, a_px);
-    Qty<QT,QR> qtyMin  = a_qty_min .ConvQty<QT,QR>(a_instr, a_px);
+    Qty<QT,QR> qty     = a_qty;
+    Qty<QT,QR> qtyShow = a_qty_show;
+    Qty<QT,QR> qtyMin  = a_qty_min;
 
     // Normalise them:
     qtyShow.MinWith(qty);
@@ -485,6 +532,47 @@ namespace MAQUETTE
     QtyAny          a_new_qty_show,   // ditto
     QtyAny          a_new_qty_min     // ditto
   )
+  {
+    //-----------------------------------------------------------------------//
+    // Get the SecDef and convert Qtys into Native ones:                     //
+    //-----------------------------------------------------------------------//
+    assert(a_aos != nullptr);
+    SecDefD const& instr  = *(a_aos->m_instr);
+
+    // XXX: Again, providing "a_new_px" in case we need a QtyA<->QtyB convers-
+    // ion; the result may be inaccurate, or fail altogether:
+    Qty<QT,QR> newQty     = a_new_qty     .ConvQty<QT,QR>(instr, a_new_px);
+    Qty<QT,QR> newQtyShow = a_new_qty_show.ConvQty<QT,QR>(instr, a_new_px);
+    Qty<QT,QR> newQtyMin  = a_new_qty_min .ConvQty<QT,QR>(instr, a_new_px);
+
+    // The rest is done with the Native Qtys:
+    return ModifyOrderGenN<QT, QR, ProtoEng, SessData>
+    (
+      a_proto_eng,   a_sess,        a_aos,         a_new_px,
+      a_is_aggr,     newQty,        a_ts_md_exch,  a_ts_md_conn,
+      a_ts_md_strat, a_batch_send,  newQtyShow,    newQtyMin
+    );
+  }
+
+  //=========================================================================//
+  // "ModifyOrderGenN":                                                      //
+  //=========================================================================//
+  template<QtyTypeT QT, typename QR, typename ProtoEng, typename SessData>
+  inline bool EConnector_OrdMgmt::ModifyOrderGenN
+  (
+    ProtoEng*       a_proto_eng,
+    SessData*       a_sess,
+    AOS*            a_aos,            // Non-NULL
+    PriceT          a_new_px,
+    bool            a_is_aggr,        // Intended to be Aggressive?
+    Qty<QT,QR>      a_new_qty,        // Full Qty
+    utxx::time_val  a_ts_md_exch,
+    utxx::time_val  a_ts_md_conn,
+    utxx::time_val  a_ts_md_strat,
+    bool            a_batch_send,     // To send multiple msgs at once
+    Qty<QT,QR>      a_new_qty_show,   // ditto
+    Qty<QT,QR>      a_new_qty_min     // ditto
+  )
   {
     //-----------------------------------------------------------------------//
     // Checks:                                                               //
@@ -513,16 +601,11 @@ namespace MAQUETTE
     constexpr bool IsTandem  =  !ProtoEng::HasAtomicModify;
     assert(m_hasAtomicModify == !IsTandem);
 
-    //-----------------------------------------------------------------------//
-    // Get the SecDef and convert Qtys into Native ones:                     //
-    //-----------------------------------------------------------------------//
+    // The SecDef and the Qtys (the latter may be adjusted below):
     SecDefD const& instr  = *(a_aos->m_instr);
-
-    // XXX: Again, providing "a_new_px" in case we need a QtyA<->QtyB convers-
-    // ion; the result may be inaccurate, or fail altogether:
-    Qty<QT,QR> newQty     = a_new_qty     .ConvQty<QT,QR>(instr, a_new_px);
-    Qty<QT,QR> newQtyShow = a_new_qty_show.ConvQty<QT,QR>(instr, a_new_px);
-    Qty<QT,QR> newQtyMin  = a_new_qty_min .ConvQty<QT,QR>(instr, a_new_px);
+    Qty<QT,QR> newQty     = a_new_qty;
+    Qty<QT,QR> newQtyShow = a_new_qty_show;
+    Qty<QT,QR> newQtyMin  = a_new_qty_min;
 
     //-----------------------------------------------------------------------//
     // Req(s) to send and OrigReq:                                           //
@@ -1023,6 +1106,9 @@ namespace MAQUETTE
       req->m_status        = Req12::StatusT::Confirmed;
       req->m_ts_conf_exch  = a_ts_exch;
       req->m_ts_conf_conn  = a_ts_recv;
+
+      // All TimeStamps of this Req12 are now known, so trace its latencies:
+      m_latTrace->TraceReq12(*req);
     }
     // All Done!
     return res;
@@ -1690,6 +1776,7 @@ namespace MAQUETTE
         a_req->m_status        = Req12::StatusT::Confirmed;
         a_req->m_ts_conf_exch  = a_ts_exch;
         a_req->m_ts_conf_conn  = a_ts_recv;
+        m_latTrace->TraceReq12(*a_req);
       }
     }
     // At this point, we must have a valid Req12 with the Status being at least
@@ -2506,5 +2593,95 @@ namespace MAQUETTE
     else
       return NaN<double>;
   }
+
+  //=========================================================================//
+  // "OMCNative": Native Order Entry API:                                    //
+  //=========================================================================//
+  //-------------------------------------------------------------------------//
+  // "NewOrderN":                                                            //
+  //-------------------------------------------------------------------------//
+  template<typename OMC>
+  template<QtyTypeT QT, typename QR>
+  inline AOS const* OMCNative<OMC>::NewOrderN
+  (
+    Strategy*               a_strategy,
+    OrderDesc<QT,QR> const& a_od
+  )
+  {
+    static_assert(QT == OMC::QT && std::is_same_v<QR, typename OMC::QR>,
+                  "OMCNative::NewOrderN: OrderDesc must have Native Qtys");
+    assert(a_od.m_instr != nullptr);
+
+    // OMC-specific checks (statically dispatched):
+    CHECK_ONLY(OMC::CheckNewOrderN(a_od);)
+
+    // Invoke the generic impl directly; "OMC" is both the ProtoEngine and the
+    // SessMgr:
+    OMC* omc = static_cast<OMC*>(this);
+    return omc->EConnector_OrdMgmt::template NewOrderGenN<QT, QR>
+    (
+      omc,               omc,               a_strategy,
+      *a_od.m_instr,     a_od.m_ordType,    a_od.m_isBuy,
+      a_od.m_px,         a_od.m_isAggr,     a_od.m_qty,
+      a_od.m_tsMDExch,   a_od.m_tsMDConn,   a_od.m_tsMDStrat,
+      a_od.m_batchSend,  a_od.m_timeInForce, a_od.m_expireDate,
+      a_od.m_qtyShow,    a_od.m_qtyMin,     true,
+      NaN<double>        // Not Pegged
+    );
+  }
+
+  //-------------------------------------------------------------------------//
+  // "CancelOrderN":                                                         //
+  //-------------------------------------------------------------------------//
+  template<typename OMC>
+  inline bool OMCNative<OMC>::CancelOrderN
+  (
+    AOS const*      a_aos,
+    utxx::time_val  a_ts_md_exch,
+    utxx::time_val  a_ts_md_conn,
+    utxx::time_val  a_ts_md_strat,
+    bool            a_batch_send
+  )
+  {
+    OMC* omc = static_cast<OMC*>(this);
+    return omc->EConnector_OrdMgmt::template CancelOrderGen
+                                             <OMC::QT, typename OMC::QR>
+    (
+      omc,           omc,           const_cast<AOS*>(a_aos),
+      a_ts_md_exch,  a_ts_md_conn,  a_ts_md_strat,  a_batch_send
+    );
+  }
+
+  //-------------------------------------------------------------------------//
+  // "ModifyOrderN":                                                         //
+  //-------------------------------------------------------------------------//
+  template<typename OMC>
+  template<QtyTypeT QT, typename QR>
+  inline bool OMCNative<OMC>::ModifyOrderN
+  (
+    AOS const*      a_aos,
+    PriceT          a_new_px,
+    bool            a_is_aggr,
+    Qty<QT,QR>      a_new_qty,
+    utxx::time_val  a_ts_md_exch,
+    utxx::time_val  a_ts_md_conn,
+    utxx::time_val  a_ts_md_strat,
+    bool            a_batch_send,
+    Qty<QT,QR>      a_new_qty_show,
+    Qty<QT,QR>      a_new_qty_min
+  )
+  {
+    static_assert(QT == OMC::QT && std::is_same_v<QR, typename OMC::QR>,
+                  "OMCNative::ModifyOrderN: Qtys must be Native");
+
+    OMC* omc = static_cast<OMC*>(this);
+    return omc->EConnector_OrdMgmt::template ModifyOrderGenN<QT, QR>
+    (
+      omc,            omc,             const_cast<AOS*>(a_aos),
+      a_new_px,       a_is_aggr,       a_new_qty,
+      a_ts_md_exch,   a_ts_md_conn,    a_ts_md_strat,
+      a_batch_send,   a_new_qty_show,  a_new_qty_min
+    );
+  }
 }
 // End namespace MAQUETTE
@@ -411,31 +411,27 @@ namespace MAQUETTE
   template<unsigned Mask>
   Req12* EConnector_OrdMgmt::GetReq12ByExchID(ExchOrdID const& a_exch_id) const
   {
-    // (*) ExchIDs Map must be supported. Then, only numeric "ExchOrdID"s are
-    //     currently supported (XXX: for efficiency; should we change that?);
+    // (*) ExchIDs Map must be supported ("ExchOrdID"s of any format are OK);
     // (*) This method is not applicable if UnChangedOrdIDs flag is set, as in
     //     that case, we cannot determine a unique Req12 with a given ExchID:
-    CHECK_ONLY
-    (
-      if (utxx::unlikely
-         (!m_useExchOrdIDsMap || a_exch_id.IsEmpty() || !a_exch_id.IsNum()))
-        return nullptr;
-    )
-    OrderID oid  = a_exch_id.GetOrderID();
-    assert (oid != 0);
-    auto it = m_reqsByExchID.find(oid);
-    if (utxx::unlikely(it == m_reqsByExchID.end()))
+    if (utxx::unlikely(!m_useExchOrdIDsMap || a_exch_id.IsEmpty()))
       return nullptr;
 
-    // If found:
-    Req12* req  = it->second;
-    assert(req != nullptr && req->m_exchOrdID == a_exch_id);
+    int id = KeyIdxFind(m_reqsByExchID, m_nIdxSlots, MkKey16(a_exch_id));
+    if (utxx::unlikely(id < 0))
+      return nullptr;
+
+    // If found: Non-numeric IDs are hashed, so verify the ID itself:
+    assert(unsigned(id) < m_maxReq12s);
+    Req12* req = m_Req12s + id;
+    if (utxx::unlikely(req->m_exchOrdID != a_exch_id))
+      return nullptr;
 
     if (utxx::unlikely((unsigned(req->m_kind) & Mask) == 0))
     {
       LOG_WARN(2,
         "EConnector_OrdMgmt::GetReq12ByExchID: ExchID={}: MisMatch: Mask={}, "
-        "ReqKind={}", oid, Mask, unsigned(req->m_kind))
+        "ReqKind={}", a_exch_id.ToString(), Mask, unsigned(req->m_kind))
       req = nullptr;
     }
     // XXX: Return what we got (even NULL):
@@ -1715,6 +1711,11 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // If we got here: Sent!                                                 //
     //-----------------------------------------------------------------------//
+    // The Req12(s) sent have got their SeqNums now:
+    IndexSeqNum(a_ind_req);
+    if (nReqsSent == 2)
+      IndexSeqNum(a_next_ind);
+
     // NB: If it was a BatchSend, the CallER,  not this method,  is responsible
     // for Flushing the wire orders (eventually).
     // But WE are responsible for stats: Increment or reset NBuffReqs depending
@@ -1730,6 +1731,22 @@ namespace MAQUETTE
     return ready2 != ReadyT::Throttled;
   }
 
+  //=========================================================================//
+  // "IndexSeqNum":                                                          //
+  //=========================================================================//
+  // A later Req12 with the same SeqNum (after a SeqNums reset) replaces the
+  // earlier one in the index:
+  //
+  inline void EConnector_OrdMgmt::IndexSeqNum(Req12 const* a_req) const
+  {
+    assert(a_req != nullptr);
+    if (utxx::unlikely(a_req->m_seqNum <= 0))
+      return;
+    (void) KeyIdxAssign
+      (m_reqsBySeqNum, m_nIdxSlots, &m_nBySeqNum,
+       Key16{uint64_t(a_req->m_seqNum), 0}, int(a_req->m_id));
+  }
+
   //=========================================================================//
   // "MemoiseIndication":                                                    //
   //=========================================================================//
@@ -1831,16 +1848,16 @@ namespace MAQUETTE
            targ.ToString(),           ", New=", src.ToString());
       )
     }
-    // If the checks are OK: Update the { ExchID => Req12 } map (only for nume-
-    // ric ExchIDs -- if this map is maintained at all).  HOWEVER, this is inc-
-    // ompatible with UnChangedOrdIDs flag,  as in that case, more than 1 ReqID
-    // can correspond to a given (unchanged) ExchOrdID:
+    // If the checks are OK: Update the { ExchID => Req12 } index (if it is
+    // maintained at all).  HOWEVER, this is incompatible with UnChangedOrdIDs
+    // flag, as in that case, more than 1 ReqID can correspond to a given (un-
+    // changed) ExchOrdID:
     //
     if (m_useExchOrdIDsMap)
     {
       CHECK_ONLY
       (
-        if (utxx::unlikely(a_exch_id.IsEmpty() || !a_exch_id.IsNum()))
+        if (utxx::unlikely(a_exch_id.IsEmpty()))
         {
           if ((a_req->m_kind & Req12::KindT::Cancel) > 0) {
             // this is a cancel, it's ok to not have an ExchOrdID
@@ -1853,30 +1870,30 @@ namespace MAQUETTE
              " : Invalid ExchOrdID=", a_exch_id.ToString());
         }
       )
-      // Otherwise:
-      OrderID oid  = a_exch_id.GetOrderID();
-      assert (oid != 0);
-      auto it =  m_reqsByExchID.find(oid);
-
-      if  (it == m_reqsByExchID.end())
-        // Yes, memoise the (oid => a_req):
-        (void)   m_reqsByExchID.insert(std::make_pair(oid, a_req));
-      else
+      // Otherwise: Memoise the (ExchID => ReqID), unless the ExchID is alrea-
+      // dy there:
+      if (utxx::unlikely(a_exch_id.IsEmpty()))
+        return;
+      int  reqID = int(a_req->m_id);
+      bool isNew =
+        KeyIdxInsert(m_reqsByExchID, m_nIdxSlots, &m_nByExchID,
+                     MkKey16(a_exch_id),    reqID);
+      if (!isNew)
       {
-        // If the pair (oid => a_req) is already there, then "oid" should point
-        // to the same Req12 (by ptr comparison),  because it was inserted on
-        // the 1st Confirm. If not, do NOT over-write the Req12 -- produce an
-        // error msg but continue;
+        // If the ExchID is already there, then it should point to the same
+        // Req12, because it was inserted on the 1st Confirm. If not, do NOT
+        // over-write the Req12 -- produce an error msg but continue:
         CHECK_ONLY
         (
-          Req12* storedReq  = it->second;
-          assert(storedReq != nullptr);
+          int storedID =
+            KeyIdxFind(m_reqsByExchID, m_nIdxSlots, MkKey16(a_exch_id));
+          assert(storedID > 0);
 
-          if (utxx::unlikely(it->second != a_req))
+          if (utxx::unlikely(storedID != reqID))
             LOG_ERROR(2,
               "EConnector_OrdMgmt::ApplyExchID({}): Inconsistency for ExchID="
               "{}: OldReqID={}, NewReqID={}",
-              a_where,   oid, storedReq->m_id, a_req->m_id)
+              a_where, a_exch_id.ToString(), storedID, reqID)
         )
       }
     }
@@ -379,7 +379,7 @@ namespace MAQUETTE
         IsPrimaryMDC()
         ? new SnapShotsCh
           (
-            a_snap_shots_conf,
+            WithRecvBatch    (a_snap_shots_conf, a_params),
             GetInterfaceIP   (a_params, 'A'),
             static_cast<EConnector_FAST_Der*>(this),
             a_params.get<int>("MaxInitRounds",   5)
@@ -401,14 +401,14 @@ namespace MAQUETTE
       m_obIncrsChA
       (
         'A',
-        a_order_incrs_confs.first,
+        WithRecvBatch    (a_order_incrs_confs.first,  a_params),
         GetInterfaceIP   (a_params, 'A'),
         this             // This MDC (incl Buffer, Processor, etc)
       ),
       m_obIncrsChB
       (
         'B',
-        a_order_incrs_confs.second,
+        WithRecvBatch    (a_order_incrs_confs.second, a_params),
         GetInterfaceIP   (a_params, 'B'),
         this             // Ditto
       ),
@@ -446,14 +446,14 @@ namespace MAQUETTE
       m_tradeIncrsChA
         ((m_tradeProc != nullptr)
          ? new TradeIncrsCh
-               ('A', a_trades_confs->first,
+               ('A', WithRecvBatch(a_trades_confs->first,  a_params),
                 GetInterfaceIP(a_params, 'A'), this) // This MDC incl Buff, Proc
          : nullptr),
 
       m_tradeIncrsChB
         ((m_tradeProc != nullptr)
          ? new TradeIncrsCh
-               ('B', a_trades_confs->second,
+               ('B', WithRecvBatch(a_trades_confs->second, a_params),
                 GetInterfaceIP(a_params, 'B'), this) // Ditto
          : nullptr)
     {
@@ -720,6 +720,30 @@ namespace MAQUETTE
               ("EConnector_FAST::GetInterfaceIP: Invalid IPs=", ipsStr);
       }
     }
+
+    //-----------------------------------------------------------------------//
+    // "WithRecvBatch": Install the "RecvBatch" param into a static Config:  //
+    //-----------------------------------------------------------------------//
+    // "RecvBatch" is the max number of DataGrams received by 1 "recvmmsg" call
+    // on each SSM Channel. The default is 0: 1 "recvmsg" call per DataGram (as
+    // before "recvmmsg" support); otherwise, it must be in [1..NU]:
+    //
+    static SSM_Config WithRecvBatch
+    (
+      SSM_Config                  const& a_config,
+      boost::property_tree::ptree const& a_params
+    )
+    {
+      int batch = a_params.get<int>("RecvBatch", 0);
+      if (utxx::unlikely(batch < 0 || batch > EPollReactor::NU))
+        throw utxx::badarg_error
+              ("EConnector_FAST::WithRecvBatch: Invalid RecvBatch=", batch,
+               ": Must be in [0..", EPollReactor::NU, ']');
+
+      SSM_Config res  = a_config;
+      res.m_recvBatch = batch;
+      return res;
+    }
   };
   // End of "EConnector_FAST" class decl
 }
@@ -50,7 +50,8 @@ namespace MAQUETTE
   class    EConnector_FIX final:
     public EConnector_OrdMgmt,
     public EConnector_MktData,
-    public FIX_ConnectorSessMgr<D, EConnector_FIX<D>>
+    public FIX_ConnectorSessMgr<D, EConnector_FIX<D>>,
+    public OMCNative<EConnector_FIX<D>>
   {
   private:
     //=======================================================================//
@@ -94,7 +94,10 @@ namespace MAQUETTE
     ProtoEngT
     (
       this,                     // SessMgr
-      a_processor               // Processor
+      a_processor,              // Processor
+      a_params.get<bool>
+        ("ZeroCopyRead", FIX::ProtocolFeatures<D>::s_zeroCopyRead),
+      a_params.get<bool>("HotOrderTmpls", true)
     ),
     //-----------------------------------------------------------------------//
     // Finally, this class:                                                  //
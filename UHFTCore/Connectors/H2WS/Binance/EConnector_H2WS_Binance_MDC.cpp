@@ -106,6 +106,7 @@ namespace MAQUETTE
     m_updateMissedNotify(true),
     m_lastUpdateID      (),
     m_mdMsg             (),
+    m_jsonIdx           (),
     m_ssTimerFD         (-1)
   {
     //-----------------------------------------------------------------------//
@@ -8,6 +8,7 @@
 #include "Connectors/H2WS/Binance/EConnector_H2WS_Binance_OMC.h"
 #include "Venues/Binance/Configs_H2WS.h"
 #include "Protocols/FIX/Msgs.h"
+#include "Protocols/JSONIndex.hpp"
 #include "string.h"
 #include <type_traits>
 
@@ -308,6 +309,7 @@ namespace MAQUETTE
     mutable std::map<SymKey, OrderID> m_lastUpdateID;
 
     mutable MDMsg                     m_mdMsg; // Buff for curr SnapShot/Trade
+    mutable JSON::StructIdx           m_jsonIdx; // Of the curr msg
     int                               m_ssTimerFD;
 
   public:
@@ -407,6 +409,12 @@ namespace MAQUETTE
                     utxx::time_val   a_ts_handl
     );
 
+    template<bool IsSnapShot>
+    bool ParseLevels(JSON::Cursor*   a_cur,
+                     bool            a_is_bid,
+                     int*            a_off
+    );
+
     //=======================================================================//
     // Session Mgmt:                                                         //
     //=======================================================================//
@@ -15,7 +15,7 @@
 #include "Connectors/H2WS/Binance/EConnector_H2WS_Binance_MDC.h"
 #include "Connectors/EConnector_MktData.h"
 #include "Connectors/EConnector_MktData.hpp"
-#include "Protocols/JSONParseMacros.h"
+#include "Protocols/JSONIndex.hpp"
 
 //===========================================================================//
 // Find and update stream ID in map                                          //
@@ -221,44 +221,131 @@ namespace MAQUETTE
   //=========================================================================//
   // Parsers                                                                 //
   //=========================================================================//
+  // NB: All parsers below index the whole msg once ("JSON::StructIdx"),  and
+  // then traverse it by keys, so the order of flds (which differs between the
+  // Spot and Futures APIs) does not matter, and un-needed flds are skipped
+  // without re-scanning them:
+  //
+  //=========================================================================//
+  // "ParseLevels":                                                          //
+  //=========================================================================//
+  // Parses an array of [Px, Qty] pairs (quoted or not) into "m_mdMsg" entries
+  // starting from "*a_off". Levels which do not fit into "m_mdMsg" are skip-
+  // ped (with a warning) rather than written beyond its end. Returns "false"
+  // if an invalid Px or Qty was encountered (then the whole msg is to be
+  // skipped):
+  //
+  template <Binance::AssetClassT::type AC>
+  template <bool IsSnapShot>
+  bool EConnector_H2WS_Binance_MDC<AC>::ParseLevels
+  (
+    JSON::Cursor*  a_cur,
+    bool           a_is_bid,
+    int*           a_off
+  )
+  {
+    assert(a_cur != nullptr && a_off != nullptr);
+    if (!a_cur->EnterArr())
+      return true;    // Empty side
+
+    int off      = *a_off;
+    int nSkipped = 0;
+    do
+    {
+      a_cur->EnterArr();
+      double px  = a_cur->GetDouble();
+      a_cur->Expect(',');
+      double qty = a_cur->GetDouble();
+      if (utxx::unlikely(a_cur->NextElem()))
+        a_cur->LeaveArr();
+
+      // Check what we got:
+      CHECK_ONLY
+      (
+        if (utxx::unlikely(!(px > 0.0 && (IsSnapShot ? qty > 0.0
+                                                     : qty >= 0.0))))
+        {
+          LOG_WARN(2,
+            "EConnector_H2WS_Binance_MDC::ParseLevels: {}: Invalid Px={} or "
+            "Qty={}: {} skipped", ToCStr(m_mdMsg.m_symbol), px, qty,
+            IsSnapShot ? "SnapShot" : "Update")
+          return false;
+        }
+      )
+      if (utxx::unlikely(off >= MDMsg::MaxMDEs))
+      {
+        ++nSkipped;
+        continue;
+      }
+      // Save the "px" and "qty":
+      MDEntryST&  mde = m_mdMsg.m_entries[off]; // REF!
+      mde.m_entryType =
+        a_is_bid ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
+      mde.m_px        = PriceT(px);
+      mde.m_qty       = QtyN  (qty);
+      ++off;
+    }
+    while (a_cur->NextElem());
+
+    if (utxx::unlikely(nSkipped > 0))
+      LOG_WARN(2,
+        "EConnector_H2WS_Binance_MDC::ParseLevels: {}: {} {} Levels beyond "
+        "MaxMDEs={} skipped", ToCStr(m_mdMsg.m_symbol), nSkipped,
+        a_is_bid ? "Bid" : "Ask", MDMsg::MaxMDEs)
+    *a_off = off;
+    return true;
+  }
+
   //=========================================================================//
   // "ProcessUpdate":                                                        //
   //=========================================================================//
   template <Binance::AssetClassT::type AC>
   bool EConnector_H2WS_Binance_MDC<AC>::ProcessUpdate
   (
-    char const*    a_curr,
+    char const*    UNUSED_PARAM(a_curr),
     char const*    a_msg_body,
     int            a_msg_len,
     utxx::time_val a_ts_recv,
     utxx::time_val a_ts_handl
   )
   {
-    m_mdMsg.m_nEntrs = m_mdMsg.MaxMDEs;   // NB: Bids + Asks!
-    char const* curr = a_curr;
-    char const* end  = a_msg_body + a_msg_len;
-    SKP_STR("{\"e\":\"depthUpdate\",\"E\":")
-
-    unsigned long lastUpdateID = m_lastUpdateID[m_mdMsg.m_symbol];
+    m_jsonIdx.Build(a_msg_body, a_msg_len);
+    JSON::Cursor     cur(m_jsonIdx);
+    std::string_view key;
 
-    // E: Event time
-    unsigned long eventTime = 0;
-    curr = utxx::fast_atoi<unsigned long, false>(curr, end, eventTime);
+    unsigned long firstID = 0;   // U: First updID of the pack
+    unsigned long lastID  = 0;   // u: Last  updID of the pack
+    int           off     = 0;   // Bids + Asks
+    bool          ok      = true;
 
-    // s: Symbol
-    curr = strstr(curr, "\"s\":\"") + 5;
-    GET_STR(symbol)
-    InitFixedStr(&m_mdMsg.m_symbol, symbol);
-
-    // U: First updID of the pack
-    curr = strstr(curr, "\"U\":") + 4;
-    unsigned long firstID = 0;
-    curr = utxx::fast_atoi<unsigned long, false>(curr, end, firstID);
+    cur.EnterObj();
+    while (ok && cur.NextKey(&key))
+    {
+      if (key == "s")
+      {
+        std::string_view symbol = cur.GetStr();
+        InitFixedStr(&m_mdMsg.m_symbol, symbol.data(), symbol.size());
+      }
+      else
+      if (key == "U")
+        firstID = cur.GetInt<unsigned long>();
+      else
+      if (key == "u")
+        lastID  = cur.GetInt<unsigned long>();
+      else
+      if (key == "b" || key == "a")
+        ok = ParseLevels<false>(&cur, key == "b", &off);
+      else
+        cur.SkipVal();    // "e", "E", and Futures-specific "T", "pu"
+    }
+    // Skip the entire msg if it contains invalid entries, but still continue
+    // reading:
+    if (utxx::unlikely(!ok))
+      return true;
+    m_mdMsg.m_nEntrs = off;
 
-    // u: Last updID of the pack
-    curr = strstr(curr, "\"u\":") + 4;
-    unsigned long lastID = 0;
-    curr = utxx::fast_atoi<unsigned long, false>(curr, end, lastID);
+    // NB: The Symbol is now known, so get its LastUpdateID:
+    unsigned long lastUpdateID = m_lastUpdateID[m_mdMsg.m_symbol];
 
     // CHECKS
     if (lastID <= lastUpdateID)
@@ -286,97 +373,12 @@ namespace MAQUETTE
         // return true;
     }
 
-    // In case of Futures there are extra fields to be skipped
-    if constexpr (IsFut)
-      curr = strstr(curr, ",\"b\"");
-
-    // Bids (b==1) and Asks (b==0) Arrays:
-    int off = 0;
-    for (int  b = 1; b >= 0; --b)
-    {
-      // Key: "bids" or "asks":
-      bool isBid(b);
-      if  (isBid)
-      {
-        SKP_STR(",\"b\":[")
-      }
-      else
-      {
-        SKP_STR(",\"a\":[")
-      }
-
-      if (utxx::unlikely(*curr == ']'))
-      {
-        ++curr;
-        continue;
-      }
-      ++curr;
-
-      for (int i = 0; i < m_mdMsg.MaxMDEs; ++i)
-      {
-        // The weird processing is due to Binance missing an occasional
-        // quotation mark:
-        if (*curr == '\"')
-          ++curr;
-
-        double px  = NaN<double>;
-        curr = utxx::atof(curr, end, px);
-        if (*curr == '\"')
-          ++curr;
-        assert(*curr == ',');
-        ++curr;
-        if (*curr == '\"')
-          ++curr;
-
-        double qty = NaN<double>;
-        curr = utxx::atof(curr, end, qty);
-        if (*curr == '\"')
-          ++curr;
-        assert(*curr == ']');
-
-        // Check what we got:
-        CHECK_ONLY
-        (
-          if (utxx::unlikely(!(px > 0.0 && qty >= 0.0)))
-          {
-            LOG_WARN(2,
-              "EConnector_H2WS_Binance_MDC::ProcessUpdate: {}: Invalid Px={} "
-              "or Qty={}: SnapShot skipped", a_msg_body, px, qty)
-            // Skip the entire msg (as the SnapShot is invalid), but still
-            // continue reading:
-            return true;
-          }
-        )
-        // Save the "px" and "qty":
-        MDEntryST&  mde = m_mdMsg.m_entries[off]; // REF!
-        mde.m_entryType =
-          isBid ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
-        mde.m_px        = PriceT(px);
-        mde.m_qty       = QtyN  (qty);
-        ++off;
-
-        // Next: It could be either next Entry, or Side Done:
-        if (utxx::unlikely(strncmp(curr, "]]", 2) == 0))
-        {
-          curr += 2;
-          break;  // Yes, Side Done
-        }
-
-        // If not done yet:
-        SKP_STR("],[")
-      }
-    }
-    // At the end:
-    m_mdMsg.m_nEntrs = off;
-    SKP_STR ("}")
-    assert(curr == end);
-
     //-------------------------------------------------------------------//
     // SnapShot done, process it in "EConnector_MktData":                //
     //-------------------------------------------------------------------//
     // NB: "UpdateOrderBooks" takes care of notifying the Strategies:
     //
-    CHECK_ONLY(bool ok =) EConnector_MktData::UpdateOrderBooks
+    CHECK_ONLY(ok =) EConnector_MktData::UpdateOrderBooks
     <
       false,    // !IsSnapShot
       IsMultiCast,
@@ -405,15 +407,16 @@ namespace MAQUETTE
         // Nothing else to do here -- Strategy mgmt already done!
       }
     )
-
-    a_curr = curr;
     return true;
   }
 
+  //=========================================================================//
+  // "ProcessBBA":                                                           //
+  //=========================================================================//
   template <Binance::AssetClassT::type AC>
   bool EConnector_H2WS_Binance_MDC<AC>::ProcessBBA
   (
-    char const*    a_curr,
+    char const*    UNUSED_PARAM(a_curr),
     char const*    a_msg_body,
     int            a_msg_len,
     utxx::time_val a_ts_recv,
@@ -421,60 +424,38 @@ namespace MAQUETTE
   )
   {
     m_mdMsg.m_nEntrs = 2;
-    char const* curr = a_curr;
-    char const* end  = a_msg_body + a_msg_len;
-
-    SKP_STR("{")
-
-    if constexpr (IsFut && !IsFutC)
-      SKP_STR("\"e\":\"bookTicker\",")
-
-    SKP_STR("\"u\":")
-    curr = std::find(curr, end, ',');
+    MDEntryST& bid   = m_mdMsg.m_entries[0];
+    MDEntryST& ask   = m_mdMsg.m_entries[1];
+    bid.m_entryType  = FIX::MDEntryTypeT::Bid;
+    ask.m_entryType  = FIX::MDEntryTypeT::Offer;
 
-    if constexpr (IsFutC)
-      SKP_STR(",\"e\":\"bookTicker\"")
+    m_jsonIdx.Build(a_msg_body, a_msg_len);
+    JSON::Cursor     cur(m_jsonIdx);
+    std::string_view key;
 
-    SKP_STR(",\"s\":\"")
-    GET_STR(symbol)
-    InitFixedStr(&m_mdMsg.m_symbol, symbol);
-
-    if constexpr (IsFutC)
-    {
-      SKP_STR(",\"ps\":\"")
-      curr = std::find(curr, end, ',');
-    }
-
-    char* after = nullptr;
+    cur.EnterObj();
+    while (cur.NextKey(&key))
     {
-      SKP_STR(",\"b\":\"")
-      MDEntryST& bid = m_mdMsg.m_entries[0];
-      bid.m_entryType = FIX::MDEntryTypeT::Bid;
-      bid.m_px = PriceT(strtod(curr, &after));
-      curr = after;
-      SKP_STR("\",\"B\":\"")
-      bid.m_qty = QtyN(strtod(curr, &after));
-      curr = after;
-    }
-    {
-      SKP_STR("\",\"a\":\"")
-      MDEntryST& ask = m_mdMsg.m_entries[1];
-      ask.m_entryType = FIX::MDEntryTypeT::Offer;
-      ask.m_px = PriceT(strtod(curr, &after));
-      curr = after;
-      SKP_STR("\",\"A\":\"")
-      ask.m_qty = QtyN(strtod(curr, &after));
-      curr = after;
-    }
-
-    if constexpr (IsFut) {
-      curr = strchr(curr, '}');
-      ++curr;
+      if (key == "s")
+      {
+        std::string_view symbol = cur.GetStr();
+        InitFixedStr(&m_mdMsg.m_symbol, symbol.data(), symbol.size());
+      }
+      else
+      if (key == "b")
+        bid.m_px  = cur.GetPx();
+      else
+      if (key == "B")
+        bid.m_qty = cur.GetQty<QtyN>();
+      else
+      if (key == "a")
+        ask.m_px  = cur.GetPx();
+      else
+      if (key == "A")
+        ask.m_qty = cur.GetQty<QtyN>();
+      else
+        cur.SkipVal();    // "u", and Futures-specific "e", "ps", "E", "T"
     }
-    else
-      SKP_STR("\"}")
-
-    assert(curr == end);
 
     CHECK_ONLY(bool ok =) EConnector_MktData::UpdateOrderBooks
     <
@@ -504,7 +485,6 @@ namespace MAQUETTE
           "Failed", ToCStr(m_mdMsg.m_symbol))
       }
     )
-    a_curr = curr;
     return true;
   }
 
@@ -514,76 +494,57 @@ namespace MAQUETTE
   template <Binance::AssetClassT::type AC>
   bool EConnector_H2WS_Binance_MDC<AC>::ProcessTrade
   (
-    char const*    a_curr,
+    char const*    UNUSED_PARAM(a_curr),
     char const*    a_msg_body,
     int            a_msg_len,
     utxx::time_val a_ts_recv,
     utxx::time_val UNUSED_PARAM(a_ts_handl)
   )
   {
-    char const* curr = a_curr;
-    char const* end  = a_msg_body + a_msg_len;
     m_mdMsg.m_nEntrs = 1;
     MDEntryST&   mde = m_mdMsg.m_entries[0];
-
-    SKP_STR("{\"e\":\"trade\",\"E\":")
-
-    // "E":EventTime, in msec from the Epoch; not very useful, as we also
-    // receive the Trade (Aggression) time below; so skip it:
-    unsigned long eventTime = 0;
-    curr = utxx::fast_atoi<unsigned long, false>(curr, end, eventTime);
-
-    // "s": Symbol
-    SKP_STR(",\"s\":\"")
-    GET_STR(symbol)
-    InitFixedStr(&m_mdMsg.m_symbol, symbol);
-
-    // "t": tradeID
-    SKP_STR(",\"t\":")
-    curr = utxx::fast_atoi<OrderID, false>(curr, end, mde.m_execID);
-
-    // "p":Px, a floating-point number in ""s:
-    SKP_STR(",\"p\":\"")
-    char*  after = nullptr;
-    mde.m_px     = PriceT(strtod(curr, &after));
-    curr         = after;
-
-    // "q":Qty (QtyA in this case), again in ""s:
-    SKP_STR("\",\"q\":\"")
-    mde.m_qty    = QtyN  (strtod(curr, &after));
-    curr         = after;
-
-    // "b":Buyer OrderID: Currently ignored:
-    SKP_STR("\",\"b\":")
-    OrderID b  = 0;
-    curr       = utxx::fast_atoi<OrderID, false>(curr, end, b);
-
-    // "a":Seller OrderID: Currently ignored:
-    SKP_STR(",\"a\":")
-    OrderID a  = 0;
-    curr       = utxx::fast_atoi<OrderID, false>(curr, end, a);
-
-    // "T":AggressionTime (in msec from the Epoch):
-    SKP_STR(",\"T\":")
-    unsigned long  T = 0;
-    curr             = utxx::fast_atoi<unsigned long, false>(curr, end, T);
-    m_mdMsg.m_exchTS = utxx::time_val(utxx::msecs(T));
-
+    mde.m_entryType  = FIX::MDEntryTypeT::Trade;
     // "m":BuyerIsMarketMaker:
     // If true, it means that PassiveSide=Buyer, ie Aggressor=Seller(Offer).
     // Otherwise, Aggressor=Buyer(Bid):
-    SKP_STR (",\"m\":")
-    GET_BOOL(sellAggr)
+    bool sellAggr    = false;
 
-    mde.m_entryType     = FIX::MDEntryTypeT::Trade;
-    FIX::SideT aggrSide =
-       sellAggr ? FIX::SideT::Sell         : FIX::SideT::Buy;
+    m_jsonIdx.Build(a_msg_body, a_msg_len);
+    JSON::Cursor     cur(m_jsonIdx);
+    std::string_view key;
 
-    // "M":ReservedBoolean:
-    SKP_STR (",\"M\":")
-    GET_BOOL(reserved)
-    SKP_STR ("}")
-    assert(curr == end);
+    cur.EnterObj();
+    while (cur.NextKey(&key))
+    {
+      if (key == "s")
+      {
+        std::string_view symbol = cur.GetStr();
+        InitFixedStr(&m_mdMsg.m_symbol, symbol.data(), symbol.size());
+      }
+      else
+      if (key == "t")
+        mde.m_execID = cur.GetInt<OrderID>();
+      else
+      if (key == "p")
+        mde.m_px     = cur.GetPx();
+      else
+      if (key == "q")
+        // QtyA in this case:
+        mde.m_qty    = cur.GetQty<QtyN>();
+      else
+      if (key == "T")
+        // AggressionTime (in msec from the Epoch):
+        m_mdMsg.m_exchTS =
+          utxx::time_val(utxx::msecs(cur.GetInt<unsigned long>()));
+      else
+      if (key == "m")
+        sellAggr     = cur.GetBool();
+      else
+        // "e", "E" (EventTime), "b", "a" (Buyer and Seller OrderIDs) and "M"
+        // (Reserved) are currently ignored:
+        cur.SkipVal();
+    }
+    FIX::SideT aggrSide = sellAggr ? FIX::SideT::Sell : FIX::SideT::Buy;
 
     //-----------------------------------------------------------------------//
     // Now Process this Trade:                                               //
@@ -607,7 +568,6 @@ namespace MAQUETTE
     EConnector_MktData::ProcessTrade<false, QT, QR, OMC>
       (m_mdMsg, mde, nullptr, *ob, mde.m_qty, aggrSide, a_ts_recv);
 
-    a_curr = curr;
     return true;
   }
 
@@ -617,102 +577,66 @@ namespace MAQUETTE
   template <Binance::AssetClassT::type AC>
   bool EConnector_H2WS_Binance_MDC<AC>::ProcessAggrTrade
   (
-    char const*    a_curr,
+    char const*    UNUSED_PARAM(a_curr),
     char const*    a_msg_body,
     int            a_msg_len,
     utxx::time_val a_ts_recv,
     utxx::time_val UNUSED_PARAM(a_ts_handl)
   )
   {
-    char const* curr = a_curr;
-    char const* end  = a_msg_body + a_msg_len;
     m_mdMsg.m_nEntrs = 1;
     MDEntryST&   mde = m_mdMsg.m_entries[0];
-
-    SKP_STR("{\"e\":\"aggTrade\",\"E\":")
-
-    // "E":EventTime, in msec from the Epoch; not very useful, as we also
-    // receive the Trade (Aggression) time below; so skip it:
-    unsigned long eventTime = 0;
-    curr = utxx::fast_atoi<unsigned long, false>(curr, end, eventTime);
-
-    //-----------------------------------------------------------------------//
-    // DIFFERENT PROCESSING FOR FUTURES AND SPOT                             //
-    //-----------------------------------------------------------------------//
-    // For Margin and Futures "a" and "s" are in reverse order
-    if constexpr (!IsFut)
-    {
-      // "s":Symbol
-      SKP_STR(",\"s\":\"")
-      GET_STR(symbol)
-      InitFixedStr(&m_mdMsg.m_symbol, symbol);
-
-      // "a":AggrTradeID:
-      SKP_STR(",\"a\":")
-      curr = utxx::fast_atoi<OrderID, false>(curr, end, mde.m_execID);
-    }
-    else
+    mde.m_entryType  = FIX::MDEntryTypeT::Trade;
+    bool sellAggr    = false;
+    DEBUG_ONLY(OrderID f = 0; OrderID l = 0;)
+
+    m_jsonIdx.Build(a_msg_body, a_msg_len);
+    JSON::Cursor     cur(m_jsonIdx);
+    std::string_view key;
+
+    // NB: For Margin and Futures, "a" and "s" come in the reverse order, but
+    // it does not matter here:
+    cur.EnterObj();
+    while (cur.NextKey(&key))
     {
-      // "a":AggrTradeID:
-      SKP_STR(",\"a\":")
-      curr = utxx::fast_atoi<OrderID, false>(curr, end, mde.m_execID);
-
-      // "s":Symbol; should be the upper-case equivalent of "altSymbol":
-      SKP_STR(",\"s\":\"")
-      GET_STR(symbol)
-      InitFixedStr(&m_mdMsg.m_symbol, symbol);
+      if (key == "s")
+      {
+        std::string_view symbol = cur.GetStr();
+        InitFixedStr(&m_mdMsg.m_symbol, symbol.data(), symbol.size());
+      }
+      else
+      if (key == "a")
+        // AggrTradeID:
+        mde.m_execID = cur.GetInt<OrderID>();
+      else
+      if (key == "p")
+        // (XXX: Since it is an Aggregate Trade resulting from a single Aggr-
+        // ession, the Px, presumably, is a VWAP of individual matches):
+        mde.m_px     = cur.GetPx();
+      else
+      if (key == "q")
+        mde.m_qty    = cur.GetQty<QtyN>();
+      else
+      if (key == "T")
+        m_mdMsg.m_exchTS =
+          utxx::time_val(utxx::msecs(cur.GetInt<unsigned long>()));
+      else
+      if (key == "m")
+        sellAggr     = cur.GetBool();
+#     ifndef NDEBUG
+      else
+      if (key == "f")
+        f = cur.GetInt<OrderID>();   // FirstMatchID: only checked
+      else
+      if (key == "l")
+        l = cur.GetInt<OrderID>();   // LastMatchID:  only checked
+#     endif
+      else
+        cur.SkipVal();
     }
-
-    // "p":Px
-    // (XXX: Since it is an Aggregate Trade resulting from a single Aggress-
-    // sion, the Px, presumably, is a VWAP of individual matches). NB: It is
-    // a floating-point number in ""s:
-    SKP_STR(",\"p\":\"")
-    char* after = nullptr;
-    mde.m_px    = PriceT(strtod(curr, &after));
-    curr        = after;
-
-    // "q":Qty (QtyA in this case), again in ""s:
-    SKP_STR("\",\"q\":\"")
-    mde.m_qty   = QtyN  (strtod(curr, &after));
-    curr        = after;
-
-    // "f":FirstMatchID: Currently ignored:
-    SKP_STR("\",\"f\":")
-    OrderID f   = 0;
-    curr        = utxx::fast_atoi<OrderID, false>(curr, end, f);
-
-    // "l":LastMatchID:  Currently ignored (only checked against "fID"):
-    SKP_STR(",\"l\":")
-    OrderID l   = 0;
-    curr        = utxx::fast_atoi<OrderID, false>(curr, end, l);
     assert(f <= l);
-
-    // "T":AggressionTime (in msec from the Epoch):
-    SKP_STR(",\"T\":")
-    unsigned long  T = 0;
-    curr             = utxx::fast_atoi<unsigned long, false>(curr, end, T);
-    m_mdMsg.m_exchTS = utxx::time_val(utxx::msecs(T));
-
-    // "m":BuyerIsMarketMaker:
-    // If true, it means that PassiveSide=Buyer, ie Aggressor=Seller(Offer).
-    // Otherwise, Aggressor=Buyer(Bid):
-    SKP_STR (",\"m\":")
-    GET_BOOL(sellAggr)
-
-    mde.m_entryType = FIX::MDEntryTypeT::Trade;
     FIX::SideT aggrSide = sellAggr ? FIX::SideT::Sell : FIX::SideT::Buy;
 
-    if constexpr (!IsFut)
-    {
-      // "M":ReservedBoolean:
-      SKP_STR (",\"M\":")
-      GET_BOOL(reserved)
-    }
-
-    SKP_STR ("}")
-    assert(curr == end);
-
     //-----------------------------------------------------------------------//
     // Now Process this Trade:                                               //
     //-----------------------------------------------------------------------//
@@ -735,7 +659,6 @@ namespace MAQUETTE
     EConnector_MktData::ProcessTrade<false, QT, QR, OMC>
         (m_mdMsg, mde, nullptr, *ob, mde.m_qty, aggrSide, a_ts_recv);
 
-    a_curr = curr;
     return true;
   }
 
@@ -745,109 +668,50 @@ namespace MAQUETTE
   template <Binance::AssetClassT::type AC>
   bool EConnector_H2WS_Binance_MDC<AC>::ProcessSnapShot
   (
-    char const*     a_curr,
+    char const*     UNUSED_PARAM(a_curr),
     char const*     a_msg_body,
     int             a_msg_len,
     utxx::time_val  a_ts_recv,
     utxx::time_val  a_ts_handl
   )
   {
-    m_mdMsg.m_nEntrs = m_mdMsg.MaxMDEs;   // NB: Bids + Asks!
-    char const* curr = a_curr;
-    char const* end  = a_msg_body + a_msg_len;
-
-    if (strncmp(curr, ",\"data", 6) == 0)
-      // WS stream
-      SKP_STR(",\"data\":{\"lastUpdateId\":")
-    else
-      // H2 snapshot
-      SKP_STR("{\"lastUpdateId\":")
-
-    // SeqNum (LastUpdateID):
-    unsigned long seqNum = 0;
-    curr = utxx::fast_atoi<unsigned long, false>(curr, end, seqNum);
-
-    // Update lastUpdateID for symbol
-    m_lastUpdateID[m_mdMsg.m_symbol] = seqNum;
-    m_updateMissedNotify = true;
-
-    if constexpr (IsFut)
-      // In Futures API, there are E and T fields here
-      curr = strstr(curr, ",\"bids");
-
-    // Bids (b==1) and Asks (b==0) Arrays:
-    int off = 0;
-    for (int  b = 1; b >= 0; --b)
+    m_jsonIdx.Build(a_msg_body, a_msg_len);
+    JSON::Cursor     cur(m_jsonIdx);
+    std::string_view key;
+    int              off = 0;   // Bids + Asks
+    bool             ok  = true;
+
+    cur.EnterObj();
+    while (ok && cur.NextKey(&key))
     {
-      // Key: "bids" or "asks":
-      bool isBid(b);
-      if  (isBid)
-        SKP_STR(",\"bids\":[[")
-      else
-        SKP_STR(",\"asks\":[[")
-
-      for (int i = 0; i < m_mdMsg.MaxMDEs; ++i)
+      if (key == "lastUpdateId")
       {
-        if (*curr == '\"')
-          ++curr;
-
-        double px  = NaN<double>;
-        curr = utxx::atof(curr, end, px);
-        if (*curr == '\"')
-          ++curr;
-        assert(*curr == ',');
-        ++curr;
-        if (*curr == '\"')
-          ++curr;
-
-        double qty = NaN<double>;
-        curr = utxx::atof(curr, end, qty);
-        if (*curr == '\"')
-          ++curr;
-        assert(*curr == ']');
-
-        // Check what we got:
-        CHECK_ONLY
-        (
-          if (utxx::unlikely(!(px > 0.0 && qty > 0.0)))
-          {
-           LOG_WARN(2,
-              "EConnector_H2WS_Binance_MDC::ProcessSnapShot: {}: Invalid Px={}"
-              " or Qty={}: SnapShot skipped", a_curr, px, qty)
-            // Skip the entire msg (as the SnapShot is invalid), but still
-            // continue reading:
-            return true;
-          }
-        )
-        // Save the "px" and "qty":
-        MDEntryST&  mde = m_mdMsg.m_entries[off]; // REF!
-        mde.m_entryType =
-          isBid ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
-        mde.m_px        = PriceT(px);
-        mde.m_qty       = QtyN  (qty);
-        ++off;
-
-        // Next: It could be either next Entry, or Side Done:
-        if (utxx::unlikely(strncmp(curr, "]]", 2) == 0))
-        {
-          curr += 2;
-          break;  // Yes, Side Done
-        }
-        // If not done yet:
-        SKP_STR("],[")
+        // SeqNum (LastUpdateID): Update it for the Symbol:
+        m_lastUpdateID[m_mdMsg.m_symbol] = cur.GetInt<unsigned long>();
+        m_updateMissedNotify = true;
       }
+      else
+      if (key == "bids" || key == "asks")
+        ok = ParseLevels<true>(&cur, key == "bids", &off);
+      else
+      if (key == "data")
+        // WS stream: The SnapShot is wrapped into "data":
+        cur.EnterObj();
+      else
+        cur.SkipVal();    // Futures-specific "E", "T"
     }
-    // At the end:
+    // Skip the entire msg if it contains invalid entries, but still continue
+    // reading:
+    if (utxx::unlikely(!ok))
+      return true;
     m_mdMsg.m_nEntrs = off;
-    SKP_STR("}")
-    assert(curr == end);
 
     //-------------------------------------------------------------------//
     // SnapShot done, process it in "EConnector_MktData":                //
     //-------------------------------------------------------------------//
     // NB: "UpdateOrderBooks" takes care of notifying the Strategies:
     //
-    CHECK_ONLY(bool ok =) EConnector_MktData::UpdateOrderBooks
+    CHECK_ONLY(ok =) EConnector_MktData::UpdateOrderBooks
     <
       true,    // IsSnapShot
       IsMultiCast,
@@ -876,8 +740,6 @@ namespace MAQUETTE
         // Nothing else to do here -- Strategy mgmt already done!
       }
     )
-
-    a_curr = curr;
     return true;
   }
 } // End namespace MAQUETTE
@@ -9,6 +9,7 @@
 #include "Protocols/H2WS/WSProtoEngine.hpp"
 #include "Venues/BitFinex/Configs_WS.h"
 #include "Venues/BitFinex/SecDefs.h"
+#include "Protocols/JSONIndex.hpp"
 #include <utxx/compiler_hints.hpp>
 #include <utxx/convert.hpp>
 #include <utxx/error.hpp>
@@ -445,8 +446,8 @@ namespace MAQUETTE
     ++curr;
 
     // Qty and Side
-    char*  after = nullptr;
-    double qty   = strtod(curr, &after);
+    char const* after = nullptr;
+    double qty   = JSON::StrToD(curr, a_end, &after);
     assert(curr != after);
 
     curr         = after + 1;
@@ -459,7 +460,7 @@ namespace MAQUETTE
     FIX::SideT aggrSide = qty < 0 ? FIX::SideT::Sell : FIX::SideT::Buy;
 
     // Price
-    double px = strtod(curr, &after);
+    double px = JSON::StrToD(curr, a_end, &after);
     assert(curr != after);
     curr      = after;
     mde.m_px  = PriceT(px);
@@ -639,9 +640,9 @@ namespace MAQUETTE
     double qty = NaN<double>;
 
     char const* curr = a_data + 1;
-    char* after      = nullptr;
+    char const* after = nullptr;
 
-    px = strtod(curr, &after);
+    px = JSON::StrToD(curr, a_end, &after);
     assert(curr != after);
 
     curr = after + 1;
@@ -649,7 +650,7 @@ namespace MAQUETTE
     assert(curr != nullptr);
 
     ++curr;
-    qty = strtod(curr, &after);
+    qty = JSON::StrToD(curr, a_end, &after);
     assert(curr != after);
     curr = after;
 
@@ -730,10 +731,10 @@ namespace MAQUETTE
         return nullptr;
       }
     )
-    char* after = nullptr;
+    char const* after = nullptr;
 
     // Px:
-    px   = strtod(curr + 1, &after);
+    px   = JSON::StrToD(curr + 1, a_end, &after);
     curr = after;
     CHECK_ONLY
     (
@@ -745,7 +746,7 @@ namespace MAQUETTE
       }
     )
     // Qty:
-    qty  = strtod(curr + 1, &after);
+    qty  = JSON::StrToD(curr + 1, a_end, &after);
     curr = after;
     CHECK_ONLY
     (
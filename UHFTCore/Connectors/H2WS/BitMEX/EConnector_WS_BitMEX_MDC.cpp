@@ -9,6 +9,7 @@
 #include "Protocols/H2WS/WSProtoEngine.hpp"
 #include "Venues/BitMEX/Configs_H2WS.h"
 #include "Venues/BitMEX/SecDefs.h"
+#include "Protocols/JSONIndex.hpp"
 #include <cstring>
 #include <sstream>
 #include <utxx/compiler_hints.hpp>
@@ -119,6 +120,7 @@ namespace MAQUETTE
     // This Class:                                                           //
     //-----------------------------------------------------------------------//
     m_mdMsg(),
+    m_jsonIdx(),
     m_isInitialized(false)
   {}
 
@@ -198,7 +200,6 @@ namespace MAQUETTE
            a_msg_body[a_msg_len] == '\0');
 
     char const* curr  = a_msg_body;
-    char*       after = nullptr;
     char const* end   = a_msg_body + a_msg_len;
 
     CHECK_ONLY(this->template LogMsg<false>(a_msg_body, nullptr, 0);)
@@ -257,54 +258,56 @@ namespace MAQUETTE
       }
 
       // Start parsing trades:
-      curr = strstr(a_msg_body, "\"data\":[{");
-      if (utxx::unlikely(curr == nullptr))
-      {
+      m_jsonIdx.Build(a_msg_body, a_msg_len);
+      JSON::Cursor     cur(m_jsonIdx);
+      std::string_view key;
+      cur.EnterObj();
+      if (utxx::unlikely(!cur.FindKey("data") || !cur.EnterArr()))
         return true;
-      }
-      curr += 9;
-      char const* currTrade = curr;
 
       //-------------------------------------------------------------------//
       // Parse Trade Batch:                                                //
       //-------------------------------------------------------------------//
       m_mdMsg.m_nEntrs = 1;
-      while (true)
+      do
       {
         // Use single entry for all trades
         MDEntryST& mde = m_mdMsg.m_entries[0];
+        mde.m_entryType     = FIX::MDEntryTypeT::Trade;
+        FIX::SideT aggrSide = FIX::SideT::Buy;
 
-        // Exchange timestamp:
-        currTrade = strstr(curr, "\"timestamp\":\"") + 13;
-        //"XXXX-XX-XXTXX:XX:XX.XXXZ"
-        m_mdMsg.m_exchTS = DateTimeToTimeValTZ(currTrade);
-
-        // Symbol (not altSymbol):
-        currTrade = strstr(curr, "\"symbol\":\"") + 10;
-        InitFixedStr(&m_mdMsg.m_symbol, currTrade,
-                     size_t(strchr(currTrade, '"') - currTrade));
-
-        // Side:
-        currTrade     = strstr(curr, "\"side\":\"") + 8;
-        bool sellAggr = strncmp(currTrade, "Sell", 4) == 0;
-        mde.m_entryType = FIX::MDEntryTypeT::Trade;
-        FIX::SideT aggrSide = sellAggr ? FIX::SideT::Sell : FIX::SideT::Buy;
-
-        // Quantity:
-        currTrade = strstr(curr, "\"size\":") + 7;
-        long qty  = -1;
-        utxx::fast_atoi<long, false>(currTrade, end, qty);
-        mde.m_qty = QtyN(qty);
-
-        // Price
-        currTrade = strstr(curr, "\"price\":") + 8;
-        mde.m_px  = PriceT(strtod(currTrade, &after));
-        currTrade = after;
-
-        // TrdMatchID
-        currTrade = strstr(curr, "\"trdMatchID\":\"") + 14;
-        mde.m_execID =
-            ExchOrdID(currTrade, int(strchr(currTrade, '"') - currTrade));
+        cur.EnterObj();
+        while (cur.NextKey(&key))
+        {
+          if (key == "timestamp")
+            // Exchange timestamp: "XXXX-XX-XXTXX:XX:XX.XXXZ":
+            m_mdMsg.m_exchTS = DateTimeToTimeValTZ(cur.GetStr().data());
+          else
+          if (key == "symbol")
+          {
+            // Symbol (not altSymbol):
+            std::string_view symbol = cur.GetStr();
+            InitFixedStr(&m_mdMsg.m_symbol, symbol.data(), symbol.size());
+          }
+          else
+          if (key == "side")
+            aggrSide =
+              (cur.GetStr() == "Sell") ? FIX::SideT::Sell : FIX::SideT::Buy;
+          else
+          if (key == "size")
+            mde.m_qty = QtyN(cur.GetInt<long>());
+          else
+          if (key == "price")
+            mde.m_px  = cur.GetPx();
+          else
+          if (key == "trdMatchID")
+          {
+            std::string_view id = cur.GetStr();
+            mde.m_execID = ExchOrdID(id.data(), int(id.size()));
+          }
+          else
+            cur.SkipVal();
+        }
 
         //-------------------------------------------------------------------//
         // Now Process this Trade:                                           //
@@ -326,15 +329,10 @@ namespace MAQUETTE
         // Generic Case:
         EConnector_MktData::ProcessTrade<WithOrdersLog, QT, QR, OMC>
           (m_mdMsg, mde, nullptr, *ob, mde.m_qty, aggrSide, a_ts_recv);
-
-        // Move to next trade or resume waiting for message
-        curr = strstr(curr, "},{");
-        if (utxx::unlikely(curr == nullptr))
-          return true;
-
-        curr += 3;
-        currTrade = curr;
       }
+      // Move to next trade or resume waiting for message
+      while (cur.NextElem());
+      return true;
     }
     else
     if (isOrderBook10)
@@ -354,56 +352,61 @@ namespace MAQUETTE
       }
 
       // Start parsing OB:
-      curr = strstr(a_msg_body, "\"data\":[{");
-      if (utxx::unlikely(curr == nullptr))
+      m_jsonIdx.Build(a_msg_body, a_msg_len);
+      JSON::Cursor     cur(m_jsonIdx);
+      std::string_view key;
+      cur.EnterObj();
+      if (utxx::unlikely(!cur.FindKey("data") || !cur.EnterArr()))
         return true;
 
-      char const* currSnap = strstr(curr, "\"symbol\":\"") + 10;
-      InitFixedStr(&m_mdMsg.m_symbol, currSnap,
-                   size_t(strchr(currSnap, '"') - currSnap));
-
       //---------------------------------------------------------------------//
       // Parse an OrderBook10 SnapShot:                                      //
       //---------------------------------------------------------------------//
-      m_mdMsg.m_nEntrs = 20;  // NB: Bids + Asks!
-
-      // Bids (b==1) and Asks (b==0) Arrays:
-      int off = 0;
-      for (int b = 1; b >= 0; --b)
+      // Bids and Asks: Arrays of length <= 10 of Entries: [Px,Qty]:
+      int off = 0;   // Bids + Asks
+      cur.EnterObj();
+      while (cur.NextKey(&key))
       {
-        // Key: "bids" or "asks":
-        bool isBid(b);
-        if (isBid)
-          currSnap = strstr(curr, "\"bids\":[[") + 9;
+        bool isBid = (key == "bids");
+        if (isBid || key == "asks")
+        {
+          if (!cur.EnterArr())
+            continue;    // Empty side
+          do
+          {
+            cur.EnterArr();
+            double px  = cur.GetDouble();
+            cur.Expect(',');
+            long   qty = cur.GetInt<long>();
+            if (utxx::unlikely(cur.NextElem()))
+              cur.LeaveArr();
+
+            // Save the "px" and "qty":
+            if (utxx::unlikely(off >= MDMsg::MaxMDEs))
+              continue;
+            MDEntryST& mde = m_mdMsg.m_entries[off];  // REF!
+            mde.m_entryType =
+              isBid ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
+            mde.m_px  = PriceT(px);
+            mde.m_qty = QtyN(qty);
+            ++off;
+          }
+          while (cur.NextElem());
+        }
         else
-          currSnap = strstr(curr, "\"asks\":[[") + 9;
-
-        // Bids or Asks: Array of length <= 10 of Entries: [\"Px\",\"Qty\"]:
-        for (int i = 0; i < 10; ++i)
+        if (key == "symbol")
         {
-          double px = strtod(currSnap, &after);
-          currSnap  = strchr(after, ',') + 1;
-
-          long qty = LONG_MIN;
-          currSnap = utxx::fast_atoi<long, false>(currSnap, end, qty);
-          currSnap = strstr(currSnap, "],[");
-          if (currSnap != nullptr)
-            currSnap += 3;
-
-          // Save the "px" and "qty":
-          MDEntryST& mde = m_mdMsg.m_entries[off];  // REF!
-          mde.m_entryType =
-            isBid ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
-          mde.m_px  = PriceT(px);
-          mde.m_qty = QtyN(qty);
-          ++off;
+          std::string_view symbol = cur.GetStr();
+          InitFixedStr(&m_mdMsg.m_symbol, symbol.data(), symbol.size());
         }
+        else
+        if (key == "timestamp")
+          // Exchange timestamp: "XXXX-XX-XXTXX:XX:XX.XXXZ":
+          m_mdMsg.m_exchTS = DateTimeToTimeValTZ(cur.GetStr().data());
+        else
+          cur.SkipVal();
       }
-
-      // Exchange timestamp:
-      curr = strstr(curr, "\"timestamp\":\"") + 13;
-      //"XXXX-XX-XXTXX:XX:XX.XXXZ"
-      m_mdMsg.m_exchTS = DateTimeToTimeValTZ(curr);
+      m_mdMsg.m_nEntrs = off;  // NB: Bids + Asks!
 
       //-------------------------------------------------------------------//
       // SnapShot done, process it in "EConnector_MktData":                //
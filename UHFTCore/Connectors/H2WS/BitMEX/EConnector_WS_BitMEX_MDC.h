@@ -8,6 +8,7 @@
 #include "Connectors/H2WS/EConnector_WS_MDC.h"
 #include "Connectors/H2WS/BitMEX/EConnector_H2WS_BitMEX_OMC.h"
 #include "Protocols/FIX/Msgs.h"
+#include "Protocols/JSONIndex.hpp"
 #include <time.h>
 
 namespace MAQUETTE
@@ -230,6 +231,7 @@ namespace MAQUETTE
     // "EConnector_WS_BitMEX_MDC" Data Flds:                                 //
     //=======================================================================//
     MDMsg m_mdMsg;  // Buffer for the curr SnapShot or Trade
+    JSON::StructIdx m_jsonIdx;  // Of the curr msg
 
     bool m_isInitialized;
     std::map<const SymKey, unsigned long> m_secID;// {{"XBTUSD", 88}};
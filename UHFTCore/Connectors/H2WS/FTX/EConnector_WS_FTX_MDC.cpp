@@ -11,6 +11,7 @@
 #include "Connectors/EConnector_MktData.hpp"
 #include "Venues/FTX/SecDefs.h"
 #include "Venues/FTX/Configs_WS.h"
+#include "Protocols/JSONIndex.hpp"
 #include <utxx/compiler_hints.hpp>
 #include <utxx/error.hpp>
 #include <boost/current_function.hpp>
@@ -419,18 +420,18 @@ namespace MAQUETTE
     CHECK(curr != nullptr && curr < a_end)
     SKP_STR(curr, a_end, a_is_bids ? R"("bids": [)" : R"("asks": [)")
 
-    char* after = nullptr;
+    char const* after = nullptr;
 
     while (curr < a_end && *curr == '[')
     {
       // [px, qty], ...]]
       ++curr;
-      px = strtod(curr, &after);
+      px = JSON::StrToD(curr, a_end, &after);
       CHECK(curr != after)
       curr = after + 2; // skip ", "
       CHECK(curr < a_end && *(curr - 2) == ',' && *(curr - 1) == ' ')
 
-      qty = strtod(curr, &after);
+      qty = JSON::StrToD(curr, a_end, &after);
       CHECK(curr != after)
       curr = after;
 
@@ -468,7 +469,7 @@ namespace MAQUETTE
     assert(a_ob != nullptr);
     CHECK(a_data != nullptr && a_data < a_end && *a_data == '[')
 
-    char*  after = nullptr;
+    char const* after = nullptr;
     size_t offset = 0;
     char const* curr = a_data + 1;
     FIX::SideT aggrSide;
@@ -483,14 +484,14 @@ namespace MAQUETTE
 
       // Price
       CHECK(CMP_STR(curr, R"(, "price": )"))
-      double px = strtod(curr, &after);
+      double px = JSON::StrToD(curr, a_end, &after);
       CHECK(curr != after)
       curr      = after;
       mde.m_px  = PriceT(px);
 
       // Qty
       CHECK(CMP_STR(curr, R"(, "size": )"))
-      double qty = strtod(curr, &after);
+      double qty = JSON::StrToD(curr, a_end, &after);
       curr       = after;
       mde.m_qty  = QtyN(qty);
 
@@ -16,6 +16,7 @@
 #include "Connectors/H2WS/EConnector_WS_MDC.hpp"
 #include "Connectors/H2WS/Huobi/EConnector_WS_Huobi_MDC.h"
 #include "Protocols/JSONParseMacros.h"
+#include "Protocols/JSONIndex.hpp"
 
 namespace MAQUETTE
 {
@@ -203,8 +204,8 @@ namespace MAQUETTE
         SKP_STR("{")
 
       SKP_STR("\"amount\":")
-      char*  after = nullptr;
-      mde.m_qty    = QtyN  (strtod(curr, &after));
+      char const* after = nullptr;
+      mde.m_qty    = QtyN  (JSON::StrToD(curr, end, &after));
       assert(after != nullptr);
       curr         = after;
 
@@ -235,7 +236,7 @@ namespace MAQUETTE
       }
 
       SKP_STR(",\"price\":")
-      mde.m_px     = PriceT(strtod(curr, &after));
+      mde.m_px     = PriceT(JSON::StrToD(curr, end, &after));
       assert(after != nullptr);
       curr         = after;
 
@@ -273,7 +274,7 @@ namespace MAQUETTE
     m_mdMsg.m_nEntrs = 2;
     char const* curr = a_curr;
     char const* end = a_msg_body + a_msg_len;
-    char* after = nullptr;
+    char const* after = nullptr;
 
     SKP_STR(",\"ts\":")
     uint64_t ms;
@@ -303,7 +304,7 @@ namespace MAQUETTE
       MDEntryST& mde = m_mdMsg.m_entries[0];
       mde.m_entryType = IsSpt ? FIX::MDEntryTypeT::Offer
                               : FIX::MDEntryTypeT::Bid;
-      mde.m_px = PriceT(strtod(curr, &after));
+      mde.m_px = PriceT(JSON::StrToD(curr, end, &after));
       assert(after != nullptr);
       curr = after;
 
@@ -312,7 +313,7 @@ namespace MAQUETTE
       else
         SKP_STR(",")
 
-      mde.m_qty = QtyN(strtod(curr, &after));
+      mde.m_qty = QtyN(JSON::StrToD(curr, end, &after));
       assert(after != nullptr);
       curr = after;
     }
@@ -326,7 +327,7 @@ namespace MAQUETTE
       MDEntryST& mde = m_mdMsg.m_entries[1];
       mde.m_entryType = IsSpt ? FIX::MDEntryTypeT::Bid
                               : FIX::MDEntryTypeT::Offer;
-      mde.m_px = PriceT(strtod(curr, &after));
+      mde.m_px = PriceT(JSON::StrToD(curr, end, &after));
       assert(after != nullptr);
       curr = after;
 
@@ -335,7 +336,7 @@ namespace MAQUETTE
       else
         SKP_STR(",")
 
-      mde.m_qty = QtyN(strtod(curr, &after));
+      mde.m_qty = QtyN(JSON::StrToD(curr, end, &after));
       assert(after != nullptr);
       curr = after;
     }
@@ -429,18 +430,18 @@ namespace MAQUETTE
         continue; // empty array
       }
 
-      char* after = nullptr;
+      char const* after = nullptr;
       for (int i = 0; i < m_mdMsg.MaxMDEs; ++i)
       {
         SKP_STR("[")
         double px  = NaN<double>;
-        px = strtod(curr, &after);
+        px = JSON::StrToD(curr, end, &after);
         assert(after != nullptr);
         curr = after;
         SKP_STR(",")
 
         double qty = NaN<double>;
-        qty = strtod(curr, &after);
+        qty = JSON::StrToD(curr, end, &after);
         assert(after != nullptr);
         curr = after;
 
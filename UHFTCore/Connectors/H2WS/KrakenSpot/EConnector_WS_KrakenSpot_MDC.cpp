@@ -99,7 +99,8 @@ namespace MAQUETTE
     // "EConnector_WS_KrakenSpot_MDC" Itself:                                 //
     //-----------------------------------------------------------------------//
     m_useBBA            (a_params.get<bool>("UseBBA", false)),
-    m_mdMsg             ()
+    m_mdMsg             (),
+    m_jsonIdx           ()
   {}
 
   //=========================================================================//
@@ -12,6 +12,7 @@
 #include "Connectors/H2WS/KrakenSpot/EConnector_WS_KrakenSpot_OMC.h"
 #include "Venues/KrakenSpot/Configs_WS.h"
 #include "Protocols/FIX/Msgs.h"
+#include "Protocols/JSONIndex.hpp"
 
 namespace MAQUETTE
 {
@@ -229,6 +230,7 @@ namespace MAQUETTE
     // Config parameter, realtime feed from exchange:
     bool const                        m_useBBA;
     mutable MDMsg                     m_mdMsg; // Buff for curr SnapShot/Trade
+    mutable JSON::StructIdx           m_jsonIdx; // Of the curr msg
 
     // Map: { ChannelID => OrderBook* }:
     mutable std::unordered_map<int, OrderBook*> m_channels;
@@ -16,6 +16,7 @@
 #include "Connectors/EConnector_MktData.hpp"
 #include "Connectors/H2WS/KrakenSpot/EConnector_WS_KrakenSpot_MDC.h"
 #include "Protocols/JSONParseMacros.h"
+#include "Protocols/JSONIndex.hpp"
 
 namespace MAQUETTE
 {
@@ -247,43 +248,38 @@ namespace MAQUETTE
     utxx::time_val  UNUSED_PARAM(a_ts_handl)
   )
   {
-    char const* curr = a_curr;
-
-    assert(*curr == '[');
-    ++curr;
-
+    assert(*a_curr == '[');
     m_mdMsg.m_nEntrs = 0;
     MDEntryST& mde = m_mdMsg.m_entries[0];
     mde.m_entryType = FIX::MDEntryTypeT::Trade;
 
-    while (curr != nullptr) {
-      SKP_STR("[\"")
-      char*  after = nullptr;
-      mde.m_px     = PriceT(strtod(curr, &after));
-      assert(after != nullptr);
-      curr         = after;
-
-      SKP_STR("\",\"")
-      mde.m_qty    = QtyN  (strtod(curr, &after));
-      assert(after != nullptr);
-      curr         = after;
-
-      SKP_STR("\",\"")
-      m_mdMsg.m_exchTS = utxx::secs(strtod(curr, &after));
-      assert(after != nullptr);
-      curr         = after;
-
-      SKP_STR("\",\"")
-      assert((*curr == 'b') || (*curr == 's'));
+    // Index the Trades array (and the rest of the msg which is not used):
+    // Each Trade is ["Px","Qty","Time","Side","OrdType","Misc"]:
+    m_jsonIdx.Build(a_curr, int(a_msg_body + a_msg_len - a_curr));
+    JSON::Cursor cur(m_jsonIdx);
+    if (utxx::unlikely(!cur.EnterArr()))
+      return true;
+    do
+    {
+      cur.EnterArr();
+      mde.m_px         = cur.GetPx();
+      cur.Expect(',');
+      mde.m_qty        = cur.GetQty<QtyN>();
+      cur.Expect(',');
+      m_mdMsg.m_exchTS = utxx::secs(cur.GetDouble());
+      cur.Expect(',');
+      std::string_view side = cur.GetStr();
+      assert(side == "b" || side == "s");
       FIX::SideT aggrSide =
-        (*curr == 's') ? FIX::SideT::Sell : FIX::SideT::Buy;
+        (side[0] == 's') ? FIX::SideT::Sell : FIX::SideT::Buy;
+      if (cur.NextElem())
+        cur.LeaveArr();
 
       EConnector_MktData::ProcessTrade<false, QT, QR, OMC>(
         m_mdMsg, mde, nullptr, *a_ob, mde.m_qty, aggrSide, a_ts_recv);
-
-      // move on to next trade (if any)
-      curr = strchr(curr, '[');
     }
+    // Move on to the next Trade (if any):
+    while (cur.NextElem());
 
     return true;
   }
@@ -384,110 +380,85 @@ namespace MAQUETTE
     utxx::time_val  a_ts_handl
   )
   {
-    m_mdMsg.m_nEntrs = m_mdMsg.MaxMDEs;   // NB: Bids + Asks!
     m_mdMsg.m_exchTS = utxx::secs(0);
 
-    char const* curr = a_curr;
-    char const* end  = a_msg_body + a_msg_len;
-
-    SKP_STR("{\"")
-
-    // If this is a snapshot, we have asks and bids, otherwise we may have
-    // both asks and bids, only asks, or only bids
-    // 0: ask, 1: bid
-    char start = IsSnapShot ? 0 : ((*curr == 'a') ? 0 : 1);
-
-    // skip [a|b]s for snapshot or [a|b] for update
-    if constexpr (IsSnapShot)
-      curr += 2;
-    else
-      curr += 1;
-
-    SKP_STR("\":[[\"")
-
-    // Bids (b==1) and Asks (b==0) Arrays:
-    int off = 0;
-    for (char b = start; b < 2; ++b)
+    // A SnapShot is {"as":[...],"bs":[...]}; an Update has Asks ("a"), Bids
+    // ("b") or both, and the CheckSum ("c"), where Asks and Bids may come in
+    // 2 separate objs. Each Level is ["Px","Qty","Time"], with an optional
+    // "r" (re-published) flag for Updates. Index the msg from the 1st obj:
+    //
+    m_jsonIdx.Build(a_curr, int(a_msg_body + a_msg_len - a_curr));
+    JSON::Cursor     cur(m_jsonIdx);
+    std::string_view key;
+    int              off      = 0;   // Bids + Asks
+    int              nSkipped = 0;
+    do
     {
-      for (int i = 0; i < m_mdMsg.MaxMDEs; ++i)
+      cur.EnterObj();
+      while (cur.NextKey(&key))
       {
-        double px  = NaN<double>;
-        curr = utxx::atof(curr, end, px);
-        SKP_STR("\",\"")
-
-        double qty = NaN<double>;
-        curr = utxx::atof(curr, end, qty);
-        SKP_STR("\",\"")
-
-        double timestamp = 0.0;
-        curr = utxx::atof(curr, end, timestamp);
-        utxx::time_val this_time = utxx::secs(timestamp);
-        m_mdMsg.m_exchTS = std::max(m_mdMsg.m_exchTS, this_time);
-
-        // skip potential republished update flag
-        curr = strchr(curr, ']');
-        assert(curr != nullptr);
-
-        // Check what we got:
-        CHECK_ONLY
-        (
-          if (utxx::unlikely
-             (!(px > 0.0 && (qty > 0 || (!IsSnapShot && qty >= 0)))))
-          {
-           LOG_WARN(2,
-              "EConnector_WS_KrakenSpot_MDC::ProcessSnapShot: {}: Invalid Px={}"
-              " or Qty={}: {} skipped", a_curr, px, qty,
-              IsSnapShot ? "Snapshot" : "Update")
-            // Skip the entire msg (as the SnapShot is invalid), but still
-            // continue reading:
-            return true;
-          }
-        )
-        // Save the "px" and "qty":
-        MDEntryST&  mde = m_mdMsg.m_entries[off]; // REF!
-        mde.m_entryType =
-          (b == 1) ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
-        mde.m_px        = PriceT(px);
-        mde.m_qty       = QtyN  (qty);
-        ++off;
-
-        // Next: It could be either next Entry, or Side Done:
-        if (utxx::unlikely(strncmp(curr, "]]", 2) == 0))
+        bool isBid = (key == "bs" || key == "b");
+        if (!isBid && key != "as" && key != "a")
         {
-          curr += 2;
-          break;  // Yes, Side Done
+          cur.SkipVal();   // "c": could read the CheckSum if we want
+          continue;
         }
-        // If not done yet:
-        SKP_STR("],[\"")
-      }
-
-      if constexpr (IsSnapShot) {
-        if (b == 0)
-          SKP_STR(",\"bs\":[[\"")
-      } else {
-        bool done = (b == 1);
-        if (!done) {
-          // processing update and we just finish processing asks,
-          // check if there are any bids
-          if (utxx::unlikely(strncmp(curr, "},{\"b\":[[\"", 9) == 0))
-            // there are also bids
-            curr += 10;
-          else
-            // we're done
-            done = true;
-        }
-
-        if (done) {
-          SKP_STR(",\"c\":\"")
-          // could now read checksum if we want
-          curr = strchr(curr, '}');
-          break;
+        if (!cur.EnterArr())
+          continue;        // Empty side
+        do
+        {
+          cur.EnterArr();
+          double px  = cur.GetDouble();
+          cur.Expect(',');
+          double qty = cur.GetDouble();
+          cur.Expect(',');
+          utxx::time_val thisTime = utxx::secs(cur.GetDouble());
+          m_mdMsg.m_exchTS = std::max(m_mdMsg.m_exchTS, thisTime);
+          // Skip the potential "republished update" flag:
+          if (cur.NextElem())
+            cur.LeaveArr();
+
+          // Check what we got:
+          CHECK_ONLY
+          (
+            if (utxx::unlikely
+               (!(px > 0.0 && (qty > 0 || (!IsSnapShot && qty >= 0)))))
+            {
+             LOG_WARN(2,
+                "EConnector_WS_KrakenSpot_MDC::ProcessSnapShot: {}: Invalid "
+                "Px={} or Qty={}: {} skipped", a_curr, px, qty,
+                IsSnapShot ? "Snapshot" : "Update")
+              // Skip the entire msg (as the SnapShot is invalid), but still
+              // continue reading:
+              return true;
+            }
+          )
+          if (utxx::unlikely(off >= MDMsg::MaxMDEs))
+          {
+            ++nSkipped;
+            continue;
+          }
+          // Save the "px" and "qty":
+          MDEntryST&  mde = m_mdMsg.m_entries[off]; // REF!
+          mde.m_entryType =
+            isBid ? FIX::MDEntryTypeT::Bid : FIX::MDEntryTypeT::Offer;
+          mde.m_px        = PriceT(px);
+          mde.m_qty       = QtyN  (qty);
+          ++off;
         }
+        while (cur.NextElem());
       }
     }
+    // Is there another Book obj (rather than the ChannelName)?
+    while (cur.TryConsume(',') && cur.Peek() == '{');
+
+    if (utxx::unlikely(nSkipped > 0))
+      LOG_WARN(2,
+        "EConnector_WS_KrakenSpot_MDC::ProcessBook: {}: {} Levels beyond "
+        "MaxMDEs={} skipped", ToCStr(m_mdMsg.m_symbol), nSkipped,
+        MDMsg::MaxMDEs)
     // At the end:
     m_mdMsg.m_nEntrs = off;
-    SKP_STR("},\"book")
 
     //-------------------------------------------------------------------//
     // Snapshot/Update done, process it in "EConnector_MktData":         //
@@ -0,0 +1,154 @@
+// vim:ts=2:et
+//===========================================================================//
+//                       "Connectors/LatencyTrace.hpp":                      //
+//        Per-Stage Latency HistoGrams: From MktData Receipt to Order Ack    //
+//===========================================================================//
+// A "LatencyTrace" obj is placed by "EConnector" into its ShM segment (under
+// the name "EConnector::LatencyTraceON()"), so that "Tools/StatsMDC" can read
+// it live; the MDC and the OMC parts of a Connector share the same obj:
+// (*) MDC Stages are traced per OrderBook update delivered to the Strategies
+//     (from the TimeStamps of "OBUpdateInfo");
+// (*) OMC Stages are traced per Req12, when it is first Confirmed (from the
+//     TimeStamps of the Req12 itself), so there is nothing extra to do on the
+//     order sending path;
+// (*) other code (eg Strategies) may trace their own intervals into any of the
+//     Stages via "Trace":
+//
+#pragma  once
+
+#include "Basis/OrdMgmtTypes.hpp"
+#include "QuantSupport/HDRHistoGram.hpp"
+#include <utxx/time_val.hpp>
+#include <utxx/compiler_hints.hpp>
+#include <ostream>
+#include <iomanip>
+#include <string>
+
+namespace MAQUETTE
+{
+  //=========================================================================//
+  // "LatencyTrace" Struct:                                                  //
+  //=========================================================================//
+  struct LatencyTrace
+  {
+    //-----------------------------------------------------------------------//
+    // Stages:                                                               //
+    //-----------------------------------------------------------------------//
+    enum class StageT: int
+    {
+      // MDC:
+      HWRecvToSocket  = 0,  // HWRecv   -> Socket   (Kernel and NIC)
+      SocketToProc    = 1,  // Socket   -> ProcBuff (Session Layer)
+      ProcToOBUpdate  = 2,  // ProcBuff -> OBUpdate (Protocol Layer)
+      OBUpdateToStrat = 3,  // OBUpdate -> Strategy Call-Back
+      HWRecvToStrat   = 4,  // HWRecv   -> Strategy Call-Back
+      // OMC:
+      StratToReq      = 5,  // Strategy Call-Back -> Req12 Created (Decision)
+      ReqToWire       = 6,  // Req12 Created      -> Sent          (OMC)
+      TickToWire      = 7,  // MktData Received   -> Sent          (Overall)
+      WireToAck       = 8,  // Sent               -> Confirm Recvd (Exchange)
+      N               = 9
+    };
+    constexpr static int NStages = int(StageT::N);
+
+    //-----------------------------------------------------------------------//
+    // Consts and Data Flds:                                                 //
+    //-----------------------------------------------------------------------//
+    // HistoGrams of latencies in nsec (from 1 nsec to ~1 sec, with ~1.6% pre-
+    // cision):
+    using Hist = QuantSupport::HDRHistoGram<>;
+
+    // Vals outside (0 .. MaxNS) are certainly invalid (eg caused by missing
+    // TimeStamps), and would only distort the stats, so they are ignored:
+    constexpr static long MaxNS = 1'000'000'000;
+
+    Hist m_hists[NStages];
+
+    //-----------------------------------------------------------------------//
+    // Default Ctor:                                                         //
+    //-----------------------------------------------------------------------//
+    LatencyTrace()
+    : m_hists
+      {
+        Hist("HWRecv-to-Socket"),
+        Hist("Socket-to-ProcBuff"),
+        Hist("ProcBuff-to-OBUpdate"),
+        Hist("OBUpdate-to-Strategy"),
+        Hist("HWRecv-to-Strategy"),
+        Hist("Strategy-to-Req12"),
+        Hist("Req12-to-Wire"),
+        Hist("Tick-to-Wire"),
+        Hist("Wire-to-Ack")
+      }
+    {}
+
+    //-----------------------------------------------------------------------//
+    // Accessor:                                                             //
+    //-----------------------------------------------------------------------//
+    Hist const& Get(StageT a_stage) const
+    {
+      assert(0 <= int(a_stage) && int(a_stage) < NStages);
+      return m_hists[int(a_stage)];
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Trace":                                                              //
+    //-----------------------------------------------------------------------//
+    // (1) Latency given directly (in nsec):
+    //
+    void Trace(StageT a_stage, long a_nsec) const
+    {
+      if (utxx::likely(0 < a_nsec && a_nsec < MaxNS))
+        Get(a_stage).Update(a_nsec);
+    }
+
+    // (2) The interval between 2 TimeStamps (skipped if either is empty):
+    //
+    void Trace
+    (
+      StageT          a_stage,
+      utxx::time_val  a_from,
+      utxx::time_val  a_to
+    )
+    const
+    {
+      if (utxx::likely(!(a_from.empty() || a_to.empty())))
+        Trace(a_stage, (a_to - a_from).nanoseconds());
+    }
+
+    //-----------------------------------------------------------------------//
+    // "TraceReq12": All OMC Stages of a Confirmed Req12:                    //
+    //-----------------------------------------------------------------------//
+    void TraceReq12(Req12 const& a_req) const
+    {
+      Trace(StageT::StratToReq, a_req.m_ts_md_strat, a_req.m_ts_created);
+      Trace(StageT::ReqToWire,  a_req.m_ts_created,  a_req.m_ts_sent);
+      Trace(StageT::TickToWire, a_req.m_ts_md_conn,  a_req.m_ts_sent);
+      Trace(StageT::WireToAck,  a_req.m_ts_sent,     a_req.m_ts_conf_conn);
+    }
+
+    //-----------------------------------------------------------------------//
+    // Output:                                                               //
+    //-----------------------------------------------------------------------//
+    // A table of all non-empty Stages (in nsec):
+    //
+    friend inline std::ostream& operator<<
+    (
+      std::ostream&       a_os,
+      LatencyTrace const& a_lt
+    )
+    {
+      a_os << std::left  << std::setw(24) << "Latency, nsec"
+           << std::right << std::setw(11) << "Count"
+           << std::setw(9)  << "Min"   << std::setw(9) << "Avg"
+           << std::setw(9)  << "50%"   << std::setw(9) << "90%"
+           << std::setw(9)  << "99%"   << std::setw(9) << "99.9%"
+           << std::setw(11) << "Max"   << '\n' << std::string(100, '-')
+           << '\n';
+      for (Hist const& hist: a_lt.m_hists)
+        if (hist.GetSummary().m_count > 0)
+          a_os << hist << '\n';
+      return a_os;
+    }
+  };
+} // End namespace MAQUETTE
@@ -0,0 +1,124 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Connectors/OBSnapShot.hpp":                      //
+//    Top-N OrderBook SnapShots Published (via a SeqLock) to Other Threads   //
+//===========================================================================//
+// An "OrderBook" is only to be used on the Reactor thread of its MDC. If Snap-
+// Shots are enabled for the OrderBook, the MDC publishes its top levels into
+// an "OBSnapShotPub" after each batch of updates is complete; other threads
+// (RiskMgr, monitoring, analytics) can then get consistent copies of them:
+// (*) single writer (the Reactor thread), any number of readers;
+// (*) the writer never waits for readers; readers never lock, and retry (ve-
+//     ry rarely) if their copy was overwritten while being made;
+// (*) there are no memory allocations on either side after construction:
+//
+#pragma  once
+
+#include "Basis/BaseTypes.hpp"
+#include "Basis/PxsQtys.h"
+#include <utxx/compiler_hints.hpp>
+#include <utxx/time_val.hpp>
+#include <utxx/error.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <atomic>
+#include <cstring>
+#include <cassert>
+
+namespace MAQUETTE
+{
+  //=========================================================================//
+  // "OBSnapShot": The data copied out to readers:                           //
+  //=========================================================================//
+  struct OBSnapShot
+  {
+    constexpr static int MaxDepth = 20;
+
+    long            m_version;    // Number of publications (>= 1 if any)
+    SeqNum          m_rptSeq;     // Last RptSeq applied to the OrderBook
+    SeqNum          m_seqNum;     // Last SeqNum ...
+    utxx::time_val  m_exchTS;     // Of the last update
+    utxx::time_val  m_recvTS;     // ditto
+    bool            m_isValid;    // OrderBook initialised, and no errors
+    int             m_nBids;      // Actual number of levels (<= MaxDepth)
+    int             m_nAsks;      // ditto
+    PriceT          m_bidPxs [MaxDepth];  // From L1 into the depth
+    double          m_bidQtys[MaxDepth];  // Aggregated, in the OrderBook's QT
+    PriceT          m_askPxs [MaxDepth];
+    double          m_askQtys[MaxDepth];
+  };
+
+  //=========================================================================//
+  // "OBSnapShotPub": SeqLock-protected "OBSnapShot":                        //
+  //=========================================================================//
+  class alignas(64) OBSnapShotPub: public boost::noncopyable
+  {
+  private:
+    // "m_seq" is odd while the writer is updating "m_data"; it is kept in a
+    // separate cache line from the data, as readers poll it:
+    std::atomic<unsigned long>  m_seq;
+    int const                   m_depth;    // Levels published (per side)
+    alignas(64) OBSnapShot      m_data;
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Non-Default Ctor:                                                     //
+    //-----------------------------------------------------------------------//
+    OBSnapShotPub(int a_depth)
+    : m_seq  (0),
+      m_depth(a_depth),
+      m_data ()
+    {
+      if (utxx::unlikely(a_depth <= 0 || a_depth > OBSnapShot::MaxDepth))
+        throw utxx::badarg_error
+              ("OBSnapShotPub::Ctor: Invalid Depth=", a_depth);
+    }
+
+    int GetDepth() const { return m_depth; }
+
+    //-----------------------------------------------------------------------//
+    // "Write": Writer (single thread only):                                 //
+    //-----------------------------------------------------------------------//
+    // "a_fill(OBSnapShot*)" fills in the data in-place (all flds except the
+    // version):
+    //
+    template<typename Fill>
+    void Write(Fill const& a_fill)
+    {
+      unsigned long seq = m_seq.load(std::memory_order_relaxed);
+      assert((seq & 1) == 0);
+      m_seq.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      a_fill(&m_data);
+      m_data.m_version = long(seq / 2 + 1);
+
+      m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Read": Reader (any thread):                                          //
+    //-----------------------------------------------------------------------//
+    // Returns "false" if nothing has been published yet:
+    //
+    bool Read(OBSnapShot* a_res) const
+    {
+      assert(a_res != nullptr);
+      while (true)
+      {
+        unsigned long seq0 = m_seq.load(std::memory_order_acquire);
+        if (utxx::unlikely(seq0 == 0))
+          return false;
+        if (utxx::unlikely(seq0 & 1))
+        {
+          __builtin_ia32_pause();
+          continue;
+        }
+        memcpy(static_cast<void*>(a_res), &m_data, sizeof(OBSnapShot));
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (utxx::likely(m_seq.load(std::memory_order_relaxed) == seq0))
+          return true;
+      }
+    }
+  };
+} // End namespace MAQUETTE
@@ -8,6 +8,24 @@ using namespace std;
 
 namespace MAQUETTE
 {
+  namespace
+  {
+    //-----------------------------------------------------------------------//
+    // "HybridWinSize":                                                      //
+    //-----------------------------------------------------------------------//
+    // The number of Px Levels in each window of a Hybrid OrderBook: a power
+    // of 2, large enough for the re-centering margins to be non-trivial:
+    //
+    inline int HybridWinSize(int a_total_levels)
+    {
+      int res = 16;
+      while (res < a_total_levels)
+        res <<= 1;
+      assert(IsPow2(res));
+      return res;
+    }
+  }
+
   //=========================================================================//
   // "OrderBookBase::SetBestBidPx":                                          //
   //=========================================================================//
@@ -75,6 +93,7 @@ namespace MAQUETTE
     // Props:
     m_isFullAmt        (false),
     m_isSparse         (false),
+    m_isHybrid         (false),
     m_qt               (QtyTypeT::UNDEFINED),
     m_withFracQtys     (false),
     m_withSeqNums      (false),
@@ -91,18 +110,30 @@ namespace MAQUETTE
     m_HAI              (-1),
     m_AD               (0), // Or (-1)?
     m_asks             (nullptr),
+    m_bidQtys          (nullptr),
+    m_askQtys          (nullptr),
     // Sparse Bids and Asks (as Maps):
     m_bidsMap          (),
     m_asksMap          (),
+    // Hybrid Rep:
+    m_BBT              (0),
+    m_BAT              (0),
+    m_bidsLoT          (0),
+    m_asksLoT          (0),
+    m_bidsWinN         (0),
+    m_asksWinN         (0),
     // Orders
     m_nOrders           (0),
     m_orders            (nullptr),
+    m_ordersHash        (nullptr),
     // Temporal:
     m_initModeOver     (false),
     m_isInitialised    (false),
     m_lastUpdateRptSeq (-1),
     m_lastUpdateSeqNum (-1),
     m_lastUpdatedBid   (false),
+    // SnapShots:
+    m_snapShotPub      (nullptr),
     // Subscrs and Logging:
     m_subscrs          (),
     m_logger           (nullptr),
@@ -125,20 +156,24 @@ namespace MAQUETTE
     bool                       a_cont_rpt_seqs,
     int                        a_total_levels,
     int                        a_max_depth,
-    long                       a_max_orders
+    long                       a_max_orders,
+    bool                       a_hashed_orders
   )
   : // Base:
     OrderBookBase      (a_mdc, a_instr),
     // Props:
     m_isFullAmt        (a_is_full_amt),
     m_isSparse         (a_is_sparse),
+    m_isHybrid         (a_is_sparse && a_total_levels > 0),
     m_qt               (a_qt),
     m_withFracQtys     (a_with_frac_qtys),
     m_withSeqNums      (a_with_seq_nums),
     m_withRptSeqs      (a_with_rpt_seqs),
     m_contRptSeqs      (a_cont_rpt_seqs),
-    // Dense Bids and Asks (as Arrays):
-    m_NL               (m_isSparse ? 0 : a_total_levels),
+    // Dense Bids and Asks (as Arrays; or Hybrid windows):
+    m_NL               (m_isHybrid
+                        ? HybridWinSize(a_total_levels)
+                        : m_isSparse ? 0 : a_total_levels),
     m_ND               (m_isSparse ? 0 : a_max_depth),
     m_LBI              (-1),
     m_BBI              (-1),              // Not yet known: no Mkt Data
@@ -148,12 +183,25 @@ namespace MAQUETTE
     m_HAI              (-1),
     m_AD               (0),               // Curr Asks Depth is 0
     m_asks             ((m_NL > 0) ? new OBEntry[size_t(m_NL)]  : nullptr),
+    // SoA AggrQtys (Dense Rep only), zeroed-out:
+    m_bidQtys          ((m_NL > 0 && !m_isSparse)
+                        ? new double [size_t(m_NL)]() : nullptr),
+    m_askQtys          ((m_NL > 0 && !m_isSparse)
+                        ? new double [size_t(m_NL)]() : nullptr),
     // Sparse Bids and Asks (as Maps):
     m_bidsMap          (),
     m_asksMap          (),
+    // Hybrid Rep: Windows are placed on the first Update of each side:
+    m_BBT              (0),
+    m_BAT              (0),
+    m_bidsLoT          (0),
+    m_asksLoT          (0),
+    m_bidsWinN         (0),
+    m_asksWinN         (0),
     // Orders
     m_nOrders           (0),              // for now
     m_orders            (nullptr),        // for now
+    m_ordersHash        (nullptr),        // ditto
     // Temporal:
     m_initModeOver     (false),
     m_isInitialised    (false),
@@ -162,6 +210,8 @@ namespace MAQUETTE
     m_lastUpdateRptSeq (-1),
     m_lastUpdateSeqNum (-1),
     m_lastUpdatedBid   (false),           // Not yet known, hence "false"
+    // SnapShots (not enabled yet):
+    m_snapShotPub      (nullptr),
     // Subscrs and Logging:
     m_subscrs          (),
     m_logger           ((m_mdc != nullptr) ? m_mdc->GetLogger()     : nullptr),
@@ -179,10 +229,14 @@ namespace MAQUETTE
     memset(m_bids, '\0', size_t(m_NL) * sizeof(OBEntry));
     memset(m_asks, '\0', size_t(m_NL) * sizeof(OBEntry));
 
-    // Now possibly construct the Orders array:
+    // Now possibly construct the Orders array or hash table:
     if (a_max_orders > 0)
     {
-      m_orders = new OrderInfo[size_t(a_max_orders)];
+      if (a_hashed_orders)
+        m_ordersHash =
+          new OrdersHash<OrderInfo>(a_max_orders, OrdersRetireLag);
+      else
+        m_orders     = new OrderInfo[size_t(a_max_orders)];
       m_nOrders = a_max_orders;
     }
     // For all allocated "OBEntry"s, install back-ptrs to this OrderBook:
@@ -204,9 +258,21 @@ namespace MAQUETTE
     if (utxx::likely(m_asks != nullptr))
       delete[] m_asks;
 
+    if (m_bidQtys != nullptr)
+      delete[] m_bidQtys;
+
+    if (m_askQtys != nullptr)
+      delete[] m_askQtys;
+
     if (m_orders != nullptr)
       delete[] m_orders;
 
+    if (m_ordersHash != nullptr)
+      delete m_ordersHash;
+
+    if (m_snapShotPub != nullptr)
+      delete m_snapShotPub;
+
     // Zero-out the contents, but some flds still get non-0 invalid values:
     memset(this, '\0', sizeof(OrderBook));
 
@@ -234,6 +300,12 @@ namespace MAQUETTE
       for (long i = 0; i < m_nOrders; ++i)
         m_orders[i] = OrderInfo();
     }
+    else
+    if (m_ordersHash != nullptr)
+    {
+      assert(m_nOrders > 0);
+      m_ordersHash->Clear();
+    }
     else
       assert(m_nOrders == 0);
   }
@@ -352,12 +424,27 @@ namespace MAQUETTE
   OrderBook::OrderInfo const* OrderBook::GetOrderInfo(OrderID a_order_id) const
   {
     // Check if we have OrdersLog at all. Also, OrderID=0 should not be used:
-    assert((m_orders != nullptr) == (m_nOrders > 0));
+    assert((m_orders != nullptr || m_ordersHash != nullptr) == (m_nOrders > 0));
     CHECK_ONLY
     (
       if (utxx::unlikely(m_nOrders <= 0 || a_order_id == 0))
         return nullptr;
     )
+    // Hash Table: The slot is created if it did not exist (NULL is returned
+    // if the pool is exhausted):
+    if (m_ordersHash != nullptr)
+    {
+      OrderBook::OrderInfo* res = m_ordersHash->FindOrInsert(a_order_id);
+      if (utxx::likely(res != nullptr && res->IsEmpty()))
+      {
+        // A new slot (or one reset by "ResetOrders"): Install the OrderID and
+        // the OuterPtr:
+        res->m_id = a_order_id;
+        res->m_ob = this;
+      }
+      assert(res == nullptr || (res->m_id == a_order_id && res->m_ob == this));
+      return res;
+    }
     // Generic case: Get the offset modulo the size:
     long   off = long(a_order_id) % m_nOrders;
     assert(0  <= off && off < m_nOrders && m_orders != nullptr);
@@ -411,6 +498,159 @@ namespace MAQUETTE
     return nullptr;
   }
 
+  //=========================================================================//
+  // "FindOrderInfo" (by OrderID):                                           //
+  //=========================================================================//
+  // Same search as in "GetOrderInfo", but an empty slot (or a miss in the
+  // Hash Table) means that the Order does not exist, so NULL is returned:
+  //
+  OrderBook::OrderInfo const* OrderBook::FindOrderInfo(OrderID a_order_id)
+  const
+  {
+    assert((m_orders != nullptr || m_ordersHash != nullptr) == (m_nOrders > 0));
+    if (utxx::unlikely(m_nOrders <= 0 || a_order_id == 0))
+      return nullptr;
+
+    if (m_ordersHash != nullptr)
+    {
+      OrderBook::OrderInfo const* res = m_ordersHash->Find(a_order_id);
+      // The slot may still be empty (eg after "ResetOrders"):
+      return (res != nullptr && !res->IsEmpty()) ? res : nullptr;
+    }
+    long off = long(a_order_id) % m_nOrders;
+    assert(0  <= off && off < m_nOrders && m_orders != nullptr);
+
+    for (long j = 0; j < m_nOrders; ++j)
+    {
+      long i = off + j;
+      if (i >= m_nOrders)
+        i -= m_nOrders;
+      OrderBook::OrderInfo const* res = m_orders + i;
+      if (utxx::likely(res->m_id == a_order_id && res->m_ob == this))
+        return res;
+      if (utxx::likely(res->IsEmpty()))
+        return nullptr;
+    }
+    return nullptr;
+  }
+
+  //=========================================================================//
+  // "RetireOrderInfo":                                                      //
+  //=========================================================================//
+  void OrderBook::RetireOrderInfo(OrderInfo const* a_order)
+  {
+    if (m_ordersHash == nullptr)
+      return;
+    assert(a_order != nullptr && a_order->m_ob == this);
+
+    // The slot is released only if the Order is still deleted (ie its OrderID
+    // has not been re-used) when it comes out of the retirement queue:
+    m_ordersHash->Retire
+      (a_order->m_id,
+       [](OrderInfo const* a_oi) -> bool { return !IsPos(a_oi->m_qty); });
+  }
+
+  //=========================================================================//
+  // "EnableSnapShots":                                                      //
+  //=========================================================================//
+  void OrderBook::EnableSnapShots(int a_depth)
+  {
+    if (utxx::unlikely(m_snapShotPub != nullptr))
+      throw utxx::logic_error
+            ("OrderBook::EnableSnapShots: ", m_instr->m_FullName.data(),
+             ": Already enabled");
+
+    // NB: The Depth is checked by the "OBSnapShotPub" Ctor:
+    m_snapShotPub = new OBSnapShotPub(a_depth);
+  }
+
+  //=========================================================================//
+  // "SnapShotSide":                                                         //
+  //=========================================================================//
+  template<bool IsBid>
+  int OrderBook::SnapShotSide
+    (PriceT* a_pxs, double* a_qtys, int a_depth) const
+  {
+    assert(a_pxs != nullptr && a_qtys != nullptr && a_depth > 0);
+    int n = 0;
+
+    if (!m_isSparse)
+    {
+      // Dense Rep: Qtys are taken directly from the SoA ones (which are in
+      // the same units); near the top of the Book most slots are non-empty,
+      // so a plain scan is cheaper than per-level "SIMD::FindPos" calls:
+      int best = IsBid ? m_BBI : m_BAI;
+      if (best < 0)
+        return 0;
+
+      double        pxStep = m_instr->m_PxStep;
+      double const* qtys   = IsBid ? m_bidQtys : m_askQtys;
+      int           wrst   = IsBid ? m_LBI     : m_HAI;
+      PriceT        bestPx = IsBid ? m_BBPx    : m_BAPx;
+
+      for (int s = best;  IsBid ? (s >= wrst) : (s <= wrst);  IsBid ? --s : ++s)
+      {
+        double q = qtys[s];
+        if (q > 0.0)
+        {
+          a_pxs [n] = bestPx + double(s - best) * pxStep;
+          a_qtys[n] = q;
+          if (++n == a_depth)
+            break;
+        }
+      }
+      return n;
+    }
+    // Sparse and Hybrid Reps: Generic traversal:
+    Traverse<IsBid>
+    (
+      a_depth,
+      [this, a_pxs, a_qtys, &n](int a_lvl, PriceT a_px, OBEntry const& a_obe)
+      -> bool
+      {
+        QtyU q         = a_obe.m_aggrQty;
+        a_pxs [a_lvl]  = a_px;
+        a_qtys[a_lvl]  = m_withFracQtys ? double(q.GetUD()) : double(q.GetUL());
+        n              = a_lvl + 1;
+        return true;
+      }
+    );
+    return n;
+  }
+
+  //=========================================================================//
+  // "PublishSnapShot":                                                      //
+  //=========================================================================//
+  void OrderBook::PublishSnapShot
+  (
+    bool            a_is_valid,
+    utxx::time_val  a_exch_ts,
+    utxx::time_val  a_recv_ts
+  )
+  const
+  {
+    if (m_snapShotPub == nullptr)
+      return;
+    int depth = m_snapShotPub->GetDepth();
+
+    // The top levels are written directly into the published SnapShot:
+    m_snapShotPub->Write
+    (
+      [this, a_is_valid, a_exch_ts, a_recv_ts, depth](OBSnapShot* a_ss)->void
+      {
+        a_ss->m_rptSeq  = m_lastUpdateRptSeq;
+        a_ss->m_seqNum  = m_lastUpdateSeqNum;
+        a_ss->m_exchTS  = a_exch_ts;
+        a_ss->m_recvTS  = a_recv_ts;
+        a_ss->m_isValid = a_is_valid && m_isInitialised;
+        a_ss->m_nBids   =
+          SnapShotSide<true> (a_ss->m_bidPxs, a_ss->m_bidQtys, depth);
+        a_ss->m_nAsks   =
+          SnapShotSide<false>(a_ss->m_askPxs, a_ss->m_askQtys, depth);
+      }
+    );
+  }
+
   //=========================================================================//
   // "ResetOrders":                                                          //
   //=========================================================================//
@@ -454,8 +694,9 @@ namespace MAQUETTE
       CheckSeqNums<InitMode>(a_rpt_seq, a_seq_num, "Clear");
 
     // Was the Bool already empty?
+    // (In the Hybrid Rep, a non-empty side always has its L1 in the window):
     bool wasEmpty  =
-      m_isSparse
+      (m_isSparse && !m_isHybrid)
       ? (m_bidsMap.empty() && m_asksMap.empty())
       : (m_BBI == -1       && m_BAI == -1);
 
@@ -470,6 +711,39 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     m_lastUpdatedBid  = false;      // Absolutely does not matter...
 
+    if (m_isHybrid)
+    {
+      // Hybrid Rep: Reset the non-empty window slots, starting from L1 and
+      // going until all of them are found (so, again, NOT all "m_NL" slots
+      // are traversed), then clear the Maps:
+      for (long t = m_BBT; m_bidsWinN > 0; --t)
+      {
+        assert(m_BBI >= 0 && t >= m_bidsLoT);
+        OBEntry& obe = m_bids[HybridSlot(t)];
+        if (IsPos(obe.m_aggrQty))
+        {
+          obe      = OBEntry();
+          obe.m_ob = this;
+          --m_bidsWinN;
+        }
+      }
+      for (long t = m_BAT; m_asksWinN > 0; ++t)
+      {
+        assert(m_BAI >= 0 && t < m_asksLoT + m_NL);
+        OBEntry& obe = m_asks[HybridSlot(t)];
+        if (IsPos(obe.m_aggrQty))
+        {
+          obe      = OBEntry();
+          obe.m_ob = this;
+          --m_asksWinN;
+        }
+      }
+      m_bidsMap.clear();
+      m_asksMap.clear();
+      m_BBI  = -1;
+      m_BAI  = -1;
+    }
+    else
     if (m_isSparse)
     {
       // Sparse Rep: Just clear the Maps:
@@ -484,13 +758,18 @@ namespace MAQUETTE
 
       // EFFICIENTLY zero-out all Qtys: Only if the corresp side is non-empty,
       // and within the known range. NB: Do NOT zero-out all "m_NL" entries --
-      // this could be very expensive if "m_NL" is large:
+      // this could be very expensive if "m_NL" is large. The back-ptrs to
+      // this OrderBook are then re-installed:
       //
       if (utxx::likely(m_BBI != -1))
       {
         assert(0 <= m_LBI  && m_LBI <= m_BBI && m_BBI < m_NL);
         memset(m_bids + m_LBI, '\0',
                size_t(m_BBI  - m_LBI + 1) * sizeof(OBEntry));
+        memset(m_bidQtys + m_LBI, '\0',
+               size_t(m_BBI  - m_LBI + 1) * sizeof(double));
+        for (int i = m_LBI; i <= m_BBI; ++i)
+          m_bids[i].m_ob = this;
       }
       else
         assert(!IsFinite(m_BBPx) && m_LBI == -1);
@@ -500,6 +779,10 @@ namespace MAQUETTE
         assert(0 <= m_BAI  && m_BAI <= m_HAI && m_HAI < m_NL);
         memset(m_asks + m_BAI, '\0',
                size_t(m_HAI  - m_BAI + 1) * sizeof(OBEntry));
+        memset(m_askQtys + m_BAI, '\0',
+               size_t(m_HAI  - m_BAI + 1) * sizeof(double));
+        for (int i = m_BAI; i <= m_HAI; ++i)
+          m_asks[i].m_ob = this;
       }
       else
         assert(!IsFinite(m_BAPx) && m_HAI == -1);
@@ -535,13 +818,16 @@ namespace MAQUETTE
   //=========================================================================//
   // Top-of-the-Book Accessors:                                              //
   //=========================================================================//
+  // NB: In the Hybrid Rep, L1 is always in the window, so the Dense accessors
+  // are used:
+  //
   //-------------------------------------------------------------------------//
   // "GetBestBidNOrders":                                                    //
   //-------------------------------------------------------------------------//
   int  OrderBook::GetBestBidNOrders() const
   {
     return
-      m_isSparse
+      (m_isSparse && !m_isHybrid)
       ? (utxx::unlikely(m_bidsMap.empty())
         ? 0 : m_bidsMap.begin()->second.m_nOrders)
 
@@ -555,7 +841,7 @@ namespace MAQUETTE
   OrderBook::OBEntry OrderBook::GetBestBidEntry() const
   {
     return
-      m_isSparse
+      (m_isSparse && !m_isHybrid)
       ? (utxx::unlikely(m_bidsMap.empty())
         ? OBEntry() : m_bidsMap.begin()->second)
 
@@ -569,7 +855,7 @@ namespace MAQUETTE
   int  OrderBook::GetBestAskNOrders() const
   {
     return
-      m_isSparse
+      (m_isSparse && !m_isHybrid)
       ? (utxx::unlikely(m_asksMap.empty())
         ? 0 : m_asksMap.begin()->second.m_nOrders)
 
@@ -583,7 +869,7 @@ namespace MAQUETTE
   OrderBook::OBEntry OrderBook::GetBestAskEntry() const
   {
     return
-      m_isSparse
+      (m_isSparse && !m_isHybrid)
       ? (utxx::unlikely(m_asksMap.empty())
         ? OBEntry() : m_asksMap.begin()->second)
 
@@ -598,7 +884,7 @@ namespace MAQUETTE
   {
     return
       m_isInitialised          &&
-        (m_isSparse
+        ((m_isSparse && !m_isHybrid)
          ? !(m_bidsMap.empty() || m_asksMap.empty())
          : (m_BBI >= 0         && m_BAI >= 0));
   }
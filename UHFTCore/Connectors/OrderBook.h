@@ -10,6 +10,8 @@
 #include "Basis/PxsQtys.h"
 #include "Protocols/FIX/Msgs.h"        // For some enums
 #include "InfraStruct/StaticLimits.h"
+#include "Connectors/OrdersHash.hpp"
+#include "Connectors/OBSnapShot.hpp"
 #include <utxx/compiler_hints.hpp>
 #include <utxx/enum.hpp>
 #include <utxx/error.hpp>
@@ -297,6 +299,7 @@ namespace MAQUETTE
     //
     bool     const            m_isFullAmt;
     bool     const            m_isSparse;   // Use Maps, not Arrays!
+    bool     const            m_isHybrid;   // Sparse with a Dense Window
     QtyTypeT const            m_qt;
     bool     const            m_withFracQtys;
     bool     const            m_withSeqNums;
@@ -337,6 +340,12 @@ namespace MAQUETTE
     mutable int               m_AD;   // Curr Mktdepth if Asks (or +oo)
     OBEntry*                  m_asks; // (Qty,#Orders) at all Ask Px Lvls
                                       //   (both 0s at empty lvls)
+    // Structure-of-Arrays "shadows" of the AggrQtys in "m_bids" and "m_asks"
+    // (as "double"s, 0s at empty lvls), maintained along with them, for vect-
+    // orised depth scans (see "Basis/SIMDScans.hpp"). Dense Rep only:
+    double*                   m_bidQtys;
+    double*                   m_askQtys;
+
     //-----------------------------------------------------------------------//
     // Sparse (Map-Based) OrderBook Rep:                                     //
     //-----------------------------------------------------------------------//
@@ -357,6 +366,39 @@ namespace MAQUETTE
     typename std::conditional_t<IsBid, BidsMap, AsksMap> const&
     GetSideMap()  const;
 
+    //-----------------------------------------------------------------------//
+    // Hybrid (Window + Map) OrderBook Rep ("Combined OrderBook"):           //
+    //-----------------------------------------------------------------------//
+    // A Sparse OrderBook ("m_isSparse" is set) which, in addition, has a non-0
+    // "m_NL". Then "m_bids" and "m_asks" are used as RING BUFFERS of "m_NL" (a
+    // power of 2) equi-spaced Px Levels each, covering a window around the L1
+    // of the corresp side; the Px Levels outside the windows are kept in the
+    // "m_bidsMap" and "m_asksMap". This gives Dense-like O(1) updates near the
+    // L1 (where most of the activity is),  and yet the Book can span an arbit-
+    // rary Px range. NB:
+    // (*) All Pxs are represented by "Ticks" (integral multiples of PxStep);
+    //     the slot of a Tick "t" in the ring is (t & (m_NL-1));
+    // (*) "m_BBI" and "m_BAI" are the ring slots of the Best Bid and Ask resp
+    //     (or (-1) if the side is empty); "m_LBI", "m_HAI" and "m_ND" are not
+    //     used;
+    // (*) If a side is non-empty, its L1 is always within the window; so the
+    //     Bids Map only contains Ticks below the window, and the Asks Map only
+    //     contains Ticks above it;
+    // (*) The windows are re-centered automatically when the L1 moves  out of
+    //     them, or too close to their "far" ends:
+    //
+    mutable long              m_BBT;      // Best Bid Tick (if m_BBI >= 0)
+    mutable long              m_BAT;      // Best Ask Tick (if m_BAI >= 0)
+    mutable long              m_bidsLoT;  // Lowest Tick in the Bids window
+    mutable long              m_asksLoT;  // Lowest Tick in the Asks window
+    mutable int               m_bidsWinN; // #Non-Empty Lvls in Bids window
+    mutable int               m_asksWinN; // #Non-Empty Lvls in Asks window
+
+    // "HybridCursor": Iterates over the Non-Empty Px Levels of a Hybrid Order-
+    // Book side (first the window, then the Map), starting from L1:
+    template<bool IsBid>
+    class HybridCursor;
+
     //-----------------------------------------------------------------------//
     // Multi-Book Rep (for CME):                                             //
     //-----------------------------------------------------------------------//
@@ -373,10 +415,16 @@ namespace MAQUETTE
     // dex is an OrderID (in throughout enumeration within the TradingSession);
     // vals are Qtys of those Orders. May or may not be used  (in the latter ca-
     // se, the following flds remain 0).
-    // XXX: It is currently assumed that all OrderIDs are numerical, and contig-
-    // uous; if not, a HashTable will need to be used instead of an array:
+    // The array assumes that all OrderIDs are numerical and contiguous, and it
+    // must hold ALL Orders of the session (slots are never released). If that
+    // is not the case (eg sparse 64-bit OrderIDs), the "OrdersHash" is used
+    // instead, and "m_nOrders" is the max number of simultaneously-live Orders:
     long                      m_nOrders;
     OrderBook::OrderInfo*     m_orders;
+    OrdersHash<OrderInfo>*    m_ordersHash;
+
+    // Number of deleted Orders kept in the "OrdersHash" before their removal:
+    constexpr static long     OrdersRetireLag = 4096;
 
     //-----------------------------------------------------------------------//
     // Initialisation and Sequencing:                                        //
@@ -392,6 +440,12 @@ namespace MAQUETTE
     mutable SeqNum            m_lastUpdateSeqNum;
     mutable bool              m_lastUpdatedBid;
 
+    //-----------------------------------------------------------------------//
+    // SnapShots for Other Threads:                                          //
+    //-----------------------------------------------------------------------//
+    // NULL unless enabled by "EnableSnapShots":
+    OBSnapShotPub*            m_snapShotPub;
+
     //-----------------------------------------------------------------------//
     // Subscription Data:                                                    //
     //-----------------------------------------------------------------------//
@@ -427,7 +481,9 @@ namespace MAQUETTE
     // of levels can be used:
     // NB: MDSubscrID (coming from the underlying protocol)  is  typically NOT
     // known at the point of OrderBook construction, or not used at all, so we
-    // provide a separate method to set it later:
+    // provide a separate method to set it later.
+    // If "a_is_sparse" is set but "a_total_levels" is non-0, the Hybrid Rep is
+    // used, with the window size "a_total_levels" rounded up to a power of 2:
     OrderBook
     (
       EConnector_MktData const* a_mdc,
@@ -441,7 +497,8 @@ namespace MAQUETTE
       bool                      a_cont_rpt_seqs,   // ...
       int                       a_total_levels,    // Physical  rep
       int                       a_max_depth,       // Eg 1..50, or 0 for +oo
-      long                      a_max_orders       // maximum number of orders
+      long                      a_max_orders,      // maximum number of orders
+      bool                      a_hashed_orders    // Use "OrdersHash"
     );
 
     //-----------------------------------------------------------------------//
@@ -531,7 +588,7 @@ namespace MAQUETTE
       bool     SnapShotsOnly,
       bool     IsRelaxed,
       bool     IsFullAmt,
-      bool     IsSparse,   // TODO: 3-way Rep
+      bool     IsSparse,   // NB: Also set for the Hybrid Rep
       QtyTypeT QT,
       typename QR
     >
@@ -589,6 +646,88 @@ namespace MAQUETTE
       OrderInfo*           a_order      // Order affected (iff WithOrdersLog)
     );
 
+    //-----------------------------------------------------------------------//
+    // "UpdateHybridSide": Impl of "Update" for Hybrid (Window + Map) Rep:   //
+    //-----------------------------------------------------------------------//
+    template
+    <
+      bool     IsBid,
+      bool     WithOrdersLog,
+      bool     SnapShotsOnly,
+      bool     IsRelaxed,
+      bool     IsFullAmt,
+      QtyTypeT QT,
+      typename QR
+    >
+    UpdateEffectT UpdateHybridSide
+    (
+      FIX::MDUpdateActionT a_action,    // Use UNDEFINED if not known
+      PriceT               a_px,
+      Qty<QT,QR>           a_qty,       // Delta or RealQty
+      OrderInfo*           a_order      // Order affected (iff WithOrdersLog)
+    );
+
+    //-----------------------------------------------------------------------//
+    // Hybrid Rep Helpers:                                                   //
+    //-----------------------------------------------------------------------//
+    // "HybridRecentre": Moves the window of the given side so that it starts
+    // at "a_new_lo" Tick; the Px Levels leaving the window are moved  to the
+    // Map, and those in the Map which are now covered by the window, are mov-
+    // ed into the window:
+    template<bool IsBid>
+    void HybridRecentre(long a_new_lo);
+
+    // "HybridFindNextBest": Invoked after the L1 of the given side has been
+    // removed; finds the new L1 (possibly re-centering the window):
+    template<bool IsBid>
+    void HybridFindNextBest();
+
+    // "HybridLoFor": The window start Tick for the given L1 Tick:
+    template<bool IsBid>
+    long HybridLoFor(long a_best_tick) const;
+
+    // "HybridSlot" and "HybridTickPx": Tick -> ring slot, Tick -> Px:
+    int    HybridSlot  (long a_tick) const
+      { return int(a_tick & long(m_NL - 1)); }
+
+    PriceT HybridTickPx(long a_tick) const
+      { return PriceT(double(a_tick) * m_instr->m_PxStep); }
+
+    // "HybridRelink": After an "OBEntry" has been moved (between the window
+    // and the Map), re-install the back-ptrs in its Orders (if any):
+    static void HybridRelink(OBEntry* a_obe)
+    {
+      for (OrderInfo* curr = a_obe->m_frstOrder; curr != nullptr;
+           curr = curr->m_next)
+        curr->m_obe = a_obe;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "SnapShotSide": Used by "PublishSnapShot":                            //
+    //-----------------------------------------------------------------------//
+    // Copies up to "a_depth" top levels of the given side into the arrays pro-
+    // vided; returns the number of levels copied:
+    //
+    template<bool IsBid>
+    int SnapShotSide(PriceT* a_pxs, double* a_qtys, int a_depth) const;
+
+    //-----------------------------------------------------------------------//
+    // "SyncLvlQty":                                                         //
+    //-----------------------------------------------------------------------//
+    // Dense Rep: Propagates the AggrQty of a "m_bids" or "m_asks" entry into
+    // "m_bidQtys" or "m_askQtys", resp:
+    //
+    template<bool IsBid>
+    void SyncLvlQty(OBEntry const* a_obe) const
+    {
+      assert(!m_isSparse);
+      long s = a_obe - (IsBid ? m_bids : m_asks);
+      assert(0 <= s && s < long(m_NL));
+      QtyU q = a_obe->m_aggrQty;
+      (IsBid ? m_bidQtys : m_askQtys)[s] =
+        m_withFracQtys ? double(q.GetUD()) : double(q.GetUL());
+    }
+
     //-----------------------------------------------------------------------//
     // "UpdateOBE": Common part of "UpdateDenseSide" and "UpdateSparseSide": //
     //-----------------------------------------------------------------------//
@@ -824,6 +963,24 @@ namespace MAQUETTE
     >
     PriceT GetDeepestPx(Qty<ArgQT,ArgQR> a_cum_vol) const;
 
+    //-----------------------------------------------------------------------//
+    // "GetCumQty":                                                          //
+    //-----------------------------------------------------------------------//
+    // Cumulative Qty of the first "a_depth" non-empty Px Levels  (or of all of
+    // them if "a_depth" is 0):
+    //
+    template<bool IsBid, QtyTypeT QT, typename QR>
+    Qty<QT,QR> GetCumQty(int a_depth) const;
+
+    //-----------------------------------------------------------------------//
+    // "GetNextPx":                                                          //
+    //-----------------------------------------------------------------------//
+    // Px of the first non-empty level deeper (further from L1) than "a_px" (the
+    // latter need not be a non-empty level itself), or NaN if there is none:
+    //
+    template<bool IsBid>
+    PriceT GetNextPx(PriceT a_px) const;
+
   private:
     //-----------------------------------------------------------------------//
     // Internal templated implementation of "GetVWAP":                       //
@@ -836,7 +993,8 @@ namespace MAQUETTE
       typename ArgQR,
       bool     IsBid,
       bool     IsFullAmt,
-      bool     IsSparse
+      bool     IsSparse,
+      bool     IsHybrid
     >
     void GetVWAP_Impl(ParamsVWAP<ArgQT>* a_params) const;
 
@@ -854,6 +1012,11 @@ namespace MAQUETTE
     >
     PriceT GetXPx(Qty<ArgQT,ArgQR> a_cum_vol) const;
 
+    // Dense Rep: Same via a vectorised scan of the AggrQtys (NaN if there is
+    // not enough liquidity):
+    template<XPxMode Mode, bool IsBid>
+    PriceT GetXPxDense(double a_cum_vol) const;
+
   public:
     //=======================================================================//
     // Subscription Services:                                                //
@@ -897,10 +1060,76 @@ namespace MAQUETTE
     // "GetOrderInfo" (by OrderID):                                          //
     //-----------------------------------------------------------------------//
     // Normally, returns a non-NULL ptr to the OrderInfo slot (which may be em-
-    // pty yet). Returns NULL if an error occurs -- no exceptions:
+    // pty yet): the slot is CREATED if it did not exist, so this is to be used
+    // when an Order is added (or registered). Returns NULL if an error occurs
+    // (eg the slots are exhausted) -- no exceptions:
     //
     OrderBook::OrderInfo const* GetOrderInfo(OrderID a_order_id) const;
 
+    //-----------------------------------------------------------------------//
+    // "FindOrderInfo" (by OrderID):                                         //
+    //-----------------------------------------------------------------------//
+    // Pure look-up: returns the existing OrderInfo slot, or NULL if there is
+    // none (never creates a slot, so look-ups of unknown OrderIDs do not con-
+    // sume the "OrdersHash" pool):
+    //
+    OrderBook::OrderInfo const* FindOrderInfo(OrderID a_order_id) const;
+
+    //-----------------------------------------------------------------------//
+    // "RetireOrderInfo":                                                    //
+    //-----------------------------------------------------------------------//
+    // To be invoked when an Order is deleted from the OrdersLog.  With the
+    // "OrdersHash", its OrderInfo slot will eventually be released (after
+    // "OrdersRetireLag" other deletions, unless the OrderID is re-used);  with
+    // the array of Orders, it is a no-op:
+    //
+    void RetireOrderInfo(OrderInfo const* a_order);
+
+    // Whether the "OrdersHash" is used, and the "OrdersHash" itself (or NULL):
+    bool HasHashedOrders() const { return (m_ordersHash != nullptr); }
+
+    OrdersHash<OrderInfo> const* GetOrdersHash() const { return m_ordersHash; }
+
+    //=======================================================================//
+    // SnapShots for Other Threads:                                          //
+    //=======================================================================//
+    //-----------------------------------------------------------------------//
+    // "EnableSnapShots":                                                    //
+    //-----------------------------------------------------------------------//
+    // To be invoked (once) before the OrderBook is used. "a_depth" is the num-
+    // ber of levels published on each side (1..OBSnapShot::MaxDepth):
+    //
+    void EnableSnapShots(int a_depth);
+
+    bool HasSnapShots() const { return (m_snapShotPub != nullptr); }
+
+    //-----------------------------------------------------------------------//
+    // "PublishSnapShot":                                                    //
+    //-----------------------------------------------------------------------//
+    // Invoked by the MDC (on the Reactor thread) when the OrderBook state is
+    // consistent, ie after a batch of updates is complete. No-op if SnapShots
+    // are not enabled:
+    //
+    void PublishSnapShot
+    (
+      bool            a_is_valid,
+      utxx::time_val  a_exch_ts,
+      utxx::time_val  a_recv_ts
+    )
+    const;
+
+    //-----------------------------------------------------------------------//
+    // "GetSnapShot":                                                        //
+    //-----------------------------------------------------------------------//
+    // Can be invoked from ANY thread; lock-free. Returns "false" if SnapShots
+    // are not enabled, or nothing has been published yet:
+    //
+    bool GetSnapShot(OBSnapShot* a_res) const
+    {
+      return utxx::likely(m_snapShotPub != nullptr)
+             ? m_snapShotPub->Read(a_res) : false;
+    }
+
   private:
     //-----------------------------------------------------------------------//
     // "GetPxStepMultiple":                                                  //
@@ -912,6 +1141,15 @@ namespace MAQUETTE
     template<bool IsRelaxed>
     int GetPxStepMultiple(double a_numer) const;
 
+    //-----------------------------------------------------------------------//
+    // "GetPxTick":                                                          //
+    //-----------------------------------------------------------------------//
+    // Similar to "GetPxStepMultiple", but for an absolute Px (in the Hybrid
+    // Rep), so the result may be outside the "int" range:
+    //
+    template<bool IsRelaxed>
+    long GetPxTick(PriceT a_px) const;
+
     //-----------------------------------------------------------------------//
     // "CheckSeqNums":                                                       //
     //-----------------------------------------------------------------------//
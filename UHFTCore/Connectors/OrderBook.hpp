@@ -9,6 +9,7 @@
 #include "Basis/Macros.h"
 #include "Basis/SecDefs.h"
 #include "Basis/QtyConvs.hpp"
+#include "Basis/SIMDScans.hpp"
 #include "Connectors/OrderBook.h"
 #include "Connectors/EConnector_MktData.h"
 #include <algorithm>
@@ -122,23 +123,32 @@ namespace MAQUETTE
         if (utxx::unlikely
            (IsNeg (a_qty) ||
            (IsZero(a_qty) != (a_action == FIX::MDUpdateActionT::Delete))))
+        {
           LOG_ERROR(1, "OrderBook::Update(Aggregated): Inconsistent args: "
-            "UpdateAction=", char(a_action), ", QtyDelta=", QR(a_qty));
+            "UpdateAction={}, QtyDelta={}", char(a_action), QR(a_qty))
           return UpdateEffectT::NONE;
+        }
       )
     }
     // In addition, the Book *should* be consistent -- if it is not, we *still*
     // allow update in the hope that it will be corrected later, possibly after
     // after multiple updates are carried out...
     //-----------------------------------------------------------------------//
-    // The reset depends on whether the OrderBooks is Dense or Sparse:       //
+    // The reset depends on whether the OrderBooks is Dense, Sparse or Hybrid://
     //-----------------------------------------------------------------------//
+    // (The Hybrid Rep is a run-time sub-mode of the Sparse one, so that the
+    // Callers' template params are not affected):
     return
       (!IsSparse)
       ? UpdateDenseSide
         <IsBid, WithOrdersLog, SnapShotsOnly, IsRelaxed, IsFullAmt, QT, QR>
         (a_action, a_px, a_qty, a_order)
 
+      : m_isHybrid
+      ? UpdateHybridSide
+        <IsBid, WithOrdersLog, SnapShotsOnly, IsRelaxed, IsFullAmt, QT, QR>
+        (a_action, a_px, a_qty, a_order)
+
       : UpdateSparseSide
         <IsBid, WithOrdersLog, SnapShotsOnly, IsRelaxed, IsFullAmt, QT, QR>
         (a_action, a_px, a_qty, a_order);
@@ -348,36 +358,22 @@ namespace MAQUETTE
           // the "side" is now completely empty, the following will apply:
           //
           res        = UpdateEffectT::L1Px;  // The orig L1 level was removed
-          bool found = false;
-
-          if constexpr (IsBid)
-            // Find the next BestBid: Traverse the "side" down-wards:
-            for (int i = s-1; i >= 0; --i)
-            {
-              assert(!IsNeg(side[i].m_aggrQty));
-
-              if (IsPos(side[i].m_aggrQty))
-              {
-                bestIdx  = i;
-                bestPx  += double(i-s) * pxStep;          // Neg incr
-                found    = true;
-                break;
-              }
-            }
-          else  // !IsBid
-            // Find the next BestAsk: Traverse the "side" up-wards:
-            for (int i = s+1; i < m_NL; ++i)
-            {
-              assert(!IsNeg(side[i].m_aggrQty));
-
-              if (IsPos(side[i].m_aggrQty))
-              {
-                bestIdx  = i;
-                bestPx  += double(i-s) * pxStep;          // Pos incr
-                found    = true;
-                break;
-              }
-            }
+
+          // Find the next Best level: Scan the "side" down-wards for Bids and
+          // up-wards for Asks, using the SoA Qtys. All non-empty levels are
+          // within [BestIdx .. WrstIdx]:
+          int  i     =
+            IsBid
+            ? SIMD::FindPos<false>(m_bidQtys, s-1, wrstIdx)
+            : SIMD::FindPos<true> (m_askQtys, s+1, wrstIdx);
+          bool found = (i >= 0);
+
+          if (utxx::likely(found))
+          {
+            assert(IsPos(side[i].m_aggrQty));
+            bestIdx  = i;
+            bestPx  += double(i-s) * pxStep;              // Neg or Pos incr
+          }
           // So:
           if (utxx::unlikely(!found))
           {
@@ -635,6 +631,11 @@ namespace MAQUETTE
       assert
         ((CheckOBEntry<true,IsRelaxed,IsSparse,QT,QR>(a_obe, IsBid, a_px)));
     }
+    //-----------------------------------------------------------------------//
+    // Dense Rep: Propagate the resulting AggrQty into the SoA Qtys:         //
+    //-----------------------------------------------------------------------//
+    if constexpr (!IsSparse)
+      SyncLvlQty<IsBid>(a_obe);
   }
 # if defined(__GCC__) && !defined(__clang__)
 # pragma GCC diagnostic pop
@@ -684,23 +685,26 @@ namespace MAQUETTE
 
     // Delete it and decrement "currDepth" back:
     wrst.m_aggrQty = QtyU();
+    SyncLvlQty<IsBid>(&wrst);
     if constexpr (IsBid) ++wrstIdx; else --wrstIdx;
 
     --currDepth;
     assert((m_ND == 0 || currDepth <= m_ND) && currDepth >= 0); // Valid again!
 
-    // Adjust  the "wrstIdx": For Bids, move it up; for Asks, down:
-    while(utxx::likely // NB: the cond below is not just "likely", it's a MUST!
-         ((IsBid && wrstIdx <= bestIdx) || (!IsBid && wrstIdx >= bestIdx)))
+    // Adjust  the "wrstIdx": For Bids, move it up; for Asks, down, until a
+    // non-empty level is found, which will now be the "wrst".  NB: it MUST
+    // be found before reaching "bestIdx"; otherwise, "wrstIdx" moves beyond
+    // "bestIdx" which is detected below:
     {
-      OBEntry& en = side[wrstIdx];
-      assert(!IsNeg(en.m_aggrQty) && en.m_nOrders == 0);
-
-      if (IsPos(en.m_aggrQty))
-        // Got a non-empty level, which will now be the "wrst":
-        break;
-      else
-        { if constexpr (IsBid) ++wrstIdx; else --wrstIdx; }
+      int i =
+        IsBid
+        ? SIMD::FindPos<true> (m_bidQtys, wrstIdx, bestIdx)
+        : SIMD::FindPos<false>(m_askQtys, wrstIdx, bestIdx);
+      wrstIdx =
+        utxx::likely(i >= 0)
+        ? i
+        : (IsBid ? (bestIdx + 1) : (bestIdx - 1));
+      assert(i < 0 || (IsPos(side[i].m_aggrQty) && side[i].m_nOrders == 0));
     }
     // Can it happen that "wrstIdx" is now inconsistent with "bestIdx", ie the
     // "side" has become completely empty? -- No, it should not be, because ini-
@@ -807,6 +811,37 @@ namespace MAQUETTE
     return int(rn);
   }
 
+  //=========================================================================//
+  // "GetPxTick":                                                            //
+  //=========================================================================//
+  // Private method, so can be inlined:
+  //
+  template<bool IsRelaxed>
+  inline long OrderBook::GetPxTick(PriceT a_px) const
+  {
+    // Only invoked in Hybrid mode:
+    assert(m_isHybrid);
+
+    double r  = double(a_px) / m_instr->m_PxStep;
+    double rn = Round(r);
+
+    // Same tolerance as in "GetPxStepMultiple":
+    CHECK_ONLY
+    (
+      if (utxx::unlikely
+         (!IsFinite(rn)                                         ||
+         (!IsRelaxed                                            &&
+            ((rn != 0.0 && Abs(r / rn - 1.0) > PriceT::s_Tol)   ||
+             (rn == 0.0 && Abs(r)            > PriceT::s_Tol) ))))
+        throw utxx::runtime_error
+              ("OrderBook::GetPxTick: ", m_instr->m_FullName.data(),
+               ": Px=", double(a_px), " is not a multiple of PxStep=",
+               m_instr->m_PxStep);
+    )
+    // If OK:
+    return long(rn);
+  }
+
   //=========================================================================//
   // "UpdateSparseSide":                                                     //
   //=========================================================================//
@@ -937,6 +972,416 @@ namespace MAQUETTE
     return res;
   }
 
+  //=========================================================================//
+  // "UpdateHybridSide":                                                     //
+  //=========================================================================//
+  template
+  <
+    bool     IsBid,
+    bool     WithOrdersLog,
+    bool     SnapShotsOnly,
+    bool     IsRelaxed,
+    bool     IsFullAmt,
+    QtyTypeT QT,
+    typename QR
+  >
+  inline OrderBook::UpdateEffectT OrderBook::UpdateHybridSide
+  (
+    FIX::MDUpdateActionT a_action,     // Use UNDEFINED if not known
+    PriceT               a_px,
+    Qty<QT,QR>           a_qty,        // WithOrdersLog: Delta; other: TargQty
+    OrderInfo*           a_order       // Order affected (iff WithOrdersLog)
+  )
+  {
+    //-----------------------------------------------------------------------//
+    // Hybrid-Specific Checks:                                               //
+    //-----------------------------------------------------------------------//
+    // Only invoked in Hybrid mode:
+    assert(m_isSparse && m_isHybrid && IsPow2(m_NL) && IsFinite(a_px));
+
+    // Refs to the Side to be updated:
+    typename std::conditional_t<IsBid, BidsMap, AsksMap>& sideMap =
+      const_cast<typename std::conditional_t<IsBid, BidsMap, AsksMap>&>
+      (GetSideMap<IsBid>());
+
+    OBEntry*  side     = IsBid ? m_bids     : m_asks;
+    int&      bestIdx  = IsBid ? m_BBI      : m_BAI;
+    long&     bestTick = IsBid ? m_BBT      : m_BAT;
+    long&     loTick   = IsBid ? m_bidsLoT  : m_asksLoT;
+    int&      winN     = IsBid ? m_bidsWinN : m_asksWinN;
+    PriceT&   bestPx   = IsBid ? m_BBPx     : m_BAPx;
+
+    // Integrity conditions: a non-empty side has its L1 in the window:
+    assert(side != nullptr && (bestIdx >= 0) == (winN > 0) &&
+          (winN > 0 || sideMap.empty()));
+
+    UpdateEffectT res  = UpdateEffectT::L2;  // Made more precise below
+    Qty<QT,QR>    newQty;                    // TBD; initially 0
+
+    // The Tick of "a_px", and its position wrt the curr L1 and the window:
+    long t        = GetPxTick<IsRelaxed>(a_px);
+    bool isEmpty  = (bestIdx < 0);
+    bool isBetter = isEmpty || (IsBid ? (t > bestTick) : (t < bestTick));
+    bool inWin    = !isEmpty && loTick <= t && t < loTick + long(m_NL);
+
+    //-----------------------------------------------------------------------//
+    // Find the existing "OBEntry" for this Px (in the window or the Map):   //
+    //-----------------------------------------------------------------------//
+    OBEntry* obe  = nullptr;
+    auto     it   = sideMap.end();
+
+    if (inWin)
+    {
+      obe = side + HybridSlot(t);
+      if (IsZero(obe->m_aggrQty))
+        obe = nullptr;
+    }
+    else
+    if (!isBetter)
+    {
+      // Bids below the window, or Asks above it:
+      it = sideMap.find(HybridTickPx(t));
+      if (it != sideMap.end())
+        obe = &(it->second);
+    }
+    bool existed = (obe != nullptr);
+
+    if (existed)
+    {
+      // The Px level already exists, so it must have a valid OrderBook ptr.
+      // In the FullOrdersLog mode, we need its prev qty, since "a_qty" is a
+      // delta in that case:
+      assert(obe->m_ob == this && !isEmpty);
+      Qty<QT,QR> prevQty = obe->GetAggrQty<QT,QR>();
+      newQty =
+        VerifyQty<IsBid,QT,QR>(WithOrdersLog ? prevQty + a_qty : a_qty, a_px);
+
+      if (t == bestTick && newQty != prevQty)
+        res = UpdateEffectT::L1Qty;
+    }
+    else
+    {
+      // No such Px level. Then the "newQty" is the given "a_qty" (no matter
+      // whether WithOrdersLog is set or not):
+      newQty = VerifyQty<IsBid,QT,QR>(a_qty, a_px);
+      assert(!IsNeg(newQty));
+
+      if (utxx::unlikely(!IsPos(newQty)))
+      {
+        // Nothing to do -- attempting to delete a non-existing level:
+        LOG_WARN(4,
+          "OrderBook::UpdateHybridSide: {}: {}: Non-existant Px={}",
+          m_instr->m_FullName.data(), IsBid ? "Bid" : "Ask", double(a_px))
+        return UpdateEffectT::NONE;
+      }
+      // If this is a new L1 outside the window (or the Side was empty), move
+      // the window first, so the new L1 will be within it:
+      if (isBetter && !inWin)
+      {
+        if (isEmpty)
+        {
+          assert(winN == 0 && sideMap.empty());
+          loTick = HybridLoFor<IsBid>(t);
+        }
+        else
+          HybridRecentre<IsBid>(HybridLoFor<IsBid>(t));
+        inWin = true;
+      }
+      // Install a new "OBEntry", empty as yet:
+      if (inWin)
+        obe = side + HybridSlot(t);
+      else
+      {
+        auto   insRes = sideMap.try_emplace(HybridTickPx(t));
+        assert(insRes.second);
+        it  =  insRes.first;
+        obe = &(it->second);
+      }
+      assert(IsZero(obe->m_aggrQty) && obe->m_nOrders == 0);
+      obe->m_ob = this;
+
+      if (isBetter)
+        res = UpdateEffectT::L1Px;
+    }
+    //-----------------------------------------------------------------------//
+    // Update this "OBEntry" (Orders if used, and AggrQty):                  //
+    //-----------------------------------------------------------------------//
+    assert(obe != nullptr && !IsNeg(newQty));
+
+    // NB: IsSparse=true (the Entry was located without "GetPxStepMultiple"):
+    UpdateOBE<IsBid, WithOrdersLog, IsRelaxed, true, QT, QR>
+      (a_action, a_px, newQty, a_order, obe, &res);
+
+    // "UpdateOBE" may have reset the Entry, so re-install the OrderBook ptr:
+    obe->m_ob      = this;
+    bool isZeroNow = IsZero(obe->m_aggrQty);
+
+    if (inWin)
+    {
+      // Maintain the count of Non-Empty window levels; a removed level is
+      // reset completely:
+      if (!existed && !isZeroNow)
+        ++winN;
+      else
+      if (isZeroNow)
+      {
+        if (existed)
+          --winN;
+        *obe      = OBEntry();
+        obe->m_ob = this;
+      }
+    }
+    else
+    if (isZeroNow)
+      // Remove the Map level:
+      sideMap.erase(it);
+
+    //-----------------------------------------------------------------------//
+    // Maintain the L1:                                                      //
+    //-----------------------------------------------------------------------//
+    if (!isZeroNow)
+    {
+      if (isBetter)
+      {
+        assert(inWin);
+        bestTick = t;
+        bestIdx  = HybridSlot(t);
+      }
+    }
+    else
+    if (existed ? (t == bestTick) : (isBetter && !isEmpty))
+    {
+      // The L1 has been removed (or a new L1 could not be installed after the
+      // window was moved): Find the new L1, and adjust the "res" (unless
+      // "UpdateOBE" has set it to ERROR):
+      HybridFindNextBest<IsBid>();
+      if (res != UpdateEffectT::ERROR)
+        res = UpdateEffectT::L1Px;
+    }
+    //-----------------------------------------------------------------------//
+    // Propagate the BestPx:                                                 //
+    //-----------------------------------------------------------------------//
+    bestPx = utxx::unlikely(bestIdx < 0) ? PriceT() : HybridTickPx(bestTick);
+
+    assert((bestIdx >= 0) == (winN > 0) && (winN > 0 || sideMap.empty()) &&
+           (bestIdx <  0  ||
+           (loTick <= bestTick && bestTick < loTick + long(m_NL) &&
+            IsPos(side[bestIdx].m_aggrQty))));
+    // All Done!
+    return res;
+  }
+
+  //=========================================================================//
+  // "HybridLoFor":                                                          //
+  //=========================================================================//
+  // Leave a margin of (m_NL/8) levels on the "near" side of the L1 (where new
+  // better Pxs would come), and use the rest of the window for the "far" side:
+  //
+  template<bool IsBid>
+  inline long OrderBook::HybridLoFor(long a_best_tick) const
+  {
+    assert(m_isHybrid);
+    long margin = long(m_NL / 8);
+    return
+      IsBid
+      ? (a_best_tick - long(m_NL) + 1 + margin)
+      : (a_best_tick - margin);
+  }
+
+  //=========================================================================//
+  // "HybridRecentre":                                                       //
+  //=========================================================================//
+  // NB: The ring slots of the Ticks which remain in the window do not change,
+  // so only the levels leaving / entering the window are actually moved:
+  //
+  template<bool IsBid>
+  inline void OrderBook::HybridRecentre(long a_new_lo)
+  {
+    assert(m_isHybrid);
+
+    typename std::conditional_t<IsBid, BidsMap, AsksMap>& sideMap =
+      const_cast<typename std::conditional_t<IsBid, BidsMap, AsksMap>&>
+      (GetSideMap<IsBid>());
+
+    OBEntry*  side   = IsBid ? m_bids     : m_asks;
+    long&     loTick = IsBid ? m_bidsLoT  : m_asksLoT;
+    int&      winN   = IsBid ? m_bidsWinN : m_asksWinN;
+    long      oldLo  = loTick;
+    long      nl     = long(m_NL);
+
+    if (utxx::unlikely(a_new_lo == oldLo))
+      return;
+
+    //-----------------------------------------------------------------------//
+    // Move the levels leaving the window into the Map:                      //
+    //-----------------------------------------------------------------------//
+    // They are the Ticks [from, to) of the old window which are not covered by
+    // the new one. Stop as soon as the window is empty:
+    long from = (a_new_lo > oldLo) ? oldLo : std::max(a_new_lo + nl, oldLo);
+    long to   = (a_new_lo > oldLo) ? std::min(a_new_lo, oldLo + nl)
+                                   : (oldLo + nl);
+
+    for (long t = from; t < to && winN > 0; ++t)
+    {
+      OBEntry& obe = side[HybridSlot(t)];
+      if (IsZero(obe.m_aggrQty))
+        continue;
+
+      // Such levels can only be on the "far" side of the L1:
+      assert(IsBid ? (t < a_new_lo) : (t >= a_new_lo + nl));
+
+      auto   insRes = sideMap.try_emplace(HybridTickPx(t), obe);
+      assert(insRes.second);
+      OBEntry* moved = &(insRes.first->second);
+      moved->m_ob    = this;
+      HybridRelink(moved);
+
+      obe      = OBEntry();
+      obe.m_ob = this;
+      --winN;
+    }
+    loTick = a_new_lo;
+
+    //-----------------------------------------------------------------------//
+    // Move the Map levels which are now covered by the window into it:      //
+    //-----------------------------------------------------------------------//
+    // The Map is ordered from the L1 side, and all its Ticks are beyond the
+    // "far" end of the window, so only a prefix of it may be affected:
+    //
+    while (!sideMap.empty())
+    {
+      auto it = sideMap.begin();
+      long t  = GetPxTick<true>(it->first);
+      if (t < a_new_lo || t >= a_new_lo + nl)
+        break;
+
+      OBEntry& obe = side[HybridSlot(t)];
+      assert(IsZero(obe.m_aggrQty));
+      obe      = it->second;
+      obe.m_ob = this;
+      HybridRelink(&obe);
+      ++winN;
+      sideMap.erase(it);
+    }
+  }
+
+  //=========================================================================//
+  // "HybridFindNextBest":                                                   //
+  //=========================================================================//
+  template<bool IsBid>
+  inline void OrderBook::HybridFindNextBest()
+  {
+    assert(m_isHybrid);
+
+    OBEntry const* side     = IsBid ? m_bids     : m_asks;
+    int&           bestIdx  = IsBid ? m_BBI      : m_BAI;
+    long&          bestTick = IsBid ? m_BBT      : m_BAT;
+    long           loTick   = IsBid ? m_bidsLoT  : m_asksLoT;
+    int            winN     = IsBid ? m_bidsWinN : m_asksWinN;
+    long           nl       = long(m_NL);
+
+    if (utxx::likely(winN > 0))
+    {
+      // The new L1 is in the window: Scan it from the prev L1 towards the
+      // "far" end:
+      long t = IsBid ? std::min(bestTick, loTick + nl - 1)
+                     : std::max(bestTick, loTick);
+
+      while (IsZero(side[HybridSlot(t)].m_aggrQty))
+      {
+        IsBid ? --t : ++t;
+        assert(loTick <= t && t < loTick + nl);
+      }
+      bestTick = t;
+      bestIdx  = HybridSlot(t);
+
+      // If the new L1 is now too close to the "far" end of the window, move
+      // the window (the ring slot of the L1 remains unchanged):
+      long margin = nl / 8;
+      if (utxx::unlikely
+         (IsBid ? (t < loTick + margin) : (t > loTick + nl - 1 - margin)))
+        HybridRecentre<IsBid>(HybridLoFor<IsBid>(t));
+    }
+    else
+    if (!GetSideMap<IsBid>().empty())
+    {
+      // The window has become empty: The new L1 is the best Map level, so
+      // move the window to it (this moves that level into the window):
+      long t = GetPxTick<true>(GetSideMap<IsBid>().begin()->first);
+      HybridRecentre<IsBid>(HybridLoFor<IsBid>(t));
+      bestTick = t;
+      bestIdx  = HybridSlot(t);
+      assert(IsPos(side[bestIdx].m_aggrQty));
+    }
+    else
+      // The whole side is now empty:
+      bestIdx  = -1;
+  }
+
+  //=========================================================================//
+  // "HybridCursor":                                                         //
+  //=========================================================================//
+  template<bool IsBid>
+  class OrderBook::HybridCursor
+  {
+  private:
+    using SideMap = std::conditional_t<IsBid, BidsMap, AsksMap>;
+
+    OrderBook const*                  m_ob;
+    long                              m_tick; // Curr Tick in the window
+    int                               m_left; // Non-Empty window lvls left
+    typename SideMap::const_iterator  m_it;   // Curr Map level (after window)
+    typename SideMap::const_iterator  m_end;
+
+  public:
+    explicit HybridCursor(OrderBook const* a_ob)
+    : m_ob  (a_ob),
+      m_tick(IsBid ? a_ob->m_BBT      : a_ob->m_BAT),
+      m_left(IsBid ? a_ob->m_bidsWinN : a_ob->m_asksWinN),
+      m_it  (a_ob->GetSideMap<IsBid>().begin()),
+      m_end (a_ob->GetSideMap<IsBid>().end())
+    {
+      // NB: May also be constructed (but then not used) for other Reps:
+      assert(!m_ob->m_isHybrid ||
+            (m_left > 0) == ((IsBid ? m_ob->m_BBI : m_ob->m_BAI) >= 0));
+    }
+
+    bool IsEnd() const
+      { return m_left == 0 && m_it == m_end; }
+
+    bool IsL1()  const
+      { return m_left > 0 && m_tick == (IsBid ? m_ob->m_BBT : m_ob->m_BAT); }
+
+    PriceT Px()  const
+      { return (m_left > 0) ? m_ob->HybridTickPx(m_tick) : m_it->first; }
+
+    OBEntry const& Entry() const
+    {
+      return
+        (m_left > 0)
+        ? (IsBid ? m_ob->m_bids : m_ob->m_asks)[m_ob->HybridSlot(m_tick)]
+        : m_it->second;
+    }
+
+    void Next()
+    {
+      assert(!IsEnd());
+      if (m_left == 0)
+      {
+        ++m_it;
+        return;
+      }
+      if (--m_left == 0)
+        return;   // Continue with the Map
+
+      // Otherwise, skip the empty window levels:
+      OBEntry const* side = IsBid ? m_ob->m_bids : m_ob->m_asks;
+      do
+        IsBid ? --m_tick : ++m_tick;
+      while (IsZero(side[m_ob->HybridSlot(m_tick)].m_aggrQty));
+    }
+  };
+
   //=========================================================================//
   // "CheckOBEntry":                                                         //
   //=========================================================================//
@@ -970,7 +1415,23 @@ namespace MAQUETTE
     {
       if constexpr (IsSparse)
       {
-        // Sparse mode:
+        // Hybrid mode: Try the window first:
+        if (m_isHybrid && (a_is_bid ? m_BBI : m_BAI) >= 0)
+        {
+          long t = 0;
+          try
+            { t = GetPxTick<IsRelaxed>(a_px); }
+          catch (std::exception const&)
+            { return false; }
+
+          long lo = a_is_bid ? m_bidsLoT : m_asksLoT;
+          if (lo <= t && t < lo + long(m_NL))
+            a_obe = (a_is_bid ? m_bids : m_asks) + HybridSlot(t);
+        }
+        // Sparse mode (or outside the Hybrid window):
+        if (a_obe != nullptr)
+          ;
+        else
         if (a_is_bid)
         {
           auto it = m_bidsMap.find(a_px);
@@ -1075,7 +1536,63 @@ namespace MAQUETTE
     UpdatedSidesT sides = UpdatedSidesT::NONE;
 
     //-----------------------------------------------------------------------//
-    // First, the case of a Sparse OrderBook:                                //
+    // First, the case of a Hybrid OrderBook:                                //
+    //-----------------------------------------------------------------------//
+    if (m_isHybrid)
+    {
+      // If either side is empty, nothing to do -- such a Book is consistent:
+      if (utxx::unlikely(m_BBI < 0 || m_BAI < 0))
+      {
+        assert(IsConsistent());
+        return sides;   // NONE as yet
+      }
+      // Otherwise, remove the L1 of the not-most-recently updated side while
+      // it collides with the other (most-recently-updated) one. The L1 is al-
+      // ways in the window, so this is done slot-by-slot:
+      //
+      if (m_lastUpdatedBid)
+      {
+        while (m_BAI >= 0 && m_BAT <= m_BBT)
+        {
+          OBEntry& obe = m_asks[m_BAI];
+          if constexpr (WithOrdersLog)
+            ResetOrders(obe.m_frstOrder);
+          obe      = OBEntry();
+          obe.m_ob = this;
+          --m_asksWinN;
+          HybridFindNextBest<false>();
+        }
+        // Update BestAskPx:
+        m_BAPx = utxx::unlikely(m_BAI < 0) ? PriceT() : HybridTickPx(m_BAT);
+
+        // NB: In this case, the Ask side is modified!
+        sides |=  UpdatedSidesT::Ask;
+      }
+      else
+      {
+        while (m_BBI >= 0 && m_BBT >= m_BAT)
+        {
+          OBEntry& obe = m_bids[m_BBI];
+          if constexpr (WithOrdersLog)
+            ResetOrders(obe.m_frstOrder);
+          obe      = OBEntry();
+          obe.m_ob = this;
+          --m_bidsWinN;
+          HybridFindNextBest<true>();
+        }
+        // Update BestBidPx:
+        m_BBPx = utxx::unlikely(m_BBI < 0) ? PriceT() : HybridTickPx(m_BBT);
+
+        // NB: In this case, the Bid side is modified!
+        sides |=  UpdatedSidesT::Bid;
+      }
+      // All Done:
+      assert(IsConsistent());
+      return sides;
+    }
+
+    //-----------------------------------------------------------------------//
+    // Then, the case of a Sparse OrderBook:                                 //
     //-----------------------------------------------------------------------//
     if (m_isSparse)
     {
@@ -1195,7 +1712,9 @@ namespace MAQUETTE
           // is set,  we need to reset the Orders at this level as well:
           if constexpr (WithOrdersLog)
             ResetOrders(m_asks[i].m_frstOrder);
-          m_asks[i] = OBEntry();
+          m_asks[i]      = OBEntry();
+          m_asks[i].m_ob = this;
+          m_askQtys[i]   = 0.0;
         }
         else
         {
@@ -1247,7 +1766,9 @@ namespace MAQUETTE
           // is set,  we need to reset the Orders at this level as well:
           if constexpr (WithOrdersLog)
             ResetOrders(m_bids[i].m_frstOrder);
-          m_bids[i] = OBEntry();
+          m_bids[i]      = OBEntry();
+          m_bids[i].m_ob = this;
+          m_bidQtys[i]   = 0.0;
         }
         else
         {
@@ -1296,13 +1817,32 @@ namespace MAQUETTE
 
     // If the Side is empty, return immediately:
     bool isEmpty =
-      m_isSparse ? sideMap.empty() : ((IsBid ? m_BBI : m_BAI) < 0);
+      (m_isSparse && !m_isHybrid)
+      ? sideMap.empty()
+      : ((IsBid ? m_BBI : m_BAI) < 0);
 
     if (utxx::unlikely(isEmpty))
       return;
 
     // Generic Case: NB: "d" is the curr depth, NOT counting empty levels;
     // "s" is the curr slot, possibly empty (Dense OrderBook):
+    if (m_isHybrid)
+    {
+      //---------------------------------------------------------------------//
+      // Hybrid OrderBook:                                                   //
+      //---------------------------------------------------------------------//
+      int d = 0;
+      for (HybridCursor<IsBid> cur(this);
+           !cur.IsEnd() && d < a_depth;  cur.Next(), ++d)
+      {
+        OBEntry const& obe = cur.Entry();
+        assert (IsPos (obe.m_aggrQty));
+
+        if (!a_action(d, cur.Px(), obe))
+          return;
+      }
+    }
+    else
     if (!m_isSparse)
     {
       //---------------------------------------------------------------------//
@@ -1313,31 +1853,35 @@ namespace MAQUETTE
       else
         assert(0 <= m_BAI && m_BAI <= m_HAI && m_HAI < m_NL);
 
-      double pxStep = m_instr->m_PxStep;
+      double        pxStep = m_instr->m_PxStep;
+      double const* qtys   = IsBid ? m_bidQtys : m_askQtys;
+      int           wrst   = IsBid ? m_LBI     : m_HAI;
 
-      for (int d = 0,  s = IsBid ? m_BBI : m_BAI;
-           d < a_depth && utxx::likely(s >= 0 && s < m_NL);
-           IsBid ? --s : ++s)
+      // Empty slots are skipped by vectorised scans of the SoA Qtys; the whole
+      // side has been traversed when no more non-empty levels are found:
+      for (int d = 0,  s = IsBid ? m_BBI : m_BAI;  d < a_depth;  ++d)
       {
-        if ((IsBid && s < m_LBI) || (!IsBid && s > m_HAI))
-          break;   // The whole side has been traversed
+        s = SIMD::FindPos<!IsBid>(qtys, s, wrst);
+        if (s < 0)
+          break;
 
+        // Yes, this is a real non-empty OrderBook level, so invoke the "a_ac-
+        // tion" and increment "d". NB: For BOTH Bid and Ask sides,  the  Px
+        // increases with "s":
+        //
         OBEntry const& obe = IsBid ? m_bids[s] : m_asks[s];
-        assert(!IsNeg(obe.m_aggrQty));
+        assert(IsPos(obe.m_aggrQty));
 
-        if (IsPos(obe.m_aggrQty))
-        {
-          // Yes, this is a real non-empty OrderBook level, so invoke the
-          // "a_action" and increment "d". NB: For BOTH Bid and Ask sides,
-          // the Px increases with "s":
-          //
-          PriceT px = (IsBid ? m_BBPx : m_BAPx) +
-                      double(s - (IsBid ? m_BBI : m_BAI)) * pxStep;
+        PriceT px = (IsBid ? m_BBPx : m_BAPx) +
+                    double(s - (IsBid ? m_BBI : m_BAI)) * pxStep;
 
-          if (!a_action(d, px, obe))
-            return;   // Exit requested from the call-back
-          ++d;
-        }
+        if (!a_action(d, px, obe))
+          return;   // Exit requested from the call-back
+
+        // Move beyond this level:
+        if constexpr (IsBid) --s; else ++s;
+        if (utxx::unlikely(s < 0 || s >= m_NL))
+          break;
       }
     }
     else
@@ -1397,20 +1941,27 @@ namespace MAQUETTE
                          a_params->m_manipRedCoeff > 1.0))
         throw utxx::badarg_error("OrderBook::GetVWAP: Invalid ManipRedCoeff");
     )
-    // The implementation is parameterised by the "IsSparse" for efficiency:
+    // The implementation is parameterised by the "IsSparse" and "IsHybrid"
+    // for efficiency:
     if (m_isFullAmt)
     {
+      if (m_isHybrid)
+        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,true, true, true >(a_params);
+      else
       if (m_isSparse)
-        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,true, true >(a_params);
+        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,true, true, false>(a_params);
       else
-        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,true, false>(a_params);
+        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,true, false,false>(a_params);
     }
     else
     {
+      if (m_isHybrid)
+        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,false,true, true >(a_params);
+      else
       if (m_isSparse)
-        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,false,true >(a_params);
+        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,false,true, false>(a_params);
       else
-        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,false,false>(a_params);
+        GetVWAP_Impl<OBQT,OBQR,ArgQT,ArgQR,IsBid,false,false,false>(a_params);
     }
   }
 
@@ -1425,11 +1976,13 @@ namespace MAQUETTE
     typename ArgQR,
     bool     IsBid,
     bool     IsFullAmt,
-    bool     IsSparse
+    bool     IsSparse,
+    bool     IsHybrid
   >
   inline void OrderBook::GetVWAP_Impl(ParamsVWAP<ArgQT>* a_params) const
   {
-    assert(IsSparse == m_isSparse);
+    static_assert(!IsHybrid || IsSparse, "Hybrid OrderBook must be Sparse");
+    assert(IsSparse == m_isSparse && IsHybrid == m_isHybrid);
     assert((IsValidQtyRep<OBQT,OBQR>(m_qt, m_withFracQtys)));
 
     //-----------------------------------------------------------------------//
@@ -1442,10 +1995,15 @@ namespace MAQUETTE
     // For both Dense and Sparse OrderBooks:
     PriceT         bestPx  = IsBid ? m_BBPx : m_BAPx;
 
-    // For a Sparse OrderBook only:
-    typename std::conditional_t<IsBid, BidsMap, AsksMap> sideMap;
-    if constexpr (IsSparse)
-      assert(bestPx == sideMap.begin()->first);
+    // For a Sparse OrderBook only. NB: This must be a ref to the actual Map,
+    // not a local (empty) copy:
+    typename std::conditional_t<IsBid, BidsMap, AsksMap> const& sideMap =
+      GetSideMap<IsBid>();
+    if constexpr (IsSparse && !IsHybrid)
+      assert(sideMap.empty() || bestPx == sideMap.begin()->first);
+
+    // For a Hybrid OrderBook only (initially at L1, if any):
+    HybridCursor<IsBid> cur(this);
 
     // The results are initially set to NaN:
     for (int i = 0; i < ParamsVWAP<ArgQT>::MaxBands; ++i)
@@ -1456,7 +2014,8 @@ namespace MAQUETTE
 
     // Is this Side completely empty? Then return all NaNs:
     if (utxx::unlikely
-       ((!IsSparse && bestIdx < 0) || (IsSparse && sideMap.empty())))
+       (((!IsSparse || IsHybrid) && bestIdx < 0) ||
+         (IsSparse && !IsHybrid  && sideMap.empty())))
     {
       assert(!IsFinite(bestPx));
       return;
@@ -1470,7 +2029,7 @@ namespace MAQUETTE
 
     // For a Sparse OrderBook: use the "it" iterator:
     auto   it     = sideMap.begin();
-    assert(!IsSparse || it != sideMap.end());
+    assert(!IsSparse || IsHybrid || it != sideMap.end());
 
     // Qty  at the curr (initially L1) OrderBook level, CONVERTED into ArgQty.
     // XXX: If this requires QtyA <-> QtyB conversion, Px(A/B) is required;
@@ -1478,7 +2037,7 @@ namespace MAQUETTE
     // we may use the CurrPxLevel to that end; so initially, it is "bestPx":
     //
     Qty<OBQT,OBQR> obQty   =
-      ((!IsSparse) ? side[s] : sideMap.begin()->second)
+      ((!IsSparse) ? side[s] : IsHybrid ? cur.Entry() : it->second)
       .template GetAggrQty<OBQT,OBQR>();
 
     PriceT           px  = bestPx;
@@ -1520,7 +2079,9 @@ namespace MAQUETTE
 
         // "nOrds" is the number of orders at that level. (If the OrderBook is
         // not OrdersLog-based, "nOrds" would be 0, and would be ignored):
-        int nOrds = ((!IsSparse) ? side[s] : it->second).m_nOrders;
+        int nOrds =
+          ((!IsSparse) ? side[s] : IsHybrid ? cur.Entry() : it->second)
+          .m_nOrders;
 
         //-------------------------------------------------------------------//
         // Full-Amount (Non-Sweepable) Pxs?                                  //
@@ -1568,8 +2129,9 @@ namespace MAQUETTE
             manip = false;
           }
           bool atL1 =
-            (!IsSparse && (s == bestIdx))     ||
-             (IsSparse && it == sideMap.begin());
+            (!IsSparse && (s == bestIdx))                   ||
+             (IsHybrid && cur.IsL1())                       ||
+             (IsSparse && !IsHybrid && it == sideMap.begin());
 
           if (utxx::unlikely(manip && (atL1 || !(a_params->m_manipOnlyL1))))
             // Reduce the available "qty" due to manipulation possibility:
@@ -1655,8 +2217,22 @@ namespace MAQUETTE
       bool atEnd = false;
       if constexpr (!IsSparse)
       {
+        // Empty levels are skipped by a vectorised scan of the SoA Qtys:
         IsBid ? --s : ++s;
         atEnd = (IsBid && s < m_LBI) || (!IsBid && s > m_HAI);
+        if (utxx::likely(!atEnd))
+        {
+          s     = IsBid
+                  ? SIMD::FindPos<false>(m_bidQtys, s, m_LBI)
+                  : SIMD::FindPos<true> (m_askQtys, s, m_HAI);
+          atEnd = (s < 0);
+        }
+      }
+      else
+      if constexpr (IsHybrid)
+      {
+        cur.Next();
+        atEnd = cur.IsEnd();
       }
       else
       {
@@ -1676,10 +2252,11 @@ namespace MAQUETTE
       // occurs HERE.  Again, QtyA <-> QtyB conversions are also allowed (using
       // the CurrPxLevel), but they are undesirable:
       //
-      obQty = ((!IsSparse) ? side[s] : it->second)
+      obQty = ((!IsSparse) ? side[s] : IsHybrid ? cur.Entry() : it->second)
               .template GetAggrQty<OBQT,OBQR>();
       px    =
-        (!IsSparse) ? (bestPx + double(s - bestIdx) * pxStep) : it->first;
+        (!IsSparse) ? (bestPx + double(s - bestIdx) * pxStep) :
+        IsHybrid    ? cur.Px()                                : it->first;
 
       qty   = QtyConverter<OBQT,ArgQT>::template Convert<OBQR,ArgQR>
               (obQty, *m_instr, px);
@@ -1807,7 +2384,7 @@ namespace MAQUETTE
   inline   Qty<QT,QR>   OrderBook::GetBestBidQty() const
   {
     assert((IsValidQtyRep<QT,QR>(m_qt, m_withFracQtys)));
-    if (m_isSparse)
+    if (m_isSparse && !m_isHybrid)
     {
       bool   isEmpty =  m_bidsMap.empty();
       assert(isEmpty || IsPos(m_bidsMap.begin()->second.m_aggrQty));
@@ -1835,7 +2412,7 @@ namespace MAQUETTE
   inline   Qty<QT,QR>   OrderBook::GetBestAskQty() const
   {
     assert((IsValidQtyRep<QT,QR>(m_qt, m_withFracQtys)));
-    if (m_isSparse)
+    if (m_isSparse && !m_isHybrid)
     {
       bool   isEmpty =  m_asksMap.empty();
       assert(isEmpty || IsPos(m_asksMap.begin()->second.m_aggrQty));
@@ -1938,6 +2515,22 @@ namespace MAQUETTE
       if (utxx::unlikely(!IsPos(a_cum_vol)))
         throw utxx::badarg_error("OrderBook::GetVWAP1: CumVol <= 0");
     )
+    // Dense OrderBook, and no Px-dependent Qty conversions: Use a vectorised
+    // scan:
+    if constexpr (OBQT == ArgQT)
+    {
+      if (!m_isSparse)
+      {
+        assert((IsValidQtyRep<OBQT,OBQR>(m_qt, m_withFracQtys)));
+        PriceT px = GetXPxDense<Mode, IsBid>(double(a_cum_vol));
+
+        if constexpr (ToPxAB)
+          if (utxx::likely(IsFinite(px)))
+            px = m_instr->GetPxAB(px);
+
+        return utxx::likely(IsFinite(px)) ? px : PriceT();
+      }
+    }
     // Get the CumPx. NB: We may potentially receive NaN here (if there is not
     // enough liquidity), in which case NaN is returned:
     //
@@ -2001,6 +2594,144 @@ namespace MAQUETTE
     return utxx::likely(IsFinite(cumPx)) ? cumPx : PriceT();
   }
 
+  //=========================================================================//
+  // "GetXPxDense":                                                          //
+  //=========================================================================//
+  template<OrderBook::XPxMode Mode, bool IsBid>
+  inline PriceT OrderBook::GetXPxDense(double a_cum_vol) const
+  {
+    assert(!m_isSparse && a_cum_vol > 0.0);
+
+    int    bestIdx = IsBid ? m_BBI  : m_BAI;
+    PriceT bestPx  = IsBid ? m_BBPx : m_BAPx;
+    if (utxx::unlikely(bestIdx < 0))
+      return PriceT();    // Empty side
+
+    // Scan from L1 into the Depth. Offsets of the levels taken are relative to
+    // L1, in PxSteps:
+    SIMD::DepthScan ds =
+      IsBid
+      ? SIMD::ScanToQty<false>(m_bidQtys, bestIdx, m_LBI, a_cum_vol)
+      : SIMD::ScanToQty<true> (m_askQtys, bestIdx, m_HAI, a_cum_vol);
+
+    // NB: "m_qty" is exactly "a_cum_vol" iff the liquidity is sufficient:
+    if (utxx::unlikely(ds.m_qty != a_cum_vol))
+      return PriceT();    // NaN
+
+    double pxStep = IsBid ? (- m_instr->m_PxStep) : m_instr->m_PxStep;
+    assert(ds.m_last >= 0);
+
+    return
+      (Mode == XPxMode::VWAP1)
+      ? bestPx + (ds.m_qtyOff / a_cum_vol) * pxStep
+      : bestPx + double(ds.m_last - bestIdx) * m_instr->m_PxStep;
+  }
+
+  //=========================================================================//
+  // "GetCumQty":                                                            //
+  //=========================================================================//
+  template<bool IsBid, QtyTypeT QT, typename QR>
+  inline Qty<QT,QR> OrderBook::GetCumQty(int a_depth) const
+  {
+    assert(a_depth >= 0 && (IsValidQtyRep<QT,QR>(m_qt, m_withFracQtys)));
+    if (a_depth == 0)
+      a_depth = INT_MAX;
+
+    if (!m_isSparse)
+    {
+      // Dense OrderBook: Vectorised scan of the SoA Qtys. The sum is exact if
+      // QR is integral (up to 2^53):
+      int bestIdx = IsBid ? m_BBI : m_BAI;
+      if (utxx::unlikely(bestIdx < 0))
+        return Qty<QT,QR>();
+
+      SIMD::DepthScan ds =
+        IsBid
+        ? SIMD::CumQtyN<false>(m_bidQtys, bestIdx, m_LBI, a_depth)
+        : SIMD::CumQtyN<true> (m_askQtys, bestIdx, m_HAI, a_depth);
+      return Qty<QT,QR>(QR(ds.m_qty));
+    }
+    // Generic Case: Sparse and Hybrid OrderBooks:
+    Qty<QT,QR> res;
+    Traverse<IsBid>
+    (
+      a_depth,
+      [&res](int, PriceT, OBEntry const& a_obe) -> bool
+      {
+        res += a_obe.GetAggrQty<QT,QR>();
+        return true;
+      }
+    );
+    return res;
+  }
+
+  //=========================================================================//
+  // "GetNextPx":                                                            //
+  //=========================================================================//
+  template<bool IsBid>
+  inline PriceT OrderBook::GetNextPx(PriceT a_px) const
+  {
+    if (utxx::unlikely(!IsFinite(a_px)))
+      return PriceT();
+
+    int    bestIdx = IsBid ? m_BBI  : m_BAI;
+    PriceT bestPx  = IsBid ? m_BBPx : m_BAPx;
+
+    if (!m_isSparse)
+    {
+      //---------------------------------------------------------------------//
+      // Dense OrderBook: Vectorised scan of the SoA Qtys:                   //
+      //---------------------------------------------------------------------//
+      if (utxx::unlikely(bestIdx < 0))
+        return PriceT();
+
+      // The slot to start from: the one next to "a_px" (if "a_px" is above the
+      // Bids L1 or below the Asks L1, start from the L1):
+      double pxStep = m_instr->m_PxStep;
+      int    s      = bestIdx + GetPxStepMultiple<true>(a_px - bestPx);
+      s             =
+        IsBid ? std::min(s - 1, bestIdx) : std::max(s + 1, bestIdx);
+
+      if (utxx::unlikely(( IsBid && s < m_LBI) || (!IsBid && s > m_HAI)))
+        return PriceT();
+
+      s = IsBid
+          ? SIMD::FindPos<false>(m_bidQtys, s, m_LBI)
+          : SIMD::FindPos<true> (m_askQtys, s, m_HAI);
+      return
+        utxx::likely(s >= 0)
+        ? bestPx + double(s - bestIdx) * pxStep
+        : PriceT();
+    }
+    if (!m_isHybrid)
+    {
+      //---------------------------------------------------------------------//
+      // Sparse OrderBook: Ordered Map look-up:                              //
+      //---------------------------------------------------------------------//
+      auto const& sideMap = GetSideMap<IsBid>();
+      auto        it      = sideMap.upper_bound(a_px);
+      return (it != sideMap.end()) ? it->first : PriceT();
+    }
+    //-----------------------------------------------------------------------//
+    // Hybrid OrderBook: Traversal:                                          //
+    //-----------------------------------------------------------------------//
+    PriceT res;
+    Traverse<IsBid>
+    (
+      0,
+      [a_px, &res](int, PriceT a_lvl_px, OBEntry const&) -> bool
+      {
+        if ((IsBid && a_lvl_px < a_px) || (!IsBid && a_lvl_px > a_px))
+        {
+          res = a_lvl_px;
+          return false;
+        }
+        return true;
+      }
+    );
+    return res;
+  }
+
   //=========================================================================//
   // "GetVWAP1" and "GetDeepestPx":                                          //
   //=========================================================================//
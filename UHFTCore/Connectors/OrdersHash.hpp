@@ -0,0 +1,336 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "Connectors/OrdersHash.hpp":                       //
+//     Open-Addressing Hash Table of Pooled Order Nodes (for OrdersLogs)     //
+//===========================================================================//
+// Used instead of a flat array indexed by OrderID when the OrderIDs are not
+// contiguous (eg 64-bit exchange-assigned IDs):
+// (*) The table consists of cache-line-sized Buckets of "BucketSz" (OrderID,
+//     Node*) slots each; probing is linear over Buckets, so a typical lookup
+//     touches 1 cache line of the table (plus the Node itself);
+// (*) OrderID=0 marks an empty slot, and "Tomb" a deleted one. Deleted slots
+//     are re-used on insertion, and are purged by re-building the table (into
+//     a pre-allocated spare one) once they accumulate;
+// (*) Nodes come from a pre-allocated pool; free Nodes are linked via their
+//     "m_next" flds, so no memory allocation occurs after construction;
+// (*) Removal of Nodes is DEFERRED: "Retire"d OrderIDs go into a FIFO of
+//     "a_retire_lag" entries, and are only removed when they fall out of it
+//     (and the Caller-provided predicate confirms that they are still dead).
+//     This is because a deleted Order may still be referenced shortly after
+//     (eg by a Trade following the OrdersLog Delete).
+// "Node" requirements: Default Ctor which makes an empty Node, and a "Node*"
+// fld "m_next" (free while the Node is not in use):
+//
+#pragma  once
+
+#include "Basis/BaseTypes.hpp"
+#include <utxx/compiler_hints.hpp>
+#include <utxx/error.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <cstring>
+#include <cassert>
+
+namespace MAQUETTE
+{
+  //=========================================================================//
+  // "OrdersHash" Class:                                                     //
+  //=========================================================================//
+  template<typename Node>
+  class OrdersHash: public boost::noncopyable
+  {
+  private:
+    //-----------------------------------------------------------------------//
+    // Buckets:                                                              //
+    //-----------------------------------------------------------------------//
+    constexpr static int     BucketSz = 4;
+    constexpr static OrderID Tomb     = ~OrderID(0);
+
+    struct alignas(64) Bucket
+    {
+      OrderID m_keys [BucketSz];  // 0: empty, Tomb: deleted
+      Node*   m_nodes[BucketSz];
+    };
+    static_assert(sizeof(Bucket) == 64, "OrdersHash::Bucket: Size?");
+
+    //-----------------------------------------------------------------------//
+    // Data Flds:                                                            //
+    //-----------------------------------------------------------------------//
+    long       m_poolSz;     // Total number of Nodes (live + retired)
+    long       m_nBuckets;   // Power of 2
+    int        m_shift;      // 64 - log2(m_nBuckets)
+    Bucket*    m_buckets;
+    Bucket*    m_spare;      // For purging Tombs
+    Node*      m_pool;
+    Node*      m_freeList;
+    long       m_nUsed;      // Slots with live or retired Nodes
+    long       m_nTombs;
+    long       m_maxFull;    // Limit on (m_nUsed + m_nTombs)
+    OrderID*   m_retired;    // FIFO ring of retired OrderIDs
+    long       m_retLag;     // Its capacity
+    long       m_retHead;    // Oldest entry
+    long       m_retN;       // Number of entries
+
+    //-----------------------------------------------------------------------//
+    // "Home": Initial Bucket for the given OrderID:                         //
+    //-----------------------------------------------------------------------//
+    // Fibonacci hashing: OrderIDs are often sequential (or nearly so), so the
+    // high bits of the product are used:
+    //
+    long Home(OrderID a_id) const
+      { return long((a_id * 0x9E3779B97F4A7C15UL) >> m_shift); }
+
+    //-----------------------------------------------------------------------//
+    // "Locate": Finds the slot of an existing OrderID:                      //
+    //-----------------------------------------------------------------------//
+    // Returns "false" if not found. Terminates because at least 1/4 of all
+    // slots are always empty:
+    //
+    bool Locate(OrderID a_id, Bucket** a_bucket, int* a_j) const
+    {
+      assert(a_id != 0 && a_id != Tomb);
+      for (long b = Home(a_id); ; b = (b + 1) & (m_nBuckets - 1))
+      {
+        Bucket* bk = m_buckets + b;
+        for (int j = 0; j < BucketSz; ++j)
+        {
+          OrderID k = bk->m_keys[j];
+          if (k == a_id)
+          {
+            *a_bucket = bk;
+            *a_j      = j;
+            return true;
+          }
+          if (k == 0)
+            return false;
+        }
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Purge": Re-builds the table without Tombs:                           //
+    //-----------------------------------------------------------------------//
+    void Purge()
+    {
+      memset(m_spare, '\0', size_t(m_nBuckets) * sizeof(Bucket));
+
+      for (long b = 0; b < m_nBuckets; ++b)
+      for (int  j = 0; j < BucketSz;   ++j)
+      {
+        OrderID k = m_buckets[b].m_keys[j];
+        if (k == 0 || k == Tomb)
+          continue;
+        // Re-insert (k, node) into the 1st empty slot in "m_spare":
+        for (long c = Home(k); ; c = (c + 1) & (m_nBuckets - 1))
+        {
+          Bucket* bk = m_spare + c;
+          int     i  = 0;
+          while (i < BucketSz && bk->m_keys[i] != 0)
+            ++i;
+          if (i < BucketSz)
+          {
+            bk->m_keys [i] = k;
+            bk->m_nodes[i] = m_buckets[b].m_nodes[j];
+            break;
+          }
+        }
+      }
+      std::swap(m_buckets, m_spare);
+      m_nTombs = 0;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Erase": Removes an existing slot, and returns its Node to the pool:  //
+    //-----------------------------------------------------------------------//
+    void Erase(Bucket* a_bucket, int a_j)
+    {
+      Node* node = a_bucket->m_nodes[a_j];
+      assert(node != nullptr);
+
+      a_bucket->m_keys [a_j] = Tomb;
+      a_bucket->m_nodes[a_j] = nullptr;
+      --m_nUsed;
+      ++m_nTombs;
+
+      *node        = Node();
+      node->m_next = m_freeList;
+      m_freeList   = node;
+
+      if (utxx::unlikely(m_nUsed + m_nTombs > m_maxFull))
+        Purge();
+    }
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Non-Default Ctor, Dtor:                                               //
+    //-----------------------------------------------------------------------//
+    // "a_max_orders" is the max number of simultaneously-live Orders (NOT the
+    // total number of Orders over the session):
+    //
+    OrdersHash(long a_max_orders, long a_retire_lag)
+    : m_poolSz  (a_max_orders + a_retire_lag),
+      m_nBuckets(1),
+      m_shift   (64),
+      m_buckets (nullptr),
+      m_spare   (nullptr),
+      m_pool    (nullptr),
+      m_freeList(nullptr),
+      m_nUsed   (0),
+      m_nTombs  (0),
+      m_maxFull (0),
+      m_retired (nullptr),
+      m_retLag  (a_retire_lag),
+      m_retHead (0),
+      m_retN    (0)
+    {
+      if (utxx::unlikely(a_max_orders <= 0 || a_retire_lag <= 0))
+        throw utxx::badarg_error("OrdersHash::Ctor: Invalid param(s)");
+
+      // Load factor of at most 1/2 in live and retired Nodes, and at most 3/4
+      // incl the Tombs:
+      while (m_nBuckets * BucketSz < 2 * m_poolSz)
+      {
+        m_nBuckets *= 2;
+        --m_shift;
+      }
+      m_maxFull = 3 * m_nBuckets * BucketSz / 4;
+
+      m_buckets = new Bucket [size_t(m_nBuckets)];
+      m_spare   = new Bucket [size_t(m_nBuckets)];
+      m_pool    = new Node   [size_t(m_poolSz)];
+      m_retired = new OrderID[size_t(m_retLag)];
+      Clear();
+    }
+
+    ~OrdersHash() noexcept
+    {
+      delete[] m_buckets;
+      delete[] m_spare;
+      delete[] m_pool;
+      delete[] m_retired;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Clear": Removes all Nodes:                                           //
+    //-----------------------------------------------------------------------//
+    void Clear()
+    {
+      memset(m_buckets, '\0', size_t(m_nBuckets) * sizeof(Bucket));
+      m_freeList = nullptr;
+      for (long i = m_poolSz - 1; i >= 0; --i)
+      {
+        m_pool[i]        = Node();
+        m_pool[i].m_next = m_freeList;
+        m_freeList       = m_pool + i;
+      }
+      m_nUsed   = 0;
+      m_nTombs  = 0;
+      m_retHead = 0;
+      m_retN    = 0;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Find": Returns NULL if not found:                                    //
+    //-----------------------------------------------------------------------//
+    Node* Find(OrderID a_id) const
+    {
+      Bucket* bk = nullptr;
+      int     j  = 0;
+      return Locate(a_id, &bk, &j) ? bk->m_nodes[j] : nullptr;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "FindOrInsert":                                                       //
+    //-----------------------------------------------------------------------//
+    // Returns the existing Node for "a_id", or a new empty one installed for
+    // it; returns NULL if the pool is exhausted:
+    //
+    Node* FindOrInsert(OrderID a_id)
+    {
+      assert(a_id != 0 && a_id != Tomb);
+      Bucket* tombBk = nullptr;
+      int     tombJ  = 0;
+
+      for (long b = Home(a_id); ; b = (b + 1) & (m_nBuckets - 1))
+      {
+        Bucket* bk = m_buckets + b;
+        for (int j = 0; j < BucketSz; ++j)
+        {
+          OrderID k = bk->m_keys[j];
+          if (utxx::likely(k == a_id))
+            return bk->m_nodes[j];
+
+          if (k == Tomb && tombBk == nullptr)
+          {
+            tombBk = bk;
+            tombJ  = j;
+          }
+          else
+          if (k == 0)
+          {
+            // Not found: Take a Node from the pool, and install it in the 1st
+            // Tomb encountered (if any), or in this empty slot:
+            Node* node = m_freeList;
+            if (utxx::unlikely(node == nullptr))
+              return nullptr;
+            m_freeList   = node->m_next;
+            node->m_next = nullptr;
+
+            if (tombBk != nullptr)
+            {
+              bk = tombBk;
+              j  = tombJ;
+              --m_nTombs;
+            }
+            bk->m_keys [j] = a_id;
+            bk->m_nodes[j] = node;
+            ++m_nUsed;
+            // NB: The Purge threshold cannot be exceeded here, as the number
+            // of used slots is bounded by the pool size
+            return node;
+          }
+        }
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Retire": Schedules a deferred removal of "a_id":                     //
+    //-----------------------------------------------------------------------//
+    // When the OrderID falls out of the FIFO, it is removed iff it still ex-
+    // ists and "a_is_dead(Node const*)" returns "true" for it (ie the Order
+    // was not re-used in the meantime):
+    //
+    template<typename IsDead>
+    void Retire(OrderID a_id, IsDead const& a_is_dead)
+    {
+      if (utxx::likely(m_retN == m_retLag))
+      {
+        OrderID old = m_retired[m_retHead];
+        m_retHead   = (m_retHead + 1 == m_retLag) ? 0 : (m_retHead + 1);
+        --m_retN;
+
+        Bucket* bk = nullptr;
+        int     j  = 0;
+        if (Locate(old, &bk, &j) && a_is_dead(bk->m_nodes[j]))
+          Erase(bk, j);
+      }
+      long tail = m_retHead + m_retN;
+      m_retired[(tail >= m_retLag) ? (tail - m_retLag) : tail] = a_id;
+      ++m_retN;
+    }
+
+    //-----------------------------------------------------------------------//
+    // Accessors (mostly for monitoring):                                    //
+    //-----------------------------------------------------------------------//
+    long GetPoolSize() const { return m_poolSz; }
+    long GetNUsed()    const { return m_nUsed;  }
+
+    // Total memory allocated (in bytes):
+    size_t GetMemSize() const
+    {
+      return sizeof(OrdersHash)                             +
+             2 * size_t(m_nBuckets) * sizeof(Bucket)        +
+             size_t(m_poolSz)       * sizeof(Node)          +
+             size_t(m_retLag)       * sizeof(OrderID);
+    }
+  };
+} // End namespace MAQUETTE
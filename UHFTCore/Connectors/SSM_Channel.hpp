@@ -112,36 +112,13 @@ namespace MAQUETTE
         return;
       }
       // Construct the Handlers:
-      // NB: We have to use Lambdas for "recvH" and "errH" below,  rather than
-      // to implement corresp "operator()"s  in "SSM_Channel" itself  and pass
-      // "*this" to "std::function" ctors,  because in the former  case,  only
-      // "this" ptr needs to be captured; in the latter case, the whole object
-      // would need to be copied into "std::function" -- and  we can't do that,
-      // obviously:
+      // NB: They are static-dispatch Thunks (only "this" ptr is stored, and the
+      // Derived class methods are invoked directly, w/o "std::function"):
       //
-      // Recv  Handler function -- a wrapper around "RecvHandler" method to be
-      // provided by the "Derived" class; "FromAddr" is ignored at this point:
-      //
-      IO::FDInfo::RecvHandler recvH
-      (
-        [this](int a_fd,     char const* a_buff,    int a_size,
-               utxx::time_val a_ts_recv, IO::IUAddr const*) ->bool
-        {
-          return (static_cast<Derived*>(this))->
-                 RecvHandler(a_fd, a_buff, a_size, a_ts_recv);
-        }
-      );
-      // Error Handler function -- a wrapper around "ErrHandler" method to be
-      // provided by the "Derived" class:
-      IO::FDInfo::ErrHandler  errH
-      (
-        [this](int a_fd, int a_err_code, uint32_t a_events, char const* a_msg)
-        -> void
-        {
-          (static_cast<Derived*>(this))->
-            ErrHandler(a_fd, a_err_code, a_events, a_msg);
-        }
-      );
+      IO::FDInfo::RecvHandler recvH =
+        IO::MkThunk<&SSM_Channel::OnRecv> (this);
+      IO::FDInfo::ErrHandler  errH  =
+        IO::MkThunk<&SSM_Channel::OnError>(this);
 
       // Open and bind the UDP socket, and attach it to the Reactor:
       // Because this is UDP, we don't need a large input buffer size  -- the
@@ -158,7 +135,8 @@ namespace MAQUETTE
         0,       // No writing into UDP SSM socket, so WriteBuffSz  = 0
         0,       //                                and WriteBuffLWM = 0
         nullptr, // No remote IP/Port to connect to (no sending)
-        -1
+        -1,
+        m_config.m_recvBatch        // 0: one "recvmsg" per DataGram
       );
       assert(m_fd >= 0);
 
@@ -204,5 +182,35 @@ namespace MAQUETTE
         "SSM_Channel::Stop: Name={}, FD={}: Stopped", m_longName, m_fd)
       m_fd = -1;
     }
+
+  private:
+    //=======================================================================//
+    // Call-Backs for "EPollReactor":                                        //
+    //=======================================================================//
+    // Recv  Handler -- a wrapper around "RecvHandler" method to be provided by
+    // the "Derived" class; "FromAddr" is ignored at this point:
+    //
+    bool OnRecv
+    (
+      int               a_fd,
+      char const*       a_buff,
+      int               a_size,
+      utxx::time_val    a_ts_recv,
+      IO::IUAddr const* UNUSED_PARAM(a_from)
+    )
+    {
+      return (static_cast<Derived*>(this))->
+             RecvHandler(a_fd, a_buff, a_size, a_ts_recv);
+    }
+
+    // Error Handler -- a wrapper around "ErrHandler" method to be provided by
+    // the "Derived" class:
+    //
+    void OnError
+      (int a_fd, int a_err_code, uint32_t a_events, char const* a_msg)
+    {
+      (static_cast<Derived*>(this))->
+        ErrHandler(a_fd, a_err_code, a_events, a_msg);
+    }
   };
 } // End namespace MAQUETTE
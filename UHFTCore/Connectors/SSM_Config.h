@@ -20,6 +20,9 @@ namespace MAQUETTE
     std::string   m_sourceIP;  // SSM Source IP;  use "" for ordinary MCast
     std::string   m_localIP;   // Local IP   to bind to (may  be empty)
     int           m_localPort; // Local port (MUST be valid 
+    // If > 0, use "recvmmsg" with this batch size. Set from the "RecvBatch"
+    // MDC param (default 0: 1 "recvmsg" per DataGram):
+    int           m_recvBatch;
 
     //----------------------------------------------------------------------//
     // Non-Default Ctor: Normally, LocalIP is not given at this point:      //
@@ -33,7 +36,8 @@ namespace MAQUETTE
     : m_groupIP   (a_group_ip),
       m_sourceIP  (a_source_ip),
       m_localIP   (""),
-      m_localPort (a_local_port)
+      m_localPort (a_local_port),
+      m_recvBatch (0)
     {}
   };
 } // End namespace MAQUETTE
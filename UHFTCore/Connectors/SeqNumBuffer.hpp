@@ -5,7 +5,16 @@
 //===========================================================================//
 // Provides proper sequencing of Items coming from 1 or more  Data Channles,
 // possibly out-of-order (as may happen eg for UDP data feeds). Valid range
-// of "SeqNum"s is assumed to be 1..+oo:
+// of "SeqNum"s is assumed to be 1..+oo.
+// Implementation:
+// (*) Items are stored in a Ring of a power-of-2 size, at the index (SeqNum &
+//     Mask); the Ring covers the window [XSN .. XSN + Capacity - 1], where XSN
+//     is the next Expected SeqNum;
+// (*) occupied slots are marked in a presence BitMap, so the end of the cont-
+//     iguous run starting at XSN (and the next occupied slot after a gap) is
+//     found with "tzcnt" over 64-bit words, rather than by slot-by-slot scans;
+// (*) there is no data movement on gap recovery; slots are re-used as the
+//     window moves forward:
 //
 #pragma once
 
@@ -15,7 +24,11 @@
 #include <utxx/time_val.hpp>
 #include <spdlog/spdlog.h>
 #include <boost/core/noncopyable.hpp>
+#include <type_traits>
+#include <algorithm>
 #include <utility>
+#include <cstdint>
+#include <cstring>
 #include <cassert>
 
 namespace MAQUETTE
@@ -23,46 +36,133 @@ namespace MAQUETTE
   //=========================================================================//
   // "SeqNumBuffer" Class:                                                   //
   //=========================================================================//
+  // The "Processor" must provide the per-Item call-back:
+  //   (SeqNum sn, T const& item, bool init_mode,
+  //    utxx::time_val ts_recv, utxx::time_val ts_handl) -> void
+  // and MAY also provide a batch one, which then gets all Items of a contig-
+  // uous run of SeqNums (sn0, sn0+1, ...) at once, instead of one call per
+  // Item:
+  //   (SeqNum sn0,  int n,   T const* items, bool init_mode,
+  //    utxx::time_val const* ts_recvs, utxx::time_val const* ts_handls)->void
+  // NB: A run which wraps around the end of the Ring is delivered in 2 calls:
+  //
   template
   <
     typename T,         // Type of msgs being buffered
     typename Emplacer,  // (T* place)->void
-    typename Processor  // (SeqNum sn, T const& item, bool init_mode)->void
+    typename Processor  // See above
   >
   class SeqNumBuffer: public boost::noncopyable
   {
   private:
     //=======================================================================//
-    // "BuffEntry" Type:                                                     //
+    // Consts:                                                               //
     //=======================================================================//
-    // Each Buffer Entry is actually an object of type "T" along with its Seq-
-    // Num and TimeStamps:
-    struct BuffEntry
-    {
-      SeqNum          m_sn;
-      T               m_item;
-      utxx::time_val  m_recvTS;
-      utxx::time_val  m_handlTS;
-    };
+    constexpr static bool HasBatchProcessor =
+      std::is_invocable_v
+      <Processor&, SeqNum, int, T const*, bool,
+       utxx::time_val const*, utxx::time_val const*>;
 
     //=======================================================================//
     // Data Flds:                                                            //
     //=======================================================================//
-    BuffEntry*        m_data;       // The actual storage
-    int               m_capacity;   // Total size of "m_data" array above
+    // The Ring is stored as Structure-of-Arrays, so that a contiguous run of
+    // Items can be passed to a batch Processor directly:
+    T*                m_items;      // Indexed by (SeqNum & m_mask)
+    utxx::time_val*   m_recvTSs;    // ditto
+    utxx::time_val*   m_handlTSs;   // ditto
+    uint64_t*         m_bits;       // Presence BitMap: bit (SeqNum & m_mask)
+    int               m_capacity;   // Power of 2, >= 64
+    int               m_mask;       // (m_capacity - 1)
     int const         m_maxGap;
     Processor*        m_processor;  // Ptr NOT owned
     spdlog::logger*   m_logger;     // Ptr NOT owned
     int               m_debugLevel;
 
-    mutable int       m_bi;         // BeginIndex of curr window (0 if empty)
-    mutable int       m_ei;         // EndIndex   of curr window (NOT incl)
     mutable SeqNum    m_xsn;        // Expected next SeqNum
+    mutable int       m_nBuffd;     // Number of Items currently in the Ring
     mutable bool      m_initMode;   // Init Mode
 
     // Default Ctor is deleted:
     SeqNumBuffer() =  delete;
 
+    //=======================================================================//
+    // Ring and BitMap Helpers:                                              //
+    //=======================================================================//
+    int  Slot (SeqNum a_sn) const { return int(a_sn & SeqNum(m_mask)); }
+
+    bool IsSet(int a_i)     const
+      { return (m_bits[a_i >> 6] >> (a_i & 63)) & 1UL; }
+
+    void Set  (int a_i)           { m_bits[a_i >> 6] |= (1UL << (a_i & 63)); }
+
+    //-----------------------------------------------------------------------//
+    // "RunLength":                                                          //
+    //-----------------------------------------------------------------------//
+    // Number of consecutive occupied slots starting from (occupied) "a_from",
+    // possibly wrapping around the end of the Ring:
+    //
+    int RunLength(int a_from) const
+    {
+      assert(IsSet(a_from));
+      int n = 0;
+      for (int i = a_from; n < m_nBuffd; )
+      {
+        // "inv" has 1s at empty slots, and also at the positions shifted in
+        // above the word end, so "ctz" is at most (64 - b) unless b == 0 and
+        // the whole word is occupied:
+        int      b   = i & 63;
+        uint64_t inv = ~(m_bits[i >> 6] >> b);
+        int      k   = (inv == 0) ? 64 : __builtin_ctzl(inv);
+        n += k;
+        if (b + k < 64)
+          break;        // The run has ended within this word
+        i = (i + k) & m_mask;
+      }
+      return std::min(n, m_nBuffd);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "NextSet":                                                            //
+    //-----------------------------------------------------------------------//
+    // The first occupied slot at or after "a_from" (wrapping around); the Ring
+    // must be non-empty:
+    //
+    int NextSet(int a_from) const
+    {
+      assert(m_nBuffd > 0);
+      for (int i = a_from; ; i = ((i | 63) + 1) & m_mask)
+      {
+        uint64_t w = m_bits[i >> 6] >> (i & 63);
+        if (w != 0)
+          return i + __builtin_ctzl(w);
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // "ClearRange":                                                         //
+    //-----------------------------------------------------------------------//
+    // Clears "a_n" (<= m_capacity) slots starting from "a_from" (wrapping ar-
+    // ound), and returns the number of them which were occupied:
+    //
+    int ClearRange(int a_from, int a_n)
+    {
+      assert(0 <= a_n && a_n <= m_capacity);
+      int cleared = 0;
+      for (int i = a_from; a_n > 0; )
+      {
+        int      b    = i & 63;
+        int      k    = std::min(a_n, 64 - b);
+        uint64_t mask = (k == 64) ? ~0UL : (((1UL << k) - 1) << b);
+        uint64_t& w   = m_bits[i >> 6];
+        cleared += __builtin_popcountl(w & mask);
+        w       &= ~mask;
+        i        = (i + k) & m_mask;
+        a_n     -= k;
+      }
+      return cleared;
+    }
+
   public:
     //=======================================================================//
     // Non-Default Ctor:                                                     //
@@ -76,7 +176,9 @@ namespace MAQUETTE
     // (*) Otherwise, there is no Init Mode -- all gaps are managed in the stan-
     //     dard way (ie gaps > "a_max_gap" will always mean data loss).
     // (*) This could also be achieved via a bool template param, but the advan-
-    //     tages of that solution appear to be very minimal:
+    //     tages of that solution appear to be very minimal.
+    // (*) "a_capacity" is rounded up to a power of 2 (and to at least 64); all
+    //     gaps (even in the Init Mode) are limited by the resulting Capacity:
     //
     SeqNumBuffer
     (
@@ -87,27 +189,37 @@ namespace MAQUETTE
       int             a_debug_level,
       bool            a_init_mode
     )
-    : m_data      (new BuffEntry[size_t(a_capacity)]),
-      m_capacity  (a_capacity),
+    : m_items     (nullptr),
+      m_recvTSs   (nullptr),
+      m_handlTSs  (nullptr),
+      m_bits      (nullptr),
+      m_capacity  (64),
+      m_mask      (63),
       m_maxGap    (a_max_gap),
       m_processor (a_processor),
       m_logger    (a_logger),
       m_debugLevel(a_debug_level),
-      m_bi        (0),
-      m_ei        (0),
       m_xsn       (-1),    // NB: Don't use 0 which is valid in Init Mode
+      m_nBuffd    (0),
       m_initMode  (a_init_mode)
     {
       CHECK_ONLY
       (
         if (utxx::unlikely
-            (m_capacity <= 0 || m_processor == nullptr) || m_logger == nullptr)
+           (a_capacity <= 0 || a_capacity > (1 << 30) ||
+            m_processor == nullptr || m_logger == nullptr))
           throw utxx::badarg_error("SeqNumBuffer::Ctor");
       )
-      // NB: For extra safety, explicitly initialise all "SeqNum"s in "m_data"
-      // to (-1), not even to 0:
-      for (int i = 0; i < m_capacity; ++i)
-        m_data[i].m_sn = -1;
+      while (m_capacity < a_capacity)
+        m_capacity *= 2;
+      m_mask = m_capacity - 1;
+
+      int nWords = m_capacity / 64;
+      m_items    = new T             [size_t(m_capacity)];
+      m_recvTSs  = new utxx::time_val[size_t(m_capacity)];
+      m_handlTSs = new utxx::time_val[size_t(m_capacity)];
+      m_bits     = new uint64_t      [size_t(nWords)];
+      memset(m_bits, '\0', size_t(nWords) * sizeof(uint64_t));
     }
 
     //=======================================================================//
@@ -115,17 +227,19 @@ namespace MAQUETTE
     //=======================================================================//
     ~SeqNumBuffer() noexcept
     {
-      if (m_data != nullptr)
-      {
-        delete[] m_data;
-        m_data = nullptr;
-      }
+      delete[] m_items;
+      delete[] m_recvTSs;
+      delete[] m_handlTSs;
+      delete[] m_bits;
+      m_items     = nullptr;
+      m_recvTSs   = nullptr;
+      m_handlTSs  = nullptr;
+      m_bits      = nullptr;
       m_capacity  = 0;
       // m_maxGap is a "const", cannot reset it
       m_processor = nullptr;
-      m_bi        = 0;
-      m_ei        = 0;
       m_xsn       = -1;
+      m_nBuffd    = 0;
       m_initMode  = false;    // Does not really matter
     }
 
@@ -149,8 +263,7 @@ namespace MAQUETTE
                 ("SeqNumBuffer::CloseInitMode: Invalid LowestSnapShotSN=",
                  a_sn);
       )
-      // If the Buffer is currently non-empty (contains a non-empty window):
-      if (utxx::likely(m_ei > 0))
+      if (utxx::likely(m_xsn >= 0))
       {
         // (*) Purge any Items with with SeqNum <= a_sn (ie up to and including
         //     the earliest SnapShot available) from the Buffer, since they will
@@ -162,54 +275,32 @@ namespace MAQUETTE
         //     mal "Put" -- we have an explicit check preventing that. It could
         //     only be closed by this method:
         //
-        assert(m_bi == 0   && m_ei >= 2 && m_data[0].m_sn == -1 &&
-               m_data[m_ei-1].m_sn >  0 && m_xsn >= 0);
+        assert(m_nBuffd == 0 || !IsSet(Slot(m_xsn)));
 
         // Thus, the new XSN will be:
         SeqNum newXSN = std::max<SeqNum>(m_xsn, a_sn) + 1;
         assert(newXSN > 0);
 
-        // The number of obsolete items to be purged (will be at least 1, which
-        // corresponds to an empty slot in front, which would never be filled in
-        // a normal way):
-        int     purgeCount = int(newXSN - m_xsn);
-        assert (purgeCount > 0);
-
-        // Purging outdated Items is incrementing "m_bi" AND re-setting the slot
-        // "SeqNum"s:
-        {
-          BuffEntry*       curr = m_data;
-          BuffEntry const* end  = curr  + purgeCount;
-          while (curr < end)
-          {
-            curr->m_sn = -1;    // For [m_bi], it is (-1) already anyway: empty
-            ++curr;
-          }
-        }
-        m_bi = purgeCount;
-
-        // But the Buffer could have become completely empty as a result; then
-        // reset it properly:
-        if (m_bi >= m_ei)
-          m_bi = m_ei = 0;
+        // Purge the obsolete Items (the whole Ring if the XSN moves beyond it):
+        SeqNum purgeCount = std::min<SeqNum>(newXSN - m_xsn, m_capacity);
+        assert(purgeCount > 0);
+        m_nBuffd -= ClearRange(Slot(m_xsn), int(purgeCount));
+        assert(m_nBuffd >= 0);
 
         // Can now actually set the new Expected SeqNum:
         m_xsn  = newXSN;
-        assert(m_xsn > 0);
 
         // Furthermore, if we got a congiguous window as a result of moving XSN
         // forward, it needs to be processed; this would increase "m_xsn" furt-
         // her:
-        if (m_data[m_bi].m_sn != -1)
-          // In particular, then the SeqNum @ [m_bi] must be equal to "m_xsn"
-          // (verified by the the following method):
+        if (m_nBuffd > 0 && IsSet(Slot(m_xsn)))
           SafeProcessContiguous();
       }
       else
       {
         // The Buffer was empty: No Items were received before the SnapShot
         // arrived:
-        assert(m_bi == 0 && m_ei == 0 && m_xsn == -1);
+        assert(m_nBuffd == 0);
         m_xsn = a_sn + 1;
       }
 
@@ -220,49 +311,39 @@ namespace MAQUETTE
     }
 
     //=======================================================================//
-    // "GetExpectedSeqNum":                                                  //
+    // Accessors:                                                            //
     //=======================================================================//
-    // This is for information only:
-    SeqNum GetExpectedSeqNum() const
-      { return m_xsn; }
+    // These are for information only:
+    SeqNum GetExpectedSeqNum() const { return m_xsn;      }
+    int    GetCapacity()       const { return m_capacity; }
+    int    GetNBuffered()      const { return m_nBuffd;   }
 
+  private:
     //=======================================================================//
     // Safe "Emplace" operation -- exceptions are caught:                    //
     //=======================================================================//
+    // Does not mark the slot as occupied -- it is up to the Caller:
+    //
     void SafeEmplace
     (
       Emplacer*       a_emplacer,
       SeqNum          a_sn,
       utxx::time_val  a_ts_recv,
       utxx::time_val  a_ts_handl,
-      int             a_pos
+      int             a_slot
     )
     {
-      // The window can be empty, or non-empty (in which case it has length of
-      // at least 2);
-      // XXX: the pre-cond of this method is that in the worst case, "a_pos"
-      // could be @ "m_ei";   if it happened to be beyond that, "m_ei" would
-      // first be corrected by the Caller:
-      assert((m_bi == 0 && m_ei == 0     && a_pos == 0)                     ||
-             (0 <= m_bi && m_bi <= a_pos && a_pos <= m_ei && m_bi <= m_ei-2 &&
-              m_ei <= m_capacity         && a_pos <  m_capacity));
-
-      // NB: The "a_pos" must always be clear (SeqNum==-1); "m_xsn" may be 0 in
-      // a rare case in the Init Mode:
-      BuffEntry& targ = m_data[a_pos];   // XXX: Ref!
-
       // The target slot must be empty at this point:
-      assert(a_emplacer != nullptr && a_sn  >  0 && a_sn >= m_xsn &&
-             targ.m_sn  == -1      && m_xsn >= 0);
+      assert(a_emplacer != nullptr && a_sn >  0 && a_sn >= m_xsn &&
+             a_sn - m_xsn < m_capacity && a_slot == Slot(a_sn)   &&
+             !IsSet(a_slot));
 
-      // Mark this slot as occupied (even if the Emplacer below fails):
-      targ.m_sn      = a_sn;
-      targ.m_recvTS  = a_ts_recv;
-      targ.m_handlTS = a_ts_handl;
+      m_recvTSs [a_slot] = a_ts_recv;
+      m_handlTSs[a_slot] = a_ts_handl;
       try
       {
         // Actually invoke the Emplacer: It installs the actual Data Item:
-        (*a_emplacer)(&(targ.m_item));
+        (*a_emplacer)(m_items + a_slot);
       }
       catch (std::exception const& exc)
       {
@@ -271,85 +352,128 @@ namespace MAQUETTE
         // exception; but this situation, over-all, is extremely unlikely, so we
         // do not handle it specifically:
         LOG_ERROR(2,
-          "SeqNumBuffer::SafeEmplace: Emplacement of SN={} (XSN={}) @ Pos={} "
-          "failed: {}", a_sn, m_xsn, a_pos, exc.what())
-      }
-      // IMPORTANT: The window is extended if we emplaced the Item @ "m_ei":
-      if (a_pos == m_ei)
-      {
-        ++m_ei;
-        assert(m_ei <= m_capacity);
+          "SeqNumBuffer::SafeEmplace: Emplacement of SN={} (XSN={}) @ Slot={} "
+          "failed: {}", a_sn, m_xsn, a_slot, exc.what())
       }
     }
 
     //=======================================================================//
-    // Safe "Process" operation -- exceptions are caught:                    //
+    // "SafeProcessSpan": Processes "a_n" Items from "a_slot" on (no wrap):  //
     //=======================================================================//
-    void SafeProcessContiguous()
+    void SafeProcessSpan(SeqNum a_sn0, int a_slot, int a_n)
     {
-      // NB:
-      // (*) At the point when this method is invoked, the window invariant is
-      //     "broken": the window starts from a non-empty slot @ "m_bi",  and
-      //     has a minimum length of 1 (not 2);
-      // (*) "m_ei" is still BEYOND the last item of the window, so the window
-      //     length is (m_si - m_bi) as  usual;
-      // (*) While "m_xsn" may (very unlikely) be 0 in "SafeEmplace", it is al-
-      //     ways > 0 here:
-      assert(m_xsn > 0 && m_bi <= m_ei-1 &&
-             m_data[m_bi].m_sn == m_xsn  && m_data[m_ei-1].m_sn > 0);
-
-      // We process all contiguous pending Items and increase "m_xsn" while do-
-      // ing so:
-      while (m_bi < m_ei)
-      {
-        // The "curr" Item, if non-empty, must correspond to "m_xsn". The 1st
-        // Item to be processed must always be non-empty  (hence "do-while"),
-        // since "Process" is invoked after an "Emplace" @ "m_xsn":
-        BuffEntry* curr    = m_data + m_bi;
-        SeqNum     curr_sn = curr->m_sn;
-
-        if (curr_sn == -1)
-          // The contiguous chunk has ended:
-          break;
-
-        // Otherwise, go ahead. At the beginning of the window, there should be
-        // an item with a valid SeqNum, same as the expected value (m_xsn > 0);
-        // in particular, "curr_sn" cannot be 0:
-        assert(curr_sn == m_xsn);
+      assert(a_n > 0 && a_slot + a_n <= m_capacity && a_sn0 > 0);
 
+      if constexpr (HasBatchProcessor)
+      {
+        // All Items are deemed to be done, even if the batch call throws:
+        try
+        {
+          (*m_processor)
+            (a_sn0, a_n, m_items + a_slot, m_initMode,
+             m_recvTSs + a_slot,  m_handlTSs + a_slot);
+        }
+        catch (std::exception const& exc)
+        {
+          LOG_ERROR(2,
+            "SeqNumBuffer::SafeProcessSpan: Processing of SNs={}..{} failed: "
+            "{}", a_sn0, a_sn0 + a_n - 1, exc.what())
+        }
+      }
+      else
+      for (int k = 0; k < a_n; ++k)
+      {
         // Actually invoke the Processor. Invocation of all in-depth call-backs
         // occurs HERE:
+        int i = a_slot + k;
         try
         {
           (*m_processor)
-            (curr->m_sn,     curr->m_item,  m_initMode,
-             curr->m_recvTS, curr->m_handlTS);
+            (a_sn0 + k,     m_items[i], m_initMode,
+             m_recvTSs[i],  m_handlTSs[i]);
         }
         catch (std::exception const& exc)
         {
           LOG_ERROR(2,
-            "SeqNumBuffer::SafeProcessContiguous: Processing of SN={} failed: "
-            "{}", m_xsn, exc.what())
+            "SeqNumBuffer::SafeProcessSpan: Processing of SN={} failed: {}",
+            a_sn0 + k, exc.what())
         }
-        // Successfully processed or otherwise, the Item is deemed to be done;
-        // NOW we increment the next Expected SeqNum and clean-up the slot:
-        curr->m_sn = -1;
-        ++m_bi;
-        ++m_xsn;
       }
+    }
 
-      // IMPORTANT: If the window becomes empty at the end (ie we have completed
-      // the above loop to the end), reset in properly:
-      if (utxx::likely(m_bi >= m_ei))
-        m_bi = m_ei = 0;
+    //=======================================================================//
+    // "SafeProcessContiguous":                                              //
+    //=======================================================================//
+    // Processes all contiguous buffered Items starting from "m_xsn" (which must
+    // be present), and moves "m_xsn" beyond them:
+    //
+    void SafeProcessContiguous()
+    {
+      assert(m_xsn > 0 && m_nBuffd > 0 && IsSet(Slot(m_xsn)));
+
+      int from = Slot(m_xsn);
+      int n    = RunLength(from);
+      assert(0 < n && n <= m_nBuffd);
+
+      // Successfully processed or otherwise, the Items are deemed to be done,
+      // so the slots are released before the processing:
+      DEBUG_ONLY(int cleared =) ClearRange(from, n);
+      assert(cleared == n);
+
+      // The run may wrap around the end of the Ring:
+      int    n1  = std::min(n, m_capacity - from);
+      SeqNum sn0 = m_xsn;
+      m_xsn     += n;
+      m_nBuffd  -= n;
+
+      SafeProcessSpan(sn0, from, n1);
+      if (utxx::unlikely(n1 < n))
+        SafeProcessSpan(sn0 + n1, 0, n - n1);
+    }
 
-      // NB: The above logic works correctly, in particular, in the most typi-
-      // cal case when the Buffer was originally empty (no window),  then we
-      // emplaced an expected Item @ m_bi==0  (and did NOT increment "m_ei"),
-      // and then called "SafeProcessContguous" -- processing will be done and
-      // the Buffer will remain empty.
+    //=======================================================================//
+    // "Recover":                                                            //
+    //=======================================================================//
+    // This method is invoked when we encountered a too large gap (perhaps, so-
+    // me SeqNum was lost forever), before placing "a_sn":
+    // (*) If the Buffer is non-empty, the Items missing at the beginning of the
+    //     window are declared lost, and the following contiguous run is proc-
+    //     essed; this may need to be repeated (by the Caller) until "a_sn" fits
+    //     in the window;
+    // (*) If the Buffer is empty, all Items up to "a_sn" are declared lost, so
+    //     that "a_sn" becomes the Expected SeqNum (or the artificial gap just
+    //     below it is created, in the Init Mode):
+    //
+    void Recover(SeqNum a_sn)
+    {
+      assert(m_xsn >= 0 && a_sn > m_xsn);  // From the Caller condition
+
+      SeqNum lost_from = m_xsn;
+      SeqNum newXSN    =
+        (m_nBuffd == 0)
+        ? (m_initMode ? (a_sn - 1) : a_sn)
+        : (m_xsn + ((NextSet(Slot(m_xsn)) - Slot(m_xsn)) & m_mask));
+      assert(newXSN >= m_xsn);
+
+      if (newXSN > lost_from)
+        LOG_WARN(2,
+          "SeqNumBuffer::Recover: SeqNum(s)={}..{} are LOST FOREVER ({} items "
+          "altogether): MaxGap={}, ArgSN={}, Capacity={}",
+          lost_from, newXSN - 1, newXSN - lost_from, m_maxGap, a_sn,
+          m_capacity)
+
+      m_xsn = newXSN;
+
+      // Process the remaining Items (while contiguous); this can increase "m_
+      // xsn" further, and can make the Buffer empty:
+      if (m_nBuffd > 0)
+      {
+        assert(m_xsn > 0);
+        SafeProcessContiguous();
+      }
     }
 
+  public:
     //=======================================================================//
     // "Put":                                                                //
     //=======================================================================//
@@ -361,7 +485,7 @@ namespace MAQUETTE
     // but this can only be done if the Buffer is currently empty, and NOT in
     // the InitMode.
     // Returns "true" iff the msg with the given "a_sn" has actually been put
-    // into the Buffer.
+    // into the Buffer (ie it was neither out-dated nor a duplicate).
     //
     bool Put
     (
@@ -382,23 +506,9 @@ namespace MAQUETTE
         if (utxx::unlikely(a_sn <= 0))
           throw utxx::badarg_error("SeqNumBuffer::Put: Invalid SeqNum=", a_sn);
       )
-      // Check the following invariants:
-      // (*) either the Buffer is empty (m_bi==m_ei==0),
-      // (*) or it has a valid window open within it, starting  from an empty
-      //     slot and ending with a non-empty one (@ (m_ei-1)), so the minimum
-      //     window size is 2:
-      // (*) In the Init Mode, "m_xsn" may (very unlikely) be 0 here with a
-      //     non-empty buffer:
-      //
-      CHECK_ONLY(bool isEmpty = (m_bi == 0 && m_ei == 0);)
-
-      assert(isEmpty                                                      ||
-             (0 <= m_bi && m_bi <= m_ei - 2    &&  m_ei <= m_capacity     &&
-             m_xsn >= 0 && m_data[m_ei-1].m_sn == (m_xsn + m_ei - m_bi -1)));
-
-      // So in any case, the slot @ "m_bi" is empty (corresponds to "m_xsn"
-      // which is expected but has not arrived yet):
-      assert(m_data[m_bi].m_sn == -1);
+      // Invariant: the slot @ "m_xsn" is always empty (it is expected but has
+      // not arrived yet), otherwise it would have been processed:
+      assert(m_nBuffd == 0 || (m_xsn >= 0 && !IsSet(Slot(m_xsn))));
 
       //---------------------------------------------------------------------//
       // Special Case (New Explicit XSN to create a Gap Window)?             //
@@ -411,11 +521,11 @@ namespace MAQUETTE
         //
         CHECK_ONLY
         (
-          if (utxx::unlikely(!isEmpty || a_xsn < m_xsn || m_initMode))
+          if (utxx::unlikely(m_nBuffd != 0 || a_xsn < m_xsn || m_initMode))
             throw utxx::badarg_error
-                  ("SeqNumBuffer::Put: Cannot set NewXSN=", a_xsn, ": BI=",
-                   m_bi,  ", EI=",  m_ei,  ", IsEmpty=",    isEmpty,
-                   ", CurrXSN=",    m_xsn, ", InitMode=",   m_initMode);
+                  ("SeqNumBuffer::Put: Cannot set NewXSN=", a_xsn,
+                   ": NBuffered=",  m_nBuffd, ", CurrXSN=", m_xsn,
+                   ", InitMode=",   m_initMode);
         )
         // Then simply set the new XSN and proceed normally:
         m_xsn = a_xsn;
@@ -427,12 +537,8 @@ namespace MAQUETTE
       if (utxx::unlikely(m_xsn == -1))
       {
         // This can only happen if the Buffer was empty and has never received
-        // any Items yet -- otherwise, we would know the next SeqNum we are wa-
-        // iting for (incl 0, which is an artificial wait target which will ne-
-        // ver arrive, of course).
-        // NB: The converse is of course NOT true -- the Buffer can be empty but
-        // XSN may be non-trivial (awaiting a next Item):
-        assert(isEmpty);
+        // any Items yet:
+        assert(m_nBuffd == 0);
 
         // Then initialise "m_xsn":
         // (*) If the Init Mode is set, then we must  NOT start processing  the
@@ -462,283 +568,70 @@ namespace MAQUETTE
         // (*) If we are in the Init Mode, DO NOT ALLOW the artificially-created
         //     gap to be filled by a "Put" with (a_sn == m_xsn); only   "Close-
         //     InitMode" (presumably invoked upon receiving full SnapShots) can
-        //     do that. So reject this Item; this will NOT result in any data
-        //     loss, because the slot @ "m_xsn" was created artificially, below
-        //     the 1st real SeqNum, so that Item would eventually be  discarded
-        //     anyway:
+        //     do that:
         return false;
 
-      // At this point, "m_xsn" is always >= 0 (and >= 1 unless it's a very
-      // rare case in the Init Mode):
       assert((m_initMode && m_xsn == 0)     || m_xsn > 0);
-
-      // And the invariant regarding "a_sn" and "m_xsn": At this point, a_sn >=
-      // m_xsn,  and the equality is only possible if we are NOT in the Init
-      // Mode:
       assert((!m_initMode && m_xsn == a_sn) || m_xsn < a_sn);
 
       //---------------------------------------------------------------------//
       // In most cases, "a_sn" we got is the expected one:                   //
       //---------------------------------------------------------------------//
+      int slot = Slot(a_sn);
+
       if (utxx::likely(a_sn == m_xsn))
       {
         assert(!m_initMode);
+        SafeEmplace(a_emplacer, a_sn, a_ts_recv, a_ts_handl, slot);
 
-        // No matter whether the Buffer is empty or not, the Item with an  exp-
-        // ected SeqNum is placed at beginning of the curr window; for an empty
-        // Buffer, it would be m_data[0].m_item.
-        // NB:
-        // (*) For the sake of uniformity, the next expected SeqNum ("m_xsn") is
-        //     incremented NOT now (when the curr expected Item was emplaced),
-        //     but when an Item is processed (below); "m_xsn" may be incremented
-        //     more than once if there are buffered Items.
-        // (*) "m_bi" and "m_ei" are not affected by Item emplacement IFF it was
-        //     at the Expected SeqNum:
-        //
-        SafeEmplace(a_emplacer, a_sn, a_ts_recv, a_ts_handl, m_bi);
-
-        // Now process the new Item (and subsequent contiguous ones):
-        // When we added a new Item at the beginning of the window (at "m_bi"),
-        // a contiguous chunk of non-0 SeqNums could have been formed, so  we
-        // need to process all of them. While doing so, "m_xsn" (which is the
-        // next SeqNum we will be expecting) is incremented each time:
-        //
-        assert(m_xsn > 0);   // Because it's same as "a_sn", so can "Process":
-        SafeProcessContiguous();
-
-        // All done:
-        return true;
-      }
-
-      //---------------------------------------------------------------------//
-      // Otherwise: Not the expected SeqNum:                                 //
-      //---------------------------------------------------------------------//
-      // It can only be that the received SeqNum is larger than the expected
-      // one, eg we experienced a gap in "SeqNums":
-      int    gap = int(a_sn - m_xsn);
-      assert(gap >= 1);
-
-      // Index at which the incoming Item will be placed (if otherwise OK):
-      int pos = m_bi + gap;
-      assert(m_bi < pos);
-
-      // It may either fall within an existing window, or beyond it; check if
-      // it can be emplaced at all; BUT "m_maxGap" is ineffective in the Init
-      // Mode:
-      //---------------------------------------------------------------------//
-      // No valid "pos" to emplace the Item? Do "Recover" and try again:     //
-      //---------------------------------------------------------------------//
-      // XXX: In the InitMode, we allow for an unlimited artificial gap -- but
-      // what happens if a real gap is encountered then???
-      //
-      if (utxx::unlikely((!m_initMode && gap > m_maxGap) || pos >= m_capacity))
-      {
-        // NB: In particular, in this case, "a_sn" cannot be a repeated SeqNum
-        // -- simply because it did not fit in the current Buffer (so its pre-
-        // vious incarnation could not be there either):
-        //
-        if (utxx::likely(Recover(pos)))
+        if (utxx::likely(m_nBuffd == 0))
         {
-          // The Buffer, empty or otherwise, is now available from the begin-
-          // ning:
-          assert(m_bi == 0);
-
-          // AND TRY AGAIN RECURSIVELY!
-          // XXX: How to control recursive depth here? Is infinite recursion
-          // possible?
-          // Also note that now a_xsn=-1: We do NOT modify XSN anymore:
-          //
-          return Put(a_emplacer, a_sn, a_ts_recv, a_ts_handl, -1);
+          // The most common case: Nothing is buffered, so process this Item
+          // right away, without touching the BitMap:
+          ++m_xsn;
+          SafeProcessSpan(a_sn, slot, 1);
         }
         else
         {
-          // Could not find the space for the new Item -- probably the gap was
-          // too large. Drop it with an error msg:
-          LOG_ERROR(2,
-            "SeqNumBuffer::Put: No room for ArgSN={}: XSN={}, Gap={}",
-            a_sn, m_xsn, gap)
-          return false;
+          // A contiguous run of buffered Items could have been formed, so we
+          // need to process all of them:
+          Set(slot);
+          ++m_nBuffd;
+          SafeProcessContiguous();
         }
-        // This point is NOT REACHABLE:
-        __builtin_unreachable();
+        return true;
       }
 
       //---------------------------------------------------------------------//
-      // Not the expected SeqNum, but Window is OK (empty or otherwise):     //
+      // Otherwise: Not the expected SeqNum:                                 //
       //---------------------------------------------------------------------//
-      if (pos < m_ei)
-      {
-        //-------------------------------------------------------------------//
-        // Emplacement "pos" is within an already-existing window:           //
-        //-------------------------------------------------------------------//
-        // It will be placed @ pos = m_bi + gap, but only if there is no previ-
-        // ous incarnation of "a_sn" there:
-        //
-        assert(pos < m_capacity);
+      // It can only be that the received SeqNum is larger than the expected
+      // one, eg we experienced a gap in "SeqNums". It must fit in the Ring, and
+      // "m_maxGap" is ineffective in the Init Mode:
+      SeqNum gap = a_sn - m_xsn;
+      assert(gap >= 1);
 
-        if (m_data[pos].m_sn == -1)
-          SafeEmplace(a_emplacer, a_sn, a_ts_recv, a_ts_handl, pos);
-      }
-      else
+      if (utxx::unlikely((!m_initMode && gap > m_maxGap) || gap >= m_capacity))
       {
-        //-------------------------------------------------------------------//
-        // Create a new window (if Buffer is empty) or extend existing one:  //
-        //-------------------------------------------------------------------//
-        assert(0 <= m_bi && m_bi <= m_ei && m_ei <= pos && pos < m_capacity);
-        // But gap == pos - m_bi > 0  strictly; ie gap >= 1
-        // In particular,   m_bi == m_ei is possible if the curr window (and
-        // Buffer as a whole) are empty
-
-        // We will emplace the new Item @ "pos", so "m_ei" will be moved bey-
-        // ond that. NB: all cells involved must be empty:
-        DEBUG_ONLY(
-        for (int i = m_ei; i <= pos; ++i)
-          assert(m_data[i].m_sn == -1);
-        )
-        // We need to move "m_ei" first, as a pre-condition of "SafeEmplace":
-        m_ei = pos + 1;
-
-        // So the window size is indeed >= 2:
-        // size = m_ei - m_bi = (pos + 1) - m_bi = (pos - m_bi) + 1 = gap + 1
-        //     >= 2:
-        assert(m_ei - m_bi >= 2);
-
-        // XXX: Because the window is extended, the destination slot MUST NOT
-        // be marked with a non-0 SeqNum ("SafeEmplace" will check that),  so
-        // there is no previous incarnation of "a_sn" in this case:
-        SafeEmplace(a_emplacer, a_sn, a_ts_recv, a_ts_handl, pos);
+        // NB: In particular, in this case, "a_sn" cannot be a repeated SeqNum
+        // -- simply because it did not fit in the current window (so its pre-
+        // vious incarnation could not be there either).
+        // "Recover" always moves "m_xsn" forward, so after a finite number of
+        // re-tries, "a_sn" will fit in (also note that now a_xsn=-1: We do NOT
+        // modify XSN anymore):
+        Recover(a_sn);
+        return Put(a_emplacer, a_sn, a_ts_recv, a_ts_handl, -1);
       }
 
-      // But cannot do any processing yet -- the window begins with an empty
-      // slot:
-      assert(m_data[m_bi].m_sn == -1);
-
-      // Still, "Put" had succeded:
-      return true;
-    }
-
-    //=======================================================================//
-    // "Recover":                                                            //
-    //=======================================================================//
-    // This method is invoked when we encountered a too large gap (perhaps, so-
-    // me SeqNum was lost forever -- XXX: is there any other scenario with non-
-    // closing windows?)
-    // Returns "true" iff the recovery has succeeded, and the Buffer is usable
-    // again:
-    //
-    bool Recover(int a_pos)
-    {
-      assert(m_xsn >= 0);  // From the Caller condition
-
-      //---------------------------------------------------------------------//
-      // How many SeqNums will be declared lost?                             //
-      //---------------------------------------------------------------------//
-      // First of all, all Items which are still missing at the beginning of
-      // the window, will be declared permanently lost. There would be at least
-      // 1 such Item, otherwise we would not get into Recover at all:
-      int lost_count = 0;
-      for (; m_bi < m_ei && m_data[m_bi].m_sn == -1; ++m_bi, ++lost_count);
-
-      if (utxx::unlikely(lost_count == 0))
-      {
-        // How could this be possible? If we had (m_bi < m_ei) at least once
-        // above, then, for that initial slot, SeqNum must have been -1,  so
-        // "lost_count" would be incremented at least to 1. Thus, the Buffer
-        // was actually 0, but we got into "Recover" because the gap was too
-        // large. In this case,  there is nothing we can do --  the incoming
-        // Item wil have to be dropped:
-        assert(m_bi == m_ei && m_ei == 0);
+      // Within the window. Don't overwrite a previous incarnation of "a_sn":
+      if (utxx::unlikely(IsSet(slot)))
         return false;
-      }
-
-      //---------------------------------------------------------------------//
-      // Expell the "lost slots" from the window front:                      //
-      //---------------------------------------------------------------------//
-      // Otherwise: The following items will be declared "lost forever", so
-      // the Buffer could be moved forward:
-      SeqNum lost_from  = m_xsn;
-      SeqNum lost_upto  = m_xsn + lost_count - 1;
-      assert(lost_from <= lost_upto);
-
-      LOG_WARN(2,
-        "SeqNumBuffer::Recover: SeqNum(s)={}..{} are LOST FOREVER ({} items "
-        "altogether): MaxGap={}, Pos={}, Capacity={}",
-        lost_from, lost_upto, lost_count, m_maxGap, a_pos, m_capacity)
-
-      // Move the expected SeqNum ("m_xsn") forward:
-      m_xsn += lost_count;
-
-      // Because we had lost_count >= 1, then m_xsn >= 1 as well (even if it
-      // was 0 originally):
-      assert(m_xsn > 0);
-
-      // NB: It is possible (though unlikely) that the Buffer is now empty
-      // (after "m_bi" was incremented).   No need to explicitly clear the
-      // SeqNums here -- other way round, we got "lost_count" on the basis
-      // that those cells were clear!
-      if (utxx::unlikely(m_bi >= m_ei))
-      {
-        m_bi = m_ei = 0;
-        return true;     // It's OK to use the Buffer again!
-      }
 
-      //---------------------------------------------------------------------//
-      // Process the remaining Items (while contiguous):                     //
-      //---------------------------------------------------------------------//
-      // Otherwise, run the Processor on remaining Items -- this can increase
-      // "m_xsn" further, and again, can make the Buffer empty:
-      // NB: The window is inconsistent at the moment -- starting from a non-
-      //     empty cell; this is what "Process" expects;
-      assert(m_xsn > 0 && m_data[m_bi].m_sn == m_xsn);
-      SafeProcessContiguous();
+      SafeEmplace(a_emplacer, a_sn, a_ts_recv, a_ts_handl, slot);
+      Set(slot);
+      ++m_nBuffd;
 
-      //---------------------------------------------------------------------//
-      // If the Buffer is still non-empty:                                   //
-      //---------------------------------------------------------------------//
-      // XXX: Move the remainig window to the beginning of the Buffer (it was
-      // definitely NOT at the beginning at this moment, since some positions
-      // have been freed up in front side). This move may be VERY EXPENSIVE:
-      //
-      if (m_ei != 0)
-      {
-        // There is still a valid remaining Window in the Buffer, that's why
-        // "Process" has stopped:
-        assert(0 < m_bi && m_bi + 2 <= m_ei && m_ei <= m_capacity      &&
-              m_data[m_bi].m_sn == -1       && m_data[m_ei-1].m_sn != -1);
-
-        // The length to be moved (remember that "m_ei" is BEYOND the Window);
-        // because a Window consists of at least 1 empty Item (in [m_bi]) and
-        // 1 non-empty Item (in [m_ei-1]), its length is at least 2:
-        int    wlen = m_ei - m_bi;
-        assert(wlen >= 2);
-
-        // Now do the actual move: m_bi --> 0:
-        for (int i = 0; i < wlen; ++i)
-        {
-          // NB: "src" is not "const" because it will be cleared:
-          BuffEntry& src = m_data[m_bi + i];
-          BuffEntry& dst = m_data[i];
-
-          // If all logic is correct, "dst" must be clear at the moment:
-          assert(dst.m_sn == -1);
-
-          if (src.m_sn == -1)
-            // Nothing to move (can happen for some intermediate empty slots);
-            // in particular, this happens for i==0:
-            continue;
-
-          // Otherwise: Do move (copy, and clear the "src"):
-          dst = src;
-          src.m_sn = -1;
-
-          // [i] (previously [m_bi+i]) must now have the SeqNum = m_xsn+i >= 1:
-          assert(dst.m_sn == m_xsn + i);
-        }
-
-        // Move "m_bi" and "m_ei" to the beginning:
-        m_bi = 0;
-        m_ei = wlen;
-      }
+      // But cannot do any processing yet -- the slot @ "m_xsn" is empty:
       return true;
     }
   };
@@ -197,8 +197,18 @@ namespace MAQUETTE
     // Handlers for EPollReactor (except ReadHandler):                       //
     //=======================================================================//
     // NB: ReadHandler is highly Protocol-specific, so it is provided by the
-    // "Derived" class:
+    // "Derived" class; "OnRead" is a wrapper around it which also maintains
+    // the Rx stats. All of them are registered with the Reactor as Thunks,
+    // so "DER::ReadHandler" is invoked via a direct (inlinable) call:
     //
+    int  OnRead
+    (
+      int            a_fd,
+      char const*    a_buff,
+      int            a_size,
+      utxx::time_val a_ts_recv
+    );
+
     void ConnectHandler(int a_fd);
 
     void ErrHandler
@@ -185,40 +185,18 @@ namespace MAQUETTE
     // Create the Handlers:                                                  //
     //-----------------------------------------------------------------------//
     // The Reactor will, in particular, create dynamic buffers to handle Stream
-    // IO on this Socket:
+    // IO on this Socket. All Handlers are static-dispatch Thunks:
     // ReadHandler: Its actual body is provided by the Derived class:
-    IO::FDInfo::ReadHandler    readH
-    (
-      [this](int a_fd, char const* a_buff, int a_size,
-             utxx::time_val a_ts_recv) ->  int
-      {
-        int consumed = DER::ReadHandler(a_fd, a_buff, a_size, a_ts_recv);
-
-        // Update the Rx stats:
-        if (utxx::likely(consumed > 0))
-        {
-          // Per-session stats:
-          m_bytesRx += size_t(consumed);
-          m_lastRxTS = a_ts_recv;
+    IO::FDInfo::ReadHandler    readH =
+      IO::MkThunk<&TCP_Connector::OnRead>(this);
 
-          // And a separate set of stats which may be maintained by the Derived
-          // class (eg in ShM):
-          DER::UpdateRxStats(consumed, a_ts_recv);
-        }
-        return consumed;
-      }
-    );
     // ConnectHandler:
-    IO::FDInfo::ConnectHandler connH
-      ( [this](int a_fd)->void { this->ConnectHandler(a_fd); });
+    IO::FDInfo::ConnectHandler connH =
+      IO::MkThunk<&TCP_Connector::ConnectHandler>(this);
 
     // ErrHandler:
-    IO::FDInfo::ErrHandler     errH
-    (
-      [this](int a_fd,     int  a_err_code, uint32_t  a_events,
-             char const* a_msg) -> void
-      { this->ErrHandler(a_fd,  a_err_code, a_events, a_msg); }
-    );
+    IO::FDInfo::ErrHandler     errH  =
+      IO::MkThunk<&TCP_Connector::ErrHandler>(this);
 
     //-----------------------------------------------------------------------//
     // Create a TCP Socket and attach it to the Reactor:                     //
@@ -389,6 +367,34 @@ namespace MAQUETTE
     // Derived::Stop -> TCPC::Stop -> Derived::StopNow -> TCPC::DisConnect
   }
 
+  //=========================================================================//
+  // "OnRead":                                                               //
+  //=========================================================================//
+  template<typename Derived>
+  inline int TCP_Connector<Derived>::OnRead
+  (
+    int            a_fd,
+    char const*    a_buff,
+    int            a_size,
+    utxx::time_val a_ts_recv
+  )
+  {
+    int consumed = DER::ReadHandler(a_fd, a_buff, a_size, a_ts_recv);
+
+    // Update the Rx stats:
+    if (utxx::likely(consumed > 0))
+    {
+      // Per-session stats:
+      m_bytesRx += size_t(consumed);
+      m_lastRxTS = a_ts_recv;
+
+      // And a separate set of stats which may be maintained by the Derived
+      // class (eg in ShM):
+      DER::UpdateRxStats(consumed, a_ts_recv);
+    }
+    return consumed;
+  }
+
   //=========================================================================//
   // "ConnectHandler":                                                       //
   //=========================================================================//
@@ -512,16 +518,12 @@ namespace MAQUETTE
     assert(m_timerFD == -1);
 
     // TimerHandler:
-    IO::FDInfo::TimerHandler timerH
-      ([this](int a_fd)->void   { this->TimerHandler (a_fd); });
+    IO::FDInfo::TimerHandler timerH =
+      IO::MkThunk<&TCP_Connector::TimerHandler>(this);
 
     // ErrHandler:
-    IO::FDInfo::ErrHandler errH
-    (
-      [this](int a_fd,   int   a_err_code, uint32_t  a_events,
-             char const* a_msg) -> void
-      { this->ErrHandler(a_fd, a_err_code, a_events, a_msg); }
-    );
+    IO::FDInfo::ErrHandler   errH   =
+      IO::MkThunk<&TCP_Connector::ErrHandler>(this);
 
     // Create a new Timer as requested, and add it to the Reactor:
     m_timerFD = DER::m_reactor->AddTimer
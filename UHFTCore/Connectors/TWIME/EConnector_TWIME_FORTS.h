@@ -17,7 +17,8 @@ namespace MAQUETTE
   //=========================================================================//
   class EConnector_TWIME_FORTS final:
     public EConnector_OrdMgmt,
-    public TCP_Connector<EConnector_TWIME_FORTS>
+    public TCP_Connector<EConnector_TWIME_FORTS>,
+    public OMCNative    <EConnector_TWIME_FORTS>
   {
   private:
     //=======================================================================//
@@ -26,6 +27,7 @@ namespace MAQUETTE
     using  TCPC = TCP_Connector<EConnector_TWIME_FORTS>;
     friend class  TCP_Connector<EConnector_TWIME_FORTS>;
     friend class  EConnector_OrdMgmt;
+    friend class  OMCNative    <EConnector_TWIME_FORTS>;
 
   public:
     //-----------------------------------------------------------------------//
@@ -246,6 +248,27 @@ namespace MAQUETTE
     override;
 
   private:
+    //-----------------------------------------------------------------------//
+    // "CheckNewOrderParams" -- Checks shared by "NewOrder{,N}":             //
+    //-----------------------------------------------------------------------//
+    static void CheckNewOrderParams
+    (
+      char const*         a_where,
+      FIX::OrderTypeT     a_ord_type,
+      PriceT              a_px,
+      QtyAny              a_qty,
+      FIX::TimeInForceT   a_time_in_force,
+      QtyAny              a_qty_show,
+      QtyAny              a_qty_min
+    );
+
+    //-----------------------------------------------------------------------//
+    // "CheckNewOrderN" -- Call-Back from "OMCNative::NewOrderN":            //
+    //-----------------------------------------------------------------------//
+    // Same checks as in "NewOrder" above, for the "OrderDesc" (Checked Mode):
+    //
+    static void CheckNewOrderN(OrderDesc<QT,QR> const& a_od);
+
     //-----------------------------------------------------------------------//
     // "NewOrderImpl" -- Call-Back from "EConnector_OrdMgmt":                //
     //-----------------------------------------------------------------------//
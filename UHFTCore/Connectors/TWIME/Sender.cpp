@@ -209,30 +209,9 @@ namespace MAQUETTE
     (
       assert(a_strategy != nullptr);
 
-      // Only Limit Orders are supported, so the Px must be finite:
-      if (utxx::unlikely
-         (a_ord_type != FIX::OrderTypeT::Limit) || !IsFinite(a_px))
-        throw utxx::badarg_error
-              ("EConnector_TWIME_FORTS::NewOrder: Must be a Limit Order");
-
-      // Check the Qty. Advanced Qty Modes are not supported (XXX QtyMin=0 means
-      // no minimum):
-      if (utxx::unlikely
-         (! (IsPos(a_qty) && (IsPosInf(a_qty_show) || a_qty_show == a_qty) &&
-            IsZero(a_qty_min))))
-        throw utxx::badarg_error
-              ("EConnector_TWIME_FORTS::NewOrder: Invalid/UnSupported Qtys"
-               ": Qty=", QR(a_qty), ", QtyShow=", QR(a_qty_show),  ", QtyMin=",
-               QR(a_qty_min));
-
-      // Only the following TimeInForce vals are supported (as we have Limit
-      // orders only):
-      if (utxx::unlikely
-         (a_time_in_force != FIX::TimeInForceT::Day           &&
-          a_time_in_force != FIX::TimeInForceT::ImmedOrCancel &&
-          a_time_in_force != FIX::TimeInForceT::FillOrKill))
-        throw utxx::badarg_error
-              ("EConnector_TWIME_FORTS::NewOrder: UnSupported TimeInForce");
+      CheckNewOrderParams
+        ("NewOrder", a_ord_type, a_px, a_qty, a_time_in_force, a_qty_show,
+         a_qty_min);
 
       // Pegged Orders are NOT supported in TWIME of course:
       if (utxx::unlikely(IsFinite(a_peg_offset)))
@@ -258,6 +237,60 @@ namespace MAQUETTE
     );
   }
 
+  //=========================================================================//
+  // "CheckNewOrderParams":                                                  //
+  //=========================================================================//
+  // The TWIME-specific constraints on NewOrder params, shared by "NewOrder" and
+  // "CheckNewOrderN"; "a_where" is the Caller name used in error msgs:
+  //
+  void EConnector_TWIME_FORTS::CheckNewOrderParams
+  (
+    char const*         a_where,
+    FIX::OrderTypeT     a_ord_type,
+    PriceT              a_px,
+    QtyAny              a_qty,
+    FIX::TimeInForceT   a_time_in_force,
+    QtyAny              a_qty_show,
+    QtyAny              a_qty_min
+  )
+  {
+    // Only Limit Orders are supported, so the Px must be finite:
+    if (utxx::unlikely
+       (a_ord_type != FIX::OrderTypeT::Limit) || !IsFinite(a_px))
+      throw utxx::badarg_error
+            ("EConnector_TWIME_FORTS::", a_where, ": Must be a Limit Order");
+
+    // Check the Qty. Advanced Qty Modes are not supported (XXX QtyMin=0 means
+    // no minimum):
+    if (utxx::unlikely
+       (! (IsPos(a_qty) && (IsPosInf(a_qty_show) || a_qty_show == a_qty) &&
+          IsZero(a_qty_min))))
+      throw utxx::badarg_error
+            ("EConnector_TWIME_FORTS::", a_where, ": Invalid/UnSupported Qtys"
+             ": Qty=", QR(a_qty), ", QtyShow=", QR(a_qty_show),  ", QtyMin=",
+             QR(a_qty_min));
+
+    // Only the following TimeInForce vals are supported (as we have Limit
+    // orders only):
+    if (utxx::unlikely
+       (a_time_in_force != FIX::TimeInForceT::Day           &&
+        a_time_in_force != FIX::TimeInForceT::ImmedOrCancel &&
+        a_time_in_force != FIX::TimeInForceT::FillOrKill))
+      throw utxx::badarg_error
+            ("EConnector_TWIME_FORTS::", a_where, ": UnSupported TimeInForce");
+  }
+
+  //=========================================================================//
+  // "CheckNewOrderN" ("OMCNative" Call-Back):                               //
+  //=========================================================================//
+  void EConnector_TWIME_FORTS::CheckNewOrderN(OrderDesc<QT,QR> const& a_od)
+  {
+    CheckNewOrderParams
+      ("NewOrderN",              a_od.m_ordType,          a_od.m_px,
+       QtyAny(a_od.m_qty),       a_od.m_timeInForce,      QtyAny(a_od.m_qtyShow),
+       QtyAny(a_od.m_qtyMin));
+  }
+
   //=========================================================================//
   // Internal "NewOrderImpl" ("EConnector_OrdMgmt" Call-Back):               //
   //=========================================================================//
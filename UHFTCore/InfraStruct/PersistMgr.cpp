@@ -38,21 +38,8 @@ namespace MAQUETTE
     if (utxx::unlikely(!IsEmpty()))
       throw utxx::badarg_error("PersistMgr::Init(RW): Already Inited");
 
-    // If OK: Create the Full Segm Name (w/ or w/o the CurrDate prefix; by def-
-    // ault, do NOT use it):
-    bool datedSegm =
-      (a_params != nullptr)
-      ? a_params->get<bool>("UseDateInShMSegmName", false)
-      : false;
-
-    string fullName =
-      datedSegm
-      ? (string(GetCurrDateStr()) + "-" + a_name)
-      : a_name;
-
-    // Prepend username to fullName to support multiple users runing MAQUETTE
-    // on the same system:
-    fullName = string(cuserid(nullptr)) + "-" + fullName;
+    // If OK: Create the Full Segm Name:
+    string fullName = MkFullSegmName(a_name, a_params);
 
     // NB: Even if the CurrDate is used in forming the segment name, it is still
     // NOT used in the MapAddr computation -- for invariance;  a_params==NULL is
@@ -84,6 +71,55 @@ namespace MAQUETTE
       fullName, m_mapAddr, m_mapSize)
   }
 
+  //=========================================================================//
+  // "MkFullSegmName":                                                       //
+  //=========================================================================//
+  // The name of the RW segment for "a_name" (w/ or w/o the CurrDate prefix; by
+  // default, do NOT use it):
+  //
+  template<typename ST>
+  string PersistMgr<ST>::MkFullSegmName
+  (
+    string const&                       a_name,
+    boost::property_tree::ptree const*  a_params        // May be NULL
+  )
+  {
+    bool datedSegm =
+      (a_params != nullptr)
+      ? a_params->get<bool>("UseDateInShMSegmName", false)
+      : false;
+
+    string fullName =
+      datedSegm
+      ? (string(GetCurrDateStr()) + "-" + a_name)
+      : a_name;
+
+    // Prepend username to fullName to support multiple users runing MAQUETTE
+    // on the same system:
+    return string(cuserid(nullptr)) + "-" + fullName;
+  }
+
+  //=========================================================================//
+  // "Remove":                                                               //
+  //=========================================================================//
+  template<typename ST>
+  bool   PersistMgr<ST>::Remove
+  (
+    string const&                       a_name,
+    boost::property_tree::ptree const*  a_params        // May be NULL
+  )
+  {
+    if (utxx::unlikely(a_name.empty()))
+      throw utxx::badarg_error("PersistMgr::Remove: Empty Name");
+
+    string fullName = MkFullSegmName(a_name, a_params);
+
+    if constexpr (std::is_same_v<ST, FixedShM>)
+      return BIPC::shared_memory_object::remove(fullName.data());
+    else
+      return BIPC::file_mapping::remove(fullName.data());
+  }
+
   //=========================================================================//
   // "Init" (RO): Opening an Existing Segment:                               //
   //=========================================================================//
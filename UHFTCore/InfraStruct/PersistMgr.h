@@ -178,6 +178,29 @@ namespace MAQUETTE
       unsigned long                      a_base_addr           // 0 is OK
     );
 
+    //=======================================================================//
+    // "Remove" (static method):                                             //
+    //=======================================================================//
+    // Removes the segment which "Init(RW)" with the same args would open or
+    // create. It must not be mapped in this process any more; returns "false"
+    // if there was no such segment:
+    //
+    static bool Remove
+    (
+      std::string                 const& a_name,
+      boost::property_tree::ptree const* a_params               // NULL is OK
+    );
+
+  private:
+    // Full name of the RW segment (with the user name and the optional date
+    // prefix):
+    static std::string MkFullSegmName
+    (
+      std::string                 const& a_name,
+      boost::property_tree::ptree const* a_params               // NULL is OK
+    );
+
+  public:
     //=======================================================================//
     // "FindOrConstruct": ShM Segment Mgmt:                                  //
     //=======================================================================//
@@ -104,8 +104,9 @@ namespace MAQUETTE
     // Read the "AssetRisks" in:                                             //
     //-----------------------------------------------------------------------//
     // This needs to be done first, as subsequently-read "InstrRisks" will dep-
-    // end on the "AssetRisks". The latter should only contain UserID=0 yet:
-    assert(m_assetRisks.size() == 1);
+    // end on the "AssetRisks". The Stores should still be empty (only UserID=0
+    // is there, without any Risks):
+    assert(m_assetRisks.Size() == 0 && m_instrRisks.Size() == 0);
     pqxx::result resAR = txn.exec("SELECT * from " + tabAR);
 
     for (auto const& row: resAR)
@@ -119,18 +120,6 @@ namespace MAQUETTE
       // Get the UserID:
       UserID userID = row["c_user_id"].as<UserID>();
 
-      // Get or create the corresp InnerMap:
-      auto it =  m_assetRisks.find(userID);
-      if  (it == m_assetRisks.end())
-        it = m_assetRisks.insert
-             (make_pair
-               (userID,
-                ARsMapI(ARsMapILessT(),
-                        ARsMapIAlloc(s_pm.GetSegm()->get_segment_manager()))
-             )).first;
-      assert(it != m_assetRisks.end() && it->first == userID);
-      ARsMapI& mapI = it->second;     // Ref!
-
       // Get the Asset Name. Use the LATOKEN-specific AssocList. XXX: We do not
       // even create a map out of it, because "Load*" is a "one-off" operation:
       // Perform a linear search instead:
@@ -155,19 +144,24 @@ namespace MAQUETTE
       // Now create a new "AssetRisks" obj:
       AssetRisks  ar(this, userID, MkSymKey(assetName), settlDate);
 
-      // Insert it into the map:
-      ARsMapIKeyT keyI   = make_pair(ar.m_asset, ar.m_settlDate);
+      // Insert it into the Store (interning the Asset Name):
+      Key16 key;
+      if (utxx::unlikely
+         (!MkARsKey(userID, ar.m_asset, ar.m_settlDate, true, &key)))
+        continue;
 
-      auto insRes = mapI.insert(make_pair(keyI,  ar));
-      if (utxx::unlikely(!insRes.second))
+      AssetRisks* arp =
+        m_assetRisks.Insert
+          (key, userID, make_pair(ar.m_asset, ar.m_settlDate), ar);
+      if (utxx::unlikely(arp == nullptr))
       {
         LOG_ERROR(2, "RiskMgr::LoadLATOKEN: Duplicate Asset={}", assetName)
         continue;
       }
+      m_userIDs.insert(userID);
+
       // If OK: Install other ("mutable") Flds in-place. XXX: There is no value
       // range verification here:
-      assert(insRes.first != mapI.end() && insRes.first->first  == keyI);
-      AssetRisks* arp = &(insRes.first->second);
 
       arp->m_lastEvalRate    = row["c_asset_rfc_rate"    ].as<double>();
       arp->m_ts              =
@@ -196,9 +190,6 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // Read the "InstrRisks" in:                                             //
     //-----------------------------------------------------------------------//
-    // They should only contain UserID==0 at the moment:
-    assert(m_instrRisks.size() == 1);
-
     pqxx::result resIR = txn.exec("SELECT * from " + tabIR);
 
     for (auto const& row: resIR)
@@ -212,18 +203,6 @@ namespace MAQUETTE
       // First, get the UserID:
       UserID userID = row["c_user_id"].as<UserID>();
 
-      // Get or create the corresp InnerMap:
-      auto it =  m_instrRisks.find(userID);
-      if  (it == m_instrRisks.end())
-        it = m_instrRisks.insert
-             (make_pair
-               (userID,
-                IRsMapI(less<SecID>(),
-                        IRsMapIAlloc(s_pm.GetSegm()->get_segment_manager()))
-             )).first;
-      assert(it != m_instrRisks.end() && it->first == userID);
-      IRsMapI& mapI = it->second;     // Ref!
-
       // Get the SecDef:
       SecID          secID = row["c_instr_id"].as<SecID>();
       SecDefD const* instr = a_sdm.FindSecDefOpt (secID);
@@ -263,19 +242,20 @@ namespace MAQUETTE
       //
       InstrRisks ir(this, userID, *instr, nullptr, arA, arB);
 
-      // Install the "InstrRisks" in "mapI":
-      auto insRes = mapI.insert(make_pair(secID, ir));
-      if (utxx::unlikely(!insRes.second))
+      // Install the "InstrRisks" in the Store:
+      InstrRisks* irp =
+        m_instrRisks.Insert(MkIRsKey(userID, secID), userID, secID, ir);
+      if (utxx::unlikely(irp == nullptr))
       {
         LOG_ERROR(2,
           "RiskMgr::LoadLATOKEN: Duplicate SecID={}, Instr={}",
           secID, instr->m_FullName.data())
         continue;
       }
+      m_userIDs.insert(userID);
+
       // If OK: Install other ("mutable") Flds in-place. XXX: There is no value
       // range verification here:
-      assert(insRes.first != mapI.end() && insRes.first->first == secID);
-      InstrRisks* irp = &(insRes.first->second);
 
       // XXX: The latest B/RFC rate is currently not stored in "InstrRisks",
       // but it is available from the corresp "AssetRisks". Do NOT use "GetVal-
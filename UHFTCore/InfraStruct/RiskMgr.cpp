@@ -9,6 +9,7 @@
 #include "Connectors/EConnector_MktData.h"
 #include "Connectors/EConnector_OrdMgmt.h"
 #include <utxx/error.hpp>
+#include <cstring>
 #include <unistd.h>
 
 using namespace std;
@@ -16,9 +17,10 @@ using namespace std;
 namespace MAQUETTE
 {
   //=========================================================================//
-  // "PersistMgr" Obj for the "RiskMgr":                                     //
+  // "PersistMgr" Objs for the "RiskMgr"s:                                   //
   //=========================================================================//
-  PersistMgr<> RiskMgr::s_pm;  // Initially empty
+  map<string, unique_ptr<PersistMgr<>>> RiskMgr::s_pms;  // Initially empty
+  mutex                                 RiskMgr::s_pmsMutex;
 
   //=========================================================================//
   // "RiskMgr" Non-Default Ctor:                                             //
@@ -35,7 +37,8 @@ namespace MAQUETTE
     bool                               a_is_prod,
     boost::property_tree::ptree const& a_prms,
     spdlog::logger*                    a_logger, // May be NULL
-    int                                a_debug_level
+    int                                a_debug_level,
+    FixedShM::segment_manager*         a_segm_mgr
   )
   : m_isProd              (a_is_prod),
     m_RFC                 (MkCcy(a_prms.get<string>("RFC"))),
@@ -43,6 +46,9 @@ namespace MAQUETTE
     m_mode                (RMModeT::Normal),     // Initially; set by "Start"
     m_mdUpdatesPeriodMSec (a_prms.get<int>   ("MDUpdatesPeriodMSec", 0)),
     m_nextMDUpdate        (),                    // Set by "Start"
+    m_rfcReconcilePeriod  (a_prms.get<int>   ("RFCTotalsReconcilePeriod",
+                                              1000)),
+    m_updateStamp         (0),
     //
     // Main Risk and NAV Limits:
     //
@@ -87,28 +93,23 @@ namespace MAQUETTE
     m_irUpdtCB            (nullptr),
     m_arUpdtCB            (nullptr),
     //
-    // "InstrRisks" and "AssetRisks" Maps:
+    // "InstrRisks" and "AssetRisks" Stores:
     //
     m_userIDs             (std::less<UserID>(),
-                           UserIDsAlloc(s_pm.GetSegm()->get_segment_manager())),
-    m_affectedUserIDs     (new   set<UserID>),
-    m_instrRisks          (std::less<UserID>(),
-                           IRsMapAlloc (s_pm.GetSegm()->get_segment_manager())),
-    m_assetRisks          (std::less<UserID>(),
-                           ARsMapAlloc (s_pm.GetSegm()->get_segment_manager())),
+                           UserIDsAlloc(a_segm_mgr)),
+    m_affectedUserIDs     (new   vector<UserID>),
+    m_instrRisks          (a_segm_mgr),
+    m_assetRisks          (a_segm_mgr),
+    m_assetIDs            (),
     m_obirMap             (new OBIRMap),
     m_obarMap             (new OBARMap),
+    m_rfcTotals           (new RFCTotalsIndex),
     //
     // Totals (for each UserID):
     //
-    m_totalRiskRFC        (std::less<UserID>(),
-                           TotalsMapAlloc
-                             (s_pm.GetSegm()->get_segment_manager())),
-    m_totalActiveOrdsSzRFC(std::less<UserID>(),
-                           TotalsMapAlloc
-                             (s_pm.GetSegm()->get_segment_manager())),
-    m_totalNAV_RFC        (std::less<UserID>(),
-                             (s_pm.GetSegm()->get_segment_manager()))
+    m_totalRiskRFC        (std::less<UserID>(), TotalsMapAlloc(a_segm_mgr)),
+    m_totalActiveOrdsSzRFC(std::less<UserID>(), TotalsMapAlloc(a_segm_mgr)),
+    m_totalNAV_RFC        (std::less<UserID>(), TotalsMapAlloc(a_segm_mgr))
   {
     // Verify the Limits (Periods are verified by the utxx::rate_throttler ctor
     // automatically):
@@ -123,54 +124,32 @@ namespace MAQUETTE
         m_VlmLimitRFC3    <= 0))
       throw utxx::badarg_error("RiskMgr::Ctor: Invalid Limit(s)");
 
+    if (utxx::unlikely(m_rfcReconcilePeriod < 0))
+      throw utxx::badarg_error
+            ("RiskMgr::Ctor: Invalid RFCTotalsReconcilePeriod");
+
     // The Logger is required:
     if (utxx::unlikely(m_logger == nullptr))
       throw utxx::badarg_error("RiskMgr::Ctor: Logger is required");
 
-    // UserID=0 is always created (as a "prototype" and a "catch-all" one):
+    // UserID=0 is always created (as a "prototype" and a "catch-all" one);
+    // its "InstrRisks" and "AssetRisks" are created on "Register":
     m_userIDs.insert(0);
 
-    // Install "IRsMapI" and "ARsMapI" for UserID=0, empty as yet:
-    InstallEmptyMaps(0);
-
     // All Done!
   }
 
   //=========================================================================//
-  // "InstallEmptyMaps":                                                     //
+  // "MkObjName":                                                            //
   //=========================================================================//
-  // Install "IRsMapI" and "ARsMapI" for a given UserID, empty as yet:
-  //
-  void RiskMgr::InstallEmptyMaps(UserID a_user_id)
+  string RiskMgr::MkObjName
+    (bool a_is_prod, boost::property_tree::ptree const& a_params)
   {
-    // XXX: For the moment, this method is only invoked for UserID=0:
-    assert(a_user_id == 0);
-
-    // "InstrRisks":
-    auto insResIR =
-      m_instrRisks.insert
-        (make_pair
-          (a_user_id,
-           IRsMapI(less<SecID>(),
-                   IRsMapIAlloc(s_pm.GetSegm()->get_segment_manager()))
-        ));
-    if (utxx::unlikely(!insResIR.second))
-      throw utxx::logic_error
-            ("RiskMgr::InstallEmptyMaps: UserID=", a_user_id,
-             ": InstrRisks insert failed");
-
-    // "AssetRisks":
-    auto insResAR =
-      m_assetRisks.insert
-        (make_pair
-          (a_user_id,
-           ARsMapI(ARsMapILessT(),
-                   ARsMapIAlloc(s_pm.GetSegm()->get_segment_manager()))
-        ));
-    if (utxx::unlikely(!insResAR.second))
-      throw utxx::logic_error
-            ("RiskMgr::InstallEmptyMaps: UserID=", a_user_id,
-             ": AssetRisks insert failed");
+    string prefix   = a_params.get<string>("AccountPfx");
+    string objName  =
+      (prefix.empty() ? "RiskMgr-" : prefix + "-RiskMgr-");
+    objName        += (a_is_prod ? "Prod"   : "Test");
+    return objName;
   }
 
   //=========================================================================//
@@ -191,11 +170,7 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // RiskMgr ShM Obj Name -- depends on the Prod/Test mode:                //
     //-----------------------------------------------------------------------//
-    string prefix   = a_params.get<string>("AccountPfx");
-    string objName  =
-      (prefix.empty() ? "RiskMgr-" : prefix + "-RiskMgr-");
-    objName        += (a_is_prod ? "Prod"   : "Test");
-
+    string objName  = MkObjName(a_is_prod, a_params);
     bool   resetAll = a_params.get<bool>  ("ResetAll",  false);
     size_t segmSz   = a_params.get<size_t>("ShMSegmSzMB") * (1UL << 20);
 
@@ -208,27 +183,48 @@ namespace MAQUETTE
              "must NOT be set together");
 
     //-----------------------------------------------------------------------//
-    // Create the Static Objects (incl the PersistMgr):                      //
+    // Create the Static Objects (incl the PersistMgr of this segment):      //
     //-----------------------------------------------------------------------//
-    if (utxx::likely(s_pm.IsEmpty()))
+    PersistMgr<>* pm = nullptr;
     {
-      if (a_is_observer)
-        s_pm.Init(objName);
-      else
-        // CurrDate is NOT used in RiskMgr segment; the BaseMapAddr is the def-
-        // ault one. Reserve a decent amount of space  for the RiskMgr  which
-        // contains all static risks data structs:
-        //
-        s_pm.Init(objName, nullptr, segmSz);
+      lock_guard<mutex> lock(s_pmsMutex);
+      unique_ptr<PersistMgr<>>& pmp = s_pms[objName];
+      if (utxx::likely(pmp == nullptr))
+      {
+        unique_ptr<PersistMgr<>> newPM(new PersistMgr<>);
+        if (a_is_observer)
+          newPM->Init(objName);
+        else
+          // CurrDate is NOT used in RiskMgr segment unless configured in
+          // "a_params"  (as is the MapAddr; by default, the BaseMapAddr is
+          // used). Reserve a decent amount of space  for the RiskMgr  which
+          // contains all static risks data structs:
+          //
+          newPM->Init(objName, &a_params, segmSz);
+        pmp = std::move(newPM);
+      }
+      pm = pmp.get();
     }
-    assert(!s_pm.IsEmpty());
+    assert(pm != nullptr && !pm->IsEmpty());
 
     //-----------------------------------------------------------------------//
     // Find or construct the "RiskMgr" obj inside the ShM Segment:           //
     //-----------------------------------------------------------------------//
     // NB: Here "res" would initially be NULL if the Segment has just been
     // created:
-    RiskMgr* res = s_pm.GetSegm()->find<RiskMgr>(RiskMgrON()).first;
+    RiskMgr* res = pm->GetSegm()->find<RiskMgr>(RiskMgrON()).first;
+
+    // But if the Segment contains a "RiskMgr" of an older ShM Layout Version
+    // (stored under another name), it cannot be used, and we must not create
+    // another one next to it either:
+    if (res == nullptr)
+      for (auto it  = pm->GetSegm()->named_begin();
+                it != pm->GetSegm()->named_end(); ++it)
+        if (utxx::unlikely(strncmp(it->name(), "RiskMgr", 7) == 0))
+          throw utxx::runtime_error
+                ("RiskMgr::GetPersistInstance: Found ", it->name(), " instead "
+                 "of ", RiskMgrON(), " (old ShM Layout): The ShM segment must "
+                 "be re-created");
 
     if (a_is_observer)
     {
@@ -260,6 +256,8 @@ namespace MAQUETTE
       // apply them -- the existing limits in the "res" obj would remain unch-
       // anged:
       int mdUpdatesPeriodMSec = a_params.get<int>   ("MDUpdatesPeriodMSec", 0);
+      int rfcReconcilePeriod  =
+          a_params.get<int>("RFCTotalsReconcilePeriod", 1000);
 
       double maxTotalRiskRFC  = a_params.get<double>("MaxTotalRisk_RFC");
       double maxNormalRiskRFC = a_params.get<double>("MaxNormalRisk_RFC");
@@ -285,7 +283,8 @@ namespace MAQUETTE
       res->m_omcs.clear();
       res->m_obirMap             = new OBIRMap;
       res->m_obarMap             = new OBARMap;
-      res->m_affectedUserIDs     = new set<UserID>;
+      res->m_rfcTotals           = new RFCTotalsIndex;
+      res->m_affectedUserIDs     = new vector<UserID>;
 
       // XXX: Make the RiskMgr inactive until Start() is invoked explicitly.
       // This only works correctly in the current fully-synchronous setup;
@@ -301,6 +300,8 @@ namespace MAQUETTE
       // new logger in the Conventional Memory:
       //
       res->m_mdUpdatesPeriodMSec = mdUpdatesPeriodMSec;
+      if (utxx::likely(rfcReconcilePeriod >= 0))
+        res->m_rfcReconcilePeriod = rfcReconcilePeriod;
 
       if (utxx::likely(maxTotalRiskRFC  > 0.0))
         res->m_MaxTotalRiskRFC   = maxTotalRiskRFC;
@@ -353,19 +354,18 @@ namespace MAQUETTE
         //-------------------------------------------------------------------//
         // ResetAll requested:                                               //
         //-------------------------------------------------------------------//
-        // Then we clear all UserIDs and Risks, and reset the Totals:
+        // Then we clear all UserIDs, Risks and AssetIDs, and reset the Totals:
         res->m_userIDs             .clear();
-        res->m_instrRisks          .clear();
-        res->m_assetRisks          .clear();
+        res->m_instrRisks          .Clear();
+        res->m_assetRisks          .Clear();
+        res->m_assetIDs            .Clear();
 
         res->m_totalRiskRFC        .clear();
         res->m_totalActiveOrdsSzRFC.clear();
         res->m_totalNAV_RFC        .clear();
 
-        // Again, install UserID=0 and the corresp "IRsMapI" and "ARsMapI" (as
-        // yet empty):
+        // Again, install UserID=0:
         res->m_userIDs.insert(0);
-        res->InstallEmptyMaps(0);
 
         // Reset the Throttlers as well:
         res->m_orderEntryThrottler1.reset();
@@ -394,19 +394,17 @@ namespace MAQUETTE
         //
         // "InstrRisks": Remove dangling OrderBook, Logger etc ptrs, but keep
         // the actual data:
-        for (IRsMapKVT&  irp:  res->m_instrRisks)
-        for (IRsMapIKVT& irpI: irp.second)
+        for (auto& irp: res->m_instrRisks)
         {
-          InstrRisks& ir  = irpI.second;
+          InstrRisks& ir  = irp.second;
           ir.ResetTransient(nullptr);  // NewOrderBook=NULL yet, it's safe
         }
         // "AssetRisks": Update the Logger and remove Asset->RFC Valuators
         // (because they are not ShM-placed, so the ptrs are now dangling):
         //
-        for (ARsMapKVT&  arp:  res->m_assetRisks)
-        for (ARsMapIKVT& arpI: arp.second)
+        for (auto& arp: res->m_assetRisks)
         {
-          AssetRisks& ar  =  arpI.second;
+          AssetRisks& ar  =  arp.second;
           ar.ResetValuator();          // DefaultValuator is installed
         }
         // XXX: Even if the limits have been changed above, we do NOT check here
@@ -419,9 +417,10 @@ namespace MAQUETTE
       //---------------------------------------------------------------------//
       // Need to create a new "RiskMgr" object in ShM:                       //
       //---------------------------------------------------------------------//
-      res = s_pm.GetSegm()->construct<RiskMgr>
+      res = pm->GetSegm()->construct<RiskMgr>
             (RiskMgrON())
-            (a_is_prod, a_params, a_logger, a_debug_level);
+            (a_is_prod, a_params, a_logger, a_debug_level,
+             pm->GetSegm()->get_segment_manager());
       assert(res != nullptr);
 
       // If the DB settings are given in "a_params", load the RiskMgr data from
@@ -433,6 +432,20 @@ namespace MAQUETTE
     return res;
   }
 
+  //=========================================================================//
+  // "RemovePersistInstance":                                                //
+  //=========================================================================//
+  bool RiskMgr::RemovePersistInstance
+    (bool a_is_prod, boost::property_tree::ptree const& a_params)
+  {
+    string objName = MkObjName(a_is_prod, a_params);
+
+    // Un-map the segment first (if it is mapped), as required by "Remove":
+    lock_guard<mutex> lock(s_pmsMutex);
+    s_pms.erase(objName);
+    return PersistMgr<>::Remove(objName, &a_params);
+  }
+
   //=========================================================================//
   // Accessors:                                                              //
   //=========================================================================//
@@ -452,27 +465,25 @@ namespace MAQUETTE
   //-------------------------------------------------------------------------//
   // "GetAllInstrRisks":                                                     //
   //-------------------------------------------------------------------------//
-  RiskMgr::IRsMapI const& RiskMgr::GetAllInstrRisks(UserID a_user_id) const
+  RiskMgr::IRsUserView RiskMgr::GetAllInstrRisks(UserID a_user_id) const
   {
-    auto cit = m_instrRisks.find(a_user_id);
-    if (utxx::unlikely(cit == m_instrRisks.cend()))
+    if (utxx::unlikely(m_userIDs.find(a_user_id) == m_userIDs.cend()))
       throw utxx::badarg_error
             ("RiskMgr::GetAllInstrRisks: UserID Not Found: ", a_user_id);
     // Generic Case:
-    return cit->second;
+    return m_instrRisks.GetUser(a_user_id);
   }
 
   //-------------------------------------------------------------------------//
   // "GetAllAssetRisks":                                                     //
   //-------------------------------------------------------------------------//
-  RiskMgr::ARsMapI const& RiskMgr::GetAllAssetRisks(UserID a_user_id) const
+  RiskMgr::ARsUserView RiskMgr::GetAllAssetRisks(UserID a_user_id) const
   {
-    auto cit = m_assetRisks.find(a_user_id);
-    if (utxx::unlikely(cit == m_assetRisks.cend()))
+    if (utxx::unlikely(m_userIDs.find(a_user_id) == m_userIDs.cend()))
       throw utxx::badarg_error
             ("RiskMgr::GetAllAssetRisks: UserID Not Found: ", a_user_id);
     // Generic Case:
-    return cit->second;
+    return m_assetRisks.GetUser(a_user_id);
   }
 
   //-------------------------------------------------------------------------//
@@ -533,26 +544,13 @@ namespace MAQUETTE
       assert(ob2 == nullptr);
       return;
     }
-    // Otherwise: Traverse all "InstrRisks" for the given UserID:
-    auto cit = m_instrRisks.find(a_ar.m_userID);
-
-    if (utxx::unlikely(cit == m_instrRisks.cend()))
-    {
-      // XXX: We got "AssetRisks", but not "InstrRisks", for some UserID. In
-      // theory, this might happen if there were Transfers only  (no Trades)
-      // in that Asset. Yet is is strange, so produce a warning:
-      LOG_WARN(2,
-        "RiskMgr::InstallXValuators: No InstrRisks found for UserID={}",
-        a_ar.m_userID)
-      return;
-    }
-    // Otherwise: Get to the "InstrRisks":
+    // Otherwise: Traverse all "InstrRisks" for the given UserID (there may be
+    // none, eg if there were Transfers only (no Trades) for that UserID):
     assert(m_obirMap != nullptr && m_obarMap != nullptr);
 
-    IRsMapI  const& mapI = cit->second;
-    for (IRsMapIKVT const& irpI: mapI)
+    for (auto const& irp: m_instrRisks.GetUser(a_ar.m_userID))
     {
-      InstrRisks const& ir = irpI.second;
+      InstrRisks const& ir = irp.second;
 
       // Check whether this "ir" has anything to do with this AssetRisks:
       if (ir.m_risksA == &a_ar || ir.m_risksB == &a_ar)
@@ -562,10 +560,10 @@ namespace MAQUETTE
         // "ir". So install it in the map, but hwn it ticks, check carefully
         // whether it is applicable:
         //
-        (*m_obirMap)  [ob1].insert(const_cast<InstrRisks*>(&ir));
+        m_obirMap->Insert  (ob1, const_cast<InstrRisks*>(&ir));
 
         if (ob2 != nullptr)
-          (*m_obirMap)[ob2].insert(const_cast<InstrRisks*>(&ir));
+          m_obirMap->Insert(ob2, const_cast<InstrRisks*>(&ir));
       }
     }
     // All Done!
@@ -579,10 +577,9 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // "AssetRisks" Checks:                                                  //
     //-----------------------------------------------------------------------//
-    for (ARsMapKVT const& arp: m_assetRisks)
+    for (UserID userID: m_userIDs)
     {
-      UserID          userID = arp.first;
-      ARsMapI const&  mapI   = arp.second;
+      ARsUserView     mapI   = m_assetRisks.GetUser(userID);
 
       for (auto itI = mapI.cbegin(); itI != mapI.cend(); ++itI)
       {
@@ -667,10 +664,9 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // InstrRisks Checks:                                                    //
     //-----------------------------------------------------------------------//
-    for (IRsMapKVT const& irp: m_instrRisks)
+    for (UserID userID: m_userIDs)
     {
-      UserID          userID = irp.first;
-      IRsMapI const&  mapI   = irp.second;
+      IRsUserView     mapI   = m_instrRisks.GetUser(userID);
 
       for (auto itI = mapI.cbegin(); itI != mapI.cend(); ++itI)
       {
@@ -750,6 +746,11 @@ namespace MAQUETTE
       (m_mdUpdatesPeriodMSec > 0)
       ? (utxx::now_utc () + utxx::msecs(m_mdUpdatesPeriodMSec))
       :  utxx::time_val();
+
+    // Full re-calculation of the RFC Totals for all UserIDs: they might have
+    // become stale while the RiskMgr was inactive (or in the Safe Mode):
+    for (UserID userID: m_userIDs)
+      ReCalcRFCTotals(userID);
   }
 
   //=========================================================================//
@@ -763,16 +764,7 @@ namespace MAQUETTE
     (OrderBookBase const* a_ob, InstrRisks* a_ir) const
   {
     assert(a_ob != nullptr && a_ir != nullptr && m_obirMap != nullptr);
-    auto   cit  =  m_obirMap->find(a_ob);
-
-    if (utxx::unlikely(cit == m_obirMap->cend()))
-      return false;    // No such OrderBook in Map Keys at all!
-
-    // Now check if this "InstrRisks" is in the OrderBook's image:
-    assert(cit->first == a_ob);
-    set<InstrRisks*> const&   irs = cit->second;
-    assert(!irs.empty());
-    return (irs.find(a_ir) != irs.cend());
+    return m_obirMap->Contains(a_ob, a_ir);
   }
 
   //-------------------------------------------------------------------------//
@@ -782,16 +774,7 @@ namespace MAQUETTE
     (OrderBookBase const* a_ob, AssetRisks* a_ar) const
   {
     assert(a_ob != nullptr && a_ar != nullptr && m_obarMap != nullptr);
-    auto   cit  =  m_obarMap->find(a_ob);
-
-    if (utxx::unlikely(cit == m_obarMap->cend()))
-      return false;    // No such OrderBook in Map Keys at all!
-
-    // Now check if this "AssetRisks" is in the OrderBook's image:
-    assert(cit->first == a_ob);
-    set<AssetRisks*> const&   ars = cit->second;
-    assert(!ars.empty());
-    return (ars.find(a_ar) != ars.cend());
+    return m_obarMap->Contains(a_ob, a_ar);
   }
 
   //=========================================================================//
@@ -871,29 +854,25 @@ namespace MAQUETTE
     // (They may remain in ShM from prev invocations. This would be done dyna-
     // mically as well, but we better install it now):
     //
-    for (auto& irp: m_instrRisks)
+    for (UserID userID: m_userIDs)
     {
-      UserID userID = irp.first;
       if (utxx::unlikely(userID == 0))
         continue;   // Already done!
 
-      IRsMapI& mapI = irp.second;
-
       // XXX: Do NOT use "GetInstrRisksImpl" here -- we do not want to create
       // a new "InstrRisks" for a UserID which may not need it at all.  Use a
       // passive search:
-      auto it =  mapI.find(a_instr.m_SecID);
-      if  (it == mapI.end())
+      InstrRisks* ir = m_instrRisks.Find(MkIRsKey(userID, a_instr.m_SecID));
+      if (ir == nullptr)
         continue;
 
       // If found: That "InstrRisks" should in general be non-Empty,   but we
       // check it for extra safety:
-      InstrRisks& ir = it->second;
-      if (utxx::likely(!ir.IsEmpty()))
+      if (utxx::likely(!ir->IsEmpty()))
       {
-        ir.m_ob = a_ob;
+        ir->m_ob = a_ob;
         // Do NOT forget to add "ir" to the map as well:
-        (*m_obirMap)[ir.m_ob].insert(&ir);
+        m_obirMap->Insert(ir->m_ob, ir);
       }
     }
     //-----------------------------------------------------------------------//
@@ -961,15 +940,17 @@ namespace MAQUETTE
     // for UserID=0:
     SymKey asset = MkSymKey(a_asset);
 
-    for (auto& arp: m_assetRisks)
+    for (UserID userID: m_userIDs)
     {
-      UserID   userID = arp.first;
-      ARsMapI& mapI   = arp.second;
-
-      // Search for this (Asset,SettlDate) in "mapI":
-      auto it = mapI.find(make_pair(asset, a_settl_date));
-
-      if (it == mapI.end())
+      // Search for this (UserID,Asset,SettlDate) (the Asset may not be known
+      // at all as yet):
+      Key16       key;
+      AssetRisks* arp =
+        MkARsKey(userID, asset, a_settl_date, false, &key)
+        ? m_assetRisks.Find(key)
+        : nullptr;
+
+      if (arp == nullptr)
       {
         if (utxx::unlikely(userID == 0))
           // If UserID is 0, then we assume the AssetRisks is ought to be found,
@@ -983,7 +964,7 @@ namespace MAQUETTE
           // UserID != 0:
           continue;
       }
-      AssetRisks& ar = it->second;
+      AssetRisks& ar = *arp;
 
       // NB: further checks are performed by  by "AssetRisks::InstallValuator":
       ar.InstallValuator(a_ob1, a_bid_adj1, a_ask_adj1, a_roll_over_time,
@@ -993,10 +974,10 @@ namespace MAQUETTE
       assert(m_obarMap != nullptr);
 
       if (utxx::likely(ar.m_evalOB1 != nullptr))
-        (*m_obarMap)  [ar.m_evalOB1].insert(&ar);
+        m_obarMap->Insert  (ar.m_evalOB1, &ar);
 
       if (ar.m_evalOB2 != nullptr)
-        (*m_obarMap)  [ar.m_evalOB2].insert(&ar);
+        m_obarMap->Insert  (ar.m_evalOB2, &ar);
     }
     // All Done!
   }
@@ -1021,15 +1002,17 @@ namespace MAQUETTE
     // NB: Install it for all UserIDs for which this Asset exists:
     SymKey asset = MkSymKey(a_asset);
 
-    for (auto& arp: m_assetRisks)
+    for (UserID userID: m_userIDs)
     {
-      UserID   userID = arp.first;
-      ARsMapI& mapI   = arp.second;
-
-      // Search for this (Asset,SettlDate) in "mapI":
-      auto it = mapI.find(make_pair(asset, a_settl_date));
-
-      if (it == mapI.end())
+      // Search for this (UserID,Asset,SettlDate) (the Asset may not be known
+      // at all as yet):
+      Key16       key;
+      AssetRisks* arp =
+        MkARsKey(userID, asset, a_settl_date, false, &key)
+        ? m_assetRisks.Find(key)
+        : nullptr;
+
+      if (arp == nullptr)
       {
         if (utxx::unlikely(userID == 0))
           // If UserID is 0, then we assume the AssetRisks is ought to be found,
@@ -1043,7 +1026,7 @@ namespace MAQUETTE
           // UserID != 0:
           continue;
       }
-      AssetRisks& ar = it->second;
+      AssetRisks& ar = *arp;
 
       // NB: Futher checks are performed by "AssetRisks::InstallValuator":
       ar.InstallValuator(a_fixed_rate);
@@ -1218,8 +1201,14 @@ namespace MAQUETTE
       utxx::msecs mdUpdatesPeriod(m_mdUpdatesPeriodMSec);
       for (; m_nextMDUpdate <= now; m_nextMDUpdate += mdUpdatesPeriod);
     }
-    // In the following, we memoise the affected UserIDs:
+    // In the following, we memoise the affected UserIDs -- but only if the
+    // RFC Totals are to be updated and checked (ie not in STP or Safe mode).
+    // Unless the RFCTotalsReconcilePeriod is 0, the Totals are updated incre-
+    // mentally, by the deltas of affected "AssetRisks" and "InstrRisks":
+    bool withTotals = (m_mode != RMModeT::STP && m_mode != RMModeT::Safe);
+    bool incrTotals = withTotals && m_rfcReconcilePeriod > 0;
     m_affectedUserIDs->clear();
+    ++m_updateStamp;
 
     //-----------------------------------------------------------------------//
     // Update "AssetRisks" affected by this OrderBook tick:                  //
@@ -1228,24 +1217,32 @@ namespace MAQUETTE
     // ently be re-used in "InstrRisks" RFC valuations:
     //
     assert(m_obarMap != nullptr);
-    auto itAR = m_obarMap->find(&a_ob);
+    OBARMap::RisksVec const* ars = m_obarMap->Find(&a_ob);
 
     // NB: Bogus ticks CAN happen, and are in general harmless (except for some
     // minor inefficiencies):
-    if (utxx::likely(itAR != m_obarMap->cend() && !(itAR->second.empty())))
+    if (utxx::likely(ars != nullptr))
     {
-      // Generic Case: Found the set of "AssetRisks" affected by this OrderBook
-      // as an Asset->RFC Valuator:
-      set<AssetRisks*> const& ars = itAR->second;
-
-      for (AssetRisks* ar: ars)
+      // Generic Case: Found the "AssetRisks" affected by this OrderBook as an
+      // Asset->RFC Valuator:
+      for (AssetRisks* ar: *ars)
       {
         assert(ar != nullptr);
         // Again, for extra safety, guard against Empty "AssetRisks":
         if (utxx::likely(!(ar->IsEmpty())))
         {
-          ar->OnValuatorTick       (a_ob,   a_ts);
-          m_affectedUserIDs->insert(ar->m_userID);
+          ar->OnValuatorTick(a_ob, a_ts);
+          if (withTotals)
+          {
+            RFCTotalsRefs& totals = GetRFCTotals(ar->m_userID);
+            if (incrTotals)
+              ApplyRFCDelta(*ar, &totals);
+            if (totals.m_lastUpdate != m_updateStamp)
+            {
+              totals.m_lastUpdate   = m_updateStamp;
+              m_affectedUserIDs->push_back(ar->m_userID);
+            }
+          }
         }
         else
           LOG_ERROR(1,
@@ -1258,23 +1255,31 @@ namespace MAQUETTE
     // Update "InstrRisks" affected by this OrderBook tick:                  //
     //-----------------------------------------------------------------------//
     assert(m_obirMap != nullptr);
-    auto itIR = m_obirMap->find(&a_ob);
+    OBIRMap::RisksVec const* irs = m_obirMap->Find(&a_ob);
 
     // NB: Again, check for "bogus" ticks:
-    if (utxx::likely(itIR != m_obirMap->cend() && !(itIR->second.empty())))
+    if (utxx::likely(irs != nullptr))
     {
-      // Generic Case: Found the set of "InstrRisks" affected by this OrderBook
-      // as UnRealisedPnL Valuator:
-      set<InstrRisks*> const& irs = itIR->second;
-
-      for (InstrRisks* ir: irs)
+      // Generic Case: Found the "InstrRisks" affected by this OrderBook as Un-
+      // RealisedPnL Valuator:
+      for (InstrRisks* ir: *irs)
       {
         assert(ir != nullptr);
         // For extra safety, guard against Empty "InstrRisks":
         if (utxx::likely(!(ir->IsEmpty())))
         {
-          ir->OnMktDataUpdate      (a_ob, bidPxAB, askPxAB, a_ts);
-          m_affectedUserIDs->insert(ir->m_userID);
+          ir->OnMktDataUpdate(a_ob, bidPxAB, askPxAB, a_ts);
+          if (withTotals)
+          {
+            RFCTotalsRefs& totals = GetRFCTotals(ir->m_userID);
+            if (incrTotals)
+              ApplyRFCDelta(*ir, &totals);
+            if (totals.m_lastUpdate != m_updateStamp)
+            {
+              totals.m_lastUpdate   = m_updateStamp;
+              m_affectedUserIDs->push_back(ir->m_userID);
+            }
+          }
         }
         else
           LOG_ERROR(1,
@@ -1286,33 +1291,41 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // Now process the AffectedUserIDs:                                      //
     //-----------------------------------------------------------------------//
-    if (m_mode != RMModeT::STP   && m_mode != RMModeT::Safe)
+    if (withTotals)
+    {
+      // Each UserID occurs only once (de-duplicated by "m_updateStamp"):
       for (UserID userID: *m_affectedUserIDs)
       {
-        ReCalcRFCTotals(userID);
+        // Periodic (or, if not incremental, immediate) full re-calculation:
+        if (incrTotals)
+          OnRFCTotalsUpdated(userID);
+        else
+          ReCalcRFCTotals(userID);
 
         //-------------------------------------------------------------------//
         // Any Limit(s) Exceeded?                                            //
         //-------------------------------------------------------------------//
         // FIXME: If a Limit is violated on some UserAccount, it should NOT im-
         // ply entering SafeMode over-all:
+        RFCTotalsRefs const& totals = GetRFCTotals(userID);
         if (utxx::unlikely
-           (m_totalRiskRFC        [userID] > m_MaxTotalRiskRFC        ||
-            m_totalActiveOrdsSzRFC[userID] > m_MaxActiveOrdsTotalSzRFC))
+           (*totals.m_riskRFC         > m_MaxTotalRiskRFC        ||
+            *totals.m_activeOrdsSzRFC > m_MaxActiveOrdsTotalSzRFC))
           EnterSafeMode("OnMktDataUpdate", "Risk Limit(s) violation");
       }
+    }
     // All Done!
   }
 
   //=========================================================================//
   // "ReCalcRFCTotals":                                                      //
   //=========================================================================//
-  // Invoked after a Trade or Valuator Tick. Updates TotalRiskRFC, TotalNAV_RFC
-  // and TotalActiveOrdsSzRFC for a given UserID.
-  // XXX: All Totals are re-calculated by direct summation from 0. This is HUGE-
-  // LY inefficient for NAV and ActiveIrdsSz (a differential update woule be
-  // much better), but OK for Risk (Exposure) which is NON-Linear anyway. So we
-  // curretly opt for full re-calculation of all Totals:
+  // Updates TotalRiskRFC, TotalNAV_RFC and TotalActiveOrdsSzRFC for a given
+  // UserID by direct summation from 0. Normally, the Totals are updated incre-
+  // mentally ("ApplyRFCDelta"), and this method is only invoked periodically,
+  // to eliminate the accumulated drift (and on "Start"); it also memoises the
+  // contribution of each "AssetRisks" and "InstrRisks",  so that subsequent
+  // deltas are consistent with the Totals:
   //
   inline void RiskMgr::ReCalcRFCTotals(UserID a_user_id) const
   {
@@ -1322,78 +1335,198 @@ namespace MAQUETTE
     if (m_mode == RMModeT::Relaxed)
       return;
 
+    RFCTotalsRefs& totals = GetRFCTotals(a_user_id);
+    totals.m_nDeltas      = 0;
+
     //-----------------------------------------------------------------------//
     // TotalRiskRFC and TotalNAV_RFC from "AssetRisks":                      //
     //-----------------------------------------------------------------------//
-    auto itAR = m_assetRisks.find(a_user_id);
+    // NB: There may be no "AssetRisks" for this UserID as yet, then the Tot-
+    // als are 0:
+    double totalRiskRFC = 0.0;
+    double totalNAV_RFC = 0.0;
 
-    if (utxx::unlikely(itAR == m_assetRisks.cend()))
+    for (auto const& arp: m_assetRisks.GetUser(a_user_id))
     {
-      // This must NOT happen:
-      LOG_ERROR(1,
-        "RiskMgr::ReCalcRFCTotals: AssetRisks for UserID={} Not Found",
-        a_user_id)
+      AssetRisks const& ar = arp.second;
+      assert(ar.m_userID  == a_user_id);
+
+      // Update the Total Pos and NAV RFC (algebraic summation is used here):
+      double netTotalRFC = ar.GetNetTotalRFC();
+      totalNAV_RFC      += netTotalRFC;
+      ar.m_totalsNetRFC  = netTotalRFC;
+
+      // Update the Total Risk (RFC), if this Asset is NOT RFC itself:  Here
+      // we use the Abs value for the worst-case exposure: TODO: Correlation
+      // Matrices!
+      if (utxx::likely(!ar.m_isRFC))
+        totalRiskRFC += Abs(netTotalRFC);
     }
-    else
-    {
-      // Generic Case:
-      double totalRiskRFC = 0.0;
-      double totalNAV_RFC = 0.0;
-      ARsMapI const& mapI = itAR->second;
+    // NB: Risks are of course non-negative, but NAV can be any:
+    assert(totalRiskRFC >= 0.0);
 
-      for (auto const& arp: mapI)
-      {
-        AssetRisks const& ar = arp.second;
-        assert(ar.m_userID  == a_user_id);
-
-        // Update the Total Pos and NAV RFC (algebraic summation is used here):
-        double netTotalRFC = ar.GetNetTotalRFC();
-        totalNAV_RFC += netTotalRFC;
-
-        // Update the Total Risk (RFC), if this Asset is NOT RFC itself:  Here
-        // we use the Abs value for the worst-case exposure: TODO: Correlation
-        // Matrices!
-        if (utxx::likely(!ar.m_isRFC))
-          totalRiskRFC += Abs(netTotalRFC);
-      }
-      // NB: Risks are of course non-negative, but NAV can be any:
-      assert(totalRiskRFC >= 0.0);
+    // Store the computed Totals back:
+    *totals.m_riskRFC = totalRiskRFC;
+    *totals.m_navRFC  = totalNAV_RFC;
 
-      // Store the computed Totals back:
-      m_totalRiskRFC[a_user_id] = totalRiskRFC;
-      m_totalNAV_RFC[a_user_id] = totalNAV_RFC;
-    }
     //-----------------------------------------------------------------------//
     // TotaActiveOrdsSzRFC from "InstrRisks" (Non-STP only):                 //
     //-----------------------------------------------------------------------//
     if (m_mode != RMModeT::STP)
     {
-      auto itIR = m_instrRisks.find(a_user_id);
+      double totalActiveOrdsSzRFC = 0.0;
 
-      if (utxx::unlikely(itIR == m_instrRisks.cend()))
+      for (auto const& irp: m_instrRisks.GetUser(a_user_id))
       {
-        // This must NOT happen:
-        LOG_ERROR(1,
-          "RiskMgr::ReCalcRFCTotals: InstrRisks for UserID={} Not Found",
-          a_user_id)
+        InstrRisks const& ir =  irp.second;
+        assert(ir.m_userID   == a_user_id && ir.m_activeOrdsSzRFC >= 0.0);
+        totalActiveOrdsSzRFC    += ir.m_activeOrdsSzRFC;
+        ir.m_totalsActiveOrdsSzRFC = ir.m_activeOrdsSzRFC;
       }
-      else
-      {
-        double totalActiveOrdsSzRFC = 0.0;
-        IRsMapI const& mapI         = itIR->second;
+      // Store the computed Total back:
+      assert(totalActiveOrdsSzRFC >= 0.0);
+      *totals.m_activeOrdsSzRFC = totalActiveOrdsSzRFC;
+    }
+    // All Done!
+  }
 
-        for (auto const& irp: mapI)
-        {
-          InstrRisks const& ir =  irp.second;
-          assert(ir.m_userID   == a_user_id && ir.m_activeOrdsSzRFC >= 0.0);
-          totalActiveOrdsSzRFC += ir.m_activeOrdsSzRFC;
-        }
-        // Store the computed Total back:
-        assert(totalActiveOrdsSzRFC >= 0.0);
-        m_totalActiveOrdsSzRFC[a_user_id] = totalActiveOrdsSzRFC;
+  //=========================================================================//
+  // "GetRFCTotals":                                                         //
+  //=========================================================================//
+  inline RiskMgr::RFCTotalsRefs& RiskMgr::GetRFCTotals(UserID a_user_id) const
+  {
+    assert(m_rfcTotals != nullptr);
+    Key16 key{uint64_t(a_user_id), 0};
+    int   i = m_rfcTotals->m_index.Find(key);
+    if (utxx::likely(i >= 0))
+      return m_rfcTotals->m_refs[size_t(i)];
+
+    // Otherwise, install the Totals for this UserID (if not there yet), and
+    // memoise the ptrs to them:
+    RFCTotalsRefs refs
+    {
+      &(m_totalRiskRFC        [a_user_id]),
+      &(m_totalNAV_RFC        [a_user_id]),
+      &(m_totalActiveOrdsSzRFC[a_user_id]),
+      0,
+      0
+    };
+    m_rfcTotals->m_refs.push_back(refs);
+    (void) m_rfcTotals->m_index.Insert
+           (key, int(m_rfcTotals->m_refs.size()) - 1);
+    return m_rfcTotals->m_refs.back();
+  }
+
+  //=========================================================================//
+  // "MkARsKey":                                                             //
+  //=========================================================================//
+  // The Key of "AssetRisks" in "m_assetRisks": (AssetID | SettlDate << 32,
+  // UserID), where the AssetID is the index of the Asset Symbol interned in
+  // "m_assetIDs":
+  //
+  bool RiskMgr::MkARsKey
+  (
+    UserID           a_user_id,
+    SymKey const&    a_asset,
+    int              a_settl_date,
+    bool             a_intern,
+    Key16*           a_key
+  )
+  const
+  {
+    assert(a_key != nullptr);
+    Key16 sym     = MkKey16(a_asset);
+    int   assetID = m_assetIDs.Find(sym);
+
+    if (utxx::unlikely(assetID < 0))
+    {
+      if (!a_intern)
+        return false;
+
+      assetID = m_assetIDs.Size();
+      if (utxx::unlikely(assetID >= m_assetIDs.Capacity))
+      {
+        LOG_ERROR(1,
+          "RiskMgr::MkARsKey: Too many Assets: Max={}", m_assetIDs.Capacity)
+        return false;
       }
+      (void) m_assetIDs.Insert(sym, assetID);
     }
-    // All Done!
+    a_key->m_lo = uint64_t(unsigned(assetID)) |
+                 (uint64_t(unsigned(a_settl_date)) << 32);
+    a_key->m_hi = uint64_t(a_user_id);
+    return true;
+  }
+
+  //=========================================================================//
+  // "ApplyRFCDelta":                                                        //
+  //=========================================================================//
+  // NB: If the old or new contribution is not finite, the delta cannot be ap-
+  // plied, so a full re-calculation is forced at the next update instead:
+  //
+  //-------------------------------------------------------------------------//
+  // "AssetRisks" => TotalNAV_RFC, TotalRiskRFC:                             //
+  //-------------------------------------------------------------------------//
+  inline void RiskMgr::ApplyRFCDelta
+  (
+    AssetRisks const& a_ar,
+    RFCTotalsRefs*    a_totals
+  )
+  const
+  {
+    assert(a_totals != nullptr);
+    double newRFC = a_ar.GetNetTotalRFC();
+    double oldRFC = a_ar.m_totalsNetRFC;
+    if (newRFC == oldRFC)
+      return;
+
+    if (utxx::unlikely(!(IsFinite(newRFC) && IsFinite(oldRFC))))
+      a_totals->m_nDeltas = m_rfcReconcilePeriod;
+    else
+    {
+      *(a_totals->m_navRFC) += newRFC - oldRFC;
+      // As in "ReCalcRFCTotals", RFC itself does not contribute to the Risk:
+      if (utxx::likely(!a_ar.m_isRFC))
+        *(a_totals->m_riskRFC) += Abs(newRFC) - Abs(oldRFC);
+    }
+    a_ar.m_totalsNetRFC = newRFC;
+  }
+
+  //-------------------------------------------------------------------------//
+  // "InstrRisks" => TotalActiveOrdsSzRFC:                                   //
+  //-------------------------------------------------------------------------//
+  inline void RiskMgr::ApplyRFCDelta
+  (
+    InstrRisks const& a_ir,
+    RFCTotalsRefs*    a_totals
+  )
+  const
+  {
+    assert(a_totals != nullptr);
+    double newRFC = a_ir.m_activeOrdsSzRFC;
+    double oldRFC = a_ir.m_totalsActiveOrdsSzRFC;
+    if (newRFC == oldRFC)
+      return;
+
+    if (utxx::unlikely(!(IsFinite(newRFC) && IsFinite(oldRFC))))
+      a_totals->m_nDeltas = m_rfcReconcilePeriod;
+    else
+      *(a_totals->m_activeOrdsSzRFC) += newRFC - oldRFC;
+
+    a_ir.m_totalsActiveOrdsSzRFC = newRFC;
+  }
+
+  //=========================================================================//
+  // "OnRFCTotalsUpdated":                                                   //
+  //=========================================================================//
+  // Drift reconciliation: after "m_rfcReconcilePeriod" incremental updates of
+  // the Totals of this UserID,  they are fully re-calculated:
+  //
+  inline void RiskMgr::OnRFCTotalsUpdated(UserID a_user_id) const
+  {
+    RFCTotalsRefs& totals = GetRFCTotals(a_user_id);
+    if (utxx::unlikely(++totals.m_nDeltas >= m_rfcReconcilePeriod))
+      ReCalcRFCTotals(a_user_id);   // Also resets "m_nDeltas"
   }
 
   //=========================================================================//
@@ -1586,13 +1719,24 @@ namespace MAQUETTE
       return;
 
     //-----------------------------------------------------------------------//
-    // Re-calculate Total RFC NAV and TotalRiskRFC:                          //
+    // Update Total RFC NAV, TotalRiskRFC and TotalActiveOrdsSzRFC:          //
     //-----------------------------------------------------------------------//
     // Only 2 Assets have been affected (arA and arB), and their RFCs were al-
     // ready re-calculated above,  so only the Totals need to be re-done, and
-    // there is no ValuatorTick:
+    // there is no ValuatorTick. In the STP and Safe modes, MktData ticks  do
+    // not update the Totals incrementally, so they are fully re-calculated:
     //
-    ReCalcRFCTotals(userID);
+    if (m_mode == RMModeT::STP  || m_mode == RMModeT::Safe ||
+        m_rfcReconcilePeriod == 0)
+      ReCalcRFCTotals(userID);
+    else
+    {
+      RFCTotalsRefs& totals = GetRFCTotals(userID);
+      ApplyRFCDelta(*(ir->m_risksA), &totals);
+      ApplyRFCDelta(*(ir->m_risksB), &totals);
+      ApplyRFCDelta(*ir,             &totals);
+      OnRFCTotalsUpdated(userID);
+    }
 
     //-----------------------------------------------------------------------//
     // Any Limits Exceeded?                                                  //
@@ -1623,9 +1767,10 @@ namespace MAQUETTE
 
       // NB: Only use NAV2; NAV1 is Instrument-based (not Ccy-based), so it's
       // for information only:
+      RFCTotalsRefs const& totals = GetRFCTotals(userID);
       if (utxx::unlikely
-         (m_totalRiskRFC[userID] > m_MaxTotalRiskRFC ||
-          m_totalNAV_RFC[userID] < m_MinTotalNAV_RFC))
+         (*totals.m_riskRFC > m_MaxTotalRiskRFC ||
+          *totals.m_navRFC  < m_MinTotalNAV_RFC))
         EnterSafeMode("OnTrade", "Risk Limit(s) violation");
     }
     // All Done!
@@ -1895,9 +2040,7 @@ namespace MAQUETTE
       if (utxx::unlikely(ir->m_activeOrdsSzRFC  < 0.0))
         ir->m_activeOrdsSzRFC  = 0.0;
 
-      m_totalActiveOrdsSzRFC  [userID] += diffSzRFC;
-      if (utxx::unlikely(m_totalActiveOrdsSzRFC[userID] < 0.0))
-        m_totalActiveOrdsSzRFC[userID] =  0.0;
+      ApplyRFCDelta(*ir, &GetRFCTotals(userID));
     }
     // All Done!
   }
@@ -1943,6 +2086,24 @@ namespace MAQUETTE
     }
     // If OK: Proceed:
     ar->OnBalanceUpdate(a_trans_id, a_trans_t, a_new_total, a_ts_exch);
+
+    //-----------------------------------------------------------------------//
+    // Update Total RFC NAV and TotalRiskRFC:                                //
+    //-----------------------------------------------------------------------//
+    // As in "OnTrade": only 1 Asset has been affected,  so apply its delta to
+    // the Totals (or re-calculate them in the STP and Safe modes):
+    //
+    if (m_mode == RMModeT::Relaxed)
+      return;
+
+    if (m_mode == RMModeT::STP  || m_mode == RMModeT::Safe ||
+        m_rfcReconcilePeriod == 0)
+      ReCalcRFCTotals(a_user_id);
+    else
+    {
+      ApplyRFCDelta(*ar, &GetRFCTotals(a_user_id));
+      OnRFCTotalsUpdated(a_user_id);
+    }
   }
 
   //=========================================================================//
@@ -2022,27 +2183,32 @@ namespace MAQUETTE
              "with UserID=", a_user_id);
 
     //-----------------------------------------------------------------------//
-    // Try to find it, or install an empty new one:                          //
+    // Fast Path: Already-initialised "InstrRisks":                          //
     //-----------------------------------------------------------------------//
-    // First, find the "IRsMapI" by UserID (or create a new empty one if this
-    // UserID is not there yet):
-    auto it = m_instrRisks.find(a_user_id);
+    // If there is nothing to install into it (no args given, and its OrderBook
+    // is already there or is not to be searched for anymore), then there is no
+    // need to go through the Maps below:
+    //
+    Key16 key = MkIRsKey(a_user_id, a_instr.m_SecID);
 
-    if (utxx::unlikely(it == m_instrRisks.end()))
+    if (utxx::likely(a_ob == nullptr && a_ar_a == nullptr && a_ar_b == nullptr))
     {
-      auto insRes =
-        m_instrRisks.insert
-          (make_pair
-            (a_user_id, IRsMapIAlloc(s_pm.GetSegm()->get_segment_manager())));
-      it   = insRes.first;
-      assert(insRes.second);
+      InstrRisks* ir = m_instrRisks.Find(key);
+      if (utxx::likely
+         (ir != nullptr && !(ir->IsEmpty()) &&
+         (ir->m_ob != nullptr || ir->m_initAttempts > 1)))
+      {
+        assert(ir->m_userID == a_user_id);
+        ++(ir->m_initAttempts);
+        return ir;
+      }
     }
-    assert(it != m_instrRisks.end() && it->first == a_user_id);
-    IRsMapI& mapI  = it->second; // Ref!
-
-    // Similarly, find or create the "InstrRisks" obj for this SecID. In parti-
-    // cular, new (Empty) "InstrRisks" are created HERE:
-    InstrRisks& ir = mapI[a_instr.m_SecID];
+    //-----------------------------------------------------------------------//
+    // Try to find it, or install an empty new one:                          //
+    //-----------------------------------------------------------------------//
+    // In particular, new (Empty) "InstrRisks" are created HERE:
+    InstrRisks& ir =
+      *(m_instrRisks.FindOrInsert(key, a_user_id, a_instr.m_SecID));
 
     // Memoise the UserID:
     m_userIDs.insert(a_user_id);
@@ -2078,7 +2244,7 @@ namespace MAQUETTE
         else
         {
           // The "InstrRisks" obj is empty and cannot be fully constructed. We
-          // XXX leave it in "mapI" but return NULL:
+          // XXX leave it in "m_instrRisks" but return NULL:
           LOG_ERROR(1,
             "RiskMgr::GetInstrRisksImpl: {}, UserID=0: Cannot construct the "
             "obj: No AssetRisks provided",   a_instr.m_FullName.data())
@@ -2141,7 +2307,7 @@ namespace MAQUETTE
       // List the new "InstrRisks" as updatable via its OrderBook:
       assert(m_obirMap != nullptr);
       if (utxx::likely(ir.m_ob != nullptr))
-        (*m_obirMap)  [ir.m_ob].insert(&ir);
+        m_obirMap->Insert  (ir.m_ob, &ir);
     }
     else
     {
@@ -2194,7 +2360,7 @@ namespace MAQUETTE
 
           // List this "InstrRisks" as updatable via its OrderBook:
           assert(m_obirMap != nullptr  && ir.m_ob != nullptr);
-          (*m_obirMap)[ir.m_ob].insert(&ir);
+          m_obirMap->Insert(ir.m_ob, &ir);
         }
         else
           LOG_WARN(1,
@@ -2263,25 +2429,16 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // Generic Case: Try to find "AssetRisks", or install an empty new one:  //
     //-----------------------------------------------------------------------//
-    // First, find the "IRsMapI" by UserID (or create a new empty one if this
-    // UserID is not there yet):
-    auto it = m_assetRisks.find(a_user_id);
-
-    if (utxx::unlikely(it == m_assetRisks.end()))
-    {
-      auto insRes =
-        m_assetRisks.insert
-          (make_pair
-            (a_user_id, ARsMapIAlloc(s_pm.GetSegm()->get_segment_manager())));
-      it   = insRes.first;
-      assert(insRes.second);
-    }
-    assert(it != m_assetRisks.end() && it->first == a_user_id);
-    ARsMapI& mapI  = it->second;  // Ref!
+    // Find or create the "AssetRisks" for (UserID, AssetName, SettlDate); the
+    // AssetName is interned if new. In particular, new (Empty) "AssetRisks"
+    // are created HERE:
+    Key16 key;
+    if (utxx::unlikely(!MkARsKey(a_user_id, a_asset, a_settl_date, true, &key)))
+      return nullptr;
 
-    // Similarly, find or create the "AssetRisks" for (AssetName, SettlDate):
-    // In particular, new (Empty) "AssetRisks" are created HERE:
-    AssetRisks& ar = mapI[make_pair(a_asset, a_settl_date)];
+    AssetRisks& ar =
+      *(m_assetRisks.FindOrInsert
+         (key, a_user_id, make_pair(a_asset, a_settl_date)));
 
     // Memoise the UserID:
     m_userIDs.insert(a_user_id);
@@ -2339,10 +2496,10 @@ namespace MAQUETTE
     {
       assert(m_obarMap != nullptr);
       if (utxx::likely(ar.m_evalOB1 != nullptr))
-        (*m_obarMap)  [ar.m_evalOB1].insert(&ar);
+        m_obarMap->Insert  (ar.m_evalOB1, &ar);
 
       if (ar.m_evalOB2 != nullptr)
-        (*m_obarMap)  [ar.m_evalOB2].insert(&ar);
+        m_obarMap->Insert  (ar.m_evalOB2, &ar);
 
       // Also possibly map them to related "InstrRisks":
       InstallXValuators(ar);
@@ -2432,15 +2589,9 @@ namespace MAQUETTE
     else
       curr = stpcpy(curr,   "Asset Trading Positions: ");
 
-    // Traverse all "AssetRisks" with SettlDates (there should be at least 1):
-    auto cit = m_assetRisks.find(a_user_id);
-
-    if (utxx::unlikely(cit == m_assetRisks.cend()))
-      return;  // No such UserID, so nothing to do
-
-    ARsMapI const& mapI  =   cit->second;
-
-    for (ARsMapIKVT const&   arp: mapI)
+    // Traverse all "AssetRisks" with SettlDates (there should be at least 1;
+    // if there is no such UserID, there is nothing to do):
+    for (auto const& arp: m_assetRisks.GetUser(a_user_id))
     {
       AssetRisks const& ar = arp.second;
 
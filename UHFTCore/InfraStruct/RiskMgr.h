@@ -5,23 +5,33 @@
 //===========================================================================//
 #pragma once
 
+#include "Basis/KeyIdx.hpp"
 #include "InfraStruct/PersistMgr.h"
 #include "InfraStruct/SecDefsMgr.h"
 #include "InfraStruct/RiskMgrTypes.h"
+#include "InfraStruct/RisksIndex.hpp"
+#include "InfraStruct/RisksStore.hpp"
 #include "InfraStruct/StaticLimits.h"
 #include <utxx/rate_throttler.hpp>
 #include <boost/container/static_vector.hpp>
 #include <boost/interprocess/allocators/private_node_allocator.hpp>
 #include <algorithm>
+#include <deque>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <set>
+#include <string>
+#include <vector>
 
 namespace MAQUETTE
 {
   //=========================================================================//
   // "RiskMgr" Class:                                                        //
   //=========================================================================//
-  // Its single instance lives in ShM, and is accessed via the static "s_pm":
+  // Its instance lives in ShM, and is accessed via a static "PersistMgr" (see
+  // "s_pms"). Normally there is one instance per process; but different Acc-
+  // ountPfxs give different ShM segments, and so independent instances:
   //
   class  EConnector_OrdMgmt;
   struct Trade;
@@ -32,7 +42,14 @@ namespace MAQUETTE
     //=======================================================================//
     // Names of Persistent Objs:                                             //
     //=======================================================================//
-    constexpr static char const* RiskMgrON() { return "RiskMgr"; }
+    // The name carries the ShM Layout Version of "RiskMgr", "InstrRisks" and
+    // "AssetRisks", and MUST be changed whenever that layout changes. Then an
+    // existing "RiskMgr" of an older layout is NOT re-attached to  (see "Get-
+    // PersistInstance"), and its ShM segment must be re-created:
+    // ".1": RFC Totals contributions memoised in "InstrRisks", "AssetRisks";
+    // ".2": Flat "RisksStore"s instead of nested ShM Maps of Risks:
+    //
+    constexpr static char const* RiskMgrON() { return "RiskMgr.2"; }
 
     //=======================================================================//
     // Public Types (with Private Impls):                                    //
@@ -43,68 +60,27 @@ namespace MAQUETTE
     // does not use any locking (which could otherwise result in ShM data being
     // locked on a crash):
     //-----------------------------------------------------------------------//
-    // "IRsMapI": Inner ShM Map: {SecID  => InstrRisks}:                     //
+    // "IRsStore": Flat ShM Store: {(UserID, SecID) => InstrRisks}:          //
     //-----------------------------------------------------------------------//
     // FIXME: Need a global space of "SecID"s! For now, there is no guratantee
     // that SecIDs from different exchanges would not accidentially clash!
   private:
-    using IRsMapIKVT   = std::pair<SecID const, InstrRisks>;
-    using IRsMapIAlloc =
-          boost::interprocess::private_node_allocator
-          <IRsMapIKVT, FixedShM::segment_manager>;
+    using IRsStore     = RisksStore<SecID, InstrRisks>;
   public:
-    using IRsMapI      =
-          std::map<SecID,  InstrRisks, std::less<SecID>,  IRsMapIAlloc>;
+    using IRsUserView  = IRsStore::UserView;
 
     //-----------------------------------------------------------------------//
-    // "IRsMap" : Outer ShM Map: {UserID => IRsMapI}:                        //
+    // "ARsStore": Flat ShM Store: {(UserID,Asset,SettlDate) => AssetRisks}: //
     //-----------------------------------------------------------------------//
+    // The Client Key is (SymKey, SettlDate);  the index Key is made of the
+    // interned AssetID instead of the SymKey (see "MkARsKey"):
+    // FIXME: Again, we need a global registry of AssetIDs, rather than these
+    // per-RiskMgr ones:
   private:
-    using IRsMapKVT    = std::pair<UserID const, IRsMapI>;
-    using IRsMapAlloc  =
-          boost::interprocess::private_node_allocator
-          <IRsMapKVT,  FixedShM::segment_manager>;
+    using ARsKeyT      = std::pair<SymKey,     int>;   // (Symbol, SettlDate)
+    using ARsStore     = RisksStore<ARsKeyT,  AssetRisks>;
   public:
-    using IRsMap       =
-          std::map<UserID, IRsMapI,    std::less<UserID>, IRsMapAlloc>;
-
-    //-----------------------------------------------------------------------//
-    // "ARsMapI": Inner ShM Map: {(SymKey, SettlDate) => AssetRisks}:        //
-    //-----------------------------------------------------------------------//
-    // FIXME: Again, we need a global registry of AssetIDs to be used instead
-    // of SymKeys for identifying Assets:
-  private:
-    using ARsMapIKeyT  = std::pair<SymKey,     int>;   // (Symbol, SettlDate)
-    using ARsMapIKVT   = std::pair<ARsMapIKeyT const,  AssetRisks>;
-    using ARsMapIAlloc =
-          boost::interprocess::private_node_allocator
-          <ARsMapIKVT, FixedShM::segment_manager>;
-
-    // Comparator of (Symbol, SettlDate) Pairs:
-    struct ARsMapILessT
-    {
-      bool operator()(ARsMapIKeyT const& a_left, ARsMapIKeyT const& a_right)
-      const
-      {
-        int     c = strcmp(a_left.first.data(), a_right.first.data());
-        return (c < 0) || (c == 0 && a_left.second < a_right.second);
-      }
-    };
-  public:
-    using ARsMapI      =
-          std::map<ARsMapIKeyT, AssetRisks, ARsMapILessT,      ARsMapIAlloc>;
-
-    //-----------------------------------------------------------------------//
-    // "ARsMap": Outer ShM Map: {UserID => ARsMapI}:                         //
-    //-----------------------------------------------------------------------//
-  private:
-    using ARsMapKVT    = std::pair<UserID const, ARsMapI>;
-    using ARsMapAlloc  =
-          boost::interprocess::private_node_allocator
-          <ARsMapKVT,  FixedShM::segment_manager>;
-  public:
-    using ARsMap       =
-          std::map<UserID,      ARsMapI,    std::less<UserID>, ARsMapAlloc>;
+    using ARsUserView  = ARsStore::UserView;
 
     //-----------------------------------------------------------------------//
     // "UserIDsSet": ShM Set: {UserID}:                                      //
@@ -121,19 +97,43 @@ namespace MAQUETTE
     // Private Types:                                                        //
     //=======================================================================//
     //-----------------------------------------------------------------------//
-    // "OBIRMap"  (NOT ShM): { OrderBook => {InstrRisks} }:                  //
+    // "OBIRMap"  (NOT ShM): { OrderBook => [InstrRisks] }:                  //
     //-----------------------------------------------------------------------//
     // Used to quickly find the InstrRisks affected by an OrderBook tick (UnRe-
     // alised PnL). Not placed in ShM because OrderBooks themselves are not in
     // ShM either:
-    using OBIRMap = std::map<OrderBookBase const*, std::set<InstrRisks*>>;
+    using OBIRMap = OBRisksIndex<InstrRisks>;
 
     //-----------------------------------------------------------------------//
-    // "OBARMap" (NOT ShM): { OrderBook => {AssetRisks} }:                   //
+    // "OBARMap" (NOT ShM): { OrderBook => [AssetRisks] }:                   //
     //-----------------------------------------------------------------------//
     // (Again, not in ShM): Used to quickly find the AssetRisks affected by an
     // OrderBook tick (as an Asset->RFC Valuator):
-    using OBARMap = std::map<OrderBookBase const*, std::set<AssetRisks*>>;
+    using OBARMap = OBRisksIndex<AssetRisks>;
+
+    //-----------------------------------------------------------------------//
+    // "RFCTotalsIndex" (NOT ShM): { UserID => RFCTotalsRefs }:              //
+    //-----------------------------------------------------------------------//
+    // Ptrs to the per-UserID entries of the "TotalsMap"s below (Map nodes are
+    // stable), so that RFC Totals can be updated incrementally without  Map
+    // look-ups:
+    //
+    struct RFCTotalsRefs
+    {
+      double*   m_riskRFC;            // -> m_totalRiskRFC        [UserID]
+      double*   m_navRFC;             // -> m_totalNAV_RFC        [UserID]
+      double*   m_activeOrdsSzRFC;    // -> m_totalActiveOrdsSzRFC[UserID]
+      int       m_nDeltas;            // Incremental updates since ReCalc
+      long      m_lastUpdate;         // To de-duplicate affected UserIDs
+    };
+
+    // NB: "std::deque" does not move its elements on "push_back", so the refs
+    // to "RFCTotalsRefs" remain valid:
+    struct RFCTotalsIndex
+    {
+      KeyIdxDyn<>               m_index;   // UserID => Idx in "m_refs"
+      std::deque<RFCTotalsRefs> m_refs;
+    };
 
     //-----------------------------------------------------------------------//
     // "TotalsMap": ShM Map: {UserID => double}:                             //
@@ -172,8 +172,12 @@ namespace MAQUETTE
     //=======================================================================//
     // Data Flds:                                                            //
     //=======================================================================//
-    // STATIC "PersistMgr" used to access the ShM-based "RiskMgr" object:
-    static PersistMgr<>               s_pm;
+    // STATIC "PersistMgr"s used to access the ShM-based "RiskMgr" objects, by
+    // ShM Obj Name (see "MkObjName"). Protected by the Mutex, as eg the work-
+    // ers of the parallel BackTest create their private "RiskMgr"s concurren-
+    // tly:
+    static std::map<std::string, std::unique_ptr<PersistMgr<>>> s_pms;
+    static std::mutex                                            s_pmsMutex;
 
     bool    const                     m_isProd;     // Prod or Test Env?
     Ccy     const                     m_RFC;        // Risk-Free Ccy
@@ -187,6 +191,14 @@ namespace MAQUETTE
     int                               m_mdUpdatesPeriodMSec;   // msec!
     mutable utxx::time_val            m_nextMDUpdate;
 
+    // RFC Totals are normally maintained incrementally (by applying the deltas
+    // of the affected "AssetRisks" and "InstrRisks"), so MktData updates need
+    // not be throttled. To eliminate the accumulated drift, the Totals of each
+    // UserID are fully re-calculated after this many incremental updates; if
+    // 0, they are fully re-calculated on each update (the old behaviour):
+    int                               m_rfcReconcilePeriod;
+    mutable long                      m_updateStamp;
+
     // Exposure, NAV and Active Orders Limits:
     // NB:
     // (*) The following params are not marked as "const" because they may act-
@@ -256,19 +268,26 @@ namespace MAQUETTE
     AssetRisksUpdateCB const*         m_arUpdtCB;
 
     // All UserIDs, and UserIDs affected by a particular Update (the latter is
-    // NOT in ShM -- XXX BAD, a ptr would be much safer!):
+    // NOT in ShM; it is a flat vector which is sorted and de-duplicated after
+    // the Update):
     mutable UserIDsSet                m_userIDs;
-    mutable std::set<UserID>*         m_affectedUserIDs;
+    mutable std::vector<UserID>*      m_affectedUserIDs;
 
-    // All "InstrsRisks" and "AssetRisks" for all Users:
-    mutable IRsMap                    m_instrRisks;
-    mutable ARsMap                    m_assetRisks;
+    // All "InstrsRisks" and "AssetRisks" for all Users, and the interned Asset
+    // Symbols => AssetIDs (used in "ARsStore" Keys):
+    mutable IRsStore                  m_instrRisks;
+    mutable ARsStore                  m_assetRisks;
+    mutable KeyIdx<2 * Limits::MaxAssets>
+                                      m_assetIDs;
 
-    // Indices for easy access to the above Maps on OrderBook updates (built in
-    // Non-Shared Memory, as their Keys are transient OrderBook ptrs anyway):
+    // Indices for easy access to the above Stores on OrderBook updates (built
+    // in Non-Shared Memory, as their Keys are transient OrderBook ptrs anyway):
     mutable OBIRMap*                  m_obirMap;
     mutable OBARMap*                  m_obarMap;
 
+    // Short-cuts into the Totals below (again in Non-Shared Memory):
+    mutable RFCTotalsIndex*           m_rfcTotals;
+
     // Total risk exposure in RFC -- RFC cash is NOT counted, by UserID:
     mutable TotalsMap                 m_totalRiskRFC;
 
@@ -293,13 +312,23 @@ namespace MAQUETTE
     // The Ctor is private: It can only be invoked from within the ShM segment
     // mgr;  "a_params" must contain the "ShMSegmSzMB" entry which is the size
     // (in MegaBytes) of that ShM segment which must be sufficient to allocate
-    // the "RiskMgr" obj itself and all of its dynamic ShM data structs:
+    // the "RiskMgr" obj itself and all of its dynamic ShM data structs;
+    // "a_segm_mgr" is the mgr of that segment:
     RiskMgr
     (
       bool                               a_is_prod,
       boost::property_tree::ptree const& a_params,
       spdlog::logger*                    a_logger,
-      int                                a_debug_level
+      int                                a_debug_level,
+      FixedShM::segment_manager*         a_segm_mgr
+    );
+
+    // "MkObjName": Name of the ShM segment of the "RiskMgr" (and the key of
+    // its "PersistMgr"); it depends on the AccountPfx and the Prod/Test mode:
+    static std::string MkObjName
+    (
+      bool                               a_is_prod,
+      boost::property_tree::ptree const& a_params
     );
 
     // The following is required in order to construct  "RiskMgr" objs in ShM,
@@ -371,6 +400,20 @@ namespace MAQUETTE
       int                                a_debug_level = 0
     );
 
+    //-----------------------------------------------------------------------//
+    // "RemovePersistInstance":                                              //
+    //-----------------------------------------------------------------------//
+    // Un-maps the ShM segment of the "RiskMgr" with the given params (all ptrs
+    // to it become invalid), and removes the segment. Returns "false" if there
+    // was no such segment. Used eg for the private "RiskMgr"s of the parallel
+    // BackTest workers:
+    //
+    static bool RemovePersistInstance
+    (
+      bool                               a_is_prod,
+      boost::property_tree::ptree const& a_params
+    );
+
     //-----------------------------------------------------------------------//
     // "Register" (Instrument):                                              //
     //-----------------------------------------------------------------------//
@@ -573,6 +616,25 @@ namespace MAQUETTE
     //
     void ReCalcRFCTotals(UserID a_user_id)   const;
 
+    // "GetRFCTotals": The "RFCTotalsRefs" for a given UserID (created if not
+    // yet there, along with the Totals themselves):
+    //
+    RFCTotalsRefs& GetRFCTotals(UserID a_user_id) const;
+
+    // "ApplyRFCDelta":
+    // Incremental update of the RFC Totals by the change in the contribution
+    // of a given "AssetRisks" (to Risk and NAV) or "InstrRisks" (to ActiveOrds-
+    // Sz) since it was last applied:
+    //
+    void ApplyRFCDelta(AssetRisks const& a_ar, RFCTotalsRefs* a_totals) const;
+    void ApplyRFCDelta(InstrRisks const& a_ir, RFCTotalsRefs* a_totals) const;
+
+    // "OnRFCTotalsUpdated":
+    // Invoked once per UserID affected by an update;  performs the periodic
+    // full re-calculation (drift reconciliation) of the Totals:
+    //
+    void OnRFCTotalsUpdated(UserID a_user_id) const;
+
     //  "IsInOBIRMap", "IsInOBARMap" (for use in "Start" checks):
     bool IsInOBIRMap(OrderBookBase    const* a_ob, InstrRisks* a_ir) const;
     bool IsInOBARMap(OrderBookBase    const* a_ob, AssetRisks* a_ar) const;
@@ -580,9 +642,21 @@ namespace MAQUETTE
     // "InstallXValuators" (see the impl for details):
     void InstallXValuators(AssetRisks const& a_ar);
 
-    // "InstallEmptyMaps": Install empty "IRsMapI" and "ARsMapI" for a given
-    // UserID (typically 0):
-    void InstallEmptyMaps (UserID a_user_id);
+    // "MkIRsKey", "MkARsKey": Keys of the "InstrRisks" and "AssetRisks" Sto-
+    // res. "MkARsKey" returns "false" if the Asset has not been interned yet
+    // (and "a_intern" is not set), or if there are too many Assets:
+    static Key16 MkIRsKey (UserID a_user_id, SecID a_sec_id)
+      { return Key16{a_sec_id, uint64_t(a_user_id)}; }
+
+    bool MkARsKey
+    (
+      UserID           a_user_id,
+      SymKey const&    a_asset,
+      int              a_settl_date,
+      bool             a_intern,
+      Key16*           a_key
+    )
+    const;
 
     //-----------------------------------------------------------------------//
     // Loading the data from a DB (when ShM segment is re-created):          //
@@ -609,8 +683,9 @@ namespace MAQUETTE
     //=======================================================================//
     UserIDsSet const& GetAllUserIDs()    const   { return m_userIDs; }
 
-    IRsMapI    const& GetAllInstrRisks   (UserID   a_user_id) const;
-    ARsMapI    const& GetAllAssetRisks   (UserID   a_user_id) const;
+    // NB: The views are traversed in the order of insertion:
+    IRsUserView       GetAllInstrRisks   (UserID   a_user_id) const;
+    ARsUserView       GetAllAssetRisks   (UserID   a_user_id) const;
 
     // The following method returns both NAVs -- they do not need to be identi-
     // cal but should be reasonable close to each other:
@@ -43,6 +43,7 @@ namespace MAQUETTE
     m_activeOrdsSzA     (0.0),
     m_activeOrdsSzRFC   (0.0),
     m_ordsCount         (0),
+    m_totalsActiveOrdsSzRFC(0.0),
     m_initAttempts      (0)
   {
     assert(IsEmpty());
@@ -71,10 +72,11 @@ namespace MAQUETTE
          (m_userID != 0          || m_ob != nullptr          ||
          AssetRisks::IsValidRate(m_lastRateB)                ||
          !m_ts.empty()           || m_posA            != 0.0 ||
-         IsFinite(m_avgPosPxAB)  || m_realisedPnLB    != 0.0 ||
-         m_unrPnLB        != 0.0 || m_realisedPnLRFC  != 0.0 ||
-         m_apprRealPnLRFC != 0.0 || m_unrPnLRFC       != 0.0 ||
-         m_activeOrdsSzA  != 0.0 || m_activeOrdsSzRFC != 0.0 ||
+         m_realisedPnLB   != 0.0 || m_unrPnLB         != 0.0 ||
+         m_realisedPnLRFC != 0.0 || m_apprRealPnLRFC  != 0.0 ||
+         m_unrPnLRFC      != 0.0 || m_activeOrdsSzA   != 0.0 ||
+         m_activeOrdsSzRFC        != 0.0                     ||
+         double(m_avgPosPxAB)     != 0.0                     ||
          m_ordsCount      != 0 )))
         throw utxx::logic_error
           ("InstrRisks::IsEmpty: Empty settings but non-empty data");
@@ -112,6 +114,7 @@ namespace MAQUETTE
     m_activeOrdsSzA     (0.0),
     m_activeOrdsSzRFC   (0.0),
     m_ordsCount         (0),
+    m_totalsActiveOrdsSzRFC(0.0),
     m_initAttempts      (0)
   {
     // Check what we got. NB: In fld inits above, we guard against segfault if
@@ -564,6 +567,7 @@ namespace MAQUETTE
     m_apprTrdDeltaRFC(0.0),
     m_apprTranssRFC  (0.0),
     m_apprDepossRFC  (0.0),
+    m_totalsNetRFC   (0.0),
     m_initAttempts   (0)
   {
     assert(IsEmpty());
@@ -652,6 +656,7 @@ namespace MAQUETTE
     m_apprTrdDeltaRFC(0.0),
     m_apprTranssRFC  (0.0),
     m_apprDepossRFC  (0.0),
+    m_totalsNetRFC   (0.0),
     m_initAttempts   (0)
   {
     // Verify the settings. NB: SettlDate==0 is allowed:
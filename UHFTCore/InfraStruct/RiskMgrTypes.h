@@ -110,6 +110,9 @@ namespace MAQUETTE
     mutable double         m_activeOrdsSzRFC; // Same in RFC
     mutable long           m_ordsCount;       // Total Orders issued: a Ticker!
 
+    // "m_activeOrdsSzRFC" as last included in the RiskMgr's RFC Totals:
+    mutable double         m_totalsActiveOrdsSzRFC;
+
     // The following is for optimisation only (to prevent multiple unsuccessful
     // init attempts):
     mutable long           m_initAttempts;
@@ -300,6 +303,9 @@ namespace MAQUETTE
     mutable double         m_apprTranssRFC;
     mutable double         m_apprDepossRFC;
 
+    // "GetNetTotalRFC()" as last included in the RiskMgr's RFC Totals:
+    mutable double         m_totalsNetRFC;
+
     // The following is for optimisation only (to prevent multiple unsuccessful
     // init attempts):
     mutable long           m_initAttempts;
@@ -0,0 +1,102 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "InfraStruct/RisksIndex.hpp":                      //
+//     OrderBook => Affected "InstrRisks" or "AssetRisks" Adjacency Index    //
+//===========================================================================//
+// Used by the "RiskMgr" on its hot path (MktData ticks) instead of node-based
+// maps and sets: {OrderBook => [R*]}, where [R*] is a dense array (sorted by
+// address, without duplicates) of "InstrRisks" or "AssetRisks" affected by a
+// tick of that OrderBook, so a tick costs 1 "KeyIdxDyn" probe and a contigu-
+// ous scan. Entries are never removed (only the whole index can be cleared);
+// this is sufficient because "InstrRisks" and "AssetRisks" are never removed
+// from the "RiskMgr" either.
+// Like the OrderBooks themselves, this index is NOT in ShM:
+//
+#pragma  once
+
+#include "Basis/KeyIdx.hpp"
+#include <utxx/compiler_hints.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cassert>
+
+namespace MAQUETTE
+{
+  class OrderBookBase;
+
+  //=========================================================================//
+  // "OBRisksIndex" Class:                                                   //
+  //=========================================================================//
+  // "R" is "InstrRisks" or "AssetRisks":
+  //
+  template<typename R>
+  class OBRisksIndex: public boost::noncopyable
+  {
+  public:
+    using RisksVec = std::vector<R*>;
+
+  private:
+    // OrderBook => Index in "m_adjs":
+    KeyIdxDyn<>            m_index;
+    std::vector<RisksVec>  m_adjs;
+
+    static Key16 MkKey(OrderBookBase const* a_ob)
+      { return Key16{uint64_t(uintptr_t(a_ob)), 0}; }
+
+  public:
+    OBRisksIndex()
+    : m_index(),
+      m_adjs ()
+    {}
+
+    //-----------------------------------------------------------------------//
+    // "Find": Returns NULL if the OrderBook is not indexed:                 //
+    //-----------------------------------------------------------------------//
+    RisksVec const* Find(OrderBookBase const* a_ob) const
+    {
+      int j = m_index.Find(MkKey(a_ob));
+      return utxx::likely(j >= 0) ? &(m_adjs[size_t(j)]) : nullptr;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Insert": Repeated insertions of the same (OrderBook, R) are ignored: //
+    //-----------------------------------------------------------------------//
+    void Insert(OrderBookBase const* a_ob, R* a_r)
+    {
+      assert(a_ob != nullptr && a_r != nullptr);
+      int j = m_index.Find(MkKey(a_ob));
+      if (j < 0)
+      {
+        j = int(m_adjs.size());
+        (void) m_index.Insert(MkKey(a_ob), j);
+        m_adjs.emplace_back();
+      }
+
+      RisksVec& adj = m_adjs[size_t(j)];
+      auto      it  = std::lower_bound(adj.begin(), adj.end(), a_r);
+      if (it == adj.end() || *it != a_r)
+        adj.insert(it, a_r);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Contains":                                                           //
+    //-----------------------------------------------------------------------//
+    bool Contains(OrderBookBase const* a_ob, R* a_r) const
+    {
+      RisksVec const* adj = Find(a_ob);
+      return
+        adj != nullptr && std::binary_search(adj->cbegin(), adj->cend(), a_r);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Clear":                                                              //
+    //-----------------------------------------------------------------------//
+    void Clear()
+    {
+      m_index.Clear();
+      m_adjs .clear();
+    }
+  };
+} // End namespace MAQUETTE
@@ -0,0 +1,308 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "InfraStruct/RisksStore.hpp":                      //
+//       Flat ShM-Resident Store of "InstrRisks" or "AssetRisks" Objs        //
+//===========================================================================//
+// Replaces the nested {UserID => {Key => R}} ShM Maps of the "RiskMgr":
+// (*) The entries ((Key, R) pairs) are allocated in fixed-size Chunks in the
+//     ShM segment, and are never moved or removed (only the whole store can
+//     be cleared), so ptrs to them are stable.  This is required because the
+//     "InstrRisks" and "AssetRisks" point to each other, and the transient
+//     "OBRisksIndex"s point into them;
+// (*) An entry is found by a single "KeyIdxDyn" probe over a 16-byte Key made
+//     by the CallER of the UserID and an interned Instrument or Asset ID;
+// (*) The entries of each UserID are chained in the order of insertion, for
+//     per-UserID traversals (eg "RiskMgr::GetAll{Instr|Asset}Risks");
+// (*) The store itself must be placed in ShM (as a member of the "RiskMgr");
+//     "R" must be default-constructible (giving an Empty obj):
+//
+#pragma  once
+
+#include "Basis/KeyIdx.hpp"
+#include "InfraStruct/PersistMgr.h"
+#include <utxx/compiler_hints.hpp>
+#include <utxx/error.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/container/vector.hpp>
+#include <boost/interprocess/allocators/allocator.hpp>
+#include <boost/interprocess/offset_ptr.hpp>
+#include <iterator>
+#include <utility>
+#include <cassert>
+
+namespace MAQUETTE
+{
+  //=========================================================================//
+  // "RisksStore" Class:                                                     //
+  //=========================================================================//
+  // "K" is the Key as seen by the Clients (eg SecID for "InstrRisks"), stored
+  // along with each "R", in the same way as in a "std::map<K, R>":
+  //
+  template<typename K, typename R>
+  class RisksStore: public boost::noncopyable
+  {
+  public:
+    using value_type = std::pair<K const, R>;
+    using SegmMgr    = FixedShM::segment_manager;
+
+    // Chunk size (in entries) and the max number of Chunks, so the Capacity is
+    // 4M entries:
+    constexpr static int ChunkLog  = 10;
+    constexpr static int ChunkSz   = 1 << ChunkLog;
+    constexpr static int MaxChunks = 4096;
+
+  private:
+    //=======================================================================//
+    // Internal Types:                                                       //
+    //=======================================================================//
+    struct Entry
+    {
+      value_type  m_kv;
+      int         m_next;   // Next entry of the same UserID, or (-1)
+    };
+
+    struct UserChain
+    {
+      int         m_head;
+      int         m_tail;
+      int         m_n;
+    };
+
+    // NB: These Allocators are only used when the Indices grow or a new UserID
+    // appears, ie not on the hot paths:
+    using SlotsAlloc  = BIPC::allocator<KeyIdxSlot, SegmMgr>;
+    using ChainsAlloc = BIPC::allocator<UserChain,  SegmMgr>;
+    using ChainsVec   = boost::container::vector<UserChain, ChainsAlloc>;
+
+    //=======================================================================//
+    // Data Flds:                                                            //
+    //=======================================================================//
+    BIPC::offset_ptr<SegmMgr>  m_sm;
+    BIPC::offset_ptr<Entry>    m_chunks[MaxChunks];
+    int                        m_n;        // Total number of entries
+    KeyIdxDyn<SlotsAlloc>      m_index;    // Key    => Entry Idx
+    KeyIdxDyn<SlotsAlloc>      m_users;    // UserID => Idx in "m_chains"
+    ChainsVec                  m_chains;
+
+    //=======================================================================//
+    // Internal Methods:                                                     //
+    //=======================================================================//
+    Entry& GetEntry(int a_i) const
+    {
+      assert(0 <= a_i && a_i < m_n);
+      return m_chunks[a_i >> ChunkLog][a_i & (ChunkSz - 1)];
+    }
+
+    static Key16 MkUserKey(UserID a_user_id)
+      { return Key16{uint64_t(a_user_id), 0}; }
+
+    //-----------------------------------------------------------------------//
+    // "Emplace": Appends a new entry (the Key must not be there yet):       //
+    //-----------------------------------------------------------------------//
+    R* Emplace(Key16 const& a_key, UserID a_user_id, K const& a_k, R const& a_r)
+    {
+      if (utxx::unlikely(m_n >= MaxChunks * ChunkSz))
+        throw utxx::runtime_error("RisksStore::Emplace: Capacity exceeded");
+
+      int    c   = m_n >> ChunkLog;
+      if (utxx::unlikely((m_n & (ChunkSz - 1)) == 0 && m_chunks[c] == nullptr))
+        m_chunks[c] =
+          static_cast<Entry*>(m_sm->allocate(sizeof(Entry) * size_t(ChunkSz)));
+
+      int    i   = m_n;
+      Entry* e   = new (m_chunks[c].get() + (i & (ChunkSz - 1)))
+                   Entry{value_type(a_k, a_r), -1};
+      (void) m_index.Insert(a_key, i);
+      ++m_n;
+
+      // Chain it to the UserID:
+      Key16 ukey = MkUserKey(a_user_id);
+      int   u    = m_users.Find(ukey);
+      if (utxx::unlikely(u < 0))
+      {
+        u = int(m_chains.size());
+        m_chains.push_back(UserChain{i, i, 1});
+        (void) m_users.Insert(ukey, u);
+      }
+      else
+      {
+        UserChain& chain = m_chains[size_t(u)];
+        GetEntry(chain.m_tail).m_next = i;
+        chain.m_tail = i;
+        ++chain.m_n;
+      }
+      return &(e->m_kv.second);
+    }
+
+  public:
+    //=======================================================================//
+    // Iterators:                                                            //
+    //=======================================================================//
+    // Over all entries (in the order of insertion) or over the entries of one
+    // UserID ("ByUser"); the End is always (-1):
+    //
+    template<bool ByUser, typename V>
+    class Iter
+    {
+    private:
+      RisksStore const* m_store;
+      int               m_i;
+
+    public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type        = V;
+      using difference_type   = std::ptrdiff_t;
+      using pointer           = V*;
+      using reference         = V&;
+
+      Iter(RisksStore const* a_store, int a_i)
+      : m_store(a_store),
+        m_i    (a_i)
+      {}
+
+      V& operator* () const { return   m_store->GetEntry(m_i).m_kv;  }
+      V* operator->() const { return &(m_store->GetEntry(m_i).m_kv); }
+
+      Iter& operator++()
+      {
+        m_i =
+          ByUser
+          ? m_store->GetEntry(m_i).m_next
+          : ((m_i + 1 < m_store->m_n) ? (m_i + 1) : -1);
+        return *this;
+      }
+
+      Iter operator++(int) { Iter res = *this; ++(*this); return res; }
+
+      bool operator==(Iter const& a_right) const
+        { return m_i == a_right.m_i; }
+      bool operator!=(Iter const& a_right) const
+        { return m_i != a_right.m_i; }
+    };
+
+    using iterator = Iter<false, value_type>;
+
+    //-----------------------------------------------------------------------//
+    // "UserView": Read-only view of the entries of one UserID:              //
+    //-----------------------------------------------------------------------//
+    // Provides the same traversal interface as the former per-UserID Maps:
+    //
+    class UserView
+    {
+    private:
+      RisksStore const* m_store;
+      int               m_head;
+      int               m_n;
+
+    public:
+      using value_type     = typename RisksStore::value_type;
+      using const_iterator = Iter<true, value_type const>;
+
+      UserView(RisksStore const* a_store, int a_head, int a_n)
+      : m_store(a_store),
+        m_head (a_head),
+        m_n    (a_n)
+      {}
+
+      const_iterator begin () const { return const_iterator(m_store, m_head); }
+      const_iterator end   () const { return const_iterator(m_store, -1);     }
+      const_iterator cbegin() const { return begin(); }
+      const_iterator cend  () const { return end  (); }
+      size_t         size  () const { return size_t(m_n); }
+      bool           empty () const { return m_n == 0;    }
+    };
+
+    //=======================================================================//
+    // Non-Default Ctor, Dtor:                                               //
+    //=======================================================================//
+    explicit RisksStore(SegmMgr* a_sm)
+    : m_sm    (a_sm),
+      m_chunks(),
+      m_n     (0),
+      m_index (4 * ChunkSz, SlotsAlloc(a_sm)),
+      m_users (64,          SlotsAlloc(a_sm)),
+      m_chains(ChainsAlloc(a_sm))
+    {
+      assert(m_sm != nullptr);
+      for (int c = 0; c < MaxChunks; ++c)
+        m_chunks[c] = nullptr;
+    }
+
+    ~RisksStore() { Clear(); }
+
+    //=======================================================================//
+    // Look-Ups and Insertions:                                              //
+    //=======================================================================//
+    //-----------------------------------------------------------------------//
+    // "Find": Returns NULL if not found:                                    //
+    //-----------------------------------------------------------------------//
+    R* Find(Key16 const& a_key) const
+    {
+      int i = m_index.Find(a_key);
+      return utxx::likely(i >= 0) ? &(GetEntry(i).m_kv.second) : nullptr;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "FindOrInsert":                                                       //
+    //-----------------------------------------------------------------------//
+    // If not found, a new Empty "R" is inserted (with the Client Key "a_k"):
+    //
+    R* FindOrInsert(Key16 const& a_key, UserID a_user_id, K const& a_k)
+    {
+      R* res = Find(a_key);
+      return
+        utxx::likely(res != nullptr)
+        ? res
+        : Emplace(a_key, a_user_id, a_k, R());
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Insert": Returns NULL (and does nothing) if the Key is already there://
+    //-----------------------------------------------------------------------//
+    R* Insert(Key16 const& a_key, UserID a_user_id, K const& a_k, R const& a_r)
+    {
+      return
+        utxx::unlikely(m_index.Find(a_key) >= 0)
+        ? nullptr
+        : Emplace(a_key, a_user_id, a_k, a_r);
+    }
+
+    //=======================================================================//
+    // Traversals:                                                           //
+    //=======================================================================//
+    // All entries:
+    iterator begin() { return iterator(this, (m_n > 0) ? 0 : -1); }
+    iterator end  () { return iterator(this, -1); }
+
+    // Entries of a given UserID (the view is empty if there are none):
+    UserView GetUser(UserID a_user_id) const
+    {
+      int u = m_users.Find(MkUserKey(a_user_id));
+      if (u < 0)
+        return UserView(this, -1, 0);
+      UserChain const& chain = m_chains[size_t(u)];
+      return UserView(this, chain.m_head, chain.m_n);
+    }
+
+    int Size() const { return m_n; }
+
+    //=======================================================================//
+    // "Clear": Removes all entries and releases the Chunks:                 //
+    //=======================================================================//
+    void Clear()
+    {
+      for (int i = 0; i < m_n; ++i)
+        GetEntry(i).~Entry();
+
+      for (int c = 0; c < MaxChunks && m_chunks[c] != nullptr; ++c)
+      {
+        m_sm->deallocate(m_chunks[c].get());
+        m_chunks[c] = nullptr;
+      }
+      m_n = 0;
+      m_index .Clear();
+      m_users .Clear();
+      m_chains.clear();
+    }
+  };
+} // End namespace MAQUETTE
@@ -4,14 +4,47 @@
 //           Mgr for a ShM Segment containing all "SecDefD" objs             //
 //===========================================================================//
 #include "InfraStruct/SecDefsMgr.h"
-#include <boost/algorithm/string.hpp>
+#include "Basis/XXHash.hpp"
 #include <string>
-#include <vector>
+#include <cstring>
 
 using namespace std;
 
 namespace MAQUETTE
 {
+  namespace
+  {
+    //=======================================================================//
+    // "MkFullKey":                                                          //
+    //=======================================================================//
+    // 128-bit hash of the (Symbol, Exchange, Segment, Tenor, Tenor2) key, com-
+    // puted over the 0-padded "SymKey" images of the components. Returns "fa-
+    // lse" if any component does not fit into a "SymKey" (and thus cannot be
+    // found at all):
+    //
+    bool MkFullKey
+    (
+      char const* a_symbol,
+      char const* a_exchange,
+      char const* a_segm,
+      char const* a_tenor,
+      char const* a_tenor2,
+      Key16*      a_res
+    )
+    {
+      Key16 parts[5];
+      if (utxx::unlikely
+         (!MkKey16(a_symbol, parts)    || !MkKey16(a_exchange, parts + 1) ||
+          !MkKey16(a_segm,   parts + 2)|| !MkKey16(a_tenor,    parts + 3) ||
+          !MkKey16(a_tenor2, parts + 4)))
+        return false;
+
+      a_res->m_lo = XXH64(parts, sizeof(parts),  XXHSeed);
+      a_res->m_hi = XXH64(parts, sizeof(parts), ~XXHSeed);
+      return true;
+    }
+  }
+
   //=========================================================================//
   // "PersistMgr" Obj for the "SecDefsMgr":                                  //
   //=========================================================================//
@@ -39,10 +72,22 @@ namespace MAQUETTE
       (
         objName.data(),
         nullptr,
-        size_t(1.1 * double(sizeof(SecDefsVec)))
+        size_t(1.1 * double(sizeof(SecDefsMgr)))
       );
     assert(!s_pm.IsEmpty());
 
+    // If the Segment contains a "SecDefsMgr" of an older ShM Layout Version
+    // (stored under another name), it cannot be used, and we must not create
+    // another one next to it either:
+    if (s_pm.GetSegm()->find<SecDefsMgr>(SecDefsMgrON()).first == nullptr)
+      for (auto it  = s_pm.GetSegm()->named_begin();
+                it != s_pm.GetSegm()->named_end(); ++it)
+        if (utxx::unlikely(strncmp(it->name(), "SecDefsMgr", 10) == 0))
+          throw utxx::runtime_error
+                ("SecDefsMgr::GetPersistInstance: Found ", it->name(),
+                 " instead of ", SecDefsMgrON(), " (old ShM Layout): The ShM "
+                 "segment ", objName, " must be re-created");
+
     // Find or construct the "SecDefsMgr" inside the ShM Segment:
     SecDefsMgr* res =
       s_pm.GetSegm()->find_or_construct<SecDefsMgr>(SecDefsMgrON())(a_is_prod);
@@ -63,29 +108,23 @@ namespace MAQUETTE
     if (utxx::unlikely(a_sec_id == 0))
       throw utxx::badarg_error("SecDefsMgr::FindSecDefOpt: Empty SecID");
 
-    // If OK: Get the 1st occurrence of this SecID:
-    auto selector =
-        [a_sec_id](SecDefD const&  a_curr)-> bool
-        { return a_curr.m_SecID == a_sec_id; };
-
-    auto cit =
-      boost::container::find_if(m_secDefs.cbegin(), m_secDefs.cend(), selector);
+    // If OK: Get the 1st occurrence of this SecID via the Hash Index:
+    int dups = 0;
+    int idx  = m_bySecID.Find(MkKey16(a_sec_id), &dups);
 
     // If not found at all, return NULL (this is not an error):
-    if (cit == m_secDefs.cend())
+    if (idx < 0)
       return nullptr;
 
-    // If found: check UNIQUENESS. This is not strictly necessary, but provided
-    // for extra safety (this method is NOT time-critical):
-    auto twit =
-      boost::container::find_if(next(cit), m_secDefs.cend(), selector);
-
-    if (utxx::unlikely(twit != m_secDefs.cend()))
+    // If found: check UNIQUENESS. This is not strictly necessary (as "Add"
+    // does not create Dups), but provided for extra safety:
+    if (utxx::unlikely(dups != 0))
       throw utxx::runtime_error
             ("SecDefsMgr::FindSecDefOpt: SecID=", a_sec_id, ": Not Unique");
 
     // If OK: return a raw ptr to the SecDef found:
-    return &(*cit);
+    assert(idx < int(m_secDefs.size()));
+    return m_secDefs.data() + idx;
   }
 
   //=========================================================================//
@@ -102,28 +141,45 @@ namespace MAQUETTE
     if (utxx::unlikely(a_instr_name == nullptr || *a_instr_name == '\0'))
       return nullptr;
 
-    // Generic Case: Parse "a_instr_name" (NB: this method is NOT performance-
-    // critical, so using "string"s and "boost::split" is OK):
-    vector<string> nameParts;
-    string         name(a_instr_name);
-    boost::split  (nameParts, name, boost::is_any_of("-|"));
-    // NB: Do not use '_' or ':', as these chars may be part of the Symbol!
+    // Split "a_instr_name" into at most 5 parts (NB: this is done without any
+    // dynamic memory allocation, as the method may be invoked on the critical
+    // path, eg by OMCs):
+    char        nameParts[5][SymKeySz];
+    int         n    = 0;
+    char const* from = a_instr_name;
+    while (true)
+    {
+      // NB: Do not use '_' or ':', as these chars may be part of the Symbol!
+      char const* to  = from + strcspn(from, "-|");
+      size_t      len = size_t(to - from);
+
+      // If there are too many parts, it is not a valid InstrName format; and
+      // a part which does not fit into "SymKey" cannot be found anyway:
+      if (utxx::unlikely(n == 5 || len >= SymKeySz))
+        return nullptr;
 
-    int    n = int(nameParts.size());
+      memcpy(nameParts[n], from, len);
+      nameParts[n][len] = '\0';
+      ++n;
+
+      if (*to == '\0')
+        break;
+      from = to + 1;
+    }
     assert(n >= 1);
-    if (utxx::unlikely(n < 2 || n > 5))
+    if (utxx::unlikely(n < 2))
       return nullptr;   // This is not a valid InstrName format
 
     // "Symbol" and "Exchange" are compulsory:
-    char const* symbol   = nameParts[0].data();
-    char const* exchange = nameParts[1].data();
+    char const* symbol   = nameParts[0];
+    char const* exchange = nameParts[1];
     if (utxx::unlikely(*symbol == '\0' || *exchange == '\0'))
       return nullptr;   // Again, this is not a valid InstrName format
 
     // Segment/SessionID, Tenor and Tenor2 are optional:
-    char const* segm   = (n >= 3) ? nameParts[2].data() : "";
-    char const* tenor  = (n >= 4) ? nameParts[3].data() : "";
-    char const* tenor2 = (n == 5) ? nameParts[4].data() : "";
+    char const* segm   = (n >= 3) ? nameParts[2] : "";
+    char const* tenor  = (n >= 4) ? nameParts[3] : "";
+    char const* tenor2 = (n == 5) ? nameParts[4] : "";
 
     // Perform full search by Symbol, Segment, Tenor and Tenor2:
     return FindSecDefOpt (symbol, exchange, segm, tenor, tenor2);
@@ -150,37 +206,39 @@ namespace MAQUETTE
         a_segm      == nullptr ||  a_tenor  == nullptr || a_tenor2 == nullptr))
       throw utxx::badarg_error("SecDefsMgr::FindSecDefOpt(5): Invalid arg(s)");
 
-    auto selector =
-        [a_symbol, a_exchange, a_segm, a_tenor, a_tenor2]
-        (SecDefD const& a_curr) -> bool
-        {
-          return
-            (strcmp(a_symbol,   a_curr.m_Symbol      .data()) == 0 &&
-             strcmp(a_exchange, a_curr.m_Exchange    .data()) == 0 &&
-             strcmp(a_segm,     a_curr.m_SessOrSegmID.data()) == 0 &&
-             strcmp(a_tenor,    a_curr.m_Tenor       .data()) == 0 &&
-             strcmp(a_tenor2,   a_curr.m_Tenor2      .data()) == 0);
-        };
-    // Try to find the 1st occurrence:
-    auto cit =
-      boost::container::find_if(m_secDefs.cbegin(), m_secDefs.cend(), selector);
+    // Look up the Full Key hash:
+    Key16 key;
+    if (utxx::unlikely
+       (!MkFullKey(a_symbol, a_exchange, a_segm, a_tenor, a_tenor2, &key)))
+      return nullptr;
+
+    int dups = 0;
+    int idx  = m_byFullKey.Find(key, &dups);
 
     // Not found?
-    if (utxx::unlikely(cit == m_secDefs.cend()))
+    if (utxx::unlikely(idx < 0))
       return nullptr;
 
-    // Now check UNIQUENESS: Search from the next entry on, to make sure the
-    // Symbol does not occur twice:
-    auto twit =
-      boost::container::find_if(next(cit), m_secDefs.cend(), selector);
-
-    if (utxx::unlikely(twit != m_secDefs.cend()))
+    // Check UNIQUENESS (again, "Add" does not create Dups):
+    if (utxx::unlikely(dups != 0))
       throw utxx::logic_error
             ("SecDefsMgr::FindSecDefOpt(5): Symbol=",  a_symbol, ", Segment=",
              a_segm, ", Tenor=", a_tenor, ", Tenor2=", a_tenor2,
              ": Not Unique");
-    // If OK:
-    return &(*cit);
+
+    // Verify the Full Key (a mismatch would mean a hash collision with some
+    // other SecDef, ie the one requested does not exist):
+    assert(idx < int(m_secDefs.size()));
+    SecDefD const* res = m_secDefs.data() + idx;
+    return
+      (utxx::likely
+      (strcmp(a_symbol,   res->m_Symbol      .data()) == 0 &&
+       strcmp(a_exchange, res->m_Exchange    .data()) == 0 &&
+       strcmp(a_segm,     res->m_SessOrSegmID.data()) == 0 &&
+       strcmp(a_tenor,    res->m_Tenor       .data()) == 0 &&
+       strcmp(a_tenor2,   res->m_Tenor2      .data()) == 0))
+      ? res
+      : nullptr;
   }
 
   //=========================================================================//
@@ -245,9 +303,28 @@ namespace MAQUETTE
     if (utxx::likely(exist0 == nullptr))
     {
       assert(exist1 == nullptr);
+      // Compute the Full Key hash first (it must be new, otherwise there is a
+      // hash collision with another SecDef):
+      Key16 fullKey;
+      DEBUG_ONLY(bool ok =)
+        MkFullKey(instr.m_Symbol.data(),       instr.m_Exchange.data(),
+                  instr.m_SessOrSegmID.data(), instr.m_Tenor   .data(),
+                  instr.m_Tenor2.data(),       &fullKey);
+      assert(ok);
+
+      if (utxx::unlikely(m_byFullKey.Find(fullKey) >= 0))
+        throw utxx::logic_error
+              ("SecDefsMgr::Add: Full Key Hash Collision for ",
+               instr.m_FullName.data());
+
       // Append a newly-constructed "instr". XXX: Incurres copying overhead:
+      int idx = int(m_secDefs.size());
       m_secDefs.push_back(instr);
       exist0 = exist1 = &(m_secDefs.back());
+
+      // Extend the Hash Indices:
+      (void) m_bySecID  .Insert(MkKey16(instr.m_SecID), idx);
+      (void) m_byFullKey.Insert(fullKey,                idx);
     }
     else
     {
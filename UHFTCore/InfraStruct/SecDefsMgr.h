@@ -6,6 +6,7 @@
 #pragma once
 
 #include "Basis/SecDefs.h"
+#include "Basis/KeyIdx.hpp"
 #include "Connectors/EConnector.h"
 #include "InfraStruct/PersistMgr.h"
 #include "InfraStruct/StaticLimits.h"
@@ -37,6 +38,14 @@ namespace MAQUETTE
   private:
     SecDefsVec           m_secDefs;
 
+    // Hash Indices of "m_secDefs" (positional idxs): by SecID, and by the Full
+    // Key (Symbol, Exchange, Segment, Tenor, Tenor2).  The latter is indexed
+    // by a 128-bit hash of the Full Key, so the SecDef found is then verified
+    // against the Full Key itself. Both are extended by "Add" only:
+    using  SecDefsIdx  = KeyIdx<2 * Limits::MaxInstrs>;
+    SecDefsIdx           m_bySecID;
+    SecDefsIdx           m_byFullKey;
+
     // The following is required in order to construct "SecDefsMgr" objs in ShM,
     // because the above Ctor is private (to prevent on-stack and on-heap  ctor
     // invocations):
@@ -47,7 +56,12 @@ namespace MAQUETTE
     //-----------------------------------------------------------------------//
     // Names of Persistent Objs:                                             //
     //-----------------------------------------------------------------------//
-    constexpr static char const* SecDefsMgrON() { return "SecDefsMgr"; }
+    // The name carries the ShM Layout Version of "SecDefsMgr", and MUST be
+    // changed whenever that layout changes; a "SecDefsMgr" of an older layout
+    // is then NOT re-attached to (see "GetPersistInstance"):
+    // ".2": "KeyIdx" Hash Indices by SecID and by Full Key:
+    //
+    constexpr static char const* SecDefsMgrON() { return "SecDefsMgr.2"; }
 
   private:
     //-----------------------------------------------------------------------//
@@ -58,7 +72,10 @@ namespace MAQUETTE
     friend class EConnector;
 
     SecDefsMgr(bool a_is_prod)
-    : m_isProd(a_is_prod)
+    : m_isProd   (a_is_prod),
+      m_secDefs  (),
+      m_bySecID  (),
+      m_byFullKey()
     {}
 
     // Default Ctor is deleted altogether:
@@ -0,0 +1,87 @@
+// vim:ts=2:et
+//===========================================================================//
+//                      "Protocols/FAST/GenSupport.hpp":                     //
+//     Run-Time Support for FAST Decoders Generated from XML Templates       //
+//===========================================================================//
+// The decoders are generated by "Tools/MkFASTDecoders.py" as function templa-
+// tes parameterised by the Msg type, so that the same "Msgs_*" structs as for
+// the hand-written decoders can be filled in. As with "Macros.h", a Msg fld
+// which is absent or STATIC in the Msg type is not used by the Strategy, and
+// is decoded with SkipVal=true; here this is decided by "FAST_GEN_HAS" inside
+// "if constexpr", so the flds may be removed from the Msg types altogether:
+//
+#pragma  once
+
+#include "Protocols/FAST/LowLevel.hpp"
+#include "Basis/BaseTypes.hpp"
+#include <utxx/compiler_hints.hpp>
+#include <utxx/error.hpp>
+#include <type_traits>
+#include <climits>
+#include <cstdint>
+
+//===========================================================================//
+// "FAST_GEN_HAS": Is "Fld" a non-static data member of "T"?                 //
+//===========================================================================//
+#ifdef  FAST_GEN_HAS
+#undef  FAST_GEN_HAS
+#endif
+#define FAST_GEN_HAS(T, Fld) \
+  (requires \
+    { requires std::is_member_object_pointer_v<decltype(&T::Fld)>; })
+
+namespace MAQUETTE
+{
+namespace FAST
+{
+  //=========================================================================//
+  // "GenSkipEntry":                                                         //
+  //=========================================================================//
+  // Used in place of a Sequence Entry if the Sequence itself is not in the
+  // Msg type: then all flds of the Entry are skipped:
+  //
+  struct GenSkipEntry {};
+
+  //=========================================================================//
+  // "GenSeqEntries":                                                        //
+  //=========================================================================//
+  // Prepares the storage for "a_n" Sequence Entries and returns the ptr to the
+  // 1st one. The Entries are NOT zeroed-out: the generated code sets all used
+  // flds of each Entry explicitly:
+  // (1) Fixed-size array (eg "m_MDEntries[MaxMDEs]"):
+  //
+  template<typename E, size_t N>
+  inline E* GenSeqEntries(E (&a_arr)[N], uint32_t a_n, char const* a_name)
+  {
+    if (utxx::unlikely(a_n > N))
+      throw utxx::runtime_error
+            ("FAST::GenSeqEntries(", a_name, "): Too many Entries: ", a_n);
+    return a_arr;
+  }
+
+  // (2) Vector-like containers (incl "boost::container::static_vector"):
+  //
+  template<typename V>
+  inline typename V::value_type* GenSeqEntries
+    (V& a_vec, uint32_t a_n, char const* a_name)
+  {
+    if (utxx::unlikely(a_n > a_vec.max_size()))
+      throw utxx::runtime_error
+            ("FAST::GenSeqEntries(", a_name, "): Too many Entries: ", a_n);
+    a_vec.resize(a_n);
+    return a_vec.data();
+  }
+
+  //=========================================================================//
+  // "GenAddDelta": Integer Delta Operator:                                  //
+  //=========================================================================//
+  // NB: The Delta itself is always signed, even if the target type is not:
+  //
+  template<typename T>
+  inline T GenAddDelta(T a_base, int64_t a_delta)
+  {
+    static_assert(std::is_integral_v<T>);
+    return T(int64_t(a_base) + a_delta);
+  }
+} // End namespace FAST
+} // End namespace MAQUETTE
@@ -6,6 +6,7 @@
 #pragma  once
 
 #include "Basis/Maths.hpp"
+#include "Protocols/FAST/StopBits.hpp"
 #include <utxx/compiler_hints.hpp>
 #include <utxx/error.hpp>
 #include <type_traits>
@@ -112,9 +113,11 @@ namespace FAST
   //=========================================================================//
   // "GetInteger":                                                           //
   //=========================================================================//
-  // (Signed or unsigned, NULLable or non-NULLable Integer):
+  // (Signed or unsigned, NULLable or non-NULLable Integer). Multi-byte values
+  // of up to 8 bytes are assembled branch-free (see "StopBits.hpp") unless
+  // "UseSIMD" is explicitly set to "false":
   //
-  template<bool SkipVal, typename T>
+  template<bool SkipVal, typename T, bool UseSIMD = HasSIMD>
   inline typename std::enable_if<std::is_integral_v<T>, char const*>::type
   GetInteger
   (
@@ -162,6 +165,25 @@ namespace FAST
     //
     char const* curr = a_buff + 1;
 
+    // Fast path: locate the stop bit within the next 8 bytes at once, and get
+    // all 7-bit groups in one go. Longer values, and those too close to the
+    // end of the buffer, fall back to the per-byte loop below:
+    if constexpr (UseSIMD)
+      if (!done && utxx::likely(a_end - a_buff >= 8))
+      {
+        uint64_t w = StopBits::Load8(a_buff);
+        int      n = StopBits::Len8 (w);
+        if (utxx::likely(n != 0))
+        {
+          // NB: For n==8 and a 32-bit "T", the high bits are discarded, just
+          // as they are by the shifts below:
+          if constexpr (!SkipVal)
+            lres = T(StopBits::Groups7(w, n));
+          curr   = a_buff + n;
+          done   = true;
+        }
+      }
+
     for (; !done && curr < a_end; ++curr)
       if constexpr (!SkipVal)
       {
@@ -391,9 +413,11 @@ namespace FAST
   // String is copied into; the string is then 0-terminated;  "a_act_len" is its
   // actual length (WITHOUT the terminating 0 -- just like "strlen");
   // NB: "a_act_len" may be smaller than the total number of bytes consumed from
-  // the input stream because of treatment of 0-prefixes and NULL strings:
+  // the input stream because of treatment of 0-prefixes and NULL strings.
+  // Unless "UseSIMD" is "false", the stop bit is located 16 bytes at a time,
+  // and the string is then copied in one go:
   //
-  template<bool SkipVal>
+  template<bool SkipVal, bool UseSIMD = HasSIMD>
   inline char const* GetASCII
   (
     bool        a_nullable,
@@ -427,6 +451,44 @@ namespace FAST
     int  stop  = std::min<int>(a_max_len - 1, int(a_end - a_buff));
     assert(stop >= 1);
 
+    if constexpr (UseSIMD)
+    {
+      // Most strings are short: first try the next 8 bytes as a word. Then
+      // all 8 bytes (with the top bits cleared) can be stored at once if the
+      // output buffer is large enough; the bytes after the stop byte are over-
+      // written by the terminator or ignored:
+      if (utxx::likely(a_end - a_buff >= 8 && a_max_len >= 8))
+      {
+        uint64_t w  = StopBits::Load8(a_buff);
+        int      n8 = StopBits::Len8 (w);
+        if (utxx::likely(n8 != 0 && n8 <= stop))
+        {
+          n    = n8;
+          done = true;
+          if constexpr (!SkipVal)
+          {
+            w &= StopBits::DataMask8;
+            memcpy(a_res, &w, 8);
+          }
+        }
+      }
+      // Otherwise, locate the stop bit 16 bytes at a time:
+      if (!done)
+      {
+        char const* to = a_buff + stop;
+        char const* sb = StopBits::Find<true>(a_buff, to, a_end);
+        done           = (sb < to);
+        n              = int(sb - a_buff) + int(done);
+
+        if constexpr (!SkipVal)
+          if (utxx::likely(done))
+          {
+            memcpy(a_res, a_buff, size_t(n));
+            a_res[n-1] &= '\x7f';   // Clear the stop bit
+          }
+      }
+    }
+    else
     for (; n < stop && !done; ++n)
       if constexpr (!SkipVal)
       {
@@ -0,0 +1,222 @@
+// vim:ts=2:et
+//===========================================================================//
+//                       "Protocols/FAST/StopBits.hpp":                      //
+//      Vectorised Stop-Bit Scanning and 7-Bit Group Assembly for FAST       //
+//===========================================================================//
+// Used by "GetInteger" and "GetASCII" (see "LowLevel.hpp") instead of per-byte
+// loops, and for splitting a whole msg into fld boundaries in one pass:
+// (*) Integers: a 8-byte word is loaded, its stop bits are located with a
+//     mask and "ctz", and the 7-bit groups are assembled branch-free (with
+//     "pext" if BMI2 is available at compile time, or with 3 shift-and-mask
+//     steps otherwise). Integers longer than 8 bytes, and those within the
+//     last 8 bytes of the buffer, still go through the per-byte loop;
+// (*) Strings and msg splitting: 16 bytes at a time with SSE2 "movemask"
+//     (32 with AVX2), with a scalar tail. "SplitFields" selects the AVX2 path
+//     at RUN TIME if the code was not compiled for AVX2 but the CPU has it.
+// As in "Basis/SIMDScans.hpp", the vectorised paths are selected at compile
+// time, and "UseSIMD" can be set to "false" explicitly to force the scalar
+// path (eg for benchmarking):
+//
+#pragma  once
+
+#include <utxx/compiler_hints.hpp>
+#include <cstring>
+#include <cstdint>
+#include <cassert>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace MAQUETTE
+{
+namespace FAST
+{
+# if defined(__SSE2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  constexpr bool HasSIMD = true;
+# else
+  constexpr bool HasSIMD = false;
+# endif
+
+  namespace StopBits
+  {
+    constexpr uint64_t StopMask8 = 0x8080808080808080UL;
+    constexpr uint64_t DataMask8 = 0x7f7f7f7f7f7f7f7fUL;
+
+    //=======================================================================//
+    // "Len8":                                                               //
+    //=======================================================================//
+    // Length (incl the stop byte) of the fld starting at "a_buff", if the stop
+    // bit is within the 8-byte word "a_w" loaded from there; 0 otherwise:
+    //
+    inline int Len8(uint64_t a_w)
+    {
+      uint64_t stops = a_w & StopMask8;
+      return
+        utxx::likely(stops != 0) ? (__builtin_ctzll(stops) / 8 + 1) : 0;
+    }
+
+    inline uint64_t Load8(char const* a_buff)
+    {
+      uint64_t w;
+      memcpy(&w, a_buff, 8);
+      return w;
+    }
+
+    //=======================================================================//
+    // "Groups7":                                                            //
+    //=======================================================================//
+    // The unsigned value of the "a_n" (1..8) 7-bit groups at the beginning of
+    // the (little-endian) word "a_w", the 1st group being the most signific-
+    // ant one:
+    //
+    inline uint64_t Groups7(uint64_t a_w, int a_n)
+    {
+      assert(1 <= a_n && a_n <= 8);
+      // Make the 1st byte the most significant one, and drop the bytes after
+      // the stop byte:
+      uint64_t x = __builtin_bswap64(a_w) >> (8 * (8 - a_n));
+#     ifdef __BMI2__
+      return _pext_u64(x, DataMask8);
+#     else
+      x &= DataMask8;
+      x  = ((x & 0x7f007f007f007f00UL) >> 1) | (x & 0x007f007f007f007fUL);
+      x  = ((x & 0x3fff00003fff0000UL) >> 2) | (x & 0x00003fff00003fffUL);
+      x  = ((x & 0x0fffffff00000000UL) >> 4) | (x & 0x000000000fffffffUL);
+      return x;
+#     endif
+    }
+
+    //=======================================================================//
+    // "Find":                                                               //
+    //=======================================================================//
+    // Returns the ptr to the first byte in [a_from, a_to) with the stop bit
+    // set, or "a_to" if there is none. Bytes up to "a_safe_end" (>= a_to) can
+    // be loaded (but are not looked at beyond "a_to"):
+    //
+    template<bool UseSIMD = HasSIMD>
+    inline char const* Find
+      (char const* a_from, char const* a_to, char const* a_safe_end)
+    {
+      assert(a_from <= a_to && a_to <= a_safe_end);
+      char const* p = a_from;
+
+#     ifdef __SSE2__
+      if constexpr (UseSIMD)
+        for (; p < a_to && a_safe_end - p >= 16; p += 16)
+        {
+          unsigned m = unsigned(_mm_movemask_epi8
+            (_mm_loadu_si128(reinterpret_cast<__m128i const*>(p))));
+          if (a_to - p < 16)
+            m &= (1U << (a_to - p)) - 1;
+          if (m != 0)
+            return p + __builtin_ctz(m);
+        }
+#     endif
+      // Scalar path, or the remaining tail:
+      for (; p < a_to; ++p)
+        if (*p & '\x80')
+          return p;
+      return a_to;
+    }
+
+    //=======================================================================//
+    // "SplitFields":                                                        //
+    //=======================================================================//
+    // Pre-splits the msg in [a_buff, a_end) into flds, by finding ALL stop
+    // bits in one pass: "a_ends[k]" is the offset (from "a_buff") just beyond
+    // the k-th fld (ie beyond its stop byte). Returns the number of flds, or
+    // (-1) if there are more than "a_max" of them. NB: This is only valid for
+    // msgs without ByteVectors (whose bodies do not contain stop bits):
+    //
+    namespace Detail
+    {
+      inline int Scatter
+        (unsigned a_m, int a_base, uint16_t* a_ends, int a_k, int a_max)
+      {
+        for (; a_m != 0; a_m &= a_m - 1)
+        {
+          if (utxx::unlikely(a_k >= a_max))
+            return -1;
+          a_ends[a_k++] = uint16_t(a_base + __builtin_ctz(a_m) + 1);
+        }
+        return a_k;
+      }
+
+      inline int SplitTail
+        (char const* a_buff, int a_from, int a_len, uint16_t* a_ends, int a_k,
+         int a_max)
+      {
+        for (int i = a_from; a_k >= 0 && i < a_len; ++i)
+          if (a_buff[i] & '\x80')
+            a_k = (a_k < a_max) ? (a_ends[a_k] = uint16_t(i + 1), a_k + 1)
+                                : -1;
+        return a_k;
+      }
+
+#     ifdef __SSE2__
+      inline int SplitSSE2
+        (char const* a_buff, int a_len, uint16_t* a_ends, int a_max)
+      {
+        int k = 0, i = 0;
+        for (; k >= 0 && i + 16 <= a_len; i += 16)
+          k = Scatter
+              (unsigned(_mm_movemask_epi8
+                 (_mm_loadu_si128(reinterpret_cast<__m128i const*>
+                 (a_buff + i)))),
+               i, a_ends, k, a_max);
+        return SplitTail(a_buff, i, a_len, a_ends, k, a_max);
+      }
+#     endif
+
+#     if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#     define MAQUETTE_FAST_SPLIT_AVX2 1
+      __attribute__((target("avx2")))
+      inline int SplitAVX2
+        (char const* a_buff, int a_len, uint16_t* a_ends, int a_max)
+      {
+        int k = 0, i = 0;
+        for (; k >= 0 && i + 32 <= a_len; i += 32)
+          k = Scatter
+              (unsigned(_mm256_movemask_epi8
+                 (_mm256_loadu_si256(reinterpret_cast<__m256i const*>
+                 (a_buff + i)))),
+               i, a_ends, k, a_max);
+        return SplitTail(a_buff, i, a_len, a_ends, k, a_max);
+      }
+
+      inline bool CPUHasAVX2()
+      {
+        static bool const s_has = __builtin_cpu_supports("avx2");
+        return s_has;
+      }
+#     endif
+    }
+
+    template<bool UseSIMD = HasSIMD>
+    inline int SplitFields
+      (char const* a_buff, char const* a_end, uint16_t* a_ends, int a_max)
+    {
+      assert(a_buff != nullptr && a_buff <= a_end && a_ends != nullptr &&
+             a_end - a_buff <= 65535);
+      int len = int(a_end - a_buff);
+
+      if constexpr (UseSIMD)
+      {
+#       if defined(__AVX2__)
+        return Detail::SplitAVX2(a_buff, len, a_ends, a_max);
+#       else
+#       ifdef MAQUETTE_FAST_SPLIT_AVX2
+        // Not compiled for AVX2, but the CPU may still have it:
+        if (Detail::CPUHasAVX2())
+          return Detail::SplitAVX2(a_buff, len, a_ends, a_max);
+#       endif
+#       ifdef __SSE2__
+        return Detail::SplitSSE2(a_buff, len, a_ends, a_max);
+#       endif
+#       endif
+      }
+      return Detail::SplitTail(a_buff, 0, len, a_ends, 0, a_max);
+    }
+  } // End namespace StopBits
+} // End namespace FAST
+} // End namespace MAQUETTE
@@ -0,0 +1,208 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "Protocols/FIX/HotTmpls.h":                        //
+//        Pre-Serialised ("Hot") Templates of Outgoing FIX Order Msgs        //
+//===========================================================================//
+// A "HotTmpl" is the image of a "NewOrderSingle" or "OrderCancelReplaceReq-
+// uest" msg for a given (Session, Instrument, Side, OrderType) in which all
+// flds are pre-rendered, EXCEPT for a small number of "Slots" (SeqNum, Send-
+// ingTime, ClOrdID etc) which change from one order to another. The image is
+// RECORDED from a msg produced by the generic (fld-by-fld) "ProtoEngine" Sen-
+// ders, so it automatically follows all Dialect-specific fld choices and fld
+// order. Subsequent msgs with the same Key are produced by copying the static
+// Segments of the image and rendering the Slot values in between; the Check-
+// Sum of the static part is pre-computed, so only the Slot bytes are summed
+// up on sending:
+//
+#pragma once
+
+#include "Basis/BaseTypes.hpp"
+#include "Protocols/FIX/Msgs.h"
+#include "Protocols/FIX/UtilsMacros.hpp"
+#include <utxx/compiler_hints.hpp>
+#include <cstdint>
+#include <cstring>
+#include <cassert>
+
+namespace MAQUETTE
+{
+namespace FIX
+{
+  struct SessData;
+
+  //=========================================================================//
+  // "HotTmplKey":                                                           //
+  //=========================================================================//
+  // Identifies the msgs which are identical up to the Slot values. NB: "m_tif"
+  // and "m_expireDate" are only relevant for "OrderCancelReplaceRequest", in
+  // which they come from the AOS (in "NewOrderSingle", they are determined by
+  // the OrderType and Dialect):
+  //
+  struct HotTmplKey
+  {
+    SessData const*   m_sess       = nullptr;
+    SecID             m_secID      = 0;
+    int               m_msgType    = 0;       // MsgT as "int"
+    char              m_side       = '\0';
+    char              m_ordType    = '\0';
+    char              m_tif        = '\0';
+    int               m_expireDate = 0;
+
+    bool operator==(HotTmplKey const& a_right) const
+    {
+      return m_sess       == a_right.m_sess    &&
+             m_secID      == a_right.m_secID   &&
+             m_msgType    == a_right.m_msgType &&
+             m_side       == a_right.m_side    &&
+             m_ordType    == a_right.m_ordType &&
+             m_tif        == a_right.m_tif     &&
+             m_expireDate == a_right.m_expireDate;
+    }
+
+    // Index in a direct-mapped table of "a_n" (a power of 2) Tmpls:
+    unsigned Hash(unsigned a_n) const
+    {
+      assert(a_n > 0 && (a_n & (a_n - 1)) == 0);
+      uint64_t h = m_secID ^ (uint64_t(uintptr_t(m_sess))  << 7);
+      h ^= (uint64_t(unsigned(m_msgType)) << 40) ^
+           (uint64_t(uint8_t (m_side))    << 32) ^
+           (uint64_t(uint8_t (m_ordType)) << 48) ^
+           (uint64_t(uint8_t (m_tif))     << 56) ^ uint64_t(m_expireDate);
+      h *= 0x9e3779b97f4a7c15UL;
+      return unsigned(h >> 32) & (a_n - 1);
+    }
+  };
+
+  //=========================================================================//
+  // "HotTmpl":                                                              //
+  //=========================================================================//
+  struct HotTmpl
+  {
+    //-----------------------------------------------------------------------//
+    // Slot Types:                                                           //
+    //-----------------------------------------------------------------------//
+    enum class SlotT: uint8_t
+    {
+      SeqNum       = 0,     // 34
+      SendingTime  = 1,     // 52
+      ClOrdID      = 2,     // 11
+      OrigClOrdID  = 3,     // 41
+      Px           = 4,     // 44 (Limit Orders only)
+      Qty          = 5,     // 38
+      TransactTime = 6,     // 60 (same value as SendingTime)
+      StratHash    = 7      // 526, or 1 if Account is used as SecOrdID
+    };
+
+    constexpr static int MaxImage = 512;
+    constexpr static int MaxSlots = 12;
+
+    //-----------------------------------------------------------------------//
+    // Data Flds:                                                            //
+    //-----------------------------------------------------------------------//
+    HotTmplKey  m_key;
+    bool        m_valid;                   // Initially false
+    int         m_nSlots;
+    int         m_bodyOff;                 // Offset of the MsgBody (35=...)
+    unsigned    m_staticSum;               // Of all Segms (BodyLength="0000")
+    SlotT       m_slots  [MaxSlots];
+    uint16_t    m_segOffs[MaxSlots + 2];   // Segm "i" is [Offs[i], Offs[i+1])
+    char        m_image  [MaxImage];       // All static Segms, concatenated
+
+    HotTmpl()
+    : m_key      (),
+      m_valid    (false),
+      m_nSlots   (0),
+      m_bodyOff  (0),
+      m_staticSum(0),
+      m_slots    (),
+      m_segOffs  (),
+      m_image    ()
+    {}
+
+    //-----------------------------------------------------------------------//
+    // "Record":                                                             //
+    //-----------------------------------------------------------------------//
+    // Builds the Tmpl from a msg in [a_msg, a_end) (from "8=" and up to, but
+    // NOT including, the "10=" fld; the BodyLength is the "9=XXXX" placehold-
+    // er) and the "a_slot_of" function which maps a Tag into a Slot (returning
+    // "false" if the Tag is static). If the msg does not fit, the Tmpl remains
+    // invalid:
+    //
+    template<typename SlotOf>
+    void Record
+    (
+      HotTmplKey const& a_key,
+      char const*       a_msg,
+      char const*       a_body,
+      char const*       a_end,
+      SlotOf const&     a_slot_of
+    )
+    {
+      assert(a_msg != nullptr && a_msg < a_body && a_body < a_end);
+      m_valid  = false;
+      m_nSlots = 0;
+
+      int len  = int(a_end - a_msg);
+      if (utxx::unlikely(len > MaxImage))
+        return;
+
+      int out      = 0;   // Curr pos in "m_image"
+      m_segOffs[0] = 0;
+
+      for (char const* fld = a_msg; fld < a_end; )
+      {
+        char const* eq  =
+          static_cast<char const*>(memchr(fld, '=', size_t(a_end - fld)));
+        char const* sep = (eq == nullptr) ? nullptr :
+          static_cast<char const*>(memchr(eq,  soh, size_t(a_end - eq)));
+        if (utxx::unlikely(sep == nullptr))
+          return;
+
+        int   tag  = 0;
+        for (char const* p = fld; p < eq; ++p)
+          tag = 10 * tag + (*p - '0');
+
+        SlotT slot = SlotT::SeqNum;
+        if (a_slot_of(tag, &slot))
+        {
+          if (utxx::unlikely(m_nSlots >= MaxSlots))
+            return;
+          // The Tag and '=' go into the curr Segm; the value is the Slot;  the
+          // SOH begins the next Segm:
+          int n = int(eq + 1 - fld);
+          memcpy(m_image + out, fld, size_t(n));
+          out += n;
+          m_slots  [m_nSlots]     = slot;
+          m_segOffs[m_nSlots + 1] = uint16_t(out);
+          ++m_nSlots;
+          m_image[out++] = soh;
+          fld = sep + 1;
+        }
+        else
+        {
+          int n = int(sep + 1 - fld);
+          memcpy(m_image + out, fld, size_t(n));
+          out += n;
+          fld  = sep + 1;
+        }
+      }
+      m_segOffs[m_nSlots + 1] = uint16_t(out);
+
+      // The BodyLength placeholder ("XXXX", immediately before the Body) is in
+      // the 1st Segm; its digits are filled in on sending, so count it as "0"s
+      // in the static sum:
+      m_bodyOff = int(a_body - a_msg);
+      if (utxx::unlikely(m_nSlots == 0 || m_bodyOff > m_segOffs[1]))
+        return;
+      memset(m_image + m_bodyOff - 5, '0', 4);
+
+      m_staticSum = 0;
+      for (int i = 0; i < out; ++i)
+        m_staticSum += unsigned(uint8_t(m_image[i]));
+
+      m_key   = a_key;
+      m_valid = true;
+    }
+  };
+} // End namespace FIX
+} // End namespace MAQUETTE
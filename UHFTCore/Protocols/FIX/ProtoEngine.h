@@ -8,6 +8,7 @@
 #include "Basis/BaseTypes.hpp"
 #include "Basis/OrdMgmtTypes.hpp"
 #include "Protocols/FIX/Msgs.h"
+#include "Protocols/FIX/HotTmpls.h"
 #include <boost/core/noncopyable.hpp>
 #include <string>
 #include <type_traits>
@@ -122,11 +123,26 @@ namespace FIX
     // Misc Data:                                                            //
     //-----------------------------------------------------------------------//
     int                                     m_reqIDPfxSz;     // For efficiency
+    // If set, the msgs are parsed in-place in the Reactor buffer, otherwise in
+    // a copy ("m_currMsg"):
+    bool const                              m_zeroCopyRead;
     // In- and Out- Msg Buffers:
     mutable char                            m_currMsg[8192];  // Input copy
     mutable size_t                          m_currMsgLen;     // <= 8192
+    // SOH positions in the curr msg (found together with the CheckSum), used
+    // by the Parsers instead of searching for each SOH:
+    constexpr static int                    MaxSOHs = 4096;
+    mutable uint16_t                        m_sohOffs[MaxSOHs];
+    mutable char*                           m_sohBase;        // Offs base
+    mutable int                             m_nSOHs;
+    mutable int                             m_nextSOH;        // Parse pos
     mutable char                            m_outBuff[65536]; // Output
     mutable int                             m_outBuffLen;     // <= 65536
+    // Pre-serialised "NewOrderSingle" and "OrderCancelReplaceRequest" msgs
+    // (direct-mapped by "HotTmplKey"; see "HotTmpls.h"):
+    bool const                              m_useHotTmpls;
+    constexpr static unsigned               HotTmplsN = 64;
+    mutable HotTmpl                         m_hotTmpls[HotTmplsN];
 
     //=======================================================================//
     // Ctors, Dtor:                                                          //
@@ -138,7 +154,9 @@ namespace FIX
     ProtoEngine
     (
       SessMgr*     a_sess_mgr,
-      Processor*   a_processor
+      Processor*   a_processor,
+      bool         a_zero_copy_read = ProtocolFeatures<D>::s_zeroCopyRead,
+      bool         a_hot_tmpls      = true
     );
 
     // Dtor is trivial:
@@ -180,6 +198,20 @@ namespace FIX
       utxx::time_val  a_ts_handl
     );
 
+    //-----------------------------------------------------------------------//
+    // "NextFld": Used by all Parsers (see "GENERATE_PARSER"):               //
+    //-----------------------------------------------------------------------//
+    // Similar to "ParseFld", but uses the pre-computed SOH positions:
+    //
+    char* NextFld
+    (
+      char*           a_curr,
+      char const*     a_body_end,
+      int*            a_tag,
+      char const**    a_str_val
+    )
+    const;
+
     //-----------------------------------------------------------------------//
     // Parsing of Session-Level Msgs:                                        //
     //-----------------------------------------------------------------------//
@@ -477,7 +509,12 @@ namespace FIX
     )
     const;
 
-    // "MkSegmSessDest":
+    // "MkReqIDVal":
+    // Same as "MkReqID" but without the Tag and SOH:
+    //
+    char* MkReqIDVal(SessData* a_sess, char* a_curr, OrderID a_req_id) const;
+
+        // "MkSegmSessDest":
     // The 2nd overloaded version is only used on the Server-Side:
     //
     char* MkSegmSessDest(char* a_curr, SecDefD const& a_instr)   const;
@@ -499,7 +536,50 @@ namespace FIX
     )
     const;
 
-    // "LogMsg":
+    // "SendLog":
+    // The 2nd part of "CompleteSendLog" (after the msg has been completed):
+    //
+    utxx::time_val SendLog
+    (
+      SessData*   a_sess,
+      int         a_len,
+      bool        a_batch_send
+    )
+    const;
+
+    // "HotTmpls":
+    // "GetHotTmpl" returns the Tmpl entry for "a_key" (valid or not), "Record-
+    // HotTmpl" builds it from the msg just generated, and "SendHotTmpl" gene-
+    // rates the msg from it, and then proceeds as "CompleteSendLog":
+    //
+    HotTmpl* GetHotTmpl(HotTmplKey const& a_key) const
+      { return m_hotTmpls + a_key.Hash(HotTmplsN); }
+
+    void RecordHotTmpl
+    (
+      HotTmpl*          a_tmpl,
+      HotTmplKey const& a_key,
+      char const*       a_body_begin,
+      char const*       a_body_end
+    )
+    const;
+
+    template<MsgT::type Type>
+    utxx::time_val SendHotTmpl
+    (
+      SessData*       a_sess,
+      HotTmpl const&  a_tmpl,
+      utxx::time_val  a_ts_create,
+      OrderID         a_req_id,
+      OrderID         a_orig_req_id,
+      PriceT          a_px,
+      QtyN            a_qty,
+      unsigned long   a_strat_hash48,
+      bool            a_batch_send
+    )
+    const;
+
+        // "LogMsg":
     template<bool IsSend>
     void LogMsg(char* a_buff, int a_len) const;
   };
@@ -35,7 +35,9 @@ namespace FIX
   inline ProtoEngine<D, IsServer, SessMgr, Processor>::ProtoEngine
   (
     SessMgr*        a_sess_mgr,
-    Processor*      a_processor
+    Processor*      a_processor,
+    bool            a_zero_copy_read,
+    bool            a_hot_tmpls
   )
   : m_sessMgr       (a_sess_mgr),
     m_processor     (a_processor),
@@ -43,10 +45,17 @@ namespace FIX
     // All Typed FIX Msg Buffers use their Default Ctors...
     //
     m_reqIDPfxSz    (0),       // Initialised below
+    m_zeroCopyRead  (a_zero_copy_read),
     m_currMsg       (),
     m_currMsgLen    (0),
+    m_sohOffs       (),
+    m_sohBase       (nullptr),
+    m_nSOHs         (0),
+    m_nextSOH       (0),
     m_outBuff       (),
-    m_outBuffLen    (0)
+    m_outBuffLen    (0),
+    m_useHotTmpls   (a_hot_tmpls),
+    m_hotTmpls      ()
   {
     // NB:  Reactor and Processor are allowed to be NULL;  SessMgr and Logger
     // must be non-NULL (in particular, SessMgr cannot be NULL, because other-
@@ -154,6 +163,8 @@ namespace FIX
       // when it is finally filled in, it will be processed straight away:
       *m_currMsg   = '\0';
       m_currMsgLen = 0;
+      m_nSOHs      = 0;
+      m_nextSOH    = 0;
 
       //---------------------------------------------------------------------//
       // Prefix: eg "8=FIX.M.N|9=XXXX|"...                                   //
@@ -228,20 +239,41 @@ namespace FIX
       //---------------------------------------------------------------------//
       assert(msgEnd <= chunkEnd);
 
-      // Copy the msg just framed into "m_currMsg".  This incurs a minor per-
-      // formance overhead, but greatly enhances the safety of the following-
-      // on parsing and processing, because in come cases, the socket can be
-      // closed during processing, and the current buff destroyed!
+      // Unless in the ZeroCopyRead mode, copy the msg just framed into "m_cu-
+      // rrMsg". This incurs a minor performance overhead, but greatly enhances
+      // the safety of the following-on parsing and processing, because in some
+      // cases, the socket can be closed during processing, and the curr buff
+      // destroyed! In the ZeroCopyRead mode, the msg is parsed in-place in the
+      // Reactor buffer (it is consumed anyway); this is safe as long as  the
+      // msg is not accessed after it has been Processed (the Session validity
+      // is checked after each msg, see below):
       //
-      int totalLen = int(msgEnd - msgBegin);   // The whole msg
-      assert(size_t(totalLen) <=  sizeof(m_currMsg));
+      int   totalLen = int(msgEnd - msgBegin);   // The whole msg
+      char* msgBuff  = msgBegin;
 
-      m_currMsgLen = size_t(totalLen);
-      memcpy(m_currMsg, msgBegin, m_currMsgLen);
-
-      // Log the original msg -- it gets modified while doing so, but we don't
-      // need it anymore: IsSend=false:
-      LogMsg<false>(msgBegin, totalLen);
+      if (m_zeroCopyRead)
+      {
+        // Log the original msg -- but LogMsg modifies the msg, so in this case
+        // a copy is still required (only if logging is enabled):   NB: very
+        // long msgs are not logged:
+        if (utxx::unlikely(m_sessMgr->m_protoLogger != nullptr &&
+                           size_t(totalLen) <= sizeof(m_currMsg)))
+        {
+          memcpy(m_currMsg, msgBegin, size_t(totalLen));
+          LogMsg<false>(m_currMsg, totalLen);
+        }
+      }
+      else
+      {
+        assert(size_t(totalLen) <=  sizeof(m_currMsg));
+        m_currMsgLen = size_t(totalLen);
+        memcpy(m_currMsg, msgBegin, m_currMsgLen);
+        msgBuff      = m_currMsg;
+
+        // Log the original msg -- it gets modified while doing so, but we do
+        // not need it anymore: IsSend=false:
+        LogMsg<false>(msgBegin, totalLen);
+      }
 
       //---------------------------------------------------------------------//
       // Prepare for the next iteration:                                     //
@@ -250,8 +282,17 @@ namespace FIX
       // iteration, so can be updated now:
       //
       msgBegin      = msgEnd;
-      msgBody       = m_currMsg + bodyOff;
-      char* bodyEnd = msgBody   + bodyLen;
+      msgBody       = msgBuff + bodyOff;
+      char* bodyEnd = msgBody + bodyLen;
+
+      //---------------------------------------------------------------------//
+      // Find all SOHs and compute the CheckSum in one pass:                 //
+      //---------------------------------------------------------------------//
+      // (From "msgBuff" to "bodyEnd", ie obviously not including the CheckSum
+      // fld itself!):
+      m_sohBase = msgBuff;
+      [[maybe_unused]] int clcCS =
+        ScanMsg(msgBuff, bodyEnd, m_sohOffs, MaxSOHs, &m_nSOHs);
 
       //---------------------------------------------------------------------//
       // The Curr Msg has been framed:                                       //
@@ -261,7 +302,7 @@ namespace FIX
       CHECK_ONLY
       (
         // Check the msg terminators:
-        char* copyEnd = m_currMsg + totalLen;
+        char* copyEnd = msgBuff + totalLen;
         if (utxx::unlikely(*(copyEnd-1) != soh || *(bodyEnd-1) != soh))
         {
           // NB: SeqNum and MsgType are not known yet:
@@ -276,10 +317,6 @@ namespace FIX
         }
 
         // Now verify the Msg CheckSum:
-        // (From "m_currMsg" to "bodyEnd", ie obviously not including the Check-
-        // Sum fld itself!):
-        //
-        int clcCS = MsgCheckSum(m_currMsg, bodyEnd);
         int embCS = 0;
 
         // NB: "bodyEnd" must point to "10=", so read the check-sum until SOH
@@ -339,6 +376,12 @@ namespace FIX
         msgType   = MsgT(int(LiteralEnum(msgBody[3], msgBody[4])));
         msgBody  += 6;
       }
+      // Skip the SOHs before the actual "msgBody" (normally 3 of them: after
+      // the "8=", "9=" and "35=" flds):
+      while (m_nextSOH < m_nSOHs &&
+             m_sohBase + m_sohOffs[m_nextSOH] < msgBody)
+        ++m_nextSOH;
+
       // The common base obj of all Msgs, not known yet (depends on MsgType):
       MsgPrefix* msgPrefix = nullptr;
 
@@ -615,6 +658,54 @@ namespace FIX
     __builtin_unreachable();
   }
 
+  //=========================================================================//
+  // "NextFld":                                                              //
+  //=========================================================================//
+  // Like "ParseFld", but the SOH terminating the curr fld is taken from the
+  // SOH positions found by "ScanMsg" (if they are not available, eg for very
+  // long msgs, "ParseFld" is used):
+  //
+  template
+  <
+    DialectT::type D,
+    bool           IsServer,
+    typename       SessMgr,
+    typename       Processor
+  >
+  inline char* ProtoEngine<D, IsServer, SessMgr, Processor>::NextFld
+  (
+    char*         a_curr,
+    char const*   a_body_end,
+    int*          a_tag,
+    char const**  a_str_val
+  )
+  const
+  {
+    assert(a_curr    != nullptr && a_curr < a_body_end && a_tag != nullptr &&
+           a_str_val != nullptr);
+
+    if (utxx::unlikely(m_nextSOH >= m_nSOHs))
+      return ParseFld(a_curr, a_body_end, a_tag, a_str_val);
+
+    char* end = m_sohBase + m_sohOffs[m_nextSOH++];
+
+    // Get the Tag: TillEOL=false, as the Tag ends with the '=':
+    char const* eq = utxx::fast_atoi<int, false>(a_curr, end, *a_tag);
+    CHECK_ONLY
+    (
+      if (utxx::unlikely(eq == nullptr || *eq != '=' || *a_tag <= 0))
+        throw utxx::runtime_error("FIX::NextFld: Invalid Tag: ", a_curr);
+      if (utxx::unlikely(end <= eq + 1 || end >= a_body_end))
+        throw utxx::runtime_error("FIX::NextFld: Invalid Val: ", a_curr);
+    )
+    // Replace SOH with 0, to delimit the Value (and the Fld):
+    *end       = '\0';
+    *a_str_val = eq + 1;
+
+    // Return a ptr beyond this fld:
+    return (end + 1);
+  }
+
   //=========================================================================//
   // Generate All Msg Parsers:                                               //
   //=========================================================================//
@@ -38,6 +38,186 @@ namespace FIX
       char(a_ord_type);   // In all other cases, return the orig rep
   }
 
+  //=========================================================================//
+  // "RecordHotTmpl":                                                        //
+  //=========================================================================//
+  // Builds "a_tmpl" from the msg just generated at "m_outBuffLen" offset (not
+  // completed yet, ie without the CheckSum). The Slots are the flds which may
+  // differ between the msgs with the same "HotTmplKey":
+  //
+  template
+  <
+    DialectT::type    D,
+    bool              IsServer,
+    typename          SessMgr,
+    typename          Processor
+  >
+  void ProtoEngine<D, IsServer, SessMgr, Processor>::RecordHotTmpl
+  (
+    HotTmpl*          a_tmpl,
+    HotTmplKey const& a_key,
+    char const*       a_body_begin,
+    char const*       a_body_end
+  )
+  const
+  {
+    assert(a_tmpl != nullptr);
+    using SlotT  = HotTmpl::SlotT;
+    bool isLimit = (a_key.m_ordType == char(OrderTypeT::Limit));
+
+    a_tmpl->Record
+    (
+      a_key, m_outBuff + m_outBuffLen, a_body_begin, a_body_end,
+      [isLimit](int a_tag, SlotT* a_slot) -> bool
+      {
+        switch (a_tag)
+        {
+        case  34: *a_slot = SlotT::SeqNum;       return true;
+        case  52: *a_slot = SlotT::SendingTime;  return true;
+        case  11: *a_slot = SlotT::ClOrdID;      return true;
+        case  41: *a_slot = SlotT::OrigClOrdID;  return true;
+        case  38: *a_slot = SlotT::Qty;          return true;
+        case  60: *a_slot = SlotT::TransactTime; return true;
+        case 526: *a_slot = SlotT::StratHash;    return true;
+        // Px is a nominal constant (if present at all) in Market Orders:
+        case  44: *a_slot = SlotT::Px;           return isLimit;
+        // Account is static unless it is used as SecOrdID:
+        case   1:
+          *a_slot = SlotT::StratHash;
+          return ProtocolFeatures<D>::s_useAccountAsSecOrdID;
+        default:                                 return false;
+        }
+      }
+    );
+    // TransactTime is copied from SendingTime, so the latter must come first:
+    bool hasTS = false;
+    for (int i = 0; a_tmpl->m_valid && i < a_tmpl->m_nSlots; ++i)
+      if (a_tmpl->m_slots[i] == SlotT::SendingTime)
+        hasTS = true;
+      else
+      if (a_tmpl->m_slots[i] == SlotT::TransactTime && !hasTS)
+        a_tmpl->m_valid = false;
+  }
+
+  //=========================================================================//
+  // "SendHotTmpl":                                                          //
+  //=========================================================================//
+  // Generates the msg from "a_tmpl" directly into "m_outBuff", then proceeds
+  // as "CompleteSendLog" does. Returns MsgSendTS:
+  //
+  template
+  <
+    DialectT::type    D,
+    bool              IsServer,
+    typename          SessMgr,
+    typename          Processor
+  >
+  template<MsgT::type Type>
+  utxx::time_val ProtoEngine<D, IsServer, SessMgr, Processor>::SendHotTmpl
+  (
+    SessData*         a_sess,
+    HotTmpl const&    a_tmpl,
+    utxx::time_val    a_ts_create,
+    OrderID           a_req_id,
+    OrderID           a_orig_req_id,
+    PriceT            a_px,
+    QtyN              a_qty,
+    unsigned long     a_strat_hash48,
+    bool              a_batch_send
+  )
+  const
+  {
+    assert(a_sess != nullptr && a_tmpl.m_valid &&
+           a_tmpl.m_key.m_msgType == int(Type) && !a_ts_create.empty());
+    CHECK_ONLY
+    (
+      if (utxx::unlikely (int(sizeof(m_outBuff) - 1024) < m_outBuffLen))
+        throw utxx::runtime_error
+              ("FIX::ProtoEngine::SendHotTmpl: OutBuff Full or Nearly Full: "
+               "CurrSize=", m_outBuffLen, ", MaxSize=", sizeof(m_outBuff));
+    )
+    using SlotT = HotTmpl::SlotT;
+
+    char*       buff = m_outBuff + m_outBuffLen;
+    char*       curr = buff;
+    unsigned    sum  = a_tmpl.m_staticSum;
+    char const* ts   = nullptr;
+    SeqNum      txSN = *(a_sess->m_txSN);
+
+    //-----------------------------------------------------------------------//
+    // Static Segms and Slots:                                               //
+    //-----------------------------------------------------------------------//
+    for (int i = 0; ; ++i)
+    {
+      int from = a_tmpl.m_segOffs[i];
+      int n    = a_tmpl.m_segOffs[i+1] - from;
+      memcpy(curr, a_tmpl.m_image + from, size_t(n));
+      curr += n;
+
+      if (i == a_tmpl.m_nSlots)
+        break;
+
+      char* val = curr;
+      switch (a_tmpl.m_slots[i])
+      {
+      case SlotT::SeqNum:
+        INT_VAL(txSN)
+        break;
+
+      case SlotT::SendingTime:
+        curr = OutputDateTimeFIX(a_ts_create, curr);
+        ts   = val;
+        break;
+
+      case SlotT::TransactTime:
+        // Same value as SendingTime (len=21):
+        assert(ts != nullptr);
+        memcpy(curr, ts, 21);
+        curr += 21;
+        break;
+
+      case SlotT::ClOrdID:
+        curr = MkReqIDVal(a_sess, curr, a_req_id);
+        break;
+
+      case SlotT::OrigClOrdID:
+        curr = MkReqIDVal(a_sess, curr, a_orig_req_id);
+        break;
+
+      case SlotT::Px:
+        assert(IsFinite(a_px));
+        DEC_VAL(double(a_px))
+        break;
+
+      case SlotT::Qty:
+        if constexpr (ProtocolFeatures<D>::s_hasFracQtys)
+          DEC_VAL(double(QR(a_qty)))
+        else
+          INT_VAL(long  (QR(a_qty)))
+        break;
+
+      case SlotT::StratHash:
+        curr = utxx::itoa16_right<unsigned long, 12>(curr, a_strat_hash48);
+        break;
+      }
+      // Only the Slot bytes are summed up:
+      sum += unsigned(MsgCheckSum(val, curr));
+    }
+    //-----------------------------------------------------------------------//
+    // BodyLength and CheckSum:                                              //
+    //-----------------------------------------------------------------------//
+    // The static sum counts the BodyLength digits as "0"s:
+    char* body    = buff + a_tmpl.m_bodyOff;
+    int   bodyLen = int(curr - body);
+    assert(0 < bodyLen && bodyLen <= 8192);
+
+    (void) utxx::itoa_right<int, 4, char>(body - 5, bodyLen, '0');
+    sum += unsigned(MsgCheckSum(body - 5, body - 1)) - 4 * unsigned('0');
+
+    int len = InstallCheckSum(buff, curr, int(sum & 0xff));
+    return SendLog(a_sess, len, a_batch_send);
+  }
+
   //=========================================================================//
   // "NewOrderImpl":                                                         //
   //=========================================================================//
@@ -113,6 +293,47 @@ namespace FIX
     constexpr bool IsCurrenex   = (D == DialectT::Currenex);
     constexpr bool IsCumberland = (D == DialectT::Cumberland);
 
+    //-----------------------------------------------------------------------//
+    // "Hot" Tmpl?                                                           //
+    //-----------------------------------------------------------------------//
+    // A "plain" order (Limit or Market, no Iceberg, no QtyMin, no ExpireDate)
+    // is generated from the pre-serialised Tmpl for its (Session, Instrument,
+    // Side, OrderType), if available; otherwise, the Tmpl is recorded from the
+    // msg generated below. (Cumberland msgs contain QuoteIDs which change all
+    // the time, so there are no Tmpls for them):
+    //
+    HotTmplKey key;
+    HotTmpl*   hot = nullptr;
+
+    if constexpr (!IsCumberland &&
+                  ProtocolFeatures<D>::s_defaultTimeInForce !=
+                  TimeInForceT::GoodTillDate)
+      if (m_useHotTmpls && !aos->m_isIceberg  &&
+          (ordType == OrderTypeT::Limit || ordType == OrderTypeT::Market) &&
+          qtyShow  == qty   && IsZero(qtyMin))
+      {
+        key.m_sess    = a_sess;
+        key.m_secID   = instr->m_SecID;
+        key.m_msgType = int(MsgT::NewOrderSingle);
+        key.m_side    = char(isBuy ? SideT::Buy : SideT::Sell);
+        key.m_ordType = char(ordType);
+        hot           = GetHotTmpl(key);
+
+        if (utxx::likely(hot->m_valid && hot->m_key == key))
+        {
+          SeqNum txSN = *(a_sess->m_txSN);
+          utxx::time_val sendTime =
+            SendHotTmpl<MsgT::NewOrderSingle>
+              (a_sess, *hot, createTS, newReqID, 0, px, qty,
+               strategy->GetHash48(), a_batch_send);
+
+          a_new_req->m_status  = Req12::StatusT::New;
+          a_new_req->m_ts_sent = sendTime;
+          a_new_req->m_seqNum  = txSN;
+          return;
+        }
+      }
+
     //-----------------------------------------------------------------------//
     // Preamble and Account:                                                 //
     //-----------------------------------------------------------------------//
@@ -424,6 +645,9 @@ namespace FIX
     //-----------------------------------------------------------------------//
     // Go!                                                                   //
     //-----------------------------------------------------------------------//
+    if (hot != nullptr)
+      RecordHotTmpl(hot, key, msgBody, curr);
+
     utxx::time_val sendTime =
       CompleteSendLog<MsgT::NewOrderSingle>
         (a_sess, msgBody, curr, a_batch_send);
@@ -650,6 +874,42 @@ namespace FIX
     QtyN newQtyMin           = a_mod_req1->GetQtyMin <QT,QR>();
     assert(!IsNeg(newQtyMin)  && newQtyMin  <= newQty);
 
+    //-----------------------------------------------------------------------//
+    // "Hot" Tmpl?                                                           //
+    //-----------------------------------------------------------------------//
+    // As in "NewOrderImpl", but TimeInForce and ExpireDate (if used) come from
+    // the AOS, so they are part of the Key:
+    //
+    HotTmplKey key;
+    HotTmpl*   hot = nullptr;
+
+    if (m_useHotTmpls && !aos->m_isIceberg &&
+        newQtyMin == a_orig_req->GetQtyMin<QT,QR>())
+    {
+      key.m_sess       = a_sess;
+      key.m_secID      = aos->m_instr->m_SecID;
+      key.m_msgType    = int(MsgT::OrderCancelReplaceRequest);
+      key.m_side       = char(aos->m_isBuy ? SideT::Buy : SideT::Sell);
+      key.m_ordType    = char(aos->m_orderType);
+      key.m_tif        = char(aos->m_timeInForce);
+      key.m_expireDate = aos->m_expireDate;
+      hot              = GetHotTmpl(key);
+
+      if (utxx::likely(hot->m_valid && hot->m_key == key))
+      {
+        SeqNum txSN = *(a_sess->m_txSN);
+        utxx::time_val sendTime =
+          SendHotTmpl<MsgT::OrderCancelReplaceRequest>
+            (a_sess, *hot, createTS, modReqID, a_orig_req->m_id, newPx,
+             newQty, aos->m_stratHash48, a_batch_send);
+
+        a_mod_req1->m_status  = Req12::StatusT::New;
+        a_mod_req1->m_ts_sent = sendTime;
+        a_mod_req1->m_seqNum  = txSN;
+        return;
+      }
+    }
+
     //-----------------------------------------------------------------------//
     // Preamble, Account and Parties:                                        //
     //-----------------------------------------------------------------------//
@@ -797,6 +1057,9 @@ namespace FIX
     //-----------------------------------------------------------------------//
     // Go!                                                                   //
     //-----------------------------------------------------------------------//
+    if (hot != nullptr)
+      RecordHotTmpl(hot, key, msgBody, curr);
+
     utxx::time_val sendTime =
       CompleteSendLog<MsgT::OrderCancelReplaceRequest>
         (a_sess, msgBody, curr, a_batch_send);
@@ -175,10 +175,38 @@ namespace FIX
   {
     assert(a_sess != nullptr && a_curr != nullptr && a_tag != nullptr);
 
-    // Output the Tag -- NB: this advances "a_curr":
-    a_curr = stpcpy (a_curr, a_tag);
+    // Output the Tag, the Value and the SOH:
+    a_curr  = stpcpy    (a_curr, a_tag);
+    a_curr  = MkReqIDVal(a_sess, a_curr, a_req_id);
+    *a_curr = soh;
+    ++a_curr;
+    return a_curr;
+  }
+
+  //=========================================================================//
+  // "MkReqIDVal":                                                           //
+  //=========================================================================//
+  // The ReqID value only (without the Tag and SOH), as described above; also
+  // used for the ClOrdID Slots of "HotTmpl"s:
+  //
+  template
+  <
+    DialectT::type D,
+    bool           IsServer,
+    typename       SessMgr,
+    typename       Processor
+  >
+  inline char* ProtoEngine<D, IsServer, SessMgr, Processor>::MkReqIDVal
+  (
+    SessData*      a_sess,
+    char*          a_curr,
+    OrderID        a_req_id
+  )
+  const
+  {
+    assert(a_sess != nullptr && a_curr != nullptr);
 
-    // From now on, keep "a_curr" unchanged and advance "curr":
+    // Keep "a_curr" unchanged and advance "curr":
     // (*) for compatibility with INT_VAL macro below;
     // (*) for prefix size validation:
     char* curr = a_curr;
@@ -204,8 +232,6 @@ namespace FIX
 
     // Finally, output the numerical ReqID itself, and increment "curr":
     INT_VAL(a_req_id)
-    *curr  = soh;
-    ++curr;
     return curr;
   }
 
@@ -369,11 +395,38 @@ namespace FIX
     // CheckSum and Length (incl the very final terminating SOH): NB: The curr
     // msg begins from "m_outBuffLen" offset:
     int len = CompleteMsg(m_outBuff + m_outBuffLen, a_body_begin, a_body_end);
+    return SendLog(a_sess, len, a_batch_send);
+  }
+
+  //=========================================================================//
+  // "SendLog":                                                              //
+  //=========================================================================//
+  // The 2nd part of "CompleteSendLog": The completed msg of "a_len" bytes is
+  // already at "m_outBuffLen" offset; send it out (unless batched)  and incr-
+  // ement the TxSN:
+  //
+  template
+  <
+    DialectT::type D,
+    bool           IsServer,
+    typename       SessMgr,
+    typename       Processor
+  >
+  inline utxx::time_val
+  ProtoEngine<D,   IsServer, SessMgr, Processor>::SendLog
+  (
+    SessData*      a_sess,
+    int            a_len,
+    bool           a_batch_send
+  )
+  const
+  {
+    assert(a_sess != nullptr && a_len > 0);
 
     // Increment the total buff length. NB: This is only done if the msg is suc-
     // cessfully places into the buffer (a partial msg, if remains there for any
     // reason, will be over-written):
-    m_outBuffLen += len;
+    m_outBuffLen += a_len;
 
     CHECK_ONLY
     (
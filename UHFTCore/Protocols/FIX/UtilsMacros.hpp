@@ -14,6 +14,10 @@
 #include <utxx/error.hpp>
 #include <type_traits>
 #include <cstdlib>
+#include <cstdint>
+#ifdef  __SSE2__
+#include <immintrin.h>
+#endif
 
 //===========================================================================//
 // "Elementary" Msg Sending Macros:                                          //
@@ -551,7 +555,7 @@ inline  double StrToD(char const* a_fld_val, char const* a_fld_end)
     { \
       int         tag = 0;    \
       char const* val = nullptr;                     \
-      curr = ParseFld(curr, a_body_end, &tag, &val); \
+      curr = NextFld (curr, a_body_end, &tag, &val); \
       assert(val != nullptr); \
       \
       switch (tag) \
@@ -706,6 +710,96 @@ namespace FIX
     return int(cs & 0xff);
   }
 
+  //-------------------------------------------------------------------------//
+  // "ScanMsg":                                                              //
+  //-------------------------------------------------------------------------//
+  // For received msgs: a single pass over [a_from, a_to) which computes the
+  // CheckSum (the same as "MsgCheckSum") and, at the same time, records  the
+  // offsets (from "a_from") of all SOHs in "a_sohs", so the Parsers do not
+  // need to search for them. Returns the CheckSum; "a_n_sohs" is the number
+  // of SOHs found, or (-1) if there are more than "a_max_sohs" of them:
+  //
+  template<bool UseSIMD = true>
+  inline int ScanMsg
+  (
+    char const* a_from,
+    char const* a_to,
+    uint16_t*   a_sohs,
+    int         a_max_sohs,
+    int*        a_n_sohs
+  )
+  {
+    assert(a_from != nullptr && a_from <= a_to && a_sohs != nullptr &&
+           a_n_sohs != nullptr);
+    int      len = int(a_to - a_from);
+    int      i   = 0;
+    int      n   = 0;
+    unsigned cs  = 0;
+
+    // NB: Offsets beyond 64k cannot be recorded (but the CheckSum is still
+    // computed):
+    if (utxx::unlikely(len > 65536))
+      n = -1;
+
+#   ifdef __SSE2__
+    if constexpr (UseSIMD)
+    {
+      __m128i const zero = _mm_setzero_si128();
+      __m128i const sohs = _mm_set1_epi8(soh);
+      __m128i       sum  = zero;
+
+      for (; i + 16 <= len; i += 16)
+      {
+        __m128i v =
+          _mm_loadu_si128(reinterpret_cast<__m128i const*>(a_from + i));
+        // Byte sums of each 8-byte half, accumulated in 64-bit lanes:
+        sum = _mm_add_epi64(sum, _mm_sad_epu8(v, zero));
+
+        unsigned m =
+          unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(v, sohs)));
+        for (; m != 0 && n >= 0; m &= m - 1)
+          n = (n < a_max_sohs)
+              ? (a_sohs[n] = uint16_t(i + __builtin_ctz(m)), n + 1)
+              : -1;
+      }
+      cs = unsigned(_mm_cvtsi128_si32(sum)) +
+           unsigned(_mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+    }
+#   endif
+    // Scalar path, or the remaining tail:
+    for (; i < len; ++i)
+    {
+      char c = a_from[i];
+      cs    += unsigned(c);
+      if (c == soh && n >= 0)
+        n = (n < a_max_sohs) ? (a_sohs[n] = uint16_t(i), n + 1) : -1;
+    }
+    *a_n_sohs = n;
+    // Take the result modulo 256, ie the lowest-order byte:
+    return int(cs & 0xff);
+  }
+
+  //-------------------------------------------------------------------------//
+  // "InstallCheckSum":                                                      //
+  //-------------------------------------------------------------------------//
+  // Appends the CheckSum fld ("a_cs" having been computed by the Caller over
+  // [a_buff, a_curr)) and the final SOH.
+  // Returns the Total Length (incl the CheckSum fld and the final SOH):
+  //
+  inline int InstallCheckSum(char* a_buff, char* a_curr, int a_cs)
+  {
+    assert(a_buff != nullptr && a_buff < a_curr && 0 <= a_cs && a_cs <= 255);
+
+    a_curr  = stpcpy(a_curr, "10=");
+    (void) utxx::itoa_right<int, 3, char>(a_curr, a_cs, '0');
+    a_curr += 3;
+    *a_curr = soh;
+
+    ++a_curr;         // Beyond the last char written
+    * a_curr = '\0';  // For extra safety, place a terminator there
+    return int(a_curr - a_buff);
+  }
+
   //-------------------------------------------------------------------------//
   // "CompleteMsg":                                                          //
   //-------------------------------------------------------------------------//
@@ -725,17 +819,7 @@ namespace FIX
     (void) utxx::itoa_right<int, 4, char>(a_msg_body - 5, msgLen, '0');
 
     // Now compute the checksum and install it:
-    int cs = MsgCheckSum(a_buff, a_curr);
-    assert(0 <= cs && cs <= 255);
-
-    a_curr  = stpcpy(a_curr, "10=");
-    (void) utxx::itoa_right<int, 3, char>(a_curr, cs, '0');
-    a_curr += 3;
-    *a_curr = soh;
-
-    ++a_curr;         // Beyond the last char written
-    * a_curr = '\0';  // For extra safety, place a terminator there
-    return int(a_curr - a_buff);
+    return InstallCheckSum(a_buff, a_curr, MsgCheckSum(a_buff, a_curr));
   }
 
   //-------------------------------------------------------------------------//
@@ -0,0 +1,714 @@
+// vim:ts=2:et
+//===========================================================================//
+//                         "Protocols/JSONIndex.hpp":                        //
+//       Vectorised Structural Index and On-Demand Cursor for JSON Msgs      //
+//===========================================================================//
+// Used by the H2WS MDCs instead of "strstr" / "strchr" chains (see "JSONParse-
+// Macros.h") which re-scan the same bytes many times, esp in large SnapShots:
+// (*) "StructIdx::Build" makes ONE pass over the whole msg, 64 bytes at a
+//     time (AVX2 or SSE2 "movemask", or a scalar loop), and records the off-
+//     sets of all structural chars: "{}[]:," outside of strings, and the
+//     un-escaped quotes which delimit strings. Backslash escapes are resolved
+//     exactly; the in-string mask is obtained by a prefix XOR of the quote
+//     bits (carry-less multiply if PCLMUL is available);
+// (*) "Cursor" walks the index forward: objs are traversed key by key (in any
+//     order, skipping un-needed values in O(1) per nested structural), and
+//     scalar values are the byte ranges between consecutive structurals;
+// (*) "ToDouble" converts decimal strings (quoted or not) without "strtod"
+//     in the common case: up to 19 significant digits are accumulated (8 at a
+//     time with SWAR), and if the mantissa is < 2^53 and there are <= 22
+//     fractional digits, a single division by an exact power of 10 gives the
+//     correctly-rounded result; anything else falls back to "strtod".
+// As in "Basis/SIMDScans.hpp", the vectorised paths are selected at compile
+// time, and "UseSIMD" can be set to "false" explicitly to force the scalar
+// path (eg for benchmarking):
+//
+#pragma  once
+
+#include "Basis/PxsQtys.h"
+#include <utxx/compiler_hints.hpp>
+#include <utxx/error.hpp>
+#include <utxx/convert.hpp>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <cstdlib>
+#include <cstdint>
+#include <cassert>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace MAQUETTE
+{
+namespace JSON
+{
+# if defined(__SSE2__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  constexpr bool HasSIMD = true;
+# else
+  constexpr bool HasSIMD = false;
+# endif
+
+  //=========================================================================//
+  // Decimal Conversions:                                                    //
+  //=========================================================================//
+  namespace Detail
+  {
+    // Exact powers of 10 (all of them are representable as "double"s):
+    constexpr double Pow10[23] =
+    {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+    };
+
+    inline bool IsDigit(char a_c) { return unsigned(a_c - '0') < 10; }
+
+    // Whether all 8 bytes of the (little-endian) word "a_w" are ASCII digits:
+    inline bool Is8Digits(uint64_t a_w)
+    {
+      return
+        (((a_w & 0xF0F0F0F0F0F0F0F0UL) |
+         (((a_w + 0x0606060606060606UL) & 0xF0F0F0F0F0F0F0F0UL) >> 4)) ==
+         0x3333333333333333UL);
+    }
+
+    // The value of 8 ASCII digits in "a_w" (the 1st byte being the most sig-
+    // nificant digit), by 3 multiplications:
+    inline uint32_t Parse8Digits(uint64_t a_w)
+    {
+      constexpr uint64_t Mask = 0x000000FF000000FFUL;
+      constexpr uint64_t Mul1 = 100 + (1000000UL << 32);
+      constexpr uint64_t Mul2 = 1   + (10000UL   << 32);
+      a_w -= 0x3030303030303030UL;
+      a_w  = (a_w * 10) + (a_w >> 8);
+      return
+        uint32_t((((a_w & Mask) * Mul1) + (((a_w >> 16) & Mask) * Mul2))
+                 >> 32);
+    }
+
+    // Accumulates the digits in [a_s, a_end) into "a_mant" (counting them in
+    // "a_nd"); returns the ptr to the 1st non-digit:
+    inline char const* Digits
+    (
+      char const* a_s,
+      char const* a_end,
+      uint64_t*   a_mant,
+      int*        a_nd
+    )
+    {
+      uint64_t m = *a_mant;
+      int      n = *a_nd;
+      while (a_end - a_s >= 8 && n <= 11)
+      {
+        uint64_t w;
+        memcpy(&w, a_s, 8);
+        if (!Is8Digits(w))
+          break;
+        m    = m * 100000000UL + Parse8Digits(w);
+        n   += 8;
+        a_s += 8;
+      }
+      for (; a_s < a_end && IsDigit(*a_s); ++a_s, ++n)
+        m = 10 * m + uint64_t(*a_s - '0');
+      *a_mant = m;
+      *a_nd   = n;
+      return a_s;
+    }
+
+    // Fall-Back to "strtod" on a 0-terminated copy (the src need not be 0-
+    // terminated at "a_end"):
+    inline char const* SlowToDouble
+      (char const* a_s, char const* a_end, double* a_res)
+    {
+      char   buff[64];
+      size_t n = std::min<size_t>(size_t(a_end - a_s), sizeof(buff) - 1);
+      memcpy(buff, a_s, n);
+      buff[n]     = '\0';
+      char* after = nullptr;
+      *a_res      = strtod(buff, &after);
+      return a_s + (after - buff);
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // "ToDouble":                                                             //
+  //-------------------------------------------------------------------------//
+  // Parses a decimal number (optional '-', digits, optional '.' and fractional
+  // digits, optional exponent) starting at "a_s" and not extending beyond
+  // "a_end". Returns the ptr to the 1st char after the number (== "a_s" if
+  // there was no number at all, in which case "a_res" is set to NaN):
+  //
+  inline char const* ToDouble
+    (char const* a_s, char const* a_end, double* a_res)
+  {
+    assert(a_s != nullptr && a_s <= a_end && a_res != nullptr);
+    char const* p    = a_s;
+    bool        neg  = (p < a_end && *p == '-');
+    p += neg;
+
+    uint64_t    mant = 0;
+    int         nd   = 0;
+    p = Detail::Digits(p, a_end, &mant, &nd);
+    int         nInt = nd;
+    int         frac = 0;
+    if (p < a_end && *p == '.')
+    {
+      p    = Detail::Digits(p + 1, a_end, &mant, &nd);
+      frac = nd - nInt;
+    }
+    if (utxx::unlikely(nd == 0))
+    {
+      *a_res = NaN<double>;
+      return a_s;
+    }
+    // Exponents, too many digits, or a mantissa which is not exact: use the
+    // slow path:
+    if (utxx::unlikely
+       ((p < a_end && (*p == 'e' || *p == 'E')) || nd > 19 || frac > 22 ||
+        mant > (1UL << 53)))
+      return Detail::SlowToDouble(a_s, a_end, a_res);
+
+    double res = double(mant);
+    if (frac != 0)
+      res /= Detail::Pow10[frac];
+    *a_res = neg ? -res : res;
+    return p;
+  }
+
+  //-------------------------------------------------------------------------//
+  // "StrToD":                                                               //
+  //-------------------------------------------------------------------------//
+  // A drop-in replacement for "strtod" in the existing hand-written parsers,
+  // but the input is bounded by "a_end", and leading white space is NOT
+  // skipped:
+  //
+  inline double StrToD
+    (char const* a_s, char const* a_end, char const** a_after)
+  {
+    assert(a_after != nullptr);
+    double res = NaN<double>;
+    *a_after   = ToDouble(a_s, a_end, &res);
+    return res;
+  }
+
+  //-------------------------------------------------------------------------//
+  // "ToPx", "ToQty": Typed wrappers, for the whole range [a_s, a_end):      //
+  //-------------------------------------------------------------------------//
+  inline PriceT ToPx(char const* a_s, char const* a_end)
+  {
+    double px = NaN<double>;
+    ToDouble(a_s, a_end, &px);
+    return PriceT(px);
+  }
+
+  template<typename QtyN>
+  inline QtyN ToQty(char const* a_s, char const* a_end)
+  {
+    double qty = NaN<double>;
+    ToDouble(a_s, a_end, &qty);
+    return QtyN(qty);
+  }
+
+  //=========================================================================//
+  // "StructIdx": Offsets of all Structural Chars in a Msg:                  //
+  //=========================================================================//
+  class StructIdx
+  {
+  private:
+    //-----------------------------------------------------------------------//
+    // Data Flds:                                                            //
+    //-----------------------------------------------------------------------//
+    // NB: "m_offs" only grows, so after the 1st large SnapShot, there are no
+    // further allocations:
+    std::vector<uint32_t> m_offs;
+    int                   m_n;      // Number of valid entries in "m_offs"
+    char const*           m_msg;
+    int                   m_len;
+
+    //-----------------------------------------------------------------------//
+    // Block Masks (bit "j" corresponds to byte "j" of a 64-byte block):     //
+    //-----------------------------------------------------------------------//
+    struct Masks
+    {
+      uint64_t m_quotes;
+      uint64_t m_bslashes;
+      uint64_t m_ops;       // "{}[]:,"
+    };
+
+    template<bool UseSIMD>
+    static Masks GetMasks(char const* a_blk)
+    {
+      Masks res;
+#     ifdef __AVX2__
+      if constexpr (UseSIMD)
+      {
+        // NB: "(c | 0x20)" maps '[' to '{' and ']' to '}':
+        __m256i const lc = _mm256_set1_epi8(0x20);
+        uint64_t      q  = 0, b = 0, o = 0;
+        for (int h = 0; h < 2; ++h)
+        {
+          __m256i v  = _mm256_loadu_si256
+                       (reinterpret_cast<__m256i const*>(a_blk + 32 * h));
+          __m256i vl = _mm256_or_si256(v, lc);
+          __m256i ops =
+            _mm256_or_si256
+            (_mm256_or_si256(_mm256_cmpeq_epi8(v,  _mm256_set1_epi8(',')),
+                             _mm256_cmpeq_epi8(v,  _mm256_set1_epi8(':'))),
+             _mm256_or_si256(_mm256_cmpeq_epi8(vl, _mm256_set1_epi8('{')),
+                             _mm256_cmpeq_epi8(vl, _mm256_set1_epi8('}'))));
+          int s = 32 * h;
+          q |= uint64_t(uint32_t(_mm256_movemask_epi8
+               (_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')))))  << s;
+          b |= uint64_t(uint32_t(_mm256_movemask_epi8
+               (_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))))) << s;
+          o |= uint64_t(uint32_t(_mm256_movemask_epi8(ops)))    << s;
+        }
+        res.m_quotes = q; res.m_bslashes = b; res.m_ops = o;
+        return res;
+      }
+      else
+#     elif defined(__SSE2__)
+      if constexpr (UseSIMD)
+      {
+        __m128i const lc = _mm_set1_epi8(0x20);
+        uint64_t      q  = 0, b = 0, o = 0;
+        for (int h = 0; h < 4; ++h)
+        {
+          __m128i v  = _mm_loadu_si128
+                       (reinterpret_cast<__m128i const*>(a_blk + 16 * h));
+          __m128i vl = _mm_or_si128(v, lc);
+          __m128i ops =
+            _mm_or_si128
+            (_mm_or_si128(_mm_cmpeq_epi8(v,  _mm_set1_epi8(',')),
+                          _mm_cmpeq_epi8(v,  _mm_set1_epi8(':'))),
+             _mm_or_si128(_mm_cmpeq_epi8(vl, _mm_set1_epi8('{')),
+                          _mm_cmpeq_epi8(vl, _mm_set1_epi8('}'))));
+          int s = 16 * h;
+          q |= uint64_t(uint16_t(_mm_movemask_epi8
+               (_mm_cmpeq_epi8(v, _mm_set1_epi8('"')))))  << s;
+          b |= uint64_t(uint16_t(_mm_movemask_epi8
+               (_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))))) << s;
+          o |= uint64_t(uint16_t(_mm_movemask_epi8(ops)))  << s;
+        }
+        res.m_quotes = q; res.m_bslashes = b; res.m_ops = o;
+        return res;
+      }
+      else
+#     endif
+      {
+        uint64_t q = 0, b = 0, o = 0;
+        for (int j = 0; j < 64; ++j)
+        {
+          char     c   = a_blk[j];
+          uint64_t bit = 1UL << j;
+          switch (c)
+          {
+          case '"':  q |= bit; break;
+          case '\\': b |= bit; break;
+          case '{': case '}': case '[': case ']': case ':': case ',':
+                     o |= bit; break;
+          default:   break;
+          }
+        }
+        res.m_quotes = q; res.m_bslashes = b; res.m_ops = o;
+        return res;
+      }
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Escaped": Mask of the chars escaped by a preceding backslash:        //
+    //-----------------------------------------------------------------------//
+    // "a_carry" is 1 iff the last byte of the prev block was an (un-escaped)
+    // backslash. Backslashes are rare in exchange msgs, so the blocks conta-
+    // ining them are processed bit by bit:
+    //
+    static uint64_t Escaped(uint64_t a_bslashes, uint64_t* a_carry)
+    {
+      if (utxx::likely(a_bslashes == 0))
+      {
+        uint64_t res = *a_carry;
+        *a_carry     = 0;
+        return res;
+      }
+      uint64_t res   = 0;
+      bool     carry = (*a_carry != 0);
+      for (int j = 0; j < 64; ++j)
+      {
+        uint64_t bit = 1UL << j;
+        if (carry)
+        {
+          res  |= bit;
+          carry = false;
+        }
+        else
+          carry = (a_bslashes & bit) != 0;
+      }
+      *a_carry = carry;
+      return res;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "PrefixXOR": Bit "j" of the result is the XOR of bits [0..j]:         //
+    //-----------------------------------------------------------------------//
+    static uint64_t PrefixXOR(uint64_t a_x)
+    {
+#     ifdef __PCLMUL__
+      __m128i r = _mm_clmulepi64_si128
+                  (_mm_set_epi64x(0, int64_t(a_x)), _mm_set1_epi8(-1), 0);
+      return uint64_t(_mm_cvtsi128_si64(r));
+#     else
+      a_x ^= a_x << 1;
+      a_x ^= a_x << 2;
+      a_x ^= a_x << 4;
+      a_x ^= a_x << 8;
+      a_x ^= a_x << 16;
+      a_x ^= a_x << 32;
+      return a_x;
+#     endif
+    }
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Default Ctor:                                                         //
+    //-----------------------------------------------------------------------//
+    StructIdx()
+    : m_offs(),
+      m_n   (0),
+      m_msg (nullptr),
+      m_len (0)
+    {}
+
+    //-----------------------------------------------------------------------//
+    // "Build":                                                              //
+    //-----------------------------------------------------------------------//
+    // The msg need not be 0-terminated; it must remain intact while the index
+    // is in use:
+    //
+    template<bool UseSIMD = HasSIMD>
+    void Build(char const* a_msg, int a_len)
+    {
+      assert(a_msg != nullptr && a_len >= 0);
+      m_msg = a_msg;
+      m_len = a_len;
+      m_n   = 0;
+
+      // There is at most 1 structural per byte:
+      if (utxx::unlikely(m_offs.size() < size_t(a_len) + 64))
+        m_offs.resize(size_t(a_len) + 64);
+      uint32_t* offs    = m_offs.data();
+      int       n       = 0;
+      uint64_t  escCarry = 0;   // 1 if the next byte is escaped
+      uint64_t  inStr    = 0;   // All 1s if the prev block ended in a string
+
+      for (int base = 0; base < a_len; base += 64)
+      {
+        // The last (partial) block is padded with spaces:
+        char const* blk = a_msg + base;
+        char        tail[64];
+        if (utxx::unlikely(a_len - base < 64))
+        {
+          memset(tail, ' ', sizeof(tail));
+          memcpy(tail, blk, size_t(a_len - base));
+          blk = tail;
+        }
+        Masks    m      = GetMasks<UseSIMD>(blk);
+        uint64_t quotes = m.m_quotes & ~Escaped(m.m_bslashes, &escCarry);
+
+        // Bits within strings (incl opening quotes, excl closing ones):
+        uint64_t strs   = PrefixXOR(quotes) ^ inStr;
+        inStr           = uint64_t(int64_t(strs) >> 63);
+
+        uint64_t bits   = (m.m_ops & ~strs) | quotes;
+        while (bits != 0)
+        {
+          offs[n++] = uint32_t(base + __builtin_ctzll(bits));
+          bits     &= bits - 1;
+        }
+      }
+      m_n = n;
+    }
+
+    //-----------------------------------------------------------------------//
+    // Accessors:                                                            //
+    //-----------------------------------------------------------------------//
+    int             GetN   () const { return m_n;           }
+    uint32_t const* GetOffs() const { return m_offs.data(); }
+    char const*     GetMsg () const { return m_msg;         }
+    int             GetLen () const { return m_len;         }
+  };
+
+  //=========================================================================//
+  // "Cursor": Forward-Only Traversal of a Msg via its "StructIdx":          //
+  //=========================================================================//
+  // After a value has been read (or skipped), the cursor is positioned at the
+  // separator which follows it (',', '}' or ']'). All errors (malformed msgs,
+  // or keys / value types other than expected) are reported by exceptions:
+  //
+  class Cursor
+  {
+  private:
+    char const*     m_msg;
+    uint32_t const* m_offs;
+    int             m_n;
+    int             m_i;      // Index of the next structural in "m_offs"
+    int             m_after;  // Offset just after the last consumed one
+
+    [[noreturn]] void Error(char const* a_what) const
+    {
+      throw utxx::runtime_error
+        ("JSON::Cursor: ", a_what, " at Offset=",
+         (m_i < m_n) ? int(m_offs[m_i]) : m_after);
+    }
+
+    // Consume the next structural (which is known to exist):
+    void Advance()
+    {
+      assert(m_i < m_n);
+      m_after = int(m_offs[m_i]) + 1;
+      ++m_i;
+    }
+
+    // Whether [from, to) is empty or white space:
+    bool IsBlank(int a_from, int a_to) const
+    {
+      for (int j = a_from; j < a_to; ++j)
+        if (!isspace(m_msg[j]))
+          return false;
+      return true;
+    }
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Non-Default Ctor:                                                     //
+    //-----------------------------------------------------------------------//
+    explicit Cursor(StructIdx const& a_idx)
+    : m_msg  (a_idx.GetMsg ()),
+      m_offs (a_idx.GetOffs()),
+      m_n    (a_idx.GetN   ()),
+      m_i    (0),
+      m_after(0)
+    {}
+
+    //-----------------------------------------------------------------------//
+    // Structural Chars:                                                     //
+    //-----------------------------------------------------------------------//
+    // "Peek": The next structural char, or '\0' at the end:
+    char Peek() const
+      { return utxx::likely(m_i < m_n) ? m_msg[m_offs[m_i]] : '\0'; }
+
+    // "Expect": Consume the next structural which must be "a_c":
+    void Expect(char a_c)
+    {
+      if (utxx::unlikely(Peek() != a_c))
+        Error("Unexpected structural char");
+      Advance();
+    }
+
+    // "TryConsume": Consume the next structural iff it is "a_c":
+    bool TryConsume(char a_c)
+    {
+      if (Peek() != a_c)
+        return false;
+      Advance();
+      return true;
+    }
+
+    //-----------------------------------------------------------------------//
+    // Objs:                                                                 //
+    //-----------------------------------------------------------------------//
+    void EnterObj() { Expect('{'); }
+
+    // "NextKey": Moves to the value of the next key of the curr obj, and re-
+    // turns "true"; at the end of the obj, consumes the '}' and returns
+    // "false":
+    //
+    bool NextKey(std::string_view* a_key)
+    {
+      assert(a_key != nullptr);
+      char c = Peek();
+      if (c == '}')
+      {
+        Advance();
+        return false;
+      }
+      if (c == ',')
+      {
+        Advance();
+        c = Peek();
+      }
+      if (utxx::unlikely(c != '"' || m_i + 2 >= m_n))
+        Error("Key expected");
+      uint32_t from = m_offs[m_i] + 1;
+      *a_key = std::string_view(m_msg + from, m_offs[m_i + 1] - from);
+      m_i   += 2;
+      Expect(':');
+      return true;
+    }
+
+    // "FindKey": Moves to the value of the key "a_key" (skipping all other
+    // keys and values on the way); returns "false" (having consumed the '}')
+    // if there is no such key in the rest of the curr obj:
+    //
+    bool FindKey(std::string_view a_key)
+    {
+      std::string_view key;
+      while (NextKey(&key))
+      {
+        if (key == a_key)
+          return true;
+        SkipVal();
+      }
+      return false;
+    }
+
+    // "LeaveObj": Skips the remaining keys and values, and the closing '}':
+    void LeaveObj()
+    {
+      std::string_view key;
+      while (NextKey(&key))
+        SkipVal();
+    }
+
+    //-----------------------------------------------------------------------//
+    // Arrays:                                                               //
+    //-----------------------------------------------------------------------//
+    // "EnterArr": Returns "false" (having consumed the ']') if the array is
+    // empty:
+    bool EnterArr()
+    {
+      Expect('[');
+      if (Peek() == ']' && IsBlank(m_after, int(m_offs[m_i])))
+      {
+        Advance();
+        return false;
+      }
+      return true;
+    }
+
+    // "NextElem": After an elem: "true" if there is another one; otherwise,
+    // consumes the ']' and returns "false":
+    bool NextElem()
+    {
+      char c = Peek();
+      if (utxx::likely(c == ','))
+      {
+        Advance();
+        return true;
+      }
+      if (utxx::unlikely(c != ']'))
+        Error("',' or ']' expected");
+      Advance();
+      return false;
+    }
+
+    // "LeaveArr": Skips the remaining elems, and the closing ']':
+    void LeaveArr()
+    {
+      do SkipVal(); while (NextElem());
+    }
+
+    //-----------------------------------------------------------------------//
+    // Values:                                                               //
+    //-----------------------------------------------------------------------//
+    // "SkipVal": Skips the curr value of any type:
+    void SkipVal()
+    {
+      char c = Peek();
+      if (c == '"')
+      {
+        if (utxx::unlikely(m_i + 1 >= m_n))
+          Error("UnTerminated string");
+        ++m_i;
+        Advance();
+      }
+      else
+      if (c == '{' || c == '[')
+      {
+        int depth = 0;
+        do
+        {
+          if (utxx::unlikely(m_i >= m_n))
+            Error("UnTerminated obj or array");
+          char d = m_msg[m_offs[m_i]];
+          depth += int(d == '{' || d == '[') - int(d == '}' || d == ']');
+          Advance();
+        }
+        while (depth > 0);
+      }
+      // Otherwise, it is a scalar which contains no structurals: Nothing to
+      // skip!
+    }
+
+    // "GetStr": The contents of a string value (escapes are NOT decoded):
+    std::string_view GetStr()
+    {
+      if (utxx::unlikely(Peek() != '"' || m_i + 1 >= m_n))
+        Error("String expected");
+      uint32_t from = m_offs[m_i] + 1;
+      std::string_view res(m_msg + from, m_offs[m_i + 1] - from);
+      ++m_i;
+      Advance();
+      return res;
+    }
+
+    // "GetRaw": The contents of a string value, or the text of a scalar one
+    // (number, "true", "false" or "null") without surrounding white space:
+    std::string_view GetRaw()
+    {
+      char c = Peek();
+      if (c == '"')
+        return GetStr();
+      if (utxx::unlikely(c == '{' || c == '[' || c == '\0'))
+        Error("Scalar expected");
+      int from = m_after;
+      int to   = int(m_offs[m_i]);
+      while (from < to && isspace(m_msg[from]))
+        ++from;
+      while (to > from && isspace(m_msg[to - 1]))
+        --to;
+      return std::string_view(m_msg + from, size_t(to - from));
+    }
+
+    // "GetDouble": A number, quoted or not:
+    double GetDouble()
+    {
+      std::string_view v   = GetRaw();
+      double           res = NaN<double>;
+      char const*      end = v.data() + v.size();
+      if (utxx::unlikely(ToDouble(v.data(), end, &res) != end))
+        Error("Invalid number");
+      return res;
+    }
+
+    PriceT GetPx() { return PriceT(GetDouble()); }
+
+    template<typename QtyN>
+    QtyN   GetQty() { return QtyN(GetDouble()); }
+
+    // "GetInt": An integer, quoted or not:
+    template<typename T>
+    T GetInt()
+    {
+      std::string_view v   = GetRaw();
+      char const*      end = v.data() + v.size();
+      T                res = 0;
+      if (utxx::unlikely(utxx::fast_atoi<T, true>(v.data(), end, res) !=
+                         end))
+        Error("Invalid integer");
+      return res;
+    }
+
+    bool GetBool()
+    {
+      std::string_view v = GetRaw();
+      if (v == "true")
+        return true;
+      if (utxx::unlikely(v != "false"))
+        Error("Boolean expected");
+      return false;
+    }
+  };
+} // End namespace JSON
+} // End namespace MAQUETTE
@@ -1,18 +1,23 @@
 
 #include "BackTest.h"
 
+#include "QuantSupport/BT/BackTestRunner.h"
 #include "QuantSupport/BT/DataProvider.h"
 
 #include "QuantSupport/BT/SecDefs.h"
 
 #include "Connectors/OrderBook.h"
 #include "Basis/ConfigUtils.hpp"
+#include "InfraStruct/PersistMgr.h"
+#include "InfraStruct/RiskMgr.h"
 
 #include <boost/ptr_container/ptr_deque.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include <fstream>
 #include <list>
+#include <set>
+#include <thread>
 
 namespace MAQUETTE
 {
@@ -142,6 +147,36 @@ namespace MAQUETTE
       }
     }
 
+    /**
+     * Number of windows in the test period
+     */
+    uint32_t Windows() const
+    {
+      uint32_t n = 0;
+      while (m_period.inside(n))
+        ++n;
+      return n;
+    }
+
+    /**
+     * Load market data for window @a index of the test period
+     */
+    void Load(uint32_t index)
+    {
+      auto [from, to] = m_period.window(index);
+      dm.Load(from, to);
+      cur_window = index;
+    }
+
+    /**
+     * Run all subscribed strategies (one by one) over the loaded window
+     */
+    void RunAll()
+    {
+      for (auto& c: m_consumers)
+        Run(c.first);
+    }
+
     std::map<Strategy*, std::list<Consumer>>::iterator m_consumers_it;
 
     void RunImpl()
@@ -171,8 +206,7 @@ namespace MAQUETTE
 
       while (m_period.inside(cur_window))
       {
-        auto [from, to] = m_period.window(cur_window);
-        dm.Load(from, to);
+        Load(cur_window);
         m_consumers_it = m_consumers.begin();
         std::vector<std::thread> thrds;
         for (uint32_t i = 0; i < threads; ++i)
@@ -194,6 +228,16 @@ namespace MAQUETTE
 
   static std::unique_ptr<BackTesting> _back_testing;
 
+  // Context of the parallel runner job on this thread (if any): the Back-
+  // Testing of its worker, and the report slot of the job
+  static thread_local BackTesting*            _job_back_testing = nullptr;
+  static thread_local History::BTReport::slot* _job_results     = nullptr;
+
+  static BackTesting& CurrentBackTesting()
+  {
+    return _job_back_testing ? *_job_back_testing : *_back_testing;
+  }
+
   namespace History
   {
     void SubscribeMktData(
@@ -203,7 +247,15 @@ namespace MAQUETTE
         bool            order_mgmt)
     {
       assert(s && c);
-      _back_testing->Set(s, c, a_instr, order_mgmt);
+      CurrentBackTesting().Set(s, c, a_instr, order_mgmt);
+    }
+
+    bool ReportStatistics(std::string const& name, Statistics const& stat)
+    {
+      if (!_job_results)
+        return false;
+      _job_results->emplace_back(name, stat);
+      return true;
     }
 
     struct brute_node
@@ -385,57 +437,62 @@ namespace MAQUETTE
 
     struct BruteGenerator
     {
-      static const uint32_t        max_brutes = 1000000;
-      boost::ptr_deque<StrategyBT> strats;
-      std::vector<std::string>     brute_params, bt_names;
+      static const uint32_t    max_brutes = 1000000;
+      std::vector<std::string> brute_params, bt_names;
+      uint32_t                 count = 0;
 
       ptree&       pt;
       ptree const* p_bt;
 
-      EPollReactor&   reactor;
-      spdlog::logger* logger;
-      InitBT          init;
-      std::string     omc_name;
-
-      BruteGenerator(
-          ptree&             _pt,
-          EPollReactor&      _reactor,
-          spdlog::logger*    _logger,
-          InitBT             _init,
-          ptree const*       _p_bt,
-          const std::string& _omc_name) :
-        pt(_pt),
-        p_bt(_p_bt),
-        reactor(_reactor),
-        logger(_logger),
-        init(_init),
-        omc_name(_omc_name)
+      /**
+       * Called for every parameter combination in turn, with the combination
+       * applied to the config, and its name
+       */
+      using visitor = std::function<void(std::string const& bt_name)>;
+
+      BruteGenerator(ptree& _pt, ptree const* _p_bt) : pt(_pt), p_bt(_p_bt)
       {
         std::string brute = p_bt->get<std::string>("Brute");
         boost::split(brute_params, brute, [](char c) { return c == ','; });
         if (brute_params.empty())
           throw std::runtime_error("BruteGenerator() nothing for brute");
         bt_names.resize(brute_params.size());
-        impl(0);
-        logger->info("BruteGenerator(): {} instances created", strats.size());
       }
 
-      void impl(uint32_t p_id)
+      /**
+       * Config paths of the brute-forced parameters
+       */
+      std::vector<std::string> keys() const
+      {
+        std::vector<std::string> res;
+        for (auto const& p: brute_params)
+        {
+          brute_node b(p, p_bt);
+          res.push_back(b.path + b.name);
+        }
+        return res;
+      }
+
+      void generate(visitor const& f)
+      {
+        count = 0;
+        impl(0, f);
+      }
+
+      void impl(uint32_t p_id, visitor const& f)
       {
         brute_node b(brute_params[p_id], p_bt);
         do
         {
           b.apply(pt, bt_names[p_id]);
           if (p_id + 1 != brute_params.size())
-            impl(p_id + 1);
+            impl(p_id + 1, f);
           else
           {
-            if (strats.size() == max_brutes)
+            if (count == max_brutes)
               throw std::runtime_error("max_brutes exceeded");
-            pt.put<std::string>(
-                omc_name + ".Name",
-                boost::algorithm::join(bt_names, ""));
-            strats.push_back(init(pt, reactor, logger));
+            ++count;
+            f(boost::algorithm::join(bt_names, ""));
           }
         } while (b.next());
       }
@@ -443,7 +500,355 @@ namespace MAQUETTE
 
     SecDefD const& FindSecDef(const std::string& ticker)
     {
-      return _back_testing->dm.GetSecDef(ticker);
+      return CurrentBackTesting().dm.GetSecDef(ticker);
+    }
+
+    /**
+     * Makes the connectors configured in the BT config private to one worker
+     * of the parallel runner. Every top-level section with an "AccountKey"
+     * gets the worker tag inserted before its environment suffix, so that the
+     * workers share neither loggers nor ShM segments, and an explicit
+     * "MapAddr" for its segment (the hashed addresses of so many similar names
+     * would clash); "Deals" files are disabled.
+     * Likewise, the "RiskMgr" (if configured) gets the worker tag appended to
+     * its "AccountPfx" and an explicit "MapAddr", so that every worker has a
+     * private RiskMgr in a segment of its own; it is reset for every job
+     */
+    class WorkerConnectors
+    {
+      public:
+      /**
+       * @param pt - full config
+       * @param worker - worker index
+       * @param slots - ShM map slots (see PersistMgr) which are already taken;
+       * the ones taken here are added
+       */
+      WorkerConnectors(
+          ptree const&                  pt,
+          uint32_t                      worker,
+          std::set<unsigned long>&      slots)
+      {
+        using PM = PersistMgr<>;
+        unsigned long slot = PM::SegmIdxMod;
+        std::string   tag  = "-BT" + std::to_string(worker);
+        for (auto const& kv: pt)
+        {
+          auto key = kv.second.get_optional<std::string>("AccountKey");
+          if (!key)
+            continue;
+
+          std::string name = *key;
+          size_t      dash = name.rfind('-');
+          name.insert(dash == std::string::npos ? name.size() : dash, tag);
+
+          m_sections.push_back(kv.first);
+          m_names.push_back(name);
+          m_addrs.push_back(TakeSlot(slot, slots));
+          m_params.push_back(kv.second);
+
+          // Segments left over from a previous (failed) run
+          PM::Remove(name, &kv.second);
+        }
+
+        ptree const* rm = GetParamsOptTree(pt, "RiskMgr");
+        if (rm)
+        {
+          std::string pfx = rm->get<std::string>("AccountPfx", "");
+          m_rmPfx = pfx.empty() ? tag.substr(1) : pfx + tag;
+          m_rmParams.reset(new ptree(*rm));
+          m_rmParams->put<std::string>("AccountPfx", m_rmPfx);
+          m_rmParams->put<std::string>("MapAddr", TakeSlot(slot, slots));
+          RemoveRiskMgr();
+        }
+      }
+
+      ~WorkerConnectors()
+      {
+        for (size_t i = 0; i != m_names.size(); ++i)
+          PersistMgr<>::Remove(m_names[i], &m_params[i]);
+        if (m_rmParams)
+          RemoveRiskMgr();
+      }
+
+      /**
+       * Hashed ShM map slot of every connector in @a pt as configured
+       */
+      static std::set<unsigned long> ConfiguredSlots(ptree const& pt)
+      {
+        using PM = PersistMgr<>;
+        std::set<unsigned long> res;
+        for (auto const& kv: pt)
+        {
+          auto key = kv.second.get_optional<std::string>("AccountKey");
+          if (!key)
+            continue;
+          auto addr = reinterpret_cast<unsigned long>(
+              PM::GetMapAddr(*key, &kv.second));
+          if (addr >= PM::BaseMapAddr)
+            res.insert((addr - PM::BaseMapAddr) / PM::MaxSegmSz);
+        }
+        return res;
+      }
+
+      /**
+       * Install the private connectors into the job config @a pt
+       */
+      void Apply(ptree& pt) const
+      {
+        for (size_t i = 0; i != m_names.size(); ++i)
+        {
+          pt.put<std::string>(m_sections[i] + ".AccountKey", m_names[i]);
+          pt.put<std::string>(m_sections[i] + ".MapAddr", m_addrs[i]);
+          pt.put<std::string>(m_sections[i] + ".Deals", "");
+        }
+        if (m_rmParams)
+        {
+          pt.put<std::string>("RiskMgr.AccountPfx", m_rmPfx);
+          pt.put<std::string>(
+              "RiskMgr.MapAddr",
+              m_rmParams->get<std::string>("MapAddr"));
+          pt.put<bool>("RiskMgr.ResetAll", true);
+        }
+      }
+
+      /**
+       * Forget the loggers of the connectors destroyed at the end of a job,
+       * so that the next job can create them again
+       */
+      void Release() const
+      {
+        for (auto const& name: m_names)
+          spdlog::drop(name);
+      }
+
+      private:
+      /**
+       * Take the highest free ShM map slot below @a slot, and return its
+       * address as a "MapAddr" value
+       */
+      static std::string TakeSlot(
+          unsigned long&           slot,
+          std::set<unsigned long>& slots)
+      {
+        using PM = PersistMgr<>;
+        do
+        {
+          if (slot == 0)
+            throw utxx::runtime_error("WorkerConnectors: no free ShM slots");
+          --slot;
+        } while (!slots.insert(slot).second);
+
+        char addr[32];
+        snprintf(
+            addr,
+            sizeof(addr),
+            "0x%lx",
+            PM::BaseMapAddr + PM::MaxSegmSz * slot);
+        return addr;
+      }
+
+      /**
+       * Unmap and remove the private RiskMgr segment (of either environment,
+       * as only the strategy knows which one it uses)
+       */
+      void RemoveRiskMgr() const
+      {
+        RiskMgr::RemovePersistInstance(true, *m_rmParams);
+        RiskMgr::RemovePersistInstance(false, *m_rmParams);
+      }
+
+      std::vector<std::string> m_sections;
+      std::vector<std::string> m_names;
+      std::vector<std::string> m_addrs;
+      std::vector<ptree>       m_params;
+      std::string              m_rmPfx;
+      std::unique_ptr<ptree>   m_rmParams; // private RiskMgr params, if any
+    };
+
+    /**
+     * Worker of the parallel runner: its own reactor and connectors, and the
+     * BackTesting (with the loaded market data) of its current job, which is
+     * reused while the instrument set and the day stay the same
+     */
+    struct BTWorker
+    {
+      static constexpr uint32_t None = ~0u;
+
+      std::unique_ptr<EPollReactor> reactor;
+      WorkerConnectors              conns;
+      std::unique_ptr<BackTesting>  ctx;
+      uint32_t                      instrs = None;
+      uint32_t                      day    = None;
+
+      BTWorker(
+          ptree const&             pt,
+          uint32_t                 worker,
+          std::set<unsigned long>& slots,
+          spdlog::logger*          logger,
+          int                      debug_level) :
+        reactor(new EPollReactor(logger, debug_level, false, false)),
+        conns(pt, worker, slots)
+      {
+      }
+    };
+
+    /**
+     * Sets the job context of the calling thread for the lifetime of a job,
+     * and cleans up after it
+     */
+    struct JobScope
+    {
+      BTWorker& worker;
+
+      JobScope(BTWorker& w, BTReport::slot* results) : worker(w)
+      {
+        _job_back_testing = w.ctx.get();
+        _job_results      = results;
+      }
+
+      ~JobScope()
+      {
+        worker.ctx->m_consumers.clear();
+        worker.conns.Release();
+        _job_back_testing = nullptr;
+        _job_results      = nullptr;
+      }
+    };
+
+    /**
+     * "parallel" mode: every (day, instrument set, parameter set) job is a
+     * separate strategy instance, run over one window on one of the workers;
+     * the OMC statistics of all jobs are aggregated into one Result file.
+     * Every worker has private connectors and RiskMgr (see WorkerConnectors)
+     */
+    void RunParallel(
+        ptree&             pt,
+        ptree const&       bt,
+        spdlog::logger*    logger,
+        InitBT             init,
+        std::string const& omc_name)
+    {
+      // Parameter sets: the "Brute" grid, if any
+      std::vector<std::string>              keys, names;
+      std::vector<std::vector<std::string>> values;
+      if (bt.get_optional<std::string>("Brute"))
+      {
+        BruteGenerator g(pt, &bt);
+        keys = g.keys();
+        g.generate(
+            [&](std::string const& name)
+            {
+              names.push_back(name);
+              values.emplace_back();
+              for (auto const& k: keys)
+                values.back().push_back(pt.get<std::string>(k));
+            });
+      }
+      else
+      {
+        names.push_back("current");
+        values.emplace_back();
+      }
+
+      // Instrument sets: ';'-separated lists of tickers. Their data are
+      // fetched here (by the DataProvider ctor), so that the loader runs only
+      // once per ticker and window, not concurrently by the workers
+      std::string tickers = pt.get<std::string>("MDC.Tickers");
+      std::string sets_s  = bt.get<std::string>("InstrSets", tickers);
+      std::vector<std::string> sets;
+      boost::split(sets, sets_s, [](char c) { return c == ';'; });
+      for (auto const& set: sets)
+        if (set != tickers)
+          BackTesting fetch(bt, logger, set);
+
+      uint32_t threads = bt.get<uint32_t>(
+          "Threads",
+          std::max(1u, std::thread::hardware_concurrency()));
+
+      JobSpace space{
+          _back_testing->Windows(),
+          uint32_t(sets.size()),
+          uint32_t(names.size())};
+
+      logger->info(
+          "RunParallel(): {} jobs ({} days, {} instr sets, {} param sets) on "
+          "{} threads",
+          space.size(),
+          space.days,
+          space.instr_sets,
+          space.param_sets,
+          threads);
+
+      std::set<unsigned long> slots = WorkerConnectors::ConfiguredSlots(pt);
+      std::vector<std::unique_ptr<BTWorker>> workers;
+      for (uint32_t w = 0; w != threads; ++w)
+        workers.emplace_back(new BTWorker(
+            pt, w, slots, logger, bt.get<int>("DebugLevel")));
+
+      BTReport            report(space.size());
+      std::atomic<size_t> failed(0);
+      WorkStealingPool    pool(threads);
+
+      pool.run(
+          space.size(),
+          [&](uint32_t w, size_t j)
+          {
+            BTWorker&     wk  = *workers[w];
+            JobSpace::job job = space[j];
+            try
+            {
+              if (!wk.ctx || wk.instrs != job.instrs)
+              {
+                wk.ctx.reset();
+                wk.instrs = BTWorker::None;
+                wk.ctx.reset(new BackTesting(bt, logger, sets[job.instrs]));
+                wk.instrs = job.instrs;
+                wk.day    = BTWorker::None;
+              }
+              if (wk.day != job.day)
+              {
+                wk.day = BTWorker::None;
+                wk.ctx->Load(job.day);
+                wk.day = job.day;
+              }
+
+              ptree jpt = pt;
+              for (size_t k = 0; k != keys.size(); ++k)
+                jpt.put<std::string>(keys[k], values[job.params][k]);
+              jpt.put<std::string>("MDC.Tickers", sets[job.instrs]);
+              jpt.put<std::string>(
+                  omc_name + ".Name",
+                  sets.size() == 1
+                      ? names[job.params]
+                      : names[job.params] + "{InstrSet = " + sets[job.instrs]
+                            + "}");
+              wk.conns.Apply(jpt);
+
+              // The strategy (and so its OMC, which reports its statistics)
+              // is destroyed before the job context is reset
+              JobScope                    scope(wk, &report[j]);
+              std::unique_ptr<StrategyBT> s(init(jpt, *wk.reactor, logger));
+              wk.ctx->RunAll();
+            }
+            catch (std::exception const& e)
+            {
+              ++failed;
+              logger->error(
+                  "RunParallel(): job {} (day {}, instrs {}, params {}) "
+                  "failed: {}",
+                  j,
+                  job.day,
+                  job.instrs,
+                  job.params,
+                  e.what());
+            }
+          });
+
+      report.write(pt.get<std::string>(omc_name + ".Result"));
+      logger->info(
+          "RunParallel(): done, {} jobs failed, {} steals",
+          failed.load(),
+          pool.steals());
     }
   } // namespace History
 
@@ -474,15 +879,28 @@ namespace MAQUETTE
         std::unique_ptr<StrategyBT> bt(init(pt, reactor, logger));
         _back_testing->Run(1);
       }
-      else if (mode != "grid")
-        throw utxx::runtime_error("Unknown BT Mode: ", mode);
-      else
+      else if (mode == "grid")
       {
         pt.put<std::string>(omc_name + ".Deals", "");
-        uint32_t       threads = p->get<uint32_t>("Threads");
-        BruteGenerator g(pt, reactor, logger, init, p, omc_name);
+        uint32_t                     threads = p->get<uint32_t>("Threads");
+        boost::ptr_deque<StrategyBT> strats;
+        BruteGenerator               g(pt, p);
+        g.generate(
+            [&](std::string const& name)
+            {
+              pt.put<std::string>(omc_name + ".Name", name);
+              strats.push_back(init(pt, reactor, logger));
+            });
+        logger->info("BruteGenerator(): {} instances created", strats.size());
         _back_testing->Run(threads);
       }
+      else if (mode == "parallel")
+      {
+        pt.put<std::string>(omc_name + ".Deals", "");
+        RunParallel(pt, *p, logger, init, omc_name);
+      }
+      else
+        throw utxx::runtime_error("Unknown BT Mode: ", mode);
     }
     else
     {
@@ -65,6 +65,47 @@ namespace MAQUETTE
       QtyUD count;
     };
 
+    /**
+     * Order management statistics of one instrument, as collected by the
+     * historical OMC
+     */
+    struct Statistics
+    {
+      SecID       secID;
+      std::string symbol;
+
+      double   fee_maker  = 0;
+      double   fee_taker  = 0;
+      uint32_t new_orders = 0;
+      uint32_t cancels    = 0;
+      uint32_t modifies   = 0;
+      double   volume     = 0;
+      double   delta      = 0;
+      double   min_pos    = 0;
+      double   max_pos    = 0;
+      double   cur_pos    = 0;
+      // Number of runs aggregated into this one
+      uint32_t runs       = 1;
+
+      /**
+       * Aggregate the results of another run over the same instrument
+       */
+      void add(Statistics const& r);
+
+      /**
+       * Print as a Result file line for the run @a name into @a buf (which
+       * must be at least 1024 bytes long); returns the end of the line
+       */
+      char* print(char* buf, std::string const& name) const;
+    };
+
+    /**
+     * Hand the final statistics of the OMC @a name over to the parallel
+     * runner, if the calling thread runs one of its jobs. Returns false
+     * otherwise (then the OMC writes them to its Result file itself)
+     */
+    bool ReportStatistics(std::string const& name, Statistics const& stat);
+
     template<typename ... args>
     inline void unused(args& ...)
     {
@@ -91,9 +132,9 @@ namespace MAQUETTE
             const SecDefD& a_instr,
             utxx::time_val time,
             uint16_t       asks_size,
-            quote*         asks_quotes,
+            quote const*   asks_quotes,
             uint16_t       bids_size,
-            quote*         bids_quotes)
+            quote const*   bids_quotes)
         {
           unused(a_instr, time, asks_size, asks_quotes, bids_size, bids_quotes);
         }
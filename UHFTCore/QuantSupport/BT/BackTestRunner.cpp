@@ -0,0 +1,218 @@
+// vim:ts=2:et
+//===========================================================================//
+//                   "QuantSupport/BT/BackTestRunner.cpp":                   //
+//===========================================================================//
+
+#include "QuantSupport/BT/BackTestRunner.h"
+
+#include <utxx/convert.hpp>
+#include <utxx/error.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <thread>
+
+namespace MAQUETTE
+{
+  namespace History
+  {
+    void Statistics::add(Statistics const& r)
+    {
+      fee_maker += r.fee_maker;
+      fee_taker += r.fee_taker;
+      new_orders += r.new_orders;
+      cancels += r.cancels;
+      modifies += r.modifies;
+      volume += r.volume;
+      delta += r.delta;
+      min_pos = std::min(min_pos, r.min_pos);
+      max_pos = std::max(max_pos, r.max_pos);
+      cur_pos += r.cur_pos;
+      runs += r.runs;
+    }
+
+    char* Statistics::print(char* buf, std::string const& name) const
+    {
+      // Leave room for the numeric fields in a 1024 bytes buffer
+      size_t const max_len = 384;
+
+      char* c = buf;
+      c = stpncpy(c, symbol.c_str(), std::min(symbol.size(), max_len));
+      *(c++) = ',';
+      c = stpncpy(c, name.c_str(), std::min(name.size(), max_len));
+      c = stpcpy(c, ", delta:");
+      c += utxx::ftoa_left(delta, c, 16, 8);
+      c = stpcpy(c, ", fee_maker:");
+      c += utxx::ftoa_left(fee_maker, c, 16, 8);
+      c = stpcpy(c, ", fee_taker:");
+      c += utxx::ftoa_left(fee_taker, c, 16, 8);
+      c = stpcpy(c, ", volume:");
+      c += utxx::ftoa_left(volume, c, 16, 8);
+      c = stpcpy(c, ", min_pos:");
+      c += utxx::ftoa_left(min_pos, c, 16, 8);
+      c = stpcpy(c, ", max_pos:");
+      c += utxx::ftoa_left(max_pos, c, 16, 8);
+      c = stpcpy(c, ", new:");
+      c = utxx::itoa_left<uint32_t, 8>(c, new_orders);
+      c = stpcpy(c, ", cancels:");
+      c = utxx::itoa_left<uint32_t, 8>(c, cancels);
+      c = stpcpy(c, ", modifies:");
+      c = utxx::itoa_left<uint32_t, 8>(c, modifies);
+      if (runs != 1)
+      {
+        c = stpcpy(c, ", runs:");
+        c = utxx::itoa_left<uint32_t, 8>(c, runs);
+      }
+      *(c++) = '\n';
+      return c;
+    }
+
+    WorkStealingPool::WorkStealingPool(uint32_t threads) :
+      m_threads(threads),
+      m_blocks(new block[threads]),
+      m_steals(0),
+      m_failed(false)
+    {
+      if (threads == 0)
+        throw utxx::badarg_error("WorkStealingPool: no threads");
+    }
+
+    void WorkStealingPool::run(size_t n, task const& f)
+    {
+      // Contiguous blocks of (almost) equal size
+      for (uint32_t w = 0; w != m_threads; ++w)
+      {
+        m_blocks[w].begin = n * w / m_threads;
+        m_blocks[w].end   = n * (w + 1) / m_threads;
+      }
+      m_steals = 0;
+      m_failed = false;
+      m_error  = nullptr;
+
+      std::vector<std::thread> thrds;
+      thrds.reserve(m_threads - 1);
+      for (uint32_t w = 1; w < m_threads; ++w)
+        thrds.emplace_back(&WorkStealingPool::work, this, w, std::cref(f));
+      work(0, f);
+      for (auto& t: thrds)
+        t.join();
+
+      if (m_error)
+        std::rethrow_exception(m_error);
+    }
+
+    bool WorkStealingPool::pop(uint32_t w, size_t* job)
+    {
+      block&                      b = m_blocks[w];
+      std::lock_guard<std::mutex> lock(b.lock);
+      if (b.begin == b.end)
+        return false;
+      *job = b.begin++;
+      return true;
+    }
+
+    bool WorkStealingPool::steal(uint32_t w)
+    {
+      for (;;)
+      {
+        // Find the largest block left. The sizes are only hints here (they
+        // are read one block at a time), so the victim is re-checked below
+        uint32_t victim = w;
+        size_t   most   = 0;
+        for (uint32_t v = 0; v != m_threads; ++v)
+        {
+          if (v == w)
+            continue;
+          std::lock_guard<std::mutex> lock(m_blocks[v].lock);
+          size_t left = m_blocks[v].end - m_blocks[v].begin;
+          if (left > most)
+          {
+            most   = left;
+            victim = v;
+          }
+        }
+        if (most == 0)
+          return false;
+
+        // Take the back half (rounded up, so a single job can be stolen too)
+        size_t from, to;
+        {
+          block&                      b = m_blocks[victim];
+          std::lock_guard<std::mutex> lock(b.lock);
+          size_t left = b.end - b.begin;
+          if (left == 0)
+            continue;
+          to    = b.end;
+          from  = b.end - (left + 1) / 2;
+          b.end = from;
+        }
+
+        block&                      mine = m_blocks[w];
+        std::lock_guard<std::mutex> lock(mine.lock);
+        assert(mine.begin == mine.end);
+        mine.begin = from;
+        mine.end   = to;
+        m_steals.fetch_add(1, std::memory_order_relaxed);
+        return true;
+      }
+    }
+
+    void WorkStealingPool::work(uint32_t w, task const& f)
+    {
+      size_t job;
+      while (!m_failed.load(std::memory_order_relaxed))
+      {
+        if (!pop(w, &job))
+        {
+          if (steal(w))
+            continue;
+          return;
+        }
+        try
+        {
+          f(w, job);
+        }
+        catch (...)
+        {
+          std::lock_guard<std::mutex> lock(m_error_lock);
+          if (!m_error)
+            m_error = std::current_exception();
+          m_failed = true;
+        }
+      }
+    }
+
+    std::vector<BTReport::entry> BTReport::summary() const
+    {
+      std::vector<entry>                              res;
+      std::map<std::pair<std::string, SecID>, size_t> index;
+      for (slot const& s: m_slots)
+        for (entry const& e: s)
+        {
+          auto key = std::make_pair(e.first, e.second.secID);
+          auto ins = index.emplace(key, res.size());
+          if (ins.second)
+            res.push_back(e);
+          else
+            res[ins.first->second].second.add(e.second);
+        }
+      return res;
+    }
+
+    void BTReport::write(std::string const& fname) const
+    {
+      std::ofstream of(fname.c_str(), std::ios::app | std::ios::binary);
+      if (!of)
+        throw utxx::runtime_error("Creating file error: ", fname);
+
+      char buf[1024];
+      for (entry const& e: summary())
+      {
+        char* c = e.second.print(buf, e.first);
+        of.write(buf, c - buf);
+      }
+    }
+
+  } // namespace History
+} // namespace MAQUETTE
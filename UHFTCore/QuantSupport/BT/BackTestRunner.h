@@ -0,0 +1,152 @@
+// vim:ts=2:et
+//===========================================================================//
+//                    "QuantSupport/BT/BackTestRunner.h":                    //
+//===========================================================================//
+
+#pragma once
+
+#include "QuantSupport/BT/BackTest.h"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace MAQUETTE
+{
+  namespace History
+  {
+    /**
+     * Job space of the parallel runner: every (day, instrument set,
+     * parameter set) triple is one independent job. Jobs are numbered with
+     * the parameter set varying fastest, so that neighbouring jobs share
+     * their market data
+     */
+    struct JobSpace
+    {
+      struct job
+      {
+        uint32_t day;
+        uint32_t instrs;
+        uint32_t params;
+      };
+
+      uint32_t days;
+      uint32_t instr_sets;
+      uint32_t param_sets;
+
+      size_t size() const
+      {
+        return size_t(days) * instr_sets * param_sets;
+      }
+
+      job operator[](size_t i) const
+      {
+        assert(i < size());
+        job res;
+        res.params = uint32_t(i % param_sets);
+        i /= param_sets;
+        res.instrs = uint32_t(i % instr_sets);
+        res.day    = uint32_t(i / instr_sets);
+        return res;
+      }
+    };
+
+    /**
+     * Work-stealing thread pool for coarse-grained jobs. Jobs [0, n) are split
+     * into contiguous blocks, one per worker. A worker runs its block front to
+     * back, which keeps consecutive jobs (and so their data) on one thread;
+     * once it is empty, the worker steals the back half of the largest block
+     * left and carries on with that
+     */
+    class WorkStealingPool
+    {
+      public:
+      using task = std::function<void(uint32_t worker, size_t job)>;
+
+      explicit WorkStealingPool(uint32_t threads);
+
+      uint32_t threads() const
+      {
+        return m_threads;
+      }
+
+      /**
+       * Run all jobs; the calling thread is worker 0. If a task throws, no
+       * more jobs are started, and the first exception is rethrown once all
+       * workers have stopped
+       */
+      void run(size_t n, task const& f);
+
+      /**
+       * Number of successful steals in the last run()
+       */
+      size_t steals() const
+      {
+        return m_steals.load(std::memory_order_relaxed);
+      }
+
+      private:
+      struct alignas(64) block
+      {
+        std::mutex lock;
+        size_t     begin = 0;
+        size_t     end   = 0;
+      };
+
+      bool pop(uint32_t w, size_t* job);
+      bool steal(uint32_t w);
+      void work(uint32_t w, task const& f);
+
+      uint32_t                 m_threads;
+      std::unique_ptr<block[]> m_blocks;
+      std::atomic<size_t>      m_steals;
+      std::atomic<bool>        m_failed;
+      std::mutex               m_error_lock;
+      std::exception_ptr       m_error;
+    };
+
+    /**
+     * Collects the OMC statistics of every job of a parallel run and
+     * aggregates them into one report. Each job has its own slot, written
+     * only by the worker running it, and slots are merged in job order, so
+     * the report does not depend on the number of threads or on scheduling
+     */
+    class BTReport
+    {
+      public:
+      // Run name, statistics of one instrument
+      using entry = std::pair<std::string, Statistics>;
+      using slot  = std::vector<entry>;
+
+      explicit BTReport(size_t jobs) : m_slots(jobs)
+      {
+      }
+
+      slot& operator[](size_t job)
+      {
+        return m_slots[job];
+      }
+
+      /**
+       * Statistics aggregated by (run name, instrument), in the order of
+       * their first appearance
+       */
+      std::vector<entry> summary() const;
+
+      /**
+       * Write the summary to @a fname in the Result file format of the
+       * historical OMC (with the number of aggregated runs added)
+       */
+      void write(std::string const& fname) const;
+
+      private:
+      std::vector<slot> m_slots;
+    };
+
+  } // namespace History
+} // namespace MAQUETTE
@@ -231,7 +231,6 @@ namespace MAQUETTE
 
     void DataProvider::Load(time_t from, time_t to)
     {
-      m_data.clear();
       LOG_INFO(
             4,
             "BackTesting::Load from {}, to {}, {} tickers",
@@ -239,12 +238,21 @@ namespace MAQUETTE
             to,
             m_tickers.size())
 
-      for (auto ticker: m_tickers)
+      // Streams are reused from the previous period, so their memory is only
+      // allocated once
+      m_streams.resize(2 * m_tickers.size());
+      for (size_t i = 0; i != m_tickers.size(); ++i)
       {
-        loadTicker(ticker, m_marketDepth, from, to);
+        loadTicker(
+            m_tickers[i],
+            m_marketDepth,
+            from,
+            to,
+            m_streams[2 * i],
+            m_streams[2 * i + 1]);
       }
+      EventReplay::record(m_streams, &m_order);
 
-      std::sort(m_data.begin(), m_data.end());
       LOG_INFO(4, "BackTesting::Load complete")
     }
 
@@ -262,19 +270,21 @@ namespace MAQUETTE
 
     DataProvider::iterator DataProvider::begin() const
     {
-      return iterator{m_data.begin()};
+      return iterator{m_streams, m_order};
     }
 
     DataProvider::iterator DataProvider::end() const
     {
-      return iterator{m_data.end()};
+      return iterator{};
     }
 
     void DataProvider::loadTicker(
         const std::string& ticker,
         uint32_t           mktDepth,
         time_t             from,
-        time_t             to)
+        time_t             to,
+        EventStream&       books,
+        EventStream&       trades)
     {
       auto it = m_ids.find(ticker);
       if (it == m_ids.end())
@@ -285,26 +295,31 @@ namespace MAQUETTE
       std::string sf = time_to_str(from);
       std::string st = time_to_str(to);
 
+      books.clear(it->second);
       loadOrderBook(
-            it->second,
-            mktDepth,
+            books,
             m_cachePath + ticker + "_" + std::to_string(mktDepth) + "_" + sf + "_"
             + st + "_book");
+      books.sort();
+
+      trades.clear(it->second);
       loadTrades(
-            it->second,
+            trades,
             m_cachePath + ticker + "_" + sf + "_" + st + "_trades.csv");
+      trades.sort();
     }
 
-    void DataProvider::loadTrades(uint16_t id, const std::string &fname)
+    void DataProvider::loadTrades(
+        EventStream& stream, const std::string &fname)
     {
       std::vector<char> buf = read_file(fname.c_str());
       char *it = &buf[0], *ie = it + buf.size();
       for(;it != ie; ++it)
       {
-        data d;
-        d.id = id;
-        it = const_cast<char*>(utxx::fast_atoi<uint64_t, false>(
-                                 it, ie, reinterpret_cast<uint64_t&>(d.time)));
+        uint64_t time;
+        bool     is_buy;
+        quote    trade;
+        it = const_cast<char*>(utxx::fast_atoi<uint64_t, false>(it, ie, time));
         if(*it != ',')
           throw utxx::runtime_error(
               "DataManager::load_trades() parsing error: ",
@@ -312,7 +327,7 @@ namespace MAQUETTE
         ++it;
         if(*it == '1' && *(it + 1) == ',') {
           it = it + 2;
-          d.type = 3;
+          is_buy = true;
         }
         else if(*it != '-' || *(it + 1) != '1' || *(it + 2) != ',')
           throw utxx::runtime_error(
@@ -321,24 +336,24 @@ namespace MAQUETTE
         else
         {
           it += 3;
-          d.type = 2;
+          is_buy = false;
         }
 
-        d.trade.price = PriceT(strtod(it, &it));
+        trade.price = PriceT(strtod(it, &it));
         if(*it != ',')
           throw utxx::runtime_error(
               "DataManager::load_trades() parsing error: ",
               fname);
         ++it;
-        d.trade.count = QtyUD(strtod(it, &it));
+        trade.count = QtyUD(strtod(it, &it));
 
-        m_data.push_back(d);
+        stream.add_trade(
+            utxx::time_val(utxx::nsecs(long(time))), is_buy, trade);
       }
     }
 
     void DataProvider::loadOrderBook(
-        uint16_t           id,
-        uint32_t           mktDepth,
+        EventStream&       stream,
         const std::string& fname)
     {
       auto skip_fixed = [fname](char*& it, char c) -> void {
@@ -349,24 +364,19 @@ namespace MAQUETTE
         ++it;
       };
 
+      // Levels are appended straight into the stream's quote pool: bids
+      // ("1") come first in the file, then asks ("-1")
       std::vector<char> buf = read_file(fname.c_str());
       char *            it = &buf[0], *ie = it + buf.size();
       for (; it != ie; ++it)
       {
-        data d;
-        d.id   = id;
-        d.type = 1;
-        it     = const_cast<char*>(utxx::fast_atoi<uint64_t, false>(
-            it,
-            ie,
-            reinterpret_cast<uint64_t&>(d.time)));
+        uint64_t time;
+        it = const_cast<char*>(utxx::fast_atoi<uint64_t, false>(it, ie, time));
+        stream.begin_book(utxx::time_val(utxx::nsecs(long(time))));
         if (*it == ',')
         {
           ++it;
-          d.quotes[0]   = new quote[mktDepth];
-          d.quotes[1]   = new quote[mktDepth];
-          quote*    ptr = d.quotes[1];
-          uint16_t* sz  = &d.asks_size;
+          bool is_bid = true;
         repeat:
           if (*it == '1')
             ++it;
@@ -377,8 +387,7 @@ namespace MAQUETTE
           else
           {
             it += 2;
-            ptr = d.quotes[0];
-            sz  = &d.bids_size;
+            is_bid = false;
           }
           skip_fixed(it, ',');
           for (;;)
@@ -386,12 +395,15 @@ namespace MAQUETTE
             if (*it == '[')
             {
               ++it;
-              ptr->price = PriceT(strtod(it, &it));
+              quote q;
+              q.price = PriceT(strtod(it, &it));
               skip_fixed(it, ',');
-              ptr->count = QtyUD(strtod(it, &it));
+              q.count = QtyUD(strtod(it, &it));
               skip_fixed(it, ']');
-              ++ptr;
-              ++(*sz);
+              if (is_bid)
+                stream.add_bid(q);
+              else
+                stream.add_ask(q);
             }
             if (*it == ',')
               ++it;
@@ -409,13 +421,6 @@ namespace MAQUETTE
           throw utxx::runtime_error(
               "DataManager::load_book() parsing error: ",
               fname);
-        else
-        {
-          d.quotes[0] = nullptr;
-          d.quotes[1] = nullptr;
-        }
-
-        m_data.push_back(d);
       }
     }
 
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "QuantSupport/BT/BackTest.h"
+#include "QuantSupport/BT/EventStore.h"
 
 #include "Basis/SecDefs.h"
 
@@ -24,89 +25,28 @@ namespace MAQUETTE
     class DataProvider
     {
       public:
-      struct data
-      {
-        utxx::time_val time;
-        uint16_t       id;   // index in secs
-        uint16_t       type; // 1 quotes, 2 trade sell, 3 trade buy
-        uint16_t       asks_size, bids_size;
-
-        union
-        {
-          quote* quotes[2];
-          quote  trade;
-        };
-
-        data()
-        {
-          memset(this, 0, sizeof(data));
-        }
-        data(const data& r)
-        {
-          memset(this, 0, sizeof(data));
-          *this = r;
-        }
-        void operator=(const data& r)
-        {
-          if (type == 1)
-          {
-            if (quotes[0])
-            {
-              delete[] quotes[0];
-              quotes[0] = nullptr;
-            }
-            if (quotes[1])
-            {
-              delete[] quotes[1];
-              quotes[1] = nullptr;
-            }
-          }
-          time      = r.time;
-          id        = r.id;
-          type      = r.type;
-          asks_size = r.asks_size;
-          bids_size = r.bids_size;
-          if (type == 1)
-          {
-            quotes[0] = new quote[asks_size];
-            quotes[1] = new quote[bids_size];
-            std::copy(r.quotes[0], r.quotes[0] + asks_size, quotes[0]);
-            std::copy(r.quotes[1], r.quotes[1] + bids_size, quotes[1]);
-          }
-          else
-          {
-            trade = r.trade;
-          }
-        }
-        ~data()
-        {
-          if (type == 1)
-          {
-            delete[] quotes[0];
-            delete[] quotes[1];
-          }
-        }
-
-        bool operator<(const data& r) const
-        {
-          if (time == r.time)
-            return r.type < type;
-          return time < r.time;
-        }
-      };
-
+      /**
+       * Event view returned by the iterators (see EventStore.h). It does not
+       * own the book quotes, so copying it never allocates
+       */
+      using data = event;
 
       /**
-       * Plugins iterator type (const)
+       * Plugins iterator type (const): a replay of the merge order of the
+       * per-instrument event streams, recorded once per window by Load, so
+       * the merged day is never built
        */
       class iterator
         : public boost::
               iterator_facade<iterator, data const, boost::forward_traversal_tag>
       {
         public:
-            explicit iterator(
-                const std::vector<data>::const_iterator& it) :
-              m_iterator(it)
+            iterator() = default;
+
+            iterator(
+                std::vector<EventStream> const& streams,
+                EventReplay::order_t const&     order) :
+              m_merge(streams, order)
             {
             }
 
@@ -115,21 +55,21 @@ namespace MAQUETTE
 
             data const& dereference() const
             {
-                return *m_iterator;
+                return m_merge.get();
             }
 
             void increment()
             {
-                ++m_iterator;
+                m_merge.next();
             }
 
             bool equal(iterator const& other) const
             {
-                return m_iterator == other.m_iterator;
+                return m_merge == other.m_merge;
             }
 
         private:
-            std::vector<data>::const_iterator m_iterator;
+            EventReplay m_merge;
 
       };
 
@@ -152,8 +92,9 @@ namespace MAQUETTE
 
       /**
        * Load data from cache files for @a from - @a to period
-       * @note After loading all trades and orders are mixed together and sorted
-       * by timestamp
+       * @note Trades and books of each ticker are loaded into their own event
+       * streams (reusing the memory of the previous period), which are then
+       * merged by timestamp once: the iterators replay that order
        */
       void Load(time_t from, time_t to);
 
@@ -175,20 +116,19 @@ namespace MAQUETTE
           std::string const& loadScript,
           const TimeRange&   period);
 
-      // Load data from file for single ticker
+      // Load data from file for single ticker into its book and trade streams
       void loadTicker(
           const std::string& ticker,
           uint32_t           mktDepth,
           time_t             from,
-          time_t             to);
+          time_t             to,
+          EventStream&       books,
+          EventStream&       trades);
 
       // Load trades from cache file
-      void loadTrades(uint16_t id, const std::string& fname);
+      void loadTrades(EventStream& stream, const std::string& fname);
       // Load order book from cache file
-      void loadOrderBook(
-          uint16_t           id,
-          uint32_t           mktDepth,
-          const std::string& fname);
+      void loadOrderBook(EventStream& stream, const std::string& fname);
 
       struct fvalue
       {
@@ -230,8 +170,11 @@ namespace MAQUETTE
       uint32_t m_marketDepth;
       // Map ticker name to instrument position
       std::map<std::string, uint16_t> m_ids;
-      // Data cache (trades and orders sorted by timestamp)
-      std::vector<data> m_data;
+      // Data cache: 2 streams (books, trades) per ticker, each sorted by
+      // timestamp
+      std::vector<EventStream> m_streams;
+      // Merge order of m_streams (see EventReplay)
+      EventReplay::order_t m_order;
       // Path to store intermediate data
       std::string m_cachePath;
       // For LOG_ macros
@@ -0,0 +1,443 @@
+// vim:ts=2:et
+//===========================================================================//
+//                    "QuantSupport/BT/EventStore.h":                        //
+//===========================================================================//
+
+#pragma once
+
+#include "QuantSupport/BT/BackTest.h"
+
+#include <utxx/error.hpp>
+#include <utxx/time_val.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace MAQUETTE
+{
+  namespace History
+  {
+    /**
+     * A single (non-owning) market data event, as seen by consumers.
+     * Book quotes point into the quote pool of the EventStream the event
+     * comes from, so they stay valid until that stream is cleared
+     */
+    struct event
+    {
+      utxx::time_val time;
+      uint16_t       id;   // index in secs
+      uint16_t       type; // 1 quotes, 2 trade sell, 3 trade buy
+      uint16_t       asks_size, bids_size;
+
+      union
+      {
+        quote const* quotes[2]; // asks, bids
+        quote        trade;
+      };
+
+      event()
+      {
+        memset(this, 0, sizeof(event));
+      }
+    };
+
+    /**
+     * Columnar, arena-backed store of the events of one instrument (books
+     * and/or trades). The times (which the merge reads) and the rest of the
+     * event headers are contiguous vectors, and all book levels live in a
+     * single flat quote pool addressed by offsets, so neither loading nor
+     * iterating allocates per event. clear() keeps the
+     * capacity, so a stream reused for consecutive windows stops allocating
+     * once it has grown to the largest window
+     */
+    class EventStream
+    {
+      public:
+      explicit EventStream(uint16_t id = 0) : m_id(id)
+      {
+      }
+
+      uint16_t id() const
+      {
+        return m_id;
+      }
+
+      size_t size() const
+      {
+        return m_time.size();
+      }
+
+      bool empty() const
+      {
+        return m_time.empty();
+      }
+
+      /**
+       * Drop all events (but keep the memory for reuse)
+       */
+      void clear(uint16_t id)
+      {
+        m_id = id;
+        m_time.clear();
+        m_hdr.clear();
+        m_quotes.clear();
+      }
+
+      /**
+       * Append a trade (is_buy selects type 3, otherwise 2)
+       */
+      void add_trade(utxx::time_val time, bool is_buy, quote const& q)
+      {
+        push_event(time, is_buy ? 3 : 2);
+        m_quotes.push_back(q);
+      }
+
+      /**
+       * Append a book snapshot: call begin_book(), then add_bid() for all bid
+       * levels, then add_ask() for all ask levels (the order in which the
+       * cache files store them)
+       */
+      void begin_book(utxx::time_val time)
+      {
+        push_event(time, 1);
+      }
+
+      void add_bid(quote const& q)
+      {
+        assert(!empty() && m_hdr.back().type == 1);
+        if (utxx::unlikely(m_hdr.back().asks_size != 0))
+          throw utxx::runtime_error("EventStream::add_bid() after add_ask()");
+        m_quotes.push_back(q);
+        ++m_hdr.back().bids_size;
+      }
+
+      void add_ask(quote const& q)
+      {
+        assert(!empty() && m_hdr.back().type == 1);
+        m_quotes.push_back(q);
+        ++m_hdr.back().asks_size;
+      }
+
+      /**
+       * Make sure the events are in time order. The cache files are already
+       * sorted, so normally this is a single pass; otherwise the columns are
+       * permuted (stably) in place of sorting whole events
+       */
+      void sort()
+      {
+        if (std::is_sorted(m_time.begin(), m_time.end()))
+          return;
+
+        std::vector<uint32_t> perm(size());
+        std::iota(perm.begin(), perm.end(), 0);
+        std::stable_sort(
+            perm.begin(),
+            perm.end(),
+            [this](uint32_t a, uint32_t b) { return m_time[a] < m_time[b]; });
+
+        permute(m_time, perm);
+        permute(m_hdr, perm);
+      }
+
+      utxx::time_val time(size_t i) const
+      {
+        return m_time[i];
+      }
+
+      uint16_t type(size_t i) const
+      {
+        return m_hdr[i].type;
+      }
+
+      /**
+       * Fill the event view for position @a i
+       */
+      void get(size_t i, event* ev) const
+      {
+        assert(i < size() && ev);
+        hdr const&   h = m_hdr[i];
+        quote const* q = m_quotes.data() + h.offset;
+        ev->time       = m_time[i];
+        ev->id         = m_id;
+        ev->type       = h.type;
+        ev->asks_size  = h.asks_size;
+        ev->bids_size  = h.bids_size;
+        if (ev->type == 1)
+        {
+          ev->quotes[0] = q + ev->bids_size;
+          ev->quotes[1] = q;
+        }
+        else
+          ev->trade = *q;
+      }
+
+      private:
+      void push_event(utxx::time_val time, uint16_t type)
+      {
+        if (utxx::unlikely(
+              m_quotes.size() >= std::numeric_limits<uint32_t>::max()))
+          throw utxx::runtime_error("EventStream: quote pool overflow");
+        m_time.push_back(time);
+        m_hdr.push_back(hdr{uint32_t(m_quotes.size()), type, 0, 0});
+      }
+
+      template<typename T>
+      static void permute(std::vector<T>& col, std::vector<uint32_t> const& p)
+      {
+        std::vector<T> tmp(col.size());
+        for (size_t i = 0; i != p.size(); ++i)
+          tmp[i] = col[p[i]];
+        col.swap(tmp);
+      }
+
+      // Event header: all but the time (a column of its own for the merge),
+      // so that get() reads one record per event
+      struct hdr
+      {
+        uint32_t offset; // into m_quotes
+        uint16_t type;
+        uint16_t asks_size;
+        uint16_t bids_size;
+      };
+
+      uint16_t                    m_id;
+      std::vector<utxx::time_val> m_time;
+      std::vector<hdr>            m_hdr;
+      std::vector<quote>          m_quotes;
+    };
+
+    /**
+     * Streaming k-way merge of several time-ordered EventStreams. Events come
+     * out ordered by time; at equal times trades go before books (as the
+     * previous sorted event vector did), then by stream index. Nothing is
+     * copied: the merge is a tournament (loser) tree over one cursor per
+     * stream, holding the cached sort key of each stream's current event, so
+     * every step is log2(k) branch-free comparisons which never touch the
+     * streams themselves
+     */
+    class EventMerge
+    {
+      public:
+      EventMerge() : m_streams(nullptr), m_k(0)
+      {
+      }
+
+      explicit EventMerge(std::vector<EventStream> const& streams) :
+        m_streams(&streams),
+        m_k(1)
+      {
+        while (m_k < streams.size())
+          m_k *= 2;
+        m_pos.assign(m_k, 0);
+        m_keys.resize(m_k);
+        m_tree.resize(m_k);
+        for (uint32_t s = 0; s != m_k; ++s)
+          set_key(s);
+
+        // Play the initial tournament bottom-up: "win" holds the winner of
+        // each sub-tree, the tree nodes keep the losers
+        std::vector<uint32_t> win(2 * m_k);
+        for (uint32_t s = 0; s != m_k; ++s)
+          win[m_k + s] = s;
+        for (uint32_t n = m_k - 1; n != 0; --n)
+        {
+          uint32_t l = win[2 * n], r = win[2 * n + 1];
+          bool     b = m_keys[r] < m_keys[l];
+          win[n]    = b ? r : l;
+          m_tree[n] = b ? l : r;
+        }
+        m_tree[0] = win[1];
+        load();
+      }
+
+      bool done() const
+      {
+        return m_k == 0 || m_keys[m_tree[0]] == Exhausted;
+      }
+
+      event const& get() const
+      {
+        assert(!done());
+        return m_cur;
+      }
+
+      void next()
+      {
+        assert(!done());
+        uint32_t w = m_tree[0];
+        ++m_pos[w];
+        set_key(w);
+        for (uint32_t n = (w + m_k) / 2; n != 0; n /= 2)
+        {
+          uint32_t l = m_tree[n];
+          bool     b = m_keys[l] < m_keys[w];
+          m_tree[n]  = b ? w : l;
+          w          = b ? l : w;
+        }
+        m_tree[0] = w;
+        load();
+      }
+
+      bool operator==(EventMerge const& r) const
+      {
+        return done() ? r.done()
+                      : (!r.done() && m_tree[0] == r.m_tree[0]
+                         && m_pos[m_tree[0]] == r.m_pos[r.m_tree[0]]);
+      }
+
+      /**
+       * Index of the stream of the current event
+       */
+      uint32_t stream() const
+      {
+        assert(!done());
+        return m_tree[0];
+      }
+
+      /**
+       * Row of the current event in its stream
+       */
+      size_t row() const
+      {
+        assert(!done());
+        return m_pos[m_tree[0]];
+      }
+
+      private:
+      // The sort key is (time in ns, (3 - type), stream) packed into 128 bits,
+      // so that keys compare with one integer comparison
+      using key_t = unsigned __int128;
+      static constexpr key_t Exhausted = ~key_t(0);
+
+      void set_key(uint32_t s)
+      {
+        if (s >= m_streams->size() || m_pos[s] == (*m_streams)[s].size())
+        {
+          m_keys[s] = Exhausted;
+          return;
+        }
+        EventStream const& es = (*m_streams)[s];
+        m_keys[s] = key_t(uint64_t(es.time(m_pos[s]).nanoseconds())) << 32
+                    | uint32_t(3 - es.type(m_pos[s])) << 16 | s;
+      }
+
+      void load()
+      {
+        if (!done())
+          (*m_streams)[m_tree[0]].get(m_pos[m_tree[0]], &m_cur);
+      }
+
+      std::vector<EventStream> const* m_streams;
+      uint32_t                        m_k;    // leaves (a power of 2)
+      std::vector<size_t>             m_pos;  // cursor per stream
+      std::vector<key_t>              m_keys; // of the cursors' events
+      std::vector<uint32_t>           m_tree; // losers; [0] is the winner
+      event                           m_cur;
+    };
+
+    /**
+     * Replay of a merge order recorded once (by "record") over the same
+     * EventStreams: every merged event is a packed (stream, row) u32, so
+     * every later pass (eg another strategy or parameter set over the same
+     * window) is a sequential scan of the order, with neither a tournament
+     * step nor any per-stream cursors
+     */
+    class EventReplay
+    {
+      public:
+      struct order_t
+      {
+        std::vector<uint32_t> recs;          // stream << row_bits | row
+        uint32_t              row_bits = 32;
+      };
+
+      EventReplay() : m_streams(nullptr), m_order(nullptr), m_i(0)
+      {
+      }
+
+      EventReplay(std::vector<EventStream> const& streams, order_t const& order)
+        : m_streams(&streams),
+          m_order(&order),
+          m_i(0)
+      {
+        load();
+      }
+
+      /**
+       * Merge @a streams once and store their merge order in @a order
+       * (re-using its memory). The stream index takes as few bits as the
+       * number of streams needs, the row all the others
+       */
+      static void record(
+          std::vector<EventStream> const& streams,
+          order_t*                        order)
+      {
+        assert(order);
+        uint32_t stream_bits = 0;
+        while ((size_t(1) << stream_bits) < streams.size())
+          ++stream_bits;
+        if (utxx::unlikely(stream_bits > 16))
+          throw utxx::runtime_error("EventReplay: too many streams");
+        order->row_bits = 32 - stream_bits;
+
+        size_t n = 0;
+        for (EventStream const& es: streams)
+        {
+          if (utxx::unlikely(es.size() > (uint64_t(1) << order->row_bits)))
+            throw utxx::runtime_error(
+                "EventReplay: too many events in a stream: ", es.size());
+          n += es.size();
+        }
+        order->recs.clear();
+        order->recs.reserve(n);
+        for (EventMerge m(streams); !m.done(); m.next())
+          order->recs.push_back(
+              uint32_t(uint64_t(m.stream()) << order->row_bits | m.row()));
+      }
+
+      bool done() const
+      {
+        return m_order == nullptr || m_i == m_order->recs.size();
+      }
+
+      event const& get() const
+      {
+        assert(!done());
+        return m_cur;
+      }
+
+      void next()
+      {
+        assert(!done());
+        ++m_i;
+        load();
+      }
+
+      bool operator==(EventReplay const& r) const
+      {
+        return done() ? r.done() : (!r.done() && m_i == r.m_i);
+      }
+
+      private:
+      void load()
+      {
+        if (!done())
+        {
+          uint64_t rec = m_order->recs[m_i];
+          uint64_t s   = rec >> m_order->row_bits;
+          (*m_streams)[s].get(
+              rec & ((uint64_t(1) << m_order->row_bits) - 1),
+              &m_cur);
+        }
+      }
+
+      std::vector<EventStream> const* m_streams;
+      order_t const*                  m_order;
+      size_t                          m_i; // position in the order
+      event                           m_cur;
+    };
+
+  } // namespace History
+} // namespace MAQUETTE
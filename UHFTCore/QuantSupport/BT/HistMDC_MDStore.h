@@ -16,7 +16,7 @@
 #include "QuantSupport/MDStore.hpp"
 
 using MAQUETTE::QuantSupport::MDRecL1;
-using MAQUETTE::QuantSupport::MDStoreReader;
+using MAQUETTE::QuantSupport::MDStoreMMapReader;
 
 namespace MAQUETTE
 {
@@ -110,7 +110,7 @@ namespace MAQUETTE
       {
         assert(m_strat != nullptr && m_book != nullptr);
 
-        using Reader = MDStoreReader<MDRecL1>;
+        using Reader = MDStoreMMapReader<MDRecL1>;
         Reader mds(m_md_store_root, m_venue, m_symbol, "ob_L1");
 
         // convert to quotes
@@ -108,9 +108,9 @@ namespace MAQUETTE
       const SecDefD& a_instr,
       utxx::time_val time,
       uint16_t asks_size,
-      History::quote* asks_quotes,
+      History::quote const* asks_quotes,
       uint16_t bids_size,
-      History::quote* bids_quotes)
+      History::quote const* bids_quotes)
   {
     if(utxx::unlikely(!asks_size && !bids_size))
       return;
@@ -189,7 +189,8 @@ namespace MAQUETTE
             false,
             0,
             0,
-            0);
+            0,
+            false);
         it = m_books
                  .insert(a_instr.m_SecID, std::unique_ptr<OrderBook>(orderBook))
                  .first;
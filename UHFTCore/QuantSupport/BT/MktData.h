@@ -62,9 +62,9 @@ namespace MAQUETTE
         const SecDefD& a_instr,
         utxx::time_val time,
         uint16_t asks_size,
-        History::quote* asks_quotes,
+        History::quote const* asks_quotes,
         uint16_t bids_size,
-        History::quote* bids_quotes) override;
+        History::quote const* bids_quotes) override;
 
     private:
       // Find order book or create new if none exists.
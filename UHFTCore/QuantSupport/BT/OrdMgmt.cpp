@@ -252,30 +252,11 @@ namespace MAQUETTE
         }
       }
 
-      char buf[1024];
-      char* c = buf;
-      c = stpncpy(c, stat.symbol.c_str(), stat.symbol.size());
-      *(c++) = ',';
-      c = stpncpy(c, name.c_str(), name.size());
-      c = stpcpy(c, ", delta:");
-      c += utxx::ftoa_left(stat.delta, c, 16, 8);
-      c = stpcpy(c, ", fee_maker:");
-      c += utxx::ftoa_left(stat.fee_maker, c, 16, 8);
-      c = stpcpy(c, ", fee_taker:");
-      c += utxx::ftoa_left(stat.fee_taker, c, 16, 8);
-      c = stpcpy(c, ", volume:");
-      c += utxx::ftoa_left(stat.volume, c, 16, 8);
-      c = stpcpy(c, ", min_pos:");
-      c += utxx::ftoa_left(stat.min_pos, c, 16, 8);
-      c = stpcpy(c, ", max_pos:");
-      c += utxx::ftoa_left(stat.max_pos, c, 16, 8);
-      c = stpcpy(c, ", new:");
-      c = utxx::itoa_left<uint32_t, 8>(c, stat.new_orders);
-      c = stpcpy(c, ", cancels:");
-      c = utxx::itoa_left<uint32_t, 8>(c, stat.cancels);
-      c = stpcpy(c, ", modifies:");
-      c = utxx::itoa_left<uint32_t, 8>(c, stat.modifies);
-      *(c++) = '\n';
+      if (History::ReportStatistics(name, stat))
+        continue;
+
+      char  buf[1024];
+      char* c = stat.print(buf, name);
       of.write(buf, c - buf);
     }
   }
@@ -389,8 +370,8 @@ namespace MAQUETTE
   }
 
   void Historical_OrdMgmt::SetBook(const SecDefD& a_instr, utxx::time_val time,
-      uint16_t asks_size, History::quote* asks_quotes,
-      uint16_t bids_size, History::quote* bids_quotes)
+      uint16_t asks_size, History::quote const* asks_quotes,
+      uint16_t bids_size, History::quote const* bids_quotes)
   {
     if(!asks_size || !bids_size)
       return;
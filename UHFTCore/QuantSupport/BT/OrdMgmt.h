@@ -97,22 +97,7 @@ namespace MAQUETTE
     AOS *m_aos_f, *m_aos_t, *m_aos_c;
     Req12 m_req[quotes_size];
 
-    struct Statistics
-    {
-      SecID       secID;
-      std::string symbol;
-
-      double   fee_maker  = 0;
-      double   fee_taker  = 0;
-      uint32_t new_orders = 0;
-      uint32_t cancels    = 0;
-      uint32_t modifies   = 0;
-      double   volume     = 0;
-      double   delta      = 0;
-      double   min_pos    = 0;
-      double   max_pos    = 0;
-      double   cur_pos    = 0;
-    };
+    using Statistics = History::Statistics;
 
     // To close positions correctly we are to have last price for each instrument
     std::unordered_map<SecID, double> m_lastPrices;
@@ -127,12 +112,12 @@ namespace MAQUETTE
     utxx::time_val last_time;
 
     void SetBook(
-        const SecDefD&  a_instr,
-        utxx::time_val  time,
-        uint16_t        asks_size,
-        History::quote* asks_quotes,
-        uint16_t        bids_size,
-        History::quote* bids_quotes) override;
+        const SecDefD&        a_instr,
+        utxx::time_val        time,
+        uint16_t              asks_size,
+        History::quote const* asks_quotes,
+        uint16_t              bids_size,
+        History::quote const* bids_quotes) override;
 
     int hdeals;
     std::string name, result;
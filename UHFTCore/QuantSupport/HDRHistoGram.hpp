@@ -0,0 +1,225 @@
+// vim:ts=2:et
+//===========================================================================//
+//                              "HDRHistoGram.hpp":                          //
+//       Log-Bucketed (HDR-Style) HistoGrams of Non-Negative Integer Vals    //
+//===========================================================================//
+#pragma once
+
+#include "Basis/BaseTypes.hpp"
+#include <utxx/compiler_hints.hpp>
+#include <atomic>
+#include <ostream>
+#include <iomanip>
+#include <string>
+#include <climits>
+#include <cstdint>
+#include <cassert>
+
+namespace MAQUETTE
+{
+namespace QuantSupport
+{
+  //=========================================================================//
+  // "HDRHistoGram" Class:                                                   //
+  //=========================================================================//
+  // Unlike "HistoGram" (with equal intervals over a fixed range), here each
+  // power-of-2 range [2^k, 2^(k+1)) is split into 2^(SubBits-1) equal inter-
+  // vals, so the relative precision is same (2^(1-SubBits), ie ~1.6% for the
+  // default SubBits=7) over the whole range [0 .. 2^MaxBits); larger vals go
+  // into the last interval (but "Max" is still exact). Typically the vals are
+  // latencies in nsec (the default range is then ~1 sec):
+  // (*) "Update" is meant to be invoked from 1 thread only; it is lock-free
+  //     and the Counters are atomic (with relaxed memory order), so the Hist-
+  //     oGram can be placed in ShM and read "live" by another process  (even
+  //     if mapped RO), with no effect on the writer;
+  // (*) the readers should use "GetSummary", which makes 1 pass over all the
+  //     Counters (so the results are consistent up to the concurrent Updates):
+  //
+  template<unsigned SubBits = 7, unsigned MaxBits = 30>
+  struct HDRHistoGram
+  {
+  public:
+    //-----------------------------------------------------------------------//
+    // Consts:                                                               //
+    //-----------------------------------------------------------------------//
+    static_assert(2 <= SubBits && SubBits < MaxBits && MaxBits <= 62,
+                  "HDRHistoGram: Invalid SubBits/MaxBits");
+
+    constexpr static unsigned Half     = 1U << (SubBits - 1);
+    constexpr static unsigned NBuckets = (MaxBits - SubBits + 2) * Half;
+    constexpr static long     MaxVal   = (1L << MaxBits) - 1;
+
+    //-----------------------------------------------------------------------//
+    // "Summary": A Snapshot of the Main Stats:                              //
+    //-----------------------------------------------------------------------//
+    struct Summary
+    {
+      long    m_count = 0;
+      long    m_min   = 0;
+      long    m_p50   = 0;
+      long    m_p90   = 0;
+      long    m_p99   = 0;
+      long    m_p999  = 0;
+      long    m_max   = 0;
+      double  m_avg   = 0.0;
+    };
+
+    //-----------------------------------------------------------------------//
+    // Data Flds:                                                            //
+    //-----------------------------------------------------------------------//
+    ObjName const                        m_name;
+    mutable std::atomic<uint64_t>        m_hist[NBuckets];  // Counters
+    mutable std::atomic<long>            m_min;
+    mutable std::atomic<long>            m_max;
+    mutable std::atomic<long>            m_sum;
+
+    //-----------------------------------------------------------------------//
+    // Ctors:                                                                //
+    //-----------------------------------------------------------------------//
+    HDRHistoGram()
+    : HDRHistoGram(std::string())
+    {}
+
+    explicit HDRHistoGram(std::string const& a_name)
+    : m_name(MkObjName(a_name)),
+      m_hist(),
+      m_min (LONG_MAX),
+      m_max (0),
+      m_sum (0)
+    { Reset(); }
+
+    // Contains atomics, so no copying:
+    HDRHistoGram(HDRHistoGram const&)            = delete;
+    HDRHistoGram& operator=(HDRHistoGram const&) = delete;
+
+    //-----------------------------------------------------------------------//
+    // "Reset":                                                              //
+    //-----------------------------------------------------------------------//
+    // NB: Not atomic as a whole, so should only be invoked by the writer:
+    //
+    void Reset() const
+    {
+      for (unsigned i = 0; i < NBuckets; ++i)
+        m_hist[i].store(0, std::memory_order_relaxed);
+      m_min.store(LONG_MAX, std::memory_order_relaxed);
+      m_max.store(0,        std::memory_order_relaxed);
+      m_sum.store(0,        std::memory_order_relaxed);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "BucketOf", "BucketTop":                                              //
+    //-----------------------------------------------------------------------//
+    // The Bucket (interval) index of "a_val":
+    //
+    constexpr static unsigned BucketOf(long a_val)
+    {
+      assert(a_val >= 0);
+      uint64_t v     = uint64_t(std::min<long>(a_val, MaxVal));
+      int      msb   = (v == 0) ? 0 : (63 - __builtin_clzl(v));
+      int      shift = std::max<int>(msb - int(SubBits) + 1, 0);
+      unsigned res   = unsigned(shift) * Half + unsigned(v >> shift);
+      assert(res < NBuckets);
+      return res;
+    }
+
+    // The largest val which falls into the given Bucket:
+    //
+    constexpr static long BucketTop(unsigned a_idx)
+    {
+      assert(a_idx < NBuckets);
+      int      shift = std::max<int>(int(a_idx / Half) - 1, 0);
+      uint64_t sub   = a_idx - unsigned(shift) * Half;
+      return long(((sub + 1) << shift) - 1);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Update":                                                             //
+    //-----------------------------------------------------------------------//
+    // Negative vals are not allowed, and should be filtered out by the Caller:
+    //
+    void Update(long a_val) const
+    {
+      assert(a_val >= 0);
+      std::atomic<uint64_t>& cnt = m_hist[BucketOf(a_val)];
+
+      // Single writer, so no atomic RMW (locked instrs) are required:
+      cnt.store(cnt.load(std::memory_order_relaxed) + 1,
+                std::memory_order_relaxed);
+
+      if (utxx::unlikely(a_val < m_min.load(std::memory_order_relaxed)))
+        m_min.store(a_val, std::memory_order_relaxed);
+      if (utxx::unlikely(a_val > m_max.load(std::memory_order_relaxed)))
+        m_max.store(a_val, std::memory_order_relaxed);
+      m_sum.store(m_sum.load(std::memory_order_relaxed) + a_val,
+                  std::memory_order_relaxed);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "GetSummary":                                                         //
+    //-----------------------------------------------------------------------//
+    // The percentiles are the upper bounds of the corresp Buckets (capped by
+    // the exact "Max"):
+    //
+    Summary GetSummary() const
+    {
+      // Take a snapshot of the Counters (and the total count):
+      uint64_t counts[NBuckets];
+      uint64_t n = 0;
+      for (unsigned i = 0; i < NBuckets; ++i)
+      {
+        counts[i] = m_hist[i].load(std::memory_order_relaxed);
+        n        += counts[i];
+      }
+      Summary res;
+      if (n == 0)
+        return res;
+
+      res.m_count = long(n);
+      res.m_min   = m_min.load(std::memory_order_relaxed);
+      res.m_max   = m_max.load(std::memory_order_relaxed);
+      res.m_avg   =
+        double(m_sum.load(std::memory_order_relaxed)) / double(n);
+
+      // The ranks (1-based) of the percentiles, and where to put them:
+      constexpr int NP = 4;
+      double const  ps  [NP] { 0.5, 0.9, 0.99, 0.999 };
+      long*   const outs[NP] { &res.m_p50, &res.m_p90, &res.m_p99,
+                               &res.m_p999 };
+      uint64_t cum = 0;
+      int      j   = 0;
+      for (unsigned i = 0; i < NBuckets && j < NP; ++i)
+      {
+        cum += counts[i];
+        while (j < NP && double(cum) >= ps[j] * double(n))
+        {
+          *outs[j] = std::min<long>(BucketTop(i), res.m_max);
+          ++j;
+        }
+      }
+      return res;
+    }
+
+    //-----------------------------------------------------------------------//
+    // Output:                                                               //
+    //-----------------------------------------------------------------------//
+    // A single line: Name, Count, Min, Avg, Percentiles and Max:
+    //
+    friend inline std::ostream& operator<<
+    (
+      std::ostream&       a_os,
+      HDRHistoGram const& a_hist
+    )
+    {
+      Summary s = a_hist.GetSummary();
+      return
+        a_os << std::left  << std::setw(24) << a_hist.m_name.data()
+             << std::right << std::setw(11) << s.m_count
+             << std::setw(9)  << s.m_min
+             << std::setw(9)  << long(s.m_avg)
+             << std::setw(9)  << s.m_p50  << std::setw(9) << s.m_p90
+             << std::setw(9)  << s.m_p99  << std::setw(9) << s.m_p999
+             << std::setw(11) << s.m_max;
+    }
+  };
+} // End namespace QuantSupport
+} // End namespace MAQUETTE
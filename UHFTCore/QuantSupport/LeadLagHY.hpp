@@ -0,0 +1,328 @@
+// vim:ts=2:et
+//===========================================================================//
+//                        "QuantSupport/LeadLagHY.hpp":                      //
+//    Streaming Hayashi-Yoshida Cross-Correlations of 2 Instrs, All Lags     //
+//===========================================================================//
+// Estimates the lead-lag between 2 Instruments (eg a Future and the under-
+// lying Spot) live, from their asynchronous Px updates, using the same esti-
+// mator as "QuantAnalytics/MOEX-Lead-Lag/HY.hpp", but incrementally and for
+// all lags at once:
+// (*) time is discretised on a grid (1 msec by default); lags are in grid
+//     steps, within [-MaxLag .. MaxLag]; a lag l > 0 means that Instr 0 leads
+//     Instr 1 by "l";
+// (*) a Px interval [a, b) of Instr 0 and an interval [c, d) of Instr 1 con-
+//     tribute the product of their returns to all lags for which [a+l, b+l)
+//     overlaps [c, d), ie to c-b < l < d-a; each pair is accounted for once
+//     (when the later of the 2 intervals is complete),  in a difference array
+//     over the lags, so the cost of an update is proportional to the number
+//     of overlapping intervals of the other Instr, not to the number of lags;
+// (*) an interval is complete when a Px change of the same Instr at a later
+//     grid time is seen (unchanged Pxs are ignored, and Pxs at the same grid
+//     time over-write each other), ie after the next update of either Instr
+//     at a later grid time;
+// (*) returns are not de-trended (the drift is negligible at these time
+//     scales), so the results are slightly different from the off-line ones;
+// (*) only the intervals which may still overlap with the future ones are
+//     kept, in ring buffers of a fixed capacity  (so there are no allocations
+//     after construction; if a buffer is full, the oldest interval is lost);
+// (*) not thread-safe: "Update" and the queries are to be invoked from the
+//     same (eg Strategy) thread:
+//
+#pragma once
+
+#include "Basis/Maths.hpp"
+#include "Connectors/OrderBook.h"
+#include <utxx/error.hpp>
+#include <utxx/time_val.hpp>
+#include <utxx/compiler_hints.hpp>
+#include <vector>
+#include <climits>
+#include <cassert>
+
+namespace MAQUETTE
+{
+namespace QuantSupport
+{
+  //=========================================================================//
+  // "LeadLagHY" Class:                                                      //
+  //=========================================================================//
+  class LeadLagHY
+  {
+  private:
+    //-----------------------------------------------------------------------//
+    // Types:                                                                //
+    //-----------------------------------------------------------------------//
+    // A complete Px interval [m_from, m_to) (in grid units) and the return
+    // over it:
+    struct IntervalT
+    {
+      long    m_from;
+      long    m_to;
+      double  m_ret;
+    };
+
+    // Per-Instr state: the ring buffer of complete intervals (the oldest one
+    // is at "m_head"), the beginning of the current interval, and the Px not
+    // yet final (as more Pxs at the same grid time may come):
+    struct InstrT
+    {
+      std::vector<IntervalT>  m_ints;
+      unsigned                m_head  = 0;
+      unsigned                m_size  = 0;
+      long                    m_fromT = NoTime;
+      double                  m_fromPx= 0.0;
+      long                    m_pendT = NoTime;
+      double                  m_pendPx= 0.0;
+      double                  m_var   = 0.0;   // Sum of squared returns
+      long                    m_nInts = 0;     // Total number of intervals
+
+      IntervalT const& FromNewest(unsigned a_k) const
+      {
+        assert(a_k < m_size);
+        return m_ints[(m_head + m_size - 1 - a_k) & (m_ints.size() - 1)];
+      }
+    };
+
+    constexpr static long NoTime = LONG_MIN;
+
+    //-----------------------------------------------------------------------//
+    // Data Flds:                                                            //
+    //-----------------------------------------------------------------------//
+    int     const       m_maxLag;
+    long    const       m_stepNS;   // Grid step, in nsec
+    utxx::time_val      m_origin;   // Grid time 0
+    InstrT              m_instrs[2];
+    std::vector<double> m_diff;     // Cross-covs for all lags, differenced
+
+  public:
+    //-----------------------------------------------------------------------//
+    // Non-Default Ctor:                                                     //
+    //-----------------------------------------------------------------------//
+    // "a_max_ints" is the capacity (rounded up to a power of 2) of the buffer
+    // of intervals of each Instr; it must exceed the number of Px changes of
+    // an Instr over (MaxLag + the longest interval of the other Instr):
+    //
+    LeadLagHY
+    (
+      int   a_max_lag,
+      long  a_step_ns  = 1'000'000,
+      int   a_max_ints = 4096
+    )
+    : m_maxLag(a_max_lag),
+      m_stepNS(a_step_ns),
+      m_origin(),
+      m_instrs(),
+      m_diff  (size_t(std::max<int>(2 * a_max_lag + 2, 0)), 0.0)
+    {
+      if (utxx::unlikely(a_max_lag < 0 || a_step_ns <= 0 || a_max_ints <= 0))
+        throw utxx::badarg_error("LeadLagHY::Ctor: Invalid arg(s)");
+
+      size_t cap = 1;
+      while (cap < size_t(a_max_ints))
+        cap *= 2;
+      for (InstrT& instr: m_instrs)
+        instr.m_ints.resize(cap);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Reset": Discard all accumulated data:                                //
+    //-----------------------------------------------------------------------//
+    void Reset()
+    {
+      m_origin = utxx::time_val();
+      for (InstrT& instr: m_instrs)
+      {
+        std::vector<IntervalT> ints(std::move(instr.m_ints));
+        instr        = InstrT();
+        instr.m_ints = std::move(ints);
+      }
+      std::fill(m_diff.begin(), m_diff.end(), 0.0);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Update": A new Px of Instr "a_i" (0 or 1):                           //
+    //-----------------------------------------------------------------------//
+    // (1) Given explicitly:
+    //
+    void Update(int a_i, utxx::time_val a_ts, double a_px)
+    {
+      assert(a_i == 0 || a_i == 1);
+      if (utxx::unlikely(!IsFinite(a_px) || a_ts.empty()))
+        return;
+
+      if (utxx::unlikely(m_origin.empty()))
+        m_origin = a_ts;
+      long t = (a_ts - m_origin).nanoseconds() / m_stepNS;
+
+      // All pending Pxs at earlier grid times are now final:
+      Flush(0, t);
+      Flush(1, t);
+
+      InstrT& instr = m_instrs[a_i];
+      if (instr.m_pendT != NoTime)
+        // Same grid time (or out-of-order): Over-write the pending Px:
+        instr.m_pendPx = a_px;
+      else
+      if (instr.m_fromT == NoTime || (t > instr.m_fromT &&
+                                      a_px != instr.m_fromPx))
+      {
+        instr.m_pendT  = t;
+        instr.m_pendPx = a_px;
+      }
+      // Otherwise, the Px is unchanged or stale, so nothing to do
+    }
+
+    // (2) From an "OrderBook" (the Mid-Px is used):
+    //
+    void Update(int a_i, OrderBook const& a_ob, utxx::time_val a_ts)
+    {
+      PriceT px = ArithmMidPx(a_ob.GetBestBidPx(), a_ob.GetBestAskPx());
+      if (utxx::likely(IsFinite(px)))
+        Update(a_i, a_ts, double(px));
+    }
+
+    //-----------------------------------------------------------------------//
+    // Accessors and Queries:                                                //
+    //-----------------------------------------------------------------------//
+    int  GetMaxLag() const { return m_maxLag; }
+
+    long GetNInts (int a_i) const
+    {
+      assert(a_i == 0 || a_i == 1);
+      return m_instrs[a_i].m_nInts;
+    }
+
+    // The Cross-Correlations for all lags: "a_res" must be of size
+    // (2 * MaxLag + 1), indexed by (l + MaxLag); all NaN if there is no data
+    // yet:
+    //
+    void GetCrossCorrs(double* a_res) const
+    {
+      assert(a_res != nullptr);
+      double norm  = SqRt(m_instrs[0].m_var * m_instrs[1].m_var);
+      double cross = 0.0;
+      for (int j = 0; j <= 2 * m_maxLag; ++j)
+      {
+        cross   += m_diff[size_t(j)];
+        a_res[j] = (norm > 0.0) ? (cross / norm) : NaN<double>;
+      }
+    }
+
+    // The Lead-Lag estimate: the lag with the largest absolute Cross-Corr
+    // (returned via "a_corr" if non-NULL), or 0 (and NaN) if no data yet:
+    //
+    int GetLeadLag(double* a_corr = nullptr) const
+    {
+      double cross = 0.0;
+      double best  = 0.0;
+      int    res   = 0;
+      for (int j = 0; j <= 2 * m_maxLag; ++j)
+      {
+        cross += m_diff[size_t(j)];
+        if (Abs(cross) > Abs(best))
+        {
+          best = cross;
+          res  = j - m_maxLag;
+        }
+      }
+      if (a_corr != nullptr)
+      {
+        double norm = SqRt(m_instrs[0].m_var * m_instrs[1].m_var);
+        *a_corr     = (norm > 0.0) ? (best / norm) : NaN<double>;
+      }
+      return res;
+    }
+
+  private:
+    //-----------------------------------------------------------------------//
+    // "Flush": Make the pending Px of Instr "a_i" final if "a_t" is later:  //
+    //-----------------------------------------------------------------------//
+    void Flush(int a_i, long a_t)
+    {
+      InstrT& instr = m_instrs[a_i];
+      if (instr.m_pendT == NoTime || instr.m_pendT >= a_t)
+        return;
+
+      if (instr.m_fromT != NoTime && instr.m_pendPx != instr.m_fromPx)
+        Complete(a_i, { instr.m_fromT, instr.m_pendT,
+                        instr.m_pendPx - instr.m_fromPx });
+
+      if (instr.m_fromT == NoTime || instr.m_pendPx != instr.m_fromPx)
+      {
+        instr.m_fromT  = instr.m_pendT;
+        instr.m_fromPx = instr.m_pendPx;
+      }
+      instr.m_pendT = NoTime;
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Complete": Account for a new complete interval of Instr "a_i":       //
+    //-----------------------------------------------------------------------//
+    void Complete(int a_i, IntervalT const& a_int)
+    {
+      InstrT&       instr = m_instrs[a_i];
+      InstrT const& other = m_instrs[1 - a_i];
+
+      instr.m_var += a_int.m_ret * a_int.m_ret;
+      ++instr.m_nInts;
+
+      // Go over the intervals of the other Instr, from the newest one, while
+      // they can still overlap with this one for some lag:
+      for (unsigned k = 0; k < other.m_size; ++k)
+      {
+        IntervalT const& oth = other.FromNewest(k);
+        IntervalT const& x   = (a_i == 0) ? a_int : oth; // Of Instr 0
+        IntervalT const& y   = (a_i == 0) ? oth   : a_int; // Of Instr 1
+
+        int lo = int(std::max<long>(y.m_from - x.m_to   + 1, -m_maxLag));
+        int hi = int(std::min<long>(y.m_to   - x.m_from - 1,  m_maxLag));
+
+        if (lo <= hi)
+        {
+          double prod = x.m_ret * y.m_ret;
+          m_diff[size_t(lo + m_maxLag)]     += prod;
+          m_diff[size_t(hi + m_maxLag + 1)] -= prod;
+        }
+        else
+        // Older intervals of the other Instr would be even further apart:
+        if ((a_i == 0) ? (hi < -m_maxLag) : (lo > m_maxLag))
+          break;
+      }
+
+      // Store this interval (over-writing the oldest one if full):
+      unsigned mask = unsigned(instr.m_ints.size()) - 1;
+      instr.m_ints[(instr.m_head + instr.m_size) & mask] = a_int;
+      if (utxx::likely(instr.m_size <= mask))
+        ++instr.m_size;
+      else
+        instr.m_head = (instr.m_head + 1) & mask;
+
+      // Drop the intervals of both Instrs which cannot overlap with any future
+      // intervals of the other one (those begin at or after its "m_fromT"):
+      Prune(0);
+      Prune(1);
+    }
+
+    //-----------------------------------------------------------------------//
+    // "Prune":                                                              //
+    //-----------------------------------------------------------------------//
+    void Prune(int a_i)
+    {
+      InstrT&       instr = m_instrs[a_i];
+      InstrT const& other = m_instrs[1 - a_i];
+      long nextFrom =
+        (other.m_fromT != NoTime) ? other.m_fromT : other.m_pendT;
+      if (nextFrom == NoTime)
+        return;
+
+      unsigned mask = unsigned(instr.m_ints.size()) - 1;
+      while (instr.m_size > 0 &&
+             instr.m_ints[instr.m_head].m_to <= nextFrom - m_maxLag)
+      {
+        instr.m_head = (instr.m_head + 1) & mask;
+        --instr.m_size;
+      }
+    }
+  };
+} // End namespace QuantSupport
+} // End namespace MAQUETTE
@@ -983,11 +983,11 @@ namespace QuantSupport
             // Order Deletion: in Steady Mode only:                          //
             //---------------------------------------------------------------//
             // Get the OrderInfo and Qty BEFORE the update:
-            oi    = m_ob1->GetOrderInfo(orderID);
+            oi    = m_ob1->FindOrderInfo(orderID);
             oiQty = utxx::likely(oi != nullptr)
                     ? double(oi->GetQty<QT,QR>()) : 0.0;
             oiPx  = utxx::likely(oi != nullptr) ? double(oi->m_px) : 0.0;
-            oiBid = oi->m_isBid;
+            oiBid = utxx::likely(oi != nullptr) && oi->m_isBid;
 
             m_dynInitMode = false;
 
@@ -1009,11 +1009,11 @@ namespace QuantSupport
             // Order Modification: in Steady Mode only:                      //
             //---------------------------------------------------------------//
             // Get the OrderInfo and Qty BEFORE the update:
-            oi    = m_ob1->GetOrderInfo(orderID);
+            oi    = m_ob1->FindOrderInfo(orderID);
             oiQty = utxx::likely(oi != nullptr)
                     ? double(oi->GetQty<QT,QR>()) : 0.0;
             oiPx  = utxx::likely(oi != nullptr)   ? double(oi->m_px) : 0.0;
-            oiBid = oi->m_isBid;
+            oiBid = utxx::likely(oi != nullptr) && oi->m_isBid;
 
             m_dynInitMode = false;
 
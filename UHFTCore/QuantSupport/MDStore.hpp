@@ -28,6 +28,12 @@
 #include <functional>
 #include <ios>
 #include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <utxx/compiler_hints.hpp>
 #include <utxx/error.hpp>
@@ -171,16 +177,20 @@ protected:
     a_fstm->seekg(0);
     a_fstm->read(reinterpret_cast<char *>(&header), sizeof(MDStoreFileHeader));
 
-    if (std::string(header.venue) != m_venue)
+    CheckHeader(header, a_path);
+    return header;
+  }
+
+  void CheckHeader(const MDStoreFileHeader &a_header,
+                   std::filesystem::path const &a_path) const {
+    if (std::string(a_header.venue) != m_venue)
       throw utxx::runtime_error("Unexpected Venue in " + a_path.string());
 
-    if (std::string(header.symbol) != m_symbol)
+    if (std::string(a_header.symbol) != m_symbol)
       throw utxx::runtime_error("Unexpected Symbol in " + a_path.string());
 
-    if (header.record_size != RecSize)
+    if (a_header.record_size != RecSize)
       throw utxx::runtime_error("Unexpected record size in " + a_path.string());
-
-    return header;
   }
 
   utxx::time_val GetLastRecordTime(std::fstream *a_fstm,
@@ -411,5 +421,350 @@ private:
   std::vector<MDStoreRecord> m_recs;
 };
 
+// MDStoreMMapReader reads the same files as MDStoreReader, but maps them into
+// memory instead of copying them, and hands the records to the callback in
+// place. It can seek either by ts_recv (the files are written in ts_recv order,
+// so this is a binary search on the mapped records), or by ts_exch, which is
+// not monotonic within a file. For the latter, every file has a sparse index
+// holding the running maximum of ts_exch at the end of each block of
+// IndexStride records: the first record with ts_exch >= t is then in the first
+// block whose running maximum is >= t, which is found by binary search too.
+//
+// The index is persisted next to its file as ".<file name>.idx" (hidden, so it
+// is never taken for a data file), and is rebuilt whenever the size of the
+// data file has changed (e.g. the current hour is still being written). While
+// reading, the next file is mapped and prefetched with madvise(MADV_WILLNEED)
+// as soon as the current one is entered.
+template <typename REC> class MDStoreMMapReader : public MDStoreBase<REC> {
+public:
+  using typename MDStoreBase<REC>::MDStoreRecord;
+  using MDStoreBase<REC>::RecSize;
+
+  // Same as in MDStoreReader. Read() also accepts any other callable with
+  // this signature, which avoids the std::function call per record
+  using CallbackT = std::function<bool(const MDStoreRecord &)>;
+
+  // number of records per index entry
+  static constexpr size_t IndexStride = 256;
+
+  // position of a record: index of its file (in m_all_files order) and of the
+  // record in that file. End() is past the last record of the last file
+  struct Pos {
+    size_t file;
+    size_t rec;
+
+    bool operator==(const Pos &a_rhs) const {
+      return file == a_rhs.file && rec == a_rhs.rec;
+    }
+    bool operator!=(const Pos &a_rhs) const { return !(*this == a_rhs); }
+  };
+
+  MDStoreMMapReader(const std::string &a_root_path, const std::string &a_venue,
+                    const std::string &a_symbol, const std::string &a_prefix,
+                    bool a_persist_index = true, bool a_prefetch = true)
+      : MDStoreBase<REC>(a_root_path, a_venue, a_symbol, a_prefix, false),
+        m_files(this->m_all_files.size()), m_persist_index(a_persist_index),
+        m_prefetch(a_prefetch) {}
+
+  ~MDStoreMMapReader() override {
+    for (auto &file : m_files)
+      Unmap(&file);
+  }
+
+  MDStoreMMapReader(const MDStoreMMapReader &) = delete;
+  MDStoreMMapReader &operator=(const MDStoreMMapReader &) = delete;
+
+  size_t NumFiles() const { return m_files.size(); }
+
+  Pos End() const { return Pos{m_files.size(), 0}; }
+
+  // The records of a file, in place. They stay valid until Read() has moved
+  // past that file (or the reader is destroyed)
+  std::pair<const MDStoreRecord *, const MDStoreRecord *>
+  Records(size_t a_file) {
+    auto &file = Map(a_file);
+    return {file.recs, file.recs + file.num_recs};
+  }
+
+  const MDStoreRecord &operator[](Pos a_pos) {
+    auto &file = Map(a_pos.file);
+    assert(a_pos.rec < file.num_recs);
+    return file.recs[a_pos.rec];
+  }
+
+  // first record with ts_recv >= a_time
+  Pos SeekRecv(utxx::time_val a_time) {
+    for (size_t i = FirstFile(a_time); i < m_files.size(); ++i) {
+      auto &file = Map(i);
+      auto end = file.recs + file.num_recs;
+      auto rec = std::lower_bound(file.recs, end, a_time,
+                                  [](const MDStoreRecord &r, utxx::time_val t) {
+                                    return r.ts_recv < t;
+                                  });
+      if (rec != end)
+        return Pos{i, size_t(rec - file.recs)};
+    }
+    return End();
+  }
+
+  // First record (in file order) with ts_exch >= a_time. Records are filed by
+  // ts_recv, which normally lags ts_exch, so the search starts at the file of
+  // a_time's hour; it steps back over earlier files only while they still hold
+  // a ts_exch >= a_time (clock skew), i.e. ts_exch may run ahead of ts_recv by
+  // up to an hour
+  Pos SeekExch(utxx::time_val a_time) {
+    size_t i = FirstFile(a_time);
+    while (i > 0 && MaxExch(i - 1) >= a_time)
+      --i;
+
+    for (; i < m_files.size(); ++i) {
+      auto const &index = Index(i);
+      auto blk = std::lower_bound(index.begin(), index.end(), a_time);
+      if (blk == index.end())
+        continue;
+
+      // the running maximum reaches a_time in this block, so the scan below
+      // stops within it
+      auto &file = Map(i);
+      size_t rec = size_t(blk - index.begin()) * IndexStride;
+      while (file.recs[rec].ts_exch < a_time)
+        ++rec;
+      return Pos{i, rec};
+    }
+    return End();
+  }
+
+  // Same as MDStoreReader::Read(): from the first record with
+  // ts_recv >= a_starting_time, until the callback returns false
+  template <typename F>
+  void Read(utxx::time_val a_starting_time, F &&a_callback) {
+    ReadFrom(SeekRecv(a_starting_time), a_callback);
+  }
+
+  // From the first record with ts_exch >= a_starting_time on. NB: the records
+  // still come in file (ts_recv) order, so a few of the following ones may
+  // have a ts_exch < a_starting_time
+  template <typename F>
+  void ReadExch(utxx::time_val a_starting_time, F &&a_callback) {
+    ReadFrom(SeekExch(a_starting_time), a_callback);
+  }
+
+  template <typename F> void ReadFrom(Pos a_pos, F &&a_callback) {
+    for (size_t i = a_pos.file; i < m_files.size(); ++i) {
+      auto &file = Map(i);
+      if (m_prefetch && i + 1 < m_files.size())
+        Advise(&Map(i + 1), 0, MADV_WILLNEED);
+
+      size_t from = (i == a_pos.file) ? a_pos.rec : 0;
+      Advise(&file, from, MADV_SEQUENTIAL);
+      for (size_t r = from; r < file.num_recs; ++r)
+        if (!a_callback(file.recs[r]))
+          return;
+
+      // done with this file, keep only its index
+      Unmap(&file);
+    }
+  }
+
+private:
+  using typename MDStoreBase<REC>::MDStoreFileHeader;
+
+  static_assert(sizeof(MDStoreFileHeader) % alignof(MDStoreRecord) == 0,
+                "mapped records would be misaligned");
+
+  struct MappedFile {
+    void *base = nullptr; // of the mapping, nullptr if not mapped
+    size_t size = 0;      // of the mapping (the whole file)
+    const MDStoreRecord *recs = nullptr;
+    size_t num_recs = 0;
+
+    // running maximum of ts_exch at the end of each block of IndexStride
+    // records, valid for a file of index_size bytes
+    std::vector<utxx::time_val> index;
+    size_t index_size = 0;
+    bool indexed = false;
+  };
+
+  // layout of the persisted index: this header, then the index entries
+  struct IndexFileHeader {
+    uint64_t magic;
+    uint32_t record_size;
+    uint32_t stride;
+    uint64_t data_size; // of the data file the index was built for
+    uint64_t num_entries;
+  };
+  static constexpr uint64_t IndexMagic = 0x3158444953444d2eULL; // ".MDSIDX1"
+
+  std::vector<MappedFile> m_files; // same order as m_all_files
+  bool m_persist_index;
+  bool m_prefetch;
+
+  // the file holding a_time (by ts_recv), or the next one
+  size_t FirstFile(utxx::time_val a_time) {
+    auto target_file = this->MakePath(a_time);
+    return size_t(std::lower_bound(this->m_all_files.begin(),
+                                   this->m_all_files.end(), target_file) -
+                  this->m_all_files.begin());
+  }
+
+  MappedFile &Map(size_t a_file) {
+    auto &file = m_files[a_file];
+    if (utxx::likely(file.base != nullptr))
+      return file;
+
+    auto const &path = this->m_all_files[a_file];
+    int fd = open(path.c_str(), O_RDONLY);
+    if (utxx::unlikely(fd < 0))
+      throw utxx::runtime_error("Could not open " + path.string());
+
+    struct stat st;
+    if (utxx::unlikely(fstat(fd, &st) != 0 ||
+                       size_t(st.st_size) < sizeof(MDStoreFileHeader))) {
+      close(fd);
+      throw utxx::runtime_error("File " + path.string() + " has no header");
+    }
+
+    void *base =
+        mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (utxx::unlikely(base == MAP_FAILED))
+      throw utxx::runtime_error("Could not map " + path.string());
+
+    file.base = base;
+    file.size = size_t(st.st_size);
+    this->CheckHeader(*static_cast<const MDStoreFileHeader *>(base), path);
+
+    file.recs = reinterpret_cast<const MDStoreRecord *>(
+        static_cast<const char *>(base) + sizeof(MDStoreFileHeader));
+    file.num_recs = (file.size - sizeof(MDStoreFileHeader)) / RecSize;
+    return file;
+  }
+
+  void Unmap(MappedFile *a_file) {
+    if (a_file->base != nullptr)
+      munmap(a_file->base, a_file->size);
+    a_file->base = nullptr;
+    a_file->size = 0;
+    a_file->recs = nullptr;
+    a_file->num_recs = 0;
+  }
+
+  // madvise() from record a_from to the end of the file
+  void Advise(MappedFile *a_file, size_t a_from, int a_advice) {
+    static const size_t s_page = size_t(sysconf(_SC_PAGESIZE));
+    size_t offset = sizeof(MDStoreFileHeader) + a_from * RecSize;
+    offset -= offset % s_page;
+    if (offset < a_file->size)
+      madvise(static_cast<char *>(a_file->base) + offset,
+              a_file->size - offset, a_advice);
+  }
+
+  const std::vector<utxx::time_val> &Index(size_t a_file) {
+    auto &file = m_files[a_file];
+    auto const &path = this->m_all_files[a_file];
+    size_t size = size_t(std::filesystem::file_size(path));
+    if (file.indexed && file.index_size == size)
+      return file.index;
+
+    // the file has changed since it was mapped, so re-map it
+    if (file.base != nullptr && file.size != size)
+      Unmap(&file);
+
+    if (!LoadIndex(a_file, size)) {
+      BuildIndex(a_file);
+      if (m_persist_index)
+        SaveIndex(a_file);
+    }
+    return file.index;
+  }
+
+  // the largest ts_exch in a file (0 if it has no records)
+  utxx::time_val MaxExch(size_t a_file) {
+    auto const &index = Index(a_file);
+    return index.empty() ? utxx::time_val() : index.back();
+  }
+
+  std::filesystem::path IndexPath(size_t a_file) const {
+    auto const &path = this->m_all_files[a_file];
+    return path.parent_path() / ("." + path.filename().string() + ".idx");
+  }
+
+  void BuildIndex(size_t a_file) {
+    auto &file = Map(a_file);
+    file.index.clear();
+    file.index.reserve((file.num_recs + IndexStride - 1) / IndexStride);
+
+    utxx::time_val max_exch;
+    for (size_t r = 0; r < file.num_recs; ++r) {
+      max_exch = std::max(max_exch, file.recs[r].ts_exch);
+      if ((r + 1) % IndexStride == 0 || r + 1 == file.num_recs)
+        file.index.push_back(max_exch);
+    }
+    file.index_size = file.size;
+    file.indexed = true;
+  }
+
+  bool LoadIndex(size_t a_file, size_t a_size) {
+    std::ifstream is(IndexPath(a_file), std::ios_base::binary);
+    if (!is)
+      return false;
+
+    IndexFileHeader header;
+    is.read(reinterpret_cast<char *>(&header), sizeof(header));
+    size_t num_recs = (a_size - sizeof(MDStoreFileHeader)) / RecSize;
+    if (!is || header.magic != IndexMagic || header.record_size != RecSize ||
+        header.stride != IndexStride || header.data_size != a_size ||
+        header.num_entries != (num_recs + IndexStride - 1) / IndexStride)
+      return false;
+
+    auto &file = m_files[a_file];
+    file.index.resize(header.num_entries);
+    is.read(reinterpret_cast<char *>(file.index.data()),
+            long(header.num_entries * sizeof(utxx::time_val)));
+    if (!is) {
+      file.index.clear();
+      return false;
+    }
+    file.index_size = a_size;
+    file.indexed = true;
+    return true;
+  }
+
+  // Best effort: the store may well be read-only, in which case the index is
+  // only kept in memory. The index is written under a temporary name and then
+  // renamed, so concurrent readers never see a partial one
+  void SaveIndex(size_t a_file) {
+    auto const &file = m_files[a_file];
+    auto path = IndexPath(a_file);
+    auto tmp_path = path;
+    tmp_path += "." + std::to_string(getpid());
+
+    IndexFileHeader header;
+    header.magic = IndexMagic;
+    header.record_size = RecSize;
+    header.stride = IndexStride;
+    header.data_size = file.index_size;
+    header.num_entries = file.index.size();
+    {
+      std::ofstream os(tmp_path, std::ios_base::binary | std::ios_base::trunc);
+      if (!os)
+        return;
+      os.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      os.write(reinterpret_cast<const char *>(file.index.data()),
+               long(file.index.size() * sizeof(utxx::time_val)));
+      if (!os) {
+        os.close();
+        std::error_code ec;
+        std::filesystem::remove(tmp_path, ec);
+        return;
+      }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec)
+      std::filesystem::remove(tmp_path, ec);
+  }
+};
+
 } // namespace QuantSupport
 } // namespace MAQUETTE
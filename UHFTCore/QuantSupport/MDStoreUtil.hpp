@@ -41,8 +41,8 @@ GetMDRecs(const std::string &a_md_store_root, const std::string &a_venue,
     }
   } else {
     // using plain MDStore
-    MDStoreReader<REC> mds(a_md_store_root, a_venue, a_symbol,
-                           IsL1 ? "ob_L1" : "trades");
+    MDStoreMMapReader<REC> mds(a_md_store_root, a_venue, a_symbol,
+                               IsL1 ? "ob_L1" : "trades");
     mds.Read(a_start, read_callback);
   }
 
@@ -34,6 +34,7 @@ namespace FIX
     constexpr static bool         s_hasPasswdChange          = false;
     constexpr static bool         s_waitForTrSessStatus      = true;
     constexpr static bool         s_useSecIDInsteadOfSymbol  = false;
+    constexpr static bool         s_zeroCopyRead             = true;
 
     //-----------------------------------------------------------------------//
     // Ord Mgmt:                                                             //
@@ -38,6 +38,7 @@ namespace FIX
     constexpr static bool         s_hasPasswdChange          = false;
     constexpr static bool         s_waitForTrSessStatus      = false;
     constexpr static bool         s_useSecIDInsteadOfSymbol  = false;
+    constexpr static bool         s_zeroCopyRead             = false;
 
     //-----------------------------------------------------------------------//
     // Ord Mgmt:                                                             //
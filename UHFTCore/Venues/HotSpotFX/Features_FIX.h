@@ -33,6 +33,7 @@ namespace FIX
     constexpr static bool         s_hasPasswdChange          = false;
     constexpr static bool         s_waitForTrSessStatus      = false;
     constexpr static bool         s_useSecIDInsteadOfSymbol  = false;
+    constexpr static bool         s_zeroCopyRead             = true;
 
     // NB: s_QT, s_hasFracQtys and s_hasFullAmount are provided by derived
     // structs...
@@ -34,6 +34,7 @@ namespace FIX
     constexpr static bool         s_hasPasswdChange          = false;
     constexpr static bool         s_waitForTrSessStatus      = false;
     constexpr static bool         s_useSecIDInsteadOfSymbol  = true;
+    constexpr static bool         s_zeroCopyRead             = true;
 
     //-----------------------------------------------------------------------//
     // Ord Mgmt:                                                             //